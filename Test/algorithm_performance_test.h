@@ -2,10 +2,14 @@
 #define MYTINYSTL_ALGORITHM_PERFORMANCE_TEST_H_
 
 // 仅仅针对 sort, binary_search 做了性能测试
+// sort 另外测试了 execution::par 版本（样本排序），使用墙上时间
+// 以及有序、逆序、先升后降、大量重复几种输入下的表现
 
 #include <algorithm>
+#include <chrono>
 
 #include "../mySTL/algorithm/algorithm.h"
+#include "../mySTL/algorithm/parallel_algo.h"
 #include "test.h"
 
 namespace mySTL
@@ -55,6 +59,61 @@ namespace algorithm_performance_test
     delete []arr;                                              \
 } while(0)
 
+// 以执行策略 policy 调用 mode::fun，clock() 统计的是所有线程的 CPU 时间，这里改用墙上时间
+#define FUN_TEST3(mode, fun, policy, len) do {                \
+    std::string fun_name = #fun;                               \
+    srand((int)time(0));                                       \
+    char buf[10];                                              \
+    int *arr = new int[len];                                   \
+    for(size_t i = 0; i < len; ++i)  *(arr + i) = rand();      \
+    auto start = std::chrono::steady_clock::now();             \
+    mode::fun(mySTL::execution::policy, arr, arr + len);       \
+    auto end = std::chrono::steady_clock::now();               \
+    int n = static_cast<int>(std::chrono::duration_cast<       \
+        std::chrono::milliseconds>(end - start).count());      \
+    std::snprintf(buf, sizeof(buf), "%d", n);                  \
+    std::string t = buf;                                       \
+    t += "ms   |";                                             \
+    std::cout << std::setw(WIDE) << t;                         \
+    delete []arr;                                              \
+} while(0)
+
+// 生成不同模式的输入
+enum sort_pattern { kSorted, kReverse, kOrganPipe, kFewUnique };
+
+inline void fill_pattern(int* arr, size_t count, sort_pattern pattern)
+{
+  for (size_t i = 0; i < count; ++i)
+  {
+    switch (pattern)
+    {
+    case kSorted:    arr[i] = static_cast<int>(i); break;
+    case kReverse:   arr[i] = static_cast<int>(count - i); break;
+    case kOrganPipe: arr[i] = static_cast<int>(i < count / 2 ? i : count - i); break;
+    case kFewUnique: arr[i] = rand() % 16; break;
+    }
+  }
+}
+
+#define FUN_TEST4(mode, fun, pattern, count) do {             \
+    std::string fun_name = #fun;                               \
+    srand((int)time(0));                                       \
+    char buf[10];                                              \
+    clock_t start, end;                                        \
+    int *arr = new int[count];                                 \
+    fill_pattern(arr, count, pattern);                         \
+    start = clock();                                           \
+    mode::fun(arr, arr + count);                               \
+    end = clock();                                             \
+    int n = static_cast<int>(static_cast<double>(end - start)  \
+        / CLOCKS_PER_SEC * 1000);                              \
+    std::snprintf(buf, sizeof(buf), "%d", n);                  \
+    std::string t = buf;                                       \
+    t += "ms   |";                                             \
+    std::cout << std::setw(WIDE) << t;                         \
+    delete []arr;                                              \
+} while(0)
+
 void binary_search_test()
 {
   std::cout << "[------------------- function : binary_search ------------------]" << std::endl;
@@ -84,6 +143,90 @@ void sort_test()
   FUN_TEST1(mySTL, sort, LEN1);
   FUN_TEST1(mySTL, sort, LEN2);
   FUN_TEST1(mySTL, sort, LEN3);
+  std::cout << std::endl << "|     mySTL(par)      |";
+  FUN_TEST3(mySTL, sort, par, LEN1);
+  FUN_TEST3(mySTL, sort, par, LEN2);
+  FUN_TEST3(mySTL, sort, par, LEN3);
+  std::cout << std::endl;
+}
+
+void sort_pattern_test()
+{
+  std::cout << "[------------------ function : sort (pattern) ------------------]" << std::endl;
+  std::cout << "| orders of magnitude |";
+  TEST_LEN(LEN1, LEN2, LEN3, WIDE);
+  std::cout << "|     std (sorted)    |";
+  FUN_TEST4(std, sort, kSorted, LEN1);
+  FUN_TEST4(std, sort, kSorted, LEN2);
+  FUN_TEST4(std, sort, kSorted, LEN3);
+  std::cout << std::endl << "|    mySTL (sorted)   |";
+  FUN_TEST4(mySTL, sort, kSorted, LEN1);
+  FUN_TEST4(mySTL, sort, kSorted, LEN2);
+  FUN_TEST4(mySTL, sort, kSorted, LEN3);
+  std::cout << std::endl << "|    std (reverse)    |";
+  FUN_TEST4(std, sort, kReverse, LEN1);
+  FUN_TEST4(std, sort, kReverse, LEN2);
+  FUN_TEST4(std, sort, kReverse, LEN3);
+  std::cout << std::endl << "|   mySTL (reverse)   |";
+  FUN_TEST4(mySTL, sort, kReverse, LEN1);
+  FUN_TEST4(mySTL, sort, kReverse, LEN2);
+  FUN_TEST4(mySTL, sort, kReverse, LEN3);
+  std::cout << std::endl << "|   std (organ pipe)  |";
+  FUN_TEST4(std, sort, kOrganPipe, LEN1);
+  FUN_TEST4(std, sort, kOrganPipe, LEN2);
+  FUN_TEST4(std, sort, kOrganPipe, LEN3);
+  std::cout << std::endl << "|  mySTL (organ pipe) |";
+  FUN_TEST4(mySTL, sort, kOrganPipe, LEN1);
+  FUN_TEST4(mySTL, sort, kOrganPipe, LEN2);
+  FUN_TEST4(mySTL, sort, kOrganPipe, LEN3);
+  std::cout << std::endl << "|   std (16 values)   |";
+  FUN_TEST4(std, sort, kFewUnique, LEN1);
+  FUN_TEST4(std, sort, kFewUnique, LEN2);
+  FUN_TEST4(std, sort, kFewUnique, LEN3);
+  std::cout << std::endl << "|  mySTL (16 values)  |";
+  FUN_TEST4(mySTL, sort, kFewUnique, LEN1);
+  FUN_TEST4(mySTL, sort, kFewUnique, LEN2);
+  FUN_TEST4(mySTL, sort, kFewUnique, LEN3);
+  std::cout << std::endl;
+}
+
+void stable_sort_test()
+{
+  std::cout << "[------------------- function : stable_sort --------------------]" << std::endl;
+  std::cout << "| orders of magnitude |";
+  TEST_LEN(LEN1, LEN2, LEN3, WIDE);
+  std::cout << "|         std         |";
+  FUN_TEST1(std, stable_sort, LEN1);
+  FUN_TEST1(std, stable_sort, LEN2);
+  FUN_TEST1(std, stable_sort, LEN3);
+  std::cout << std::endl << "|        mySTL        |";
+  FUN_TEST1(mySTL, stable_sort, LEN1);
+  FUN_TEST1(mySTL, stable_sort, LEN2);
+  FUN_TEST1(mySTL, stable_sort, LEN3);
+  std::cout << std::endl << "|     mySTL(par)      |";
+  FUN_TEST3(mySTL, stable_sort, par, LEN1);
+  FUN_TEST3(mySTL, stable_sort, par, LEN2);
+  FUN_TEST3(mySTL, stable_sort, par, LEN3);
+  std::cout << std::endl;
+}
+
+void radix_sort_test()
+{
+  std::cout << "[-------------------- function : radix_sort --------------------]" << std::endl;
+  std::cout << "| orders of magnitude |";
+  TEST_LEN(LEN1, LEN2, LEN3, WIDE);
+  std::cout << "|      std(sort)      |";
+  FUN_TEST1(std, sort, LEN1);
+  FUN_TEST1(std, sort, LEN2);
+  FUN_TEST1(std, sort, LEN3);
+  std::cout << std::endl << "|     mySTL(sort)     |";
+  FUN_TEST1(mySTL, sort, LEN1);
+  FUN_TEST1(mySTL, sort, LEN2);
+  FUN_TEST1(mySTL, sort, LEN3);
+  std::cout << std::endl << "|  mySTL(radix_sort)  |";
+  FUN_TEST1(mySTL, radix_sort, LEN1);
+  FUN_TEST1(mySTL, radix_sort, LEN2);
+  FUN_TEST1(mySTL, radix_sort, LEN3);
   std::cout << std::endl;
 }
 
@@ -94,6 +237,9 @@ void algorithm_performance_test()
   std::cout << "[===============================================================]" << std::endl;
   std::cout << "[--------------- Run algorithm performance test ----------------]" << std::endl;
   sort_test();
+  sort_pattern_test();
+  stable_sort_test();
+  radix_sort_test();
   binary_search_test();
   std::cout << "[--------------- End algorithm performance test ----------------]" << std::endl;
   std::cout << "[===============================================================]" << std::endl;
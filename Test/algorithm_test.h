@@ -1,11 +1,12 @@
 #ifndef MYTINYSTL_ALGORITHM_TEST_H_
 #define MYTINYSTL_ALGORITHM_TEST_H_
 
-// 算法测试: 包含了 mySTL 的 81 个算法测试
+// 算法测试: 包含了 mySTL 的 85 个算法测试
 
 #include <algorithm>
 #include <functional>
 #include <numeric>
+#include <string>
 
 #include "../mySTL/algorithm/algorithm.h"
 #include "../mySTL/container/sequence/vector.h"
@@ -46,7 +47,7 @@ bool cmp(const int& a, const int& b) { return b < a; }
 int  unary_op(const int& x) { return x + 1; }
 int  binary_op(const int& x, const int& y) { return x + y; }
 
-// 以下为 80 个函数的简单测试
+// 以下为 84 个函数的简单测试
 
 // algobase test:
 TEST(copy_test)
@@ -627,8 +628,19 @@ TEST(inplace_merge_test)
   mySTL::inplace_merge(arr2, arr2 + 5, arr2 + 10);
   std::inplace_merge(arr3, arr3 + 3, arr3 + 8, std::less<int>());
   mySTL::inplace_merge(arr4, arr4 + 3, arr4 + 8, std::less<int>());
+  // std::string 被移动到自身时会丢失内容
+  std::string str1[] = { "b","b","b","c","d","d","e","e" };
+  std::string str2[] = { "b","b","b","c","d","d","e","e" };
+  std::string str3[] = { "c","d","e","a","b","f" };
+  std::string str4[] = { "c","d","e","a","b","f" };
+  std::inplace_merge(str1, str1 + 1, str1 + 8);
+  mySTL::inplace_merge(str2, str2 + 1, str2 + 8);
+  std::inplace_merge(str3, str3 + 3, str3 + 6);
+  mySTL::inplace_merge(str4, str4 + 3, str4 + 6);
   EXPECT_CON_EQ(arr1, arr2);
   EXPECT_CON_EQ(arr3, arr4);
+  EXPECT_CON_EQ(str1, str2);
+  EXPECT_CON_EQ(str3, str4);
 }
 
 TEST(is_heap_test)
@@ -837,6 +849,26 @@ TEST(partial_sort_copy_test)
   EXPECT_CON_EQ(exp, act);
 }
 
+TEST(partial_stable_sort_test)
+{
+  int arr1[] = { 31,12,23,11,32,13,21,22,33,10,20 };
+  int arr2[] = { 31,12,23,11,32,13,21,22,33,10,20 };
+  int arr3[] = { 5,1,5,8,6,4,8,4,1,3,5,8,4 };
+  int arr4[] = { 5,1,5,8,6,4,8,4,1,3,5,8,4 };
+  int exp1[4], act1[4], exp2[6], act2[6];
+  auto mod = [](int a, int b) { return a % 10 < b % 10; };
+  std::stable_sort(arr1, arr1 + 11, mod);
+  mySTL::partial_stable_sort(arr2, arr2 + 4, arr2 + 11, mod);
+  std::stable_sort(arr3, arr3 + 13, std::greater<int>());
+  mySTL::partial_stable_sort(arr4, arr4 + 6, arr4 + 13, std::greater<int>());
+  std::copy(arr1, arr1 + 4, exp1);
+  std::copy(arr2, arr2 + 4, act1);
+  std::copy(arr3, arr3 + 6, exp2);
+  std::copy(arr4, arr4 + 6, act2);
+  EXPECT_CON_EQ(exp1, act1);
+  EXPECT_CON_EQ(exp2, act2);
+}
+
 TEST(partition_test)
 {
   int arr1[] = { 1,2,3,4,5,6,7,8,9 };
@@ -894,6 +926,32 @@ TEST(random_shuffle_test)
   EXPECT_CON_NE(arr1, arr2);
 }
 
+TEST(radix_sort_test)
+{
+  int arr1[] = { 6,-1,2,5,-4,8,3,2,-4,6,10,2,1,-9 };
+  int arr2[] = { 6,-1,2,5,-4,8,3,2,-4,6,10,2,1,-9 };
+  double arr3[] = { 8.5,-3.0,5.1,-6.5,1.2,0.0,2.4,-8.7,6.2,5.1 };
+  double arr4[] = { 8.5,-3.0,5.1,-6.5,1.2,0.0,2.4,-8.7,6.2,5.1 };
+  int arr5[] = { 31,12,23,11,32,13,21,22,33 };
+  int arr6[] = { 31,12,23,11,32,13,21,22,33 };
+  mySTL::vector<unsigned> v1, v2;
+  for (unsigned i = 0; i < 1000; ++i)
+    v1.push_back(i * 2654435761u);
+  v2 = v1;
+  std::sort(arr1, arr1 + 14);
+  mySTL::radix_sort(arr2, arr2 + 14);
+  std::sort(arr3, arr3 + 10);
+  mySTL::radix_sort(arr4, arr4 + 10);
+  std::stable_sort(arr5, arr5 + 9, [](int a, int b) { return a % 10 < b % 10; });
+  mySTL::radix_sort_by_key(arr6, arr6 + 9, [](int x) { return x % 10; });
+  std::sort(v1.begin(), v1.end());
+  mySTL::radix_sort(v2.begin(), v2.end());
+  EXPECT_CON_EQ(arr1, arr2);
+  EXPECT_CON_EQ(arr3, arr4);
+  EXPECT_CON_EQ(arr5, arr6);
+  EXPECT_CON_EQ(v1, v2);
+}
+
 TEST(remove_test)
 {
   std::vector<int> v1{ 1,2,3,4,5,6,6,6 };
@@ -1098,6 +1156,51 @@ TEST(sort_test)
   EXPECT_CON_EQ(arr5, arr6);
 }
 
+TEST(stable_partition_test)
+{
+  int arr1[] = { 1,2,3,4,5,6,7,8,9,10 };
+  int arr2[] = { 1,2,3,4,5,6,7,8,9,10 };
+  int arr3[] = { 5,1,5,8,6,4,8,4,1,3,5,8,4 };
+  int arr4[] = { 5,1,5,8,6,4,8,4,1,3,5,8,4 };
+  auto p1 = std::stable_partition(arr1, arr1 + 10, is_odd);
+  auto p2 = mySTL::stable_partition(arr2, arr2 + 10, is_odd);
+  auto p3 = std::stable_partition(arr3, arr3 + 13, is_even);
+  auto p4 = mySTL::stable_partition(arr4, arr4 + 13, is_even);
+  EXPECT_EQ(p1 - arr1, p2 - arr2);
+  EXPECT_EQ(p3 - arr3, p4 - arr4);
+  EXPECT_CON_EQ(arr1, arr2);
+  EXPECT_CON_EQ(arr3, arr4);
+}
+
+TEST(stable_sort_test)
+{
+  int arr1[] = { 6,1,2,5,4,8,3,2,4,6,10,2,1,9 };
+  int arr2[] = { 6,1,2,5,4,8,3,2,4,6,10,2,1,9 };
+  int arr3[] = { 31,12,23,11,32,13,21,22,33,10,20 };
+  int arr4[] = { 31,12,23,11,32,13,21,22,33,10,20 };
+  auto mod = [](int a, int b) { return a % 10 < b % 10; };
+  mySTL::vector<int> v1, v2;
+  for (int i = 0; i < 1000; ++i)
+    v1.push_back((i * 7919) % 1009);
+  v2 = v1;
+  std::stable_sort(arr1, arr1 + 14);
+  mySTL::stable_sort(arr2, arr2 + 14);
+  std::stable_sort(arr3, arr3 + 11, mod);
+  mySTL::stable_sort(arr4, arr4 + 11, mod);
+  mySTL::vector<std::string> s1, s2;
+  for (int i = 0; i < 100; ++i)
+    s1.push_back(std::to_string((i * 37) % 11));
+  s2 = s1;
+  std::stable_sort(v1.begin(), v1.end(), std::greater<int>());
+  mySTL::stable_sort(v2.begin(), v2.end(), std::greater<int>());
+  std::stable_sort(s1.begin(), s1.end());
+  mySTL::stable_sort(s2.begin(), s2.end());
+  EXPECT_CON_EQ(arr1, arr2);
+  EXPECT_CON_EQ(arr3, arr4);
+  EXPECT_CON_EQ(v1, v2);
+  EXPECT_CON_EQ(s1, s2);
+}
+
 TEST(swap_ranges_test)
 {
   int arr1[] = { 4,5,6,1,2,3 };
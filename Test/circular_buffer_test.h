@@ -0,0 +1,152 @@
+#ifndef MYTINYSTL_CIRCULAR_BUFFER_TEST_H_
+#define MYTINYSTL_CIRCULAR_BUFFER_TEST_H_
+
+// circular_buffer test : 测试 circular_buffer 的接口与作为有界队列的 push/pop 性能
+
+#include <queue>
+
+#include "../mySTL/adapter/queue.h"
+#include "../mySTL/adapter/stack.h"
+#include "../mySTL/allocator/memory_resource.h"
+#include "../mySTL/container/sequence/basic_string.h"
+#include "../mySTL/container/sequence/circular_buffer.h"
+#include "test.h"
+
+namespace mySTL
+{
+namespace test
+{
+
+namespace bounded_std
+{
+typedef std::queue<int> table;
+inline table make(size_t) { return table(); }
+} // namespace bounded_std
+
+namespace bounded_deque
+{
+typedef mySTL::queue<int> table;
+inline table make(size_t) { return table(); }
+} // namespace bounded_deque
+
+namespace bounded_ring
+{
+typedef mySTL::queue<int, mySTL::circular_buffer<int>> table;
+inline table make(size_t n)
+{
+  mySTL::circular_buffer<int> buf;
+  buf.reserve(n);
+  return table(mySTL::move(buf));
+}
+} // namespace bounded_ring
+
+namespace circular_buffer_test
+{
+
+void circular_buffer_test()
+{
+  std::cout << "[===============================================================]\n";
+  std::cout << "[------------ Run container test : circular_buffer -------------]\n";
+  std::cout << "[-------------------------- API test ---------------------------]\n";
+  int a[] = { 1,2,3,4,5 };
+  mySTL::circular_buffer<int> c1;
+  mySTL::circular_buffer<int> c2(5);
+  mySTL::circular_buffer<int> c3(5, 1);
+  mySTL::circular_buffer<int> c4(a, a + 5);
+  mySTL::circular_buffer<int> c5(c2);
+  mySTL::circular_buffer<int> c6(std::move(c2));
+  mySTL::circular_buffer<int> c7;
+  c7 = c3;
+  mySTL::circular_buffer<int> c8;
+  c8 = std::move(c3);
+  mySTL::circular_buffer<int> c9{ 1,2,3,4,5,6,7,8,9 };
+  mySTL::circular_buffer<int> c10;
+  c10 = { 1,2,3,4,5,6,7,8,9 };
+  typedef mySTL::basic_string<char, mySTL::char_traits<char>,
+                              mySTL::pmr::polymorphic_allocator<char>> pmr_string;
+  typedef mySTL::circular_buffer<pmr_string, mySTL::pmr::polymorphic_allocator<pmr_string>> pmr_ring;
+  mySTL::pmr::unsynchronized_pool_resource pool;
+  pmr_ring c11(2, "pool", &pool);
+  pmr_ring c12(c11.begin(), c11.end(), &pool);
+  pmr_ring c13(c12, &pool);
+
+  FUN_VALUE(c1.capacity());
+  FUN_AFTER(c1, c1.reserve(4));
+  FUN_VALUE(c1.capacity());
+  FUN_AFTER(c1, c1.push_back(1));
+  FUN_AFTER(c1, c1.push_back(2));
+  FUN_AFTER(c1, c1.emplace_front(0));
+  FUN_AFTER(c1, c1.push_back(3));
+  std::cout << std::boolalpha;
+  FUN_VALUE(c1.full());
+  FUN_AFTER(c1, c1.push_back(4));
+  FUN_AFTER(c1, c1.push_front(9));
+  FUN_AFTER(c1, c1.set_overflow_policy(mySTL::circular_buffer_overflow::reject));
+  FUN_VALUE(c1.push_back(5));
+  FUN_VALUE(c1.emplace_front(5));
+  FUN_VALUE(c1.empty());
+  std::cout << std::noboolalpha;
+  FUN_AFTER(c1, c1.pop_front());
+  FUN_AFTER(c1, c1.pop_back());
+  FUN_AFTER(c1, c1.push_back(6));
+  FUN_AFTER(c1, c1.swap(c4));
+  FUN_VALUE(*(c1.begin()));
+  FUN_VALUE(*(c1.end() - 1));
+  FUN_VALUE(*(c1.rbegin()));
+  FUN_VALUE(c1.front());
+  FUN_VALUE(c1.back());
+  FUN_VALUE(c1.at(1));
+  FUN_VALUE(c1[2]);
+  FUN_VALUE(c1.size());
+  FUN_VALUE(c1.capacity());
+  FUN_AFTER(c1, c1.clear());
+  FUN_VALUE(c1.size());
+  std::cout << std::boolalpha;
+  FUN_VALUE((c11.front().get_allocator().resource() == &pool));
+  FUN_VALUE((c12.back().get_allocator().resource() == &pool));
+  FUN_VALUE((c13.back().get_allocator().resource() == &pool));
+  std::cout << std::noboolalpha;
+
+  mySTL::queue<int, mySTL::circular_buffer<int>> q(mySTL::circular_buffer<int>{ 1,2,3,4 });
+  q.push(5);
+  q.pop();
+  FUN_VALUE(q.front());
+  FUN_VALUE(q.back());
+  FUN_VALUE(q.size());
+  mySTL::stack<int, mySTL::circular_buffer<int>> s(mySTL::circular_buffer<int>{ 1,2,3,4 });
+  s.push(5);
+  FUN_VALUE(s.top());
+  FUN_VALUE(s.size());
+  // 默认构造的 circular_buffer 容量为 0，push 抛出 length_error 而不是丢弃元素
+  mySTL::stack<int, mySTL::circular_buffer<int>> s0;
+  mySTL::queue<int, mySTL::circular_buffer<int>> q0;
+  bool stack_thrown = false, queue_thrown = false;
+  try { s0.push(1); } catch (const std::length_error&) { stack_thrown = true; }
+  try { q0.push(1); } catch (const std::length_error&) { queue_thrown = true; }
+  std::cout << std::boolalpha;
+  FUN_VALUE(stack_thrown);
+  FUN_VALUE(queue_thrown);
+  std::cout << std::noboolalpha;
+  FUN_VALUE(s0.size());
+  FUN_VALUE(q0.size());
+  PASSED;
+#if PERFORMANCE_TEST_ON
+  std::cout << "[--------------------- Performance Testing ---------------------]\n";
+  std::cout << "|---------------------|-------------|-------------|-------------|\n";
+  std::cout << "| queue push+pop      |";
+#if LARGER_TEST_DATA_ON
+  BOUNDED_QUEUE_TEST(SCALE_LL(LEN1), SCALE_LL(LEN2), SCALE_LL(LEN3));
+#else
+  BOUNDED_QUEUE_TEST(SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3));
+#endif
+  std::cout << "\n";
+  std::cout << "|---------------------|-------------|-------------|-------------|\n";
+  PASSED;
+#endif
+  std::cout << "[------------ End container test : circular_buffer -------------]\n";
+}
+
+} // namespace circular_buffer_test
+} // namespace test
+} // namespace mySTL
+#endif // !MYTINYSTL_CIRCULAR_BUFFER_TEST_H_
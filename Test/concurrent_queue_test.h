@@ -0,0 +1,278 @@
+#ifndef MYTINYSTL_CONCURRENT_QUEUE_TEST_H_
+#define MYTINYSTL_CONCURRENT_QUEUE_TEST_H_
+
+// concurrent_queue test : 测试 spsc_queue / mpmc_queue 的接口与两个线程之间传递数据的性能
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../mySTL/adapter/concurrent_queue.h"
+#include "../mySTL/adapter/queue.h"
+#include "../mySTL/allocator/memory_resource.h"
+#include "test.h"
+
+namespace mySTL
+{
+namespace test
+{
+
+// 流水线的两个阶段：produce 放入 0 ~ len-1，consume 取出 len 个元素并求和
+// 队满 / 队空时让出 CPU
+namespace pipe_mutex
+{
+struct table
+{
+  std::mutex lock;
+  mySTL::queue<int> q;
+};
+inline void produce(table& t, size_t len)
+{
+  for (size_t i = 0; i < len; ++i)
+  {
+    std::lock_guard<std::mutex> guard(t.lock);
+    t.q.push(static_cast<int>(i));
+  }
+}
+inline long long consume(table& t, size_t len)
+{
+  long long sum = 0;
+  for (size_t i = 0; i < len; )
+  {
+    {
+      std::lock_guard<std::mutex> guard(t.lock);
+      if (!t.q.empty())
+      {
+        sum += t.q.front();
+        t.q.pop();
+        ++i;
+        continue;
+      }
+    }
+    std::this_thread::yield();
+  }
+  return sum;
+}
+} // namespace pipe_mutex
+
+namespace pipe_spsc
+{
+struct table
+{
+  table() : q(1024) {}
+  mySTL::spsc_queue<int> q;
+};
+inline void produce(table& t, size_t len)
+{
+  for (size_t i = 0; i < len; )
+  {
+    if (t.q.try_push(static_cast<int>(i)))
+      ++i;
+    else
+      std::this_thread::yield();
+  }
+}
+inline long long consume(table& t, size_t len)
+{
+  long long sum = 0;
+  int x;
+  for (size_t i = 0; i < len; )
+  {
+    if (t.q.try_pop(x))
+    {
+      sum += x;
+      ++i;
+    }
+    else
+      std::this_thread::yield();
+  }
+  return sum;
+}
+} // namespace pipe_spsc
+
+// 每次最多传递 64 个元素
+template <class Queue>
+void produce_batch(Queue& q, size_t len)
+{
+  int buf[64];
+  for (size_t i = 0; i < len; )
+  {
+    const size_t n = len - i < 64 ? len - i : 64;
+    for (size_t j = 0; j < n; ++j)
+      buf[j] = static_cast<int>(i + j);
+    size_t k = 0;
+    while (k < n)
+    {
+      const size_t m = q.push_n(buf + k, n - k);
+      if (m == 0)
+        std::this_thread::yield();
+      k += m;
+    }
+    i += n;
+  }
+}
+
+template <class Queue>
+long long consume_batch(Queue& q, size_t len)
+{
+  long long sum = 0;
+  int buf[64];
+  for (size_t i = 0; i < len; )
+  {
+    const size_t k = q.pop_n(buf, 64);
+    if (k == 0)
+      std::this_thread::yield();
+    for (size_t j = 0; j < k; ++j)
+      sum += buf[j];
+    i += k;
+  }
+  return sum;
+}
+
+namespace pipe_spsc_batch
+{
+typedef pipe_spsc::table table;
+inline void produce(table& t, size_t len) { produce_batch(t.q, len); }
+inline long long consume(table& t, size_t len) { return consume_batch(t.q, len); }
+} // namespace pipe_spsc_batch
+
+namespace pipe_mpmc
+{
+struct table
+{
+  table() : q(1024) {}
+  mySTL::mpmc_queue<int> q;
+};
+inline void produce(table& t, size_t len) { produce_batch(t.q, len); }
+inline long long consume(table& t, size_t len) { return consume_batch(t.q, len); }
+} // namespace pipe_mpmc
+
+// 分配器感知的元素，记录构造时得到的资源；移动不抛出异常，可以放入 mpmc_queue
+struct pmr_item
+{
+  typedef mySTL::pmr::polymorphic_allocator<char> allocator_type;
+
+  int value;
+  mySTL::pmr::memory_resource* resource;
+
+  pmr_item(int v = 0) : value(v), resource(nullptr) {}
+  pmr_item(int v, const allocator_type& alloc) : value(v), resource(alloc.resource()) {}
+  pmr_item(pmr_item&& rhs, const allocator_type& alloc) noexcept
+    : value(rhs.value), resource(alloc.resource()) {}
+  pmr_item(pmr_item&&) noexcept = default;
+  pmr_item& operator=(pmr_item&&) noexcept = default;
+};
+
+namespace concurrent_queue_test
+{
+
+void concurrent_queue_test()
+{
+  std::cout << "[===============================================================]\n";
+  std::cout << "[------------ Run container test : concurrent_queue -------------]\n";
+  std::cout << "[-------------------------- API test ---------------------------]\n";
+  int a[] = { 1,2,3,4,5,6,7,8,9 };
+  int out[9] = {};
+  int x = 0;
+  mySTL::spsc_queue<int> q1(5);
+  mySTL::mpmc_queue<int> q2(4);
+  mySTL::mpmc_queue<std::string> q3(2);
+
+  std::cout << std::boolalpha;
+  FUN_VALUE(q1.capacity());
+  FUN_VALUE(q1.try_push(1));
+  FUN_VALUE(q1.try_emplace(2));
+  FUN_VALUE(q1.push_n(a, 9));
+  FUN_VALUE(q1.size());
+  FUN_VALUE(q1.try_push(10));
+  FUN_VALUE(q1.try_pop(x));
+  FUN_VALUE(x);
+  FUN_VALUE(q1.pop_n(out, 9));
+  FUN_VALUE(out[0]);
+  FUN_VALUE(out[6]);
+  FUN_VALUE(q1.empty());
+  FUN_VALUE(q1.try_pop(x));
+  FUN_VALUE(q2.capacity());
+  FUN_VALUE(q2.push_n(a, 3));
+  FUN_VALUE(q2.try_push(4));
+  FUN_VALUE(q2.try_push(5));
+  FUN_VALUE(q2.pop_n(out, 2));
+  FUN_VALUE(out[1]);
+  FUN_VALUE(q2.push_n(a + 5, 4));
+  FUN_VALUE(q2.size());
+  FUN_VALUE(q3.try_push("a"));
+  FUN_VALUE(q3.try_emplace(3, 'b'));
+  FUN_VALUE(q3.try_emplace("c"));
+  std::string s;
+  FUN_VALUE(q3.try_pop(s));
+  FUN_VALUE(s);
+  mySTL::pmr::unsynchronized_pool_resource pool;
+  mySTL::mpmc_queue<pmr_item, mySTL::pmr::polymorphic_allocator<pmr_item>> q4(2, &pool);
+  pmr_item item;
+  FUN_VALUE(q4.try_emplace(7));
+  FUN_VALUE(q4.push_n(a, 1));
+  FUN_VALUE(q4.try_pop(item));
+  FUN_VALUE(item.value);
+  FUN_VALUE((item.resource == &pool));
+  FUN_VALUE(q4.try_pop(item));
+  FUN_VALUE((item.resource == &pool));
+  {
+    // 4 个生产者、4 个消费者共用一个 mpmc_queue
+    mySTL::mpmc_queue<int> q(64);
+    std::atomic<long long> sum(0);
+    std::atomic<int> count(0);
+    std::vector<std::thread> workers;
+    for (int w = 0; w < 4; ++w)
+    {
+      workers.emplace_back([&q, w] {
+        for (int i = 0; i < 10000; )
+        {
+          if (q.try_push(w * 10000 + i))
+            ++i;
+          else
+            std::this_thread::yield();
+        }
+      });
+      workers.emplace_back([&q, &sum, &count] {
+        int v;
+        while (count.load() < 40000)
+        {
+          if (q.try_pop(v))
+          {
+            sum += v;
+            ++count;
+          }
+          else
+            std::this_thread::yield();
+        }
+      });
+    }
+    for (auto& th : workers)
+      th.join();
+    FUN_VALUE(count.load());
+    FUN_VALUE((sum.load() == 40000LL * 39999 / 2));
+  }
+  std::cout << std::noboolalpha;
+  PASSED;
+#if PERFORMANCE_TEST_ON
+  std::cout << "[--------------------- Performance Testing ---------------------]\n";
+  std::cout << "|---------------------|-------------|-------------|-------------|\n";
+  std::cout << "|  producer/consumer  |";
+#if LARGER_TEST_DATA_ON
+  PIPELINE_TEST(SCALE_LL(LEN1), SCALE_LL(LEN2), SCALE_LL(LEN3));
+#else
+  PIPELINE_TEST(SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3));
+#endif
+  std::cout << "\n";
+  std::cout << "|---------------------|-------------|-------------|-------------|\n";
+  PASSED;
+#endif
+  std::cout << "[------------ End container test : concurrent_queue -------------]\n";
+}
+
+} // namespace concurrent_queue_test
+} // namespace test
+} // namespace mySTL
+#endif // !MYTINYSTL_CONCURRENT_QUEUE_TEST_H_
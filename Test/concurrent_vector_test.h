@@ -0,0 +1,196 @@
+#ifndef MYTINYSTL_CONCURRENT_VECTOR_TEST_H_
+#define MYTINYSTL_CONCURRENT_VECTOR_TEST_H_
+
+// concurrent_vector test : 测试 concurrent_vector 的接口与多线程 push_back 的性能
+
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../mySTL/container/sequence/concurrent_vector.h"
+#include "../mySTL/container/sequence/vector.h"
+#include "test.h"
+
+namespace mySTL
+{
+namespace test
+{
+
+// 用互斥量保护的 vector
+namespace locked_std
+{
+struct table
+{
+  std::mutex lock;
+  std::vector<int> v;
+};
+inline void push(table& t, int value)
+{
+  std::lock_guard<std::mutex> guard(t.lock);
+  t.v.push_back(value);
+}
+} // namespace locked_std
+
+namespace locked_mystl
+{
+struct table
+{
+  std::mutex lock;
+  mySTL::vector<int> v;
+};
+inline void push(table& t, int value)
+{
+  std::lock_guard<std::mutex> guard(t.lock);
+  t.v.push_back(value);
+}
+} // namespace locked_mystl
+
+namespace concurrent
+{
+typedef mySTL::concurrent_vector<int> table;
+inline void push(table& t, int value)
+{
+  t.push_back(value);
+}
+} // namespace concurrent
+
+// 有状态的分配器：按编号统计尚未释放的元素个数，不随容器传播，编号不同时互不相等
+inline long long* tagged_live()
+{
+  static long long live[4] = {};
+  return live;
+}
+
+template <class T>
+struct tagged_allocator
+{
+  typedef T value_type;
+  int id;
+
+  explicit tagged_allocator(int i = 0) : id(i) {}
+  template <class U>
+  tagged_allocator(const tagged_allocator<U>& rhs) : id(rhs.id) {}
+
+  T* allocate(size_t n)
+  {
+    tagged_live()[id] += static_cast<long long>(n);
+    return static_cast<T*>(::operator new(n * sizeof(T)));
+  }
+  void deallocate(T* p, size_t n)
+  {
+    tagged_live()[id] -= static_cast<long long>(n);
+    ::operator delete(p);
+  }
+  bool operator==(const tagged_allocator& rhs) const { return id == rhs.id; }
+  bool operator!=(const tagged_allocator& rhs) const { return id != rhs.id; }
+};
+
+namespace concurrent_vector_test
+{
+
+void concurrent_vector_test()
+{
+  std::cout << "[===============================================================]\n";
+  std::cout << "[------------ Run container test : concurrent_vector ------------]\n";
+  std::cout << "[-------------------------- API test ---------------------------]\n";
+  int a[] = { 1,2,3,4,5 };
+  mySTL::concurrent_vector<int> v1;
+  mySTL::concurrent_vector<int> v2(10);
+  mySTL::concurrent_vector<int> v3(10, 1);
+  mySTL::concurrent_vector<int> v4{ 1,2,3,4,5 };
+  mySTL::concurrent_vector<int> v5(v3);
+  mySTL::concurrent_vector<int> v6(std::move(v3));
+  mySTL::concurrent_vector<int> v7, v8;
+  v7 = v4;
+  v8 = std::move(v4);
+  mySTL::concurrent_vector<std::string> v9;
+
+  FUN_AFTER(v1, v1.push_back(1));
+  FUN_AFTER(v1, v1.emplace_back(2));
+  FUN_AFTER(v1, v1.grow_by(3));
+  FUN_AFTER(v1, v1.grow_by(2, 6));
+  FUN_AFTER(v1, v1.grow_by(a, a + 5));
+  FUN_AFTER(v1, v1.grow_to_at_least(15));
+  FUN_AFTER(v1, v1.swap(v7));
+  FUN_AFTER(v1, v1.swap(v7));
+  FUN_AFTER(v9, v9.push_back("a"));
+  FUN_AFTER(v9, v9.grow_by(2, "b"));
+  FUN_VALUE(*v1.begin());
+  FUN_VALUE(*(v1.end() - 1));
+  FUN_VALUE(*v1.rbegin());
+  FUN_VALUE(*(v1.rend() - 1));
+  FUN_VALUE(v1.front());
+  FUN_VALUE(v1.back());
+  FUN_VALUE(v1[0]);
+  FUN_VALUE(v1.at(1));
+  std::cout << std::boolalpha;
+  FUN_VALUE(v1.empty());
+  FUN_VALUE((v5 == v6));
+  std::cout << std::noboolalpha;
+  FUN_VALUE(v1.size());
+  FUN_VALUE(v1.capacity());
+  FUN_AFTER(v1, v1.reserve(100));
+  FUN_VALUE(v1.capacity());
+  {
+    // 多个线程同时 push_back，第一个元素的地址保持不变
+    mySTL::concurrent_vector<int> c;
+    c.push_back(-1);
+    const int* first = &c[0];
+    std::vector<std::thread> workers;
+    for (int w = 0; w < 4; ++w)
+      workers.emplace_back([&c, w] {
+        for (int i = 0; i < 10000; ++i)
+          c.push_back(w);
+      });
+    for (auto& th : workers)
+      th.join();
+    std::cout << std::boolalpha;
+    FUN_VALUE(c.size());
+    FUN_VALUE((first == &c[0]));
+    FUN_VALUE((mySTL::count(c.begin(), c.end(), 3) == 10000));
+    std::cout << std::noboolalpha;
+  }
+  {
+    // 分配器不传播且不相等：赋值后仍使用自己的分配器，段由各自的分配器释放
+    typedef mySTL::concurrent_vector<int, tagged_allocator<int>> tagged_vector;
+    tagged_vector t1(40, 1, tagged_allocator<int>(1));
+    tagged_vector t2(20, 2, tagged_allocator<int>(2));
+    tagged_vector t3(t2, tagged_allocator<int>(3));
+    t1 = std::move(t2);
+    FUN_VALUE(t1.get_allocator().id);
+    FUN_VALUE(t1.size());
+    t1 = t3;
+    FUN_VALUE(t1.get_allocator().id);
+    FUN_VALUE(t1.size());
+    tagged_vector t4(std::move(t1), tagged_allocator<int>(2));
+    FUN_VALUE(t4.get_allocator().id);
+    FUN_VALUE(t4.size());
+  }
+  FUN_VALUE(tagged_live()[1]);
+  FUN_VALUE(tagged_live()[2]);
+  FUN_VALUE(tagged_live()[3]);
+  FUN_AFTER(v1, v1.clear());
+  FUN_VALUE(v1.size());
+  FUN_VALUE(v1.capacity());
+  PASSED;
+#if PERFORMANCE_TEST_ON
+  std::cout << "[--------------------- Performance Testing ---------------------]\n";
+  std::cout << "|---------------------|-------------|-------------|-------------|\n";
+  std::cout << "| 4 threads push_back |";
+#if LARGER_TEST_DATA_ON
+  CONCURRENT_PUSH_TEST(SCALE_LL(LEN1), SCALE_LL(LEN2), SCALE_LL(LEN3));
+#else
+  CONCURRENT_PUSH_TEST(SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3));
+#endif
+  std::cout << "\n";
+  std::cout << "|---------------------|-------------|-------------|-------------|\n";
+  PASSED;
+#endif
+  std::cout << "[------------ End container test : concurrent_vector ------------]\n";
+}
+
+} // namespace concurrent_vector_test
+} // namespace test
+} // namespace mySTL
+#endif // !MYTINYSTL_CONCURRENT_VECTOR_TEST_H_
+
@@ -1,10 +1,11 @@
 ﻿#ifndef MYTINYSTL_DEQUE_TEST_H_
 #define MYTINYSTL_DEQUE_TEST_H_
 
-// deque test : 测试 deque 的接口和 push_front/push_back 的性能
+// deque test : 测试 deque 的接口和 push_front/push_back/随机访问/队列/整体拷贝的性能
 
 #include <deque>
 #include <iostream>
+#include "../mySTL/algorithm/algo.h"
 #include "../mySTL/container/sequence/deque.h"
 #include "test.h"
 
@@ -12,6 +13,12 @@ namespace mySTL
 {
 namespace test
 {
+namespace chunk
+{
+template <class T>
+using deque = mySTL::deque<T, mySTL::allocator<T>, DEQUE_CHUNK_SIZE>;
+} // namespace chunk
+
 namespace deque_test
 {
 
@@ -34,6 +41,7 @@ void deque_test()
   mySTL::deque<int> d9{ 1,2,3,4,5,6,7,8,9 };
   mySTL::deque<int> d10;
   d10 = { 1,2,3,4,5,6,7,8,9 };
+  mySTL::deque<int, mySTL::allocator<int>, 3> d11{ 1,2,3,4,5,6,7,8,9 };
 
   FUN_AFTER(d1, d1.assign(5, 1));
   FUN_AFTER(d1, d1.assign(8, 8));
@@ -70,6 +78,16 @@ void deque_test()
   std::cout << std::noboolalpha;
   FUN_VALUE(d1.size());
   FUN_VALUE(d1.max_size());
+  FUN_VALUE(d1.buffer_size);
+  FUN_VALUE(d11.buffer_size);
+  FUN_AFTER(d11, d11.push_front(0));
+  FUN_VALUE(d11[5]);
+  FUN_VALUE(*(d11.end() - 7));
+  FUN_AFTER(d11, mySTL::fill(d11.begin() + 1, d11.end() - 1, 6));
+  FUN_AFTER(d11, mySTL::copy(a, a + 5, d11.begin() + 2));
+  FUN_AFTER(d11, mySTL::copy_backward(d11.begin(), d11.begin() + 5, d11.end()));
+  FUN_VALUE(mySTL::find(d11.begin(), d11.end(), 3) - d11.begin());
+  FUN_VALUE((mySTL::equal(a, a + 3, d11.end() - 3)));
   PASSED;
 #if PERFORMANCE_TEST_ON
   std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
@@ -87,6 +105,30 @@ void deque_test()
   CON_TEST_P1(deque<int>, push_back, rand(), SCALE_LL(LEN1), SCALE_LL(LEN2), SCALE_LL(LEN3));
 #else
   CON_TEST_P1(deque<int>, push_back, rand(), SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3));
+#endif
+  std::cout << std::endl;
+  std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+  std::cout << "|   random access     |";
+#if LARGER_TEST_DATA_ON
+  DEQUE_RANDOM_TEST(SCALE_LL(LEN1), SCALE_LL(LEN2), SCALE_LL(LEN3));
+#else
+  DEQUE_RANDOM_TEST(SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3));
+#endif
+  std::cout << std::endl;
+  std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+  std::cout << "| push_back+pop_front |";
+#if LARGER_TEST_DATA_ON
+  DEQUE_FIFO_TEST(SCALE_LL(LEN1), SCALE_LL(LEN2), SCALE_LL(LEN3));
+#else
+  DEQUE_FIFO_TEST(SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3));
+#endif
+  std::cout << std::endl;
+  std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+  std::cout << "|   copy to array     |";
+#if LARGER_TEST_DATA_ON
+  DEQUE_COPY_TEST(SCALE_LL(LEN1), SCALE_LL(LEN2), SCALE_LL(LEN3));
+#else
+  DEQUE_COPY_TEST(SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3));
 #endif
   std::cout << std::endl;
   std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
@@ -5,6 +5,8 @@
 
 #include <list>
 
+#include "../mySTL/allocator/pool_allocator.h"
+#include "../mySTL/allocator/thread_cache_allocator.h"
 #include "../mySTL/container/sequence/list.h"
 #include "test.h"
 
@@ -12,6 +14,18 @@ namespace mySTL
 {
 namespace test
 {
+namespace pool
+{
+template <class T>
+using list = mySTL::list<T, mySTL::pool_allocator<T>>;
+} // namespace pool
+
+namespace tcache
+{
+template <class T>
+using list = mySTL::list<T, mySTL::thread_cache_allocator<T>>;
+} // namespace tcache
+
 namespace list_test
 {
 
@@ -37,8 +51,14 @@ void list_test()
   l9 = std::move(l3);
   mySTL::list<int> l10;
   l10 = { 1, 2, 2, 3, 5, 6, 7, 8, 9 };
+  mySTL::list<int, mySTL::pool_allocator<int>> l11(a, a + 5);
+  mySTL::list<int, mySTL::thread_cache_allocator<int>> l12(a, a + 5);
 
   FUN_AFTER(l1, l1.assign(8, 8));
+  FUN_AFTER(l11, l11.splice(l11.end(), l11, l11.begin()));
+  FUN_AFTER(l11, l11.sort());
+  FUN_AFTER(l12, std::thread([&] { l12.clear(); }).join());
+  FUN_AFTER(l12, l12.assign(a, a + 5));
   FUN_AFTER(l1, l1.assign(a, a + 5));
   FUN_AFTER(l1, l1.assign({ 1,2,3,4,5,6 }));
   FUN_AFTER(l1, l1.insert(l1.end(), 6));
@@ -103,6 +123,14 @@ void list_test()
   LIST_SORT_TEST(SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
 #else
   LIST_SORT_TEST(SCALE_S(LEN1), SCALE_S(LEN2), SCALE_S(LEN3));
+#endif
+  std::cout << std::endl;
+  std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+  std::cout << "|    cross-thread     |";
+#if LARGER_TEST_DATA_ON
+  LIST_XTHREAD_TEST(SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3));
+#else
+  LIST_XTHREAD_TEST(SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
 #endif
   std::cout << std::endl;
   std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
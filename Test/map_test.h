@@ -5,7 +5,10 @@
 
 #include <map>
 
+#include "../mySTL/allocator/memory_resource.h"
+#include "../mySTL/allocator/pool_allocator.h"
 #include "../mySTL/container/associative/map.h"
+#include "../mySTL/container/sequence/basic_string.h"
 #include "../mySTL/container/sequence/vector.h"
 #include "test.h"
 
@@ -13,6 +16,17 @@ namespace mySTL
 {
 namespace test
 {
+namespace pool
+{
+using mySTL::make_pair;
+
+template <class Key, class T>
+using map = mySTL::map<Key, T, mySTL::less<Key>, mySTL::pool_allocator<mySTL::pair<const Key, T>>>;
+
+template <class Key, class T>
+using multimap = mySTL::multimap<Key, T, mySTL::less<Key>, mySTL::pool_allocator<mySTL::pair<const Key, T>>>;
+} // namespace pool
+
 namespace map_test
 {
 
@@ -63,6 +77,12 @@ void map_test()
   mySTL::map<int, int> m9{ PAIR(1,1),PAIR(3,2),PAIR(2,3) };
   mySTL::map<int, int> m10;
   m10 = { PAIR(1,1),PAIR(3,2),PAIR(2,3) };
+  mySTL::pmr::unsynchronized_pool_resource pool_res;
+  mySTL::map<int, int, mySTL::less<int>, mySTL::pmr::polymorphic_allocator<PAIR>> m11(&pool_res);
+  typedef mySTL::basic_string<char, mySTL::char_traits<char>,
+                              mySTL::pmr::polymorphic_allocator<char>> pmr_string;
+  typedef mySTL::pair<const int, pmr_string> pmr_pair;
+  mySTL::map<int, pmr_string, mySTL::less<int>, mySTL::pmr::polymorphic_allocator<pmr_pair>> m12(&pool_res);
 
   for (int i = 5; i > 0; --i)
   {
@@ -92,6 +112,16 @@ void map_test()
   MAP_FUN_AFTER(m1, m1.erase(m1.begin(), m1.find(3)));
   MAP_FUN_AFTER(m1, m1.clear());
   MAP_FUN_AFTER(m1, m1.swap(m9));
+  MAP_FUN_AFTER(m11, m11.insert(v.begin(), v.end()));
+  MAP_FUN_AFTER(m11, m11.erase(m11.begin()));
+  m12.insert(pmr_pair(1, pmr_string("one")));
+  m12[2] = "two";
+  m12.emplace(3, "three");
+  std::cout << std::boolalpha;
+  FUN_VALUE((m12.at(1).get_allocator().resource() == &pool_res));
+  FUN_VALUE((m12.at(2).get_allocator().resource() == &pool_res));
+  FUN_VALUE((m12.at(3).get_allocator().resource() == &pool_res));
+  std::cout << std::noboolalpha;
   MAP_VALUE(*m1.begin());
   MAP_VALUE(*m1.rbegin());
   FUN_VALUE(m1[1]);
@@ -109,8 +139,10 @@ void map_test()
   std::cout << "|       emplace       |";
 #if LARGER_TEST_DATA_ON
   MAP_EMPLACE_TEST(map, SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3));
+  MAP_EMPLACE_POOL_TEST(map, SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3));
 #else
   MAP_EMPLACE_TEST(map, SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+  MAP_EMPLACE_POOL_TEST(map, SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
 #endif
   std::cout << std::endl;
   std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
@@ -185,8 +217,10 @@ void multimap_test()
   std::cout << "|       emplace       |";
 #if LARGER_TEST_DATA_ON
   MAP_EMPLACE_TEST(multimap, SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+  MAP_EMPLACE_POOL_TEST(multimap, SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
 #else
   MAP_EMPLACE_TEST(multimap, SCALE_S(LEN1), SCALE_S(LEN2), SCALE_S(LEN3));
+  MAP_EMPLACE_POOL_TEST(multimap, SCALE_S(LEN1), SCALE_S(LEN2), SCALE_S(LEN3));
 #endif
   std::cout << std::endl;
   std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
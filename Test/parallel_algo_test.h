@@ -0,0 +1,164 @@
+#ifndef MYTINYSTL_PARALLEL_ALGO_TEST_H_
+#define MYTINYSTL_PARALLEL_ALGO_TEST_H_
+
+// parallel algo test : 测试带执行策略的算法的接口与 seq / par / par_unseq 的性能
+
+#include <functional>
+#include <vector>
+
+#include "../mySTL/algorithm/parallel_algo.h"
+#include "../mySTL/container/sequence/list.h"
+#include "test.h"
+
+namespace mySTL
+{
+namespace test
+{
+
+// 性能测试中使用的算法，v 中已经放入 n 个随机数
+namespace exec_sort
+{
+template <class ExecutionPolicy>
+void run(ExecutionPolicy&& policy, int* v, size_t n)
+{
+  mySTL::sort(policy, v, v + n);
+}
+} // namespace exec_sort
+
+namespace exec_stable_sort
+{
+template <class ExecutionPolicy>
+void run(ExecutionPolicy&& policy, int* v, size_t n)
+{
+  mySTL::stable_sort(policy, v, v + n);
+}
+} // namespace exec_stable_sort
+
+namespace exec_transform
+{
+template <class ExecutionPolicy>
+void run(ExecutionPolicy&& policy, int* v, size_t n)
+{
+  mySTL::transform(policy, v, v + n, v, [](int x) { return x * 3 + 1; });
+}
+} // namespace exec_transform
+
+namespace exec_reduce
+{
+template <class ExecutionPolicy>
+void run(ExecutionPolicy&& policy, int* v, size_t n)
+{
+  volatile long long sink = mySTL::reduce(policy, v, v + n, 0LL);
+  (void)sink;
+}
+} // namespace exec_reduce
+
+namespace exec_scan
+{
+template <class ExecutionPolicy>
+void run(ExecutionPolicy&& policy, int* v, size_t n)
+{
+  // 按位异或满足结合律，不会溢出
+  mySTL::inclusive_scan(policy, v, v + n, v, std::bit_xor<int>());
+}
+} // namespace exec_scan
+
+namespace parallel_algo_test
+{
+
+void parallel_algo_test()
+{
+  std::cout << "[===============================================================]\n";
+  std::cout << "[------------- Run algorithm test : parallel algo --------------]\n";
+  std::cout << "[-------------------------- API test ---------------------------]\n";
+  const size_t n = 100000;
+  std::vector<int> v(n), w(n);
+  for (size_t i = 0; i < n; ++i)
+    v[i] = static_cast<int>((i * 7919) % 10007);
+  int* first = v.data();
+  int* last = v.data() + n;
+  mySTL::list<int> l;
+  for (int i = 0; i < 10; ++i)
+    l.push_back(i % 4);
+
+  FUN_VALUE(mySTL::count_if(mySTL::execution::par, first, last,
+                            [](int x) { return x % 2 == 0; }));
+  FUN_VALUE(*mySTL::find_if(mySTL::execution::par, first, last,
+                            [](int x) { return x > 10000; }));
+  FUN_VALUE(mySTL::reduce(mySTL::execution::seq, first, last, 0LL));
+  FUN_VALUE(mySTL::reduce(mySTL::execution::par, first, last, 0LL));
+  FUN_VALUE(mySTL::reduce(mySTL::execution::par_unseq, first, last, 0LL));
+  FUN_VALUE(mySTL::inner_product(mySTL::execution::par_unseq, first, first + 1000, first, 0LL));
+  FUN_VALUE(mySTL::count_if(mySTL::execution::par, l.begin(), l.end(),
+                            [](int x) { return x == 0; }));
+  mySTL::transform(mySTL::execution::par_unseq, first, last, w.data(),
+                   [](int x) { return x * 2; });
+  FUN_VALUE(w[99999]);
+  mySTL::inclusive_scan(mySTL::execution::par, first, last, w.data());
+  FUN_VALUE(w[99999]);
+  mySTL::sort(mySTL::execution::par, first, last);
+  std::cout << std::boolalpha;
+  FUN_VALUE(mySTL::is_sorted(first, last));
+  mySTL::sort(mySTL::execution::par_unseq, first, last, std::greater<int>());
+  FUN_VALUE(mySTL::is_sorted(first, last, std::greater<int>()));
+  mySTL::stable_sort(mySTL::execution::par, first, last);
+  FUN_VALUE(mySTL::is_sorted(first, last));
+  std::cout << std::noboolalpha;
+  mySTL::fill(mySTL::execution::par, first, first + n / 2, 1);
+  FUN_VALUE(mySTL::count(first, last, 1));
+  FUN_VALUE(mySTL::remove_if(mySTL::execution::par, first, last,
+                             [](int x) { return x == 1; }) - first);
+  FUN_VALUE(mySTL::unique(mySTL::execution::par, first, first + n / 2) - first);
+  PASSED;
+#if PERFORMANCE_TEST_ON
+  std::cout << "[--------------------- Performance Testing ---------------------]\n";
+  std::cout << "|---------------------|-------------|-------------|-------------|\n";
+  std::cout << "|    sort (policy)    |";
+#if LARGER_TEST_DATA_ON
+  EXECUTION_TEST(exec_sort, SCALE_LL(LEN1), SCALE_LL(LEN2), SCALE_LL(LEN3));
+#else
+  EXECUTION_TEST(exec_sort, SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3));
+#endif
+  std::cout << "\n";
+  std::cout << "|---------------------|-------------|-------------|-------------|\n";
+  std::cout << "| stable_sort(policy) |";
+#if LARGER_TEST_DATA_ON
+  EXECUTION_TEST(exec_stable_sort, SCALE_LL(LEN1), SCALE_LL(LEN2), SCALE_LL(LEN3));
+#else
+  EXECUTION_TEST(exec_stable_sort, SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3));
+#endif
+  std::cout << "\n";
+  std::cout << "|---------------------|-------------|-------------|-------------|\n";
+  std::cout << "| transform (policy)  |";
+#if LARGER_TEST_DATA_ON
+  EXECUTION_TEST(exec_transform, SCALE_LL(LEN1), SCALE_LL(LEN2), SCALE_LL(LEN3));
+#else
+  EXECUTION_TEST(exec_transform, SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3));
+#endif
+  std::cout << "\n";
+  std::cout << "|---------------------|-------------|-------------|-------------|\n";
+  std::cout << "|   reduce (policy)   |";
+#if LARGER_TEST_DATA_ON
+  EXECUTION_TEST(exec_reduce, SCALE_LL(LEN1), SCALE_LL(LEN2), SCALE_LL(LEN3));
+#else
+  EXECUTION_TEST(exec_reduce, SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3));
+#endif
+  std::cout << "\n";
+  std::cout << "|---------------------|-------------|-------------|-------------|\n";
+  std::cout << "|    scan (policy)    |";
+#if LARGER_TEST_DATA_ON
+  EXECUTION_TEST(exec_scan, SCALE_LL(LEN1), SCALE_LL(LEN2), SCALE_LL(LEN3));
+#else
+  EXECUTION_TEST(exec_scan, SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3));
+#endif
+  std::cout << "\n";
+  std::cout << "|---------------------|-------------|-------------|-------------|\n";
+  PASSED;
+#endif
+  std::cout << "[------------- End algorithm test : parallel algo --------------]\n";
+}
+
+} // namespace parallel_algo_test
+} // namespace test
+} // namespace mySTL
+#endif // !MYTINYSTL_PARALLEL_ALGO_TEST_H_
@@ -0,0 +1,140 @@
+#ifndef MYTINYSTL_SMALL_VECTOR_TEST_H_
+#define MYTINYSTL_SMALL_VECTOR_TEST_H_
+
+// small_vector test : 测试 small_vector 的接口与大量短数组 push_back 的性能
+
+#include <vector>
+
+#include "../mySTL/allocator/memory_resource.h"
+#include "../mySTL/container/sequence/basic_string.h"
+#include "../mySTL/container/sequence/small_vector.h"
+#include "../mySTL/container/sequence/static_vector.h"
+#include "../mySTL/container/sequence/vector.h"
+#include "test.h"
+
+namespace mySTL
+{
+namespace test
+{
+namespace small
+{
+template <class T>
+using vector = mySTL::small_vector<T, SMALL_VECTOR_BATCH>;
+} // namespace small
+
+namespace fixed
+{
+template <class T>
+using vector = mySTL::static_vector<T, SMALL_VECTOR_BATCH>;
+} // namespace fixed
+
+namespace small_vector_test
+{
+
+void small_vector_test()
+{
+  std::cout << "[===============================================================]\n";
+  std::cout << "[-------------- Run container test : small_vector --------------]\n";
+  std::cout << "[-------------------------- API test ---------------------------]\n";
+  int a[] = { 1,2,3,4,5 };
+  mySTL::small_vector<int, 8> v1;
+  mySTL::small_vector<int, 8> v2(10);
+  mySTL::small_vector<int, 8> v3(10, 1);
+  mySTL::small_vector<int, 8> v4(a, a + 5);
+  mySTL::small_vector<int, 8> v5(v2);
+  mySTL::small_vector<int, 8> v6(std::move(v2));
+  mySTL::small_vector<int, 8> v7{ 1,2,3,4,5,6,7,8,9 };
+  mySTL::small_vector<int, 8> v8, v9, v10;
+  v8 = v3;
+  v9 = std::move(v3);
+  v10 = { 1,2,3,4,5,6,7,8,9 };
+  mySTL::small_vector<int, 8> v11(v4, v4.get_allocator());
+  mySTL::small_vector<int, 8> v12(std::move(v11), mySTL::allocator<int>());
+  mySTL::small_vector<std::string, 2> v13{ "a", "b" };
+  typedef mySTL::basic_string<char, mySTL::char_traits<char>,
+                              mySTL::pmr::polymorphic_allocator<char>> pmr_string;
+  typedef mySTL::small_vector<pmr_string, 2, mySTL::pmr::polymorphic_allocator<pmr_string>> pmr_small;
+  mySTL::pmr::unsynchronized_pool_resource pool;
+  pmr_small v14(1, "pool", &pool);
+
+  FUN_AFTER(v1, v1.assign(8, 8));
+  FUN_AFTER(v1, v1.assign(a, a + 5));
+  FUN_AFTER(v1, v1.emplace(v1.begin(), 0));
+  FUN_AFTER(v1, v1.emplace_back(6));
+  FUN_AFTER(v1, v1.push_back(6));
+  FUN_AFTER(v1, v1.insert(v1.end(), 7));
+  FUN_AFTER(v1, v1.insert(v1.begin() + 3, 2, 3));
+  FUN_AFTER(v1, v1.insert(v1.begin(), a, a + 5));
+  FUN_AFTER(v1, v1.pop_back());
+  FUN_AFTER(v1, v1.erase(v1.begin()));
+  FUN_AFTER(v1, v1.erase(v1.begin(), v1.begin() + 2));
+  FUN_AFTER(v1, v1.reverse());
+  FUN_AFTER(v1, v1.swap(v4));
+  FUN_AFTER(v12, v12.swap(v7));
+  FUN_AFTER(v13, v13.push_back("c"));
+  FUN_AFTER(v13, v13.insert(v13.begin(), "d"));
+  FUN_AFTER(v14, v14.insert(v14.begin(), 3, "n"));
+  FUN_AFTER(v14, v14.push_back("x"));
+  pmr_small v15(v14, &pool);
+  std::cout << std::boolalpha;
+  FUN_VALUE((v14.front().get_allocator().resource() == &pool));
+  FUN_VALUE((v14.back().get_allocator().resource() == &pool));
+  FUN_VALUE((v15[2].get_allocator().resource() == &pool));
+  std::cout << std::noboolalpha;
+  FUN_VALUE(*v1.begin());
+  FUN_VALUE(*(v1.end() - 1));
+  FUN_VALUE(*v1.rbegin());
+  FUN_VALUE(*(v1.rend() - 1));
+  FUN_VALUE(v1.front());
+  FUN_VALUE(v1.back());
+  FUN_VALUE(v1[0]);
+  FUN_VALUE(v1.at(1));
+  std::cout << std::boolalpha;
+  FUN_VALUE(v1.empty());
+  FUN_VALUE(v1.is_inline());
+  FUN_VALUE(v4.is_inline());
+  FUN_VALUE((v5 == v6));
+  FUN_VALUE((v7 < v12));
+  std::cout << std::noboolalpha;
+  FUN_VALUE(v1.size());
+  FUN_VALUE(v1.capacity());
+  FUN_AFTER(v1, v1.resize(10));
+  FUN_VALUE(v1.size());
+  FUN_VALUE(v1.capacity());
+  FUN_AFTER(v1, v1.resize(6, 6));
+  FUN_VALUE(v1.size());
+  FUN_VALUE(v1.capacity());
+  FUN_AFTER(v1, v1.shrink_to_fit());
+  std::cout << std::boolalpha;
+  FUN_VALUE(v1.is_inline());
+  std::cout << std::noboolalpha;
+  FUN_VALUE(v1.size());
+  FUN_VALUE(v1.capacity());
+  FUN_AFTER(v1, v1.clear());
+  FUN_VALUE(v1.size());
+  FUN_VALUE(v1.capacity());
+  FUN_AFTER(v1, v1.reserve(20));
+  FUN_VALUE(v1.size());
+  FUN_VALUE(v1.capacity());
+  PASSED;
+#if PERFORMANCE_TEST_ON
+  std::cout << "[--------------------- Performance Testing ---------------------]\n";
+  std::cout << "|---------------------|-------------|-------------|-------------|\n";
+  std::cout << "|   8 x push_back     |";
+#if LARGER_TEST_DATA_ON
+  SMALL_VECTOR_TEST(SCALE_LL(LEN1), SCALE_LL(LEN2), SCALE_LL(LEN3));
+#else
+  SMALL_VECTOR_TEST(SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3));
+#endif
+  std::cout << "\n";
+  std::cout << "|---------------------|-------------|-------------|-------------|\n";
+  PASSED;
+#endif
+  std::cout << "[-------------- End container test : small_vector --------------]\n";
+}
+
+} // namespace small_vector_test
+} // namespace test
+} // namespace mySTL
+#endif // !MYTINYSTL_SMALL_VECTOR_TEST_H_
+
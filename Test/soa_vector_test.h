@@ -0,0 +1,170 @@
+#ifndef MYTINYSTL_SOA_VECTOR_TEST_H_
+#define MYTINYSTL_SOA_VECTOR_TEST_H_
+
+// soa_vector test : 测试 soa_vector 的接口与只读取两个字段的打分循环的性能
+
+#include <tuple>
+#include <vector>
+
+#include "../mySTL/allocator/memory_resource.h"
+#include "../mySTL/container/sequence/soa_vector.h"
+#include "../mySTL/container/sequence/vector.h"
+#include "test.h"
+
+namespace mySTL
+{
+namespace test
+{
+
+// 9 个字段的记录
+struct score_record
+{
+  int id;
+  float score;
+  float weight;
+  double price;
+  double volume;
+  long long stamp;
+  int category;
+  double lat;
+  double lon;
+};
+
+inline score_record make_record(size_t i)
+{
+  return score_record{ static_cast<int>(i), static_cast<float>(i % 100), static_cast<float>(i % 7),
+                       1.0 * i, 2.0 * i, static_cast<long long>(i), static_cast<int>(i % 13), 0.5, 0.25 };
+}
+
+namespace aos_std
+{
+typedef std::vector<score_record> table;
+inline void fill(table& t, size_t n)
+{
+  for (size_t i = 0; i < n; ++i)
+    t.push_back(make_record(i));
+}
+inline double score(const table& t)
+{
+  double sum = 0;
+  for (const auto& r : t)
+    sum += r.score * r.weight;
+  return sum;
+}
+} // namespace aos_std
+
+namespace aos_mystl
+{
+typedef mySTL::vector<score_record> table;
+inline void fill(table& t, size_t n)
+{
+  for (size_t i = 0; i < n; ++i)
+    t.push_back(make_record(i));
+}
+inline double score(const table& t)
+{
+  double sum = 0;
+  for (const auto& r : t)
+    sum += r.score * r.weight;
+  return sum;
+}
+} // namespace aos_mystl
+
+namespace soa
+{
+typedef mySTL::soa_vector<int, float, float, double, double, long long, int, double, double> table;
+inline void fill(table& t, size_t n)
+{
+  for (size_t i = 0; i < n; ++i)
+  {
+    const score_record r = make_record(i);
+    t.push_back(r.id, r.score, r.weight, r.price, r.volume, r.stamp, r.category, r.lat, r.lon);
+  }
+}
+inline double score(const table& t)
+{
+  const float* s = t.data<1>();
+  const float* w = t.data<2>();
+  double sum = 0;
+  for (size_t i = 0; i < t.size(); ++i)
+    sum += s[i] * w[i];
+  return sum;
+}
+} // namespace soa
+
+namespace soa_vector_test
+{
+
+void soa_vector_test()
+{
+  std::cout << "[===============================================================]\n";
+  std::cout << "[--------------- Run container test : soa_vector ---------------]\n";
+  std::cout << "[-------------------------- API test ---------------------------]\n";
+  mySTL::soa_vector<int, double> v1;
+  mySTL::soa_vector<int, double> v2(5);
+  mySTL::soa_vector<int, double> v3(5, 1, 0.5);
+  mySTL::soa_vector<int, double> v4(v3);
+  mySTL::soa_vector<int, double> v5(std::move(v3));
+  mySTL::soa_vector<int, std::string> v6;
+  mySTL::pmr::unsynchronized_pool_resource pool;
+  mySTL::basic_soa_vector<mySTL::pmr::polymorphic_allocator<char>, int, double> v7(&pool);
+  v2 = v4;
+
+  FUN_AFTER(v1.column<0>(), v1.push_back(1, 1.5));
+  FUN_AFTER(v1.column<0>(), v1.push_back(std::make_tuple(2, 2.5)));
+  FUN_AFTER(v1.column<0>(), v1.emplace_back(3, 3.5));
+  FUN_AFTER(v1.column<1>(), v1.emplace_back(4, 4.5));
+  FUN_AFTER(v1.column<1>(), v1.resize(6, 5, 5.5));
+  FUN_AFTER(v1.column<0>(), v1.erase(v1.begin() + 1));
+  FUN_AFTER(v1.column<0>(), v1.pop_back());
+  FUN_AFTER(v1.column<0>(), v1.swap(v5));
+  FUN_AFTER(v1.column<0>(), v1.swap(v5));
+  FUN_AFTER(v1.column<1>(), for (auto row : v1) std::get<1>(row) *= 2);
+  FUN_AFTER(v6.column<1>(), v6.emplace_back(1, "a"));
+  FUN_AFTER(v6.column<1>(), v6.emplace_back(2, std::get<1>(v6[0])));
+  FUN_AFTER(v7.column<1>(), v7.emplace_back(1, 1.5));
+  FUN_VALUE((v7.get_allocator().resource() == &pool));
+  FUN_VALUE(std::get<0>(*v1.begin()));
+  FUN_VALUE(std::get<0>(*(v1.end() - 1)));
+  FUN_VALUE(std::get<0>(*v1.rbegin()));
+  FUN_VALUE(std::get<0>(v1.front()));
+  FUN_VALUE(std::get<1>(v1.back()));
+  FUN_VALUE(std::get<1>(v1[1]));
+  FUN_VALUE(std::get<0>(v1.at(2)));
+  FUN_VALUE(v1.get<1>(0));
+  FUN_VALUE(v1.column<1>().size_bytes());
+  std::cout << std::boolalpha;
+  FUN_VALUE(v1.empty());
+  std::cout << std::noboolalpha;
+  FUN_VALUE(v1.size());
+  FUN_VALUE(v1.capacity());
+  FUN_AFTER(v1.column<0>(), v1.shrink_to_fit());
+  FUN_VALUE(v1.capacity());
+  FUN_AFTER(v1.column<0>(), v1.resize(2));
+  FUN_VALUE(v1.size());
+  FUN_AFTER(v1.column<0>(), v1.clear());
+  FUN_VALUE(v1.size());
+  FUN_AFTER(v1.column<0>(), v1.reserve(20));
+  FUN_VALUE(v1.capacity());
+  PASSED;
+#if PERFORMANCE_TEST_ON
+  std::cout << "[--------------------- Performance Testing ---------------------]\n";
+  std::cout << "|---------------------|-------------|-------------|-------------|\n";
+  std::cout << "| score * weight      |";
+#if LARGER_TEST_DATA_ON
+  SOA_SCORE_TEST(SCALE_LL(LEN1), SCALE_LL(LEN2), SCALE_LL(LEN3));
+#else
+  SOA_SCORE_TEST(SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3));
+#endif
+  std::cout << "\n";
+  std::cout << "|---------------------|-------------|-------------|-------------|\n";
+  PASSED;
+#endif
+  std::cout << "[--------------- End container test : soa_vector ---------------]\n";
+}
+
+} // namespace soa_vector_test
+} // namespace test
+} // namespace mySTL
+#endif // !MYTINYSTL_SOA_VECTOR_TEST_H_
+
@@ -0,0 +1,99 @@
+#ifndef MYTINYSTL_STATIC_VECTOR_TEST_H_
+#define MYTINYSTL_STATIC_VECTOR_TEST_H_
+
+// static_vector test : 测试 static_vector 的接口，性能对比见 small_vector test
+
+#include "../mySTL/container/sequence/static_vector.h"
+#include "test.h"
+
+namespace mySTL
+{
+namespace test
+{
+namespace static_vector_test
+{
+
+// 放在其他结构体中的定长缓冲区
+struct packet
+{
+  int id;
+  mySTL::static_vector<char, 16> payload;
+};
+
+void static_vector_test()
+{
+  std::cout << "[===============================================================]\n";
+  std::cout << "[------------- Run container test : static_vector --------------]\n";
+  std::cout << "[-------------------------- API test ---------------------------]\n";
+  int a[] = { 1,2,3,4,5 };
+  mySTL::static_vector<int, 16> v1;
+  mySTL::static_vector<int, 16> v2(10);
+  mySTL::static_vector<int, 16> v3(10, 1);
+  mySTL::static_vector<int, 16> v4(a, a + 5);
+  mySTL::static_vector<int, 16> v5(v2);
+  mySTL::static_vector<int, 16> v6(std::move(v2));
+  mySTL::static_vector<int, 16> v7{ 1,2,3,4,5,6,7,8,9 };
+  mySTL::static_vector<int, 16> v8, v9, v10;
+  v8 = v3;
+  v9 = std::move(v3);
+  v10 = { 1,2,3,4,5,6,7,8,9 };
+  mySTL::static_vector<std::string, 4> v11{ "a", "b" };
+  packet p1{ 1, { 'a','b','c' } };
+  packet p2 = p1;
+
+  FUN_AFTER(v1, v1.assign(8, 8));
+  FUN_AFTER(v1, v1.assign(a, a + 5));
+  FUN_AFTER(v1, v1.emplace(v1.begin(), 0));
+  FUN_AFTER(v1, v1.emplace_back(6));
+  FUN_AFTER(v1, v1.push_back(6));
+  FUN_AFTER(v1, v1.insert(v1.end(), 7));
+  FUN_AFTER(v1, v1.insert(v1.begin() + 3, 2, 3));
+  FUN_AFTER(v1, v1.insert(v1.begin(), a, a + 5));
+  FUN_AFTER(v1, v1.pop_back());
+  FUN_AFTER(v1, v1.erase(v1.begin()));
+  FUN_AFTER(v1, v1.erase(v1.begin(), v1.begin() + 2));
+  FUN_AFTER(v1, v1.reverse());
+  FUN_AFTER(v1, v1.swap(v4));
+  FUN_AFTER(v11, v11.insert(v11.begin(), "c"));
+  FUN_AFTER(p2.payload, p2.payload.push_back('d'));
+  FUN_VALUE(*v1.begin());
+  FUN_VALUE(*(v1.end() - 1));
+  FUN_VALUE(*v1.rbegin());
+  FUN_VALUE(*(v1.rend() - 1));
+  FUN_VALUE(v1.front());
+  FUN_VALUE(v1.back());
+  FUN_VALUE(v1[0]);
+  FUN_VALUE(v1.at(1));
+  std::cout << std::boolalpha;
+  FUN_VALUE(v1.empty());
+  FUN_VALUE(v1.full());
+  FUN_VALUE((v5 == v6));
+  FUN_VALUE((p1.payload < p2.payload));
+  std::cout << std::noboolalpha;
+  FUN_VALUE(v1.size());
+  FUN_VALUE(v1.max_size());
+  FUN_VALUE(v1.capacity());
+  FUN_AFTER(v1, v1.resize(16));
+  FUN_VALUE(v1.size());
+  try
+  {
+    v1.push_back(17);
+  }
+  catch (const std::length_error& e)
+  {
+    std::cout << " v1.push_back(17) : " << e.what() << "\n";
+  }
+  FUN_AFTER(v1, v1.resize(6, 6));
+  FUN_VALUE(v1.size());
+  FUN_AFTER(v1, v1.clear());
+  FUN_VALUE(v1.size());
+  FUN_VALUE(v1.capacity());
+  PASSED;
+  std::cout << "[------------- End container test : static_vector --------------]\n";
+}
+
+} // namespace static_vector_test
+} // namespace test
+} // namespace mySTL
+#endif // !MYTINYSTL_STATIC_VECTOR_TEST_H_
+
@@ -5,6 +5,7 @@
 
 #include <string>
 
+#include "../mySTL/allocator/memory_resource.h"
 #include "../mySTL/container/sequence/astring.h"
 #include "test.h"
 
@@ -38,7 +39,11 @@ void string_test()
   str11 = "123";
   mySTL::string str12;
   str12 = 'A';
+  char buf[128];
+  mySTL::pmr::monotonic_buffer_resource arena(buf, sizeof(buf));
+  mySTL::basic_string<char, mySTL::char_traits<char>, mySTL::pmr::polymorphic_allocator<char>> str13("arena", &arena);
 
+  STR_FUN_AFTER(str13, str13.append(" string"));
   STR_FUN_AFTER(str, str = 'a');
   STR_FUN_AFTER(str, str = "string");
   FUN_VALUE(*str.begin());
@@ -81,6 +86,10 @@ void string_test()
   FUN_VALUE(str.size());
   STR_FUN_AFTER(str, str.resize(20, 'x'));
   FUN_VALUE(str.size());
+  STR_FUN_AFTER(str, str.resize_default_init(12));
+  FUN_VALUE(str.size());
+  STR_FUN_AFTER(str, str.reserve_and_append(8, [](char* p, size_t n) { std::memset(p, 'y', n); return n / 2; }));
+  FUN_VALUE(str.size());
   STR_FUN_AFTER(str, str.clear());
 
   STR_FUN_AFTER(str, str = "string");
@@ -10,9 +10,17 @@
 
 #include "algorithm_performance_test.h"
 #include "algorithm_test.h"
+#include "parallel_algo_test.h"
 #include "vector_test.h"
+#include "small_vector_test.h"
+#include "static_vector_test.h"
+#include "soa_vector_test.h"
+#include "concurrent_vector_test.h"
+#include "circular_buffer_test.h"
+#include "concurrent_queue_test.h"
 #include "list_test.h"
 #include "deque_test.h"
+#include "work_stealing_deque_test.h"
 #include "queue_test.h"
 #include "stack_test.h"
 #include "map_test.h"
@@ -20,6 +28,7 @@
 #include "unordered_map_test.h"
 #include "unordered_set_test.h"
 #include "string_test.h"
+#include "thread_pool_test.h"
 
 int main()
 {
@@ -29,9 +38,17 @@ int main()
 
   RUN_ALL_TESTS();
   algorithm_performance_test::algorithm_performance_test();
+  parallel_algo_test::parallel_algo_test();
   vector_test::vector_test();
+  small_vector_test::small_vector_test();
+  static_vector_test::static_vector_test();
+  soa_vector_test::soa_vector_test();
+  concurrent_vector_test::concurrent_vector_test();
+  circular_buffer_test::circular_buffer_test();
+  concurrent_queue_test::concurrent_queue_test();
   list_test::list_test();
   deque_test::deque_test();
+  work_stealing_deque_test::work_stealing_deque_test();
   queue_test::queue_test();
   queue_test::priority_test();
   stack_test::stack_test();
@@ -44,6 +61,7 @@ int main()
   unordered_set_test::unordered_set_test();
   unordered_set_test::unordered_multiset_test();
   string_test::string_test();
+  thread_pool_test::thread_pool_test();
 
 #if defined(_MSC_VER) && defined(_DEBUG)
   _CrtDumpMemoryLeaks();
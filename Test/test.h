@@ -3,13 +3,18 @@
 
 // 一个简单的单元测试框架，定义了两个类 TestCase 和 UnitTest，以及一系列用于测试的宏
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <ctime>
 #include <cstring>
 #include <cstdio>
 #include <iostream>
 #include <iomanip>
+#include <mutex>
 #include <string>
 #include <sstream>
+#include <thread>
 #include <vector>
 
 #include "Lib/redbud/io/color.h"
@@ -631,6 +636,366 @@ void test_len(size_t len1, size_t len2, size_t len3, size_t wide)
   std::cout << std::setw(WIDE) << t;                         \
 } while(0)
 
+// 多线程测试：生产者线程构造链表后交给消费者线程析构，节点总是在另一个线程中释放
+// 多个线程同时运行，clock() 统计的是所有线程的 CPU 时间，因此这里使用墙上时间
+#define LIST_XTHREAD_THREADS 4
+#define LIST_XTHREAD_BATCH   1000
+#define LIST_XTHREAD_DO_TEST(mode, len) do {                 \
+  typedef mode::list<int> list_type;                         \
+  std::mutex mtx;                                            \
+  std::condition_variable cv;                                \
+  std::vector<list_type*> ready;                             \
+  size_t producing = LIST_XTHREAD_THREADS;                   \
+  char buf[10];                                              \
+  auto start = std::chrono::steady_clock::now();             \
+  std::vector<std::thread> threads;                          \
+  for (size_t t = 0; t < LIST_XTHREAD_THREADS; ++t)          \
+  {                                                          \
+    threads.emplace_back([&] {                               \
+      for (size_t i = 0; i < len / LIST_XTHREAD_THREADS;     \
+           i += LIST_XTHREAD_BATCH)                          \
+      {                                                      \
+        list_type* l = new list_type;                        \
+        for (size_t j = 0; j < LIST_XTHREAD_BATCH; ++j)      \
+          l->push_back(static_cast<int>(j));                 \
+        std::lock_guard<std::mutex> lock(mtx);               \
+        ready.push_back(l);                                  \
+        cv.notify_one();                                     \
+      }                                                      \
+      std::lock_guard<std::mutex> lock(mtx);                 \
+      --producing;                                           \
+      cv.notify_all();                                       \
+    });                                                      \
+    threads.emplace_back([&] {                               \
+      for (;;)                                               \
+      {                                                      \
+        list_type* l = nullptr;                              \
+        {                                                    \
+          std::unique_lock<std::mutex> lock(mtx);            \
+          cv.wait(lock, [&] {                                \
+            return !ready.empty() || producing == 0; });     \
+          if (ready.empty())                                 \
+            break;                                           \
+          l = ready.back();                                  \
+          ready.pop_back();                                  \
+        }                                                    \
+        delete l;                                            \
+      }                                                      \
+    });                                                      \
+  }                                                          \
+  for (auto& th : threads)                                   \
+    th.join();                                               \
+  auto end = std::chrono::steady_clock::now();               \
+  int n = static_cast<int>(std::chrono::duration_cast<       \
+      std::chrono::milliseconds>(end - start).count());      \
+  std::snprintf(buf, sizeof(buf), "%d", n);                  \
+  std::string t = buf;                                       \
+  t += "ms    |";                                            \
+  std::cout << std::setw(WIDE) << t;                         \
+} while(0)
+
+// 大量短小的数组：每个数组只放 SMALL_VECTOR_BATCH 个元素，随后立即析构
+// mode::vector 为定义在对应命名空间中的容器别名，累加结果防止循环被优化掉
+#define SMALL_VECTOR_BATCH 8
+#define SMALL_VECTOR_DO_TEST(mode, len) do {                 \
+  clock_t start, end;                                        \
+  char buf[10];                                              \
+  size_t sum = 0;                                            \
+  start = clock();                                           \
+  for (size_t i = 0; i < len / SMALL_VECTOR_BATCH; ++i)      \
+  {                                                          \
+    mode::vector<int> v;                                     \
+    for (size_t j = 0; j < SMALL_VECTOR_BATCH; ++j)          \
+      v.push_back(static_cast<int>(i + j));                  \
+    sum += v.size() + static_cast<size_t>(v.back());         \
+  }                                                          \
+  end = clock();                                             \
+  volatile size_t sink = sum;                                \
+  (void)sink;                                                \
+  int n = static_cast<int>(static_cast<double>(end - start)  \
+      / CLOCKS_PER_SEC * 1000);                              \
+  std::snprintf(buf, sizeof(buf), "%d", n);                  \
+  std::string t = buf;                                       \
+  t += "ms    |";                                            \
+  std::cout << std::setw(WIDE) << t;                         \
+} while(0)
+
+// vector<bool> 上的 count，重复 BIT_COUNT_REPEAT 次
+#define BIT_COUNT_REPEAT 100
+#define BIT_COUNT_DO_TEST(mode, len) do {                    \
+  srand((int)time(0));                                       \
+  clock_t start, end;                                        \
+  mode::vector<bool> v;                                      \
+  char buf[10];                                              \
+  size_t sum = 0;                                            \
+  for (size_t i = 0; i < len; ++i)                           \
+    v.push_back((rand() & 1) != 0);                          \
+  start = clock();                                           \
+  for (size_t i = 0; i < BIT_COUNT_REPEAT; ++i)              \
+    sum += mode::count(v.begin(), v.end(), true);            \
+  end = clock();                                             \
+  volatile size_t sink = sum;                                \
+  (void)sink;                                                \
+  int n = static_cast<int>(static_cast<double>(end - start)  \
+      / CLOCKS_PER_SEC * 1000);                              \
+  std::snprintf(buf, sizeof(buf), "%d", n);                  \
+  std::string t = buf;                                       \
+  t += "ms    |";                                            \
+  std::cout << std::setw(WIDE) << t;                         \
+} while(0)
+
+// 9 个字段的记录，打分循环只读取其中的 score 与 weight，重复 SOA_SCORE_REPEAT 次
+// mode 命名空间中定义 table 类型以及 fill、score 函数
+#define SOA_SCORE_REPEAT 20
+#define SOA_SCORE_DO_TEST(mode, len) do {                    \
+  clock_t start, end;                                        \
+  char buf[10];                                              \
+  mode::table c;                                             \
+  mode::fill(c, len);                                        \
+  double sum = 0;                                            \
+  start = clock();                                           \
+  for (size_t i = 0; i < SOA_SCORE_REPEAT; ++i)              \
+    sum += mode::score(c);                                   \
+  end = clock();                                             \
+  volatile double sink = sum;                                \
+  (void)sink;                                                \
+  int n = static_cast<int>(static_cast<double>(end - start)  \
+      / CLOCKS_PER_SEC * 1000);                              \
+  std::snprintf(buf, sizeof(buf), "%d", n);                  \
+  std::string t = buf;                                       \
+  t += "ms    |";                                            \
+  std::cout << std::setw(WIDE) << t;                         \
+} while(0)
+
+// 有界队列：保持 BOUNDED_QUEUE_DEPTH 个元素，push 与 pop 各 len 次
+// mode 命名空间中定义 table 类型以及 make 函数，make 返回容量足够的空队列
+#define BOUNDED_QUEUE_DEPTH 1000
+#define BOUNDED_QUEUE_DO_TEST(mode, len) do {                \
+  clock_t start, end;                                        \
+  char buf[10];                                              \
+  mode::table c = mode::make(BOUNDED_QUEUE_DEPTH + 1);       \
+  for (int i = 0; i < BOUNDED_QUEUE_DEPTH; ++i)              \
+    c.push(i);                                               \
+  start = clock();                                           \
+  for (size_t i = 0; i < len; ++i)                           \
+  {                                                          \
+    c.push(static_cast<int>(i));                             \
+    c.pop();                                                 \
+  }                                                          \
+  end = clock();                                             \
+  volatile int sink = c.front();                             \
+  (void)sink;                                                \
+  int n = static_cast<int>(static_cast<double>(end - start)  \
+      / CLOCKS_PER_SEC * 1000);                              \
+  std::snprintf(buf, sizeof(buf), "%d", n);                  \
+  std::string t = buf;                                       \
+  t += "ms    |";                                            \
+  std::cout << std::setw(WIDE) << t;                         \
+} while(0)
+
+// CONCURRENT_PUSH_THREADS 个线程同时向同一个容器 push_back，共 len 个元素
+// mode 命名空间中定义 table 类型以及 push 函数，clock() 会累加各线程的时间，这里使用墙上时间
+#define CONCURRENT_PUSH_THREADS 4
+#define CONCURRENT_PUSH_DO_TEST(mode, len) do {              \
+  char buf[10];                                              \
+  mode::table c;                                             \
+  std::vector<std::thread> workers;                          \
+  auto start = std::chrono::steady_clock::now();             \
+  for (int w = 0; w < CONCURRENT_PUSH_THREADS; ++w)          \
+    workers.emplace_back([&c, w] {                           \
+      const size_t per = len / CONCURRENT_PUSH_THREADS;      \
+      for (size_t i = 0; i < per; ++i)                       \
+        mode::push(c, static_cast<int>(w * per + i));        \
+    });                                                      \
+  for (auto& th : workers)                                   \
+    th.join();                                               \
+  auto end = std::chrono::steady_clock::now();               \
+  int n = static_cast<int>(std::chrono::duration_cast<       \
+      std::chrono::milliseconds>(end - start).count());      \
+  std::snprintf(buf, sizeof(buf), "%d", n);                  \
+  std::string t = buf;                                       \
+  t += "ms    |";                                            \
+  std::cout << std::setw(WIDE) << t;                         \
+} while(0)
+
+// 一个生产者线程经由队列向一个消费者线程传递 len 个元素，使用墙上时间
+// mode 命名空间中定义 table 类型以及 produce / consume 函数
+#define PIPELINE_DO_TEST(mode, len) do {                     \
+  char buf[10];                                              \
+  mode::table c;                                             \
+  auto start = std::chrono::steady_clock::now();             \
+  std::thread producer([&c] { mode::produce(c, len); });     \
+  volatile long long sink = mode::consume(c, len);           \
+  (void)sink;                                                \
+  producer.join();                                           \
+  auto end = std::chrono::steady_clock::now();               \
+  int n = static_cast<int>(std::chrono::duration_cast<       \
+      std::chrono::milliseconds>(end - start).count());      \
+  std::snprintf(buf, sizeof(buf), "%d", n);                  \
+  std::string t = buf;                                       \
+  t += "ms    |";                                            \
+  std::cout << std::setw(WIDE) << t;                         \
+} while(0)
+
+// 拥有者线程每轮 push 8 个、pop 4 个，WORK_STEAL_THIEVES 个线程同时从另一端窃取，共 len 个元素
+// mode 命名空间中定义 table 类型以及 push / pop / steal 函数，使用墙上时间
+#define WORK_STEAL_THIEVES 3
+#define WORK_STEAL_DO_TEST(mode, len) do {                   \
+  char buf[10];                                              \
+  mode::table c;                                             \
+  std::atomic<size_t> done(0);                               \
+  std::vector<std::thread> thieves;                          \
+  auto start = std::chrono::steady_clock::now();             \
+  for (int w = 0; w < WORK_STEAL_THIEVES; ++w)               \
+    thieves.emplace_back([&c, &done] {                       \
+      int v;                                                 \
+      while (done.load(std::memory_order_relaxed) < len)     \
+      {                                                      \
+        if (mode::steal(c, v))                               \
+          done.fetch_add(1, std::memory_order_relaxed);      \
+        else                                                 \
+          std::this_thread::yield();                         \
+      }                                                      \
+    });                                                      \
+  int v;                                                     \
+  for (size_t i = 0; i < len; )                              \
+  {                                                          \
+    for (int k = 0; k < 8 && i < len; ++k)                   \
+      mode::push(c, static_cast<int>(i++));                  \
+    for (int k = 0; k < 4; ++k)                              \
+      if (mode::pop(c, v))                                   \
+        done.fetch_add(1, std::memory_order_relaxed);        \
+  }                                                          \
+  while (mode::pop(c, v))                                    \
+    done.fetch_add(1, std::memory_order_relaxed);            \
+  for (auto& th : thieves)                                   \
+    th.join();                                               \
+  auto end = std::chrono::steady_clock::now();               \
+  int n = static_cast<int>(std::chrono::duration_cast<       \
+      std::chrono::milliseconds>(end - start).count());      \
+  std::snprintf(buf, sizeof(buf), "%d", n);                  \
+  std::string t = buf;                                       \
+  t += "ms    |";                                            \
+  std::cout << std::setw(WIDE) << t;                         \
+} while(0)
+
+// 把 len 个元素分成每块 PARALLEL_FOR_BLOCK 个，逐块调用 mode::run 做一次并行循环，使用墙上时间
+#define PARALLEL_FOR_BLOCK 65536
+#define PARALLEL_FOR_DO_TEST(mode, len) do {                 \
+  char buf[10];                                              \
+  std::vector<int> v(len, 1);                                \
+  auto start = std::chrono::steady_clock::now();             \
+  for (size_t off = 0; off < len; off += PARALLEL_FOR_BLOCK) \
+    mode::run(v.data() + off, len - off < PARALLEL_FOR_BLOCK \
+        ? len - off : PARALLEL_FOR_BLOCK);                   \
+  auto end = std::chrono::steady_clock::now();               \
+  volatile int sink = v[len / 2];                            \
+  (void)sink;                                                \
+  int n = static_cast<int>(std::chrono::duration_cast<       \
+      std::chrono::milliseconds>(end - start).count());      \
+  std::snprintf(buf, sizeof(buf), "%d", n);                  \
+  std::string t = buf;                                       \
+  t += "ms    |";                                            \
+  std::cout << std::setw(WIDE) << t;                         \
+} while(0)
+
+// 对 len 个随机数以执行策略 policy 调用一次 algo::run，使用墙上时间
+#define EXECUTION_DO_TEST(algo, policy, len) do {            \
+  srand((int)time(0));                                       \
+  char buf[10];                                              \
+  std::vector<int> v(len);                                   \
+  for (size_t i = 0; i < len; ++i)                           \
+    v[i] = rand();                                           \
+  auto start = std::chrono::steady_clock::now();             \
+  algo::run(mySTL::execution::policy, v.data(), len);        \
+  auto end = std::chrono::steady_clock::now();               \
+  volatile int sink = v[len / 2];                            \
+  (void)sink;                                                \
+  int n = static_cast<int>(std::chrono::duration_cast<       \
+      std::chrono::milliseconds>(end - start).count());      \
+  std::snprintf(buf, sizeof(buf), "%d", n);                  \
+  std::string t = buf;                                       \
+  t += "ms    |";                                            \
+  std::cout << std::setw(WIDE) << t;                         \
+} while(0)
+
+// 随机下标访问：先放入 len 个元素，再按预先生成的随机下标读取 len 次
+// chunk::deque 使用 DEQUE_CHUNK_SIZE 个元素的缓冲区
+#define DEQUE_CHUNK_SIZE 1024
+#define DEQUE_RANDOM_DO_TEST(mode, len) do {                 \
+  srand((int)time(0));                                       \
+  clock_t start, end;                                        \
+  char buf[10];                                              \
+  mode::deque<int> d;                                        \
+  std::vector<size_t> idx(len);                              \
+  for (size_t i = 0; i < len; ++i)                           \
+  {                                                          \
+    d.push_back(static_cast<int>(i));                        \
+    idx[i] = static_cast<size_t>(rand()) * RAND_MAX % len;   \
+  }                                                          \
+  long long sum = 0;                                         \
+  start = clock();                                           \
+  for (size_t i = 0; i < len; ++i)                           \
+    sum += d[idx[i]];                                        \
+  end = clock();                                             \
+  volatile long long sink = sum;                             \
+  (void)sink;                                                \
+  int n = static_cast<int>(static_cast<double>(end - start)  \
+      / CLOCKS_PER_SEC * 1000);                              \
+  std::snprintf(buf, sizeof(buf), "%d", n);                  \
+  std::string t = buf;                                       \
+  t += "ms    |";                                            \
+  std::cout << std::setw(WIDE) << t;                         \
+} while(0)
+
+// 把 deque 中的 len 个元素整体拷贝到数组，重复 DEQUE_COPY_REPEAT 次
+#define DEQUE_COPY_REPEAT 10
+#define DEQUE_COPY_DO_TEST(mode, len) do {                   \
+  clock_t start, end;                                        \
+  char buf[10];                                              \
+  mode::deque<int> d;                                        \
+  for (size_t i = 0; i < len; ++i)                           \
+    d.push_back(static_cast<int>(i));                        \
+  std::vector<int> out(len);                                 \
+  start = clock();                                           \
+  for (int r = 0; r < DEQUE_COPY_REPEAT; ++r)                \
+    mode::copy(d.begin(), d.end(), out.data());              \
+  end = clock();                                             \
+  volatile int sink = out[len / 2];                          \
+  (void)sink;                                                \
+  int n = static_cast<int>(static_cast<double>(end - start)  \
+      / CLOCKS_PER_SEC * 1000);                              \
+  std::snprintf(buf, sizeof(buf), "%d", n);                  \
+  std::string t = buf;                                       \
+  t += "ms    |";                                            \
+  std::cout << std::setw(WIDE) << t;                         \
+} while(0)
+
+// 一端进一端出的队列：保持 DEQUE_FIFO_DEPTH 个元素，push_back 与 pop_front 各 len 次
+#define DEQUE_FIFO_DEPTH 1000
+#define DEQUE_FIFO_DO_TEST(mode, len) do {                   \
+  clock_t start, end;                                        \
+  char buf[10];                                              \
+  mode::deque<int> d;                                        \
+  for (int i = 0; i < DEQUE_FIFO_DEPTH; ++i)                 \
+    d.push_back(i);                                          \
+  start = clock();                                           \
+  for (size_t i = 0; i < len; ++i)                           \
+  {                                                          \
+    d.push_back(static_cast<int>(i));                        \
+    d.pop_front();                                           \
+  }                                                          \
+  end = clock();                                             \
+  volatile int sink = d.front();                             \
+  (void)sink;                                                \
+  int n = static_cast<int>(static_cast<double>(end - start)  \
+      / CLOCKS_PER_SEC * 1000);                              \
+  std::snprintf(buf, sizeof(buf), "%d", n);                  \
+  std::string t = buf;                                       \
+  t += "ms    |";                                            \
+  std::cout << std::setw(WIDE) << t;                         \
+} while(0)
+
 #define MAP_EMPLACE_DO_TEST(mode, con, count) do {           \
   srand((int)time(0));                                       \
   clock_t start, end;                                        \
@@ -660,6 +1025,13 @@ void test_len(size_t len1, size_t len2, size_t len3, size_t wide)
   FUN_TEST_FORMAT1(mySTL::con, fun, arg, len2);              \
   FUN_TEST_FORMAT1(mySTL::con, fun, arg, len3);    
 
+// 追加一行使用其他分配器的结果，mode 为定义了同名容器别名的命名空间
+#define CON_TEST_P1_ROW(row, mode, con, fun, arg, len1, len2, len3) \
+  std::cout << "\n|" row "|";                               \
+  FUN_TEST_FORMAT1(mode::con, fun, arg, len1);               \
+  FUN_TEST_FORMAT1(mode::con, fun, arg, len2);               \
+  FUN_TEST_FORMAT1(mode::con, fun, arg, len3);
+
 #define CON_TEST_P2(con, fun, arg1, arg2, len1, len2, len3)  \
   TEST_LEN(len1, len2, len3, WIDE);                          \
   std::cout << "|         std         |";                    \
@@ -682,6 +1054,205 @@ void test_len(size_t len1, size_t len2, size_t len3, size_t wide)
   MAP_EMPLACE_DO_TEST(mySTL, con, len2);                     \
   MAP_EMPLACE_DO_TEST(mySTL, con, len3);
 
+// 使用 pool_allocator 的容器，定义在 mySTL::test::pool 中
+#define MAP_EMPLACE_POOL_TEST(con, len1, len2, len3)         \
+  std::cout << "\n|     mySTL(pool)     |";                 \
+  MAP_EMPLACE_DO_TEST(pool, con, len1);                      \
+  MAP_EMPLACE_DO_TEST(pool, con, len2);                      \
+  MAP_EMPLACE_DO_TEST(pool, con, len3);
+
+// pool / tcache 中的 list 分别使用 pool_allocator 和 thread_cache_allocator
+#define LIST_XTHREAD_TEST(len1, len2, len3)                  \
+  TEST_LEN(len1, len2, len3, WIDE);                          \
+  std::cout << "|         std         |";                    \
+  LIST_XTHREAD_DO_TEST(std, len1);                           \
+  LIST_XTHREAD_DO_TEST(std, len2);                           \
+  LIST_XTHREAD_DO_TEST(std, len3);                           \
+  std::cout << "\n|        mySTL        |";                  \
+  LIST_XTHREAD_DO_TEST(mySTL, len1);                         \
+  LIST_XTHREAD_DO_TEST(mySTL, len2);                         \
+  LIST_XTHREAD_DO_TEST(mySTL, len3);                         \
+  std::cout << "\n|     mySTL(pool)     |";                 \
+  LIST_XTHREAD_DO_TEST(pool, len1);                          \
+  LIST_XTHREAD_DO_TEST(pool, len2);                          \
+  LIST_XTHREAD_DO_TEST(pool, len3);                          \
+  std::cout << "\n|    mySTL(tcache)    |";                 \
+  LIST_XTHREAD_DO_TEST(tcache, len1);                        \
+  LIST_XTHREAD_DO_TEST(tcache, len2);                        \
+  LIST_XTHREAD_DO_TEST(tcache, len3);
+
+#define SMALL_VECTOR_TEST(len1, len2, len3)                  \
+  TEST_LEN(len1, len2, len3, WIDE);                          \
+  std::cout << "|         std         |";                    \
+  SMALL_VECTOR_DO_TEST(std, len1);                           \
+  SMALL_VECTOR_DO_TEST(std, len2);                           \
+  SMALL_VECTOR_DO_TEST(std, len3);                           \
+  std::cout << "\n|        mySTL        |";                  \
+  SMALL_VECTOR_DO_TEST(mySTL, len1);                         \
+  SMALL_VECTOR_DO_TEST(mySTL, len2);                         \
+  SMALL_VECTOR_DO_TEST(mySTL, len3);                         \
+  std::cout << "\n|    mySTL(small)     |";                  \
+  SMALL_VECTOR_DO_TEST(small, len1);                         \
+  SMALL_VECTOR_DO_TEST(small, len2);                         \
+  SMALL_VECTOR_DO_TEST(small, len3);                         \
+  std::cout << "\n|    mySTL(static)    |";                  \
+  SMALL_VECTOR_DO_TEST(fixed, len1);                         \
+  SMALL_VECTOR_DO_TEST(fixed, len2);                         \
+  SMALL_VECTOR_DO_TEST(fixed, len3);
+
+#define BIT_COUNT_TEST(len1, len2, len3)                     \
+  TEST_LEN(len1, len2, len3, WIDE);                          \
+  std::cout << "|         std         |";                    \
+  BIT_COUNT_DO_TEST(std, len1);                              \
+  BIT_COUNT_DO_TEST(std, len2);                              \
+  BIT_COUNT_DO_TEST(std, len3);                              \
+  std::cout << "\n|        mySTL        |";                  \
+  BIT_COUNT_DO_TEST(mySTL, len1);                            \
+  BIT_COUNT_DO_TEST(mySTL, len2);                            \
+  BIT_COUNT_DO_TEST(mySTL, len3);
+
+#define SOA_SCORE_TEST(len1, len2, len3)                     \
+  TEST_LEN(len1, len2, len3, WIDE);                          \
+  std::cout << "|      std(AoS)       |";                    \
+  SOA_SCORE_DO_TEST(aos_std, len1);                          \
+  SOA_SCORE_DO_TEST(aos_std, len2);                          \
+  SOA_SCORE_DO_TEST(aos_std, len3);                          \
+  std::cout << "\n|     mySTL(AoS)      |";                  \
+  SOA_SCORE_DO_TEST(aos_mystl, len1);                        \
+  SOA_SCORE_DO_TEST(aos_mystl, len2);                        \
+  SOA_SCORE_DO_TEST(aos_mystl, len3);                        \
+  std::cout << "\n|     mySTL(SoA)      |";                  \
+  SOA_SCORE_DO_TEST(soa, len1);                              \
+  SOA_SCORE_DO_TEST(soa, len2);                              \
+  SOA_SCORE_DO_TEST(soa, len3);
+
+#define BOUNDED_QUEUE_TEST(len1, len2, len3)                 \
+  TEST_LEN(len1, len2, len3, WIDE);                          \
+  std::cout << "|     std(deque)      |";                    \
+  BOUNDED_QUEUE_DO_TEST(bounded_std, len1);                  \
+  BOUNDED_QUEUE_DO_TEST(bounded_std, len2);                  \
+  BOUNDED_QUEUE_DO_TEST(bounded_std, len3);                  \
+  std::cout << "\n|    mySTL(deque)     |";                  \
+  BOUNDED_QUEUE_DO_TEST(bounded_deque, len1);                \
+  BOUNDED_QUEUE_DO_TEST(bounded_deque, len2);                \
+  BOUNDED_QUEUE_DO_TEST(bounded_deque, len3);                \
+  std::cout << "\n|   mySTL(circular)   |";                  \
+  BOUNDED_QUEUE_DO_TEST(bounded_ring, len1);                 \
+  BOUNDED_QUEUE_DO_TEST(bounded_ring, len2);                 \
+  BOUNDED_QUEUE_DO_TEST(bounded_ring, len3);
+
+#define CONCURRENT_PUSH_TEST(len1, len2, len3)               \
+  TEST_LEN(len1, len2, len3, WIDE);                          \
+  std::cout << "|     std(mutex)      |";                    \
+  CONCURRENT_PUSH_DO_TEST(locked_std, len1);                 \
+  CONCURRENT_PUSH_DO_TEST(locked_std, len2);                 \
+  CONCURRENT_PUSH_DO_TEST(locked_std, len3);                 \
+  std::cout << "\n|    mySTL(mutex)     |";                  \
+  CONCURRENT_PUSH_DO_TEST(locked_mystl, len1);               \
+  CONCURRENT_PUSH_DO_TEST(locked_mystl, len2);               \
+  CONCURRENT_PUSH_DO_TEST(locked_mystl, len3);               \
+  std::cout << "\n|  mySTL(concurrent)  |";                  \
+  CONCURRENT_PUSH_DO_TEST(concurrent, len1);                 \
+  CONCURRENT_PUSH_DO_TEST(concurrent, len2);                 \
+  CONCURRENT_PUSH_DO_TEST(concurrent, len3);
+
+#define PIPELINE_TEST(len1, len2, len3)                      \
+  TEST_LEN(len1, len2, len3, WIDE);                          \
+  std::cout << "|    mySTL(mutex)     |";                    \
+  PIPELINE_DO_TEST(pipe_mutex, len1);                        \
+  PIPELINE_DO_TEST(pipe_mutex, len2);                        \
+  PIPELINE_DO_TEST(pipe_mutex, len3);                        \
+  std::cout << "\n|        spsc         |";                  \
+  PIPELINE_DO_TEST(pipe_spsc, len1);                         \
+  PIPELINE_DO_TEST(pipe_spsc, len2);                         \
+  PIPELINE_DO_TEST(pipe_spsc, len3);                         \
+  std::cout << "\n|     spsc(batch)     |";                  \
+  PIPELINE_DO_TEST(pipe_spsc_batch, len1);                   \
+  PIPELINE_DO_TEST(pipe_spsc_batch, len2);                   \
+  PIPELINE_DO_TEST(pipe_spsc_batch, len3);                   \
+  std::cout << "\n|     mpmc(batch)     |";                  \
+  PIPELINE_DO_TEST(pipe_mpmc, len1);                         \
+  PIPELINE_DO_TEST(pipe_mpmc, len2);                         \
+  PIPELINE_DO_TEST(pipe_mpmc, len3);
+
+#define WORK_STEAL_TEST(len1, len2, len3)                    \
+  TEST_LEN(len1, len2, len3, WIDE);                          \
+  std::cout << "|    mySTL(mutex)     |";                    \
+  WORK_STEAL_DO_TEST(steal_mutex, len1);                     \
+  WORK_STEAL_DO_TEST(steal_mutex, len2);                     \
+  WORK_STEAL_DO_TEST(steal_mutex, len3);                     \
+  std::cout << "\n|   mySTL(stealing)   |";                  \
+  WORK_STEAL_DO_TEST(steal_lockfree, len1);                  \
+  WORK_STEAL_DO_TEST(steal_lockfree, len2);                  \
+  WORK_STEAL_DO_TEST(steal_lockfree, len3);
+
+#define PARALLEL_FOR_TEST(len1, len2, len3)                  \
+  TEST_LEN(len1, len2, len3, WIDE);                          \
+  std::cout << "|       serial        |";                    \
+  PARALLEL_FOR_DO_TEST(for_serial, len1);                    \
+  PARALLEL_FOR_DO_TEST(for_serial, len2);                    \
+  PARALLEL_FOR_DO_TEST(for_serial, len3);                    \
+  std::cout << "\n|   std::thread x N   |";                  \
+  PARALLEL_FOR_DO_TEST(for_threads, len1);                   \
+  PARALLEL_FOR_DO_TEST(for_threads, len2);                   \
+  PARALLEL_FOR_DO_TEST(for_threads, len3);                   \
+  std::cout << "\n|    parallel_for     |";                  \
+  PARALLEL_FOR_DO_TEST(for_pool, len1);                      \
+  PARALLEL_FOR_DO_TEST(for_pool, len2);                      \
+  PARALLEL_FOR_DO_TEST(for_pool, len3);
+
+#define EXECUTION_TEST(algo, len1, len2, len3)               \
+  TEST_LEN(len1, len2, len3, WIDE);                          \
+  std::cout << "|         seq         |";                    \
+  EXECUTION_DO_TEST(algo, seq, len1);                        \
+  EXECUTION_DO_TEST(algo, seq, len2);                        \
+  EXECUTION_DO_TEST(algo, seq, len3);                        \
+  std::cout << "\n|         par         |";                  \
+  EXECUTION_DO_TEST(algo, par, len1);                        \
+  EXECUTION_DO_TEST(algo, par, len2);                        \
+  EXECUTION_DO_TEST(algo, par, len3);                        \
+  std::cout << "\n|      par_unseq      |";                  \
+  EXECUTION_DO_TEST(algo, par_unseq, len1);                  \
+  EXECUTION_DO_TEST(algo, par_unseq, len2);                  \
+  EXECUTION_DO_TEST(algo, par_unseq, len3);
+
+#define DEQUE_RANDOM_TEST(len1, len2, len3)                  \
+  TEST_LEN(len1, len2, len3, WIDE);                          \
+  std::cout << "|         std         |";                    \
+  DEQUE_RANDOM_DO_TEST(std, len1);                           \
+  DEQUE_RANDOM_DO_TEST(std, len2);                           \
+  DEQUE_RANDOM_DO_TEST(std, len3);                           \
+  std::cout << "\n|        mySTL        |";                  \
+  DEQUE_RANDOM_DO_TEST(mySTL, len1);                         \
+  DEQUE_RANDOM_DO_TEST(mySTL, len2);                         \
+  DEQUE_RANDOM_DO_TEST(mySTL, len3);                         \
+  std::cout << "\n|    mySTL(chunk)     |";                  \
+  DEQUE_RANDOM_DO_TEST(chunk, len1);                         \
+  DEQUE_RANDOM_DO_TEST(chunk, len2);                         \
+  DEQUE_RANDOM_DO_TEST(chunk, len3);
+
+#define DEQUE_FIFO_TEST(len1, len2, len3)                    \
+  TEST_LEN(len1, len2, len3, WIDE);                          \
+  std::cout << "|         std         |";                    \
+  DEQUE_FIFO_DO_TEST(std, len1);                             \
+  DEQUE_FIFO_DO_TEST(std, len2);                             \
+  DEQUE_FIFO_DO_TEST(std, len3);                             \
+  std::cout << "\n|        mySTL        |";                  \
+  DEQUE_FIFO_DO_TEST(mySTL, len1);                           \
+  DEQUE_FIFO_DO_TEST(mySTL, len2);                           \
+  DEQUE_FIFO_DO_TEST(mySTL, len3);
+
+#define DEQUE_COPY_TEST(len1, len2, len3)                    \
+  TEST_LEN(len1, len2, len3, WIDE);                          \
+  std::cout << "|         std         |";                    \
+  DEQUE_COPY_DO_TEST(std, len1);                             \
+  DEQUE_COPY_DO_TEST(std, len2);                             \
+  DEQUE_COPY_DO_TEST(std, len3);                             \
+  std::cout << "\n|        mySTL        |";                  \
+  DEQUE_COPY_DO_TEST(mySTL, len1);                           \
+  DEQUE_COPY_DO_TEST(mySTL, len2);                           \
+  DEQUE_COPY_DO_TEST(mySTL, len3);
+
 #define LIST_SORT_TEST(len1, len2, len3)                     \
   TEST_LEN(len1, len2, len3, WIDE);                          \
   std::cout << "|         std         |";                    \
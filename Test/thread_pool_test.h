@@ -0,0 +1,142 @@
+#ifndef MYTINYSTL_THREAD_POOL_TEST_H_
+#define MYTINYSTL_THREAD_POOL_TEST_H_
+
+// thread_pool test : 测试 thread_pool、task_group、parallel_for 的接口与并行循环的性能
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "../mySTL/algorithm/algo.h"
+#include "../mySTL/util/thread_pool.h"
+#include "test.h"
+
+namespace mySTL
+{
+namespace test
+{
+
+// 对 [0, n) 中的每个元素执行 PARALLEL_FOR_BODY
+#define PARALLEL_FOR_BODY(v, b, e) \
+  for (size_t i = b; i < e; ++i) v[i] = v[i] * 3 + 1
+
+namespace for_serial
+{
+inline void run(int* v, size_t n)
+{
+  PARALLEL_FOR_BODY(v, 0, n);
+}
+} // namespace for_serial
+
+// 每次调用都创建 hardware_concurrency 个 std::thread
+namespace for_threads
+{
+inline void run(int* v, size_t n)
+{
+  const size_t k = mySTL::thread_pool::default_concurrency();
+  std::vector<std::thread> workers;
+  for (size_t w = 0; w < k; ++w)
+    workers.emplace_back([v, n, k, w] {
+      const size_t b = n * w / k, e = n * (w + 1) / k;
+      PARALLEL_FOR_BODY(v, b, e);
+    });
+  for (auto& th : workers)
+    th.join();
+}
+} // namespace for_threads
+
+namespace for_pool
+{
+inline void run(int* v, size_t n)
+{
+  mySTL::parallel_for(size_t(0), n, size_t(4096), [v](size_t b, size_t e) {
+    PARALLEL_FOR_BODY(v, b, e);
+  });
+}
+} // namespace for_pool
+
+namespace thread_pool_test
+{
+
+int fib(int n)
+{
+  if (n < 2)
+    return n;
+  int x = 0, y = 0;
+  mySTL::task_group g;
+  g.spawn([&x, n] { x = fib(n - 1); });
+  y = fib(n - 2);
+  g.wait();
+  return x + y;
+}
+
+void thread_pool_test()
+{
+  std::cout << "[===============================================================]\n";
+  std::cout << "[-------------- Run container test : thread_pool ---------------]\n";
+  std::cout << "[-------------------------- API test ---------------------------]\n";
+  mySTL::thread_pool pool(4);
+  std::vector<int> v(100000, 1);
+  std::atomic<int> count(0);
+
+  FUN_VALUE(pool.size());
+  std::cout << std::boolalpha;
+  FUN_VALUE(pool.in_worker());
+  std::cout << std::noboolalpha;
+  {
+    mySTL::task_group g(pool);
+    for (int i = 0; i < 100; ++i)
+      g.spawn([&count] { ++count; });
+    g.wait();
+    FUN_VALUE(count.load());
+  }
+  {
+    mySTL::task_group g(pool);
+    g.spawn([] { throw std::runtime_error("task failed"); });
+    try
+    {
+      g.wait();
+    }
+    catch (const std::runtime_error& e)
+    {
+      std::cout << " g.wait() : throw " << e.what() << std::endl;
+    }
+  }
+  mySTL::parallel_for(size_t(0), v.size(), size_t(1000), [&v](size_t b, size_t e) {
+    for (size_t i = b; i < e; ++i)
+      v[i] += static_cast<int>(i % 3);
+  }, pool);
+  FUN_VALUE(v[0]);
+  FUN_VALUE(v[99998]);
+  std::cout << std::boolalpha;
+  FUN_VALUE((mySTL::count(v.data(), v.data() + v.size(), 3) == 33333));
+  std::cout << std::noboolalpha;
+  count = 0;
+  mySTL::parallel_for(0, 64, 1, [&count, &pool](int b, int e) {
+    for (int i = b; i < e; ++i)
+      mySTL::parallel_for(0, 64, 8, [&count](int b2, int e2) { count += e2 - b2; }, pool);
+  }, pool);
+  FUN_VALUE(count.load());
+  FUN_VALUE(fib(20));
+  PASSED;
+#if PERFORMANCE_TEST_ON
+  std::cout << "[--------------------- Performance Testing ---------------------]\n";
+  std::cout << "|---------------------|-------------|-------------|-------------|\n";
+  std::cout << "|    parallel for     |";
+#if LARGER_TEST_DATA_ON
+  PARALLEL_FOR_TEST(SCALE_LL(LEN1), SCALE_LL(LEN2), SCALE_LL(LEN3));
+#else
+  PARALLEL_FOR_TEST(SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3));
+#endif
+  std::cout << "\n";
+  std::cout << "|---------------------|-------------|-------------|-------------|\n";
+  PASSED;
+#endif
+  std::cout << "[-------------- End container test : thread_pool ---------------]\n";
+}
+
+} // namespace thread_pool_test
+} // namespace test
+} // namespace mySTL
+#endif // !MYTINYSTL_THREAD_POOL_TEST_H_
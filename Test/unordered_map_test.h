@@ -5,6 +5,7 @@
 
 #include <unordered_map>
 
+#include "../mySTL/allocator/pool_allocator.h"
 #include "../mySTL/container/associative/unordered_map.h"
 #include "map_test.h"
 #include "test.h"
@@ -13,6 +14,19 @@ namespace mySTL
 {
 namespace test
 {
+namespace pool
+{
+using mySTL::make_pair;
+
+template <class Key, class T>
+using unordered_map = mySTL::unordered_map<Key, T, mySTL::hash<Key>, mySTL::equal_to<Key>,
+                                           mySTL::pool_allocator<mySTL::pair<const Key, T>>>;
+
+template <class Key, class T>
+using unordered_multimap = mySTL::unordered_multimap<Key, T, mySTL::hash<Key>, mySTL::equal_to<Key>,
+                                                     mySTL::pool_allocator<mySTL::pair<const Key, T>>>;
+} // namespace pool
+
 namespace unordered_map_test
 {
 
@@ -41,6 +55,12 @@ void unordered_map_test()
   mySTL::unordered_map<int, int> um13{ PAIR(1,1),PAIR(2,3),PAIR(3,3) };
   mySTL::unordered_map<int, int> um14;
   um14 = { PAIR(1,1),PAIR(2,3),PAIR(3,3) };
+  typedef mySTL::basic_string<char, mySTL::char_traits<char>,
+                              mySTL::pmr::polymorphic_allocator<char>> pmr_string;
+  typedef mySTL::pair<const int, pmr_string> pmr_pair;
+  mySTL::pmr::unsynchronized_pool_resource pool_res;
+  mySTL::unordered_map<int, pmr_string, mySTL::hash<int>, mySTL::equal_to<int>,
+                       mySTL::pmr::polymorphic_allocator<pmr_pair>> um15(&pool_res);
 
   MAP_FUN_AFTER(um1, um1.emplace(1, 1));
   MAP_FUN_AFTER(um1, um1.emplace_hint(um1.begin(), 1, 2));
@@ -50,7 +70,13 @@ void unordered_map_test()
   MAP_FUN_AFTER(um1, um1.erase(um1.begin()));
   MAP_FUN_AFTER(um1, um1.erase(um1.begin(), um1.find(3)));
   MAP_FUN_AFTER(um1, um1.erase(1));
+  um15.insert(pmr_pair(1, pmr_string("one")));
+  um15[2] = "two";
+  um15.emplace(3, "three");
   std::cout << std::boolalpha;
+  FUN_VALUE((um15.at(1).get_allocator().resource() == &pool_res));
+  FUN_VALUE((um15.at(2).get_allocator().resource() == &pool_res));
+  FUN_VALUE((um15.at(3).get_allocator().resource() == &pool_res));
   FUN_VALUE(um1.empty());
   std::cout << std::noboolalpha;
   FUN_VALUE(um1.size());
@@ -97,8 +123,10 @@ void unordered_map_test()
   std::cout << "|       emplace       |";
 #if LARGER_TEST_DATA_ON
   MAP_EMPLACE_TEST(unordered_map, SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+  MAP_EMPLACE_POOL_TEST(unordered_map, SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
 #else
   MAP_EMPLACE_TEST(unordered_map, SCALE_S(LEN1), SCALE_S(LEN2), SCALE_S(LEN3));
+  MAP_EMPLACE_POOL_TEST(unordered_map, SCALE_S(LEN1), SCALE_S(LEN2), SCALE_S(LEN3));
 #endif
   std::cout << std::endl;
   std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
@@ -186,8 +214,10 @@ void unordered_multimap_test()
   std::cout << "|       emplace       |";
 #if LARGER_TEST_DATA_ON
   MAP_EMPLACE_TEST(unordered_multimap, SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+  MAP_EMPLACE_POOL_TEST(unordered_multimap, SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
 #else
   MAP_EMPLACE_TEST(unordered_multimap, SCALE_S(LEN1), SCALE_S(LEN2), SCALE_S(LEN3));
+  MAP_EMPLACE_POOL_TEST(unordered_multimap, SCALE_S(LEN1), SCALE_S(LEN2), SCALE_S(LEN3));
 #endif
   std::cout << std::endl;
   std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
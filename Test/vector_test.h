@@ -3,8 +3,12 @@
 
 // vector test : 测试 vector 的接口与 push_back 的性能
 
+#include <algorithm>
 #include <vector>
 
+#include "../mySTL/allocator/aligned_allocator.h"
+#include "../mySTL/allocator/memory_resource.h"
+#include "../mySTL/container/sequence/basic_string.h"
 #include "../mySTL/container/sequence/vector.h"
 #include "test.h"
 
@@ -12,6 +16,12 @@ namespace mySTL
 {
 namespace test
 {
+namespace huge
+{
+template <class T>
+using vector = mySTL::vector<T, mySTL::huge_page_allocator<T>>;
+} // namespace huge
+
 namespace vector_test
 {
 
@@ -32,6 +42,18 @@ void vector_test()
   v8 = v3;
   v9 = std::move(v3);
   v10 = { 1,2,3,4,5,6,7,8,9 };
+  mySTL::vector<int> v11(v7, v7.get_allocator());
+  mySTL::vector<int> v12(std::move(v11), mySTL::allocator<int>());
+  char buf[256];
+  mySTL::pmr::monotonic_buffer_resource arena(buf, sizeof(buf));
+  mySTL::vector<int, mySTL::pmr::polymorphic_allocator<int>> v13(a, a + 5, &arena);
+  mySTL::vector<double, mySTL::aligned_allocator<double, 64>> v14(5, 1.0);
+  mySTL::vector<bool> v15(6, true);
+  typedef mySTL::basic_string<char, mySTL::char_traits<char>,
+                              mySTL::pmr::polymorphic_allocator<char>> pmr_string;
+  mySTL::pmr::unsynchronized_pool_resource pool;
+  mySTL::vector<pmr_string, mySTL::pmr::polymorphic_allocator<pmr_string>> v16(2, "pool", &pool);
+  mySTL::vector<pmr_string, mySTL::pmr::polymorphic_allocator<pmr_string>> v17(v16.begin(), v16.end(), &pool);
 
   FUN_AFTER(v1, v1.assign(8, 8));
   FUN_AFTER(v1, v1.assign(a, a + 5));
@@ -46,6 +68,21 @@ void vector_test()
   FUN_AFTER(v1, v1.erase(v1.begin(), v1.begin() + 2));
   FUN_AFTER(v1, v1.reverse());
   FUN_AFTER(v1, v1.swap(v4));
+  FUN_AFTER(v12, v12.swap(v11));
+  FUN_AFTER(v13, v13.insert(v13.end(), v7.begin(), v7.end()));
+  FUN_AFTER(v14, v14.resize(8, 2.0));
+  FUN_VALUE(reinterpret_cast<uintptr_t>(v14.data()) % 64);
+  FUN_AFTER(v15, v15.insert(v15.begin() + 2, 3, false));
+  FUN_AFTER(v15, v15.push_back(false));
+  FUN_AFTER(v15, v15.erase(v15.begin()));
+  FUN_AFTER(v15, v15.flip());
+  FUN_VALUE(mySTL::count(v15.begin(), v15.end(), true));
+  FUN_VALUE(mySTL::find(v15.begin(), v15.end(), false) - v15.begin());
+  FUN_VALUE(v15.capacity());
+  FUN_AFTER(v16, v16.insert(v16.begin() + 1, 3, "resource"));
+  FUN_VALUE((v16[0].get_allocator().resource() == &pool));
+  FUN_VALUE((v16[1].get_allocator().resource() == &pool));
+  FUN_VALUE((v17[1].get_allocator().resource() == &pool));
   FUN_VALUE(*v1.begin());
   FUN_VALUE(*(v1.end() - 1));
   FUN_VALUE(*v1.rbegin());
@@ -75,6 +112,10 @@ void vector_test()
   FUN_AFTER(v1, v1.resize(6, 6));
   FUN_VALUE(v1.size());
   FUN_VALUE(v1.capacity());
+  FUN_AFTER(v1, v1.reserve_and_append(4, [](int* p, size_t n) { for (size_t i = 0; i < n; ++i) p[i] = static_cast<int>(i); return n - 1; }));
+  FUN_VALUE(v1.size());
+  FUN_AFTER(v1, v1.resize_default_init(6));
+  FUN_VALUE(v1.size());
   FUN_AFTER(v1, v1.shrink_to_fit());
   FUN_VALUE(v1.size());
   FUN_VALUE(v1.capacity());
@@ -97,8 +138,28 @@ void vector_test()
   std::cout << "|      push_back      |";
 #if LARGER_TEST_DATA_ON
   CON_TEST_P1(vector<int>, push_back, rand(), SCALE_LL(LEN1), SCALE_LL(LEN2), SCALE_LL(LEN3));
+  CON_TEST_P1_ROW("     mySTL(huge)     ", huge, vector<int>, push_back, rand(),
+                  SCALE_LL(LEN1), SCALE_LL(LEN2), SCALE_LL(LEN3));
 #else
   CON_TEST_P1(vector<int>, push_back, rand(), SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3));
+  CON_TEST_P1_ROW("     mySTL(huge)     ", huge, vector<int>, push_back, rand(),
+                  SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3));
+#endif
+  std::cout << "\n";
+  std::cout << "|---------------------|-------------|-------------|-------------|\n";
+  std::cout << "|   push_back(bool)   |";
+#if LARGER_TEST_DATA_ON
+  CON_TEST_P1(vector<bool>, push_back, (rand() & 1) != 0, SCALE_LL(LEN1), SCALE_LL(LEN2), SCALE_LL(LEN3));
+#else
+  CON_TEST_P1(vector<bool>, push_back, (rand() & 1) != 0, SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3));
+#endif
+  std::cout << "\n";
+  std::cout << "|---------------------|-------------|-------------|-------------|\n";
+  std::cout << "|  100 x count(bool)  |";
+#if LARGER_TEST_DATA_ON
+  BIT_COUNT_TEST(SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3));
+#else
+  BIT_COUNT_TEST(LEN1, LEN2, LEN3);
 #endif
   std::cout << "\n";
   std::cout << "|---------------------|-------------|-------------|-------------|\n";
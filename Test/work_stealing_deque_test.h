@@ -0,0 +1,156 @@
+#ifndef MYTINYSTL_WORK_STEALING_DEQUE_TEST_H_
+#define MYTINYSTL_WORK_STEALING_DEQUE_TEST_H_
+
+// work_stealing_deque test : 测试 work_stealing_deque 的接口与拥有者 push/pop、其他线程窃取的性能
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../mySTL/algorithm/algo.h"
+#include "../mySTL/container/sequence/deque.h"
+#include "../mySTL/container/sequence/work_stealing_deque.h"
+#include "test.h"
+
+namespace mySTL
+{
+namespace test
+{
+
+// 用互斥量保护的 deque：拥有者操作尾部，窃取者操作头部
+namespace steal_mutex
+{
+struct table
+{
+  std::mutex lock;
+  mySTL::deque<int> d;
+};
+inline void push(table& t, int value)
+{
+  std::lock_guard<std::mutex> guard(t.lock);
+  t.d.push_back(value);
+}
+inline bool pop(table& t, int& out)
+{
+  std::lock_guard<std::mutex> guard(t.lock);
+  if (t.d.empty())
+    return false;
+  out = t.d.back();
+  t.d.pop_back();
+  return true;
+}
+inline bool steal(table& t, int& out)
+{
+  std::lock_guard<std::mutex> guard(t.lock);
+  if (t.d.empty())
+    return false;
+  out = t.d.front();
+  t.d.pop_front();
+  return true;
+}
+} // namespace steal_mutex
+
+namespace steal_lockfree
+{
+typedef mySTL::work_stealing_deque<int> table;
+inline void push(table& t, int value) { t.push(value); }
+inline bool pop(table& t, int& out) { return t.try_pop(out); }
+inline bool steal(table& t, int& out) { return t.try_steal(out); }
+} // namespace steal_lockfree
+
+namespace work_stealing_deque_test
+{
+
+void work_stealing_deque_test()
+{
+  std::cout << "[===============================================================]\n";
+  std::cout << "[---------- Run container test : work_stealing_deque -----------]\n";
+  std::cout << "[-------------------------- API test ---------------------------]\n";
+  int x = 0;
+  mySTL::work_stealing_deque<int> q1;
+  mySTL::work_stealing_deque<int> q2(2);
+
+  std::cout << std::boolalpha;
+  FUN_VALUE(q1.capacity());
+  FUN_VALUE(q1.empty());
+  FUN_VALUE(q1.try_pop(x));
+  FUN_VALUE(q1.try_steal(x));
+  FUN_VALUE(q2.capacity());
+  for (int i = 1; i <= 5; ++i)
+    q2.push(i);
+  FUN_VALUE(q2.size());
+  FUN_VALUE(q2.capacity());
+  FUN_VALUE(q2.try_pop(x));
+  FUN_VALUE(x);
+  FUN_VALUE(q2.try_steal(x));
+  FUN_VALUE(x);
+  FUN_VALUE(q2.try_pop(x));
+  FUN_VALUE(x);
+  FUN_VALUE(q2.size());
+  {
+    // 拥有者不断 push/pop，3 个线程同时窃取，每个元素恰好被取出一次
+    mySTL::work_stealing_deque<int> q(4);
+    std::vector<std::atomic<int>> seen(40000);
+    for (auto& s : seen)
+      s = 0;
+    std::atomic<int> done(0);
+    std::vector<std::thread> thieves;
+    for (int w = 0; w < 3; ++w)
+      thieves.emplace_back([&] {
+        int v;
+        while (done.load() < 40000)
+        {
+          if (q.try_steal(v))
+          {
+            ++seen[v];
+            ++done;
+          }
+          else
+            std::this_thread::yield();
+        }
+      });
+    int v;
+    for (int i = 0; i < 40000; )
+    {
+      for (int k = 0; k < 8; ++k)
+        q.push(i++);
+      for (int k = 0; k < 4; ++k)
+        if (q.try_pop(v))
+        {
+          ++seen[v];
+          ++done;
+        }
+    }
+    while (q.try_pop(v))
+    {
+      ++seen[v];
+      ++done;
+    }
+    for (auto& th : thieves)
+      th.join();
+    FUN_VALUE(done.load());
+    FUN_VALUE((mySTL::count(seen.data(), seen.data() + seen.size(), 1) == 40000));
+  }
+  std::cout << std::noboolalpha;
+  PASSED;
+#if PERFORMANCE_TEST_ON
+  std::cout << "[--------------------- Performance Testing ---------------------]\n";
+  std::cout << "|---------------------|-------------|-------------|-------------|\n";
+  std::cout << "|  push/pop + steal   |";
+#if LARGER_TEST_DATA_ON
+  WORK_STEAL_TEST(SCALE_LL(LEN1), SCALE_LL(LEN2), SCALE_LL(LEN3));
+#else
+  WORK_STEAL_TEST(SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3));
+#endif
+  std::cout << "\n";
+  std::cout << "|---------------------|-------------|-------------|-------------|\n";
+  PASSED;
+#endif
+  std::cout << "[---------- End container test : work_stealing_deque -----------]\n";
+}
+
+} // namespace work_stealing_deque_test
+} // namespace test
+} // namespace mySTL
+#endif // !MYTINYSTL_WORK_STEALING_DEQUE_TEST_H_
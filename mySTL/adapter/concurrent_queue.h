@@ -0,0 +1,533 @@
+#ifndef MYSTL_CONCURRENT_QUEUE_H_
+#define MYSTL_CONCURRENT_QUEUE_H_
+
+// 这个头文件包含两个模板类 spsc_queue 和 mpmc_queue
+// spsc_queue : 单生产者、单消费者的有界环形队列，push 与 pop 都是无等待（wait-free）的
+// mpmc_queue : 多生产者、多消费者的有界队列，每个位置带一个序号，push 与 pop 是无锁（lock-free）的
+// 用于流水线各阶段之间传递数据，代替 mutex + mySTL::queue：
+//   mySTL::spsc_queue<int> q(1024);
+//   q.try_push(1);         // 生产者线程
+//   int x; q.try_pop(x);   // 消费者线程
+
+// notes:
+//
+// 容量在构造时确定，向上取整为 2 的幂，位置由单调增长的计数器与 capacity - 1 按位与得到
+// 队满时 try_push 返回 false，队空时 try_pop 返回 false，由调用者决定自旋、让出还是丢弃
+// push_n / pop_n 一次占用多个位置，只更新一次共享的计数器，返回实际放入 / 取出的个数
+// 生产者与消费者各自修改的计数器放在不同的缓存行，避免伪共享
+// size() 只是一个近似值，empty() 同理
+// 构造、析构不是线程安全的，队列不能复制或移动
+//
+// spsc_queue:
+//   * 只能有一个线程 push，一个线程 pop
+//   * 生产者缓存消费者的计数器（反之亦然），只有看起来满 / 空时才读取对方的缓存行
+//   * 异常保证：构造元素抛出异常时队列不变；push_n 抛出异常时已构造的元素仍然入队，
+//     pop_n 写入 out 抛出异常时已写入的元素出队，其余元素留在队列中
+//
+// mpmc_queue:
+//   * 位置 pos 的序号为 pos 时可以写入，为 pos + 1 时可以读取，读取后改为 pos + capacity
+//   * 占用位置之后无法撤销，因此要求 T 的移动构造、移动赋值不抛出异常；
+//     不能无异常构造的元素先构造到临时对象中，再占用位置移动过去
+//   * 元素通过分配器构造与析构；分配器提供 construct 时（如 polymorphic_allocator）
+//     也先通过分配器构造临时对象，占用位置后只需要用同一个分配器从右值构造
+//   * pop_n 写入 out 抛出异常时，这一批中剩余的元素被析构丢弃
+
+#include <atomic>
+#include <type_traits>
+#include <utility>
+
+#include "../allocator/aligned_allocator.h"
+#include "../iterator/iterator.h"
+#include "../util/memory.h"
+#include "../util/util.h"
+#include "../util/exceptdef.h"
+
+namespace mySTL
+{
+#ifdef max
+#pragma message("#undefing marco max")
+#undef max
+#endif // max
+
+#ifdef min
+#pragma message("#undefing marco min")
+#undef min
+#endif // min
+
+    // 不小于 n 的最小的 2 的幂，至少为 1
+    inline size_t concurrent_queue_capacity(size_t n) noexcept
+    {
+        size_t cap = 1;
+        while (cap < n)
+            cap <<= 1;
+        return cap;
+    }
+
+    /*****************************************************************************************/
+    // 模板类 spsc_queue
+    // 模板参数 T 代表类型，Alloc 代表分配器
+    template <class T, class Alloc = mySTL::allocator<T>>
+    class spsc_queue
+        : private mySTL::alloc_holder<typename mySTL::allocator_traits<Alloc>::template rebind_alloc<T>>
+    {
+        static_assert(std::is_same<T, typename Alloc::value_type>::value,
+                      "the value_type of Alloc should be same with T");
+
+    public:
+        // spsc_queue 的型别定义
+        typedef Alloc allocator_type;
+        typedef typename mySTL::allocator_traits<Alloc>::template rebind_alloc<T> data_allocator;
+        typedef mySTL::allocator_traits<data_allocator> data_traits;
+
+        typedef T value_type;
+        typedef typename data_traits::pointer pointer;
+        typedef value_type &reference;
+        typedef const value_type &const_reference;
+        typedef typename data_traits::size_type size_type;
+
+        allocator_type get_allocator() const { return allocator_type(this->alloc_ref()); }
+
+    private:
+        typedef mySTL::alloc_holder<data_allocator> alloc_base;
+
+        // 只读的数据
+        pointer data_;
+        size_type mask_;
+
+        // 生产者修改的数据
+        alignas(MYSTL_CACHE_LINE_SIZE) std::atomic<size_type> tail_; // 下一个写入的位置
+        size_type head_cache_;                                      // 生产者看到的 head_
+
+        // 消费者修改的数据
+        alignas(MYSTL_CACHE_LINE_SIZE) std::atomic<size_type> head_; // 下一个读取的位置
+        size_type tail_cache_;                                      // 消费者看到的 tail_
+
+        char pad_[MYSTL_CACHE_LINE_SIZE - sizeof(std::atomic<size_type>) - sizeof(size_type)];
+
+    public:
+        // 构造、析构函数
+
+        explicit spsc_queue(size_type capacity, const allocator_type &alloc = allocator_type())
+            : alloc_base(data_allocator(alloc)),
+              data_(nullptr), mask_(concurrent_queue_capacity(capacity) - 1),
+              tail_(0), head_cache_(0), head_(0), tail_cache_(0)
+        {
+            data_ = data_traits::allocate(this->alloc_ref(), mask_ + 1);
+        }
+
+        spsc_queue(const spsc_queue &) = delete;
+        spsc_queue &operator=(const spsc_queue &) = delete;
+
+        ~spsc_queue()
+        {
+            const size_type t = tail_.load(std::memory_order_relaxed);
+            for (size_type h = head_.load(std::memory_order_relaxed); h != t; ++h)
+                data_traits::destroy(this->alloc_ref(), data_ + (h & mask_));
+            data_traits::deallocate(this->alloc_ref(), data_, mask_ + 1);
+        }
+
+    public:
+        // 容量相关操作
+
+        size_type capacity() const noexcept { return mask_ + 1; }
+        size_type size() const noexcept
+        {
+            const size_type h = head_.load(std::memory_order_acquire);
+            return tail_.load(std::memory_order_acquire) - h;
+        }
+        bool empty() const noexcept { return size() == 0; }
+
+        // 生产者的操作
+
+        template <class... Args>
+        bool try_emplace(Args &&...args);
+        bool try_push(const value_type &value) { return try_emplace(value); }
+        bool try_push(value_type &&value) { return try_emplace(mySTL::move(value)); }
+
+        // 从 first 开始复制至多 n 个元素，返回放入的个数
+        template <class InputIter>
+        size_type push_n(InputIter first, size_type n);
+
+        // 消费者的操作
+
+        bool try_pop(value_type &out);
+
+        // 至多取出 n 个元素依次写入 out，返回取出的个数
+        template <class OutputIter>
+        size_type pop_n(OutputIter out, size_type n);
+
+    private:
+        // 生产者可以写入的位置个数，不够 n 个时重新读取 head_
+        size_type free_slots(size_type t, size_type n) noexcept
+        {
+            size_type free = capacity() - (t - head_cache_);
+            if (free < n)
+            {
+                head_cache_ = head_.load(std::memory_order_acquire);
+                free = capacity() - (t - head_cache_);
+            }
+            return free;
+        }
+
+        // 消费者可以读取的元素个数，不够 n 个时重新读取 tail_
+        size_type ready_slots(size_type h, size_type n) noexcept
+        {
+            size_type ready = tail_cache_ - h;
+            if (ready < n)
+            {
+                tail_cache_ = tail_.load(std::memory_order_acquire);
+                ready = tail_cache_ - h;
+            }
+            return ready;
+        }
+    };
+
+    template <class T, class Alloc>
+    template <class... Args>
+    bool spsc_queue<T, Alloc>::try_emplace(Args &&...args)
+    {
+        const size_type t = tail_.load(std::memory_order_relaxed);
+        if (free_slots(t, 1) == 0)
+            return false;
+        data_traits::construct(this->alloc_ref(), data_ + (t & mask_), mySTL::forward<Args>(args)...);
+        tail_.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    template <class T, class Alloc>
+    template <class InputIter>
+    typename spsc_queue<T, Alloc>::size_type
+    spsc_queue<T, Alloc>::push_n(InputIter first, size_type n)
+    {
+        const size_type t = tail_.load(std::memory_order_relaxed);
+        n = mySTL::min(n, free_slots(t, n));
+        size_type i = 0;
+        try
+        {
+            for (; i < n; ++i, ++first)
+                data_traits::construct(this->alloc_ref(), data_ + ((t + i) & mask_), *first);
+        }
+        catch (...)
+        {
+            tail_.store(t + i, std::memory_order_release);
+            throw;
+        }
+        tail_.store(t + n, std::memory_order_release);
+        return n;
+    }
+
+    template <class T, class Alloc>
+    bool spsc_queue<T, Alloc>::try_pop(value_type &out)
+    {
+        const size_type h = head_.load(std::memory_order_relaxed);
+        if (ready_slots(h, 1) == 0)
+            return false;
+        pointer p = data_ + (h & mask_);
+        out = mySTL::move(*p);
+        data_traits::destroy(this->alloc_ref(), p);
+        head_.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    template <class T, class Alloc>
+    template <class OutputIter>
+    typename spsc_queue<T, Alloc>::size_type
+    spsc_queue<T, Alloc>::pop_n(OutputIter out, size_type n)
+    {
+        const size_type h = head_.load(std::memory_order_relaxed);
+        n = mySTL::min(n, ready_slots(h, n));
+        size_type i = 0;
+        try
+        {
+            for (; i < n; ++i, ++out)
+            {
+                pointer p = data_ + ((h + i) & mask_);
+                *out = mySTL::move(*p);
+                data_traits::destroy(this->alloc_ref(), p);
+            }
+        }
+        catch (...)
+        {
+            head_.store(h + i, std::memory_order_release);
+            throw;
+        }
+        head_.store(h + n, std::memory_order_release);
+        return n;
+    }
+
+    /*****************************************************************************************/
+    // mpmc_queue 的位置：序号与元素的存储空间
+    template <class T>
+    struct mpmc_slot
+    {
+        std::atomic<size_t> seq;
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+
+        T *value() noexcept { return reinterpret_cast<T *>(&storage); }
+    };
+
+    // 模板类 mpmc_queue
+    // 模板参数 T 代表类型，Alloc 代表分配器
+    template <class T, class Alloc = mySTL::allocator<T>>
+    class mpmc_queue
+        : private mySTL::alloc_holder<typename mySTL::allocator_traits<Alloc>::template rebind_alloc<T>>
+    {
+        static_assert(std::is_same<T, typename Alloc::value_type>::value,
+                      "the value_type of Alloc should be same with T");
+        static_assert(std::is_nothrow_move_constructible<T>::value &&
+                          std::is_nothrow_move_assignable<T>::value,
+                      "mpmc_queue<T> needs T to be nothrow move constructible and assignable");
+
+    public:
+        // mpmc_queue 的型别定义
+        typedef Alloc allocator_type;
+        typedef typename mySTL::allocator_traits<Alloc>::template rebind_alloc<T> data_allocator;
+        typedef mySTL::allocator_traits<data_allocator> data_traits;
+        typedef mpmc_slot<T> slot_type;
+        typedef typename data_traits::template rebind_alloc<slot_type> slot_allocator;
+        typedef mySTL::allocator_traits<slot_allocator> slot_traits;
+
+        typedef T value_type;
+        typedef value_type &reference;
+        typedef const value_type &const_reference;
+        typedef typename data_traits::size_type size_type;
+
+        allocator_type get_allocator() const { return allocator_type(this->alloc_ref()); }
+
+    private:
+        typedef mySTL::alloc_holder<data_allocator> alloc_base;
+        typedef typename slot_traits::pointer slot_pointer;
+
+        // 构造元素不会抛出异常：分配器的 construct 可能分配内存，视为可能抛出
+        template <class... Args>
+        struct nothrow_construct
+            : m_intergral_constant<bool, std::is_nothrow_constructible<T, Args...>::value &&
+                                         !alloc_has_construct<data_allocator, T *, Args...>::value> {};
+
+        // 只读的数据
+        slot_pointer slots_;
+        size_type mask_;
+
+        alignas(MYSTL_CACHE_LINE_SIZE) std::atomic<size_type> tail_; // 下一个写入的位置
+        alignas(MYSTL_CACHE_LINE_SIZE) std::atomic<size_type> head_; // 下一个读取的位置
+
+        char pad_[MYSTL_CACHE_LINE_SIZE - sizeof(std::atomic<size_type>)];
+
+    public:
+        // 构造、析构函数
+
+        explicit mpmc_queue(size_type capacity, const allocator_type &alloc = allocator_type())
+            : alloc_base(data_allocator(alloc)),
+              slots_(nullptr), mask_(concurrent_queue_capacity(capacity) - 1),
+              tail_(0), head_(0)
+        {
+            slot_allocator slot_alloc(this->alloc_ref());
+            slots_ = slot_traits::allocate(slot_alloc, mask_ + 1);
+            for (size_type i = 0; i <= mask_; ++i)
+                ::new (static_cast<void *>(&slots_[i].seq)) std::atomic<size_type>(i);
+        }
+
+        mpmc_queue(const mpmc_queue &) = delete;
+        mpmc_queue &operator=(const mpmc_queue &) = delete;
+
+        ~mpmc_queue()
+        {
+            const size_type t = tail_.load(std::memory_order_relaxed);
+            for (size_type h = head_.load(std::memory_order_relaxed); h != t; ++h)
+                data_traits::destroy(this->alloc_ref(), slots_[h & mask_].value());
+            slot_allocator slot_alloc(this->alloc_ref());
+            slot_traits::deallocate(slot_alloc, slots_, mask_ + 1);
+        }
+
+    public:
+        // 容量相关操作
+
+        size_type capacity() const noexcept { return mask_ + 1; }
+        size_type size() const noexcept
+        {
+            const size_type h = head_.load(std::memory_order_acquire);
+            const size_type t = tail_.load(std::memory_order_acquire);
+            return t > h ? t - h : 0;
+        }
+        bool empty() const noexcept { return size() == 0; }
+
+        // 生产者的操作
+
+        template <class... Args>
+        bool try_emplace(Args &&...args)
+        {
+            return try_emplace_aux(nothrow_construct<Args &&...>{},
+                                   mySTL::forward<Args>(args)...);
+        }
+        bool try_push(const value_type &value) { return try_emplace(value); }
+        bool try_push(value_type &&value) { return try_emplace(mySTL::move(value)); }
+
+        // 从 first 开始复制至多 n 个元素，返回放入的个数
+        template <class InputIter>
+        size_type push_n(InputIter first, size_type n)
+        {
+            return push_n_aux(first, n, nothrow_construct<
+                                            typename mySTL::iterator_traits<InputIter>::reference>{});
+        }
+
+        // 消费者的操作
+
+        bool try_pop(value_type &out);
+
+        // 至多取出 n 个元素依次写入 out，返回取出的个数
+        template <class OutputIter>
+        size_type pop_n(OutputIter out, size_type n);
+
+    private:
+        // helper functions
+
+        template <class... Args>
+        bool try_emplace_aux(m_true_type, Args &&...args);
+        template <class... Args>
+        bool try_emplace_aux(m_false_type, Args &&...args);
+
+        template <class InputIter>
+        size_type push_n_aux(InputIter first, size_type n, m_true_type);
+        template <class InputIter>
+        size_type push_n_aux(InputIter first, size_type n, m_false_type);
+
+        // 占用 [pos, pos + k) 个连续位置，k 不超过 n，返回 k；expect 为位置可用时的序号与 pos 之差
+        size_type claim(std::atomic<size_type> &counter, size_type &pos, size_type n, size_type expect) noexcept;
+    };
+
+    // 从 counter 开始找出至多 n 个可用的连续位置并一次占用
+    template <class T, class Alloc>
+    typename mpmc_queue<T, Alloc>::size_type
+    mpmc_queue<T, Alloc>::claim(std::atomic<size_type> &counter, size_type &pos, size_type n,
+                                size_type expect) noexcept
+    {
+        pos = counter.load(std::memory_order_relaxed);
+        while (true)
+        {
+            size_type k = 0;
+            for (; k < n; ++k)
+            {
+                const size_type seq = slots_[(pos + k) & mask_].seq.load(std::memory_order_acquire);
+                if (seq != pos + k + expect)
+                    break;
+            }
+            if (k == 0)
+            {
+                // 第一个位置还没轮到：其他线程已经越过了 pos，或者队列满 / 空
+                const size_type seq = slots_[pos & mask_].seq.load(std::memory_order_acquire);
+                const auto dif = static_cast<ptrdiff_t>(seq - (pos + expect));
+                if (dif < 0)
+                    return 0;
+                pos = counter.load(std::memory_order_relaxed);
+                continue;
+            }
+            // 只有占用了 pos 的线程会修改这些位置的序号，计数器仍为 pos 时它们都还可用
+            if (counter.compare_exchange_weak(pos, pos + k, std::memory_order_relaxed))
+                return k;
+        }
+    }
+
+    // 可以无异常构造：占用位置后就地构造
+    template <class T, class Alloc>
+    template <class... Args>
+    bool mpmc_queue<T, Alloc>::try_emplace_aux(m_true_type, Args &&...args)
+    {
+        size_type pos;
+        if (claim(tail_, pos, 1, 0) == 0)
+            return false;
+        slot_type &s = slots_[pos & mask_];
+        data_traits::construct(this->alloc_ref(), s.value(), mySTL::forward<Args>(args)...);
+        s.seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 构造可能抛出异常：先通过分配器构造到临时对象中，占用位置后再移动过去
+    template <class T, class Alloc>
+    template <class... Args>
+    bool mpmc_queue<T, Alloc>::try_emplace_aux(m_false_type, Args &&...args)
+    {
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type buf;
+        T *tmp = reinterpret_cast<T *>(&buf);
+        data_traits::construct(this->alloc_ref(), tmp, mySTL::forward<Args>(args)...);
+        const bool ok = try_emplace_aux(m_true_type(), mySTL::move(*tmp));
+        data_traits::destroy(this->alloc_ref(), tmp);
+        return ok;
+    }
+
+    template <class T, class Alloc>
+    template <class InputIter>
+    typename mpmc_queue<T, Alloc>::size_type
+    mpmc_queue<T, Alloc>::push_n_aux(InputIter first, size_type n, m_true_type)
+    {
+        size_type pos;
+        const size_type k = claim(tail_, pos, n, 0);
+        for (size_type i = 0; i < k; ++i, ++first)
+        {
+            slot_type &s = slots_[(pos + i) & mask_];
+            data_traits::construct(this->alloc_ref(), s.value(), *first);
+            s.seq.store(pos + i + 1, std::memory_order_release);
+        }
+        return k;
+    }
+
+    // 复制可能抛出异常：逐个先构造再占用
+    template <class T, class Alloc>
+    template <class InputIter>
+    typename mpmc_queue<T, Alloc>::size_type
+    mpmc_queue<T, Alloc>::push_n_aux(InputIter first, size_type n, m_false_type)
+    {
+        size_type i = 0;
+        for (; i < n; ++i, ++first)
+        {
+            if (!try_emplace_aux(m_false_type(), *first))
+                break;
+        }
+        return i;
+    }
+
+    template <class T, class Alloc>
+    bool mpmc_queue<T, Alloc>::try_pop(value_type &out)
+    {
+        size_type pos;
+        if (claim(head_, pos, 1, 1) == 0)
+            return false;
+        slot_type &s = slots_[pos & mask_];
+        out = mySTL::move(*s.value());
+        data_traits::destroy(this->alloc_ref(), s.value());
+        s.seq.store(pos + capacity(), std::memory_order_release);
+        return true;
+    }
+
+    template <class T, class Alloc>
+    template <class OutputIter>
+    typename mpmc_queue<T, Alloc>::size_type
+    mpmc_queue<T, Alloc>::pop_n(OutputIter out, size_type n)
+    {
+        size_type pos;
+        const size_type k = claim(head_, pos, n, 1);
+        size_type i = 0;
+        try
+        {
+            for (; i < k; ++i, ++out)
+            {
+                slot_type &s = slots_[(pos + i) & mask_];
+                *out = mySTL::move(*s.value());
+                data_traits::destroy(this->alloc_ref(), s.value());
+                s.seq.store(pos + i + capacity(), std::memory_order_release);
+            }
+        }
+        catch (...)
+        { // 已占用的位置必须归还，剩余的元素只能丢弃
+            for (; i < k; ++i)
+            {
+                slot_type &s = slots_[(pos + i) & mask_];
+                data_traits::destroy(this->alloc_ref(), s.value());
+                s.seq.store(pos + i + capacity(), std::memory_order_release);
+            }
+            throw;
+        }
+        return k;
+    }
+
+} // namespace mySTL
+#endif // !MYSTL_CONCURRENT_QUEUE_H_
@@ -68,6 +68,38 @@ namespace mySTL
         {
         }
 
+        // 使用指定分配器构造底层容器，仅当底层容器支持该分配器时可用
+        template <class Alloc, typename std::enable_if<
+                                   mySTL::uses_allocator<Container, Alloc>::value, int>::type = 0>
+        explicit queue(const Alloc &alloc)
+            : c_(alloc)
+        {
+        }
+        template <class Alloc, typename std::enable_if<
+                                   mySTL::uses_allocator<Container, Alloc>::value, int>::type = 0>
+        queue(const Container &c, const Alloc &alloc)
+            : c_(c, alloc)
+        {
+        }
+        template <class Alloc, typename std::enable_if<
+                                   mySTL::uses_allocator<Container, Alloc>::value, int>::type = 0>
+        queue(Container &&c, const Alloc &alloc)
+            : c_(mySTL::move(c), alloc)
+        {
+        }
+        template <class Alloc, typename std::enable_if<
+                                   mySTL::uses_allocator<Container, Alloc>::value, int>::type = 0>
+        queue(const queue &rhs, const Alloc &alloc)
+            : c_(rhs.c_, alloc)
+        {
+        }
+        template <class Alloc, typename std::enable_if<
+                                   mySTL::uses_allocator<Container, Alloc>::value, int>::type = 0>
+        queue(queue &&rhs, const Alloc &alloc)
+            : c_(mySTL::move(rhs.c_), alloc)
+        {
+        }
+
         queue &operator=(const queue &rhs)
         {
             c_ = rhs.c_;
@@ -253,6 +285,40 @@ namespace mySTL
             mySTL::make_heap(c_.begin(), c_.end(), comp_);
         }
 
+        // 使用指定分配器构造底层容器，仅当底层容器支持该分配器时可用
+        template <class Alloc, typename std::enable_if<
+                                   mySTL::uses_allocator<Container, Alloc>::value, int>::type = 0>
+        explicit priority_queue(const Alloc &alloc)
+            : c_(alloc)
+        {
+        }
+        template <class Alloc, typename std::enable_if<
+                                   mySTL::uses_allocator<Container, Alloc>::value, int>::type = 0>
+        priority_queue(const Container &c, const Alloc &alloc)
+            : c_(c, alloc)
+        {
+            mySTL::make_heap(c_.begin(), c_.end(), comp_);
+        }
+        template <class Alloc, typename std::enable_if<
+                                   mySTL::uses_allocator<Container, Alloc>::value, int>::type = 0>
+        priority_queue(Container &&c, const Alloc &alloc)
+            : c_(mySTL::move(c), alloc)
+        {
+            mySTL::make_heap(c_.begin(), c_.end(), comp_);
+        }
+        template <class Alloc, typename std::enable_if<
+                                   mySTL::uses_allocator<Container, Alloc>::value, int>::type = 0>
+        priority_queue(const priority_queue &rhs, const Alloc &alloc)
+            : c_(rhs.c_, alloc), comp_(rhs.comp_)
+        {
+        }
+        template <class Alloc, typename std::enable_if<
+                                   mySTL::uses_allocator<Container, Alloc>::value, int>::type = 0>
+        priority_queue(priority_queue &&rhs, const Alloc &alloc)
+            : c_(mySTL::move(rhs.c_), alloc), comp_(rhs.comp_)
+        {
+        }
+
         priority_queue &operator=(const priority_queue &rhs)
         {
             c_ = rhs.c_;
@@ -64,6 +64,38 @@ namespace mySTL
         {
         }
 
+        // 使用指定分配器构造底层容器，仅当底层容器支持该分配器时可用
+        template <class Alloc, typename std::enable_if<
+                                   mySTL::uses_allocator<Container, Alloc>::value, int>::type = 0>
+        explicit stack(const Alloc &alloc)
+            : c_(alloc)
+        {
+        }
+        template <class Alloc, typename std::enable_if<
+                                   mySTL::uses_allocator<Container, Alloc>::value, int>::type = 0>
+        stack(const Container &c, const Alloc &alloc)
+            : c_(c, alloc)
+        {
+        }
+        template <class Alloc, typename std::enable_if<
+                                   mySTL::uses_allocator<Container, Alloc>::value, int>::type = 0>
+        stack(Container &&c, const Alloc &alloc)
+            : c_(mySTL::move(c), alloc)
+        {
+        }
+        template <class Alloc, typename std::enable_if<
+                                   mySTL::uses_allocator<Container, Alloc>::value, int>::type = 0>
+        stack(const stack &rhs, const Alloc &alloc)
+            : c_(rhs.c_, alloc)
+        {
+        }
+        template <class Alloc, typename std::enable_if<
+                                   mySTL::uses_allocator<Container, Alloc>::value, int>::type = 0>
+        stack(stack &&rhs, const Alloc &alloc)
+            : c_(mySTL::move(rhs.c_), alloc)
+        {
+        }
+
         stack &operator=(const stack &rhs)
         {
             c_ = rhs.c_;
@@ -109,13 +109,50 @@ namespace mySTL
 
     template <class InputIter, class T>
     InputIter
-    find(InputIter first, InputIter last, const T& value)
+    find_seg(InputIter first, InputIter last, const T& value, m_false_type)
     {
         while (first != last && *first != value)
             ++first;
         return first;
     }
 
+    //  分段迭代器版本：逐段以指针查找
+    template <class SegIter, class T>
+    SegIter
+    find_seg(SegIter first, SegIter last, const T& value, m_true_type)
+    {
+        typedef segmented_iterator_traits<SegIter> traits;
+        auto sf = traits::segment(first);
+        const auto sl = traits::segment(last);
+        if (sf == sl)
+        {
+            auto p = find_seg(traits::local(first), traits::local(last), value, m_false_type());
+            return p == traits::local(last) ? last : traits::compose(sf, p);
+        }
+        auto p = find_seg(traits::local(first), traits::end(sf), value, m_false_type());
+        if (p != traits::end(sf))
+        {
+            return traits::compose(sf, p);
+        }
+        for (++sf; sf != sl; ++sf)
+        {
+            p = find_seg(traits::begin(sf), traits::end(sf), value, m_false_type());
+            if (p != traits::end(sf))
+            {
+                return traits::compose(sf, p);
+            }
+        }
+        p = find_seg(traits::begin(sl), traits::local(last), value, m_false_type());
+        return p == traits::local(last) ? last : traits::compose(sl, p);
+    }
+
+    template <class InputIter, class T>
+    InputIter
+    find(InputIter first, InputIter last, const T& value)
+    {
+        return find_seg(first, last, value, is_segmented_iterator<InputIter>{});
+    }
+
     /* 
     find_if
     返回符合条件元素的迭代器
@@ -493,12 +530,38 @@ namespace mySTL
      */
 
     template <class InputIter, class Function>
-    Function for_each(InputIter first, InputIter last, Function f)
+    void for_each_seg(InputIter first, InputIter last, Function& f, m_false_type)
     {
         for (; first != last; ++first)
         {
             f(*first);
         }
+    }
+
+    //  分段迭代器版本：逐段以指针遍历
+    template <class SegIter, class Function>
+    void for_each_seg(SegIter first, SegIter last, Function& f, m_true_type)
+    {
+        typedef segmented_iterator_traits<SegIter> traits;
+        auto sf = traits::segment(first);
+        const auto sl = traits::segment(last);
+        if (sf == sl)
+        {
+            for_each_seg(traits::local(first), traits::local(last), f, m_false_type());
+            return;
+        }
+        for_each_seg(traits::local(first), traits::end(sf), f, m_false_type());
+        for (++sf; sf != sl; ++sf)
+        {
+            for_each_seg(traits::begin(sf), traits::end(sf), f, m_false_type());
+        }
+        for_each_seg(traits::begin(sl), traits::local(last), f, m_false_type());
+    }
+
+    template <class InputIter, class Function>
+    Function for_each(InputIter first, InputIter last, Function f)
+    {
+        for_each_seg(first, last, f, is_segmented_iterator<InputIter>{});
         return f;
     }
 
@@ -1567,13 +1630,13 @@ namespace mySTL
         auto result = first + (last - middle);
         if (l == r)
         {
-            swap_ranges(first, middle, middle);
+            mySTL::swap_ranges(first, middle, middle);
             return result;
         }
         auto cycle_times = rgcd(n, l);
         for (auto i = 0; i < cycle_times; ++i)
         {
-            auto tmp = *first;
+            auto tmp = mySTL::move(*first);
             auto p = first;
             if (l < r)
             {
@@ -1581,10 +1644,10 @@ namespace mySTL
                 {
                     if (p > first + r)
                     {
-                        *p = *(p - r);
+                        *p = mySTL::move(*(p - r));
                         p -= r;
                     }
-                    *p = *(p + l);
+                    *p = mySTL::move(*(p + l));
                     p += l;
                 }
             }
@@ -1594,14 +1657,14 @@ namespace mySTL
                 {
                     if (p < last - l)
                     {
-                        *p = *(p + l);
+                        *p = mySTL::move(*(p + l));
                         p += l;
                     }
-                    *p = *(p - r);
+                    *p = mySTL::move(*(p - r));
                     p -= r;
                 }
             }
-            *p = tmp;
+            *p = mySTL::move(tmp);
             ++first;
         }
         return result;
@@ -1894,6 +1957,99 @@ namespace mySTL
         return mySTL::copy(first2, last2, mySTL::copy(first1, last1, result));
     }
 
+    // merge_move : 与 merge 相同，但把元素移动到 result，两个输入区间都不能与输出重叠
+    template <class InputIter1, class InputIter2, class OutputIter>
+    OutputIter
+    merge_move(InputIter1 first1, InputIter1 last1,
+               InputIter2 first2, InputIter2 last2,
+               OutputIter result)
+    {
+        while (first1 != last1 && first2 != last2)
+        {
+            if (*first2 < *first1)
+            {
+                *result = mySTL::move(*first2);
+                ++first2;
+            }
+            else
+            {
+                *result = mySTL::move(*first1);
+                ++first1;
+            }
+            ++result;
+        }
+        return mySTL::move(first2, last2, mySTL::move(first1, last1, result));
+    }
+
+    template <class InputIter1, class InputIter2, class OutputIter, class Compared>
+    OutputIter
+    merge_move(InputIter1 first1, InputIter1 last1,
+               InputIter2 first2, InputIter2 last2,
+               OutputIter result, Compared cmp)
+    {
+        while (first1 != last1 && first2 != last2)
+        {
+            if (cmp(*first2, *first1))
+            {
+                *result = mySTL::move(*first2);
+                ++first2;
+            }
+            else
+            {
+                *result = mySTL::move(*first1);
+                ++first1;
+            }
+            ++result;
+        }
+        return mySTL::move(first2, last2, mySTL::move(first1, last1, result));
+    }
+
+    // merge_buffer_forward : 把缓冲区中的前一段 [buffer, buffer_end) 与原地的后一段 [middle, last)
+    // 归并到 result，result 位于 middle 之前；缓冲区用完时后一段剩余的元素已经在原位，不再移动
+    template <class Pointer, class BidirectionalIter>
+    void merge_buffer_forward(Pointer buffer, Pointer buffer_end,
+                              BidirectionalIter middle, BidirectionalIter last,
+                              BidirectionalIter result)
+    {
+        while (buffer != buffer_end && middle != last)
+        {
+            if (*middle < *buffer)
+            {
+                *result = mySTL::move(*middle);
+                ++middle;
+            }
+            else
+            {
+                *result = mySTL::move(*buffer);
+                ++buffer;
+            }
+            ++result;
+        }
+        mySTL::move(buffer, buffer_end, result);
+    }
+
+    template <class Pointer, class BidirectionalIter, class Compared>
+    void merge_buffer_forward(Pointer buffer, Pointer buffer_end,
+                              BidirectionalIter middle, BidirectionalIter last,
+                              BidirectionalIter result, Compared cmp)
+    {
+        while (buffer != buffer_end && middle != last)
+        {
+            if (cmp(*middle, *buffer))
+            {
+                *result = mySTL::move(*middle);
+                ++middle;
+            }
+            else
+            {
+                *result = mySTL::move(*buffer);
+                ++buffer;
+            }
+            ++result;
+        }
+        mySTL::move(buffer, buffer_end, result);
+    }
+
     /* 
     inplace_merge
     把连接在一起的两个有序序列结合成单一序列并保持有序
@@ -1930,9 +2086,9 @@ namespace mySTL
             first_cut = mySTL::upper_bound(first, middle, *second_cut);
             len11 = mySTL::distance(first, first_cut);
         }
-        auto new_middle = rotate(first_cut, middle, second_cut);
-        merge_without_buffer(first, first_cut, new_middle, len11, len22);
-        merge_without_buffer(new_middle, second_cut, last, len1 - len11, len2 - len22);
+        auto new_middle = mySTL::rotate(first_cut, middle, second_cut);
+        mySTL::merge_without_buffer(first, first_cut, new_middle, len11, len22);
+        mySTL::merge_without_buffer(new_middle, second_cut, last, len1 - len11, len2 - len22);
     }
 
     template <class BidirectionalIter1, class BidirectionalIter2>
@@ -1942,25 +2098,28 @@ namespace mySTL
                 BidirectionalIter1 result)
     {
         if (first1 == last1)
-            return mySTL::copy_backward(first2, last2, result);
+            return mySTL::move_backward(first2, last2, result);
         if (first2 == last2)
-            return mySTL::copy_backward(first1, last1, result);
+            return result == last1 ? first1 : mySTL::move_backward(first1, last1, result);
         --last1;
         --last2;
         while (true)
         {
             if (*last2 < *last1)
             {
-                *--result = *last1;
+                *--result = mySTL::move(*last1);
                 if (first1 == last1)
-                    return mySTL::copy_backward(first2, ++last2, result);
+                    return mySTL::move_backward(first2, ++last2, result);
                 --last1;
             }
             else
             {
-                *--result = *last2;
+                *--result = mySTL::move(*last2);
                 if (first2 == last2)
-                    return mySTL::copy_backward(first1, ++last1, result);
+                {   // 原地归并时前一段剩余的元素已经在原位，不能再移动到自身
+                    ++last1;
+                    return result == last1 ? first1 : mySTL::move_backward(first1, last1, result);
+                }
                 --last2;
             }
         }
@@ -1973,17 +2132,19 @@ namespace mySTL
                     BidirectionalIter2 buffer, Distance buffer_size)
     {
         BidirectionalIter2 buffer_end;
+        if (len1 == 0 || len2 == 0) // 有一段为空时不需要移动，否则下面会把元素移动到自身
+            return len1 == 0 ? last : first;
         if (len1 > len2 && len2 <= buffer_size)
         {
-            buffer_end = mySTL::copy(middle, last, buffer);
-            mySTL::copy_backward(first, middle, last);
-            return mySTL::copy(buffer, buffer_end, first);
+            buffer_end = mySTL::move(middle, last, buffer);
+            mySTL::move_backward(first, middle, last);
+            return mySTL::move(buffer, buffer_end, first);
         }
         else if (len1 <= buffer_size)
         {
-            buffer_end = mySTL::copy(first, middle, buffer);
-            mySTL::copy(middle, last, first);
-            return mySTL::copy_backward(buffer, buffer_end, last);
+            buffer_end = mySTL::move(first, middle, buffer);
+            mySTL::move(middle, last, first);
+            return mySTL::move_backward(buffer, buffer_end, last);
         }
         else
         {
@@ -2000,12 +2161,12 @@ namespace mySTL
         // 区间长度足够放进缓冲区
         if (len1 <= len2 && len1 <= buffer_size)
         {
-            Pointer buffer_end = mySTL::copy(first, middle, buffer);
-            mySTL::merge(buffer, buffer_end, middle, last, first);
+            Pointer buffer_end = mySTL::move(first, middle, buffer);
+            mySTL::merge_buffer_forward(buffer, buffer_end, middle, last, first);
         }
         else if (len2 <= buffer_size)
         {
-            Pointer buffer_end = mySTL::copy(middle, last, buffer);
+            Pointer buffer_end = mySTL::move(middle, last, buffer);
             mySTL::merge_backward(first, middle, buffer, buffer_end, last);
         }
         else
@@ -2109,25 +2270,28 @@ namespace mySTL
                 BidirectionalIter1 result, Compared cmp)
     {
         if (first1 == last1)
-            return mySTL::copy_backward(first2, last2, result);
+            return mySTL::move_backward(first2, last2, result);
         if (first2 == last2)
-            return mySTL::copy_backward(first1, last1, result);
+            return result == last1 ? first1 : mySTL::move_backward(first1, last1, result);
         --last1;
         --last2;
         while (true)
         {
             if (cmp(*last2, *last1))
             {
-                *--result = *last1;
+                *--result = mySTL::move(*last1);
                 if (first1 == last1)
-                    return mySTL::copy_backward(first2, ++last2, result);
+                    return mySTL::move_backward(first2, ++last2, result);
                 --last1;
             }
             else
             {
-                *--result = *last2;
+                *--result = mySTL::move(*last2);
                 if (first2 == last2)
-                    return mySTL::copy_backward(first1, ++last1, result);
+                {   // 原地归并时前一段剩余的元素已经在原位，不能再移动到自身
+                    ++last1;
+                    return result == last1 ? first1 : mySTL::move_backward(first1, last1, result);
+                }
                 --last2;
             }
         }
@@ -2142,12 +2306,12 @@ namespace mySTL
         // 区间长度足够放进缓冲区
         if (len1 <= len2 && len1 <= buffer_size)
         {
-            Pointer buffer_end = mySTL::copy(first, middle, buffer);
-            mySTL::merge(buffer, buffer_end, middle, last, first, cmp);
+            Pointer buffer_end = mySTL::move(first, middle, buffer);
+            mySTL::merge_buffer_forward(buffer, buffer_end, middle, last, first, cmp);
         }
         else if (len2 <= buffer_size)
         {
-            Pointer buffer_end = mySTL::copy(middle, last, buffer);
+            Pointer buffer_end = mySTL::move(middle, last, buffer);
             mySTL::merge_backward(first, middle, buffer, buffer_end, last, cmp);
         }
         else
@@ -2379,11 +2543,83 @@ namespace mySTL
         return mySTL::pair<OutputIter1, OutputIter2>(result_true, result_false);
     }
 
+    /*
+    stable_partition
+    与 partition 相同，但两部分中的元素都保持原始相对位置
+    缓冲区能放下区间时一次遍历完成，否则二分区间，分别划分后用 rotate 把两段中间的部分交换
+    没有缓冲区时退化为 O(nlogn) 次交换
+    */
+    template <class BidirectionalIter, class Pointer, class Distance, class UnaryPredicate>
+    BidirectionalIter
+    stable_partition_adaptive(BidirectionalIter first, BidirectionalIter last,
+                              UnaryPredicate unary_pred, Distance len,
+                              Pointer buffer, Distance buffer_size)
+    {
+        if (len == 1)
+            return unary_pred(*first) ? last : first;
+        if (len <= buffer_size)
+        {   // true 的元素向前移动，false 的元素移到缓冲区，最后接在后面
+            while (first != last && unary_pred(*first))
+                ++first;
+            auto result = first;
+            auto buffer_end = buffer;
+            for (; first != last; ++first)
+            {
+                if (unary_pred(*first))
+                {
+                    *result = mySTL::move(*first);
+                    ++result;
+                }
+                else
+                {
+                    *buffer_end = mySTL::move(*first);
+                    ++buffer_end;
+                }
+            }
+            mySTL::move(buffer, buffer_end, result);
+            return result;
+        }
+        auto middle = first;
+        const Distance half = len / 2;
+        mySTL::advance(middle, half);
+        auto left_split = mySTL::stable_partition_adaptive(first, middle, unary_pred, half,
+                                                           buffer, buffer_size);
+        auto right_split = mySTL::stable_partition_adaptive(middle, last, unary_pred, len - half,
+                                                            buffer, buffer_size);
+        return mySTL::rotate(left_split, middle, right_split);
+    }
+
+    template <class BidirectionalIter, class UnaryPredicate>
+    BidirectionalIter
+    stable_partition(BidirectionalIter first, BidirectionalIter last,
+                     UnaryPredicate unary_pred)
+    {
+        typedef typename iterator_traits<BidirectionalIter>::value_type value_type;
+        typedef typename iterator_traits<BidirectionalIter>::difference_type difference_type;
+        first = mySTL::find_if_not(first, last, unary_pred);
+        if (first == last)
+            return first;
+        temporary_buffer<BidirectionalIter, value_type> buf(first, last);
+        return mySTL::stable_partition_adaptive(first, last, unary_pred,
+                                                mySTL::distance(first, last), buf.begin(),
+                                                static_cast<difference_type>(buf.size()));
+    }
+
     /* 
     sort
+    pattern-defeating quicksort（pdqsort），对区间内的元素进行排序：
+    小区间使用插入排序，枢轴取三数中值，大区间取九数中值（ninther）
+    划分时没有交换任何元素，说明区间可能已经有序，先尝试移动次数有限的插入排序
+    枢轴与左边界外的元素相等时，把等于枢轴的元素一次划分到左边，不再对它们递归
+    划分极不均衡时打乱几个元素，不均衡的次数超过 log(n) 时改用 heap sort
+    算术类型以 less / greater 比较时使用无分支的块划分（BlockQuicksort）
      */
 
-    constexpr static size_t kSmallSectionSize = 128;  // 小型区间的大小，在这个大小内采用插入排序
+    constexpr static size_t kInsertionSortThreshold = 24;       // 小于这个大小的区间使用插入排序
+    constexpr static size_t kNintherThreshold = 128;            // 大于这个大小的区间取九数中值
+    constexpr static size_t kPartialInsertionSortLimit = 8;     // 尝试插入排序时最多移动的元素个数
+    constexpr static size_t kPartitionBlockSize = 64;           // 块划分时每块的元素个数
+
     // 找出 lgk <= n 的 k 的最大值
     template <class Size>
     Size slg2(Size n)
@@ -2399,7 +2635,7 @@ namespace mySTL
     RandomIter
     unchecked_partition(RandomIter first, RandomIter last, const T& pivot)
     {
-    while (true)
+        while (true)
         {
             while (*first < pivot)
                 ++first;
@@ -2413,47 +2649,29 @@ namespace mySTL
         }
     }
 
-    // 内省式排序，先进行 quick sort，当分割行为有恶化倾向时，改用 heap sort
-    template <class RandomIter, class Size>
-    void intro_sort(RandomIter first, RandomIter last, Size depth_limit)
-    {
-        while (static_cast<size_t>(last - first) > kSmallSectionSize)
-        {
-            if (depth_limit == 0)
-            {                      // 到达最大分割深度限制
-                mySTL::partial_sort(first, last, last);  // 改用 heap_sort
-                return;
-            }
-            --depth_limit;
-            auto mid = mySTL::median(*(first), *(first + (last - first) / 2), *(last - 1));
-            auto cut = mySTL::unchecked_partition(first, last, mid);
-            mySTL::intro_sort(cut, last, depth_limit);
-            last = cut;
-        }
-    }
-
     // 插入排序辅助函数 unchecked_linear_insert
     template <class RandomIter, class T>
-    void unchecked_linear_insert(RandomIter last, const T& value)
+    void unchecked_linear_insert(RandomIter last, T& value)
     {
         auto next = last;
         --next;
         while (value < *next)
         {
-            *last = *next;
+            *last = mySTL::move(*next);
             last = next;
             --next;
         }
-        *last = value;
+        *last = mySTL::move(value);
     }
 
-    // 插入排序函数 unchecked_insertion_sort
+    // 插入排序函数 unchecked_insertion_sort，要求 first 之前有一个不大于区间内所有元素的元素
     template <class RandomIter>
     void unchecked_insertion_sort(RandomIter first, RandomIter last)
     {
         for (auto i = first; i != last; ++i)
         {
-            mySTL::unchecked_linear_insert(i, *i);
+            auto value = mySTL::move(*i);  // *i 会在后移时被覆盖，先移出
+            mySTL::unchecked_linear_insert(i, value);
         }
     }
 
@@ -2465,11 +2683,11 @@ namespace mySTL
             return;
         for (auto i = first + 1; i != last; ++i)
         {
-            auto value = *i;
+            auto value = mySTL::move(*i);
             if (value < *first)
             {
-                mySTL::copy_backward(first, i, i + 1);
-                *first = value;
+                mySTL::move_backward(first, i, i + 1);
+                *first = mySTL::move(value);
             }
             else
             {
@@ -2478,32 +2696,6 @@ namespace mySTL
         }
     }
 
-    // 最终插入排序函数 final_insertion_sort
-    template <class RandomIter>
-    void final_insertion_sort(RandomIter first, RandomIter last)
-    {
-        if (static_cast<size_t>(last - first) > kSmallSectionSize)
-        {
-            mySTL::insertion_sort(first, first + kSmallSectionSize);
-            mySTL::unchecked_insertion_sort(first + kSmallSectionSize, last);
-        }
-        else
-        {
-            mySTL::insertion_sort(first, last);
-        }
-    }
-
-    template <class RandomIter>
-    void sort(RandomIter first, RandomIter last)
-    {
-        if (first != last)
-        {
-            // 内省式排序，将区间分为一个个小区间，然后对整体进行插入排序
-            mySTL::intro_sort(first, last, slg2(last - first) * 2);
-            mySTL::final_insertion_sort(first, last);
-        }
-    }
-
     // 重载版本使用函数对象 cmp 代替比较操作
     // 分割函数 unchecked_partition
     template <class RandomIter, class T, class Compared>
@@ -2525,49 +2717,30 @@ namespace mySTL
         }
     }
 
-    // 内省式排序，先进行 quick sort，当分割行为有恶化倾向时，改用 heap sort
-    template <class RandomIter, class Size, class Compared>
-    void intro_sort(RandomIter first, RandomIter last,
-                    Size depth_limit, Compared cmp)
-    {
-        while (static_cast<size_t>(last - first) > kSmallSectionSize)
-        {
-            if (depth_limit == 0)
-            {                            // 到达最大分割深度限制
-                mySTL::partial_sort(first, last, last, cmp);  // 改用 heap_sort
-                return;
-            }
-            --depth_limit;
-            auto mid = mySTL::median(*(first), *(first + (last - first) / 2), *(last - 1));
-            auto cut = mySTL::unchecked_partition(first, last, mid, cmp);
-            mySTL::intro_sort(cut, last, depth_limit, cmp);
-            last = cut;
-        }
-    }
-
     // 插入排序辅助函数 unchecked_linear_insert
     template <class RandomIter, class T, class Compared>
-    void unchecked_linear_insert(RandomIter last, const T& value, Compared cmp)
+    void unchecked_linear_insert(RandomIter last, T& value, Compared cmp)
     {
         auto next = last;
         --next;
         while (cmp(value, *next))
-        {  // 从尾部开始寻找第一个可插入位置
-            *last = *next;
+        {
+            *last = mySTL::move(*next);
             last = next;
             --next;
         }
-        *last = value;
+        *last = mySTL::move(value);
     }
 
-    // 插入排序函数 unchecked_insertion_sort
+    // 插入排序函数 unchecked_insertion_sort，要求 first 之前有一个不大于区间内所有元素的元素
     template <class RandomIter, class Compared>
     void unchecked_insertion_sort(RandomIter first, RandomIter last,
-                                Compared cmp)
+                                  Compared cmp)
     {
         for (auto i = first; i != last; ++i)
         {
-            mySTL::unchecked_linear_insert(i, *i, cmp);
+            auto value = mySTL::move(*i);
+            mySTL::unchecked_linear_insert(i, value, cmp);
         }
     }
 
@@ -2579,11 +2752,11 @@ namespace mySTL
             return;
         for (auto i = first + 1; i != last; ++i)
         {
-            auto value = *i;
+            auto value = mySTL::move(*i);
             if (cmp(value, *first))
             {
-                mySTL::copy_backward(first, i, i + 1);
-                *first = value;
+                mySTL::move_backward(first, i, i + 1);
+                *first = mySTL::move(value);
             }
             else
             {
@@ -2592,32 +2765,523 @@ namespace mySTL
         }
     }
 
-    // 最终插入排序函数 final_insertion_sort
+    // 移动次数有限的插入排序，超过 kPartialInsertionSortLimit 时放弃并返回 false
     template <class RandomIter, class Compared>
-    void final_insertion_sort(RandomIter first, RandomIter last, Compared cmp)
+    bool partial_insertion_sort(RandomIter first, RandomIter last, Compared cmp)
     {
-        if (static_cast<size_t>(last - first) > kSmallSectionSize)
+        if (first == last)
+            return true;
+        size_t moves = 0;
+        for (auto i = first + 1; i != last; ++i)
         {
-            mySTL::insertion_sort(first, first + kSmallSectionSize, cmp);
-            mySTL::unchecked_insertion_sort(first + kSmallSectionSize, last, cmp);
+            auto sift = i;
+            auto prev = i - 1;
+            if (cmp(*sift, *prev))
+            {
+                auto value = mySTL::move(*sift);
+                do
+                {
+                    *sift-- = mySTL::move(*prev);
+                } while (sift != first && cmp(value, *--prev));
+                *sift = mySTL::move(value);
+                moves += static_cast<size_t>(i - sift);
+            }
+            if (moves > kPartialInsertionSortLimit)
+                return false;
+        }
+        return true;
+    }
+
+    // 使 *a, *b, *c 有序
+    template <class RandomIter, class Compared>
+    void sort3(RandomIter a, RandomIter b, RandomIter c, Compared& cmp)
+    {
+        if (cmp(*b, *a))
+            mySTL::iter_swap(a, b);
+        if (cmp(*c, *b))
+            mySTL::iter_swap(b, c);
+        if (cmp(*b, *a))
+            mySTL::iter_swap(a, b);
+    }
+
+    // 以 *first 为枢轴划分 [first, last)，小于枢轴的元素在左边，其余的在右边
+    // 返回枢轴的最终位置，以及划分前区间是否已经满足划分
+    // 调用者保证区间内有不小于枢轴的元素作为哨兵
+    template <class RandomIter, class Compared>
+    mySTL::pair<RandomIter, bool>
+    partition_right(RandomIter first, RandomIter last, Compared& cmp, m_false_type)
+    {
+        auto pivot = mySTL::move(*first);
+        auto l = first, r = last;
+        while (cmp(*++l, pivot))
+            ;
+        if (l - 1 == first)
+        {
+            while (l < r && !cmp(*--r, pivot))
+                ;
         }
         else
         {
-            mySTL::insertion_sort(first, last, cmp);
+            while (!cmp(*--r, pivot))
+                ;
+        }
+        const bool already_partitioned = l >= r;
+        while (l < r)
+        {
+            mySTL::iter_swap(l, r);
+            while (cmp(*++l, pivot))
+                ;
+            while (!cmp(*--r, pivot))
+                ;
+        }
+        auto pivot_pos = l - 1;
+        *first = mySTL::move(*pivot_pos);
+        *pivot_pos = mySTL::move(pivot);
+        return mySTL::pair<RandomIter, bool>(pivot_pos, already_partitioned);
+    }
+
+    // 交换 lbase + offsets_l[i] 与 rbase - offsets_r[i]，两边个数不同时用循环移动代替交换
+    template <class RandomIter>
+    void swap_offsets(RandomIter lbase, RandomIter rbase,
+                      const unsigned char* offsets_l, const unsigned char* offsets_r,
+                      size_t num, bool use_swaps)
+    {
+        if (use_swaps)
+        { // 逆序的区间需要逐对交换，才能保持线性时间
+            for (size_t i = 0; i < num; ++i)
+                mySTL::iter_swap(lbase + offsets_l[i], rbase - offsets_r[i]);
+        }
+        else if (num > 0)
+        {
+            auto l = lbase + offsets_l[0];
+            auto r = rbase - offsets_r[0];
+            auto tmp = mySTL::move(*l);
+            *l = mySTL::move(*r);
+            for (size_t i = 1; i < num; ++i)
+            {
+                l = lbase + offsets_l[i];
+                *r = mySTL::move(*l);
+                r = rbase - offsets_r[i];
+                *l = mySTL::move(*r);
+            }
+            *r = mySTL::move(tmp);
+        }
+    }
+
+    // 无分支的块划分：每次从左右两端各扫描一块，把位置放错的元素的偏移记录下来再成对交换，
+    // 比较的结果只用于累加下标，不产生条件跳转
+    template <class RandomIter, class Compared>
+    mySTL::pair<RandomIter, bool>
+    partition_right(RandomIter first, RandomIter last, Compared& cmp, m_true_type)
+    {
+        auto pivot = mySTL::move(*first);
+        auto l = first, r = last;
+        while (cmp(*++l, pivot))
+            ;
+        if (l - 1 == first)
+        {
+            while (l < r && !cmp(*--r, pivot))
+                ;
+        }
+        else
+        {
+            while (!cmp(*--r, pivot))
+                ;
+        }
+        const bool already_partitioned = l >= r;
+        if (!already_partitioned)
+        {
+            mySTL::iter_swap(l, r);
+            ++l;
+
+            alignas(64) unsigned char offsets_l[kPartitionBlockSize];
+            alignas(64) unsigned char offsets_r[kPartitionBlockSize];
+            auto lbase = l, rbase = r;
+            size_t num_l = 0, num_r = 0, start_l = 0, start_r = 0;
+            while (l < r)
+            {
+                // 一端的偏移用完时才扫描这一端，两端都用完时平分剩余的元素
+                const size_t num_unknown = static_cast<size_t>(r - l);
+                const size_t left_split = num_l == 0 ? (num_r == 0 ? num_unknown / 2 : num_unknown) : 0;
+                const size_t right_split = num_r == 0 ? (num_unknown - left_split) : 0;
+                const size_t lsize = left_split < kPartitionBlockSize ? left_split : kPartitionBlockSize;
+                const size_t rsize = right_split < kPartitionBlockSize ? right_split : kPartitionBlockSize;
+
+                for (size_t i = 0; i < lsize; ++i)
+                {
+                    offsets_l[num_l] = static_cast<unsigned char>(i);
+                    num_l += !cmp(*l, pivot);
+                    ++l;
+                }
+                for (size_t i = 0; i < rsize; ++i)
+                {
+                    offsets_r[num_r] = static_cast<unsigned char>(i + 1);
+                    num_r += cmp(*--r, pivot);
+                }
+
+                const size_t num = num_l < num_r ? num_l : num_r;
+                mySTL::swap_offsets(lbase, rbase, offsets_l + start_l, offsets_r + start_r,
+                                    num, num_l == num_r);
+                num_l -= num;
+                num_r -= num;
+                start_l += num;
+                start_r += num;
+                if (num_l == 0)
+                {
+                    start_l = 0;
+                    lbase = l;
+                }
+                if (num_r == 0)
+                {
+                    start_r = 0;
+                    rbase = r;
+                }
+            }
+
+            // 剩下一端还有放错的元素，把它们逐个交换到分界处
+            if (num_l != 0)
+            {
+                while (num_l--)
+                    mySTL::iter_swap(lbase + offsets_l[start_l + num_l], --r);
+                l = r;
+            }
+            if (num_r != 0)
+            {
+                while (num_r--)
+                {
+                    mySTL::iter_swap(rbase - offsets_r[start_r + num_r], l);
+                    ++l;
+                }
+                r = l;
+            }
+        }
+        auto pivot_pos = l - 1;
+        *first = mySTL::move(*pivot_pos);
+        *pivot_pos = mySTL::move(pivot);
+        return mySTL::pair<RandomIter, bool>(pivot_pos, already_partitioned);
+    }
+
+    // 以 *first 为枢轴划分 [first, last)，不大于枢轴的元素在左边，返回枢轴的最终位置
+    // 用于区间内没有小于枢轴的元素的情况，此时左边的元素都与枢轴相等
+    template <class RandomIter, class Compared>
+    RandomIter partition_left(RandomIter first, RandomIter last, Compared& cmp)
+    {
+        auto pivot = mySTL::move(*first);
+        auto l = first, r = last;
+        while (cmp(pivot, *--r))
+            ;
+        if (r + 1 == last)
+        {
+            while (l < r && !cmp(pivot, *++l))
+                ;
+        }
+        else
+        {
+            while (!cmp(pivot, *++l))
+                ;
+        }
+        while (l < r)
+        {
+            mySTL::iter_swap(l, r);
+            while (cmp(pivot, *--r))
+                ;
+            while (!cmp(pivot, *++l))
+                ;
+        }
+        *first = mySTL::move(*r);
+        *r = mySTL::move(pivot);
+        return r;
+    }
+
+    // 比较简单的算术类型才使用块划分
+    template <class T, class Compared>
+    struct use_block_partition
+        : public m_intergral_constant<bool, std::is_arithmetic<T>::value &&
+                                                (std::is_same<Compared, mySTL::less<T>>::value ||
+                                                 std::is_same<Compared, mySTL::greater<T>>::value)> {};
+
+    // pdqsort 的主循环，对左半部分递归，对右半部分循环
+    // bad_allowed 为还允许出现的不均衡划分次数，leftmost 表示 first 之前没有可以作为哨兵的元素
+    template <class RandomIter, class Compared, class BlockPartition>
+    void pdq_sort(RandomIter first, RandomIter last, Compared cmp,
+                  size_t bad_allowed, bool leftmost, BlockPartition)
+    {
+        typedef typename iterator_traits<RandomIter>::difference_type difference_type;
+        const difference_type kInsertion = static_cast<difference_type>(kInsertionSortThreshold);
+        const difference_type kNinther = static_cast<difference_type>(kNintherThreshold);
+        while (true)
+        {
+            const difference_type size = last - first;
+            if (size < kInsertion)
+            {
+                if (leftmost)
+                    mySTL::insertion_sort(first, last, cmp);
+                else
+                    mySTL::unchecked_insertion_sort(first, last, cmp);
+                return;
+            }
+
+            // 把枢轴放到 *first，同时保证 *(last - 1) 不小于枢轴
+            const difference_type half = size / 2;
+            if (size > kNinther)
+            {
+                mySTL::sort3(first, first + half, last - 1, cmp);
+                mySTL::sort3(first + 1, first + (half - 1), last - 2, cmp);
+                mySTL::sort3(first + 2, first + (half + 1), last - 3, cmp);
+                mySTL::sort3(first + (half - 1), first + half, first + (half + 1), cmp);
+                mySTL::iter_swap(first, first + half);
+            }
+            else
+            {
+                mySTL::sort3(first + half, first, last - 1, cmp);
+            }
+
+            // *(first - 1) 是上一次划分的枢轴，区间内没有比它小的元素；
+            // 如果枢轴与它相等，等于枢轴的元素都划分到左边，左边已经有序，只处理右边
+            if (!leftmost && !cmp(*(first - 1), *first))
+            {
+                first = mySTL::partition_left(first, last, cmp) + 1;
+                continue;
+            }
+
+            auto result = mySTL::partition_right(first, last, cmp, BlockPartition());
+            auto pivot_pos = result.first;
+            const difference_type l_size = pivot_pos - first;
+            const difference_type r_size = last - (pivot_pos + 1);
+
+            if (l_size < size / 8 || r_size < size / 8)
+            { // 划分极不均衡
+                if (--bad_allowed == 0)
+                {
+                    mySTL::make_heap(first, last, cmp);
+                    mySTL::sort_heap(first, last, cmp);
+                    return;
+                }
+                // 打乱几个元素，破坏导致不均衡的模式
+                if (l_size >= kInsertion)
+                {
+                    mySTL::iter_swap(first, first + l_size / 4);
+                    mySTL::iter_swap(pivot_pos - 1, pivot_pos - l_size / 4);
+                    if (l_size > kNinther)
+                    {
+                        mySTL::iter_swap(first + 1, first + (l_size / 4 + 1));
+                        mySTL::iter_swap(first + 2, first + (l_size / 4 + 2));
+                        mySTL::iter_swap(pivot_pos - 2, pivot_pos - (l_size / 4 + 1));
+                        mySTL::iter_swap(pivot_pos - 3, pivot_pos - (l_size / 4 + 2));
+                    }
+                }
+                if (r_size >= kInsertion)
+                {
+                    mySTL::iter_swap(pivot_pos + 1, pivot_pos + (1 + r_size / 4));
+                    mySTL::iter_swap(last - 1, last - r_size / 4);
+                    if (r_size > kNinther)
+                    {
+                        mySTL::iter_swap(pivot_pos + 2, pivot_pos + (2 + r_size / 4));
+                        mySTL::iter_swap(pivot_pos + 3, pivot_pos + (3 + r_size / 4));
+                        mySTL::iter_swap(last - 2, last - (1 + r_size / 4));
+                        mySTL::iter_swap(last - 3, last - (2 + r_size / 4));
+                    }
+                }
+            }
+            else if (result.second &&
+                     mySTL::partial_insertion_sort(first, pivot_pos, cmp) &&
+                     mySTL::partial_insertion_sort(pivot_pos + 1, last, cmp))
+            { // 划分前已经满足划分，并且两边都几乎有序
+                return;
+            }
+
+            mySTL::pdq_sort(first, pivot_pos, cmp, bad_allowed, leftmost, BlockPartition());
+            first = pivot_pos + 1;
+            leftmost = false;
         }
     }
 
     template <class RandomIter, class Compared>
     void sort(RandomIter first, RandomIter last, Compared cmp)
     {
-        if (first != last)
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        if (last - first > 1)
         {
-            // 内省式排序，将区间分为一个个小区间，然后对整体进行插入排序
-            mySTL::intro_sort(first, last, slg2(last - first) * 2, cmp);
-            mySTL::final_insertion_sort(first, last, cmp);
+            mySTL::pdq_sort(first, last, cmp, slg2(static_cast<size_t>(last - first)), true,
+                            use_block_partition<value_type, Compared>());
         }
     }
 
+    template <class RandomIter>
+    void sort(RandomIter first, RandomIter last)
+    {
+        mySTL::sort(first, last, mySTL::less<typename iterator_traits<RandomIter>::value_type>());
+    }
+
+    /*
+    stable_sort
+    对区间内的元素进行排序，等价元素保持原始相对位置
+    能申请到缓冲区时：每 kStableChunkSize 个元素先做插入排序，再在区间与缓冲区之间交替地两两归并，
+    缓冲区放不下半个区间时先二分，两半排好后用 merge_adaptive 合并
+    申请不到缓冲区时二分递归，用 merge_without_buffer 原地合并，复杂度为 O(nlog²n)
+    两半已经首尾有序时跳过合并
+    */
+    constexpr static size_t kStableChunkSize = 7; // 归并之前插入排序的段长
+
+    // 把 [first, last) 中每 step 个元素的相邻两段归并到 result
+    template <class RandomIter1, class RandomIter2, class Distance, class Compared>
+    void merge_sort_loop(RandomIter1 first, RandomIter1 last, RandomIter2 result,
+                         Distance step, Compared cmp)
+    {
+        const Distance two_step = 2 * step;
+        while (last - first >= two_step)
+        {
+            result = mySTL::merge_move(first, first + step, first + step, first + two_step,
+                                       result, cmp);
+            first += two_step;
+        }
+        step = mySTL::min(Distance(last - first), step);
+        mySTL::merge_move(first, first + step, first + step, last, result, cmp);
+    }
+
+    // 缓冲区至少能放下整个区间
+    template <class RandomIter, class Pointer, class Compared>
+    void merge_sort_with_buffer(RandomIter first, RandomIter last, Pointer buffer, Compared cmp)
+    {
+        typedef typename iterator_traits<RandomIter>::difference_type difference_type;
+        const difference_type len = last - first;
+        const Pointer buffer_last = buffer + len;
+        difference_type step = kStableChunkSize;
+        auto chunk = first;
+        for (; last - chunk >= step; chunk += step)
+            mySTL::insertion_sort(chunk, chunk + step, cmp);
+        mySTL::insertion_sort(chunk, last, cmp);
+        while (step < len)
+        {
+            mySTL::merge_sort_loop(first, last, buffer, step, cmp);
+            step *= 2;
+            mySTL::merge_sort_loop(buffer, buffer_last, first, step, cmp);
+            step *= 2;
+        }
+    }
+
+    template <class RandomIter, class Pointer, class Distance, class Compared>
+    void stable_sort_adaptive(RandomIter first, RandomIter last, Pointer buffer,
+                              Distance buffer_size, Compared cmp)
+    {
+        if (last - first < 2)
+            return;
+        const Distance len = (last - first + 1) / 2;
+        const RandomIter middle = first + len;
+        if (len > buffer_size)
+        {
+            mySTL::stable_sort_adaptive(first, middle, buffer, buffer_size, cmp);
+            mySTL::stable_sort_adaptive(middle, last, buffer, buffer_size, cmp);
+        }
+        else
+        {
+            mySTL::merge_sort_with_buffer(first, middle, buffer, cmp);
+            mySTL::merge_sort_with_buffer(middle, last, buffer, cmp);
+        }
+        if (cmp(*middle, *(middle - 1)))
+        {
+            mySTL::merge_adaptive(first, middle, last, Distance(middle - first),
+                                  Distance(last - middle), buffer, buffer_size, cmp);
+        }
+    }
+
+    template <class RandomIter, class Compared>
+    void inplace_stable_sort(RandomIter first, RandomIter last, Compared cmp)
+    {
+        if (last - first < static_cast<ptrdiff_t>(2 * kStableChunkSize))
+        {
+            mySTL::insertion_sort(first, last, cmp);
+            return;
+        }
+        const RandomIter middle = first + (last - first) / 2;
+        mySTL::inplace_stable_sort(first, middle, cmp);
+        mySTL::inplace_stable_sort(middle, last, cmp);
+        if (cmp(*middle, *(middle - 1)))
+            mySTL::merge_without_buffer(first, middle, last, middle - first, last - middle, cmp);
+    }
+
+    template <class RandomIter, class Compared>
+    void stable_sort(RandomIter first, RandomIter last, Compared cmp)
+    {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        typedef typename iterator_traits<RandomIter>::difference_type difference_type;
+        if (last - first < 2)
+            return;
+        temporary_buffer<RandomIter, value_type> buf(first, last);
+        if (!buf.begin())
+        {
+            mySTL::inplace_stable_sort(first, last, cmp);
+        }
+        else
+        {
+            mySTL::stable_sort_adaptive(first, last, buf.begin(),
+                                        static_cast<difference_type>(buf.size()), cmp);
+        }
+    }
+
+    template <class RandomIter>
+    void stable_sort(RandomIter first, RandomIter last)
+    {
+        mySTL::stable_sort(first, last, mySTL::less<typename iterator_traits<RandomIter>::value_type>());
+    }
+
+    /*
+    partial_stable_sort
+    稳定的 partial_sort：[first, middle) 中是最小的 middle - first 个元素，按稳定排序的次序排列，
+    等价元素中原来靠前的优先被选中，[middle, last) 中剩余元素的次序不确定
+    后面的元素每 middle - first 个一块，块中有元素小于已选出的最大元素时才对这一块做 stable_sort，
+    再与 [first, middle) 归并，较小的 middle - first 个留在前面，其余放回这一块，复杂度为 O(nlogk)
+    申请不到 middle - first 个元素的缓冲区时对整个区间做 stable_sort
+    */
+    template <class RandomIter, class Compared>
+    void partial_stable_sort(RandomIter first, RandomIter middle, RandomIter last, Compared cmp)
+    {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        typedef typename iterator_traits<RandomIter>::difference_type difference_type;
+        if (first == middle)
+            return;
+        const difference_type k = middle - first;
+        temporary_buffer<RandomIter, value_type> buf(first, middle);
+        if (static_cast<difference_type>(buf.size()) < k)
+        {
+            mySTL::stable_sort(first, last, cmp);
+            return;
+        }
+        auto buffer = buf.begin();
+        mySTL::stable_sort_adaptive(first, middle, buffer, k, cmp);
+        for (auto chunk = middle; chunk != last;)
+        {
+            const auto chunk_last = last - chunk > k ? chunk + k : last;
+            auto it = chunk;
+            while (it != chunk_last && !cmp(*it, *(middle - 1)))
+                ++it;
+            if (it != chunk_last)
+            {   // 这一块中有元素小于已选出的最大元素，排序后归并；[first, middle) 中的元素在前，相等时优先选取
+                mySTL::stable_sort_adaptive(chunk, chunk_last, buffer, k, cmp);
+                const auto buffer_end = mySTL::move(first, middle, buffer);
+                auto p = buffer;
+                auto q = chunk;
+                for (auto out = first; out != middle; ++out)
+                {
+                    if (q != chunk_last && cmp(*q, *p))
+                        *out = mySTL::move(*q++);
+                    else
+                        *out = mySTL::move(*p++);
+                }
+                // 从这一块取走了 q - chunk 个元素，缓冲区中正好剩下这么多
+                mySTL::move(p, buffer_end, chunk);
+            }
+            chunk = chunk_last;
+        }
+    }
+
+    template <class RandomIter>
+    void partial_stable_sort(RandomIter first, RandomIter middle, RandomIter last)
+    {
+        mySTL::partial_stable_sort(first, middle, last,
+                                   mySTL::less<typename iterator_traits<RandomIter>::value_type>());
+    }
+
     /*
     nth_element
     对序列重排，使得所有小于第 n 个元素的元素出现在它的前面，大于它的出现在它的后面
@@ -98,11 +98,68 @@ namespace mySTL
         return result + n;
     }
 
+    //  分段迭代器版本：按段拆开，每一段以指针调用 copy
+    template <class InputIter, class OutputIter>
+    OutputIter copy(InputIter first, InputIter last, OutputIter result);
+
+    template <class SegIter, class OutputIter, class OutSeg>
+    OutputIter copy_seg(SegIter first, SegIter last, OutputIter result, m_true_type, OutSeg)
+    {
+        typedef segmented_iterator_traits<SegIter> traits;
+        auto sf = traits::segment(first);
+        const auto sl = traits::segment(last);
+        if (sf == sl)
+        {
+            return mySTL::copy(traits::local(first), traits::local(last), result);
+        }
+        result = mySTL::copy(traits::local(first), traits::end(sf), result);
+        for (++sf; sf != sl; ++sf)
+        {
+            result = mySTL::copy(traits::begin(sf), traits::end(sf), result);
+        }
+        return mySTL::copy(traits::begin(sl), traits::local(last), result);
+    }
+
+    //  目的区间为分段迭代器：按目的段的剩余空间拆开
+    template <class RandomIter, class SegIter>
+    SegIter copy_seg(RandomIter first, RandomIter last, SegIter result, m_false_type, m_true_type)
+    {
+        typedef segmented_iterator_traits<SegIter> traits;
+        auto n = last - first;
+        if (n <= 0)
+        {
+            return result;
+        }
+        auto seg = traits::segment(result);
+        auto cur = traits::local(result);
+        while (true)
+        {
+            const auto k = mySTL::min(n, static_cast<decltype(n)>(traits::end(seg) - cur));
+            cur = unchecked_copy(first, first + k, cur);
+            first += k;
+            n -= k;
+            if (n == 0)
+            {
+                return traits::compose(seg, cur);
+            }
+            ++seg;
+            cur = traits::begin(seg);
+        }
+    }
+
+    template <class InputIter, class OutputIter>
+    OutputIter copy_seg(InputIter first, InputIter last, OutputIter result, m_false_type, m_false_type)
+    {
+        return unchecked_copy(first, last, result);
+    }
+
     //  整合 unchecked
     template <class InputIter, class OutputIter>
     OutputIter copy(InputIter first, InputIter last, OutputIter result)
     {
-        return unchecked_copy(first, last, result);
+        return copy_seg(first, last, result, is_segmented_iterator<InputIter>{},
+                        m_intergral_constant<bool, is_segmented_iterator<OutputIter>::value &&
+                                                       is_random_access_iterator<InputIter>::value>{});
     }
 
     //  copy_backward BidirectionalIter
@@ -157,12 +214,76 @@ namespace mySTL
         return result;
     }
     
+    //  分段迭代器版本：从最后一段开始，每一段以指针调用 copy_backward
+    template <class BidirectionalIter1, class BidirectionalIter2>
+    BidirectionalIter2
+    copy_backward(BidirectionalIter1 first, BidirectionalIter1 last, BidirectionalIter2 result);
+
+    template <class SegIter, class BidirectionalIter2, class OutSeg>
+    BidirectionalIter2
+    copy_backward_seg(SegIter first, SegIter last, BidirectionalIter2 result, m_true_type, OutSeg)
+    {
+        typedef segmented_iterator_traits<SegIter> traits;
+        const auto sf = traits::segment(first);
+        auto sl = traits::segment(last);
+        if (sf == sl)
+        {
+            return mySTL::copy_backward(traits::local(first), traits::local(last), result);
+        }
+        result = mySTL::copy_backward(traits::begin(sl), traits::local(last), result);
+        for (--sl; sl != sf; --sl)
+        {
+            result = mySTL::copy_backward(traits::begin(sl), traits::end(sl), result);
+        }
+        return mySTL::copy_backward(traits::local(first), traits::end(sf), result);
+    }
+
+    //  目的区间为分段迭代器：按目的段中 result 之前的空间拆开
+    template <class RandomIter, class SegIter>
+    SegIter copy_backward_seg(RandomIter first, RandomIter last, SegIter result, m_false_type, m_true_type)
+    {
+        typedef segmented_iterator_traits<SegIter> traits;
+        auto n = last - first;
+        if (n <= 0)
+        {
+            return result;
+        }
+        auto seg = traits::segment(result);
+        auto cur = traits::local(result);
+        while (true)
+        {
+            if (cur == traits::begin(seg))
+            {
+                --seg;
+                cur = traits::end(seg);
+            }
+            const auto k = mySTL::min(n, static_cast<decltype(n)>(cur - traits::begin(seg)));
+            cur = unchecked_copy_backward(last - k, last, cur);
+            last -= k;
+            n -= k;
+            if (n == 0)
+            {
+                return traits::compose(seg, cur);
+            }
+        }
+    }
+
+    template <class BidirectionalIter1, class BidirectionalIter2>
+    BidirectionalIter2
+    copy_backward_seg(BidirectionalIter1 first, BidirectionalIter1 last, BidirectionalIter2 result,
+                      m_false_type, m_false_type)
+    {
+        return unchecked_copy_backward(first, last, result);
+    }
+
     //  整合所有
     template <class BidirectionalIter1, class BidirectionalIter2>
     BidirectionalIter2 
     copy_backward(BidirectionalIter1 first, BidirectionalIter1 last, BidirectionalIter2 result)
     {
-        return unchecked_copy_backward(first, last, result);
+        return copy_backward_seg(first, last, result, is_segmented_iterator<BidirectionalIter1>{},
+                                 m_intergral_constant<bool, is_segmented_iterator<BidirectionalIter2>::value &&
+                                                                is_random_access_iterator<BidirectionalIter1>::value>{});
     }
 
     //  copy_if
@@ -256,12 +377,69 @@ namespace mySTL
         return result + n;
     }
 
+    //  分段迭代器版本：按段拆开，每一段以指针调用 move
     template <class InputIter, class OutputIter>
-    OutputIter move(InputIter first, InputIter last, OutputIter result)
+    OutputIter move(InputIter first, InputIter last, OutputIter result);
+
+    template <class SegIter, class OutputIter, class OutSeg>
+    OutputIter move_seg(SegIter first, SegIter last, OutputIter result, m_true_type, OutSeg)
+    {
+        typedef segmented_iterator_traits<SegIter> traits;
+        auto sf = traits::segment(first);
+        const auto sl = traits::segment(last);
+        if (sf == sl)
+        {
+            return mySTL::move(traits::local(first), traits::local(last), result);
+        }
+        result = mySTL::move(traits::local(first), traits::end(sf), result);
+        for (++sf; sf != sl; ++sf)
+        {
+            result = mySTL::move(traits::begin(sf), traits::end(sf), result);
+        }
+        return mySTL::move(traits::begin(sl), traits::local(last), result);
+    }
+
+    //  目的区间为分段迭代器：按目的段的剩余空间拆开
+    template <class RandomIter, class SegIter>
+    SegIter move_seg(RandomIter first, RandomIter last, SegIter result, m_false_type, m_true_type)
+    {
+        typedef segmented_iterator_traits<SegIter> traits;
+        auto n = last - first;
+        if (n <= 0)
+        {
+            return result;
+        }
+        auto seg = traits::segment(result);
+        auto cur = traits::local(result);
+        while (true)
+        {
+            const auto k = mySTL::min(n, static_cast<decltype(n)>(traits::end(seg) - cur));
+            cur = unchecked_move(first, first + k, cur);
+            first += k;
+            n -= k;
+            if (n == 0)
+            {
+                return traits::compose(seg, cur);
+            }
+            ++seg;
+            cur = traits::begin(seg);
+        }
+    }
+
+    template <class InputIter, class OutputIter>
+    OutputIter move_seg(InputIter first, InputIter last, OutputIter result, m_false_type, m_false_type)
     {
         return unchecked_move(first, last, result);
     }
 
+    template <class InputIter, class OutputIter>
+    OutputIter move(InputIter first, InputIter last, OutputIter result)
+    {
+        return move_seg(first, last, result, is_segmented_iterator<InputIter>{},
+                        m_intergral_constant<bool, is_segmented_iterator<OutputIter>::value &&
+                                                       is_random_access_iterator<InputIter>::value>{});
+    }
+
     //  move_backward bidirectional_iterator_tag版本
     template <class BidirectionalIter1, class BidirectionalIter2>
     BidirectionalIter2
@@ -314,17 +492,84 @@ namespace mySTL
         return result;
     }
 
+    //  分段迭代器版本：从最后一段开始，每一段以指针调用 move_backward
+    template <class BidirectionalIter1, class BidirectionalIter2>
+    BidirectionalIter2
+    move_backward(BidirectionalIter1 first, BidirectionalIter1 last, BidirectionalIter2 result);
+
+    template <class SegIter, class BidirectionalIter2, class OutSeg>
+    BidirectionalIter2
+    move_backward_seg(SegIter first, SegIter last, BidirectionalIter2 result, m_true_type, OutSeg)
+    {
+        typedef segmented_iterator_traits<SegIter> traits;
+        const auto sf = traits::segment(first);
+        auto sl = traits::segment(last);
+        if (sf == sl)
+        {
+            return mySTL::move_backward(traits::local(first), traits::local(last), result);
+        }
+        result = mySTL::move_backward(traits::begin(sl), traits::local(last), result);
+        for (--sl; sl != sf; --sl)
+        {
+            result = mySTL::move_backward(traits::begin(sl), traits::end(sl), result);
+        }
+        return mySTL::move_backward(traits::local(first), traits::end(sf), result);
+    }
+
+    //  目的区间为分段迭代器：按目的段中 result 之前的空间拆开
+    template <class RandomIter, class SegIter>
+    SegIter move_backward_seg(RandomIter first, RandomIter last, SegIter result, m_false_type, m_true_type)
+    {
+        typedef segmented_iterator_traits<SegIter> traits;
+        auto n = last - first;
+        if (n <= 0)
+        {
+            return result;
+        }
+        auto seg = traits::segment(result);
+        auto cur = traits::local(result);
+        while (true)
+        {
+            if (cur == traits::begin(seg))
+            {
+                --seg;
+                cur = traits::end(seg);
+            }
+            const auto k = mySTL::min(n, static_cast<decltype(n)>(cur - traits::begin(seg)));
+            cur = unchecked_move_backward(last - k, last, cur);
+            last -= k;
+            n -= k;
+            if (n == 0)
+            {
+                return traits::compose(seg, cur);
+            }
+        }
+    }
+
+    template <class BidirectionalIter1, class BidirectionalIter2>
+    BidirectionalIter2
+    move_backward_seg(BidirectionalIter1 first, BidirectionalIter1 last, BidirectionalIter2 result,
+                      m_false_type, m_false_type)
+    {
+        return unchecked_move_backward(first, last, result);
+    }
+
     //  整合所有
     template <class BidirectionalIter1, class BidirectionalIter2>
     BidirectionalIter2
     move_backward(BidirectionalIter1 first, BidirectionalIter1 last, BidirectionalIter2 result)
     {
-        return unchecked_move_backward(first, last, result);
+        return move_backward_seg(first, last, result, is_segmented_iterator<BidirectionalIter1>{},
+                                 m_intergral_constant<bool, is_segmented_iterator<BidirectionalIter2>::value &&
+                                                                is_random_access_iterator<BidirectionalIter1>::value>{});
     }
 
     //  equal
     template <class InputIter1, class InputIter2>
-    bool equal(InputIter1 first1, InputIter1 last1, InputIter2 first2)
+    bool equal(InputIter1 first1, InputIter1 last1, InputIter2 first2);
+
+    template <class InputIter1, class InputIter2>
+    bool unchecked_equal(InputIter1 first1, InputIter1 last1, InputIter2 first2)
     {
         for (; first1 != last1; ++first1, ++first2)
         {
@@ -336,6 +581,91 @@ namespace mySTL
         return true;
     }
 
+    //  整数与指针按字节比较
+    template <class Tp, class Up>
+    typename std::enable_if<
+        std::is_same<typename std::remove_const<Tp>::type, typename std::remove_const<Up>::type>::value &&
+        (std::is_integral<Up>::value || std::is_pointer<Up>::value),
+        bool>::type
+    unchecked_equal(Tp* first1, Tp* last1, Up* first2)
+    {
+        const auto n = static_cast<size_t>(last1 - first1);
+        return n == 0 || std::memcmp(first1, first2, n * sizeof(Up)) == 0;
+    }
+
+    //  第一个区间为分段迭代器：按段拆开，第二个区间需要能多次遍历
+    template <class SegIter, class ForwardIter, class Seg2>
+    bool equal_seg(SegIter first1, SegIter last1, ForwardIter first2, m_true_type, Seg2)
+    {
+        typedef segmented_iterator_traits<SegIter> traits;
+        auto sf = traits::segment(first1);
+        const auto sl = traits::segment(last1);
+        if (sf == sl)
+        {
+            return mySTL::equal(traits::local(first1), traits::local(last1), first2);
+        }
+        if (!mySTL::equal(traits::local(first1), traits::end(sf), first2))
+        {
+            return false;
+        }
+        mySTL::advance(first2, traits::end(sf) - traits::local(first1));
+        for (++sf; sf != sl; ++sf)
+        {
+            if (!mySTL::equal(traits::begin(sf), traits::end(sf), first2))
+            {
+                return false;
+            }
+            mySTL::advance(first2, traits::end(sf) - traits::begin(sf));
+        }
+        return mySTL::equal(traits::begin(sl), traits::local(last1), first2);
+    }
+
+    //  第二个区间为分段迭代器：按第二个区间的段拆开
+    template <class RandomIter, class SegIter>
+    bool equal_seg(RandomIter first1, RandomIter last1, SegIter first2, m_false_type, m_true_type)
+    {
+        typedef segmented_iterator_traits<SegIter> traits;
+        auto n = last1 - first1;
+        if (n <= 0)
+        {
+            return true;
+        }
+        auto seg = traits::segment(first2);
+        auto cur = traits::local(first2);
+        while (true)
+        {
+            const auto k = mySTL::min(n, static_cast<decltype(n)>(traits::end(seg) - cur));
+            if (!unchecked_equal(first1, first1 + k, cur))
+            {
+                return false;
+            }
+            first1 += k;
+            n -= k;
+            if (n == 0)
+            {
+                return true;
+            }
+            ++seg;
+            cur = traits::begin(seg);
+        }
+    }
+
+    template <class InputIter1, class InputIter2>
+    bool equal_seg(InputIter1 first1, InputIter1 last1, InputIter2 first2, m_false_type, m_false_type)
+    {
+        return unchecked_equal(first1, last1, first2);
+    }
+
+    template <class InputIter1, class InputIter2>
+    bool equal(InputIter1 first1, InputIter1 last1, InputIter2 first2)
+    {
+        return equal_seg(first1, last1, first2,
+                         m_intergral_constant<bool, is_segmented_iterator<InputIter1>::value &&
+                                                        is_forward_iterator<InputIter2>::value>{},
+                         m_intergral_constant<bool, is_segmented_iterator<InputIter2>::value &&
+                                                        is_random_access_iterator<InputIter1>::value>{});
+    }
+
     //  equal overload cmp
     template <class InputIter1, class InputIter2, class cmpared>
     bool equal(InputIter1 first1, InputIter1 last1, InputIter2 first2, cmpared cmp)
@@ -377,12 +707,43 @@ namespace mySTL
         return first + n;   
     }
 
+    //  分段迭代器版本：按段拆开，每一段以指针调用 fill_n
+    template <class SegIter, class Size, class T>
+    SegIter fill_n_seg(SegIter first, Size n, const T& value, m_true_type)
+    {
+        typedef segmented_iterator_traits<SegIter> traits;
+        if (n <= 0)
+        {
+            return first;
+        }
+        auto seg = traits::segment(first);
+        auto cur = traits::local(first);
+        while (true)
+        {
+            const auto k = mySTL::min(static_cast<ptrdiff_t>(n), traits::end(seg) - cur);
+            cur = unchecked_fill_n(cur, k, value);
+            n -= static_cast<Size>(k);
+            if (n == 0)
+            {
+                return traits::compose(seg, cur);
+            }
+            ++seg;
+            cur = traits::begin(seg);
+        }
+    }
+
     template <class OutputIter, class Size, class T>
-    OutputIter fill_n(OutputIter first, Size n, const T& value)
+    OutputIter fill_n_seg(OutputIter first, Size n, const T& value, m_false_type)
     {
         return unchecked_fill_n(first, n, value);
     }
 
+    template <class OutputIter, class Size, class T>
+    OutputIter fill_n(OutputIter first, Size n, const T& value)
+    {
+        return fill_n_seg(first, n, value, is_segmented_iterator<OutputIter>{});
+    }
+
     //  fill
     template <class ForwardIter, class T>
     void fill_cat(ForwardIter first, ForwardIter last, const T& value, mySTL::forward_iterator_tag)
@@ -397,7 +758,7 @@ namespace mySTL
     void fill_cat(RandomIter first, RandomIter last, const T& value,
                 mySTL::random_access_iterator_tag)
     {
-        fill_n(first, last - first, value);
+        mySTL::fill_n(first, last - first, value);
     }
 
     template <class ForwardIter, class T>
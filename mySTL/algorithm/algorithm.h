@@ -1,13 +1,14 @@
 ﻿#ifndef MYSTL_ALGORITHM_H_
 #define MYSTL_ALGORITHM_H_
 
-// 这个头文件包含了 mystl 的所有算法，包括基本算法，数值算法，heap 算法，set 算法和其他算法
+// 这个头文件包含了 mystl 的所有算法，包括基本算法，数值算法，heap 算法，set 算法，基数排序和其他算法
 
 #include "algobase.h"
 #include "algo.h"
 #include "set_algo.h"
 #include "heap_algo.h"
 #include "numeric.h"
+#include "radix_sort.h"
 
 namespace mySTL
 {
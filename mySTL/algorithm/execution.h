@@ -0,0 +1,79 @@
+#ifndef MYSTL_EXECUTION_H_
+#define MYSTL_EXECUTION_H_
+
+// 这个头文件包含执行策略 sequenced_policy、parallel_policy、parallel_unsequenced_policy
+// 以及它们的对象 execution::seq、execution::par、execution::par_unseq
+// 作为 parallel_algo.h 中算法的第一个参数：
+//   mySTL::sort(mySTL::execution::par, v.begin(), v.end());
+
+// notes:
+//
+// seq       : 在调用线程上按顺序执行，等同于不带策略的版本
+// par       : 把区间分块交给 thread_pool::instance() 执行，块内按顺序执行
+// par_unseq : 同 par，块内使用可向量化的循环，元素访问函数之间不能有依赖，也不能加锁
+// 每个策略定义 is_parallel 与 is_unsequenced 两个标签，算法据此分派
+
+#include "../iterator/type_traits.h"
+
+// 提示编译器忽略循环中的内存依赖，用于 par_unseq 的块内循环
+#if defined(__clang__)
+#define MYSTL_VECTORIZE_LOOP _Pragma("clang loop vectorize(enable) interleave(enable)")
+#elif defined(__GNUC__)
+#define MYSTL_VECTORIZE_LOOP _Pragma("GCC ivdep")
+#elif defined(_MSC_VER)
+#define MYSTL_VECTORIZE_LOOP __pragma(loop(ivdep))
+#else
+#define MYSTL_VECTORIZE_LOOP
+#endif
+
+namespace mySTL
+{
+namespace execution
+{
+    class sequenced_policy
+    {
+    public:
+        typedef m_false_type is_parallel;
+        typedef m_false_type is_unsequenced;
+    };
+
+    class parallel_policy
+    {
+    public:
+        typedef m_true_type is_parallel;
+        typedef m_false_type is_unsequenced;
+    };
+
+    class parallel_unsequenced_policy
+    {
+    public:
+        typedef m_true_type is_parallel;
+        typedef m_true_type is_unsequenced;
+    };
+
+    constexpr sequenced_policy seq{};
+    constexpr parallel_policy par{};
+    constexpr parallel_unsequenced_policy par_unseq{};
+
+} // namespace execution
+
+    // 萃取执行策略
+    template <class T>
+    struct is_execution_policy : public m_false_type {};
+
+    template <>
+    struct is_execution_policy<execution::sequenced_policy> : public m_true_type {};
+
+    template <>
+    struct is_execution_policy<execution::parallel_policy> : public m_true_type {};
+
+    template <>
+    struct is_execution_policy<execution::parallel_unsequenced_policy> : public m_true_type {};
+
+    // 只有第一个参数是执行策略时才参与重载，避免与不带策略的版本冲突
+    template <class ExecutionPolicy, class T>
+    struct enable_if_execution_policy
+        : public std::enable_if<is_execution_policy<typename std::decay<ExecutionPolicy>::type>::value, T> {};
+
+} // namespace mySTL
+#endif // !MYSTL_EXECUTION_H_
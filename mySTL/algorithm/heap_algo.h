@@ -152,7 +152,7 @@ namespace mySTL
     {
         while (last - first > 1)
         {
-            pop_heap(first, last--);
+            mySTL::pop_heap(first, last--);
         }
     }
 
@@ -162,7 +162,7 @@ namespace mySTL
     {
         while (last - first > 1)
         {
-            pop_heap(first, last--, cmp);
+            mySTL::pop_heap(first, last--, cmp);
         }
     }
 
@@ -194,7 +194,7 @@ namespace mySTL
     template <class RandomIter>
     void make_heap(RandomIter first, RandomIter last)
     {
-        make_heap_aux(first, last, distance(first));
+        mySTL::make_heap_aux(first, last, distance_type(first));
     }
 
     // 重载版本使用函数对象 cmp 代替比较操作
@@ -3,7 +3,7 @@
 
 #include "../iterator/iterator.h"
 
-//  accumulate, adjacent_difference, inner_product, itoa, partial_sum
+//  accumulate, reduce, adjacent_difference, inner_product, itoa, partial_sum, inclusive_scan
 
 namespace mySTL
 {
@@ -33,6 +33,34 @@ namespace mySTL
         return init;
     }
 
+    /* 
+    reduce
+    与 accumulate 相同，但不保证运算顺序，binary_op 需要满足结合律与交换律，
+    带执行策略的版本（parallel_algo.h）据此分块并行计算
+    版本1：以 value_type() 为初值累加
+    版本2：以init为初值累加
+    版本3：自定义二元操作
+    */
+
+    template <class InputIter>
+    typename iterator_traits<InputIter>::value_type
+    reduce(InputIter first, InputIter last)
+    {
+        return mySTL::accumulate(first, last, typename iterator_traits<InputIter>::value_type());
+    }
+
+    template <class InputIter, class T>
+    T reduce(InputIter first, InputIter last, T init)
+    {
+        return mySTL::accumulate(first, last, init);
+    }
+
+    template <class InputIter, class T, class BinaryOp>
+    T reduce(InputIter first, InputIter last, T init, BinaryOp binary_op)
+    {
+        return mySTL::accumulate(first, last, init, binary_op);
+    }
+
     /* 
     adjacent_difference
     版本1：计算相邻元素的差值，结果保存到以resutl为起的区间上
@@ -156,6 +184,39 @@ namespace mySTL
         return ++result;
     }
 
+    /* 
+    inclusive_scan
+    与 partial_sum 相同，但 binary_op 只需满足结合律，带执行策略的版本据此分块并行计算
+    版本1：计算局部累计求和
+    版本2：自定义二元操作
+    版本3：自定义二元操作，以init为初值
+     */
+
+    template <class InputIter, class OutputIter>
+    OutputIter inclusive_scan(InputIter first, InputIter last, OutputIter result)
+    {
+        return mySTL::partial_sum(first, last, result);
+    }
+
+    template <class InputIter, class OutputIter, class BinaryOp>
+    OutputIter inclusive_scan(InputIter first, InputIter last, OutputIter result,
+                              BinaryOp binary_op)
+    {
+        return mySTL::partial_sum(first, last, result, binary_op);
+    }
+
+    template <class InputIter, class OutputIter, class BinaryOp, class T>
+    OutputIter inclusive_scan(InputIter first, InputIter last, OutputIter result,
+                              BinaryOp binary_op, T init)
+    {
+        for (; first != last; ++first, ++result)
+        {
+            init = binary_op(init, *first);
+            *result = init;
+        }
+        return result;
+    }
+
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,1040 @@
+#ifndef MYSTL_PARALLEL_ALGO_H_
+#define MYSTL_PARALLEL_ALGO_H_
+
+// 这个头文件包含带执行策略的算法重载：
+// for_each, transform, count_if, find_if, copy, fill, remove_if, unique, sort, stable_sort,
+// reduce, inner_product, inclusive_scan, partial_sum
+//   mySTL::sort(mySTL::execution::par, v.begin(), v.end());
+//   auto sum = mySTL::reduce(mySTL::execution::par_unseq, v.begin(), v.end(), 0LL);
+
+// notes:
+//
+// 区间被分成若干块交给 thread_pool::instance()，每块至少 MYSTL_PARALLEL_GRAIN 个元素，
+// 块数不超过线程数的 4 倍；区间太短（不足两块）时直接在调用线程上执行
+// 策略为 seq 或者迭代器不能随机访问时退化为不带策略的版本
+// 函数对象可能在多个线程上同时被调用，需要自行保证线程安全；某一块抛出的异常在所有块结束后重新抛出
+// par_unseq 在块内使用 MYSTL_VECTORIZE_LOOP 修饰的下标循环，reduce / inner_product 使用 4 个独立的累加器
+// reduce / inner_product 要求运算满足结合律与交换律，inclusive_scan / partial_sum 只要求结合律：
+// 先并行求出每块的和，顺序求出每块的前缀，再并行扫描每一块
+// remove_if / unique 在块内并行压缩，再按顺序把各块剩余的元素移到一起
+// sort 是样本排序，分割点把元素分到约 4 倍线程数的桶中，再并行排序每个桶，需要 n 个元素的缓冲区
+// stable_sort 先并行排序各块，再逐轮并行归并，每轮按输出位置均分，同样需要 n 个元素的缓冲区
+// 这些算法依赖 thread_pool，因此没有放进 algorithm.h，需要时单独包含这个头文件
+
+#include <atomic>
+
+#include "algo.h"
+#include "numeric.h"
+#include "execution.h"
+#include "../container/sequence/vector.h"
+#include "../util/thread_pool.h"
+
+namespace mySTL
+{
+#ifndef MYSTL_PARALLEL_GRAIN
+#define MYSTL_PARALLEL_GRAIN 4096
+#endif
+
+    /*****************************************************************************************/
+    // 辅助工具
+    /*****************************************************************************************/
+
+    // 所有迭代器都可以随机访问
+    template <class Iter, class... Rest>
+    struct all_random_access
+        : public m_intergral_constant<bool, is_random_access_iterator<Iter>::value &&
+                                                all_random_access<Rest...>::value> {};
+
+    template <class Iter>
+    struct all_random_access<Iter> : public is_random_access_iterator<Iter> {};
+
+    // 策略要求并行且迭代器都可以随机访问时才分块执行
+    template <class ExecutionPolicy, class... Iters>
+    struct parallel_execution
+        : public m_intergral_constant<bool, std::decay<ExecutionPolicy>::type::is_parallel::value &&
+                                                all_random_access<Iters...>::value> {};
+
+    template <class ExecutionPolicy>
+    struct unsequenced_execution : public std::decay<ExecutionPolicy>::type::is_unsequenced {};
+
+    // 分块的个数，不足两块时为 1
+    inline size_t parallel_chunk_count(size_t n)
+    {
+        if (n < 2 * MYSTL_PARALLEL_GRAIN)
+            return 1;
+        const size_t limit = thread_pool::instance().size() * 4;
+        const size_t k = n / MYSTL_PARALLEL_GRAIN;
+        return k < limit ? k : limit;
+    }
+
+    // 把 [0, n) 均分成 k 块，对第 c 块 [b, e) 调用 f(c, b, e)
+    template <class Function>
+    void parallel_chunks(size_t n, size_t k, Function f)
+    {
+        if (k == 1)
+        {
+            f(size_t(0), size_t(0), n);
+            return;
+        }
+        mySTL::parallel_for(size_t(0), k, size_t(1), [&f, n, k](size_t b, size_t e) {
+            for (size_t c = b; c < e; ++c)
+                f(c, n * c / k, n * (c + 1) / k);
+        });
+    }
+
+    /*****************************************************************************************/
+    // for_each
+    /*****************************************************************************************/
+    template <class RandomIter, class Function>
+    void chunk_for_each(RandomIter first, RandomIter last, Function &f, m_false_type)
+    {
+        for (; first != last; ++first)
+            f(*first);
+    }
+
+    template <class RandomIter, class Function>
+    void chunk_for_each(RandomIter first, RandomIter last, Function &f, m_true_type)
+    {
+        const auto n = last - first;
+        MYSTL_VECTORIZE_LOOP
+        for (decltype(last - first) i = 0; i < n; ++i)
+            f(first[i]);
+    }
+
+    template <class ForwardIter, class Function, class Unseq>
+    void parallel_for_each_dispatch(ForwardIter first, ForwardIter last, Function &f, m_false_type, Unseq)
+    {
+        mySTL::for_each(first, last, f);
+    }
+
+    template <class RandomIter, class Function, class Unseq>
+    void parallel_for_each_dispatch(RandomIter first, RandomIter last, Function &f, m_true_type, Unseq)
+    {
+        const size_t n = static_cast<size_t>(last - first);
+        parallel_chunks(n, parallel_chunk_count(n), [first, &f](size_t, size_t b, size_t e) {
+            mySTL::chunk_for_each(first + b, first + e, f, Unseq());
+        });
+    }
+
+    template <class ExecutionPolicy, class ForwardIter, class Function>
+    typename enable_if_execution_policy<ExecutionPolicy, void>::type
+    for_each(ExecutionPolicy &&, ForwardIter first, ForwardIter last, Function f)
+    {
+        mySTL::parallel_for_each_dispatch(first, last, f,
+                                          parallel_execution<ExecutionPolicy, ForwardIter>(),
+                                          unsequenced_execution<ExecutionPolicy>());
+    }
+
+    /*****************************************************************************************/
+    // transform
+    // 版本1：一元操作，版本2：二元操作
+    /*****************************************************************************************/
+    template <class RandomIter1, class RandomIter2, class UnaryOp>
+    void chunk_transform(RandomIter1 first, RandomIter1 last, RandomIter2 result,
+                         UnaryOp &op, m_false_type)
+    {
+        for (; first != last; ++first, ++result)
+            *result = op(*first);
+    }
+
+    template <class RandomIter1, class RandomIter2, class UnaryOp>
+    void chunk_transform(RandomIter1 first, RandomIter1 last, RandomIter2 result,
+                         UnaryOp &op, m_true_type)
+    {
+        const auto n = last - first;
+        MYSTL_VECTORIZE_LOOP
+        for (decltype(last - first) i = 0; i < n; ++i)
+            result[i] = op(first[i]);
+    }
+
+    template <class RandomIter1, class RandomIter2, class RandomIter3, class BinaryOp>
+    void chunk_transform(RandomIter1 first1, RandomIter1 last1, RandomIter2 first2,
+                         RandomIter3 result, BinaryOp &op, m_false_type)
+    {
+        for (; first1 != last1; ++first1, ++first2, ++result)
+            *result = op(*first1, *first2);
+    }
+
+    template <class RandomIter1, class RandomIter2, class RandomIter3, class BinaryOp>
+    void chunk_transform(RandomIter1 first1, RandomIter1 last1, RandomIter2 first2,
+                         RandomIter3 result, BinaryOp &op, m_true_type)
+    {
+        const auto n = last1 - first1;
+        MYSTL_VECTORIZE_LOOP
+        for (decltype(last1 - first1) i = 0; i < n; ++i)
+            result[i] = op(first1[i], first2[i]);
+    }
+
+    template <class ForwardIter1, class ForwardIter2, class UnaryOp, class Unseq>
+    ForwardIter2 parallel_transform_dispatch(ForwardIter1 first, ForwardIter1 last,
+                                             ForwardIter2 result, UnaryOp &op, m_false_type, Unseq)
+    {
+        return mySTL::transform(first, last, result, op);
+    }
+
+    template <class RandomIter1, class RandomIter2, class UnaryOp, class Unseq>
+    RandomIter2 parallel_transform_dispatch(RandomIter1 first, RandomIter1 last,
+                                            RandomIter2 result, UnaryOp &op, m_true_type, Unseq)
+    {
+        const size_t n = static_cast<size_t>(last - first);
+        parallel_chunks(n, parallel_chunk_count(n), [first, result, &op](size_t, size_t b, size_t e) {
+            mySTL::chunk_transform(first + b, first + e, result + b, op, Unseq());
+        });
+        return result + n;
+    }
+
+    template <class ExecutionPolicy, class ForwardIter1, class ForwardIter2, class UnaryOp>
+    typename enable_if_execution_policy<ExecutionPolicy, ForwardIter2>::type
+    transform(ExecutionPolicy &&, ForwardIter1 first, ForwardIter1 last,
+              ForwardIter2 result, UnaryOp op)
+    {
+        return mySTL::parallel_transform_dispatch(
+            first, last, result, op,
+            parallel_execution<ExecutionPolicy, ForwardIter1, ForwardIter2>(),
+            unsequenced_execution<ExecutionPolicy>());
+    }
+
+    template <class ForwardIter1, class ForwardIter2, class ForwardIter3, class BinaryOp, class Unseq>
+    ForwardIter3 parallel_transform_dispatch(ForwardIter1 first1, ForwardIter1 last1, ForwardIter2 first2,
+                                             ForwardIter3 result, BinaryOp &op, m_false_type, Unseq)
+    {
+        return mySTL::transform(first1, last1, first2, result, op);
+    }
+
+    template <class RandomIter1, class RandomIter2, class RandomIter3, class BinaryOp, class Unseq>
+    RandomIter3 parallel_transform_dispatch(RandomIter1 first1, RandomIter1 last1, RandomIter2 first2,
+                                            RandomIter3 result, BinaryOp &op, m_true_type, Unseq)
+    {
+        const size_t n = static_cast<size_t>(last1 - first1);
+        parallel_chunks(n, parallel_chunk_count(n),
+                        [first1, first2, result, &op](size_t, size_t b, size_t e) {
+                            mySTL::chunk_transform(first1 + b, first1 + e, first2 + b, result + b,
+                                                   op, Unseq());
+                        });
+        return result + n;
+    }
+
+    template <class ExecutionPolicy, class ForwardIter1, class ForwardIter2, class ForwardIter3,
+              class BinaryOp>
+    typename enable_if_execution_policy<ExecutionPolicy, ForwardIter3>::type
+    transform(ExecutionPolicy &&, ForwardIter1 first1, ForwardIter1 last1, ForwardIter2 first2,
+              ForwardIter3 result, BinaryOp op)
+    {
+        return mySTL::parallel_transform_dispatch(
+            first1, last1, first2, result, op,
+            parallel_execution<ExecutionPolicy, ForwardIter1, ForwardIter2, ForwardIter3>(),
+            unsequenced_execution<ExecutionPolicy>());
+    }
+
+    /*****************************************************************************************/
+    // count_if
+    /*****************************************************************************************/
+    template <class RandomIter, class UnaryPredicate>
+    size_t chunk_count_if(RandomIter first, RandomIter last, UnaryPredicate &pred, m_false_type)
+    {
+        return mySTL::count_if(first, last, pred);
+    }
+
+    template <class RandomIter, class UnaryPredicate>
+    size_t chunk_count_if(RandomIter first, RandomIter last, UnaryPredicate &pred, m_true_type)
+    {
+        const auto n = last - first;
+        size_t count = 0;
+        MYSTL_VECTORIZE_LOOP
+        for (decltype(last - first) i = 0; i < n; ++i)
+            count += pred(first[i]) ? 1 : 0;
+        return count;
+    }
+
+    template <class ForwardIter, class UnaryPredicate, class Unseq>
+    size_t parallel_count_if_dispatch(ForwardIter first, ForwardIter last, UnaryPredicate &pred,
+                                      m_false_type, Unseq)
+    {
+        return mySTL::count_if(first, last, pred);
+    }
+
+    template <class RandomIter, class UnaryPredicate, class Unseq>
+    size_t parallel_count_if_dispatch(RandomIter first, RandomIter last, UnaryPredicate &pred,
+                                      m_true_type, Unseq)
+    {
+        const size_t n = static_cast<size_t>(last - first);
+        const size_t k = parallel_chunk_count(n);
+        mySTL::vector<size_t> part(k, 0);
+        parallel_chunks(n, k, [first, &pred, &part](size_t c, size_t b, size_t e) {
+            part[c] = mySTL::chunk_count_if(first + b, first + e, pred, Unseq());
+        });
+        return mySTL::accumulate(part.begin(), part.end(), size_t(0));
+    }
+
+    template <class ExecutionPolicy, class ForwardIter, class UnaryPredicate>
+    typename enable_if_execution_policy<ExecutionPolicy, size_t>::type
+    count_if(ExecutionPolicy &&, ForwardIter first, ForwardIter last, UnaryPredicate pred)
+    {
+        return mySTL::parallel_count_if_dispatch(first, last, pred,
+                                                 parallel_execution<ExecutionPolicy, ForwardIter>(),
+                                                 unsequenced_execution<ExecutionPolicy>());
+    }
+
+    /*****************************************************************************************/
+    // find_if
+    // 每块分段查找，已经有更靠前的块找到时提前结束，返回所有块中最靠前的位置
+    /*****************************************************************************************/
+    template <class ForwardIter, class UnaryPredicate>
+    ForwardIter parallel_find_if_dispatch(ForwardIter first, ForwardIter last, UnaryPredicate &pred,
+                                          m_false_type)
+    {
+        return mySTL::find_if(first, last, pred);
+    }
+
+    template <class RandomIter, class UnaryPredicate>
+    RandomIter parallel_find_if_dispatch(RandomIter first, RandomIter last, UnaryPredicate &pred,
+                                         m_true_type)
+    {
+        const size_t n = static_cast<size_t>(last - first);
+        std::atomic<size_t> found(n);
+        parallel_chunks(n, parallel_chunk_count(n), [first, &pred, &found](size_t, size_t b, size_t e) {
+            for (size_t pos = b; pos < e; )
+            {
+                if (found.load(std::memory_order_relaxed) <= pos)
+                    return;
+                const size_t end = e - pos < MYSTL_PARALLEL_GRAIN ? e : pos + MYSTL_PARALLEL_GRAIN;
+                const RandomIter it = mySTL::find_if(first + pos, first + end, pred);
+                if (it != first + end)
+                {
+                    size_t cur = found.load(std::memory_order_relaxed);
+                    const size_t idx = static_cast<size_t>(it - first);
+                    while (idx < cur && !found.compare_exchange_weak(cur, idx, std::memory_order_relaxed))
+                    {
+                    }
+                    return;
+                }
+                pos = end;
+            }
+        });
+        return first + found.load();
+    }
+
+    template <class ExecutionPolicy, class ForwardIter, class UnaryPredicate>
+    typename enable_if_execution_policy<ExecutionPolicy, ForwardIter>::type
+    find_if(ExecutionPolicy &&, ForwardIter first, ForwardIter last, UnaryPredicate pred)
+    {
+        return mySTL::parallel_find_if_dispatch(first, last, pred,
+                                                parallel_execution<ExecutionPolicy, ForwardIter>());
+    }
+
+    /*****************************************************************************************/
+    // copy / fill
+    /*****************************************************************************************/
+    template <class ForwardIter1, class ForwardIter2>
+    ForwardIter2 parallel_copy_dispatch(ForwardIter1 first, ForwardIter1 last, ForwardIter2 result,
+                                        m_false_type)
+    {
+        return mySTL::copy(first, last, result);
+    }
+
+    template <class RandomIter1, class RandomIter2>
+    RandomIter2 parallel_copy_dispatch(RandomIter1 first, RandomIter1 last, RandomIter2 result,
+                                       m_true_type)
+    {
+        const size_t n = static_cast<size_t>(last - first);
+        parallel_chunks(n, parallel_chunk_count(n), [first, result](size_t, size_t b, size_t e) {
+            mySTL::copy(first + b, first + e, result + b);
+        });
+        return result + n;
+    }
+
+    template <class ExecutionPolicy, class ForwardIter1, class ForwardIter2>
+    typename enable_if_execution_policy<ExecutionPolicy, ForwardIter2>::type
+    copy(ExecutionPolicy &&, ForwardIter1 first, ForwardIter1 last, ForwardIter2 result)
+    {
+        return mySTL::parallel_copy_dispatch(first, last, result,
+                                             parallel_execution<ExecutionPolicy, ForwardIter1, ForwardIter2>());
+    }
+
+    template <class ForwardIter, class T>
+    void parallel_fill_dispatch(ForwardIter first, ForwardIter last, const T &value, m_false_type)
+    {
+        mySTL::fill(first, last, value);
+    }
+
+    template <class RandomIter, class T>
+    void parallel_fill_dispatch(RandomIter first, RandomIter last, const T &value, m_true_type)
+    {
+        const size_t n = static_cast<size_t>(last - first);
+        parallel_chunks(n, parallel_chunk_count(n), [first, &value](size_t, size_t b, size_t e) {
+            mySTL::fill(first + b, first + e, value);
+        });
+    }
+
+    template <class ExecutionPolicy, class ForwardIter, class T>
+    typename enable_if_execution_policy<ExecutionPolicy, void>::type
+    fill(ExecutionPolicy &&, ForwardIter first, ForwardIter last, const T &value)
+    {
+        mySTL::parallel_fill_dispatch(first, last, value, parallel_execution<ExecutionPolicy, ForwardIter>());
+    }
+
+    /*****************************************************************************************/
+    // remove_if / unique
+    // 每块在块内压缩，记录剩余元素的起点与个数，再按顺序移到一起
+    /*****************************************************************************************/
+    template <class RandomIter>
+    RandomIter parallel_compact(RandomIter first, const mySTL::vector<size_t> &start,
+                                const mySTL::vector<size_t> &kept)
+    {
+        RandomIter result = first + start[0] + kept[0];
+        for (size_t c = 1; c < start.size(); ++c)
+        {
+            RandomIter src = first + start[c];
+            if (src == result)
+                result += kept[c];
+            else
+                result = mySTL::move(src, src + kept[c], result);
+        }
+        return result;
+    }
+
+    template <class ForwardIter, class UnaryPredicate>
+    ForwardIter parallel_remove_if_dispatch(ForwardIter first, ForwardIter last, UnaryPredicate &pred,
+                                            m_false_type)
+    {
+        return mySTL::remove_if(first, last, pred);
+    }
+
+    template <class RandomIter, class UnaryPredicate>
+    RandomIter parallel_remove_if_dispatch(RandomIter first, RandomIter last, UnaryPredicate &pred,
+                                           m_true_type)
+    {
+        const size_t n = static_cast<size_t>(last - first);
+        const size_t k = parallel_chunk_count(n);
+        if (k == 1)
+            return mySTL::remove_if(first, last, pred);
+        mySTL::vector<size_t> start(k, 0), kept(k, 0);
+        parallel_chunks(n, k, [first, &pred, &start, &kept](size_t c, size_t b, size_t e) {
+            start[c] = b;
+            kept[c] = static_cast<size_t>(mySTL::remove_if(first + b, first + e, pred) - (first + b));
+        });
+        return mySTL::parallel_compact(first, start, kept);
+    }
+
+    template <class ExecutionPolicy, class ForwardIter, class UnaryPredicate>
+    typename enable_if_execution_policy<ExecutionPolicy, ForwardIter>::type
+    remove_if(ExecutionPolicy &&, ForwardIter first, ForwardIter last, UnaryPredicate pred)
+    {
+        return mySTL::parallel_remove_if_dispatch(first, last, pred,
+                                                  parallel_execution<ExecutionPolicy, ForwardIter>());
+    }
+
+    template <class ForwardIter, class BinaryPredicate>
+    ForwardIter parallel_unique_dispatch(ForwardIter first, ForwardIter last, BinaryPredicate &pred,
+                                         m_false_type)
+    {
+        return mySTL::unique(first, last, pred);
+    }
+
+    // 块的开头与前一块最后一个元素相等的元素先跳过，这一步只读，必须在任何块被压缩之前完成
+    template <class RandomIter, class BinaryPredicate>
+    RandomIter parallel_unique_dispatch(RandomIter first, RandomIter last, BinaryPredicate &pred,
+                                        m_true_type)
+    {
+        const size_t n = static_cast<size_t>(last - first);
+        const size_t k = parallel_chunk_count(n);
+        if (k == 1)
+            return mySTL::unique(first, last, pred);
+        mySTL::vector<size_t> start(k, 0), kept(k, 0);
+        parallel_chunks(n, k, [first, &pred, &start](size_t c, size_t b, size_t e) {
+            size_t s = b;
+            if (c != 0)
+            {
+                while (s != e && pred(first[b - 1], first[s]))
+                    ++s;
+            }
+            start[c] = s;
+        });
+        parallel_chunks(n, k, [first, &pred, &start, &kept](size_t c, size_t, size_t e) {
+            kept[c] = static_cast<size_t>(mySTL::unique(first + start[c], first + e, pred) -
+                                          (first + start[c]));
+        });
+        return mySTL::parallel_compact(first, start, kept);
+    }
+
+    template <class ExecutionPolicy, class ForwardIter, class BinaryPredicate>
+    typename enable_if_execution_policy<ExecutionPolicy, ForwardIter>::type
+    unique(ExecutionPolicy &&, ForwardIter first, ForwardIter last, BinaryPredicate pred)
+    {
+        return mySTL::parallel_unique_dispatch(first, last, pred,
+                                               parallel_execution<ExecutionPolicy, ForwardIter>());
+    }
+
+    template <class ExecutionPolicy, class ForwardIter>
+    typename enable_if_execution_policy<ExecutionPolicy, ForwardIter>::type
+    unique(ExecutionPolicy &&policy, ForwardIter first, ForwardIter last)
+    {
+        return mySTL::unique(policy, first, last,
+                             mySTL::equal_to<typename iterator_traits<ForwardIter>::value_type>());
+    }
+
+    /*****************************************************************************************/
+    // sort
+    // 样本排序：按抽样得到的分割点把元素分到各个桶中，桶之间有序，再并行地对每个桶调用 sort
+    /*****************************************************************************************/
+#ifndef MYSTL_SAMPLE_SORT_OVERSAMPLE
+#define MYSTL_SAMPLE_SORT_OVERSAMPLE 32 // 每个桶抽取的样本数
+#endif
+
+    // 把 [first, last) 移动构造到未初始化的 result，元素的移动构造不抛出异常时分块并行执行
+    template <class RandomIter, class T>
+    void parallel_uninitialized_move(RandomIter first, RandomIter last, T *result, m_true_type)
+    {
+        const size_t n = static_cast<size_t>(last - first);
+        parallel_chunks(n, parallel_chunk_count(n), [first, result](size_t, size_t b, size_t e) {
+            mySTL::uninitialized_move(first + b, first + e, result + b);
+        });
+    }
+
+    template <class RandomIter, class T>
+    void parallel_uninitialized_move(RandomIter first, RandomIter last, T *result, m_false_type)
+    {
+        mySTL::uninitialized_move(first, last, result);
+    }
+
+    // 分割点为 spl[0, m)，返回 value 所在的桶：
+    // 桶 2i 中的元素在 spl[i - 1] 与 spl[i] 之间，桶 2i + 1 中的元素等价于 spl[i]，不需要再排序
+    template <class T, class Compared>
+    size_t sample_sort_bucket(const T *spl, size_t m, const T &value, Compared &cmp)
+    {
+        size_t lo = 0, hi = m;
+        while (lo < hi)
+        { // 第一个大于 value 的分割点
+            const size_t mid = lo + (hi - lo) / 2;
+            if (cmp(value, spl[mid]))
+                hi = mid;
+            else
+                lo = mid + 1;
+        }
+        if (lo > 0 && !cmp(spl[lo - 1], value))
+            return 2 * lo - 1;
+        return 2 * lo;
+    }
+
+    template <class RandomIter, class Compared>
+    void parallel_sort_dispatch(RandomIter first, RandomIter last, Compared &cmp, m_false_type)
+    {
+        mySTL::sort(first, last, cmp);
+    }
+
+    // 1. 抽取 k * MYSTL_SAMPLE_SORT_OVERSAMPLE 个样本（不超过 n 个），排序后等距选出 k - 1 个分割点
+    // 2. 把元素移到缓冲区，分块计算每个元素所在的桶并统计每块每个桶的元素个数
+    // 3. 按桶、块的顺序求出前缀和，各块把元素移回 [first, last) 中自己的位置
+    // 4. 并行地对每个桶调用 sort
+    template <class RandomIter, class Compared>
+    void parallel_sort_dispatch(RandomIter first, RandomIter last, Compared &cmp, m_true_type)
+    {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        const size_t n = static_cast<size_t>(last - first);
+        size_t k = parallel_chunk_count(n);
+        if (k > 4096)
+            k = 4096; // 桶的编号保存在 unsigned short 中
+        if (k == 1)
+        {
+            mySTL::sort(first, last, cmp);
+            return;
+        }
+
+        mySTL::vector<value_type> samples;
+        // MYSTL_PARALLEL_GRAIN 很小时样本数可能超过 n，此时每段为空
+        const size_t oversample = mySTL::min(size_t(MYSTL_SAMPLE_SORT_OVERSAMPLE), n / k);
+        const size_t sample_count = k * oversample;
+        samples.reserve(sample_count);
+        size_t seed = n | 1;
+        for (size_t i = 0; i < sample_count; ++i)
+        { // 在第 i 段中随机选取一个位置
+            seed ^= seed << 13;
+            seed ^= seed >> 7;
+            seed ^= seed << 17;
+            const size_t b = n * i / sample_count, e = n * (i + 1) / sample_count;
+            samples.push_back(first[b + seed % (e - b)]);
+        }
+        mySTL::sort(samples.begin(), samples.end(), cmp);
+        mySTL::vector<value_type> splitters;
+        splitters.reserve(k - 1);
+        for (size_t i = 1; i < k; ++i)
+            splitters.push_back(samples[i * oversample]);
+        const value_type *spl = splitters.data();
+        const size_t m = k - 1;
+        const size_t buckets = 2 * m + 1;
+
+        value_type *buf = mySTL::allocator<value_type>::allocate(n);
+        try
+        {
+            mySTL::parallel_uninitialized_move(first, last, buf,
+                                               typename std::is_nothrow_move_constructible<value_type>::type());
+        }
+        catch (...)
+        {
+            mySTL::allocator<value_type>::deallocate(buf, n);
+            throw;
+        }
+        try
+        {
+            // count[c * buckets + j] 为第 c 块中属于桶 j 的元素个数，之后改为第 c 块的桶 j 在结果中的起始位置
+            mySTL::vector<unsigned short> id(n);
+            mySTL::vector<size_t> count(k * buckets, 0);
+            unsigned short *ids = id.data();
+            size_t *counts = count.data();
+            parallel_chunks(n, k, [buf, spl, m, buckets, ids, counts, &cmp](size_t c, size_t b, size_t e) {
+                size_t *cnt = counts + c * buckets;
+                for (size_t i = b; i < e; ++i)
+                {
+                    const size_t j = mySTL::sample_sort_bucket(spl, m, buf[i], cmp);
+                    ids[i] = static_cast<unsigned short>(j);
+                    ++cnt[j];
+                }
+            });
+            mySTL::vector<size_t> bounds(buckets + 1);
+            size_t sum = 0;
+            for (size_t j = 0; j < buckets; ++j)
+            {
+                bounds[j] = sum;
+                for (size_t c = 0; c < k; ++c)
+                {
+                    const size_t t = counts[c * buckets + j];
+                    counts[c * buckets + j] = sum;
+                    sum += t;
+                }
+            }
+            bounds[buckets] = n;
+            parallel_chunks(n, k, [first, buf, ids, counts, buckets](size_t c, size_t b, size_t e) {
+                size_t *pos = counts + c * buckets;
+                for (size_t i = b; i < e; ++i)
+                    first[pos[ids[i]]++] = mySTL::move(buf[i]);
+            });
+            // 只有偶数号的桶需要排序，每个桶作为一个任务，由线程池平衡负载
+            mySTL::parallel_for(size_t(0), m + 1, size_t(1), [first, &bounds, &cmp](size_t b, size_t e) {
+                for (size_t j = b; j < e; ++j)
+                    mySTL::sort(first + bounds[2 * j], first + bounds[2 * j + 1], cmp);
+            });
+        }
+        catch (...)
+        {
+            mySTL::destroy(buf, buf + n);
+            mySTL::allocator<value_type>::deallocate(buf, n);
+            throw;
+        }
+        mySTL::destroy(buf, buf + n);
+        mySTL::allocator<value_type>::deallocate(buf, n);
+    }
+
+    template <class ExecutionPolicy, class RandomIter, class Compared>
+    typename enable_if_execution_policy<ExecutionPolicy, void>::type
+    sort(ExecutionPolicy &&, RandomIter first, RandomIter last, Compared cmp)
+    {
+        mySTL::parallel_sort_dispatch(first, last, cmp, parallel_execution<ExecutionPolicy, RandomIter>());
+    }
+
+    template <class ExecutionPolicy, class RandomIter>
+    typename enable_if_execution_policy<ExecutionPolicy, void>::type
+    sort(ExecutionPolicy &&policy, RandomIter first, RandomIter last)
+    {
+        mySTL::sort(policy, first, last, mySTL::less<typename iterator_traits<RandomIter>::value_type>());
+    }
+
+    /*****************************************************************************************/
+    // stable_sort
+    // 等长的块并行 stable_sort，再逐轮把相邻的有序段两两归并，每轮在原区间与缓冲区之间交替进行
+    // 每一轮的输出被均分给各块，块的起止位置通过二分查找归并路径定位，长段的归并也能并行
+    /*****************************************************************************************/
+
+    // 归并 a[0, la) 与 b[0, lb) 时，输出的前 diag 个元素中来自 a 的个数，相等时 a 中的元素在前
+    template <class RandomIter1, class RandomIter2, class Compared>
+    size_t merge_path_split(RandomIter1 a, size_t la, RandomIter2 b, size_t lb, size_t diag,
+                            Compared &cmp)
+    {
+        size_t lo = diag > lb ? diag - lb : 0;
+        size_t hi = diag < la ? diag : la;
+        while (lo < hi)
+        {
+            const size_t mid = lo + (hi - lo) / 2;
+            if (cmp(b[diag - mid - 1], a[mid]))
+                hi = mid;
+            else
+                lo = mid + 1;
+        }
+        return lo;
+    }
+
+    // 把 src 中长为 w 的相邻有序段两两归并，移动到 dst 中相同的位置
+    // 各块的起点先在调用线程上全部定位好，归并开始后 src 中的元素会被移走，不能再比较
+    template <class RandomIter1, class RandomIter2, class Compared>
+    void parallel_merge_round(RandomIter1 src, RandomIter2 dst, size_t n, size_t w, size_t k,
+                              Compared &cmp)
+    {
+        // split[c] 为第 c 块的起点 n * c / k 在它所在的一对有序段中对应的前一段的元素个数
+        mySTL::vector<size_t> split(k + 1);
+        for (size_t c = 0; c <= k; ++c)
+        {
+            const size_t x = n * c / k;
+            const size_t ps = x - x % (2 * w);
+            const size_t pm = mySTL::min(ps + w, n);
+            const size_t pe = mySTL::min(ps + 2 * w, n);
+            split[c] = mySTL::merge_path_split(src + ps, pm - ps, src + pm, pe - pm, x - ps, cmp);
+        }
+        const size_t *sp = split.data();
+        parallel_chunks(n, k, [src, dst, n, w, sp, &cmp](size_t c, size_t b, size_t e) {
+            for (size_t ps = b - b % (2 * w); ps < e; ps += 2 * w)
+            {
+                const size_t pm = mySTL::min(ps + w, n);
+                const size_t pe = mySTL::min(ps + 2 * w, n);
+                const size_t d1 = ps < b ? b - ps : 0;
+                const size_t d2 = e < pe ? e - ps : pe - ps;
+                const size_t i1 = ps < b ? sp[c] : 0;
+                const size_t i2 = e < pe ? sp[c + 1] : pm - ps;
+                mySTL::merge_move(src + ps + i1, src + ps + i2, src + pm + (d1 - i1), src + pm + (d2 - i2),
+                                  dst + ps + d1, cmp);
+            }
+        });
+    }
+
+    template <class RandomIter, class Compared>
+    void parallel_stable_sort_dispatch(RandomIter first, RandomIter last, Compared &cmp, m_false_type)
+    {
+        mySTL::stable_sort(first, last, cmp);
+    }
+
+    template <class RandomIter, class Compared>
+    void parallel_stable_sort_dispatch(RandomIter first, RandomIter last, Compared &cmp, m_true_type)
+    {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        const size_t n = static_cast<size_t>(last - first);
+        const size_t k = parallel_chunk_count(n);
+        if (k == 1)
+        {
+            mySTL::stable_sort(first, last, cmp);
+            return;
+        }
+        size_t w = (n + k - 1) / k;
+        mySTL::parallel_for(size_t(0), (n + w - 1) / w, size_t(1), [first, n, w, &cmp](size_t b, size_t e) {
+            for (size_t c = b; c < e; ++c)
+                mySTL::stable_sort(first + c * w, first + mySTL::min((c + 1) * w, n), cmp);
+        });
+
+        value_type *buf = mySTL::allocator<value_type>::allocate(n);
+        try
+        {
+            mySTL::parallel_uninitialized_move(first, last, buf,
+                                               typename std::is_nothrow_move_constructible<value_type>::type());
+        }
+        catch (...)
+        {
+            mySTL::allocator<value_type>::deallocate(buf, n);
+            throw;
+        }
+        try
+        {
+            bool in_buf = true; // 当前的有序段在缓冲区中
+            for (; w < n; w *= 2)
+            {
+                if (in_buf)
+                    mySTL::parallel_merge_round(buf, first, n, w, k, cmp);
+                else
+                    mySTL::parallel_merge_round(first, buf, n, w, k, cmp);
+                in_buf = !in_buf;
+            }
+            if (in_buf)
+            {
+                parallel_chunks(n, k, [first, buf](size_t, size_t b, size_t e) {
+                    mySTL::move(buf + b, buf + e, first + b);
+                });
+            }
+        }
+        catch (...)
+        {
+            mySTL::destroy(buf, buf + n);
+            mySTL::allocator<value_type>::deallocate(buf, n);
+            throw;
+        }
+        mySTL::destroy(buf, buf + n);
+        mySTL::allocator<value_type>::deallocate(buf, n);
+    }
+
+    template <class ExecutionPolicy, class RandomIter, class Compared>
+    typename enable_if_execution_policy<ExecutionPolicy, void>::type
+    stable_sort(ExecutionPolicy &&, RandomIter first, RandomIter last, Compared cmp)
+    {
+        mySTL::parallel_stable_sort_dispatch(first, last, cmp,
+                                             parallel_execution<ExecutionPolicy, RandomIter>());
+    }
+
+    template <class ExecutionPolicy, class RandomIter>
+    typename enable_if_execution_policy<ExecutionPolicy, void>::type
+    stable_sort(ExecutionPolicy &&policy, RandomIter first, RandomIter last)
+    {
+        mySTL::stable_sort(policy, first, last, mySTL::less<typename iterator_traits<RandomIter>::value_type>());
+    }
+
+    /*****************************************************************************************/
+    // reduce / inner_product
+    // 每块的第一个元素作为这一块的初值，init 只参与最后的合并
+    /*****************************************************************************************/
+    template <class T, class RandomIter, class BinaryOp>
+    T chunk_reduce(RandomIter first, RandomIter last, BinaryOp &op, m_false_type)
+    {
+        T acc(*first);
+        for (++first; first != last; ++first)
+            acc = op(acc, *first);
+        return acc;
+    }
+
+    // 4 个独立的累加器，消除相邻两次运算之间的依赖，便于向量化
+    template <class T, class RandomIter, class BinaryOp>
+    T chunk_reduce(RandomIter first, RandomIter last, BinaryOp &op, m_true_type)
+    {
+        const auto n = last - first;
+        if (n < 8)
+            return mySTL::chunk_reduce<T>(first, last, op, m_false_type());
+        T a0(first[0]), a1(first[1]), a2(first[2]), a3(first[3]);
+        decltype(last - first) i = 4;
+        for (; i + 4 <= n; i += 4)
+        {
+            a0 = op(a0, first[i]);
+            a1 = op(a1, first[i + 1]);
+            a2 = op(a2, first[i + 2]);
+            a3 = op(a3, first[i + 3]);
+        }
+        for (; i < n; ++i)
+            a0 = op(a0, first[i]);
+        return op(op(a0, a1), op(a2, a3));
+    }
+
+    template <class ForwardIter, class T, class BinaryOp, class Unseq>
+    T parallel_reduce_dispatch(ForwardIter first, ForwardIter last, T init, BinaryOp &op,
+                               m_false_type, Unseq)
+    {
+        return mySTL::reduce(first, last, init, op);
+    }
+
+    template <class RandomIter, class T, class BinaryOp, class Unseq>
+    T parallel_reduce_dispatch(RandomIter first, RandomIter last, T init, BinaryOp &op,
+                               m_true_type, Unseq)
+    {
+        const size_t n = static_cast<size_t>(last - first);
+        if (n == 0)
+            return init;
+        const size_t k = parallel_chunk_count(n);
+        mySTL::vector<T> part;
+        part.reserve(k);
+        for (size_t c = 0; c < k; ++c)
+            part.push_back(init);
+        parallel_chunks(n, k, [first, &op, &part](size_t c, size_t b, size_t e) {
+            part[c] = mySTL::chunk_reduce<T>(first + b, first + e, op, Unseq());
+        });
+        for (size_t c = 0; c < k; ++c)
+            init = op(init, part[c]);
+        return init;
+    }
+
+    template <class ExecutionPolicy, class ForwardIter, class T, class BinaryOp>
+    typename enable_if_execution_policy<ExecutionPolicy, T>::type
+    reduce(ExecutionPolicy &&, ForwardIter first, ForwardIter last, T init, BinaryOp op)
+    {
+        return mySTL::parallel_reduce_dispatch(first, last, init, op,
+                                               parallel_execution<ExecutionPolicy, ForwardIter>(),
+                                               unsequenced_execution<ExecutionPolicy>());
+    }
+
+    template <class ExecutionPolicy, class ForwardIter, class T>
+    typename enable_if_execution_policy<ExecutionPolicy, T>::type
+    reduce(ExecutionPolicy &&policy, ForwardIter first, ForwardIter last, T init)
+    {
+        return mySTL::reduce(policy, first, last, init, mySTL::plus<T>());
+    }
+
+    template <class ExecutionPolicy, class ForwardIter>
+    typename enable_if_execution_policy<ExecutionPolicy, typename iterator_traits<ForwardIter>::value_type>::type
+    reduce(ExecutionPolicy &&policy, ForwardIter first, ForwardIter last)
+    {
+        return mySTL::reduce(policy, first, last, typename iterator_traits<ForwardIter>::value_type());
+    }
+
+    template <class T, class RandomIter1, class RandomIter2, class BinaryOp1, class BinaryOp2>
+    T chunk_inner_product(RandomIter1 first1, RandomIter1 last1, RandomIter2 first2,
+                          BinaryOp1 &op1, BinaryOp2 &op2, m_false_type)
+    {
+        T acc(op2(*first1, *first2));
+        for (++first1, ++first2; first1 != last1; ++first1, ++first2)
+            acc = op1(acc, op2(*first1, *first2));
+        return acc;
+    }
+
+    template <class T, class RandomIter1, class RandomIter2, class BinaryOp1, class BinaryOp2>
+    T chunk_inner_product(RandomIter1 first1, RandomIter1 last1, RandomIter2 first2,
+                          BinaryOp1 &op1, BinaryOp2 &op2, m_true_type)
+    {
+        const auto n = last1 - first1;
+        if (n < 8)
+            return mySTL::chunk_inner_product<T>(first1, last1, first2, op1, op2, m_false_type());
+        T a0(op2(first1[0], first2[0])), a1(op2(first1[1], first2[1]));
+        T a2(op2(first1[2], first2[2])), a3(op2(first1[3], first2[3]));
+        decltype(last1 - first1) i = 4;
+        for (; i + 4 <= n; i += 4)
+        {
+            a0 = op1(a0, op2(first1[i], first2[i]));
+            a1 = op1(a1, op2(first1[i + 1], first2[i + 1]));
+            a2 = op1(a2, op2(first1[i + 2], first2[i + 2]));
+            a3 = op1(a3, op2(first1[i + 3], first2[i + 3]));
+        }
+        for (; i < n; ++i)
+            a0 = op1(a0, op2(first1[i], first2[i]));
+        return op1(op1(a0, a1), op1(a2, a3));
+    }
+
+    template <class ForwardIter1, class ForwardIter2, class T, class BinaryOp1, class BinaryOp2, class Unseq>
+    T parallel_inner_product_dispatch(ForwardIter1 first1, ForwardIter1 last1, ForwardIter2 first2, T init,
+                                      BinaryOp1 &op1, BinaryOp2 &op2, m_false_type, Unseq)
+    {
+        return mySTL::inner_product(first1, last1, first2, init, op1, op2);
+    }
+
+    template <class RandomIter1, class RandomIter2, class T, class BinaryOp1, class BinaryOp2, class Unseq>
+    T parallel_inner_product_dispatch(RandomIter1 first1, RandomIter1 last1, RandomIter2 first2, T init,
+                                      BinaryOp1 &op1, BinaryOp2 &op2, m_true_type, Unseq)
+    {
+        const size_t n = static_cast<size_t>(last1 - first1);
+        if (n == 0)
+            return init;
+        const size_t k = parallel_chunk_count(n);
+        mySTL::vector<T> part;
+        part.reserve(k);
+        for (size_t c = 0; c < k; ++c)
+            part.push_back(init);
+        parallel_chunks(n, k, [first1, first2, &op1, &op2, &part](size_t c, size_t b, size_t e) {
+            part[c] = mySTL::chunk_inner_product<T>(first1 + b, first1 + e, first2 + b, op1, op2, Unseq());
+        });
+        for (size_t c = 0; c < k; ++c)
+            init = op1(init, part[c]);
+        return init;
+    }
+
+    template <class ExecutionPolicy, class ForwardIter1, class ForwardIter2, class T,
+              class BinaryOp1, class BinaryOp2>
+    typename enable_if_execution_policy<ExecutionPolicy, T>::type
+    inner_product(ExecutionPolicy &&, ForwardIter1 first1, ForwardIter1 last1,
+                  ForwardIter2 first2, T init, BinaryOp1 op1, BinaryOp2 op2)
+    {
+        return mySTL::parallel_inner_product_dispatch(
+            first1, last1, first2, init, op1, op2,
+            parallel_execution<ExecutionPolicy, ForwardIter1, ForwardIter2>(),
+            unsequenced_execution<ExecutionPolicy>());
+    }
+
+    template <class ExecutionPolicy, class ForwardIter1, class ForwardIter2, class T>
+    typename enable_if_execution_policy<ExecutionPolicy, T>::type
+    inner_product(ExecutionPolicy &&policy, ForwardIter1 first1, ForwardIter1 last1,
+                  ForwardIter2 first2, T init)
+    {
+        return mySTL::inner_product(policy, first1, last1, first2, init,
+                                    mySTL::plus<T>(), mySTL::multiplies<T>());
+    }
+
+    /*****************************************************************************************/
+    // inclusive_scan / partial_sum
+    // 第一遍求出除最后一块外每块的和，顺序求出每块之前所有元素的和，第二遍带着这个前缀扫描每一块
+    // init 为空时第一块没有前缀
+    /*****************************************************************************************/
+    template <class T, class RandomIter1, class RandomIter2, class BinaryOp>
+    RandomIter2 parallel_scan(RandomIter1 first, RandomIter1 last, RandomIter2 result,
+                              BinaryOp &op, const T *init)
+    {
+        const size_t n = static_cast<size_t>(last - first);
+        if (n == 0)
+            return result;
+        const size_t k = parallel_chunk_count(n);
+        mySTL::vector<T> carry;
+        carry.reserve(k);
+        if (k > 1)
+        {
+            mySTL::vector<T> part;
+            part.reserve(k);
+            for (size_t c = 0; c < k; ++c)
+                part.push_back(T(*first));
+            parallel_chunks(n, k - 1, [first, &op, &part, n, k](size_t c, size_t, size_t) {
+                const size_t b = n * c / k, e = n * (c + 1) / k;
+                part[c] = mySTL::chunk_reduce<T>(first + b, first + e, op, m_false_type());
+            });
+            // carry[c - 1] 是第 c 块之前所有元素的和
+            carry.push_back(init ? op(*init, part[0]) : part[0]);
+            for (size_t c = 1; c + 1 < k; ++c)
+                carry.push_back(op(carry.back(), part[c]));
+        }
+        parallel_chunks(n, k, [first, result, &op, &carry, init](size_t c, size_t b, size_t e) {
+            const T *prefix = c == 0 ? init : &carry[c - 1];
+            T acc = prefix ? op(*prefix, first[b]) : T(first[b]);
+            result[b] = acc;
+            for (size_t i = b + 1; i < e; ++i)
+            {
+                acc = op(acc, first[i]);
+                result[i] = acc;
+            }
+        });
+        return result + n;
+    }
+
+    template <class ForwardIter1, class ForwardIter2, class BinaryOp, class T>
+    ForwardIter2 parallel_scan_dispatch(ForwardIter1 first, ForwardIter1 last, ForwardIter2 result,
+                                        BinaryOp &op, const T *init, m_false_type)
+    {
+        if (init)
+            return mySTL::inclusive_scan(first, last, result, op, *init);
+        return mySTL::inclusive_scan(first, last, result, op);
+    }
+
+    template <class RandomIter1, class RandomIter2, class BinaryOp, class T>
+    RandomIter2 parallel_scan_dispatch(RandomIter1 first, RandomIter1 last, RandomIter2 result,
+                                       BinaryOp &op, const T *init, m_true_type)
+    {
+        return mySTL::parallel_scan<T>(first, last, result, op, init);
+    }
+
+    template <class ExecutionPolicy, class ForwardIter1, class ForwardIter2, class BinaryOp>
+    typename enable_if_execution_policy<ExecutionPolicy, ForwardIter2>::type
+    inclusive_scan(ExecutionPolicy &&, ForwardIter1 first, ForwardIter1 last, ForwardIter2 result,
+                   BinaryOp op)
+    {
+        typedef typename iterator_traits<ForwardIter1>::value_type value_type;
+        return mySTL::parallel_scan_dispatch(first, last, result, op, static_cast<const value_type *>(nullptr),
+                                             parallel_execution<ExecutionPolicy, ForwardIter1, ForwardIter2>());
+    }
+
+    template <class ExecutionPolicy, class ForwardIter1, class ForwardIter2>
+    typename enable_if_execution_policy<ExecutionPolicy, ForwardIter2>::type
+    inclusive_scan(ExecutionPolicy &&policy, ForwardIter1 first, ForwardIter1 last, ForwardIter2 result)
+    {
+        return mySTL::inclusive_scan(policy, first, last, result,
+                                     mySTL::plus<typename iterator_traits<ForwardIter1>::value_type>());
+    }
+
+    template <class ExecutionPolicy, class ForwardIter1, class ForwardIter2, class BinaryOp, class T>
+    typename enable_if_execution_policy<ExecutionPolicy, ForwardIter2>::type
+    inclusive_scan(ExecutionPolicy &&, ForwardIter1 first, ForwardIter1 last, ForwardIter2 result,
+                   BinaryOp op, T init)
+    {
+        return mySTL::parallel_scan_dispatch(first, last, result, op, &init,
+                                             parallel_execution<ExecutionPolicy, ForwardIter1, ForwardIter2>());
+    }
+
+    template <class ExecutionPolicy, class ForwardIter1, class ForwardIter2>
+    typename enable_if_execution_policy<ExecutionPolicy, ForwardIter2>::type
+    partial_sum(ExecutionPolicy &&policy, ForwardIter1 first, ForwardIter1 last, ForwardIter2 result)
+    {
+        return mySTL::inclusive_scan(policy, first, last, result);
+    }
+
+    template <class ExecutionPolicy, class ForwardIter1, class ForwardIter2, class BinaryOp>
+    typename enable_if_execution_policy<ExecutionPolicy, ForwardIter2>::type
+    partial_sum(ExecutionPolicy &&policy, ForwardIter1 first, ForwardIter1 last, ForwardIter2 result,
+                BinaryOp op)
+    {
+        return mySTL::inclusive_scan(policy, first, last, result, op);
+    }
+
+} // namespace mySTL
+#endif // !MYSTL_PARALLEL_ALGO_H_
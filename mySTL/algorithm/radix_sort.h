@@ -0,0 +1,469 @@
+#ifndef MYSTL_RADIX_SORT_H_
+#define MYSTL_RADIX_SORT_H_
+
+// 这个头文件包含基数排序 radix_sort 与 radix_sort_by_key
+//   mySTL::radix_sort(v.begin(), v.end());                                 // 整数、浮点数、basic_string
+//   mySTL::radix_sort_by_key(v.begin(), v.end(), [](const item& x) { return x.id; });
+
+// notes:
+//
+// 整数与浮点数键使用基数排序：区间较大时先按最高的 kRadixBits 位分桶（MSD），
+// 桶不超过 kRadixCacheBytes 后对剩下的位做 LSD 排序，每轮 8 位：
+//   有符号整数翻转符号位，浮点数为负时翻转所有位、否则翻转符号位，转换后的无符号数与原来的大小顺序一致
+//   LSD 一次遍历统计出所有轮次的直方图，所有元素在某一轮的数位都相同时跳过这一轮
+//   负零排在正零之前，NaN 按符号排在两端
+// 单字节字符的 basic_string 键使用 MSD 基数排序，每轮处理一个字符，元素少于 kRadixStringThreshold 时改用插入排序：
+//   排序的是记录了键的数据指针、长度与下标的数组，最后按下标一次性重排元素，因此 key 必须返回引用
+// 分配时使用 temporary_buffer / get_temporary_buffer 申请的缓冲区，两种排序都是稳定的
+// 缓冲区申请不到足够的大小时退化为 stable_sort，同样是稳定的
+// 随机访问迭代器
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "algo.h"
+#include "../container/sequence/vector.h"
+#include "../util/memory.h"
+
+namespace mySTL
+{
+    template <class CharType, class CharTraits, class Alloc>
+    class basic_string;
+
+    constexpr static size_t kRadixInsertionThreshold = 64; // 小于这个大小的区间直接使用插入排序
+    constexpr static unsigned kRadixBits = 8;              // MSD 分桶每次处理的位数
+    constexpr static size_t kRadixBuckets = size_t(1) << kRadixBits;
+    constexpr static size_t kRadixCacheBytes = 1024 * 1024; // 不超过这个大小的区间直接做 LSD 排序
+    constexpr static size_t kRadixStringThreshold = 32;    // MSD 排序中小于这个大小的桶使用插入排序
+
+    /*****************************************************************************************/
+    // 键的萃取
+    /*****************************************************************************************/
+
+    // 键的种类
+    struct radix_integer_tag {};
+    struct radix_float_tag {};
+    struct radix_string_tag {};
+
+    template <class Key, class = void>
+    struct radix_key_traits
+    {
+        static_assert(sizeof(Key) == 0,
+                      "radix_sort needs integral, floating point or single byte basic_string keys");
+    };
+
+    // 整数：有符号整数翻转符号位
+    template <class Key>
+    struct radix_key_traits<Key, typename std::enable_if<std::is_integral<Key>::value &&
+                                                         !std::is_same<Key, bool>::value>::type>
+    {
+        typedef radix_integer_tag category;
+        typedef typename std::make_unsigned<Key>::type unsigned_type;
+
+        static unsigned_type encode(Key key) noexcept
+        {
+            return std::is_signed<Key>::value
+                       ? static_cast<unsigned_type>(static_cast<unsigned_type>(key) ^
+                                                    (unsigned_type(1) << (sizeof(Key) * 8 - 1)))
+                       : static_cast<unsigned_type>(key);
+        }
+    };
+
+    // IEEE 浮点数：为负时翻转所有位，否则翻转符号位
+    template <class Key>
+    struct radix_key_traits<Key, typename std::enable_if<std::is_floating_point<Key>::value &&
+                                                         (sizeof(Key) == 4 || sizeof(Key) == 8)>::type>
+    {
+        typedef radix_float_tag category;
+        typedef typename std::conditional<sizeof(Key) == 4, uint32_t, uint64_t>::type unsigned_type;
+
+        static unsigned_type encode(Key key) noexcept
+        {
+            unsigned_type bits;
+            std::memcpy(&bits, &key, sizeof(bits));
+            const unsigned_type sign = unsigned_type(1) << (sizeof(Key) * 8 - 1);
+            return (bits & sign) ? static_cast<unsigned_type>(~bits) : static_cast<unsigned_type>(bits | sign);
+        }
+    };
+
+    template <class CharType, class CharTraits, class Alloc>
+    struct radix_key_traits<mySTL::basic_string<CharType, CharTraits, Alloc>,
+                            typename std::enable_if<sizeof(CharType) == 1>::type>
+    {
+        typedef radix_string_tag category;
+        typedef CharTraits traits_type;
+    };
+
+    // 把键转换为无符号数后比较，与基数排序的顺序一致
+    template <class KeyFunction>
+    struct radix_key_less
+    {
+        KeyFunction *key;
+
+        template <class T>
+        bool operator()(const T &a, const T &b) const
+        {
+            typedef typename std::decay<decltype((*key)(a))>::type key_type;
+            return radix_key_traits<key_type>::encode((*key)(a)) <
+                   radix_key_traits<key_type>::encode((*key)(b));
+        }
+    };
+
+    // 比较两个字符串键从第 depth 个字符开始的后缀，前 depth 个字符已经相同
+    template <class KeyFunction>
+    struct radix_suffix_less
+    {
+        KeyFunction *key;
+        size_t depth;
+
+        template <class T>
+        bool operator()(const T &a, const T &b) const
+        {
+            typedef typename std::decay<decltype((*key)(a))>::type key_type;
+            typedef typename radix_key_traits<key_type>::traits_type traits_type;
+            const key_type &x = (*key)(a);
+            const key_type &y = (*key)(b);
+            const size_t xn = x.size() - depth;
+            const size_t yn = y.size() - depth;
+            const int r = traits_type::compare(x.data() + depth, y.data() + depth, xn < yn ? xn : yn);
+            return r < 0 || (r == 0 && xn < yn);
+        }
+    };
+
+    /*****************************************************************************************/
+    // 整数与浮点数键
+    // 区间大于 kRadixCacheBytes 时先按最高的 kRadixBits 位分桶（MSD），桶能放进缓存后再对剩下的位做 LSD 排序，
+    // 使每一轮随机写入都落在缓存中
+    /*****************************************************************************************/
+
+    // 按第 shift 位开始的 mask 位把 [src, src + n) 移动到 dst，offset 为每个桶的起始位置
+    template <class Iter1, class Iter2, class KeyFunction, class Traits>
+    void radix_scatter(Iter1 src, size_t n, Iter2 dst, size_t *offset, unsigned shift, size_t mask,
+                       KeyFunction &key, Traits)
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            const size_t d = static_cast<size_t>((Traits::encode(key(src[i])) >> shift) & mask);
+            dst[offset[d]++] = mySTL::move(src[i]);
+        }
+    }
+
+    // 把直方图 count[0, buckets) 改为每个桶的起始位置
+    inline void radix_prefix_sum(size_t *count, size_t buckets)
+    {
+        size_t sum = 0;
+        for (size_t d = 0; d < buckets; ++d)
+        {
+            const size_t t = count[d];
+            count[d] = sum;
+            sum += t;
+        }
+    }
+
+    // LSD：对 [first, first + n) 按键的低 bits 位排序，每轮 8 位，一次遍历统计出所有轮次的直方图
+    template <class RandomIter, class T, class KeyFunction, class Traits>
+    void radix_sort_lsd(RandomIter first, size_t n, T *buf, unsigned bits, KeyFunction &key, Traits)
+    {
+        typedef typename Traits::unsigned_type unsigned_type;
+        enum { kMaxPasses = sizeof(unsigned_type) };
+        const unsigned passes = (bits + 7) / 8;
+        size_t count[kMaxPasses][256] = {};
+        for (size_t i = 0; i < n; ++i)
+        {
+            const unsigned_type k = Traits::encode(key(first[i]));
+            for (unsigned p = 0; p < passes; ++p)
+                ++count[p][(k >> (8 * p)) & 0xff];
+        }
+        bool in_buf = false;
+        for (unsigned p = 0; p < passes; ++p)
+        {
+            const unsigned shift = 8 * p;
+            const unsigned_type k0 = in_buf ? Traits::encode(key(buf[0])) : Traits::encode(key(first[0]));
+            if (count[p][(k0 >> shift) & 0xff] == n)
+                continue; // 所有元素的这 8 位都相同
+            mySTL::radix_prefix_sum(count[p], 256);
+            if (in_buf)
+                mySTL::radix_scatter(buf, n, first, count[p], shift, 0xff, key, Traits());
+            else
+                mySTL::radix_scatter(first, n, buf, count[p], shift, 0xff, key, Traits());
+            in_buf = !in_buf;
+        }
+        if (in_buf)
+            mySTL::move(buf, buf + n, first);
+    }
+
+    // MSD：[first, first + n) 中的键除低 bits 位外都相同，按 bits 中最高的 kRadixBits 位分桶后处理每个桶
+    template <class RandomIter, class T, class KeyFunction, class Traits>
+    void radix_sort_msd(RandomIter first, size_t n, T *buf, unsigned bits, KeyFunction &key, Traits)
+    {
+        typedef typename Traits::unsigned_type unsigned_type;
+        while (true)
+        {
+            if (n < kRadixInsertionThreshold)
+            {
+                mySTL::insertion_sort(first, first + n, radix_key_less<KeyFunction>{&key});
+                return;
+            }
+            if (n * sizeof(T) <= kRadixCacheBytes || bits <= kRadixBits)
+            {
+                mySTL::radix_sort_lsd(first, n, buf, bits, key, Traits());
+                return;
+            }
+            const unsigned shift = bits - kRadixBits;
+            mySTL::vector<size_t> count(kRadixBuckets, 0);
+            for (size_t i = 0; i < n; ++i)
+                ++count[(Traits::encode(key(first[i])) >> shift) & (kRadixBuckets - 1)];
+            const unsigned_type k0 = Traits::encode(key(first[0]));
+            if (count[(k0 >> shift) & (kRadixBuckets - 1)] == n)
+            { // 所有元素的这几位都相同
+                bits = shift;
+                continue;
+            }
+            mySTL::vector<size_t> offset(count);
+            mySTL::radix_prefix_sum(offset.data(), kRadixBuckets);
+            mySTL::radix_scatter(first, n, buf, offset.data(), shift, kRadixBuckets - 1, key, Traits());
+            mySTL::move(buf, buf + n, first);
+            size_t start = 0;
+            for (size_t d = 0; d < kRadixBuckets; ++d)
+            {
+                if (count[d] > 1)
+                    mySTL::radix_sort_msd(first + start, count[d], buf, shift, key, Traits());
+                start += count[d];
+            }
+            return;
+        }
+    }
+
+    template <class RandomIter, class KeyFunction>
+    void radix_sort_dispatch(RandomIter first, RandomIter last, KeyFunction &key, radix_integer_tag)
+    {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        typedef typename std::decay<decltype(key(*first))>::type key_type;
+        typedef radix_key_traits<key_type> traits;
+
+        const size_t n = static_cast<size_t>(last - first);
+        if (n < kRadixInsertionThreshold)
+        {
+            mySTL::insertion_sort(first, last, radix_key_less<KeyFunction>{&key});
+            return;
+        }
+        mySTL::temporary_buffer<RandomIter, value_type> buf(first, last);
+        if (static_cast<size_t>(buf.size()) < n)
+        { // 用已经申请到的部分缓冲区做归并排序
+            if (buf.begin())
+                mySTL::stable_sort_adaptive(first, last, buf.begin(), buf.size(),
+                                            radix_key_less<KeyFunction>{&key});
+            else
+                mySTL::inplace_stable_sort(first, last, radix_key_less<KeyFunction>{&key});
+            return;
+        }
+        const unsigned bits = static_cast<unsigned>(sizeof(typename traits::unsigned_type) * 8);
+        mySTL::radix_sort_msd(first, n, buf.begin(), bits, key, traits());
+    }
+
+    template <class RandomIter, class KeyFunction>
+    void radix_sort_dispatch(RandomIter first, RandomIter last, KeyFunction &key, radix_float_tag)
+    {
+        mySTL::radix_sort_dispatch(first, last, key, radix_integer_tag());
+    }
+
+    /*****************************************************************************************/
+    // MSD 基数排序：字符串键
+    // 先为每个元素记录键的数据指针、长度与下标，之后只分配这些记录，顺序读取记录时只有字符本身可能不在缓存中，
+    // 最后按记录中的下标一次性重排元素
+    /*****************************************************************************************/
+
+    template <class CharType>
+    struct radix_string_entry
+    {
+        const CharType *data;
+        size_t size;
+        size_t index;
+    };
+
+    // 比较两个记录从第 depth 个字符开始的后缀，前 depth 个字符已经相同
+    template <class CharTraits>
+    struct radix_entry_less
+    {
+        size_t depth;
+
+        template <class Entry>
+        bool operator()(const Entry &a, const Entry &b) const
+        {
+            const size_t an = a.size - depth;
+            const size_t bn = b.size - depth;
+            const int r = CharTraits::compare(a.data + depth, b.data + depth, an < bn ? an : bn);
+            return r < 0 || (r == 0 && an < bn);
+        }
+    };
+
+    // 第 depth 个字符所在的桶，字符串已经结束的放在 0 号桶
+    template <class Entry>
+    size_t radix_string_digit(const Entry &e, size_t depth)
+    {
+        return depth < e.size ? static_cast<size_t>(static_cast<unsigned char>(e.data[depth])) + 1 : 0;
+    }
+
+    // e[0, n) 的公共前缀长度，已知前 depth 个字符相同
+    template <class Entry>
+    size_t radix_common_prefix(const Entry *e, size_t n, size_t depth)
+    {
+        size_t lcp = e[0].size;
+        for (size_t i = 1; i < n && lcp > depth; ++i)
+        {
+            const size_t m = e[i].size < lcp ? e[i].size : lcp;
+            size_t j = depth;
+            while (j < m && e[i].data[j] == e[0].data[j])
+                ++j;
+            lcp = j;
+        }
+        return lcp;
+    }
+
+    // 对前 depth 个字符都相同的 e[0, n) 排序，tmp 是分配时使用的缓冲区，digit[i] 暂存 e[i] 所在的桶
+    // 最大的桶在循环中继续处理，其余的桶递归处理，递归深度不超过 log(n)
+    template <class CharTraits, class Entry>
+    void radix_sort_string(Entry *e, size_t n, Entry *tmp, unsigned short *digit, size_t depth)
+    {
+        while (true)
+        {
+            if (n < kRadixStringThreshold)
+            {
+                mySTL::insertion_sort(e, e + n, radix_entry_less<CharTraits>{depth});
+                return;
+            }
+            size_t count[257] = {};
+            for (size_t i = 0; i < n; ++i)
+            {
+                const size_t d = mySTL::radix_string_digit(e[i], depth);
+                digit[i] = static_cast<unsigned short>(d);
+                ++count[d];
+            }
+            if (count[digit[0]] == n)
+            { // 所有字符串的这一个字符都相同，一次跳过它们的公共前缀
+                if (digit[0] == 0)
+                    return;
+                depth = mySTL::radix_common_prefix(e, n, depth + 1);
+                continue;
+            }
+
+            size_t offset[257];
+            size_t sum = 0;
+            for (size_t d = 0; d < 257; ++d)
+            {
+                offset[d] = sum;
+                sum += count[d];
+            }
+            for (size_t i = 0; i < n; ++i)
+                tmp[offset[digit[i]]++] = e[i];
+            mySTL::copy(tmp, tmp + n, e);
+
+            // 0 号桶中的字符串全部相等，不需要再排序
+            size_t largest = 1;
+            for (size_t d = 2; d < 257; ++d)
+            {
+                if (count[d] > count[largest])
+                    largest = d;
+            }
+            size_t start = count[0];
+            size_t largest_start = 0;
+            for (size_t d = 1; d < 257; ++d)
+            {
+                if (d == largest)
+                    largest_start = start;
+                else if (count[d] > 1)
+                    mySTL::radix_sort_string<CharTraits>(e + start, count[d], tmp, digit, depth + 1);
+                start += count[d];
+            }
+            e += largest_start;
+            n = count[largest];
+            ++depth;
+        }
+    }
+
+    // 按排好序的记录重排 [first, first + n)：沿着置换的每个环移动元素，每个元素只移动一次
+    template <class RandomIter, class Entry>
+    void radix_apply_permutation(RandomIter first, Entry *e, size_t n)
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            if (e[i].index == i)
+                continue;
+            auto value = mySTL::move(first[i]);
+            size_t j = i;
+            while (e[j].index != i)
+            {
+                const size_t k = e[j].index;
+                first[j] = mySTL::move(first[k]);
+                e[j].index = j;
+                j = k;
+            }
+            first[j] = mySTL::move(value);
+            e[j].index = j;
+        }
+    }
+
+    template <class RandomIter, class KeyFunction>
+    void radix_sort_dispatch(RandomIter first, RandomIter last, KeyFunction &key, radix_string_tag)
+    {
+        static_assert(std::is_lvalue_reference<decltype(key(*first))>::value,
+                      "radix_sort_by_key needs the string key to be returned by reference");
+        typedef typename std::decay<decltype(key(*first))>::type key_type;
+        typedef typename key_type::value_type char_type;
+        typedef typename key_type::traits_type traits_type;
+        typedef radix_string_entry<char_type> entry;
+
+        const size_t n = static_cast<size_t>(last - first);
+        // 记录可以平凡复制，不需要初始化，直接申请临时缓冲区
+        auto buf = mySTL::get_temporary_buffer<entry>(static_cast<ptrdiff_t>(2 * n));
+        if (static_cast<size_t>(buf.second) < 2 * n)
+        {
+            mySTL::release_temporary_buffer(buf.first);
+            mySTL::stable_sort(first, last, radix_suffix_less<KeyFunction>{&key, 0});
+            return;
+        }
+        entry *e = buf.first;
+        try
+        {
+            for (size_t i = 0; i < n; ++i)
+            {
+                const key_type &k = key(first[i]);
+                e[i] = entry{k.data(), k.size(), i};
+            }
+            mySTL::vector<unsigned short> digit(n);
+            mySTL::radix_sort_string<traits_type>(e, n, buf.first + n, digit.data(), 0);
+            mySTL::radix_apply_permutation(first, e, n);
+        }
+        catch (...)
+        {
+            mySTL::release_temporary_buffer(buf.first);
+            throw;
+        }
+        mySTL::release_temporary_buffer(buf.first);
+    }
+
+    /*****************************************************************************************/
+    // radix_sort_by_key
+    // 按 key(x) 对 [first, last) 稳定排序，key 返回整数、浮点数或单字节字符的 basic_string
+    /*****************************************************************************************/
+    template <class RandomIter, class KeyFunction>
+    void radix_sort_by_key(RandomIter first, RandomIter last, KeyFunction key)
+    {
+        typedef typename std::decay<decltype(key(*first))>::type key_type;
+        if (last - first > 1)
+            mySTL::radix_sort_dispatch(first, last, key, typename radix_key_traits<key_type>::category());
+    }
+
+    /*****************************************************************************************/
+    // radix_sort
+    // 对整数、浮点数或单字节字符的 basic_string 排序，结果与 sort 相同
+    /*****************************************************************************************/
+    template <class RandomIter>
+    void radix_sort(RandomIter first, RandomIter last)
+    {
+        mySTL::radix_sort_by_key(first, last, mySTL::identity<typename iterator_traits<RandomIter>::value_type>());
+    }
+
+} // namespace mySTL
+#endif // !MYSTL_RADIX_SORT_H_
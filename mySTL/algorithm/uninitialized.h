@@ -3,6 +3,8 @@
 
 //  对未初始化空间构造元素
 
+#include <cstring>
+
 #include "algobase.h"
 #include "../allocator/construct.h"
 // #include "iterator.h"
@@ -29,17 +31,18 @@ namespace mySTL
         auto cur = result;
         try
         {
-            for (; first != last; ++cur)
+            for (; first != last; ++first, ++cur)
             {
                 mySTL::construct(&*cur, *first);
             }
         }
         catch (...)
         {
-            for (; result != cur; --cur)
+            for (; result != cur; ++result)
             {
-                mySTL::destroy(&*cur);
+                mySTL::destroy(&*result);
             }
+            throw;
         }
         return cur;
     }
@@ -75,8 +78,9 @@ namespace mySTL
         }
         catch (...)
         {
-            for (; result != cur; --cur)
-            mySTL::destroy(&*cur);
+            for (; result != cur; ++result)
+                mySTL::destroy(&*result);
+            throw;
         }
         return cur;
     }
@@ -113,7 +117,8 @@ namespace mySTL
         catch (...)
         {
             for (;first != cur; ++first)
-            mySTL::destroy(&*first);
+                mySTL::destroy(&*first);
+            throw;
         }
     }
 
@@ -131,7 +136,7 @@ namespace mySTL
     ForwardIter 
     unchecked_uninit_fill_n(ForwardIter first, Size n, const T& value, m_intergral_constant<bool, true>)
     {
-        return mySTL::fill(first, n, value);
+        return mySTL::fill_n(first, n, value);
     }
 
     template <class ForwardIter, class Size, class T>
@@ -150,6 +155,7 @@ namespace mySTL
         {
             for (; first != cur; ++first)
                 mySTL::destroy(&*first);
+            throw;
         }
         return cur;
     }
@@ -186,6 +192,7 @@ namespace mySTL
         catch (...)
         {
             mySTL::destroy(result, cur);
+            throw;
         }
         return cur;
     }
@@ -236,5 +243,34 @@ namespace mySTL
                                             typename iterator_traits<InputIter>::
                                             value_type>{});
     }
+
+    /* uninitialized_relocate */
+    // 把 [first, last) 上的对象搬到 result 起始的未初始化空间，完成后原区间视为未初始化
+    // 可以按字节搬移的类型直接 memcpy，不调用移动构造和析构函数
+    template <class T>
+    T* unchecked_uninit_relocate(T* first, T* last, T* result, m_intergral_constant<bool, true>)
+    {
+        const auto n = static_cast<size_t>(last - first);
+        if (n != 0)
+        {
+            std::memcpy(static_cast<void*>(result), static_cast<const void*>(first), n * sizeof(T));
+        }
+        return result + n;
+    }
+
+    template <class T>
+    T* unchecked_uninit_relocate(T* first, T* last, T* result, m_intergral_constant<bool, false>)
+    {
+        T* cur = mySTL::uninitialized_move(first, last, result);
+        mySTL::destroy(first, last);
+        return cur;
+    }
+
+    template <class T>
+    T* uninitialized_relocate(T* first, T* last, T* result)
+    {
+        return mySTL::unchecked_uninit_relocate(first, last, result,
+                                                is_trivially_relocatable<T>{});
+    }
 }
 #endif
\ No newline at end of file
@@ -20,7 +20,22 @@ namespace mySTL
         typedef size_t      size_type;
         typedef ptrdiff_t   difference_type;
 
+        // 无状态的分配器：任意两个实例都相等，移动赋值时随容器一起传播
+        typedef m_true_type propagate_on_container_move_assignment;
+        typedef m_true_type is_always_equal;
+
+        template <class U>
+        struct rebind
+        {
+            typedef allocator<U> other;
+        };
+
     public:
+        allocator() noexcept = default;
+        allocator(const allocator&) noexcept = default;
+        template <class U>
+        allocator(const allocator<U>&) noexcept {}
+
         //分配内存
         static T* allocate();
         static T* allocate(size_type n);
@@ -41,6 +56,18 @@ namespace mySTL
         static void destroy(T* first, T* last);
     };
 
+    template <class T, class U>
+    bool operator==(const allocator<T>&, const allocator<U>&) noexcept
+    {
+        return true;
+    }
+
+    template <class T, class U>
+    bool operator!=(const allocator<T>&, const allocator<U>&) noexcept
+    {
+        return false;
+    }
+
     template <class T>
     T* allocator<T>::allocate()
     {
@@ -0,0 +1,512 @@
+#ifndef MYSTL_ALLOCATOR_TRAITS_H_
+#define MYSTL_ALLOCATOR_TRAITS_H_
+
+//  模板类 allocator_traits, 容器通过它使用分配器
+//  提供 rebind、propagate_on_* 等萃取，并支持有状态的分配器
+
+#include <cstddef>
+#include <type_traits>
+
+#include "construct.h"
+#include "../algorithm/uninitialized.h"
+#include "../iterator/type_traits.h"
+#include "../util/util.h"
+
+namespace mySTL
+{
+    // 用于检测成员类型是否存在
+    template <class...>
+    struct alloc_make_void
+    {
+        typedef void type;
+    };
+
+    template <class... Ts>
+    using alloc_void_t = typename alloc_make_void<Ts...>::type;
+
+    /* 以下萃取分配器的嵌套型别，缺省时使用标准规定的默认值 */
+
+    template <class Alloc, class = void>
+    struct alloc_pointer
+    {
+        typedef typename Alloc::value_type* type;
+    };
+
+    template <class Alloc>
+    struct alloc_pointer<Alloc, alloc_void_t<typename Alloc::pointer>>
+    {
+        typedef typename Alloc::pointer type;
+    };
+
+    template <class Alloc, class = void>
+    struct alloc_const_pointer
+    {
+        typedef const typename Alloc::value_type* type;
+    };
+
+    template <class Alloc>
+    struct alloc_const_pointer<Alloc, alloc_void_t<typename Alloc::const_pointer>>
+    {
+        typedef typename Alloc::const_pointer type;
+    };
+
+    template <class Alloc, class = void>
+    struct alloc_size_type
+    {
+        typedef size_t type;
+    };
+
+    template <class Alloc>
+    struct alloc_size_type<Alloc, alloc_void_t<typename Alloc::size_type>>
+    {
+        typedef typename Alloc::size_type type;
+    };
+
+    template <class Alloc, class = void>
+    struct alloc_difference_type
+    {
+        typedef ptrdiff_t type;
+    };
+
+    template <class Alloc>
+    struct alloc_difference_type<Alloc, alloc_void_t<typename Alloc::difference_type>>
+    {
+        typedef typename Alloc::difference_type type;
+    };
+
+    // propagate_on_* 统一转换为 m_intergral_constant，便于容器做标签分派
+    template <class Alloc, class = void>
+    struct alloc_pocca : m_false_type {};
+
+    template <class Alloc>
+    struct alloc_pocca<Alloc, alloc_void_t<typename Alloc::propagate_on_container_copy_assignment>>
+        : m_intergral_constant<bool, Alloc::propagate_on_container_copy_assignment::value> {};
+
+    template <class Alloc, class = void>
+    struct alloc_pocma : m_false_type {};
+
+    template <class Alloc>
+    struct alloc_pocma<Alloc, alloc_void_t<typename Alloc::propagate_on_container_move_assignment>>
+        : m_intergral_constant<bool, Alloc::propagate_on_container_move_assignment::value> {};
+
+    template <class Alloc, class = void>
+    struct alloc_pocs : m_false_type {};
+
+    template <class Alloc>
+    struct alloc_pocs<Alloc, alloc_void_t<typename Alloc::propagate_on_container_swap>>
+        : m_intergral_constant<bool, Alloc::propagate_on_container_swap::value> {};
+
+    // 未声明 is_always_equal 时，无状态（空类）的分配器视为总是相等
+    template <class Alloc, class = void>
+    struct alloc_always_equal : m_intergral_constant<bool, std::is_empty<Alloc>::value> {};
+
+    template <class Alloc>
+    struct alloc_always_equal<Alloc, alloc_void_t<typename Alloc::is_always_equal>>
+        : m_intergral_constant<bool, Alloc::is_always_equal::value> {};
+
+    // rebind：优先使用 Alloc::rebind<U>::other，否则替换 Alloc<T, Args...> 的第一个模板参数
+    template <class Alloc, class U>
+    struct alloc_rebind_first {};
+
+    template <template <class, class...> class Alloc, class T, class... Args, class U>
+    struct alloc_rebind_first<Alloc<T, Args...>, U>
+    {
+        typedef Alloc<U, Args...> type;
+    };
+
+    template <class Alloc, class U, class = void>
+    struct alloc_rebind : alloc_rebind_first<Alloc, U> {};
+
+    template <class Alloc, class U>
+    struct alloc_rebind<Alloc, U, alloc_void_t<typename Alloc::template rebind<U>::other>>
+    {
+        typedef typename Alloc::template rebind<U>::other type;
+    };
+
+    /* 以下检测分配器是否提供了对应的成员函数 */
+
+    template <class Alloc, class P, class = void, class... Args>
+    struct alloc_has_construct_impl : m_false_type {};
+
+    template <class Alloc, class P, class... Args>
+    struct alloc_has_construct_impl<Alloc, P,
+        alloc_void_t<decltype(std::declval<Alloc&>().construct(
+            std::declval<P>(), std::declval<Args>()...))>, Args...>
+        : m_true_type {};
+
+    template <class Alloc, class P, class... Args>
+    struct alloc_has_construct : alloc_has_construct_impl<Alloc, P, void, Args...> {};
+
+    template <class Alloc, class P, class = void>
+    struct alloc_has_destroy : m_false_type {};
+
+    template <class Alloc, class P>
+    struct alloc_has_destroy<Alloc, P,
+        alloc_void_t<decltype(std::declval<Alloc&>().destroy(std::declval<P>()))>>
+        : m_true_type {};
+
+    template <class Alloc, class = void>
+    struct alloc_has_max_size : m_false_type {};
+
+    template <class Alloc>
+    struct alloc_has_max_size<Alloc,
+        alloc_void_t<decltype(std::declval<const Alloc&>().max_size())>>
+        : m_true_type {};
+
+    template <class Alloc, class = void>
+    struct alloc_has_reallocate : m_false_type {};
+
+    template <class Alloc>
+    struct alloc_has_reallocate<Alloc,
+        alloc_void_t<decltype(std::declval<Alloc&>().reallocate(
+            std::declval<typename alloc_pointer<Alloc>::type>(),
+            std::declval<typename alloc_size_type<Alloc>::type>(),
+            std::declval<typename alloc_size_type<Alloc>::type>()))>>
+        : m_true_type {};
+
+    template <class Alloc, class = void>
+    struct alloc_has_select : m_false_type {};
+
+    template <class Alloc>
+    struct alloc_has_select<Alloc,
+        alloc_void_t<decltype(std::declval<const Alloc&>().select_on_container_copy_construction())>>
+        : m_true_type {};
+
+    /*
+    模板类：allocator_traits
+    容器不直接调用分配器，而是通过 allocator_traits 间接使用，
+    从而只要求分配器提供 value_type / allocate / deallocate 即可
+     */
+    template <class Alloc>
+    struct allocator_traits
+    {
+        typedef Alloc                                             allocator_type;
+        typedef typename Alloc::value_type                        value_type;
+        typedef typename alloc_pointer<Alloc>::type               pointer;
+        typedef typename alloc_const_pointer<Alloc>::type         const_pointer;
+        typedef typename alloc_size_type<Alloc>::type             size_type;
+        typedef typename alloc_difference_type<Alloc>::type       difference_type;
+
+        typedef alloc_pocca<Alloc>                                propagate_on_container_copy_assignment;
+        typedef alloc_pocma<Alloc>                                propagate_on_container_move_assignment;
+        typedef alloc_pocs<Alloc>                                 propagate_on_container_swap;
+        typedef alloc_always_equal<Alloc>                         is_always_equal;
+
+        template <class U>
+        using rebind_alloc = typename alloc_rebind<Alloc, U>::type;
+
+        template <class U>
+        using rebind_traits = allocator_traits<rebind_alloc<U>>;
+
+        // 分配 / 释放内存
+        static pointer allocate(Alloc& a, size_type n)
+        {
+            return a.allocate(n);
+        }
+
+        static void deallocate(Alloc& a, pointer p, size_type n)
+        {
+            a.deallocate(p, n);
+        }
+
+        // 构造 / 析构对象，分配器未提供时使用 mySTL::construct / mySTL::destroy
+        template <class U, class... Args>
+        static void construct(Alloc& a, U* p, Args&&... args)
+        {
+            construct_aux(alloc_has_construct<Alloc, U*, Args...>{}, a, p,
+                          mySTL::forward<Args>(args)...);
+        }
+
+        template <class U>
+        static void destroy(Alloc& a, U* p)
+        {
+            destroy_aux(alloc_has_destroy<Alloc, U*>{}, a, p);
+        }
+
+        // 析构 [first, last) 上的对象，平凡析构的类型直接跳过
+        template <class ForwardIter>
+        static void destroy(Alloc& a, ForwardIter first, ForwardIter last)
+        {
+            destroy_range(a, first, last, m_intergral_constant<bool,
+                          std::is_trivially_destructible<
+                          typename iterator_traits<ForwardIter>::value_type>::value>{});
+        }
+
+        // 在 result 起始的未初始化空间上通过分配器构造元素，失败时析构已构造的元素
+        // 分配器未提供 construct 时交给 mySTL::uninitialized_*，保留按字节复制的快速路径
+        template <class InputIter, class ForwardIter>
+        static ForwardIter uninitialized_copy(Alloc& a, InputIter first, InputIter last, ForwardIter result)
+        {
+            return uninit_copy_aux(alloc_has_construct<Alloc,
+                                   typename iterator_traits<ForwardIter>::value_type*,
+                                   decltype(*first)>{}, a, first, last, result);
+        }
+
+        template <class InputIter, class ForwardIter>
+        static ForwardIter uninitialized_move(Alloc& a, InputIter first, InputIter last, ForwardIter result)
+        {
+            return uninit_move_aux(alloc_has_construct<Alloc,
+                                   typename iterator_traits<ForwardIter>::value_type*,
+                                   decltype(mySTL::move(*first))>{}, a, first, last, result);
+        }
+
+        template <class ForwardIter, class T>
+        static void uninitialized_fill(Alloc& a, ForwardIter first, ForwardIter last, const T& value)
+        {
+            uninitialized_fill_n(a, first, mySTL::distance(first, last), value);
+        }
+
+        template <class ForwardIter, class Size, class T>
+        static ForwardIter uninitialized_fill_n(Alloc& a, ForwardIter first, Size n, const T& value)
+        {
+            return uninit_fill_n_aux(alloc_has_construct<Alloc,
+                                     typename iterator_traits<ForwardIter>::value_type*,
+                                     const T&>{}, a, first, n, value);
+        }
+
+        static size_type max_size(const Alloc& a) noexcept
+        {
+            return max_size_aux(alloc_has_max_size<Alloc>{}, a);
+        }
+
+        static Alloc select_on_container_copy_construction(const Alloc& a)
+        {
+            return select_aux(alloc_has_select<Alloc>{}, a);
+        }
+
+        // 把 p 指向的 old_n 个元素的空间调整为 new_n 个，内容按字节保留，地址可能改变
+        // 分配器不支持或无法完成时返回空指针，原空间保持不变
+        // 只能用于可以按字节搬移的元素（is_trivially_relocatable）
+        static pointer reallocate(Alloc& a, pointer p, size_type old_n, size_type new_n)
+        {
+            return reallocate_aux(alloc_has_reallocate<Alloc>{}, a, p, old_n, new_n);
+        }
+
+    private:
+        template <class U, class... Args>
+        static void construct_aux(m_true_type, Alloc& a, U* p, Args&&... args)
+        {
+            a.construct(p, mySTL::forward<Args>(args)...);
+        }
+
+        template <class U, class... Args>
+        static void construct_aux(m_false_type, Alloc&, U* p, Args&&... args)
+        {
+            mySTL::construct(p, mySTL::forward<Args>(args)...);
+        }
+
+        template <class U>
+        static void destroy_aux(m_true_type, Alloc& a, U* p)
+        {
+            a.destroy(p);
+        }
+
+        template <class U>
+        static void destroy_aux(m_false_type, Alloc&, U* p)
+        {
+            mySTL::destroy(p);
+        }
+
+        template <class ForwardIter>
+        static void destroy_range(Alloc&, ForwardIter, ForwardIter, m_true_type) {}
+
+        template <class ForwardIter>
+        static void destroy_range(Alloc& a, ForwardIter first, ForwardIter last, m_false_type)
+        {
+            for (; first != last; ++first)
+            {
+                destroy(a, &*first);
+            }
+        }
+
+        template <class InputIter, class ForwardIter>
+        static ForwardIter uninit_copy_aux(m_true_type, Alloc& a, InputIter first, InputIter last,
+                                           ForwardIter result)
+        {
+            auto cur = result;
+            try
+            {
+                for (; first != last; ++first, ++cur)
+                {
+                    construct(a, &*cur, *first);
+                }
+            }
+            catch (...)
+            {
+                destroy(a, result, cur);
+                throw;
+            }
+            return cur;
+        }
+
+        template <class InputIter, class ForwardIter>
+        static ForwardIter uninit_copy_aux(m_false_type, Alloc&, InputIter first, InputIter last,
+                                           ForwardIter result)
+        {
+            return mySTL::uninitialized_copy(first, last, result);
+        }
+
+        template <class InputIter, class ForwardIter>
+        static ForwardIter uninit_move_aux(m_true_type, Alloc& a, InputIter first, InputIter last,
+                                           ForwardIter result)
+        {
+            auto cur = result;
+            try
+            {
+                for (; first != last; ++first, ++cur)
+                {
+                    construct(a, &*cur, mySTL::move(*first));
+                }
+            }
+            catch (...)
+            {
+                destroy(a, result, cur);
+                throw;
+            }
+            return cur;
+        }
+
+        template <class InputIter, class ForwardIter>
+        static ForwardIter uninit_move_aux(m_false_type, Alloc&, InputIter first, InputIter last,
+                                           ForwardIter result)
+        {
+            return mySTL::uninitialized_move(first, last, result);
+        }
+
+        template <class ForwardIter, class Size, class T>
+        static ForwardIter uninit_fill_n_aux(m_true_type, Alloc& a, ForwardIter first, Size n,
+                                             const T& value)
+        {
+            auto cur = first;
+            try
+            {
+                for (; n > 0; --n, ++cur)
+                {
+                    construct(a, &*cur, value);
+                }
+            }
+            catch (...)
+            {
+                destroy(a, first, cur);
+                throw;
+            }
+            return cur;
+        }
+
+        template <class ForwardIter, class Size, class T>
+        static ForwardIter uninit_fill_n_aux(m_false_type, Alloc&, ForwardIter first, Size n,
+                                             const T& value)
+        {
+            return mySTL::uninitialized_fill_n(first, n, value);
+        }
+
+        static size_type max_size_aux(m_true_type, const Alloc& a)
+        {
+            return a.max_size();
+        }
+
+        static size_type max_size_aux(m_false_type, const Alloc&)
+        {
+            return static_cast<size_type>(-1) / sizeof(value_type);
+        }
+
+        static pointer reallocate_aux(m_true_type, Alloc& a, pointer p, size_type old_n, size_type new_n)
+        {
+            return a.reallocate(p, old_n, new_n);
+        }
+
+        static pointer reallocate_aux(m_false_type, Alloc&, pointer, size_type, size_type)
+        {
+            return nullptr;
+        }
+
+        static Alloc select_aux(m_true_type, const Alloc& a)
+        {
+            return a.select_on_container_copy_construction();
+        }
+
+        static Alloc select_aux(m_false_type, const Alloc& a)
+        {
+            return a;
+        }
+    };
+
+    /*
+    模板类：alloc_holder
+    容器以私有继承的方式保存分配器，无状态的分配器借助空基类优化不占用额外空间
+     */
+    // std::is_final 是 C++14 才有的，这里直接使用编译器内建的 __is_final
+    template <class Alloc, bool = std::is_empty<Alloc>::value && !__is_final(Alloc)>
+    class alloc_holder : private Alloc
+    {
+    public:
+        alloc_holder() : Alloc() {}
+        explicit alloc_holder(const Alloc& a) : Alloc(a) {}
+        explicit alloc_holder(Alloc&& a) : Alloc(mySTL::move(a)) {}
+
+        Alloc&       alloc_ref()       noexcept { return *this; }
+        const Alloc& alloc_ref() const noexcept { return *this; }
+    };
+
+    template <class Alloc>
+    class alloc_holder<Alloc, false>
+    {
+    private:
+        Alloc alloc_;
+
+    public:
+        alloc_holder() : alloc_() {}
+        explicit alloc_holder(const Alloc& a) : alloc_(a) {}
+        explicit alloc_holder(Alloc&& a) : alloc_(mySTL::move(a)) {}
+
+        Alloc&       alloc_ref()       noexcept { return alloc_; }
+        const Alloc& alloc_ref() const noexcept { return alloc_; }
+    };
+
+    // 根据 propagate_on_* 决定是否复制 / 移动 / 交换分配器
+    template <class Alloc>
+    void alloc_copy_assign(Alloc& lhs, const Alloc& rhs, m_true_type)
+    {
+        lhs = rhs;
+    }
+
+    template <class Alloc>
+    void alloc_copy_assign(Alloc&, const Alloc&, m_false_type) {}
+
+    template <class Alloc>
+    void alloc_move_assign(Alloc& lhs, Alloc& rhs, m_true_type)
+    {
+        lhs = mySTL::move(rhs);
+    }
+
+    template <class Alloc>
+    void alloc_move_assign(Alloc&, Alloc&, m_false_type) {}
+
+    template <class Alloc>
+    void alloc_swap(Alloc& lhs, Alloc& rhs, m_true_type)
+    {
+        mySTL::swap(lhs, rhs);
+    }
+
+    template <class Alloc>
+    void alloc_swap(Alloc&, Alloc&, m_false_type) {}
+
+    // 判断两个分配器是否相等，总是相等的分配器不做比较
+    template <class Alloc>
+    bool alloc_equal(const Alloc& lhs, const Alloc& rhs)
+    {
+        return allocator_traits<Alloc>::is_always_equal::value || lhs == rhs;
+    }
+
+    // uses_allocator：T 是否可以使用 Alloc 构造（T 具有可由 Alloc 转换得到的 allocator_type）
+    template <class T, class Alloc, class = void>
+    struct uses_allocator : m_false_type {};
+
+    template <class T, class Alloc>
+    struct uses_allocator<T, Alloc, alloc_void_t<typename T::allocator_type>>
+        : m_intergral_constant<bool,
+          std::is_convertible<Alloc, typename T::allocator_type>::value> {};
+
+}
+
+#endif // !MYSTL_ALLOCATOR_TRAITS_H_
@@ -0,0 +1,820 @@
+#ifndef MYSTL_MEMORY_RESOURCE_H_
+#define MYSTL_MEMORY_RESOURCE_H_
+
+//  这个头文件包含 pmr 命名空间下的内存资源与多态分配器
+//  memory_resource                : 内存资源的抽象基类
+//  monotonic_buffer_resource      : 只增不减的缓冲区，deallocate 为空操作，release 时一次性归还
+//  unsynchronized_pool_resource   : 按 2 的幂分级的内存池，不加锁
+//  synchronized_pool_resource     : 加锁的内存池，可以在多个线程间共享
+//  polymorphic_allocator          : 把分配转交给 memory_resource 的分配器，可以作为容器的 Alloc 参数：
+//    char buf[4096];
+//    mySTL::pmr::monotonic_buffer_resource arena(buf, sizeof(buf));
+//    mySTL::vector<int, mySTL::pmr::polymorphic_allocator<int>> v(&arena);
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "aligned_allocator.h"
+#include "allocator_traits.h"
+#include "construct.h"
+#include "../iterator/type_traits.h"
+#include "../util/exceptdef.h"
+#include "../util/util.h"
+
+namespace mySTL
+{
+namespace pmr
+{
+    /*
+    类：memory_resource
+    所有内存资源的基类，派生类实现 do_allocate / do_deallocate / do_is_equal
+     */
+    class memory_resource
+    {
+    public:
+        static constexpr size_t max_align = alignof(std::max_align_t);
+
+    public:
+        virtual ~memory_resource() = default;
+
+        void* allocate(size_t bytes, size_t align = max_align)
+        {
+            return do_allocate(bytes, align);
+        }
+
+        void deallocate(void* p, size_t bytes, size_t align = max_align)
+        {
+            do_deallocate(p, bytes, align);
+        }
+
+        bool is_equal(const memory_resource& other) const noexcept
+        {
+            return do_is_equal(other);
+        }
+
+    private:
+        virtual void* do_allocate(size_t bytes, size_t align) = 0;
+        virtual void  do_deallocate(void* p, size_t bytes, size_t align) = 0;
+        virtual bool  do_is_equal(const memory_resource& other) const noexcept = 0;
+    };
+
+    inline bool operator==(const memory_resource& lhs, const memory_resource& rhs) noexcept
+    {
+        return &lhs == &rhs || lhs.is_equal(rhs);
+    }
+
+    inline bool operator!=(const memory_resource& lhs, const memory_resource& rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
+
+    // 把 n 向上取整为 align 的倍数，align 为 2 的幂
+    inline size_t align_up(size_t n, size_t align) noexcept
+    {
+        return (n + align - 1) & ~(align - 1);
+    }
+
+    inline bool is_power_of_two(size_t n) noexcept
+    {
+        return n != 0 && (n & (n - 1)) == 0;
+    }
+
+    /*
+    类：new_delete_resource_imp
+    使用 ::operator new / ::operator delete，超过 max_align 的对齐要求由 aligned_allocate 处理
+     */
+    class new_delete_resource_imp : public memory_resource
+    {
+    private:
+        void* do_allocate(size_t bytes, size_t align) override
+        {
+            return aligned_allocate(bytes, align);
+        }
+
+        void do_deallocate(void* p, size_t, size_t align) override
+        {
+            aligned_deallocate(p, align);
+        }
+
+        bool do_is_equal(const memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+    };
+
+    /*
+    类：null_memory_resource_imp
+    任何分配都抛出 std::bad_alloc，用于确认 monotonic_buffer_resource 没有越过初始缓冲区
+     */
+    class null_memory_resource_imp : public memory_resource
+    {
+    private:
+        void* do_allocate(size_t, size_t) override
+        {
+            throw std::bad_alloc();
+        }
+
+        void do_deallocate(void*, size_t, size_t) override {}
+
+        bool do_is_equal(const memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+    };
+
+    // 以下两个资源在进程结束前一直存在，不会在静态对象析构之后失效
+    inline memory_resource* new_delete_resource() noexcept
+    {
+        static memory_resource* res = new new_delete_resource_imp;
+        return res;
+    }
+
+    inline memory_resource* null_memory_resource() noexcept
+    {
+        static memory_resource* res = new null_memory_resource_imp;
+        return res;
+    }
+
+    // 默认资源，polymorphic_allocator 缺省构造时使用
+    inline std::atomic<memory_resource*>& default_resource_ref() noexcept
+    {
+        static std::atomic<memory_resource*> res(new_delete_resource());
+        return res;
+    }
+
+    inline memory_resource* get_default_resource() noexcept
+    {
+        return default_resource_ref().load(std::memory_order_acquire);
+    }
+
+    // 设置新的默认资源并返回原来的资源，传入空指针时恢复为 new_delete_resource
+    inline memory_resource* set_default_resource(memory_resource* r) noexcept
+    {
+        if (r == nullptr)
+        {
+            r = new_delete_resource();
+        }
+        return default_resource_ref().exchange(r, std::memory_order_acq_rel);
+    }
+
+    /*****************************************************************************************/
+
+    /*
+    类：monotonic_buffer_resource
+    从当前缓冲区顺序切出内存，不足时向上游申请一块更大的缓冲区（每次翻倍），
+    deallocate 不做任何事，所有内存在 release 或析构时一次性归还给上游
+     */
+    class monotonic_buffer_resource : public memory_resource
+    {
+    private:
+        // 从上游申请的缓冲区，头部放在缓冲区末尾
+        struct chunk_header
+        {
+            chunk_header* next;
+            size_t        bytes;   // 整块大小（含头部）
+            size_t        align;
+        };
+
+        enum { MONO_INIT_SIZE = 1024 };
+
+        memory_resource* upstream_;
+        void*            initial_buffer_;
+        size_t           initial_size_;
+        char*            cur_;          // 当前缓冲区中尚未使用的位置
+        size_t           space_;        // 当前缓冲区剩余的字节数
+        size_t           next_size_;    // 下一次向上游申请的大小
+        chunk_header*    chunks_;
+
+    public:
+        monotonic_buffer_resource()
+            : monotonic_buffer_resource(get_default_resource()) {}
+
+        explicit monotonic_buffer_resource(memory_resource* upstream)
+            : monotonic_buffer_resource(MONO_INIT_SIZE, upstream) {}
+
+        explicit monotonic_buffer_resource(size_t initial_size,
+                                           memory_resource* upstream = get_default_resource())
+            : upstream_(upstream), initial_buffer_(nullptr), initial_size_(0),
+              cur_(nullptr), space_(0),
+              next_size_(initial_size < sizeof(chunk_header) ? size_t(MONO_INIT_SIZE) : initial_size),
+              chunks_(nullptr)
+        {
+            MYSTL_DEBUG(upstream != nullptr);
+        }
+
+        // 使用调用者提供的缓冲区，用完之后才向上游申请
+        monotonic_buffer_resource(void* buffer, size_t buffer_size,
+                                  memory_resource* upstream = get_default_resource())
+            : upstream_(upstream), initial_buffer_(buffer), initial_size_(buffer_size),
+              cur_(static_cast<char*>(buffer)), space_(buffer_size),
+              next_size_(buffer_size < MONO_INIT_SIZE ? size_t(MONO_INIT_SIZE) : buffer_size * 2),
+              chunks_(nullptr)
+        {
+            MYSTL_DEBUG(upstream != nullptr);
+        }
+
+        monotonic_buffer_resource(const monotonic_buffer_resource&) = delete;
+        monotonic_buffer_resource& operator=(const monotonic_buffer_resource&) = delete;
+
+        ~monotonic_buffer_resource() override
+        {
+            release();
+        }
+
+        // 归还所有从上游申请的缓冲区，并重新从初始缓冲区开始分配
+        void release() noexcept
+        {
+            while (chunks_ != nullptr)
+            {
+                chunk_header* next = chunks_->next;
+                char* start = reinterpret_cast<char*>(chunks_ + 1) - chunks_->bytes;
+                upstream_->deallocate(start, chunks_->bytes, chunks_->align);
+                chunks_ = next;
+            }
+            cur_ = static_cast<char*>(initial_buffer_);
+            space_ = initial_size_;
+        }
+
+        memory_resource* upstream_resource() const noexcept { return upstream_; }
+
+    private:
+        void* do_allocate(size_t bytes, size_t align) override
+        {
+            MYSTL_DEBUG(is_power_of_two(align));
+            void* p = carve(bytes, align);
+            if (p == nullptr)
+            {
+                new_chunk(bytes, align);
+                p = carve(bytes, align);
+            }
+            return p;
+        }
+
+        void do_deallocate(void*, size_t, size_t) override {}
+
+        bool do_is_equal(const memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+
+        // 在当前缓冲区中按对齐要求切出 bytes 字节，空间不足时返回空指针
+        void* carve(size_t bytes, size_t align) noexcept
+        {
+            if (cur_ == nullptr)
+            {
+                return nullptr;
+            }
+            const std::uintptr_t addr = reinterpret_cast<std::uintptr_t>(cur_);
+            const size_t pad = align_up(addr, align) - addr;
+            if (pad > space_ || bytes > space_ - pad)
+            {
+                return nullptr;
+            }
+            char* p = cur_ + pad;
+            cur_ = p + bytes;
+            space_ -= pad + bytes;
+            return p;
+        }
+
+        void new_chunk(size_t bytes, size_t align)
+        {
+            if (align < alignof(chunk_header))
+            {
+                align = alignof(chunk_header);
+            }
+            // 至少要放下本次请求（含对齐填充）和末尾的头部
+            const size_t need = align_up(bytes + align, alignof(chunk_header)) + sizeof(chunk_header);
+            THROW_LENGTH_ERROR_IF(need < bytes, "monotonic_buffer_resource<T>'s size too big");
+            size_t size = next_size_;
+            while (size < need)
+            {
+                size *= 2;
+            }
+            size = align_up(size, alignof(chunk_header));
+            char* start = static_cast<char*>(upstream_->allocate(size, align));
+            chunk_header* header = reinterpret_cast<chunk_header*>(start + size) - 1;
+            header->next = chunks_;
+            header->bytes = size;
+            header->align = align;
+            chunks_ = header;
+            cur_ = start;
+            space_ = size - sizeof(chunk_header);
+            next_size_ = size * 2;
+        }
+    };
+
+    /*****************************************************************************************/
+
+    // 内存池的参数，为 0 时使用缺省值
+    struct pool_options
+    {
+        size_t max_blocks_per_chunk = 0;        // 每次向上游申请的块数上限
+        size_t largest_required_pool_block = 0; // 超过该大小的请求直接交给上游
+    };
+
+    /*
+    类：unsynchronized_pool_resource
+    按 8、16、32 ... 字节分级，每一级从上游申请的 chunk 中切出大小相同的块，
+    释放的块挂回该级的空闲链表；超过最大级别的请求直接交给上游，并记录下来以便 release
+    不加锁，只能在单个线程中使用
+     */
+    class unsynchronized_pool_resource : public memory_resource
+    {
+    private:
+        enum
+        {
+            POOL_MIN_SHIFT = 3,                 // 最小的块为 8 字节
+            POOL_MAX_SHIFT = 20,                // 最大的块为 1MB
+            POOL_LEVELS = POOL_MAX_SHIFT - POOL_MIN_SHIFT + 1,
+            POOL_DEFAULT_LARGEST = 4096,
+            POOL_DEFAULT_MAX_BLOCKS = 1024,
+            POOL_CHUNK_INIT_BYTES = 1024        // 每一级第一个 chunk 的大致大小
+        };
+
+        struct free_block
+        {
+            free_block* next;
+        };
+
+        // chunk 的头部放在 chunk 末尾，块本身按块大小对齐
+        struct chunk_header
+        {
+            chunk_header* next;
+            size_t        bytes;
+            size_t        align;
+        };
+
+        // 交给上游的大块内存，头部放在返回地址之前，使用双向链表以便单独释放
+        struct large_header
+        {
+            large_header* prev;
+            large_header* next;
+            size_t        bytes;
+            size_t        align;
+        };
+
+        struct pool
+        {
+            free_block*   free_list = nullptr;
+            chunk_header* chunks = nullptr;
+            size_t        next_blocks = 0;  // 下一个 chunk 的块数
+        };
+
+        memory_resource* upstream_;
+        pool_options     options_;
+        size_t           levels_;
+        pool             pools_[POOL_LEVELS];
+        large_header*    large_;
+
+    public:
+        unsynchronized_pool_resource()
+            : unsynchronized_pool_resource(pool_options(), get_default_resource()) {}
+
+        explicit unsynchronized_pool_resource(memory_resource* upstream)
+            : unsynchronized_pool_resource(pool_options(), upstream) {}
+
+        explicit unsynchronized_pool_resource(const pool_options& opts,
+                                              memory_resource* upstream = get_default_resource())
+            : upstream_(upstream), options_(opts), levels_(0), large_(nullptr)
+        {
+            MYSTL_DEBUG(upstream != nullptr);
+            size_t largest = options_.largest_required_pool_block;
+            if (largest == 0)
+            {
+                largest = POOL_DEFAULT_LARGEST;
+            }
+            if (largest > (static_cast<size_t>(1) << POOL_MAX_SHIFT))
+            {
+                largest = static_cast<size_t>(1) << POOL_MAX_SHIFT;
+            }
+            size_t block = static_cast<size_t>(1) << POOL_MIN_SHIFT;
+            levels_ = 1;
+            while (block < largest)
+            {
+                block <<= 1;
+                ++levels_;
+            }
+            options_.largest_required_pool_block = block;
+            if (options_.max_blocks_per_chunk == 0)
+            {
+                options_.max_blocks_per_chunk = POOL_DEFAULT_MAX_BLOCKS;
+            }
+        }
+
+        unsynchronized_pool_resource(const unsynchronized_pool_resource&) = delete;
+        unsynchronized_pool_resource& operator=(const unsynchronized_pool_resource&) = delete;
+
+        ~unsynchronized_pool_resource() override
+        {
+            release();
+        }
+
+        // 把所有 chunk 和大块内存归还给上游，即使其中的块尚未释放
+        void release() noexcept
+        {
+            for (size_t i = 0; i < levels_; ++i)
+            {
+                pool& pl = pools_[i];
+                while (pl.chunks != nullptr)
+                {
+                    chunk_header* next = pl.chunks->next;
+                    char* start = reinterpret_cast<char*>(pl.chunks + 1) - pl.chunks->bytes;
+                    upstream_->deallocate(start, pl.chunks->bytes, pl.chunks->align);
+                    pl.chunks = next;
+                }
+                pl.free_list = nullptr;
+                pl.next_blocks = 0;
+            }
+            while (large_ != nullptr)
+            {
+                large_header* next = large_->next;
+                const size_t offset = large_offset(large_->align);
+                upstream_->deallocate(reinterpret_cast<char*>(large_ + 1) - offset,
+                                      large_->bytes + offset, large_->align);
+                large_ = next;
+            }
+        }
+
+        memory_resource* upstream_resource() const noexcept { return upstream_; }
+        pool_options     options()           const noexcept { return options_; }
+
+    private:
+        static size_t block_size(size_t level) noexcept
+        {
+            return static_cast<size_t>(1) << (level + POOL_MIN_SHIFT);
+        }
+
+        // 能容纳 bytes 且满足 align 的最小级别，块按自身大小对齐
+        size_t level_of(size_t bytes, size_t align) const noexcept
+        {
+            const size_t need = bytes > align ? bytes : align;
+            size_t level = 0;
+            while (level < levels_ && block_size(level) < need)
+            {
+                ++level;
+            }
+            return level;
+        }
+
+        // 大块内存的头部占用的空间，保证返回地址仍满足 align
+        static size_t large_offset(size_t align) noexcept
+        {
+            return align_up(sizeof(large_header), align > alignof(large_header) ? align : alignof(large_header));
+        }
+
+        void* do_allocate(size_t bytes, size_t align) override
+        {
+            MYSTL_DEBUG(is_power_of_two(align));
+            const size_t level = level_of(bytes, align);
+            if (level == levels_)
+            {
+                return allocate_large(bytes, align);
+            }
+            pool& pl = pools_[level];
+            if (pl.free_list == nullptr)
+            {
+                refill(pl, level);
+            }
+            free_block* p = pl.free_list;
+            pl.free_list = p->next;
+            return p;
+        }
+
+        void do_deallocate(void* p, size_t bytes, size_t align) override
+        {
+            const size_t level = level_of(bytes, align);
+            if (level == levels_)
+            {
+                deallocate_large(p);
+                return;
+            }
+            free_block* node = static_cast<free_block*>(p);
+            node->next = pools_[level].free_list;
+            pools_[level].free_list = node;
+        }
+
+        bool do_is_equal(const memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+
+        // 为 level 级申请新的 chunk，块数每次翻倍直到 max_blocks_per_chunk
+        void refill(pool& pl, size_t level)
+        {
+            const size_t block = block_size(level);
+            if (pl.next_blocks == 0)
+            {
+                pl.next_blocks = POOL_CHUNK_INIT_BYTES / block;
+                if (pl.next_blocks == 0)
+                {
+                    pl.next_blocks = 1;
+                }
+            }
+            size_t n = pl.next_blocks;
+            if (n > options_.max_blocks_per_chunk)
+            {
+                n = options_.max_blocks_per_chunk;
+            }
+            const size_t align = block > alignof(chunk_header) ? block : alignof(chunk_header);
+            const size_t size = n * block + sizeof(chunk_header);
+            char* start = static_cast<char*>(upstream_->allocate(size, align));
+            chunk_header* header = reinterpret_cast<chunk_header*>(start + n * block);
+            header->next = pl.chunks;
+            header->bytes = size;
+            header->align = align;
+            pl.chunks = header;
+            // 按地址顺序把块串到空闲链表上
+            for (size_t i = n; i > 0; --i)
+            {
+                free_block* node = reinterpret_cast<free_block*>(start + (i - 1) * block);
+                node->next = pl.free_list;
+                pl.free_list = node;
+            }
+            if (pl.next_blocks < options_.max_blocks_per_chunk)
+            {
+                pl.next_blocks *= 2;
+            }
+        }
+
+        void* allocate_large(size_t bytes, size_t align)
+        {
+            const size_t offset = large_offset(align);
+            THROW_LENGTH_ERROR_IF(bytes + offset < bytes, "unsynchronized_pool_resource<T>'s size too big");
+            char* start = static_cast<char*>(upstream_->allocate(bytes + offset,
+                align > alignof(large_header) ? align : alignof(large_header)));
+            large_header* header = reinterpret_cast<large_header*>(start + offset) - 1;
+            header->prev = nullptr;
+            header->next = large_;
+            header->bytes = bytes;
+            header->align = align > alignof(large_header) ? align : alignof(large_header);
+            if (large_ != nullptr)
+            {
+                large_->prev = header;
+            }
+            large_ = header;
+            return start + offset;
+        }
+
+        void deallocate_large(void* p)
+        {
+            large_header* header = static_cast<large_header*>(p) - 1;
+            if (header->prev != nullptr)
+            {
+                header->prev->next = header->next;
+            }
+            else
+            {
+                large_ = header->next;
+            }
+            if (header->next != nullptr)
+            {
+                header->next->prev = header->prev;
+            }
+            const size_t offset = large_offset(header->align);
+            upstream_->deallocate(static_cast<char*>(p) - offset, header->bytes + offset, header->align);
+        }
+    };
+
+    /*
+    类：synchronized_pool_resource
+    在 unsynchronized_pool_resource 外加一把互斥锁，可以在多个线程间共享
+     */
+    class synchronized_pool_resource : public memory_resource
+    {
+    private:
+        unsynchronized_pool_resource pool_;
+        std::mutex                   mutex_;
+
+    public:
+        synchronized_pool_resource()
+            : pool_() {}
+
+        explicit synchronized_pool_resource(memory_resource* upstream)
+            : pool_(upstream) {}
+
+        explicit synchronized_pool_resource(const pool_options& opts,
+                                            memory_resource* upstream = get_default_resource())
+            : pool_(opts, upstream) {}
+
+        synchronized_pool_resource(const synchronized_pool_resource&) = delete;
+        synchronized_pool_resource& operator=(const synchronized_pool_resource&) = delete;
+
+        void release()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            pool_.release();
+        }
+
+        memory_resource* upstream_resource() const noexcept { return pool_.upstream_resource(); }
+        pool_options     options()           const noexcept { return pool_.options(); }
+
+    private:
+        void* do_allocate(size_t bytes, size_t align) override
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return pool_.allocate(bytes, align);
+        }
+
+        void do_deallocate(void* p, size_t bytes, size_t align) override
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            pool_.deallocate(p, bytes, align);
+        }
+
+        bool do_is_equal(const memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+    };
+
+    /*****************************************************************************************/
+
+    /*
+    模板类：polymorphic_allocator
+    保存一个 memory_resource 指针，所有分配都转交给它
+    容器复制时不传播资源（新容器使用默认资源），移动赋值与交换时也不传播，
+    两个分配器相等当且仅当它们的资源相等
+     */
+    template <class T>
+    class polymorphic_allocator
+    {
+    public:
+        typedef T           value_type;
+        typedef T*          pointer;
+        typedef const T*    const_pointer;
+        typedef T&          reference;
+        typedef const T&    const_reference;
+        typedef size_t      size_type;
+        typedef ptrdiff_t   difference_type;
+
+        template <class U>
+        struct rebind
+        {
+            typedef polymorphic_allocator<U> other;
+        };
+
+    private:
+        memory_resource* resource_;
+
+    public:
+        polymorphic_allocator() noexcept
+            : resource_(get_default_resource()) {}
+
+        polymorphic_allocator(memory_resource* r) noexcept
+            : resource_(r)
+        {
+            MYSTL_DEBUG(r != nullptr);
+        }
+
+        polymorphic_allocator(const polymorphic_allocator&) = default;
+
+        template <class U>
+        polymorphic_allocator(const polymorphic_allocator<U>& other) noexcept
+            : resource_(other.resource()) {}
+
+        T* allocate(size_type n)
+        {
+            THROW_LENGTH_ERROR_IF(n > max_size(), "polymorphic_allocator<T>'s size too big");
+            return static_cast<T*>(resource_->allocate(n * sizeof(T), alignof(T)));
+        }
+
+        void deallocate(T* ptr, size_type n)
+        {
+            if (ptr == nullptr)
+            {
+                return;
+            }
+            resource_->deallocate(ptr, n * sizeof(T), alignof(T));
+        }
+
+        // 元素类型也使用 polymorphic_allocator 时（如 vector<string>），把资源传给元素
+        template <class U, class... Args,
+                  typename std::enable_if<!is_pair<U>::value, int>::type = 0>
+        void construct(U* p, Args&&... args)
+        {
+            construct_aux(pass_resource<U, Args...>{}, p, mySTL::forward<Args>(args)...);
+        }
+
+        // pair 不是分配器感知的类型，但 first / second 可能是（如 map<int, string>），
+        // 所有 pair 的构造都转换为分段构造，对两个成员分别决定是否传入资源
+        template <class T1, class T2, class... Args1, class... Args2>
+        void construct(pair<T1, T2>* p, std::piecewise_construct_t,
+                       std::tuple<Args1...> x, std::tuple<Args2...> y)
+        {
+            ::new ((void*)p) pair<T1, T2>(std::piecewise_construct,
+                                          member_args(pass_resource<T1, Args1...>{}, x),
+                                          member_args(pass_resource<T2, Args2...>{}, y));
+        }
+
+        template <class T1, class T2>
+        void construct(pair<T1, T2>* p)
+        {
+            construct(p, std::piecewise_construct, std::tuple<>(), std::tuple<>());
+        }
+
+        template <class T1, class T2, class U, class V>
+        void construct(pair<T1, T2>* p, U&& x, V&& y)
+        {
+            construct(p, std::piecewise_construct,
+                      std::forward_as_tuple(mySTL::forward<U>(x)),
+                      std::forward_as_tuple(mySTL::forward<V>(y)));
+        }
+
+        template <class T1, class T2, class U, class V>
+        void construct(pair<T1, T2>* p, const pair<U, V>& pr)
+        {
+            construct(p, std::piecewise_construct,
+                      std::forward_as_tuple(pr.first), std::forward_as_tuple(pr.second));
+        }
+
+        template <class T1, class T2, class U, class V>
+        void construct(pair<T1, T2>* p, pair<U, V>&& pr)
+        {
+            construct(p, std::piecewise_construct,
+                      std::forward_as_tuple(mySTL::forward<U>(pr.first)),
+                      std::forward_as_tuple(mySTL::forward<V>(pr.second)));
+        }
+
+        template <class U>
+        void destroy(U* p)
+        {
+            mySTL::destroy(p);
+        }
+
+        size_type max_size() const noexcept
+        {
+            return static_cast<size_type>(-1) / sizeof(T);
+        }
+
+        polymorphic_allocator select_on_container_copy_construction() const
+        {
+            return polymorphic_allocator();
+        }
+
+        memory_resource* resource() const noexcept { return resource_; }
+
+    private:
+        // U::allocator_type 是否为某个 polymorphic_allocator
+        template <class U, class = void>
+        struct uses_pmr : m_false_type {};
+
+        template <class U>
+        struct uses_pmr<U, alloc_void_t<typename U::allocator_type>>
+            : m_intergral_constant<bool, std::is_convertible<
+              const polymorphic_allocator&, typename U::allocator_type>::value> {};
+
+        // 需要把资源作为最后一个参数传给 U 的构造函数
+        template <class U, class... Args>
+        struct pass_resource
+            : m_intergral_constant<bool, uses_pmr<U>::value &&
+              std::is_constructible<U, Args..., const polymorphic_allocator&>::value> {};
+
+        // pair 成员的构造参数，需要时在末尾追加资源
+        template <class... Args>
+        std::tuple<Args...> member_args(m_false_type, std::tuple<Args...>& t)
+        {
+            return mySTL::move(t);
+        }
+
+        template <class... Args>
+        std::tuple<Args..., const polymorphic_allocator&>
+        member_args(m_true_type, std::tuple<Args...>& t)
+        {
+            return std::tuple_cat(mySTL::move(t), std::tuple<const polymorphic_allocator&>(*this));
+        }
+
+        template <class U, class... Args>
+        void construct_aux(m_true_type, U* p, Args&&... args)
+        {
+            ::new ((void*)p) U(mySTL::forward<Args>(args)..., *this);
+        }
+
+        template <class U, class... Args>
+        void construct_aux(m_false_type, U* p, Args&&... args)
+        {
+            mySTL::construct(p, mySTL::forward<Args>(args)...);
+        }
+    };
+
+    template <class T, class U>
+    bool operator==(const polymorphic_allocator<T>& lhs, const polymorphic_allocator<U>& rhs) noexcept
+    {
+        return *lhs.resource() == *rhs.resource();
+    }
+
+    template <class T, class U>
+    bool operator!=(const polymorphic_allocator<T>& lhs, const polymorphic_allocator<U>& rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
+
+} // namespace pmr
+} // namespace mySTL
+
+#endif // !MYSTL_MEMORY_RESOURCE_H_
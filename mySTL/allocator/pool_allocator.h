@@ -0,0 +1,282 @@
+#ifndef MYSTL_POOL_ALLOCATOR_H_
+#define MYSTL_POOL_ALLOCATOR_H_
+
+//  这个头文件包含 node_pool 与模板类 pool_allocator
+//  node_pool 把小块内存按 8 字节分级，每一级从大块内存（slab）中切出固定大小的槽位，
+//  释放的槽位挂回该级的空闲链表，不归还给系统
+//  pool_allocator 把单个对象的分配交给 node_pool，适合 list / rb_tree / hashtable 的节点：
+//    mySTL::map<int, int, mySTL::less<int>, mySTL::pool_allocator<mySTL::pair<const int, int>>> m;
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <thread>
+
+#include "construct.h"
+#include "../iterator/type_traits.h"
+
+namespace mySTL
+{
+    /*
+    类：node_pool
+    全局的分级内存池，每一级使用独立的自旋锁，不同大小的节点互不影响
+     */
+    class node_pool
+    {
+    public:
+        enum
+        {
+            POOL_ALIGN = 8,         // 槽位大小按 8 字节对齐
+            POOL_MAX_BYTES = 256,   // 超过该大小的请求不进入内存池
+            POOL_CLASSES = POOL_MAX_BYTES / POOL_ALIGN,
+            POOL_SLAB_BYTES = 16384 // 每次向系统申请的 slab 大小
+        };
+
+        // 空闲槽位通过自身的前 8 字节串成链表
+        struct free_node
+        {
+            free_node* next;
+        };
+
+    private:
+        // slab 头部，用来把所有 slab 串起来
+        struct slab_header
+        {
+            slab_header* next;
+            std::size_t  pad;
+        };
+
+        struct size_class
+        {
+            std::atomic_flag lock = ATOMIC_FLAG_INIT;
+            free_node*   free_list = nullptr; // 已回收的槽位
+            char*        cur = nullptr;       // 当前 slab 中尚未切分的位置
+            char*        end = nullptr;
+            slab_header* slabs = nullptr;
+        };
+
+        size_class classes_[POOL_CLASSES];
+
+    public:
+        node_pool() = default;
+        node_pool(const node_pool&) = delete;
+        node_pool& operator=(const node_pool&) = delete;
+
+        // 内存池在进程结束前一直存在，节点的生命期可以长于任何静态对象
+        static node_pool& instance()
+        {
+            static node_pool* pool = new node_pool;
+            return *pool;
+        }
+
+        static constexpr bool is_pooled(std::size_t bytes, std::size_t align) noexcept
+        {
+            return bytes != 0 && bytes <= POOL_MAX_BYTES && align <= POOL_ALIGN;
+        }
+
+        void* allocate(std::size_t bytes)
+        {
+            const std::size_t index = class_index(bytes);
+            size_class& sc = classes_[index];
+            lock(sc);
+            void* p = nullptr;
+            if (sc.free_list != nullptr)
+            {
+                p = sc.free_list;
+                sc.free_list = sc.free_list->next;
+            }
+            else
+            {
+                const std::size_t slot = (index + 1) * POOL_ALIGN;
+                if (static_cast<std::size_t>(sc.end - sc.cur) < slot)
+                {
+                    try
+                    {
+                        refill(sc);
+                    }
+                    catch (...)
+                    {
+                        unlock(sc);
+                        throw;
+                    }
+                }
+                p = sc.cur;
+                sc.cur += slot;
+            }
+            unlock(sc);
+            return p;
+        }
+
+        void deallocate(void* p, std::size_t bytes) noexcept
+        {
+            size_class& sc = classes_[class_index(bytes)];
+            free_node* node = static_cast<free_node*>(p);
+            lock(sc);
+            node->next = sc.free_list;
+            sc.free_list = node;
+            unlock(sc);
+        }
+
+        // 一次取出 n 个槽位串成链表，只加一次锁，供线程缓存批量补充
+        free_node* allocate_batch(std::size_t bytes, std::size_t n)
+        {
+            const std::size_t index = class_index(bytes);
+            const std::size_t slot = (index + 1) * POOL_ALIGN;
+            size_class& sc = classes_[index];
+            free_node* head = nullptr;
+            lock(sc);
+            while (n > 0 && sc.free_list != nullptr)
+            {
+                free_node* node = sc.free_list;
+                sc.free_list = node->next;
+                node->next = head;
+                head = node;
+                --n;
+            }
+            if (n > 0 && static_cast<std::size_t>(sc.end - sc.cur) < slot)
+            {
+                try
+                {
+                    refill(sc);
+                }
+                catch (...)
+                {
+                    // 已经取出的槽位仍然可以使用
+                    unlock(sc);
+                    if (head == nullptr)
+                    {
+                        throw;
+                    }
+                    return head;
+                }
+            }
+            for (; n > 0 && static_cast<std::size_t>(sc.end - sc.cur) >= slot; --n)
+            {
+                free_node* node = reinterpret_cast<free_node*>(sc.cur);
+                sc.cur += slot;
+                node->next = head;
+                head = node;
+            }
+            unlock(sc);
+            return head;
+        }
+
+        // 把 [first, last] 串成的链表一次归还
+        void deallocate_batch(free_node* first, free_node* last, std::size_t bytes) noexcept
+        {
+            size_class& sc = classes_[class_index(bytes)];
+            lock(sc);
+            last->next = sc.free_list;
+            sc.free_list = first;
+            unlock(sc);
+        }
+
+        static std::size_t class_index(std::size_t bytes) noexcept
+        {
+            return (bytes + POOL_ALIGN - 1) / POOL_ALIGN - 1;
+        }
+
+    private:
+        static void lock(size_class& sc) noexcept
+        {
+            while (sc.lock.test_and_set(std::memory_order_acquire))
+                std::this_thread::yield();
+        }
+
+        static void unlock(size_class& sc) noexcept
+        {
+            sc.lock.clear(std::memory_order_release);
+        }
+
+        // 申请新的 slab，上一个 slab 剩余不足一个槽位的尾部直接丢弃
+        static void refill(size_class& sc)
+        {
+            char* mem = static_cast<char*>(::operator new(POOL_SLAB_BYTES));
+            slab_header* header = reinterpret_cast<slab_header*>(mem);
+            header->next = sc.slabs;
+            sc.slabs = header;
+            sc.cur = mem + sizeof(slab_header);
+            sc.end = mem + POOL_SLAB_BYTES;
+        }
+    };
+
+    /*
+    模板类：pool_allocator
+    单个对象的分配使用 node_pool，批量分配（如 vector、deque 的 map）仍然使用 ::operator new
+     */
+    template <class T>
+    class pool_allocator
+    {
+    public:
+        typedef T           value_type;
+        typedef T*          pointer;
+        typedef const T*    const_pointer;
+        typedef T&          reference;
+        typedef const T&    const_reference;
+        typedef size_t      size_type;
+        typedef ptrdiff_t   difference_type;
+
+        // 所有实例共享同一个 node_pool，因此总是相等
+        typedef m_true_type propagate_on_container_move_assignment;
+        typedef m_true_type is_always_equal;
+
+        template <class U>
+        struct rebind
+        {
+            typedef pool_allocator<U> other;
+        };
+
+    public:
+        pool_allocator() noexcept = default;
+        pool_allocator(const pool_allocator&) noexcept = default;
+        template <class U>
+        pool_allocator(const pool_allocator<U>&) noexcept {}
+
+        static T* allocate(size_type n);
+        static void deallocate(T* ptr, size_type n) noexcept;
+    };
+
+    template <class T>
+    T* pool_allocator<T>::allocate(size_type n)
+    {
+        if (n == 0)
+        {
+            return nullptr;
+        }
+        if (n == 1 && node_pool::is_pooled(sizeof(T), alignof(T)))
+        {
+            return static_cast<T*>(node_pool::instance().allocate(sizeof(T)));
+        }
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    template <class T>
+    void pool_allocator<T>::deallocate(T* ptr, size_type n) noexcept
+    {
+        if (ptr == nullptr)
+        {
+            return;
+        }
+        if (n == 1 && node_pool::is_pooled(sizeof(T), alignof(T)))
+        {
+            node_pool::instance().deallocate(ptr, sizeof(T));
+            return;
+        }
+        ::operator delete(ptr);
+    }
+
+    template <class T, class U>
+    bool operator==(const pool_allocator<T>&, const pool_allocator<U>&) noexcept
+    {
+        return true;
+    }
+
+    template <class T, class U>
+    bool operator!=(const pool_allocator<T>&, const pool_allocator<U>&) noexcept
+    {
+        return false;
+    }
+
+}
+
+#endif // !MYSTL_POOL_ALLOCATOR_H_
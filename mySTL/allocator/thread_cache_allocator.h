@@ -0,0 +1,232 @@
+#ifndef MYSTL_THREAD_CACHE_ALLOCATOR_H_
+#define MYSTL_THREAD_CACHE_ALLOCATOR_H_
+
+//  这个头文件包含 thread_cache 与模板类 thread_cache_allocator
+//  每个线程为每一级槽位保存一个本地空闲链表，分配与释放在本线程内完成，不需要加锁；
+//  本地链表为空时从 node_pool 批量取出一批槽位，过长时把一批槽位还给 node_pool
+//  槽位不属于任何线程，由 A 线程分配、B 线程释放的节点进入 B 的本地链表，
+//  再以批量的方式回到 node_pool，供 A 重新取用：
+//    mySTL::list<int, mySTL::thread_cache_allocator<int>> l;
+
+#include <cstddef>
+
+#include "pool_allocator.h"
+#include "../iterator/type_traits.h"
+
+namespace mySTL
+{
+    /*
+    类：thread_cache
+    线程本地的槽位缓存，线程退出时把所有槽位还给 node_pool
+     */
+    class thread_cache
+    {
+    private:
+        typedef node_pool::free_node free_node;
+
+        static constexpr std::size_t CACHE_BATCH_BYTES = 4096;  // 每次与 node_pool 交换的字节数
+        static constexpr std::size_t CACHE_MIN_BATCH = 4;
+        static constexpr std::size_t CACHE_MAX_BATCH = 64;
+
+        struct cache_class
+        {
+            free_node*  head = nullptr;
+            std::size_t count = 0;
+        };
+
+        cache_class classes_[node_pool::POOL_CLASSES];
+        bool*       destroyed_;
+
+    public:
+        explicit thread_cache(bool* destroyed) noexcept
+            : destroyed_(destroyed) {}
+
+        thread_cache(const thread_cache&) = delete;
+        thread_cache& operator=(const thread_cache&) = delete;
+
+        ~thread_cache()
+        {
+            for (std::size_t i = 0; i < node_pool::POOL_CLASSES; ++i)
+            {
+                release(i, classes_[i].count);
+            }
+            *destroyed_ = true;
+        }
+
+        // 当前线程的缓存；线程局部对象析构之后（如静态对象析构时）返回空指针
+        static thread_cache* local()
+        {
+            static thread_local bool destroyed = false;
+            if (destroyed)
+            {
+                return nullptr;
+            }
+            static thread_local thread_cache cache(&destroyed);
+            return &cache;
+        }
+
+        void* allocate(std::size_t bytes)
+        {
+            const std::size_t index = node_pool::class_index(bytes);
+            cache_class& cc = classes_[index];
+            if (cc.head == nullptr)
+            {
+                fetch(index);
+            }
+            free_node* node = cc.head;
+            cc.head = node->next;
+            --cc.count;
+            return node;
+        }
+
+        // 本地链表超过两批时归还一批，避免只释放不分配的线程囤积槽位
+        void deallocate(void* p, std::size_t bytes) noexcept
+        {
+            const std::size_t index = node_pool::class_index(bytes);
+            cache_class& cc = classes_[index];
+            free_node* node = static_cast<free_node*>(p);
+            node->next = cc.head;
+            cc.head = node;
+            if (++cc.count >= 2 * batch_size(index))
+            {
+                release(index, batch_size(index));
+            }
+        }
+
+    private:
+        // 小槽位一批多取一些，大槽位少取一些，每批大约 CACHE_BATCH_BYTES 字节
+        static std::size_t batch_size(std::size_t index) noexcept
+        {
+            const std::size_t n = CACHE_BATCH_BYTES / ((index + 1) * node_pool::POOL_ALIGN);
+            if (n < CACHE_MIN_BATCH)
+                return CACHE_MIN_BATCH;
+            if (n > CACHE_MAX_BATCH)
+                return CACHE_MAX_BATCH;
+            return n;
+        }
+
+        void fetch(std::size_t index)
+        {
+            const std::size_t bytes = (index + 1) * node_pool::POOL_ALIGN;
+            free_node* head = node_pool::instance().allocate_batch(bytes, batch_size(index));
+            cache_class& cc = classes_[index];
+            for (free_node* node = head; node != nullptr; node = node->next)
+            {
+                ++cc.count;
+            }
+            cc.head = head;
+        }
+
+        // 从本地链表头部取下 n 个槽位还给 node_pool
+        void release(std::size_t index, std::size_t n) noexcept
+        {
+            cache_class& cc = classes_[index];
+            if (n == 0 || cc.head == nullptr)
+            {
+                return;
+            }
+            free_node* first = cc.head;
+            free_node* last = first;
+            std::size_t taken = 1;
+            for (; taken < n && last->next != nullptr; ++taken)
+            {
+                last = last->next;
+            }
+            cc.head = last->next;
+            cc.count -= taken;
+            node_pool::instance().deallocate_batch(first, last, (index + 1) * node_pool::POOL_ALIGN);
+        }
+    };
+
+    /*
+    模板类：thread_cache_allocator
+    与 pool_allocator 共用 node_pool，单个对象的分配先经过线程本地缓存，
+    批量分配（如 vector、deque 的 map）仍然使用 ::operator new
+     */
+    template <class T>
+    class thread_cache_allocator
+    {
+    public:
+        typedef T           value_type;
+        typedef T*          pointer;
+        typedef const T*    const_pointer;
+        typedef T&          reference;
+        typedef const T&    const_reference;
+        typedef size_t      size_type;
+        typedef ptrdiff_t   difference_type;
+
+        // 所有线程共享同一个 node_pool，任一线程都可以释放其他线程分配的节点
+        typedef m_true_type propagate_on_container_move_assignment;
+        typedef m_true_type is_always_equal;
+
+        template <class U>
+        struct rebind
+        {
+            typedef thread_cache_allocator<U> other;
+        };
+
+    public:
+        thread_cache_allocator() noexcept = default;
+        thread_cache_allocator(const thread_cache_allocator&) noexcept = default;
+        template <class U>
+        thread_cache_allocator(const thread_cache_allocator<U>&) noexcept {}
+
+        static T* allocate(size_type n);
+        static void deallocate(T* ptr, size_type n) noexcept;
+    };
+
+    template <class T>
+    T* thread_cache_allocator<T>::allocate(size_type n)
+    {
+        if (n == 0)
+        {
+            return nullptr;
+        }
+        if (n == 1 && node_pool::is_pooled(sizeof(T), alignof(T)))
+        {
+            thread_cache* cache = thread_cache::local();
+            if (cache != nullptr)
+            {
+                return static_cast<T*>(cache->allocate(sizeof(T)));
+            }
+            return static_cast<T*>(node_pool::instance().allocate(sizeof(T)));
+        }
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    template <class T>
+    void thread_cache_allocator<T>::deallocate(T* ptr, size_type n) noexcept
+    {
+        if (ptr == nullptr)
+        {
+            return;
+        }
+        if (n == 1 && node_pool::is_pooled(sizeof(T), alignof(T)))
+        {
+            thread_cache* cache = thread_cache::local();
+            if (cache != nullptr)
+            {
+                cache->deallocate(ptr, sizeof(T));
+                return;
+            }
+            node_pool::instance().deallocate(ptr, sizeof(T));
+            return;
+        }
+        ::operator delete(ptr);
+    }
+
+    template <class T, class U>
+    bool operator==(const thread_cache_allocator<T>&, const thread_cache_allocator<U>&) noexcept
+    {
+        return true;
+    }
+
+    template <class T, class U>
+    bool operator!=(const thread_cache_allocator<T>&, const thread_cache_allocator<U>&) noexcept
+    {
+        return false;
+    }
+
+}
+
+#endif // !MYSTL_THREAD_CACHE_ALLOCATOR_H_
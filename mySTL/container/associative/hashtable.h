@@ -102,13 +102,13 @@ namespace mySTL
 
   // forward declaration
 
-  template <class T, class HashFun, class KeyEqual>
+  template <class T, class HashFun, class KeyEqual, class Alloc>
   class hashtable;
 
-  template <class T, class HashFun, class KeyEqual>
+  template <class T, class HashFun, class KeyEqual, class Alloc>
   struct ht_iterator;
 
-  template <class T, class HashFun, class KeyEqual>
+  template <class T, class HashFun, class KeyEqual, class Alloc>
   struct ht_const_iterator;
 
   template <class T>
@@ -119,13 +119,13 @@ namespace mySTL
 
   // ht_iterator
 
-  template <class T, class Hash, class KeyEqual>
+  template <class T, class Hash, class KeyEqual, class Alloc>
   struct ht_iterator_base : public mySTL::iterator<mySTL::forward_iterator_tag, T>
   {
-    typedef mySTL::hashtable<T, Hash, KeyEqual> hashtable;
-    typedef ht_iterator_base<T, Hash, KeyEqual> base;
-    typedef mySTL::ht_iterator<T, Hash, KeyEqual> iterator;
-    typedef mySTL::ht_const_iterator<T, Hash, KeyEqual> const_iterator;
+    typedef mySTL::hashtable<T, Hash, KeyEqual, Alloc> hashtable;
+    typedef ht_iterator_base<T, Hash, KeyEqual, Alloc> base;
+    typedef mySTL::ht_iterator<T, Hash, KeyEqual, Alloc> iterator;
+    typedef mySTL::ht_const_iterator<T, Hash, KeyEqual, Alloc> const_iterator;
     typedef hashtable_node<T> *node_ptr;
     typedef hashtable *contain_ptr;
     typedef const node_ptr const_node_ptr;
@@ -143,10 +143,10 @@ namespace mySTL
     bool operator!=(const base &rhs) const { return node != rhs.node; }
   };
 
-  template <class T, class Hash, class KeyEqual>
-  struct ht_iterator : public ht_iterator_base<T, Hash, KeyEqual>
+  template <class T, class Hash, class KeyEqual, class Alloc>
+  struct ht_iterator : public ht_iterator_base<T, Hash, KeyEqual, Alloc>
   {
-    typedef ht_iterator_base<T, Hash, KeyEqual> base;
+    typedef ht_iterator_base<T, Hash, KeyEqual, Alloc> base;
     typedef typename base::hashtable hashtable;
     typedef typename base::iterator iterator;
     typedef typename base::const_iterator const_iterator;
@@ -221,10 +221,10 @@ namespace mySTL
     }
   };
 
-  template <class T, class Hash, class KeyEqual>
-  struct ht_const_iterator : public ht_iterator_base<T, Hash, KeyEqual>
+  template <class T, class Hash, class KeyEqual, class Alloc>
+  struct ht_const_iterator : public ht_iterator_base<T, Hash, KeyEqual, Alloc>
   {
-    typedef ht_iterator_base<T, Hash, KeyEqual> base;
+    typedef ht_iterator_base<T, Hash, KeyEqual, Alloc> base;
     typedef typename base::hashtable hashtable;
     typedef typename base::iterator iterator;
     typedef typename base::const_iterator const_iterator;
@@ -506,13 +506,14 @@ namespace mySTL
   }
 
   // 模板类 hashtable
-  // 参数一代表数据类型，参数二代表哈希函数，参数三代表键值相等的比较函数
-  template <class T, class Hash, class KeyEqual>
+  // 参数一代表数据类型，参数二代表哈希函数，参数三代表键值相等的比较函数，参数四代表空间配置器类型
+  template <class T, class Hash, class KeyEqual, class Alloc>
   class hashtable
+      : private mySTL::alloc_holder<typename mySTL::allocator_traits<Alloc>::template rebind_alloc<hashtable_node<T>>>
   {
 
-    friend struct mySTL::ht_iterator<T, Hash, KeyEqual>;
-    friend struct mySTL::ht_const_iterator<T, Hash, KeyEqual>;
+    friend struct mySTL::ht_iterator<T, Hash, KeyEqual, Alloc>;
+    friend struct mySTL::ht_const_iterator<T, Hash, KeyEqual, Alloc>;
 
   public:
     // hashtable 的型别定义
@@ -525,27 +526,31 @@ namespace mySTL
 
     typedef hashtable_node<T> node_type;
     typedef node_type *node_ptr;
-    typedef mySTL::vector<node_ptr> bucket_type;
 
-    typedef mySTL::allocator<T> allocator_type;
-    typedef mySTL::allocator<T> data_allocator;
-    typedef mySTL::allocator<node_type> node_allocator;
+    typedef Alloc allocator_type;
+    typedef mySTL::allocator_traits<Alloc> data_alloc_traits;
+    typedef typename data_alloc_traits::template rebind_alloc<node_type> node_allocator;
+    typedef typename data_alloc_traits::template rebind_alloc<node_ptr> bucket_allocator;
+    typedef mySTL::allocator_traits<node_allocator> node_alloc_traits;
+    typedef mySTL::vector<node_ptr, bucket_allocator> bucket_type;
 
-    typedef typename allocator_type::pointer pointer;
-    typedef typename allocator_type::const_pointer const_pointer;
-    typedef typename allocator_type::reference reference;
-    typedef typename allocator_type::const_reference const_reference;
-    typedef typename allocator_type::size_type size_type;
-    typedef typename allocator_type::difference_type difference_type;
+    typedef typename data_alloc_traits::pointer pointer;
+    typedef typename data_alloc_traits::const_pointer const_pointer;
+    typedef value_type &reference;
+    typedef const value_type &const_reference;
+    typedef typename data_alloc_traits::size_type size_type;
+    typedef typename data_alloc_traits::difference_type difference_type;
 
-    typedef mySTL::ht_iterator<T, Hash, KeyEqual> iterator;
-    typedef mySTL::ht_const_iterator<T, Hash, KeyEqual> const_iterator;
+    typedef mySTL::ht_iterator<T, Hash, KeyEqual, Alloc> iterator;
+    typedef mySTL::ht_const_iterator<T, Hash, KeyEqual, Alloc> const_iterator;
     typedef mySTL::ht_local_iterator<T> local_iterator;
     typedef mySTL::ht_const_local_iterator<T> const_local_iterator;
 
-    allocator_type get_allocator() const { return allocator_type(); }
+    allocator_type get_allocator() const { return allocator_type(this->alloc_ref()); }
 
   private:
+    typedef mySTL::alloc_holder<node_allocator> alloc_base;
+
     // 用以下六个参数来表现 hashtable
     bucket_type buckets_;
     size_type bucket_size_;
@@ -594,8 +599,10 @@ namespace mySTL
     // 构造、复制、移动、析构函数
     explicit hashtable(size_type bucket_count,
                        const Hash &hash = Hash(),
-                       const KeyEqual &equal = KeyEqual())
-        : size_(0), mlf_(1.0f), hash_(hash), equal_(equal)
+                       const KeyEqual &equal = KeyEqual(),
+                       const allocator_type &alloc = allocator_type())
+        : alloc_base(node_allocator(alloc)), buckets_(bucket_allocator(alloc)),
+          size_(0), mlf_(1.0f), hash_(hash), equal_(equal)
     {
       init(bucket_count);
     }
@@ -605,32 +612,46 @@ namespace mySTL
     hashtable(Iter first, Iter last,
               size_type bucket_count,
               const Hash &hash = Hash(),
-              const KeyEqual &equal = KeyEqual())
-        : size_(mySTL::distance(first, last)), mlf_(1.0f), hash_(hash), equal_(equal)
+              const KeyEqual &equal = KeyEqual(),
+              const allocator_type &alloc = allocator_type())
+        : alloc_base(node_allocator(alloc)), buckets_(bucket_allocator(alloc)),
+          size_(mySTL::distance(first, last)), mlf_(1.0f), hash_(hash), equal_(equal)
     {
       init(mySTL::max(bucket_count, static_cast<size_type>(mySTL::distance(first, last))));
     }
 
     hashtable(const hashtable &rhs)
-        : hash_(rhs.hash_), equal_(rhs.equal_)
+        : alloc_base(node_alloc_traits::select_on_container_copy_construction(rhs.alloc_ref())),
+          buckets_(bucket_allocator(this->alloc_ref())),
+          hash_(rhs.hash_), equal_(rhs.equal_)
+    {
+      copy_init(rhs);
+    }
+    hashtable(const hashtable &rhs, const allocator_type &alloc)
+        : alloc_base(node_allocator(alloc)), buckets_(bucket_allocator(alloc)),
+          hash_(rhs.hash_), equal_(rhs.equal_)
     {
       copy_init(rhs);
     }
     hashtable(hashtable &&rhs) noexcept
-        : bucket_size_(rhs.bucket_size_),
+        : alloc_base(mySTL::move(rhs.alloc_ref())),
+          buckets_(mySTL::move(rhs.buckets_)),
+          bucket_size_(rhs.bucket_size_),
           size_(rhs.size_),
           mlf_(rhs.mlf_),
           hash_(rhs.hash_),
           equal_(rhs.equal_)
     {
-      buckets_ = mySTL::move(rhs.buckets_);
       rhs.bucket_size_ = 0;
       rhs.size_ = 0;
       rhs.mlf_ = 0.0f;
     }
+    hashtable(hashtable &&rhs, const allocator_type &alloc);
 
     hashtable &operator=(const hashtable &rhs);
-    hashtable &operator=(hashtable &&rhs) noexcept;
+    hashtable &operator=(hashtable &&rhs) noexcept(
+        node_alloc_traits::propagate_on_container_move_assignment::value ||
+        node_alloc_traits::is_always_equal::value);
 
     ~hashtable() { clear(); }
 
@@ -853,6 +874,8 @@ namespace mySTL
     // init
     void init(size_type n);
     void copy_init(const hashtable &ht);
+    void move_init(hashtable &ht);
+    void move_data(hashtable &ht) noexcept;
 
     // node
     template <class... Args>
@@ -891,37 +914,69 @@ namespace mySTL
 
   /*****************************************************************************************/
 
+  // 使用指定分配器的移动构造函数，分配器不相等时逐个移动元素
+  template <class T, class Hash, class KeyEqual, class Alloc>
+  hashtable<T, Hash, KeyEqual, Alloc>::
+      hashtable(hashtable &&rhs, const allocator_type &alloc)
+      : alloc_base(node_allocator(alloc)), buckets_(bucket_allocator(alloc)),
+        bucket_size_(0), size_(0), mlf_(rhs.mlf_), hash_(rhs.hash_), equal_(rhs.equal_)
+  {
+    if (mySTL::alloc_equal(this->alloc_ref(), rhs.alloc_ref()))
+    {
+      buckets_.swap(rhs.buckets_);
+      bucket_size_ = rhs.bucket_size_;
+      size_ = rhs.size_;
+      rhs.bucket_size_ = 0;
+      rhs.size_ = 0;
+    }
+    else
+    {
+      move_init(rhs);
+    }
+  }
+
   // 复制赋值运算符
-  template <class T, class Hash, class KeyEqual>
-  hashtable<T, Hash, KeyEqual> &
-  hashtable<T, Hash, KeyEqual>::
+  template <class T, class Hash, class KeyEqual, class Alloc>
+  hashtable<T, Hash, KeyEqual, Alloc> &
+  hashtable<T, Hash, KeyEqual, Alloc>::
   operator=(const hashtable &rhs)
   {
     if (this != &rhs)
     {
-      hashtable tmp(rhs);
-      swap(tmp);
+      typedef typename node_alloc_traits::propagate_on_container_copy_assignment pocca;
+      clear();
+      mySTL::alloc_copy_assign(this->alloc_ref(), rhs.alloc_ref(), pocca());
+      hashtable tmp(rhs, get_allocator());
+      move_data(tmp);
     }
     return *this;
   }
 
   // 移动赋值运算符
-  template <class T, class Hash, class KeyEqual>
-  hashtable<T, Hash, KeyEqual> &
-  hashtable<T, Hash, KeyEqual>::
-  operator=(hashtable &&rhs) noexcept
+  template <class T, class Hash, class KeyEqual, class Alloc>
+  hashtable<T, Hash, KeyEqual, Alloc> &
+  hashtable<T, Hash, KeyEqual, Alloc>::
+  operator=(hashtable &&rhs) noexcept(
+      node_alloc_traits::propagate_on_container_move_assignment::value ||
+      node_alloc_traits::is_always_equal::value)
   {
-    hashtable tmp(mySTL::move(rhs));
-    swap(tmp);
+    if (this != &rhs)
+    {
+      typedef typename node_alloc_traits::propagate_on_container_move_assignment pocma;
+      clear();
+      mySTL::alloc_move_assign(this->alloc_ref(), rhs.alloc_ref(), pocma());
+      hashtable tmp(mySTL::move(rhs), get_allocator());
+      move_data(tmp);
+    }
     return *this;
   }
 
   // 就地构造元素，键值允许重复
   // 强异常安全保证
-  template <class T, class Hash, class KeyEqual>
+  template <class T, class Hash, class KeyEqual, class Alloc>
   template <class... Args>
-  typename hashtable<T, Hash, KeyEqual>::iterator
-  hashtable<T, Hash, KeyEqual>::
+  typename hashtable<T, Hash, KeyEqual, Alloc>::iterator
+  hashtable<T, Hash, KeyEqual, Alloc>::
       emplace_multi(Args &&...args)
   {
     auto np = create_node(mySTL::forward<Args>(args)...);
@@ -940,10 +995,10 @@ namespace mySTL
 
   // 就地构造元素，键值允许重复
   // 强异常安全保证
-  template <class T, class Hash, class KeyEqual>
+  template <class T, class Hash, class KeyEqual, class Alloc>
   template <class... Args>
-  pair<typename hashtable<T, Hash, KeyEqual>::iterator, bool>
-  hashtable<T, Hash, KeyEqual>::
+  pair<typename hashtable<T, Hash, KeyEqual, Alloc>::iterator, bool>
+  hashtable<T, Hash, KeyEqual, Alloc>::
       emplace_unique(Args &&...args)
   {
     auto np = create_node(mySTL::forward<Args>(args)...);
@@ -961,9 +1016,9 @@ namespace mySTL
   }
 
   // 在不需要重建表格的情况下插入新节点，键值不允许重复
-  template <class T, class Hash, class KeyEqual>
-  pair<typename hashtable<T, Hash, KeyEqual>::iterator, bool>
-  hashtable<T, Hash, KeyEqual>::
+  template <class T, class Hash, class KeyEqual, class Alloc>
+  pair<typename hashtable<T, Hash, KeyEqual, Alloc>::iterator, bool>
+  hashtable<T, Hash, KeyEqual, Alloc>::
       insert_unique_noresize(const value_type &value)
   {
     const auto n = hash(value_traits::get_key(value));
@@ -982,9 +1037,9 @@ namespace mySTL
   }
 
   // 在不需要重建表格的情况下插入新节点，键值允许重复
-  template <class T, class Hash, class KeyEqual>
-  typename hashtable<T, Hash, KeyEqual>::iterator
-  hashtable<T, Hash, KeyEqual>::
+  template <class T, class Hash, class KeyEqual, class Alloc>
+  typename hashtable<T, Hash, KeyEqual, Alloc>::iterator
+  hashtable<T, Hash, KeyEqual, Alloc>::
       insert_multi_noresize(const value_type &value)
   {
     const auto n = hash(value_traits::get_key(value));
@@ -1008,8 +1063,8 @@ namespace mySTL
   }
 
   // 删除迭代器所指的节点
-  template <class T, class Hash, class KeyEqual>
-  void hashtable<T, Hash, KeyEqual>::
+  template <class T, class Hash, class KeyEqual, class Alloc>
+  void hashtable<T, Hash, KeyEqual, Alloc>::
       erase(const_iterator position)
   {
     auto p = position.node;
@@ -1046,8 +1101,8 @@ namespace mySTL
   }
 
   // 删除[first, last)内的节点
-  template <class T, class Hash, class KeyEqual>
-  void hashtable<T, Hash, KeyEqual>::
+  template <class T, class Hash, class KeyEqual, class Alloc>
+  void hashtable<T, Hash, KeyEqual, Alloc>::
       erase(const_iterator first, const_iterator last)
   {
     if (first.node == last.node)
@@ -1078,9 +1133,9 @@ namespace mySTL
   }
 
   // 删除键值为 key 的节点
-  template <class T, class Hash, class KeyEqual>
-  typename hashtable<T, Hash, KeyEqual>::size_type
-  hashtable<T, Hash, KeyEqual>::
+  template <class T, class Hash, class KeyEqual, class Alloc>
+  typename hashtable<T, Hash, KeyEqual, Alloc>::size_type
+  hashtable<T, Hash, KeyEqual, Alloc>::
       erase_multi(const key_type &key)
   {
     auto p = equal_range_multi(key);
@@ -1092,9 +1147,9 @@ namespace mySTL
     return 0;
   }
 
-  template <class T, class Hash, class KeyEqual>
-  typename hashtable<T, Hash, KeyEqual>::size_type
-  hashtable<T, Hash, KeyEqual>::
+  template <class T, class Hash, class KeyEqual, class Alloc>
+  typename hashtable<T, Hash, KeyEqual, Alloc>::size_type
+  hashtable<T, Hash, KeyEqual, Alloc>::
       erase_unique(const key_type &key)
   {
     const auto n = hash(key);
@@ -1129,8 +1184,8 @@ namespace mySTL
   }
 
   // 清空 hashtable
-  template <class T, class Hash, class KeyEqual>
-  void hashtable<T, Hash, KeyEqual>::
+  template <class T, class Hash, class KeyEqual, class Alloc>
+  void hashtable<T, Hash, KeyEqual, Alloc>::
       clear()
   {
     if (size_ != 0)
@@ -1151,9 +1206,9 @@ namespace mySTL
   }
 
   // 在某个 bucket 节点的个数
-  template <class T, class Hash, class KeyEqual>
-  typename hashtable<T, Hash, KeyEqual>::size_type
-  hashtable<T, Hash, KeyEqual>::
+  template <class T, class Hash, class KeyEqual, class Alloc>
+  typename hashtable<T, Hash, KeyEqual, Alloc>::size_type
+  hashtable<T, Hash, KeyEqual, Alloc>::
       bucket_size(size_type n) const noexcept
   {
     size_type result = 0;
@@ -1165,8 +1220,8 @@ namespace mySTL
   }
 
   // 重新对元素进行一遍哈希，插入到新的位置
-  template <class T, class Hash, class KeyEqual>
-  void hashtable<T, Hash, KeyEqual>::
+  template <class T, class Hash, class KeyEqual, class Alloc>
+  void hashtable<T, Hash, KeyEqual, Alloc>::
       rehash(size_type count)
   {
     auto n = ht_next_prime(count);
@@ -1185,9 +1240,9 @@ namespace mySTL
   }
 
   // 查找键值为 key 的节点，返回其迭代器
-  template <class T, class Hash, class KeyEqual>
-  typename hashtable<T, Hash, KeyEqual>::iterator
-  hashtable<T, Hash, KeyEqual>::
+  template <class T, class Hash, class KeyEqual, class Alloc>
+  typename hashtable<T, Hash, KeyEqual, Alloc>::iterator
+  hashtable<T, Hash, KeyEqual, Alloc>::
       find(const key_type &key)
   {
     const auto n = hash(key);
@@ -1198,9 +1253,9 @@ namespace mySTL
     return iterator(first, this);
   }
 
-  template <class T, class Hash, class KeyEqual>
-  typename hashtable<T, Hash, KeyEqual>::const_iterator
-  hashtable<T, Hash, KeyEqual>::
+  template <class T, class Hash, class KeyEqual, class Alloc>
+  typename hashtable<T, Hash, KeyEqual, Alloc>::const_iterator
+  hashtable<T, Hash, KeyEqual, Alloc>::
       find(const key_type &key) const
   {
     const auto n = hash(key);
@@ -1212,9 +1267,9 @@ namespace mySTL
   }
 
   // 查找键值为 key 出现的次数
-  template <class T, class Hash, class KeyEqual>
-  typename hashtable<T, Hash, KeyEqual>::size_type
-  hashtable<T, Hash, KeyEqual>::
+  template <class T, class Hash, class KeyEqual, class Alloc>
+  typename hashtable<T, Hash, KeyEqual, Alloc>::size_type
+  hashtable<T, Hash, KeyEqual, Alloc>::
       count(const key_type &key) const
   {
     const auto n = hash(key);
@@ -1228,10 +1283,10 @@ namespace mySTL
   }
 
   // 查找与键值 key 相等的区间，返回一个 pair，指向相等区间的首尾
-  template <class T, class Hash, class KeyEqual>
-  pair<typename hashtable<T, Hash, KeyEqual>::iterator,
-       typename hashtable<T, Hash, KeyEqual>::iterator>
-  hashtable<T, Hash, KeyEqual>::
+  template <class T, class Hash, class KeyEqual, class Alloc>
+  pair<typename hashtable<T, Hash, KeyEqual, Alloc>::iterator,
+       typename hashtable<T, Hash, KeyEqual, Alloc>::iterator>
+  hashtable<T, Hash, KeyEqual, Alloc>::
       equal_range_multi(const key_type &key)
   {
     const auto n = hash(key);
@@ -1255,10 +1310,10 @@ namespace mySTL
     return mySTL::make_pair(end(), end());
   }
 
-  template <class T, class Hash, class KeyEqual>
-  pair<typename hashtable<T, Hash, KeyEqual>::const_iterator,
-       typename hashtable<T, Hash, KeyEqual>::const_iterator>
-  hashtable<T, Hash, KeyEqual>::
+  template <class T, class Hash, class KeyEqual, class Alloc>
+  pair<typename hashtable<T, Hash, KeyEqual, Alloc>::const_iterator,
+       typename hashtable<T, Hash, KeyEqual, Alloc>::const_iterator>
+  hashtable<T, Hash, KeyEqual, Alloc>::
       equal_range_multi(const key_type &key) const
   {
     const auto n = hash(key);
@@ -1282,10 +1337,10 @@ namespace mySTL
     return mySTL::make_pair(cend(), cend());
   }
 
-  template <class T, class Hash, class KeyEqual>
-  pair<typename hashtable<T, Hash, KeyEqual>::iterator,
-       typename hashtable<T, Hash, KeyEqual>::iterator>
-  hashtable<T, Hash, KeyEqual>::
+  template <class T, class Hash, class KeyEqual, class Alloc>
+  pair<typename hashtable<T, Hash, KeyEqual, Alloc>::iterator,
+       typename hashtable<T, Hash, KeyEqual, Alloc>::iterator>
+  hashtable<T, Hash, KeyEqual, Alloc>::
       equal_range_unique(const key_type &key)
   {
     const auto n = hash(key);
@@ -1306,10 +1361,10 @@ namespace mySTL
     return mySTL::make_pair(end(), end());
   }
 
-  template <class T, class Hash, class KeyEqual>
-  pair<typename hashtable<T, Hash, KeyEqual>::const_iterator,
-       typename hashtable<T, Hash, KeyEqual>::const_iterator>
-  hashtable<T, Hash, KeyEqual>::
+  template <class T, class Hash, class KeyEqual, class Alloc>
+  pair<typename hashtable<T, Hash, KeyEqual, Alloc>::const_iterator,
+       typename hashtable<T, Hash, KeyEqual, Alloc>::const_iterator>
+  hashtable<T, Hash, KeyEqual, Alloc>::
       equal_range_unique(const key_type &key) const
   {
     const auto n = hash(key);
@@ -1331,12 +1386,15 @@ namespace mySTL
   }
 
   // 交换 hashtable
-  template <class T, class Hash, class KeyEqual>
-  void hashtable<T, Hash, KeyEqual>::
+  template <class T, class Hash, class KeyEqual, class Alloc>
+  void hashtable<T, Hash, KeyEqual, Alloc>::
       swap(hashtable &rhs) noexcept
   {
     if (this != &rhs)
     {
+      typedef typename node_alloc_traits::propagate_on_container_swap pocs;
+      MYSTL_DEBUG(pocs::value || mySTL::alloc_equal(this->alloc_ref(), rhs.alloc_ref()));
+      mySTL::alloc_swap(this->alloc_ref(), rhs.alloc_ref(), pocs());
       buckets_.swap(rhs.buckets_);
       mySTL::swap(bucket_size_, rhs.bucket_size_);
       mySTL::swap(size_, rhs.size_);
@@ -1350,8 +1408,8 @@ namespace mySTL
   // helper function
 
   // init 函数
-  template <class T, class Hash, class KeyEqual>
-  void hashtable<T, Hash, KeyEqual>::
+  template <class T, class Hash, class KeyEqual, class Alloc>
+  void hashtable<T, Hash, KeyEqual, Alloc>::
       init(size_type n)
   {
     const auto bucket_nums = next_size(n);
@@ -1370,8 +1428,8 @@ namespace mySTL
   }
 
   // copy_init 函数
-  template <class T, class Hash, class KeyEqual>
-  void hashtable<T, Hash, KeyEqual>::
+  template <class T, class Hash, class KeyEqual, class Alloc>
+  void hashtable<T, Hash, KeyEqual, Alloc>::
       copy_init(const hashtable &ht)
   {
     bucket_size_ = 0;
@@ -1401,68 +1459,116 @@ namespace mySTL
     catch (...)
     {
       clear();
+      throw;
     }
   }
 
+  // move_init 函数，分配器不相等时逐个移动 ht 的元素
+  template <class T, class Hash, class KeyEqual, class Alloc>
+  void hashtable<T, Hash, KeyEqual, Alloc>::
+      move_init(hashtable &ht)
+  {
+    bucket_size_ = 0;
+    buckets_.reserve(ht.bucket_size_);
+    buckets_.assign(ht.bucket_size_, nullptr);
+    try
+    {
+      for (size_type i = 0; i < ht.bucket_size_; ++i)
+      {
+        node_ptr *link = &buckets_[i];
+        for (auto cur = ht.buckets_[i]; cur; cur = cur->next)
+        {
+          *link = create_node(mySTL::move(cur->value));
+          link = &(*link)->next;
+          ++size_;
+        }
+        bucket_size_ = i + 1;
+      }
+      bucket_size_ = ht.bucket_size_;
+      mlf_ = ht.mlf_;
+    }
+    catch (...)
+    {
+      clear();
+      throw;
+    }
+    ht.clear();
+  }
+
+  // move_data 函数，接管 ht 的 bucket 与节点，调用前 *this 必须为空
+  template <class T, class Hash, class KeyEqual, class Alloc>
+  void hashtable<T, Hash, KeyEqual, Alloc>::
+      move_data(hashtable &ht) noexcept
+  {
+    buckets_ = mySTL::move(ht.buckets_);
+    bucket_size_ = ht.bucket_size_;
+    size_ = ht.size_;
+    mlf_ = ht.mlf_;
+    hash_ = ht.hash_;
+    equal_ = ht.equal_;
+    ht.bucket_size_ = 0;
+    ht.size_ = 0;
+  }
+
   // create_node 函数
-  template <class T, class Hash, class KeyEqual>
+  template <class T, class Hash, class KeyEqual, class Alloc>
   template <class... Args>
-  typename hashtable<T, Hash, KeyEqual>::node_ptr
-  hashtable<T, Hash, KeyEqual>::
+  typename hashtable<T, Hash, KeyEqual, Alloc>::node_ptr
+  hashtable<T, Hash, KeyEqual, Alloc>::
       create_node(Args &&...args)
   {
-    node_ptr tmp = node_allocator::allocate(1);
+    node_ptr tmp = node_alloc_traits::allocate(this->alloc_ref(), 1);
     try
     {
-      data_allocator::construct(mySTL::address_of(tmp->value), mySTL::forward<Args>(args)...);
+      node_alloc_traits::construct(this->alloc_ref(), mySTL::address_of(tmp->value), mySTL::forward<Args>(args)...);
       tmp->next = nullptr;
     }
     catch (...)
     {
-      node_allocator::deallocate(tmp);
+      node_alloc_traits::deallocate(this->alloc_ref(), tmp, 1);
       throw;
     }
     return tmp;
   }
 
   // destroy_node 函数
-  template <class T, class Hash, class KeyEqual>
-  void hashtable<T, Hash, KeyEqual>::
+  template <class T, class Hash, class KeyEqual, class Alloc>
+  void hashtable<T, Hash, KeyEqual, Alloc>::
       destroy_node(node_ptr node)
   {
-    data_allocator::destroy(mySTL::address_of(node->value));
-    node_allocator::deallocate(node);
+    node_alloc_traits::destroy(this->alloc_ref(), mySTL::address_of(node->value));
+    node_alloc_traits::deallocate(this->alloc_ref(), node, 1);
     node = nullptr;
   }
 
   // next_size 函数
-  template <class T, class Hash, class KeyEqual>
-  typename hashtable<T, Hash, KeyEqual>::size_type
-  hashtable<T, Hash, KeyEqual>::next_size(size_type n) const
+  template <class T, class Hash, class KeyEqual, class Alloc>
+  typename hashtable<T, Hash, KeyEqual, Alloc>::size_type
+  hashtable<T, Hash, KeyEqual, Alloc>::next_size(size_type n) const
   {
     return ht_next_prime(n);
   }
 
   // hash 函数
-  template <class T, class Hash, class KeyEqual>
-  typename hashtable<T, Hash, KeyEqual>::size_type
-  hashtable<T, Hash, KeyEqual>::
+  template <class T, class Hash, class KeyEqual, class Alloc>
+  typename hashtable<T, Hash, KeyEqual, Alloc>::size_type
+  hashtable<T, Hash, KeyEqual, Alloc>::
       hash(const key_type &key, size_type n) const
   {
     return hash_(key) % n;
   }
 
-  template <class T, class Hash, class KeyEqual>
-  typename hashtable<T, Hash, KeyEqual>::size_type
-  hashtable<T, Hash, KeyEqual>::
+  template <class T, class Hash, class KeyEqual, class Alloc>
+  typename hashtable<T, Hash, KeyEqual, Alloc>::size_type
+  hashtable<T, Hash, KeyEqual, Alloc>::
       hash(const key_type &key) const
   {
     return hash_(key) % bucket_size_;
   }
 
   // rehash_if_need 函数
-  template <class T, class Hash, class KeyEqual>
-  void hashtable<T, Hash, KeyEqual>::
+  template <class T, class Hash, class KeyEqual, class Alloc>
+  void hashtable<T, Hash, KeyEqual, Alloc>::
       rehash_if_need(size_type n)
   {
     if (static_cast<float>(size_ + n) > (float)bucket_size_ * max_load_factor())
@@ -1470,9 +1576,9 @@ namespace mySTL
   }
 
   // copy_insert
-  template <class T, class Hash, class KeyEqual>
+  template <class T, class Hash, class KeyEqual, class Alloc>
   template <class InputIter>
-  void hashtable<T, Hash, KeyEqual>::
+  void hashtable<T, Hash, KeyEqual, Alloc>::
       copy_insert_multi(InputIter first, InputIter last, mySTL::input_iterator_tag)
   {
     rehash_if_need(mySTL::distance(first, last));
@@ -1480,9 +1586,9 @@ namespace mySTL
       insert_multi_noresize(*first);
   }
 
-  template <class T, class Hash, class KeyEqual>
+  template <class T, class Hash, class KeyEqual, class Alloc>
   template <class ForwardIter>
-  void hashtable<T, Hash, KeyEqual>::
+  void hashtable<T, Hash, KeyEqual, Alloc>::
       copy_insert_multi(ForwardIter first, ForwardIter last, mySTL::forward_iterator_tag)
   {
     size_type n = mySTL::distance(first, last);
@@ -1491,9 +1597,9 @@ namespace mySTL
       insert_multi_noresize(*first);
   }
 
-  template <class T, class Hash, class KeyEqual>
+  template <class T, class Hash, class KeyEqual, class Alloc>
   template <class InputIter>
-  void hashtable<T, Hash, KeyEqual>::
+  void hashtable<T, Hash, KeyEqual, Alloc>::
       copy_insert_unique(InputIter first, InputIter last, mySTL::input_iterator_tag)
   {
     rehash_if_need(mySTL::distance(first, last));
@@ -1501,9 +1607,9 @@ namespace mySTL
       insert_unique_noresize(*first);
   }
 
-  template <class T, class Hash, class KeyEqual>
+  template <class T, class Hash, class KeyEqual, class Alloc>
   template <class ForwardIter>
-  void hashtable<T, Hash, KeyEqual>::
+  void hashtable<T, Hash, KeyEqual, Alloc>::
       copy_insert_unique(ForwardIter first, ForwardIter last, mySTL::forward_iterator_tag)
   {
     size_type n = mySTL::distance(first, last);
@@ -1513,9 +1619,9 @@ namespace mySTL
   }
 
   // insert_node 函数
-  template <class T, class Hash, class KeyEqual>
-  typename hashtable<T, Hash, KeyEqual>::iterator
-  hashtable<T, Hash, KeyEqual>::
+  template <class T, class Hash, class KeyEqual, class Alloc>
+  typename hashtable<T, Hash, KeyEqual, Alloc>::iterator
+  hashtable<T, Hash, KeyEqual, Alloc>::
       insert_node_multi(node_ptr np)
   {
     const auto n = hash(value_traits::get_key(np->value));
@@ -1543,9 +1649,9 @@ namespace mySTL
   }
 
   // insert_node_unique 函数
-  template <class T, class Hash, class KeyEqual>
-  pair<typename hashtable<T, Hash, KeyEqual>::iterator, bool>
-  hashtable<T, Hash, KeyEqual>::
+  template <class T, class Hash, class KeyEqual, class Alloc>
+  pair<typename hashtable<T, Hash, KeyEqual, Alloc>::iterator, bool>
+  hashtable<T, Hash, KeyEqual, Alloc>::
       insert_node_unique(node_ptr np)
   {
     const auto n = hash(value_traits::get_key(np->value));
@@ -1559,7 +1665,8 @@ namespace mySTL
     for (; cur; cur = cur->next)
     {
       if (is_equal(value_traits::get_key(cur->value), value_traits::get_key(np->value)))
-      {
+      { // 键值已存在，释放新建的节点
+        destroy_node(np);
         return mySTL::make_pair(iterator(cur, this), false);
       }
     }
@@ -1570,18 +1677,20 @@ namespace mySTL
   }
 
   // replace_bucket 函数
-  template <class T, class Hash, class KeyEqual>
-  void hashtable<T, Hash, KeyEqual>::
+  template <class T, class Hash, class KeyEqual, class Alloc>
+  void hashtable<T, Hash, KeyEqual, Alloc>::
       replace_bucket(size_type bucket_count)
   {
-    bucket_type bucket(bucket_count);
+    bucket_type bucket(bucket_count, nullptr, buckets_.get_allocator());
     if (size_ != 0)
     {
       for (size_type i = 0; i < bucket_size_; ++i)
       {
-        for (auto first = buckets_[i]; first; first = first->next)
-        {
-          auto tmp = create_node(first->value);
+        for (auto first = buckets_[i], next = first; first; first = next)
+        { // 直接把旧节点链接到新的 bucket 中
+          next = first->next;
+          auto tmp = first;
+          tmp->next = nullptr;
           const auto n = hash(value_traits::get_key(first->value), bucket_count);
           auto f = bucket[n];
           bool is_inserted = false;
@@ -1609,8 +1718,8 @@ namespace mySTL
 
   // erase_bucket 函数
   // 在第 n 个 bucket 内，删除 [first, last) 的节点
-  template <class T, class Hash, class KeyEqual>
-  void hashtable<T, Hash, KeyEqual>::
+  template <class T, class Hash, class KeyEqual, class Alloc>
+  void hashtable<T, Hash, KeyEqual, Alloc>::
       erase_bucket(size_type n, node_ptr first, node_ptr last)
   {
     auto cur = buckets_[n];
@@ -1636,8 +1745,8 @@ namespace mySTL
 
   // erase_bucket 函数
   // 在第 n 个 bucket 内，删除 [buckets_[n], last) 的节点
-  template <class T, class Hash, class KeyEqual>
-  void hashtable<T, Hash, KeyEqual>::
+  template <class T, class Hash, class KeyEqual, class Alloc>
+  void hashtable<T, Hash, KeyEqual, Alloc>::
       erase_bucket(size_type n, node_ptr last)
   {
     auto cur = buckets_[n];
@@ -1652,8 +1761,8 @@ namespace mySTL
   }
 
   // equal_to 函数
-  template <class T, class Hash, class KeyEqual>
-  bool hashtable<T, Hash, KeyEqual>::equal_to_multi(const hashtable &other)
+  template <class T, class Hash, class KeyEqual, class Alloc>
+  bool hashtable<T, Hash, KeyEqual, Alloc>::equal_to_multi(const hashtable &other)
   {
     if (size_ != other.size_)
       return false;
@@ -1669,8 +1778,8 @@ namespace mySTL
     return true;
   }
 
-  template <class T, class Hash, class KeyEqual>
-  bool hashtable<T, Hash, KeyEqual>::equal_to_unique(const hashtable &other)
+  template <class T, class Hash, class KeyEqual, class Alloc>
+  bool hashtable<T, Hash, KeyEqual, Alloc>::equal_to_unique(const hashtable &other)
   {
     if (size_ != other.size_)
       return false;
@@ -1684,9 +1793,9 @@ namespace mySTL
   }
 
   // 重载 mySTL 的 swap
-  template <class T, class Hash, class KeyEqual>
-  void swap(hashtable<T, Hash, KeyEqual> &lhs,
-            hashtable<T, Hash, KeyEqual> &rhs) noexcept
+  template <class T, class Hash, class KeyEqual, class Alloc>
+  void swap(hashtable<T, Hash, KeyEqual, Alloc> &lhs,
+            hashtable<T, Hash, KeyEqual, Alloc> &rhs) noexcept
   {
     lhs.swap(rhs);
   }
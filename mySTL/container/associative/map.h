@@ -14,7 +14,7 @@
 namespace mySTL
 {
 
-    template <class Key, class T, class Compare = mySTL::less<Key>>
+    template <class Key, class T, class Compare = mySTL::less<Key>, class Alloc = mySTL::allocator<mySTL::pair<const Key, T>>>
     class map
     {
     public:
@@ -27,7 +27,7 @@ namespace mySTL
         // 定义一个 functor，用来进行元素比较
         class value_compare : public binary_function<value_type, value_type, bool>
         {
-            friend class map<Key, T, Compare>;
+            friend class map<Key, T, Compare, Alloc>;
 
         private:
             Compare comp;
@@ -42,7 +42,7 @@ namespace mySTL
 
     private:
         // 以 mySTL::rb_tree 作为底层机制
-        typedef mySTL::rb_tree<value_type, key_compare> base_type;
+        typedef mySTL::rb_tree<value_type, key_compare, Alloc> base_type;
         base_type tree_;
 
     public:
@@ -65,15 +65,26 @@ namespace mySTL
 
         map() = default;
 
+        explicit map(const key_compare &comp, const allocator_type &alloc = allocator_type())
+            : tree_(comp, alloc)
+        {
+        }
+        explicit map(const allocator_type &alloc)
+            : tree_(alloc)
+        {
+        }
+
         template <class InputIterator>
-        map(InputIterator first, InputIterator last)
-            : tree_()
+        map(InputIterator first, InputIterator last,
+            const allocator_type &alloc = allocator_type())
+            : tree_(alloc)
         {
             tree_.insert_unique(first, last);
         }
 
-        map(std::initializer_list<value_type> ilist)
-            : tree_()
+        map(std::initializer_list<value_type> ilist,
+            const allocator_type &alloc = allocator_type())
+            : tree_(alloc)
         {
             tree_.insert_unique(ilist.begin(), ilist.end());
         }
@@ -87,6 +98,15 @@ namespace mySTL
         {
         }
 
+        map(const map &rhs, const allocator_type &alloc)
+            : tree_(rhs.tree_, alloc)
+        {
+        }
+        map(map &&rhs, const allocator_type &alloc)
+            : tree_(mySTL::move(rhs.tree_), alloc)
+        {
+        }
+
         map &operator=(const map &rhs)
         {
             tree_ = rhs.tree_;
@@ -284,50 +304,50 @@ namespace mySTL
     };
 
     // 重载比较操作符
-    template <class Key, class T, class Compare>
-    bool operator==(const map<Key, T, Compare> &lhs, const map<Key, T, Compare> &rhs)
+    template <class Key, class T, class Compare, class Alloc>
+    bool operator==(const map<Key, T, Compare, Alloc> &lhs, const map<Key, T, Compare, Alloc> &rhs)
     {
         return lhs == rhs;
     }
 
-    template <class Key, class T, class Compare>
-    bool operator<(const map<Key, T, Compare> &lhs, const map<Key, T, Compare> &rhs)
+    template <class Key, class T, class Compare, class Alloc>
+    bool operator<(const map<Key, T, Compare, Alloc> &lhs, const map<Key, T, Compare, Alloc> &rhs)
     {
         return lhs < rhs;
     }
 
-    template <class Key, class T, class Compare>
-    bool operator!=(const map<Key, T, Compare> &lhs, const map<Key, T, Compare> &rhs)
+    template <class Key, class T, class Compare, class Alloc>
+    bool operator!=(const map<Key, T, Compare, Alloc> &lhs, const map<Key, T, Compare, Alloc> &rhs)
     {
         return !(lhs == rhs);
     }
 
-    template <class Key, class T, class Compare>
-    bool operator>(const map<Key, T, Compare> &lhs, const map<Key, T, Compare> &rhs)
+    template <class Key, class T, class Compare, class Alloc>
+    bool operator>(const map<Key, T, Compare, Alloc> &lhs, const map<Key, T, Compare, Alloc> &rhs)
     {
         return rhs < lhs;
     }
 
-    template <class Key, class T, class Compare>
-    bool operator<=(const map<Key, T, Compare> &lhs, const map<Key, T, Compare> &rhs)
+    template <class Key, class T, class Compare, class Alloc>
+    bool operator<=(const map<Key, T, Compare, Alloc> &lhs, const map<Key, T, Compare, Alloc> &rhs)
     {
         return !(rhs < lhs);
     }
 
-    template <class Key, class T, class Compare>
-    bool operator>=(const map<Key, T, Compare> &lhs, const map<Key, T, Compare> &rhs)
+    template <class Key, class T, class Compare, class Alloc>
+    bool operator>=(const map<Key, T, Compare, Alloc> &lhs, const map<Key, T, Compare, Alloc> &rhs)
     {
         return !(lhs < rhs);
     }
 
     // 重载 mySTL 的 swap
-    template <class Key, class T, class Compare>
-    void swap(map<Key, T, Compare> &lhs, map<Key, T, Compare> &rhs) noexcept
+    template <class Key, class T, class Compare, class Alloc>
+    void swap(map<Key, T, Compare, Alloc> &lhs, map<Key, T, Compare, Alloc> &rhs) noexcept
     {
         lhs.swap(rhs);
     }
 
-    template <class Key, class T, class Compare = mySTL::less<Key>>
+    template <class Key, class T, class Compare = mySTL::less<Key>, class Alloc = mySTL::allocator<mySTL::pair<const Key, T>>>
     class multimap
     {
     public:
@@ -340,7 +360,7 @@ namespace mySTL
         // 定义一个 functor，用来进行元素比较
         class value_compare : public binary_function<value_type, value_type, bool>
         {
-            friend class multimap<Key, T, Compare>;
+            friend class multimap<Key, T, Compare, Alloc>;
 
         private:
             Compare comp;
@@ -355,7 +375,7 @@ namespace mySTL
 
     private:
         // 用 mySTL::rb_tree 作为底层机制
-        typedef mySTL::rb_tree<value_type, key_compare> base_type;
+        typedef mySTL::rb_tree<value_type, key_compare, Alloc> base_type;
         base_type tree_;
 
     public:
@@ -378,14 +398,25 @@ namespace mySTL
 
         multimap() = default;
 
+        explicit multimap(const key_compare &comp, const allocator_type &alloc = allocator_type())
+            : tree_(comp, alloc)
+        {
+        }
+        explicit multimap(const allocator_type &alloc)
+            : tree_(alloc)
+        {
+        }
+
         template <class InputIterator>
-        multimap(InputIterator first, InputIterator last)
-            : tree_()
+        multimap(InputIterator first, InputIterator last,
+                 const allocator_type &alloc = allocator_type())
+            : tree_(alloc)
         {
             tree_.insert_multi(first, last);
         }
-        multimap(std::initializer_list<value_type> ilist)
-            : tree_()
+        multimap(std::initializer_list<value_type> ilist,
+                 const allocator_type &alloc = allocator_type())
+            : tree_(alloc)
         {
             tree_.insert_multi(ilist.begin(), ilist.end());
         }
@@ -399,6 +430,15 @@ namespace mySTL
         {
         }
 
+        multimap(const multimap &rhs, const allocator_type &alloc)
+            : tree_(rhs.tree_, alloc)
+        {
+        }
+        multimap(multimap &&rhs, const allocator_type &alloc)
+            : tree_(mySTL::move(rhs.tree_), alloc)
+        {
+        }
+
         multimap &operator=(const multimap &rhs)
         {
             tree_ = rhs.tree_;
@@ -561,45 +601,45 @@ namespace mySTL
     };
 
     // 重载比较操作符
-    template <class Key, class T, class Compare>
-    bool operator==(const multimap<Key, T, Compare> &lhs, const multimap<Key, T, Compare> &rhs)
+    template <class Key, class T, class Compare, class Alloc>
+    bool operator==(const multimap<Key, T, Compare, Alloc> &lhs, const multimap<Key, T, Compare, Alloc> &rhs)
     {
         return lhs == rhs;
     }
 
-    template <class Key, class T, class Compare>
-    bool operator<(const multimap<Key, T, Compare> &lhs, const multimap<Key, T, Compare> &rhs)
+    template <class Key, class T, class Compare, class Alloc>
+    bool operator<(const multimap<Key, T, Compare, Alloc> &lhs, const multimap<Key, T, Compare, Alloc> &rhs)
     {
         return lhs < rhs;
     }
 
-    template <class Key, class T, class Compare>
-    bool operator!=(const multimap<Key, T, Compare> &lhs, const multimap<Key, T, Compare> &rhs)
+    template <class Key, class T, class Compare, class Alloc>
+    bool operator!=(const multimap<Key, T, Compare, Alloc> &lhs, const multimap<Key, T, Compare, Alloc> &rhs)
     {
         return !(lhs == rhs);
     }
 
-    template <class Key, class T, class Compare>
-    bool operator>(const multimap<Key, T, Compare> &lhs, const multimap<Key, T, Compare> &rhs)
+    template <class Key, class T, class Compare, class Alloc>
+    bool operator>(const multimap<Key, T, Compare, Alloc> &lhs, const multimap<Key, T, Compare, Alloc> &rhs)
     {
         return rhs < lhs;
     }
 
-    template <class Key, class T, class Compare>
-    bool operator<=(const multimap<Key, T, Compare> &lhs, const multimap<Key, T, Compare> &rhs)
+    template <class Key, class T, class Compare, class Alloc>
+    bool operator<=(const multimap<Key, T, Compare, Alloc> &lhs, const multimap<Key, T, Compare, Alloc> &rhs)
     {
         return !(rhs < lhs);
     }
 
-    template <class Key, class T, class Compare>
-    bool operator>=(const multimap<Key, T, Compare> &lhs, const multimap<Key, T, Compare> &rhs)
+    template <class Key, class T, class Compare, class Alloc>
+    bool operator>=(const multimap<Key, T, Compare, Alloc> &lhs, const multimap<Key, T, Compare, Alloc> &rhs)
     {
         return !(lhs < rhs);
     }
 
     // 重载 mySTL 的 swap
-    template <class Key, class T, class Compare>
-    void swap(multimap<Key, T, Compare> &lhs, multimap<Key, T, Compare> &rhs) noexcept
+    template <class Key, class T, class Compare, class Alloc>
+    void swap(multimap<Key, T, Compare, Alloc> &lhs, multimap<Key, T, Compare, Alloc> &rhs) noexcept
     {
         lhs.swap(rhs);
     }
@@ -707,9 +707,10 @@ NodePtr rb_tree_erase_rebalance(NodePtr z, NodePtr& root, NodePtr& leftmost, Nod
 }
 
 // 模板类 rb_tree
-// 参数一代表数据类型，参数二代表键值比较类型
-template <class T, class Compare>
+// 参数一代表数据类型，参数二代表键值比较类型，参数三代表空间配置器类型
+template <class T, class Compare, class Alloc = mySTL::allocator<T>>
 class rb_tree
+  : private mySTL::alloc_holder<typename mySTL::allocator_traits<Alloc>::template rebind_alloc<rb_tree_node<T>>>
 {
 public:
   // rb_tree 的嵌套型别定义 
@@ -726,27 +727,31 @@ public:
   typedef typename tree_traits::value_type         value_type;
   typedef Compare                                  key_compare;
 
-  typedef mySTL::allocator<T>                      allocator_type;
-  typedef mySTL::allocator<T>                      data_allocator;
-  typedef mySTL::allocator<base_type>              base_allocator;
-  typedef mySTL::allocator<node_type>              node_allocator;
+  typedef Alloc                                    allocator_type;
+  typedef mySTL::allocator_traits<Alloc>           data_alloc_traits;
+  typedef typename data_alloc_traits::template rebind_alloc<base_type> base_allocator;
+  typedef typename data_alloc_traits::template rebind_alloc<node_type> node_allocator;
+  typedef mySTL::allocator_traits<base_allocator>  base_alloc_traits;
+  typedef mySTL::allocator_traits<node_allocator>  node_alloc_traits;
 
-  typedef typename allocator_type::pointer         pointer;
-  typedef typename allocator_type::const_pointer   const_pointer;
-  typedef typename allocator_type::reference       reference;
-  typedef typename allocator_type::const_reference const_reference;
-  typedef typename allocator_type::size_type       size_type;
-  typedef typename allocator_type::difference_type difference_type;
+  typedef typename data_alloc_traits::pointer         pointer;
+  typedef typename data_alloc_traits::const_pointer   const_pointer;
+  typedef value_type&                                 reference;
+  typedef const value_type&                           const_reference;
+  typedef typename data_alloc_traits::size_type       size_type;
+  typedef typename data_alloc_traits::difference_type difference_type;
 
   typedef rb_tree_iterator<T>                      iterator;
   typedef rb_tree_const_iterator<T>                const_iterator;
   typedef mySTL::reverse_iterator<iterator>        reverse_iterator;
   typedef mySTL::reverse_iterator<const_iterator>  const_reverse_iterator;
 
-  allocator_type get_allocator() const { return node_allocator(); }
+  allocator_type get_allocator() const { return allocator_type(this->alloc_ref()); }
   key_compare    key_comp()      const { return key_comp_; }
 
 private:
+  typedef mySTL::alloc_holder<node_allocator>      alloc_base;
+
   // 用以下三个数据表现 rb tree
   base_ptr    header_;      // 特殊节点，与根节点互为对方的父节点
   size_type   node_count_;  // 节点数
@@ -762,13 +767,30 @@ public:
   // 构造、复制、析构函数
   rb_tree() { rb_tree_init(); }
 
+  explicit rb_tree(const key_compare& comp, const allocator_type& alloc = allocator_type())
+    :alloc_base(node_allocator(alloc))
+  {
+    rb_tree_init();
+    key_comp_ = comp;
+  }
+
+  explicit rb_tree(const allocator_type& alloc)
+    :alloc_base(node_allocator(alloc))
+  {
+    rb_tree_init();
+  }
+
   rb_tree(const rb_tree& rhs);
+  rb_tree(const rb_tree& rhs, const allocator_type& alloc);
   rb_tree(rb_tree&& rhs) noexcept;
+  rb_tree(rb_tree&& rhs, const allocator_type& alloc);
 
   rb_tree& operator=(const rb_tree& rhs);
-  rb_tree& operator=(rb_tree&& rhs);
+  rb_tree& operator=(rb_tree&& rhs) noexcept(
+    node_alloc_traits::propagate_on_container_move_assignment::value ||
+    node_alloc_traits::is_always_equal::value);
 
-  ~rb_tree() { clear(); }
+  ~rb_tree() { destroy_all(); }
 
 public:
   // 迭代器相关操作
@@ -943,6 +965,8 @@ private:
   // init / reset
   void     rb_tree_init();
   void     reset();
+  void     copy_tree(const rb_tree& rhs);
+  void     destroy_all();
 
   // get insert pos
   mySTL::pair<base_ptr, bool> 
@@ -966,74 +990,116 @@ private:
 /*****************************************************************************************/
 
 // 复制构造函数
-template <class T, class Compare>
-rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+rb_tree<T, Compare, Alloc>::
 rb_tree(const rb_tree& rhs)
+  :alloc_base(node_alloc_traits::select_on_container_copy_construction(rhs.alloc_ref()))
 {
   rb_tree_init();
-  if (rhs.node_count_ != 0)
-  {
-    root() = copy_from(rhs.root(), header_);
-    leftmost() = rb_tree_min(root());
-    rightmost() = rb_tree_max(root());
-  }
-  node_count_ = rhs.node_count_;
-  key_comp_ = rhs.key_comp_;
+  copy_tree(rhs);
+}
+
+// 使用指定分配器的复制构造函数
+template <class T, class Compare, class Alloc>
+rb_tree<T, Compare, Alloc>::
+rb_tree(const rb_tree& rhs, const allocator_type& alloc)
+  :alloc_base(node_allocator(alloc))
+{
+  rb_tree_init();
+  copy_tree(rhs);
 }
 
 // 移动构造函数
-template <class T, class Compare>
-rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+rb_tree<T, Compare, Alloc>::
 rb_tree(rb_tree&& rhs) noexcept
-  :header_(mySTL::move(rhs.header_)),
+  :alloc_base(mySTL::move(rhs.alloc_ref())),
+  header_(mySTL::move(rhs.header_)),
   node_count_(rhs.node_count_),
   key_comp_(rhs.key_comp_)
 {
   rhs.reset();
 }
 
+// 使用指定分配器的移动构造函数，分配器不相等时逐个移动元素
+template <class T, class Compare, class Alloc>
+rb_tree<T, Compare, Alloc>::
+rb_tree(rb_tree&& rhs, const allocator_type& alloc)
+  :alloc_base(node_allocator(alloc))
+{
+  if (mySTL::alloc_equal(this->alloc_ref(), rhs.alloc_ref()))
+  {
+    header_ = rhs.header_;
+    node_count_ = rhs.node_count_;
+    key_comp_ = rhs.key_comp_;
+    rhs.reset();
+  }
+  else
+  {
+    rb_tree_init();
+    key_comp_ = rhs.key_comp_;
+    for (auto it = rhs.begin(); it != rhs.end(); ++it)
+      emplace_multi_use_hint(end(), mySTL::move(*it));
+  }
+}
+
 // 复制赋值操作符
-template <class T, class Compare>
-rb_tree<T, Compare>& 
-rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+rb_tree<T, Compare, Alloc>& 
+rb_tree<T, Compare, Alloc>::
 operator=(const rb_tree& rhs)
 {
   if (this != &rhs)
   {
     clear();
-
-    if (rhs.node_count_ != 0)
-    {
-      root() = copy_from(rhs.root(), header_);
-      leftmost() = rb_tree_min(root());
-      rightmost() = rb_tree_max(root());
+    typedef typename node_alloc_traits::propagate_on_container_copy_assignment pocca;
+    if (pocca::value && !mySTL::alloc_equal(this->alloc_ref(), rhs.alloc_ref()))
+    { // 头节点由旧的分配器分配，需要先释放再重新分配
+      destroy_all();
+      mySTL::alloc_copy_assign(this->alloc_ref(), rhs.alloc_ref(), pocca());
+      rb_tree_init();
     }
-
-    node_count_ = rhs.node_count_;
-    key_comp_ = rhs.key_comp_;
+    copy_tree(rhs);
   }
   return *this;
 }
 
 // 移动赋值操作符
-template <class T, class Compare>
-rb_tree<T, Compare>&
-rb_tree<T, Compare>::
-operator=(rb_tree&& rhs)
-{
-  clear();
-  header_ = mySTL::move(rhs.header_);
-  node_count_ = rhs.node_count_;
-  key_comp_ = rhs.key_comp_;
-  rhs.reset();
+template <class T, class Compare, class Alloc>
+rb_tree<T, Compare, Alloc>&
+rb_tree<T, Compare, Alloc>::
+operator=(rb_tree&& rhs) noexcept(
+  node_alloc_traits::propagate_on_container_move_assignment::value ||
+  node_alloc_traits::is_always_equal::value)
+{
+  if (this == &rhs)
+    return *this;
+  typedef typename node_alloc_traits::propagate_on_container_move_assignment pocma;
+  if (pocma::value || mySTL::alloc_equal(this->alloc_ref(), rhs.alloc_ref()))
+  {
+    destroy_all();
+    mySTL::alloc_move_assign(this->alloc_ref(), rhs.alloc_ref(), pocma());
+    header_ = rhs.header_;
+    node_count_ = rhs.node_count_;
+    key_comp_ = rhs.key_comp_;
+    rhs.reset();
+  }
+  else
+  { // 分配器不相等且不传播，只能逐个移动元素
+    clear();
+    key_comp_ = rhs.key_comp_;
+    for (auto it = rhs.begin(); it != rhs.end(); ++it)
+      emplace_multi_use_hint(end(), mySTL::move(*it));
+    rhs.clear();
+  }
   return *this;
 }
 
 // 就地插入元素，键值允许重复
-template <class T, class Compare>
+template <class T, class Compare, class Alloc>
 template <class ...Args>
-typename rb_tree<T, Compare>::iterator 
-rb_tree<T, Compare>::
+typename rb_tree<T, Compare, Alloc>::iterator 
+rb_tree<T, Compare, Alloc>::
 emplace_multi(Args&& ...args)
 {
   THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1, "rb_tree<T, Comp>'s size too big");
@@ -1043,10 +1109,10 @@ emplace_multi(Args&& ...args)
 }
 
 // 就地插入元素，键值不允许重复
-template <class T, class Compare>
+template <class T, class Compare, class Alloc>
 template <class ...Args>
-mySTL::pair<typename rb_tree<T, Compare>::iterator, bool> 
-rb_tree<T, Compare>::
+mySTL::pair<typename rb_tree<T, Compare, Alloc>::iterator, bool> 
+rb_tree<T, Compare, Alloc>::
 emplace_unique(Args&& ...args)
 {
   THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1, "rb_tree<T, Comp>'s size too big");
@@ -1061,10 +1127,10 @@ emplace_unique(Args&& ...args)
 }
 
 // 就地插入元素，键值允许重复，当 hint 位置与插入位置接近时，插入操作的时间复杂度可以降低
-template <class T, class Compare>
+template <class T, class Compare, class Alloc>
 template <class ...Args>
-typename rb_tree<T, Compare>::iterator
-rb_tree<T, Compare>::
+typename rb_tree<T, Compare, Alloc>::iterator
+rb_tree<T, Compare, Alloc>::
 emplace_multi_use_hint(iterator hint, Args&& ...args)
 {
   THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1, "rb_tree<T, Comp>'s size too big");
@@ -1102,10 +1168,10 @@ emplace_multi_use_hint(iterator hint, Args&& ...args)
 }
 
 // 就地插入元素，键值不允许重复，当 hint 位置与插入位置接近时，插入操作的时间复杂度可以降低
-template<class T, class Compare>
+template <class T, class Compare, class Alloc>
 template<class ...Args>
-typename rb_tree<T, Compare>::iterator
-rb_tree<T, Compare>::
+typename rb_tree<T, Compare, Alloc>::iterator
+rb_tree<T, Compare, Alloc>::
 emplace_unique_use_hint(iterator hint, Args&& ...args)
 {
   THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1, "rb_tree<T, Comp>'s size too big");
@@ -1153,9 +1219,9 @@ emplace_unique_use_hint(iterator hint, Args&& ...args)
 }
 
 // 插入元素，节点键值允许重复
-template <class T, class Compare>
-typename rb_tree<T, Compare>::iterator
-rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::iterator
+rb_tree<T, Compare, Alloc>::
 insert_multi(const value_type& value)
 {
   THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1, "rb_tree<T, Comp>'s size too big");
@@ -1164,9 +1230,9 @@ insert_multi(const value_type& value)
 }
 
 // 插入新值，节点键值不允许重复，返回一个 pair，若插入成功，pair 的第二参数为 true，否则为 false
-template <class T, class Compare>
-mySTL::pair<typename rb_tree<T, Compare>::iterator, bool>
-rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+mySTL::pair<typename rb_tree<T, Compare, Alloc>::iterator, bool>
+rb_tree<T, Compare, Alloc>::
 insert_unique(const value_type& value)
 {
   THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1, "rb_tree<T, Comp>'s size too big");
@@ -1179,9 +1245,9 @@ insert_unique(const value_type& value)
 }
 
 // 删除 hint 位置的节点
-template <class T, class Compare>
-typename rb_tree<T, Compare>::iterator
-rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::iterator
+rb_tree<T, Compare, Alloc>::
 erase(iterator hint)
 {
   auto node = hint.node->get_node_ptr();
@@ -1195,9 +1261,9 @@ erase(iterator hint)
 }
 
 // 删除键值等于 key 的元素，返回删除的个数
-template <class T, class Compare>
-typename rb_tree<T, Compare>::size_type
-rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::size_type
+rb_tree<T, Compare, Alloc>::
 erase_multi(const key_type& key)
 {
   auto p = equal_range_multi(key);
@@ -1207,9 +1273,9 @@ erase_multi(const key_type& key)
 }
 
 // 删除键值等于 key 的元素，返回删除的个数
-template <class T, class Compare>
-typename rb_tree<T, Compare>::size_type
-rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::size_type
+rb_tree<T, Compare, Alloc>::
 erase_unique(const key_type& key)
 {
   auto it = find(key);
@@ -1222,8 +1288,8 @@ erase_unique(const key_type& key)
 }
 
 // 删除[first, last)区间内的元素
-template <class T, class Compare>
-void rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+void rb_tree<T, Compare, Alloc>::
 erase(iterator first, iterator last)
 {
   if (first == begin() && last == end())
@@ -1238,8 +1304,8 @@ erase(iterator first, iterator last)
 }
 
 // 清空 rb tree
-template <class T, class Compare>
-void rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+void rb_tree<T, Compare, Alloc>::
 clear()
 {
   if (node_count_ != 0)
@@ -1253,9 +1319,9 @@ clear()
 }
 
 // 查找键值为 k 的节点，返回指向它的迭代器
-template <class T, class Compare>
-typename rb_tree<T, Compare>::iterator
-rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::iterator
+rb_tree<T, Compare, Alloc>::
 find(const key_type& key)
 {
   auto y = header_;  // 最后一个不小于 key 的节点
@@ -1275,9 +1341,9 @@ find(const key_type& key)
   return (j == end() || key_comp_(key, value_traits::get_key(*j))) ? end() : j;
 }
 
-template <class T, class Compare>
-typename rb_tree<T, Compare>::const_iterator
-rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::const_iterator
+rb_tree<T, Compare, Alloc>::
 find(const key_type& key) const
 {
   auto y = header_;  // 最后一个不小于 key 的节点
@@ -1298,9 +1364,9 @@ find(const key_type& key) const
 }
 
 // 键值不小于 key 的第一个位置
-template <class T, class Compare>
-typename rb_tree<T, Compare>::iterator
-rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::iterator
+rb_tree<T, Compare, Alloc>::
 lower_bound(const key_type& key)
 {
   auto y = header_;
@@ -1319,9 +1385,9 @@ lower_bound(const key_type& key)
   return iterator(y);
 }
 
-template <class T, class Compare>
-typename rb_tree<T, Compare>::const_iterator
-rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::const_iterator
+rb_tree<T, Compare, Alloc>::
 lower_bound(const key_type& key) const
 {
   auto y = header_;
@@ -1341,9 +1407,9 @@ lower_bound(const key_type& key) const
 }
 
 // 键值不小于 key 的最后一个位置
-template <class T, class Compare>
-typename rb_tree<T, Compare>::iterator
-rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::iterator
+rb_tree<T, Compare, Alloc>::
 upper_bound(const key_type& key)
 {
   auto y = header_;
@@ -1362,9 +1428,9 @@ upper_bound(const key_type& key)
   return iterator(y);
 }
 
-template <class T, class Compare>
-typename rb_tree<T, Compare>::const_iterator
-rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::const_iterator
+rb_tree<T, Compare, Alloc>::
 upper_bound(const key_type& key) const
 {
   auto y = header_;
@@ -1384,12 +1450,15 @@ upper_bound(const key_type& key) const
 }
 
 // 交换 rb tree
-template <class T, class Compare>
-void rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+void rb_tree<T, Compare, Alloc>::
 swap(rb_tree& rhs) noexcept
 {
   if (this != &rhs)
   {
+    typedef typename node_alloc_traits::propagate_on_container_swap pocs;
+    MYSTL_DEBUG(pocs::value || mySTL::alloc_equal(this->alloc_ref(), rhs.alloc_ref()));
+    mySTL::alloc_swap(this->alloc_ref(), rhs.alloc_ref(), pocs());
     mySTL::swap(header_, rhs.header_);
     mySTL::swap(node_count_, rhs.node_count_);
     mySTL::swap(key_comp_, rhs.key_comp_);
@@ -1400,32 +1469,32 @@ swap(rb_tree& rhs) noexcept
 // helper function
 
 // 创建一个结点
-template <class T, class Compare>
+template <class T, class Compare, class Alloc>
 template <class ...Args>
-typename rb_tree<T, Compare>::node_ptr
-rb_tree<T, Compare>::
+typename rb_tree<T, Compare, Alloc>::node_ptr
+rb_tree<T, Compare, Alloc>::
 create_node(Args&&... args)
 {
-  auto tmp = node_allocator::allocate(1);
+  auto tmp = node_alloc_traits::allocate(this->alloc_ref(), 1);
   try
   {
-    data_allocator::construct(mySTL::address_of(tmp->value), mySTL::forward<Args>(args)...);
+    node_alloc_traits::construct(this->alloc_ref(), mySTL::address_of(tmp->value), mySTL::forward<Args>(args)...);
     tmp->left = nullptr;
     tmp->right = nullptr;
     tmp->parent = nullptr;
   }
   catch (...)
   {
-    node_allocator::deallocate(tmp);
+    node_alloc_traits::deallocate(this->alloc_ref(), tmp, 1);
     throw;
   }
   return tmp;
 }
 
 // 复制一个结点
-template <class T, class Compare>
-typename rb_tree<T, Compare>::node_ptr
-rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::node_ptr
+rb_tree<T, Compare, Alloc>::
 clone_node(base_ptr x)
 {
   node_ptr tmp = create_node(x->get_node_ptr()->value);
@@ -1436,20 +1505,21 @@ clone_node(base_ptr x)
 }
 
 // 销毁一个结点
-template <class T, class Compare>
-void rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+void rb_tree<T, Compare, Alloc>::
 destroy_node(node_ptr p)
 {
-  data_allocator::destroy(&p->value);
-  node_allocator::deallocate(p);
+  node_alloc_traits::destroy(this->alloc_ref(), &p->value);
+  node_alloc_traits::deallocate(this->alloc_ref(), p, 1);
 }
 
 // 初始化容器
-template <class T, class Compare>
-void rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+void rb_tree<T, Compare, Alloc>::
 rb_tree_init()
 {
-  header_ = base_allocator::allocate(1);
+  base_allocator base_alloc(this->alloc_ref());
+  header_ = base_alloc_traits::allocate(base_alloc, 1);
   header_->color = rb_tree_red;  // header_ 节点颜色为红，与 root 区分
   root() = nullptr;
   leftmost() = header_;
@@ -1458,17 +1528,44 @@ rb_tree_init()
 }
 
 // reset 函数
-template <class T, class Compare>
-void rb_tree<T, Compare>::reset()
+template <class T, class Compare, class Alloc>
+void rb_tree<T, Compare, Alloc>::reset()
 {
   header_ = nullptr;
   node_count_ = 0;
 }
 
+// copy_tree 函数，复制 rhs 的节点到空树中
+template <class T, class Compare, class Alloc>
+void rb_tree<T, Compare, Alloc>::copy_tree(const rb_tree& rhs)
+{
+  if (rhs.node_count_ != 0)
+  {
+    root() = copy_from(rhs.root(), header_);
+    leftmost() = rb_tree_min(root());
+    rightmost() = rb_tree_max(root());
+  }
+  node_count_ = rhs.node_count_;
+  key_comp_ = rhs.key_comp_;
+}
+
+// destroy_all 函数，销毁所有节点并释放头节点
+template <class T, class Compare, class Alloc>
+void rb_tree<T, Compare, Alloc>::destroy_all()
+{
+  if (header_ != nullptr)
+  {
+    clear();
+    base_allocator base_alloc(this->alloc_ref());
+    base_alloc_traits::deallocate(base_alloc, header_, 1);
+    header_ = nullptr;
+  }
+}
+
 // get_insert_multi_pos 函数
-template <class T, class Compare>
-mySTL::pair<typename rb_tree<T, Compare>::base_ptr, bool>
-rb_tree<T, Compare>::get_insert_multi_pos(const key_type& key)
+template <class T, class Compare, class Alloc>
+mySTL::pair<typename rb_tree<T, Compare, Alloc>::base_ptr, bool>
+rb_tree<T, Compare, Alloc>::get_insert_multi_pos(const key_type& key)
 {
   auto x = root();
   auto y = header_;
@@ -1483,9 +1580,9 @@ rb_tree<T, Compare>::get_insert_multi_pos(const key_type& key)
 }
 
 // get_insert_unique_pos 函数
-template <class T, class Compare>
-mySTL::pair<mySTL::pair<typename rb_tree<T, Compare>::base_ptr, bool>, bool>
-rb_tree<T, Compare>::get_insert_unique_pos(const key_type& key)
+template <class T, class Compare, class Alloc>
+mySTL::pair<mySTL::pair<typename rb_tree<T, Compare, Alloc>::base_ptr, bool>, bool>
+rb_tree<T, Compare, Alloc>::get_insert_unique_pos(const key_type& key)
 { // 返回一个 pair，第一个值为一个 pair，包含插入点的父节点和一个 bool 表示是否在左边插入，
   // 第二个值为一个 bool，表示是否插入成功
   auto x = root();
@@ -1519,9 +1616,9 @@ rb_tree<T, Compare>::get_insert_unique_pos(const key_type& key)
 
 // insert_value_at 函数
 // x 为插入点的父节点， value 为要插入的值，add_to_left 表示是否在左边插入
-template <class T, class Compare>
-typename rb_tree<T, Compare>::iterator
-rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::iterator
+rb_tree<T, Compare, Alloc>::
 insert_value_at(base_ptr x, const value_type& value, bool add_to_left)
 {
   node_ptr node = create_node(value);
@@ -1552,9 +1649,9 @@ insert_value_at(base_ptr x, const value_type& value, bool add_to_left)
 
 // 在 x 节点处插入新的节点
 // x 为插入点的父节点， node 为要插入的节点，add_to_left 表示是否在左边插入
-template <class T, class Compare>
-typename rb_tree<T, Compare>::iterator
-rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::iterator
+rb_tree<T, Compare, Alloc>::
 insert_node_at(base_ptr x, node_ptr node, bool add_to_left)
 {
   node->parent = x;
@@ -1583,9 +1680,9 @@ insert_node_at(base_ptr x, node_ptr node, bool add_to_left)
 }
 
 // 插入元素，键值允许重复，使用 hint
-template <class T, class Compare>
-typename rb_tree<T, Compare>::iterator 
-rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::iterator 
+rb_tree<T, Compare, Alloc>::
 insert_multi_use_hint(iterator hint, key_type key, node_ptr node)
 {
   // 在 hint 附近寻找可插入的位置
@@ -1610,9 +1707,9 @@ insert_multi_use_hint(iterator hint, key_type key, node_ptr node)
 }
 
 // 插入元素，键值不允许重复，使用 hint
-template <class T, class Compare>
-typename rb_tree<T, Compare>::iterator 
-rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::iterator 
+rb_tree<T, Compare, Alloc>::
 insert_unique_use_hint(iterator hint, key_type key, node_ptr node)
 {
   // 在 hint 附近寻找可插入的位置
@@ -1643,9 +1740,9 @@ insert_unique_use_hint(iterator hint, key_type key, node_ptr node)
 
 // copy_from 函数
 // 递归复制一颗树，节点从 x 开始，p 为 x 的父节点
-template <class T, class Compare>
-typename rb_tree<T, Compare>::base_ptr
-rb_tree<T, Compare>::copy_from(base_ptr x, base_ptr p)
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::base_ptr
+rb_tree<T, Compare, Alloc>::copy_from(base_ptr x, base_ptr p)
 {
   auto top = clone_node(x);
   top->parent = p;
@@ -1676,8 +1773,8 @@ rb_tree<T, Compare>::copy_from(base_ptr x, base_ptr p)
 
 // erase_since 函数
 // 从 x 节点开始删除该节点及其子树
-template <class T, class Compare>
-void rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+void rb_tree<T, Compare, Alloc>::
 erase_since(base_ptr x)
 {
   while (x != nullptr)
@@ -1690,45 +1787,45 @@ erase_since(base_ptr x)
 }
 
 // 重载比较操作符
-template <class T, class Compare>
-bool operator==(const rb_tree<T, Compare>& lhs, const rb_tree<T, Compare>& rhs)
+template <class T, class Compare, class Alloc>
+bool operator==(const rb_tree<T, Compare, Alloc>& lhs, const rb_tree<T, Compare, Alloc>& rhs)
 {
   return lhs.size() == rhs.size() && mySTL::equal(lhs.begin(), lhs.end(), rhs.begin());
 }
 
-template <class T, class Compare>
-bool operator<(const rb_tree<T, Compare>& lhs, const rb_tree<T, Compare>& rhs)
+template <class T, class Compare, class Alloc>
+bool operator<(const rb_tree<T, Compare, Alloc>& lhs, const rb_tree<T, Compare, Alloc>& rhs)
 {
   return mySTL::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 }
 
-template <class T, class Compare>
-bool operator!=(const rb_tree<T, Compare>& lhs, const rb_tree<T, Compare>& rhs)
+template <class T, class Compare, class Alloc>
+bool operator!=(const rb_tree<T, Compare, Alloc>& lhs, const rb_tree<T, Compare, Alloc>& rhs)
 {
   return !(lhs == rhs);
 }
 
-template <class T, class Compare>
-bool operator>(const rb_tree<T, Compare>& lhs, const rb_tree<T, Compare>& rhs)
+template <class T, class Compare, class Alloc>
+bool operator>(const rb_tree<T, Compare, Alloc>& lhs, const rb_tree<T, Compare, Alloc>& rhs)
 {
   return rhs < lhs;
 }
 
-template <class T, class Compare>
-bool operator<=(const rb_tree<T, Compare>& lhs, const rb_tree<T, Compare>& rhs)
+template <class T, class Compare, class Alloc>
+bool operator<=(const rb_tree<T, Compare, Alloc>& lhs, const rb_tree<T, Compare, Alloc>& rhs)
 {
   return !(rhs < lhs);
 }
 
-template <class T, class Compare>
-bool operator>=(const rb_tree<T, Compare>& lhs, const rb_tree<T, Compare>& rhs)
+template <class T, class Compare, class Alloc>
+bool operator>=(const rb_tree<T, Compare, Alloc>& lhs, const rb_tree<T, Compare, Alloc>& rhs)
 {
   return !(lhs < rhs);
 }
 
 // 重载 mySTL 的 swap
-template <class T, class Compare>
-void swap(rb_tree<T, Compare>& lhs, rb_tree<T, Compare>& rhs) noexcept
+template <class T, class Compare, class Alloc>
+void swap(rb_tree<T, Compare, Alloc>& lhs, rb_tree<T, Compare, Alloc>& rhs) noexcept
 {
   lhs.swap(rhs);
 }
@@ -20,7 +20,8 @@ namespace mySTL
 
     // 模板类 set，键值不允许重复
     // 参数一代表键值类型，参数二代表键值比较方式，缺省使用 mySTL::less
-    template <class Key, class Compare = mySTL::less<Key>>
+    // 参数三代表空间配置器类型，缺省使用 mySTL::allocator
+    template <class Key, class Compare = mySTL::less<Key>, class Alloc = mySTL::allocator<Key>>
     class set
     {
     public:
@@ -31,7 +32,7 @@ namespace mySTL
 
     private:
         // 以 mySTL::rb_tree 作为底层机制
-        typedef mySTL::rb_tree<value_type, key_compare> base_type;
+        typedef mySTL::rb_tree<value_type, key_compare, Alloc> base_type;
         base_type tree_;
 
     public:
@@ -53,14 +54,25 @@ namespace mySTL
         // 构造、复制、移动函数
         set() = default;
 
+        explicit set(const key_compare &comp, const allocator_type &alloc = allocator_type())
+            : tree_(comp, alloc)
+        {
+        }
+        explicit set(const allocator_type &alloc)
+            : tree_(alloc)
+        {
+        }
+
         template <class InputIterator>
-        set(InputIterator first, InputIterator last)
-            : tree_()
+        set(InputIterator first, InputIterator last,
+            const allocator_type &alloc = allocator_type())
+            : tree_(alloc)
         {
             tree_.insert_unique(first, last);
         }
-        set(std::initializer_list<value_type> ilist)
-            : tree_()
+        set(std::initializer_list<value_type> ilist,
+            const allocator_type &alloc = allocator_type())
+            : tree_(alloc)
         {
             tree_.insert_unique(ilist.begin(), ilist.end());
         }
@@ -74,6 +86,15 @@ namespace mySTL
         {
         }
 
+        set(const set &rhs, const allocator_type &alloc)
+            : tree_(rhs.tree_, alloc)
+        {
+        }
+        set(set &&rhs, const allocator_type &alloc)
+            : tree_(mySTL::move(rhs.tree_), alloc)
+        {
+        }
+
         set &operator=(const set &rhs)
         {
             tree_ = rhs.tree_;
@@ -235,52 +256,53 @@ namespace mySTL
     };
 
     // 重载比较操作符
-    template <class Key, class Compare>
-    bool operator==(const set<Key, Compare> &lhs, const set<Key, Compare> &rhs)
+    template <class Key, class Compare, class Alloc>
+    bool operator==(const set<Key, Compare, Alloc> &lhs, const set<Key, Compare, Alloc> &rhs)
     {
         return lhs == rhs;
     }
 
-    template <class Key, class Compare>
-    bool operator<(const set<Key, Compare> &lhs, const set<Key, Compare> &rhs)
+    template <class Key, class Compare, class Alloc>
+    bool operator<(const set<Key, Compare, Alloc> &lhs, const set<Key, Compare, Alloc> &rhs)
     {
         return lhs < rhs;
     }
 
-    template <class Key, class Compare>
-    bool operator!=(const set<Key, Compare> &lhs, const set<Key, Compare> &rhs)
+    template <class Key, class Compare, class Alloc>
+    bool operator!=(const set<Key, Compare, Alloc> &lhs, const set<Key, Compare, Alloc> &rhs)
     {
         return !(lhs == rhs);
     }
 
-    template <class Key, class Compare>
-    bool operator>(const set<Key, Compare> &lhs, const set<Key, Compare> &rhs)
+    template <class Key, class Compare, class Alloc>
+    bool operator>(const set<Key, Compare, Alloc> &lhs, const set<Key, Compare, Alloc> &rhs)
     {
         return rhs < lhs;
     }
 
-    template <class Key, class Compare>
-    bool operator<=(const set<Key, Compare> &lhs, const set<Key, Compare> &rhs)
+    template <class Key, class Compare, class Alloc>
+    bool operator<=(const set<Key, Compare, Alloc> &lhs, const set<Key, Compare, Alloc> &rhs)
     {
         return !(rhs < lhs);
     }
 
-    template <class Key, class Compare>
-    bool operator>=(const set<Key, Compare> &lhs, const set<Key, Compare> &rhs)
+    template <class Key, class Compare, class Alloc>
+    bool operator>=(const set<Key, Compare, Alloc> &lhs, const set<Key, Compare, Alloc> &rhs)
     {
         return !(lhs < rhs);
     }
 
     // 重载 mySTL 的 swap
-    template <class Key, class Compare>
-    void swap(set<Key, Compare> &lhs, set<Key, Compare> &rhs) noexcept
+    template <class Key, class Compare, class Alloc>
+    void swap(set<Key, Compare, Alloc> &lhs, set<Key, Compare, Alloc> &rhs) noexcept
     {
         lhs.swap(rhs);
     }
 
     // 模板类 multiset，键值允许重复
     // 参数一代表键值类型，参数二代表键值比较方式，缺省使用 mySTL::less
-    template <class Key, class Compare = mySTL::less<Key>>
+    // 参数三代表空间配置器类型，缺省使用 mySTL::allocator
+    template <class Key, class Compare = mySTL::less<Key>, class Alloc = mySTL::allocator<Key>>
     class multiset
     {
     public:
@@ -291,7 +313,7 @@ namespace mySTL
 
     private:
         // 以 mySTL::rb_tree 作为底层机制
-        typedef mySTL::rb_tree<value_type, key_compare> base_type;
+        typedef mySTL::rb_tree<value_type, key_compare, Alloc> base_type;
         base_type tree_; // 以 rb_tree 表现 multiset
 
     public:
@@ -313,14 +335,25 @@ namespace mySTL
         // 构造、复制、移动函数
         multiset() = default;
 
+        explicit multiset(const key_compare &comp, const allocator_type &alloc = allocator_type())
+            : tree_(comp, alloc)
+        {
+        }
+        explicit multiset(const allocator_type &alloc)
+            : tree_(alloc)
+        {
+        }
+
         template <class InputIterator>
-        multiset(InputIterator first, InputIterator last)
-            : tree_()
+        multiset(InputIterator first, InputIterator last,
+                 const allocator_type &alloc = allocator_type())
+            : tree_(alloc)
         {
             tree_.insert_multi(first, last);
         }
-        multiset(std::initializer_list<value_type> ilist)
-            : tree_()
+        multiset(std::initializer_list<value_type> ilist,
+                 const allocator_type &alloc = allocator_type())
+            : tree_(alloc)
         {
             tree_.insert_multi(ilist.begin(), ilist.end());
         }
@@ -334,6 +367,15 @@ namespace mySTL
         {
         }
 
+        multiset(const multiset &rhs, const allocator_type &alloc)
+            : tree_(rhs.tree_, alloc)
+        {
+        }
+        multiset(multiset &&rhs, const allocator_type &alloc)
+            : tree_(mySTL::move(rhs.tree_), alloc)
+        {
+        }
+
         multiset &operator=(const multiset &rhs)
         {
             tree_ = rhs.tree_;
@@ -495,45 +537,45 @@ namespace mySTL
     };
     
     // 重载比较操作符
-    template <class Key, class Compare>
-    bool operator==(const multiset<Key, Compare> &lhs, const multiset<Key, Compare> &rhs)
+    template <class Key, class Compare, class Alloc>
+    bool operator==(const multiset<Key, Compare, Alloc> &lhs, const multiset<Key, Compare, Alloc> &rhs)
     {
         return lhs == rhs;
     }
 
-    template <class Key, class Compare>
-    bool operator<(const multiset<Key, Compare> &lhs, const multiset<Key, Compare> &rhs)
+    template <class Key, class Compare, class Alloc>
+    bool operator<(const multiset<Key, Compare, Alloc> &lhs, const multiset<Key, Compare, Alloc> &rhs)
     {
         return lhs < rhs;
     }
 
-    template <class Key, class Compare>
-    bool operator!=(const multiset<Key, Compare> &lhs, const multiset<Key, Compare> &rhs)
+    template <class Key, class Compare, class Alloc>
+    bool operator!=(const multiset<Key, Compare, Alloc> &lhs, const multiset<Key, Compare, Alloc> &rhs)
     {
         return !(lhs == rhs);
     }
 
-    template <class Key, class Compare>
-    bool operator>(const multiset<Key, Compare> &lhs, const multiset<Key, Compare> &rhs)
+    template <class Key, class Compare, class Alloc>
+    bool operator>(const multiset<Key, Compare, Alloc> &lhs, const multiset<Key, Compare, Alloc> &rhs)
     {
         return rhs < lhs;
     }
 
-    template <class Key, class Compare>
-    bool operator<=(const multiset<Key, Compare> &lhs, const multiset<Key, Compare> &rhs)
+    template <class Key, class Compare, class Alloc>
+    bool operator<=(const multiset<Key, Compare, Alloc> &lhs, const multiset<Key, Compare, Alloc> &rhs)
     {
         return !(rhs < lhs);
     }
 
-    template <class Key, class Compare>
-    bool operator>=(const multiset<Key, Compare> &lhs, const multiset<Key, Compare> &rhs)
+    template <class Key, class Compare, class Alloc>
+    bool operator>=(const multiset<Key, Compare, Alloc> &lhs, const multiset<Key, Compare, Alloc> &rhs)
     {
         return !(lhs < rhs);
     }
 
     // 重载 mySTL 的 swap
-    template <class Key, class Compare>
-    void swap(multiset<Key, Compare> &lhs, multiset<Key, Compare> &rhs) noexcept
+    template <class Key, class Compare, class Alloc>
+    void swap(multiset<Key, Compare, Alloc> &lhs, multiset<Key, Compare, Alloc> &rhs) noexcept
     {
         lhs.swap(rhs);
     }
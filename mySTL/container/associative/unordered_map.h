@@ -16,13 +16,15 @@ namespace mySTL
     // 模板类 unordered_map，键值不允许重复
     // 参数一代表键值类型，参数二代表实值类型，参数三代表哈希函数，缺省使用 mySTL::hash
     // 参数四代表键值比较方式，缺省使用 mySTL::equal_to
+    // 参数五代表空间配置器类型，缺省使用 mySTL::allocator
 
-    template <class Key, class T, class Hash = mySTL::hash<Key>, class KeyEqual = mySTL::equal_to<Key>>
+    template <class Key, class T, class Hash = mySTL::hash<Key>, class KeyEqual = mySTL::equal_to<Key>,
+              class Alloc = mySTL::allocator<mySTL::pair<const Key, T>>>
     class unordered_map
     {
     private:
         // 使用 hashtable 作为底层机制
-        typedef hashtable<mySTL::pair<const Key, T>, Hash, KeyEqual> base_type;
+        typedef hashtable<mySTL::pair<const Key, T>, Hash, KeyEqual, Alloc> base_type;
         base_type ht_;
 
     public:
@@ -57,10 +59,16 @@ namespace mySTL
         {
         }
 
+        explicit unordered_map(const allocator_type &alloc)
+            : ht_(100, Hash(), KeyEqual(), alloc)
+        {
+        }
+
         explicit unordered_map(size_type bucket_count,
                                const Hash &hash = Hash(),
-                               const KeyEqual &equal = KeyEqual())
-            : ht_(bucket_count, hash, equal)
+                               const KeyEqual &equal = KeyEqual(),
+                               const allocator_type &alloc = allocator_type())
+            : ht_(bucket_count, hash, equal, alloc)
         {
         }
 
@@ -68,8 +76,9 @@ namespace mySTL
         unordered_map(InputIterator first, InputIterator last,
                       const size_type bucket_count = 100,
                       const Hash &hash = Hash(),
-                      const KeyEqual &equal = KeyEqual())
-            : ht_(mySTL::max(bucket_count, static_cast<size_type>(mySTL::distance(first, last))), hash, equal)
+                      const KeyEqual &equal = KeyEqual(),
+                      const allocator_type &alloc = allocator_type())
+            : ht_(mySTL::max(bucket_count, static_cast<size_type>(mySTL::distance(first, last))), hash, equal, alloc)
         {
             for (; first != last; ++first)
                 ht_.insert_unique_noresize(*first);
@@ -78,8 +87,9 @@ namespace mySTL
         unordered_map(std::initializer_list<value_type> ilist,
                       const size_type bucket_count = 100,
                       const Hash &hash = Hash(),
-                      const KeyEqual &equal = KeyEqual())
-            : ht_(mySTL::max(bucket_count, static_cast<size_type>(ilist.size())), hash, equal)
+                      const KeyEqual &equal = KeyEqual(),
+                      const allocator_type &alloc = allocator_type())
+            : ht_(mySTL::max(bucket_count, static_cast<size_type>(ilist.size())), hash, equal, alloc)
         {
             for (auto first = ilist.begin(), last = ilist.end(); first != last; ++first)
                 ht_.insert_unique_noresize(*first);
@@ -93,6 +103,14 @@ namespace mySTL
             : ht_(mySTL::move(rhs.ht_))
         {
         }
+        unordered_map(const unordered_map &rhs, const allocator_type &alloc)
+            : ht_(rhs.ht_, alloc)
+        {
+        }
+        unordered_map(unordered_map &&rhs, const allocator_type &alloc)
+            : ht_(mySTL::move(rhs.ht_), alloc)
+        {
+        }
 
         unordered_map &operator=(const unordered_map &rhs)
         {
@@ -342,24 +360,24 @@ namespace mySTL
     };
 
     // 重载比较操作符
-    template <class Key, class T, class Hash, class KeyEqual>
-    bool operator==(const unordered_map<Key, T, Hash, KeyEqual> &lhs,
-                    const unordered_map<Key, T, Hash, KeyEqual> &rhs)
+    template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+    bool operator==(const unordered_map<Key, T, Hash, KeyEqual, Alloc> &lhs,
+                    const unordered_map<Key, T, Hash, KeyEqual, Alloc> &rhs)
     {
         return lhs == rhs;
     }
 
-    template <class Key, class T, class Hash, class KeyEqual>
-    bool operator!=(const unordered_map<Key, T, Hash, KeyEqual> &lhs,
-                    const unordered_map<Key, T, Hash, KeyEqual> &rhs)
+    template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+    bool operator!=(const unordered_map<Key, T, Hash, KeyEqual, Alloc> &lhs,
+                    const unordered_map<Key, T, Hash, KeyEqual, Alloc> &rhs)
     {
         return lhs != rhs;
     }
 
     // 重载 mySTL 的 swap
-    template <class Key, class T, class Hash, class KeyEqual>
-    void swap(unordered_map<Key, T, Hash, KeyEqual> &lhs,
-              unordered_map<Key, T, Hash, KeyEqual> &rhs)
+    template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+    void swap(unordered_map<Key, T, Hash, KeyEqual, Alloc> &lhs,
+              unordered_map<Key, T, Hash, KeyEqual, Alloc> &rhs)
     {
         lhs.swap(rhs);
     }
@@ -367,12 +385,14 @@ namespace mySTL
     // 模板类 unordered_multimap，键值允许重复
     // 参数一代表键值类型，参数二代表实值类型，参数三代表哈希函数，缺省使用 mySTL::hash
     // 参数四代表键值比较方式，缺省使用 mySTL::equal_to
-    template <class Key, class T, class Hash = mySTL::hash<Key>, class KeyEqual = mySTL::equal_to<Key>>
+    // 参数五代表空间配置器类型，缺省使用 mySTL::allocator
+    template <class Key, class T, class Hash = mySTL::hash<Key>, class KeyEqual = mySTL::equal_to<Key>,
+              class Alloc = mySTL::allocator<mySTL::pair<const Key, T>>>
     class unordered_multimap
     {
     private:
         // 使用 hashtable 作为底层机制
-        typedef hashtable<pair<const Key, T>, Hash, KeyEqual> base_type;
+        typedef hashtable<pair<const Key, T>, Hash, KeyEqual, Alloc> base_type;
         base_type ht_;
 
     public:
@@ -406,10 +426,16 @@ namespace mySTL
         {
         }
 
+        explicit unordered_multimap(const allocator_type &alloc)
+            : ht_(100, Hash(), KeyEqual(), alloc)
+        {
+        }
+
         explicit unordered_multimap(size_type bucket_count,
                                     const Hash &hash = Hash(),
-                                    const KeyEqual &equal = KeyEqual())
-            : ht_(bucket_count, hash, equal)
+                                    const KeyEqual &equal = KeyEqual(),
+                                    const allocator_type &alloc = allocator_type())
+            : ht_(bucket_count, hash, equal, alloc)
         {
         }
 
@@ -417,8 +443,9 @@ namespace mySTL
         unordered_multimap(InputIterator first, InputIterator last,
                            const size_type bucket_count = 100,
                            const Hash &hash = Hash(),
-                           const KeyEqual &equal = KeyEqual())
-            : ht_(mySTL::max(bucket_count, static_cast<size_type>(mySTL::distance(first, last))), hash, equal)
+                           const KeyEqual &equal = KeyEqual(),
+                           const allocator_type &alloc = allocator_type())
+            : ht_(mySTL::max(bucket_count, static_cast<size_type>(mySTL::distance(first, last))), hash, equal, alloc)
         {
             for (; first != last; ++first)
                 ht_.insert_multi_noresize(*first);
@@ -427,8 +454,9 @@ namespace mySTL
         unordered_multimap(std::initializer_list<value_type> ilist,
                            const size_type bucket_count = 100,
                            const Hash &hash = Hash(),
-                           const KeyEqual &equal = KeyEqual())
-            : ht_(mySTL::max(bucket_count, static_cast<size_type>(ilist.size())), hash, equal)
+                           const KeyEqual &equal = KeyEqual(),
+                           const allocator_type &alloc = allocator_type())
+            : ht_(mySTL::max(bucket_count, static_cast<size_type>(ilist.size())), hash, equal, alloc)
         {
             for (auto first = ilist.begin(), last = ilist.end(); first != last; ++first)
                 ht_.insert_multi_noresize(*first);
@@ -442,6 +470,14 @@ namespace mySTL
             : ht_(mySTL::move(rhs.ht_))
         {
         }
+        unordered_multimap(const unordered_multimap &rhs, const allocator_type &alloc)
+            : ht_(rhs.ht_, alloc)
+        {
+        }
+        unordered_multimap(unordered_multimap &&rhs, const allocator_type &alloc)
+            : ht_(mySTL::move(rhs.ht_), alloc)
+        {
+        }
 
         unordered_multimap &operator=(const unordered_multimap &rhs)
         {
@@ -663,24 +699,24 @@ namespace mySTL
     };
 
     // 重载比较操作符
-    template <class Key, class T, class Hash, class KeyEqual>
-    bool operator==(const unordered_multimap<Key, T, Hash, KeyEqual> &lhs,
-                    const unordered_multimap<Key, T, Hash, KeyEqual> &rhs)
+    template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+    bool operator==(const unordered_multimap<Key, T, Hash, KeyEqual, Alloc> &lhs,
+                    const unordered_multimap<Key, T, Hash, KeyEqual, Alloc> &rhs)
     {
         return lhs == rhs;
     }
 
-    template <class Key, class T, class Hash, class KeyEqual>
-    bool operator!=(const unordered_multimap<Key, T, Hash, KeyEqual> &lhs,
-                    const unordered_multimap<Key, T, Hash, KeyEqual> &rhs)
+    template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+    bool operator!=(const unordered_multimap<Key, T, Hash, KeyEqual, Alloc> &lhs,
+                    const unordered_multimap<Key, T, Hash, KeyEqual, Alloc> &rhs)
     {
         return lhs != rhs;
     }
 
     // 重载 mySTL 的 swap
-    template <class Key, class T, class Hash, class KeyEqual>
-    void swap(unordered_multimap<Key, T, Hash, KeyEqual> &lhs,
-              unordered_multimap<Key, T, Hash, KeyEqual> &rhs)
+    template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+    void swap(unordered_multimap<Key, T, Hash, KeyEqual, Alloc> &lhs,
+              unordered_multimap<Key, T, Hash, KeyEqual, Alloc> &rhs)
     {
         lhs.swap(rhs);
     }
@@ -16,12 +16,14 @@ namespace mySTL
     // 模板类 unordered_set，键值不允许重复
     // 参数一代表键值类型，参数二代表哈希函数，缺省使用 mySTL::hash，
     // 参数三代表键值比较方式，缺省使用 mySTL::equal_to
-    template <class Key, class Hash = mySTL::hash<Key>, class KeyEqual = mySTL::equal_to<Key>>
+    // 参数四代表空间配置器类型，缺省使用 mySTL::allocator
+    template <class Key, class Hash = mySTL::hash<Key>, class KeyEqual = mySTL::equal_to<Key>,
+              class Alloc = mySTL::allocator<Key>>
     class unordered_set
     {
     private:
         // 使用 hashtable 作为底层机制
-        typedef hashtable<Key, Hash, KeyEqual> base_type;
+        typedef hashtable<Key, Hash, KeyEqual, Alloc> base_type;
         base_type ht_;
 
     public:
@@ -54,10 +56,16 @@ namespace mySTL
         {
         }
 
+        explicit unordered_set(const allocator_type &alloc)
+            : ht_(100, Hash(), KeyEqual(), alloc)
+        {
+        }
+
         explicit unordered_set(size_type bucket_count,
                                const Hash &hash = Hash(),
-                               const KeyEqual &equal = KeyEqual())
-            : ht_(bucket_count, hash, equal)
+                               const KeyEqual &equal = KeyEqual(),
+                               const allocator_type &alloc = allocator_type())
+            : ht_(bucket_count, hash, equal, alloc)
         {
         }
 
@@ -65,8 +73,9 @@ namespace mySTL
         unordered_set(InputIterator first, InputIterator last,
                       const size_type bucket_count = 100,
                       const Hash &hash = Hash(),
-                      const KeyEqual &equal = KeyEqual())
-            : ht_(mySTL::max(bucket_count, static_cast<size_type>(mySTL::distance(first, last))), hash, equal)
+                      const KeyEqual &equal = KeyEqual(),
+                      const allocator_type &alloc = allocator_type())
+            : ht_(mySTL::max(bucket_count, static_cast<size_type>(mySTL::distance(first, last))), hash, equal, alloc)
         {
             for (; first != last; ++first)
                 ht_.insert_unique_noresize(*first);
@@ -75,8 +84,9 @@ namespace mySTL
         unordered_set(std::initializer_list<value_type> ilist,
                       const size_type bucket_count = 100,
                       const Hash &hash = Hash(),
-                      const KeyEqual &equal = KeyEqual())
-            : ht_(mySTL::max(bucket_count, static_cast<size_type>(ilist.size())), hash, equal)
+                      const KeyEqual &equal = KeyEqual(),
+                      const allocator_type &alloc = allocator_type())
+            : ht_(mySTL::max(bucket_count, static_cast<size_type>(ilist.size())), hash, equal, alloc)
         {
             for (auto first = ilist.begin(), last = ilist.end(); first != last; ++first)
                 ht_.insert_unique_noresize(*first);
@@ -90,6 +100,14 @@ namespace mySTL
             : ht_(mySTL::move(rhs.ht_))
         {
         }
+        unordered_set(const unordered_set &rhs, const allocator_type &alloc)
+            : ht_(rhs.ht_, alloc)
+        {
+        }
+        unordered_set(unordered_set &&rhs, const allocator_type &alloc)
+            : ht_(mySTL::move(rhs.ht_), alloc)
+        {
+        }
 
         unordered_set &operator=(const unordered_set &rhs)
         {
@@ -313,23 +331,23 @@ namespace mySTL
     };
         // 重载比较操作符
     template <class Key, class Hash, class KeyEqual, class Alloc>
-    bool operator==(const unordered_set<Key, Hash, KeyEqual> &lhs,
-                    const unordered_set<Key, Hash, KeyEqual> &rhs)
+    bool operator==(const unordered_set<Key, Hash, KeyEqual, Alloc> &lhs,
+                    const unordered_set<Key, Hash, KeyEqual, Alloc> &rhs)
     {
         return lhs == rhs;
     }
 
     template <class Key, class Hash, class KeyEqual, class Alloc>
-    bool operator!=(const unordered_set<Key, Hash, KeyEqual> &lhs,
-                    const unordered_set<Key, Hash, KeyEqual> &rhs)
+    bool operator!=(const unordered_set<Key, Hash, KeyEqual, Alloc> &lhs,
+                    const unordered_set<Key, Hash, KeyEqual, Alloc> &rhs)
     {
         return lhs != rhs;
     }
 
     // 重载 mySTL 的 swap
     template <class Key, class Hash, class KeyEqual, class Alloc>
-    void swap(unordered_set<Key, Hash, KeyEqual> &lhs,
-                unordered_set<Key, Hash, KeyEqual> &rhs)
+    void swap(unordered_set<Key, Hash, KeyEqual, Alloc> &lhs,
+                unordered_set<Key, Hash, KeyEqual, Alloc> &rhs)
     {
         lhs.swap(rhs);
     }
@@ -337,13 +355,15 @@ namespace mySTL
     // 模板类 unordered_multiset，键值允许重复
     // 参数一代表键值类型，参数二代表哈希函数，缺省使用 mySTL::hash，
     // 参数三代表键值比较方式，缺省使用 mySTL::equal_to
+    // 参数四代表空间配置器类型，缺省使用 mySTL::allocator
 
-    template <class Key, class Hash = mySTL::hash<Key>, class KeyEqual = mySTL::equal_to<Key>>
+    template <class Key, class Hash = mySTL::hash<Key>, class KeyEqual = mySTL::equal_to<Key>,
+              class Alloc = mySTL::allocator<Key>>
     class unordered_multiset
     {
     private:
         // 使用 hashtable 作为底层机制
-        typedef hashtable<Key, Hash, KeyEqual> base_type;
+        typedef hashtable<Key, Hash, KeyEqual, Alloc> base_type;
         base_type ht_;
 
     public:
@@ -376,10 +396,16 @@ namespace mySTL
         {
         }
 
+        explicit unordered_multiset(const allocator_type &alloc)
+            : ht_(100, Hash(), KeyEqual(), alloc)
+        {
+        }
+
         explicit unordered_multiset(size_type bucket_count,
                                     const Hash &hash = Hash(),
-                                    const KeyEqual &equal = KeyEqual())
-            : ht_(bucket_count, hash, equal)
+                                    const KeyEqual &equal = KeyEqual(),
+                                    const allocator_type &alloc = allocator_type())
+            : ht_(bucket_count, hash, equal, alloc)
         {
         }
 
@@ -387,8 +413,9 @@ namespace mySTL
         unordered_multiset(InputIterator first, InputIterator last,
                            const size_type bucket_count = 100,
                            const Hash &hash = Hash(),
-                           const KeyEqual &equal = KeyEqual())
-            : ht_(mySTL::max(bucket_count, static_cast<size_type>(mySTL::distance(first, last))), hash, equal)
+                           const KeyEqual &equal = KeyEqual(),
+                           const allocator_type &alloc = allocator_type())
+            : ht_(mySTL::max(bucket_count, static_cast<size_type>(mySTL::distance(first, last))), hash, equal, alloc)
         {
             for (; first != last; ++first)
                 ht_.insert_multi_noresize(*first);
@@ -397,8 +424,9 @@ namespace mySTL
         unordered_multiset(std::initializer_list<value_type> ilist,
                            const size_type bucket_count = 100,
                            const Hash &hash = Hash(),
-                           const KeyEqual &equal = KeyEqual())
-            : ht_(mySTL::max(bucket_count, static_cast<size_type>(ilist.size())), hash, equal)
+                           const KeyEqual &equal = KeyEqual(),
+                           const allocator_type &alloc = allocator_type())
+            : ht_(mySTL::max(bucket_count, static_cast<size_type>(ilist.size())), hash, equal, alloc)
         {
             for (auto first = ilist.begin(), last = ilist.end(); first != last; ++first)
                 ht_.insert_multi_noresize(*first);
@@ -412,6 +440,14 @@ namespace mySTL
             : ht_(mySTL::move(rhs.ht_))
         {
         }
+        unordered_multiset(const unordered_multiset &rhs, const allocator_type &alloc)
+            : ht_(rhs.ht_, alloc)
+        {
+        }
+        unordered_multiset(unordered_multiset &&rhs, const allocator_type &alloc)
+            : ht_(mySTL::move(rhs.ht_), alloc)
+        {
+        }
 
         unordered_multiset &operator=(const unordered_multiset &rhs)
         {
@@ -634,23 +670,23 @@ namespace mySTL
 
     // 重载比较操作符
     template <class Key, class Hash, class KeyEqual, class Alloc>
-    bool operator==(const unordered_multiset<Key, Hash, KeyEqual> &lhs,
-                    const unordered_multiset<Key, Hash, KeyEqual> &rhs)
+    bool operator==(const unordered_multiset<Key, Hash, KeyEqual, Alloc> &lhs,
+                    const unordered_multiset<Key, Hash, KeyEqual, Alloc> &rhs)
     {
         return lhs == rhs;
     }
 
     template <class Key, class Hash, class KeyEqual, class Alloc>
-    bool operator!=(const unordered_multiset<Key, Hash, KeyEqual> &lhs,
-                    const unordered_multiset<Key, Hash, KeyEqual> &rhs)
+    bool operator!=(const unordered_multiset<Key, Hash, KeyEqual, Alloc> &lhs,
+                    const unordered_multiset<Key, Hash, KeyEqual, Alloc> &rhs)
     {
         return lhs != rhs;
     }
 
     // 重载 mySTL 的 swap
     template <class Key, class Hash, class KeyEqual, class Alloc>
-    void swap(unordered_multiset<Key, Hash, KeyEqual> &lhs,
-              unordered_multiset<Key, Hash, KeyEqual> &rhs)
+    void swap(unordered_multiset<Key, Hash, KeyEqual, Alloc> &lhs,
+              unordered_multiset<Key, Hash, KeyEqual, Alloc> &rhs)
     {
         lhs.swap(rhs);
     }
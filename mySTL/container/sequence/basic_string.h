@@ -11,6 +11,7 @@
 #include "../../util/util.h"
 #include "../../util/exceptdef.h"
 #include "../../allocator/allocator.h"
+#include "../../allocator/allocator_traits.h"
 
 namespace mySTL
 {
@@ -268,30 +269,33 @@ namespace mySTL
 // 初始化 basic_string 尝试分配的最小 buffer 大小，可能被忽略
 #define STRING_INIT_SIZE 32
 
-    template <class CharType, class CharTraits = mySTL::char_traits<CharType>>
+    template <class CharType, class CharTraits = mySTL::char_traits<CharType>,
+              class Alloc = mySTL::allocator<CharType>>
     class basic_string
+        : private mySTL::alloc_holder<typename mySTL::allocator_traits<Alloc>::template rebind_alloc<CharType>>
     {
     public:
         typedef CharTraits traits_type;
         typedef CharTraits char_traits;
 
-        typedef mySTL::allocator<CharType> allocator_type;
-        typedef mySTL::allocator<CharType> data_allocator;
+        typedef Alloc allocator_type;
+        typedef typename mySTL::allocator_traits<Alloc>::template rebind_alloc<CharType> data_allocator;
+        typedef mySTL::allocator_traits<data_allocator> data_traits;
 
-        typedef typename allocator_type::value_type value_type;
-        typedef typename allocator_type::pointer pointer;
-        typedef typename allocator_type::const_pointer const_pointer;
-        typedef typename allocator_type::reference reference;
-        typedef typename allocator_type::const_reference const_reference;
-        typedef typename allocator_type::size_type size_type;
-        typedef typename allocator_type::difference_type difference_type;
+        typedef typename data_traits::value_type value_type;
+        typedef typename data_traits::pointer pointer;
+        typedef typename data_traits::const_pointer const_pointer;
+        typedef value_type &reference;
+        typedef const value_type &const_reference;
+        typedef typename data_traits::size_type size_type;
+        typedef typename data_traits::difference_type difference_type;
 
         typedef value_type *iterator;
         typedef const value_type *const_iterator;
         typedef mySTL::reverse_iterator<iterator> reverse_iterator;
         typedef mySTL::reverse_iterator<const_iterator> const_reverse_iterator;
 
-        allocator_type get_allocator() { return allocator_type(); }
+        allocator_type get_allocator() const { return allocator_type(this->alloc_ref()); }
 
         static_assert(std::is_pod<CharType>::value, "Character type of basic_string must be a POD");
         static_assert(std::is_same<CharType, typename traits_type::char_type>::value,
@@ -303,9 +307,11 @@ namespace mySTL
         static constexpr size_type npos = static_cast<size_type>(-1);
 
     private:
+        typedef mySTL::alloc_holder<data_allocator> alloc_base;
+
         iterator buffer_; // 储存字符串的起始位置
         size_type size_;  // 大小
-        size_type cap_;   // 容量
+        size_type cap_;   // 容量，buffer 实际多分配一个位置用于存放结尾的空字符
 
     public:
         // 构造、复制、移动、析构函数
@@ -315,56 +321,90 @@ namespace mySTL
             try_init();
         }
 
-        basic_string(size_type n, value_type ch)
-            : buffer_(nullptr), size_(0), cap_(0)
+        explicit basic_string(const allocator_type &alloc) noexcept
+            : alloc_base(data_allocator(alloc))
+        {
+            try_init();
+        }
+
+        basic_string(size_type n, value_type ch,
+                     const allocator_type &alloc = allocator_type())
+            : alloc_base(data_allocator(alloc)), buffer_(nullptr), size_(0), cap_(0)
         {
             fill_init(n, ch);
         }
 
-        basic_string(const basic_string &other, size_type pos)
-            : buffer_(nullptr), size_(0), cap_(0)
+        basic_string(const basic_string &other, size_type pos,
+                     const allocator_type &alloc = allocator_type())
+            : alloc_base(data_allocator(alloc)), buffer_(nullptr), size_(0), cap_(0)
         {
             init_from(other.buffer_, pos, other.size_ - pos);
         }
-        basic_string(const basic_string &other, size_type pos, size_type count)
-            : buffer_(nullptr), size_(0), cap_(0)
+        basic_string(const basic_string &other, size_type pos, size_type count,
+                     const allocator_type &alloc = allocator_type())
+            : alloc_base(data_allocator(alloc)), buffer_(nullptr), size_(0), cap_(0)
         {
             init_from(other.buffer_, pos, count);
         }
 
-        basic_string(const_pointer str)
-            : buffer_(nullptr), size_(0), cap_(0)
+        basic_string(const_pointer str,
+                     const allocator_type &alloc = allocator_type())
+            : alloc_base(data_allocator(alloc)), buffer_(nullptr), size_(0), cap_(0)
         {
             init_from(str, 0, char_traits::length(str));
         }
-        basic_string(const_pointer str, size_type count)
-            : buffer_(nullptr), size_(0), cap_(0)
+        basic_string(const_pointer str, size_type count,
+                     const allocator_type &alloc = allocator_type())
+            : alloc_base(data_allocator(alloc)), buffer_(nullptr), size_(0), cap_(0)
         {
             init_from(str, 0, count);
         }
 
         template <class Iter, typename std::enable_if<
                                   mySTL::is_input_iterator<Iter>::value, int>::type = 0>
-        basic_string(Iter first, Iter last)
+        basic_string(Iter first, Iter last,
+                     const allocator_type &alloc = allocator_type())
+            : alloc_base(data_allocator(alloc))
         {
             copy_init(first, last, iterator_category(first));
         }
 
         basic_string(const basic_string &rhs)
-            : buffer_(nullptr), size_(0), cap_(0)
+            : alloc_base(data_traits::select_on_container_copy_construction(rhs.alloc_ref())),
+              buffer_(nullptr), size_(0), cap_(0)
+        {
+            init_from(rhs.buffer_, 0, rhs.size_);
+        }
+        basic_string(const basic_string &rhs, const allocator_type &alloc)
+            : alloc_base(data_allocator(alloc)), buffer_(nullptr), size_(0), cap_(0)
         {
             init_from(rhs.buffer_, 0, rhs.size_);
         }
         basic_string(basic_string &&rhs) noexcept
-            : buffer_(rhs.buffer_), size_(rhs.size_), cap_(rhs.cap_)
+            : alloc_base(mySTL::move(rhs.alloc_ref())),
+              buffer_(rhs.buffer_), size_(rhs.size_), cap_(rhs.cap_)
         {
             rhs.buffer_ = nullptr;
             rhs.size_ = 0;
             rhs.cap_ = 0;
         }
+        basic_string(basic_string &&rhs, const allocator_type &alloc)
+            : alloc_base(data_allocator(alloc)), buffer_(nullptr), size_(0), cap_(0)
+        {
+            if (mySTL::alloc_equal(this->alloc_ref(), rhs.alloc_ref()))
+            {
+                swap_data(rhs);
+            }
+            else
+            {
+                init_from(rhs.buffer_, 0, rhs.size_);
+            }
+        }
 
         basic_string &operator=(const basic_string &rhs);
-        basic_string &operator=(basic_string &&rhs) noexcept;
+        basic_string &operator=(basic_string &&rhs) noexcept(
+            data_traits::propagate_on_container_move_assignment::value ||
+            data_traits::is_always_equal::value);
 
         basic_string &operator=(const_pointer str);
         basic_string &operator=(value_type ch);
@@ -567,6 +607,14 @@ namespace mySTL
         }
         void resize(size_type count, value_type ch);
 
+        // 新增的字符不初始化，留给调用者随后写入
+        void resize_default_init(size_type count);
+
+        // 在末尾预留 count 个未初始化的字符，交给 writer(p, count) 写入，
+        // writer 返回实际写入的个数 m (m <= count)，字符串只保留前 m 个
+        template <class Writer>
+        basic_string &reserve_and_append(size_type count, Writer writer);
+
         void clear() noexcept
         {
             size_ = 0;
@@ -759,6 +807,11 @@ namespace mySTL
         template <class Iter>
         basic_string &replace_copy(const_iterator first, const_iterator last, Iter first2, Iter last2);
 
+        // buffer
+        pointer allocate_buffer(size_type n);
+        void deallocate_buffer(pointer p, size_type n) noexcept;
+        void swap_data(basic_string &rhs) noexcept;
+
         // reallocate
         void reallocate(size_type need);
         iterator reallocate_and_fill(iterator pos, size_type n, value_type ch);
@@ -766,46 +819,61 @@ namespace mySTL
     };
 
     // 复制赋值操作符
-    template <class CharType, class CharTraits>
-    basic_string<CharType, CharTraits> &
-    basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    basic_string<CharType, CharTraits, Alloc> &
+    basic_string<CharType, CharTraits, Alloc>::
     operator=(const basic_string &rhs)
     {
         if (this != &rhs)
         {
-            basic_string tmp(rhs);
-            swap(tmp);
+            typedef typename data_traits::propagate_on_container_copy_assignment pocca;
+            if (pocca::value && !mySTL::alloc_equal(this->alloc_ref(), rhs.alloc_ref()))
+            { // 旧的 buffer 只能由原来的分配器释放
+                destroy_buffer();
+                mySTL::alloc_copy_assign(this->alloc_ref(), rhs.alloc_ref(), pocca());
+            }
+            basic_string tmp(rhs, get_allocator());
+            swap_data(tmp);
         }
         return *this;
     }
 
     // 移动赋值操作符
-    template <class CharType, class CharTraits>
-    basic_string<CharType, CharTraits> &
-    basic_string<CharType, CharTraits>::
-    operator=(basic_string &&rhs) noexcept
-    {
-        destroy_buffer();
-        buffer_ = rhs.buffer_;
-        size_ = rhs.size_;
-        cap_ = rhs.cap_;
-        rhs.buffer_ = nullptr;
-        rhs.size_ = 0;
-        rhs.cap_ = 0;
+    template <class CharType, class CharTraits, class Alloc>
+    basic_string<CharType, CharTraits, Alloc> &
+    basic_string<CharType, CharTraits, Alloc>::
+    operator=(basic_string &&rhs) noexcept(
+        data_traits::propagate_on_container_move_assignment::value ||
+        data_traits::is_always_equal::value)
+    {
+        if (this == &rhs)
+            return *this;
+        typedef typename data_traits::propagate_on_container_move_assignment pocma;
+        if (pocma::value || mySTL::alloc_equal(this->alloc_ref(), rhs.alloc_ref()))
+        {
+            destroy_buffer();
+            mySTL::alloc_move_assign(this->alloc_ref(), rhs.alloc_ref(), pocma());
+            swap_data(rhs);
+        }
+        else
+        { // 分配器不相等且不传播，只能复制字符
+            basic_string tmp(rhs, get_allocator());
+            swap_data(tmp);
+        }
         return *this;
     }
 
     // 用一个字符串赋值
-    template <class CharType, class CharTraits>
-    basic_string<CharType, CharTraits> &
-    basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    basic_string<CharType, CharTraits, Alloc> &
+    basic_string<CharType, CharTraits, Alloc>::
     operator=(const_pointer str)
     {
         const size_type len = char_traits::length(str);
         if (cap_ < len)
         {
-            auto new_buffer = data_allocator::allocate(len + 1);
-            data_allocator::deallocate(buffer_);
+            auto new_buffer = allocate_buffer(len + 1);
+            deallocate_buffer(buffer_, cap_);
             buffer_ = new_buffer;
             cap_ = len + 1;
         }
@@ -815,15 +883,15 @@ namespace mySTL
     }
 
     // 用一个字符赋值
-    template <class CharType, class CharTraits>
-    basic_string<CharType, CharTraits> &
-    basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    basic_string<CharType, CharTraits, Alloc> &
+    basic_string<CharType, CharTraits, Alloc>::
     operator=(value_type ch)
     {
         if (cap_ < 1)
         {
-            auto new_buffer = data_allocator::allocate(2);
-            data_allocator::deallocate(buffer_);
+            auto new_buffer = allocate_buffer(2);
+            deallocate_buffer(buffer_, cap_);
             buffer_ = new_buffer;
             cap_ = 2;
         }
@@ -833,24 +901,25 @@ namespace mySTL
     }
 
     // 预留储存空间
-    template <class CharType, class CharTraits>
-    void basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    void basic_string<CharType, CharTraits, Alloc>::
         reserve(size_type n)
     {
         if (cap_ < n)
         {
             THROW_LENGTH_ERROR_IF(n > max_size(), "n can not larger than max_size()"
                                                   "in basic_string<Char,Traits>::reserve(n)");
-            auto new_buffer = data_allocator::allocate(n);
+            auto new_buffer = allocate_buffer(n);
             char_traits::move(new_buffer, buffer_, size_);
+            deallocate_buffer(buffer_, cap_);
             buffer_ = new_buffer;
             cap_ = n;
         }
     }
 
     // 减少不用的空间
-    template <class CharType, class CharTraits>
-    void basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    void basic_string<CharType, CharTraits, Alloc>::
         shrink_to_fit()
     {
         if (size_ != cap_)
@@ -860,9 +929,9 @@ namespace mySTL
     }
 
     // 在 pos 处插入一个元素
-    template <class CharType, class CharTraits>
-    typename basic_string<CharType, CharTraits>::iterator
-    basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    typename basic_string<CharType, CharTraits, Alloc>::iterator
+    basic_string<CharType, CharTraits, Alloc>::
         insert(const_iterator pos, value_type ch)
     {
         iterator r = const_cast<iterator>(pos);
@@ -877,9 +946,9 @@ namespace mySTL
     }
 
     // 在 pos 处插入 n 个元素
-    template <class CharType, class CharTraits>
-    typename basic_string<CharType, CharTraits>::iterator
-    basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    typename basic_string<CharType, CharTraits, Alloc>::iterator
+    basic_string<CharType, CharTraits, Alloc>::
         insert(const_iterator pos, size_type count, value_type ch)
     {
         iterator r = const_cast<iterator>(pos);
@@ -902,10 +971,10 @@ namespace mySTL
     }
 
     // 在 pos 处插入 [first, last) 内的元素
-    template <class CharType, class CharTraits>
+    template <class CharType, class CharTraits, class Alloc>
     template <class Iter>
-    typename basic_string<CharType, CharTraits>::iterator
-    basic_string<CharType, CharTraits>::
+    typename basic_string<CharType, CharTraits, Alloc>::iterator
+    basic_string<CharType, CharTraits, Alloc>::
         insert(const_iterator pos, Iter first, Iter last)
     {
         iterator r = const_cast<iterator>(pos);
@@ -929,9 +998,9 @@ namespace mySTL
     }
 
     // 在末尾添加 count 个 ch
-    template <class CharType, class CharTraits>
-    basic_string<CharType, CharTraits> &
-    basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    basic_string<CharType, CharTraits, Alloc> &
+    basic_string<CharType, CharTraits, Alloc>::
         append(size_type count, value_type ch)
     {
         THROW_LENGTH_ERROR_IF(size_ > max_size() - count,
@@ -946,9 +1015,9 @@ namespace mySTL
     }
 
     // 在末尾添加 [str[pos] str[pos+count]) 一段
-    template <class CharType, class CharTraits>
-    basic_string<CharType, CharTraits> &
-    basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    basic_string<CharType, CharTraits, Alloc> &
+    basic_string<CharType, CharTraits, Alloc>::
         append(const basic_string &str, size_type pos, size_type count)
     {
         THROW_LENGTH_ERROR_IF(size_ > max_size() - count,
@@ -965,9 +1034,9 @@ namespace mySTL
     }
 
     // 在末尾添加 [s, s+count) 一段
-    template <class CharType, class CharTraits>
-    basic_string<CharType, CharTraits> &
-    basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    basic_string<CharType, CharTraits, Alloc> &
+    basic_string<CharType, CharTraits, Alloc>::
         append(const_pointer s, size_type count)
     {
         THROW_LENGTH_ERROR_IF(size_ > max_size() - count,
@@ -982,9 +1051,9 @@ namespace mySTL
     }
 
     // 删除 pos 处的元素
-    template <class CharType, class CharTraits>
-    typename basic_string<CharType, CharTraits>::iterator
-    basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    typename basic_string<CharType, CharTraits, Alloc>::iterator
+    basic_string<CharType, CharTraits, Alloc>::
         erase(const_iterator pos)
     {
         MYSTL_DEBUG(pos != end());
@@ -995,9 +1064,9 @@ namespace mySTL
     }
 
     // 删除 [first, last) 的元素
-    template <class CharType, class CharTraits>
-    typename basic_string<CharType, CharTraits>::iterator
-    basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    typename basic_string<CharType, CharTraits, Alloc>::iterator
+    basic_string<CharType, CharTraits, Alloc>::
         erase(const_iterator first, const_iterator last)
     {
         if (first == begin() && last == end())
@@ -1013,8 +1082,8 @@ namespace mySTL
     }
 
     // 重置容器大小
-    template <class CharType, class CharTraits>
-    void basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    void basic_string<CharType, CharTraits, Alloc>::
         resize(size_type count, value_type ch)
     {
         if (count < size_)
@@ -1027,17 +1096,54 @@ namespace mySTL
         }
     }
 
+    // 重置容器大小，新增的字符不初始化
+    template <class CharType, class CharTraits, class Alloc>
+    void basic_string<CharType, CharTraits, Alloc>::
+        resize_default_init(size_type count)
+    {
+        if (count < size_)
+        {
+            erase(buffer_ + count, buffer_ + size_);
+            return;
+        }
+        THROW_LENGTH_ERROR_IF(count > max_size(), "basic_string<Char, Tratis>'s size too big");
+        if (cap_ < count)
+        {
+            reallocate(count - size_);
+        }
+        size_ = count;
+    }
+
+    // 在末尾预留 count 个字符交给 writer 写入
+    template <class CharType, class CharTraits, class Alloc>
+    template <class Writer>
+    basic_string<CharType, CharTraits, Alloc> &
+    basic_string<CharType, CharTraits, Alloc>::
+        reserve_and_append(size_type count, Writer writer)
+    {
+        THROW_LENGTH_ERROR_IF(size_ > max_size() - count,
+                              "basic_string<Char, Tratis>'s size too big");
+        if (cap_ - size_ < count)
+        {
+            reallocate(count);
+        }
+        const size_type written = writer(buffer_ + size_, count);
+        MYSTL_DEBUG(written <= count);
+        size_ += written;
+        return *this;
+    }
+
     // 比较两个 basic_string，小于返回 -1，大于返回 1，等于返回 0
-    template <class CharType, class CharTraits>
-    int basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    int basic_string<CharType, CharTraits, Alloc>::
         compare(const basic_string &other) const
     {
         return compare_cstr(buffer_, size_, other.buffer_, other.size_);
     }
 
     // 从 pos1 下标开始的 count1 个字符跟另一个 basic_string 比较
-    template <class CharType, class CharTraits>
-    int basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    int basic_string<CharType, CharTraits, Alloc>::
         compare(size_type pos1, size_type count1, const basic_string &other) const
     {
         auto n1 = mySTL::min(count1, size_ - pos1);
@@ -1045,8 +1151,8 @@ namespace mySTL
     }
 
     // 从 pos1 下标开始的 count1 个字符跟另一个 basic_string 下标 pos2 开始的 count2 个字符比较
-    template <class CharType, class CharTraits>
-    int basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    int basic_string<CharType, CharTraits, Alloc>::
         compare(size_type pos1, size_type count1, const basic_string &other,
                 size_type pos2, size_type count2) const
     {
@@ -1056,8 +1162,8 @@ namespace mySTL
     }
 
     // 跟一个字符串比较
-    template <class CharType, class CharTraits>
-    int basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    int basic_string<CharType, CharTraits, Alloc>::
         compare(const_pointer s) const
     {
         auto n2 = char_traits::length(s);
@@ -1065,8 +1171,8 @@ namespace mySTL
     }
 
     // 从下标 pos1 开始的 count1 个字符跟另一个字符串比较
-    template <class CharType, class CharTraits>
-    int basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    int basic_string<CharType, CharTraits, Alloc>::
         compare(size_type pos1, size_type count1, const_pointer s) const
     {
         auto n1 = mySTL::min(count1, size_ - pos1);
@@ -1075,8 +1181,8 @@ namespace mySTL
     }
 
     // 从下标 pos1 开始的 count1 个字符跟另一个字符串的前 count2 个字符比较
-    template <class CharType, class CharTraits>
-    int basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    int basic_string<CharType, CharTraits, Alloc>::
         compare(size_type pos1, size_type count1, const_pointer s, size_type count2) const
     {
         auto n1 = mySTL::min(count1, size_ - pos1);
@@ -1084,8 +1190,8 @@ namespace mySTL
     }
 
     // 反转 basic_string
-    template <class CharType, class CharTraits>
-    void basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    void basic_string<CharType, CharTraits, Alloc>::
         reverse() noexcept
     {
         for (auto i = begin(), j = end(); i < j;)
@@ -1095,22 +1201,23 @@ namespace mySTL
     }
 
     // 交换两个 basic_string
-    template <class CharType, class CharTraits>
-    void basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    void basic_string<CharType, CharTraits, Alloc>::
         swap(basic_string &rhs) noexcept
     {
         if (this != &rhs)
         {
-            mySTL::swap(buffer_, rhs.buffer_);
-            mySTL::swap(size_, rhs.size_);
-            mySTL::swap(cap_, rhs.cap_);
+            typedef typename data_traits::propagate_on_container_swap pocs;
+            MYSTL_DEBUG(pocs::value || mySTL::alloc_equal(this->alloc_ref(), rhs.alloc_ref()));
+            mySTL::alloc_swap(this->alloc_ref(), rhs.alloc_ref(), pocs());
+            swap_data(rhs);
         }
     }
 
     // 从下标 pos 开始查找字符为 ch 的元素，若找到返回其下标，否则返回 npos
-    template <class CharType, class CharTraits>
-    typename basic_string<CharType, CharTraits>::size_type
-    basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    typename basic_string<CharType, CharTraits, Alloc>::size_type
+    basic_string<CharType, CharTraits, Alloc>::
         find(value_type ch, size_type pos) const noexcept
     {
         for (auto i = pos; i < size_; ++i)
@@ -1122,9 +1229,9 @@ namespace mySTL
     }
 
     // 从下标 pos 开始查找字符串 str，若找到返回起始位置的下标，否则返回 npos
-    template <class CharType, class CharTraits>
-    typename basic_string<CharType, CharTraits>::size_type
-    basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    typename basic_string<CharType, CharTraits, Alloc>::size_type
+    basic_string<CharType, CharTraits, Alloc>::
         find(const_pointer str, size_type pos) const noexcept
     {
         const auto len = char_traits::length(str);
@@ -1151,9 +1258,9 @@ namespace mySTL
     }
 
     // 从下标 pos 开始查找字符串 str 的前 count 个字符，若找到返回起始位置的下标，否则返回 npos
-    template <class CharType, class CharTraits>
-    typename basic_string<CharType, CharTraits>::size_type
-    basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    typename basic_string<CharType, CharTraits, Alloc>::size_type
+    basic_string<CharType, CharTraits, Alloc>::
         find(const_pointer str, size_type pos, size_type count) const noexcept
     {
         if (count == 0)
@@ -1179,9 +1286,9 @@ namespace mySTL
     }
 
     // 从下标 pos 开始查找字符串 str，若找到返回起始位置的下标，否则返回 npos
-    template <class CharType, class CharTraits>
-    typename basic_string<CharType, CharTraits>::size_type
-    basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    typename basic_string<CharType, CharTraits, Alloc>::size_type
+    basic_string<CharType, CharTraits, Alloc>::
         find(const basic_string &str, size_type pos) const noexcept
     {
         const size_type count = str.size_;
@@ -1208,9 +1315,9 @@ namespace mySTL
     }
 
     // 从下标 pos 开始反向查找值为 ch 的元素，与 find 类似
-    template <class CharType, class CharTraits>
-    typename basic_string<CharType, CharTraits>::size_type
-    basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    typename basic_string<CharType, CharTraits, Alloc>::size_type
+    basic_string<CharType, CharTraits, Alloc>::
         rfind(value_type ch, size_type pos) const noexcept
     {
         if (pos >= size_)
@@ -1224,9 +1331,9 @@ namespace mySTL
     }
 
     // 从下标 pos 开始反向查找字符串 str，与 find 类似
-    template <class CharType, class CharTraits>
-    typename basic_string<CharType, CharTraits>::size_type
-    basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    typename basic_string<CharType, CharTraits, Alloc>::size_type
+    basic_string<CharType, CharTraits, Alloc>::
         rfind(const_pointer str, size_type pos) const noexcept
     {
         if (pos >= size_)
@@ -1268,9 +1375,9 @@ namespace mySTL
     }
 
     // 从下标 pos 开始反向查找字符串 str 前 count 个字符，与 find 类似
-    template <class CharType, class CharTraits>
-    typename basic_string<CharType, CharTraits>::size_type
-    basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    typename basic_string<CharType, CharTraits, Alloc>::size_type
+    basic_string<CharType, CharTraits, Alloc>::
         rfind(const_pointer str, size_type pos, size_type count) const noexcept
     {
         if (count == 0)
@@ -1297,9 +1404,9 @@ namespace mySTL
     }
 
     // 从下标 pos 开始反向查找字符串 str，与 find 类似
-    template <class CharType, class CharTraits>
-    typename basic_string<CharType, CharTraits>::size_type
-    basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    typename basic_string<CharType, CharTraits, Alloc>::size_type
+    basic_string<CharType, CharTraits, Alloc>::
         rfind(const basic_string &str, size_type pos) const noexcept
     {
         const size_type count = str.size_;
@@ -1327,9 +1434,9 @@ namespace mySTL
     }
 
     // 从下标 pos 开始查找 ch 出现的第一个位置
-    template <class CharType, class CharTraits>
-    typename basic_string<CharType, CharTraits>::size_type
-    basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    typename basic_string<CharType, CharTraits, Alloc>::size_type
+    basic_string<CharType, CharTraits, Alloc>::
         find_first_of(value_type ch, size_type pos) const noexcept
     {
         for (auto i = pos; i < size_; ++i)
@@ -1341,9 +1448,9 @@ namespace mySTL
     }
 
     // 从下标 pos 开始查找字符串 s 其中的一个字符出现的第一个位置
-    template <class CharType, class CharTraits>
-    typename basic_string<CharType, CharTraits>::size_type
-    basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    typename basic_string<CharType, CharTraits, Alloc>::size_type
+    basic_string<CharType, CharTraits, Alloc>::
         find_first_of(const_pointer s, size_type pos) const noexcept
     {
         const size_type len = char_traits::length(s);
@@ -1360,9 +1467,9 @@ namespace mySTL
     }
 
     // 从下标 pos 开始查找字符串 s
-    template <class CharType, class CharTraits>
-    typename basic_string<CharType, CharTraits>::size_type
-    basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    typename basic_string<CharType, CharTraits, Alloc>::size_type
+    basic_string<CharType, CharTraits, Alloc>::
         find_first_of(const_pointer s, size_type pos, size_type count) const noexcept
     {
         for (auto i = pos; i < size_; ++i)
@@ -1378,9 +1485,9 @@ namespace mySTL
     }
 
     // 从下标 pos 开始查找字符串 str 其中一个字符出现的第一个位置
-    template <class CharType, class CharTraits>
-    typename basic_string<CharType, CharTraits>::size_type
-    basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    typename basic_string<CharType, CharTraits, Alloc>::size_type
+    basic_string<CharType, CharTraits, Alloc>::
         find_first_of(const basic_string &str, size_type pos) const noexcept
     {
         for (auto i = pos; i < size_; ++i)
@@ -1396,9 +1503,9 @@ namespace mySTL
     }
 
     // 从下标 pos 开始查找与 ch 不相等的第一个位置
-    template <class CharType, class CharTraits>
-    typename basic_string<CharType, CharTraits>::size_type
-    basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    typename basic_string<CharType, CharTraits, Alloc>::size_type
+    basic_string<CharType, CharTraits, Alloc>::
         find_first_not_of(value_type ch, size_type pos) const noexcept
     {
         for (auto i = pos; i < size_; ++i)
@@ -1410,9 +1517,9 @@ namespace mySTL
     }
 
     // 从下标 pos 开始查找与字符串 s 其中一个字符不相等的第一个位置
-    template <class CharType, class CharTraits>
-    typename basic_string<CharType, CharTraits>::size_type
-    basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    typename basic_string<CharType, CharTraits, Alloc>::size_type
+    basic_string<CharType, CharTraits, Alloc>::
         find_first_not_of(const_pointer s, size_type pos) const noexcept
     {
         const size_type len = char_traits::length(s);
@@ -1429,9 +1536,9 @@ namespace mySTL
     }
 
     // 从下标 pos 开始查找与字符串 s 前 count 个字符中不相等的第一个位置
-    template <class CharType, class CharTraits>
-    typename basic_string<CharType, CharTraits>::size_type
-    basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    typename basic_string<CharType, CharTraits, Alloc>::size_type
+    basic_string<CharType, CharTraits, Alloc>::
         find_first_not_of(const_pointer s, size_type pos, size_type count) const noexcept
     {
         for (auto i = pos; i < size_; ++i)
@@ -1447,9 +1554,9 @@ namespace mySTL
     }
 
     // 从下标 pos 开始查找与字符串 str 的字符中不相等的第一个位置
-    template <class CharType, class CharTraits>
-    typename basic_string<CharType, CharTraits>::size_type
-    basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    typename basic_string<CharType, CharTraits, Alloc>::size_type
+    basic_string<CharType, CharTraits, Alloc>::
         find_first_not_of(const basic_string &str, size_type pos) const noexcept
     {
         for (auto i = pos; i < size_; ++i)
@@ -1465,9 +1572,9 @@ namespace mySTL
     }
 
     // 从下标 pos 开始查找与 ch 相等的最后一个位置
-    template <class CharType, class CharTraits>
-    typename basic_string<CharType, CharTraits>::size_type
-    basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    typename basic_string<CharType, CharTraits, Alloc>::size_type
+    basic_string<CharType, CharTraits, Alloc>::
         find_last_of(value_type ch, size_type pos) const noexcept
     {
         for (auto i = size_ - 1; i >= pos; --i)
@@ -1479,9 +1586,9 @@ namespace mySTL
     }
 
     // 从下标 pos 开始查找与字符串 s 其中一个字符相等的最后一个位置
-    template <class CharType, class CharTraits>
-    typename basic_string<CharType, CharTraits>::size_type
-    basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    typename basic_string<CharType, CharTraits, Alloc>::size_type
+    basic_string<CharType, CharTraits, Alloc>::
         find_last_of(const_pointer s, size_type pos) const noexcept
     {
         const size_type len = char_traits::length(s);
@@ -1498,9 +1605,9 @@ namespace mySTL
     }
 
     // 从下标 pos 开始查找与字符串 s 前 count 个字符中相等的最后一个位置
-    template <class CharType, class CharTraits>
-    typename basic_string<CharType, CharTraits>::size_type
-    basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    typename basic_string<CharType, CharTraits, Alloc>::size_type
+    basic_string<CharType, CharTraits, Alloc>::
         find_last_of(const_pointer s, size_type pos, size_type count) const noexcept
     {
         for (auto i = size_ - 1; i >= pos; --i)
@@ -1516,9 +1623,9 @@ namespace mySTL
     }
 
     // 从下标 pos 开始查找与字符串 str 字符中相等的最后一个位置
-    template <class CharType, class CharTraits>
-    typename basic_string<CharType, CharTraits>::size_type
-    basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    typename basic_string<CharType, CharTraits, Alloc>::size_type
+    basic_string<CharType, CharTraits, Alloc>::
         find_last_of(const basic_string &str, size_type pos) const noexcept
     {
         for (auto i = size_ - 1; i >= pos; --i)
@@ -1534,9 +1641,9 @@ namespace mySTL
     }
 
     // 从下标 pos 开始查找与 ch 字符不相等的最后一个位置
-    template <class CharType, class CharTraits>
-    typename basic_string<CharType, CharTraits>::size_type
-    basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    typename basic_string<CharType, CharTraits, Alloc>::size_type
+    basic_string<CharType, CharTraits, Alloc>::
         find_last_not_of(value_type ch, size_type pos) const noexcept
     {
         for (auto i = size_ - 1; i >= pos; --i)
@@ -1548,9 +1655,9 @@ namespace mySTL
     }
 
     // 从下标 pos 开始查找与字符串 s 的字符中不相等的最后一个位置
-    template <class CharType, class CharTraits>
-    typename basic_string<CharType, CharTraits>::size_type
-    basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    typename basic_string<CharType, CharTraits, Alloc>::size_type
+    basic_string<CharType, CharTraits, Alloc>::
         find_last_not_of(const_pointer s, size_type pos) const noexcept
     {
         const size_type len = char_traits::length(s);
@@ -1567,9 +1674,9 @@ namespace mySTL
     }
 
     // 从下标 pos 开始查找与字符串 s 前 count 个字符中不相等的最后一个位置
-    template <class CharType, class CharTraits>
-    typename basic_string<CharType, CharTraits>::size_type
-    basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    typename basic_string<CharType, CharTraits, Alloc>::size_type
+    basic_string<CharType, CharTraits, Alloc>::
         find_last_not_of(const_pointer s, size_type pos, size_type count) const noexcept
     {
         for (auto i = size_ - 1; i >= pos; --i)
@@ -1585,9 +1692,9 @@ namespace mySTL
     }
 
     // 从下标 pos 开始查找与字符串 str 字符中不相等的最后一个位置
-    template <class CharType, class CharTraits>
-    typename basic_string<CharType, CharTraits>::size_type
-    basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    typename basic_string<CharType, CharTraits, Alloc>::size_type
+    basic_string<CharType, CharTraits, Alloc>::
         find_last_not_of(const basic_string &str, size_type pos) const noexcept
     {
         for (auto i = size_ - 1; i >= pos; --i)
@@ -1603,9 +1710,9 @@ namespace mySTL
     }
 
     // 返回从下标 pos 开始字符为 ch 的元素出现的次数
-    template <class CharType, class CharTraits>
-    typename basic_string<CharType, CharTraits>::size_type
-    basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    typename basic_string<CharType, CharTraits, Alloc>::size_type
+    basic_string<CharType, CharTraits, Alloc>::
         count(value_type ch, size_type pos) const noexcept
     {
         size_type n = 0;
@@ -1620,15 +1727,15 @@ namespace mySTL
     // helper function
 
     // 尝试初始化一段 buffer，若分配失败则忽略，不会抛出异常
-    template <class CharType, class CharTraits>
-    void basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    void basic_string<CharType, CharTraits, Alloc>::
         try_init() noexcept
     {
         try
         {
-            buffer_ = data_allocator::allocate(static_cast<size_type>(STRING_INIT_SIZE));
+            buffer_ = allocate_buffer(static_cast<size_type>(STRING_INIT_SIZE));
             size_ = 0;
-            cap_ = 0;
+            cap_ = static_cast<size_type>(STRING_INIT_SIZE);
         }
         catch (...)
         {
@@ -1640,28 +1747,28 @@ namespace mySTL
     }
 
     // fill_init 函数
-    template <class CharType, class CharTraits>
-    void basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    void basic_string<CharType, CharTraits, Alloc>::
         fill_init(size_type n, value_type ch)
     {
         const auto init_size = mySTL::max(static_cast<size_type>(STRING_INIT_SIZE), n + 1);
-        buffer_ = data_allocator::allocate(init_size);
+        buffer_ = allocate_buffer(init_size);
         char_traits::fill(buffer_, ch, n);
         size_ = n;
         cap_ = init_size;
     }
 
     // copy_init 函数
-    template <class CharType, class CharTraits>
+    template <class CharType, class CharTraits, class Alloc>
     template <class Iter>
-    void basic_string<CharType, CharTraits>::
+    void basic_string<CharType, CharTraits, Alloc>::
         copy_init(Iter first, Iter last, mySTL::input_iterator_tag)
     {
         size_type n = mySTL::distance(first, last);
         const auto init_size = mySTL::max(static_cast<size_type>(STRING_INIT_SIZE), n + 1);
         try
         {
-            buffer_ = data_allocator::allocate(init_size);
+            buffer_ = allocate_buffer(init_size);
             size_ = n;
             cap_ = init_size;
         }
@@ -1676,16 +1783,16 @@ namespace mySTL
             append(*first);
     }
 
-    template <class CharType, class CharTraits>
+    template <class CharType, class CharTraits, class Alloc>
     template <class Iter>
-    void basic_string<CharType, CharTraits>::
+    void basic_string<CharType, CharTraits, Alloc>::
         copy_init(Iter first, Iter last, mySTL::forward_iterator_tag)
     {
         const size_type n = mySTL::distance(first, last);
         const auto init_size = mySTL::max(static_cast<size_type>(STRING_INIT_SIZE), n + 1);
         try
         {
-            buffer_ = data_allocator::allocate(init_size);
+            buffer_ = allocate_buffer(init_size);
             size_ = n;
             cap_ = init_size;
             mySTL::uninitialized_copy(first, last, buffer_);
@@ -1700,25 +1807,25 @@ namespace mySTL
     }
 
     // init_from 函数
-    template <class CharType, class CharTraits>
-    void basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    void basic_string<CharType, CharTraits, Alloc>::
         init_from(const_pointer src, size_type pos, size_type count)
     {
         const auto init_size = mySTL::max(static_cast<size_type>(STRING_INIT_SIZE), count + 1);
-        buffer_ = data_allocator::allocate(init_size);
+        buffer_ = allocate_buffer(init_size);
         char_traits::copy(buffer_, src + pos, count);
         size_ = count;
         cap_ = init_size;
     }
 
     // destroy_buffer 函数
-    template <class CharType, class CharTraits>
-    void basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    void basic_string<CharType, CharTraits, Alloc>::
         destroy_buffer()
     {
         if (buffer_ != nullptr)
         {
-            data_allocator::deallocate(buffer_, cap_);
+            deallocate_buffer(buffer_, cap_);
             buffer_ = nullptr;
             size_ = 0;
             cap_ = 0;
@@ -1726,9 +1833,9 @@ namespace mySTL
     }
 
     // to_raw_pointer 函数
-    template <class CharType, class CharTraits>
-    typename basic_string<CharType, CharTraits>::const_pointer
-    basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    typename basic_string<CharType, CharTraits, Alloc>::const_pointer
+    basic_string<CharType, CharTraits, Alloc>::
         to_raw_pointer() const
     {
         *(buffer_ + size_) = value_type();
@@ -1736,29 +1843,23 @@ namespace mySTL
     }
 
     // reinsert 函数
-    template <class CharType, class CharTraits>
-    void basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    void basic_string<CharType, CharTraits, Alloc>::
         reinsert(size_type size)
     {
-        auto new_buffer = data_allocator::allocate(size);
-        try
-        {
-            char_traits::move(new_buffer, buffer_, size);
-        }
-        catch (...)
-        {
-            data_allocator::deallocate(new_buffer);
-        }
+        auto new_buffer = allocate_buffer(size);
+        char_traits::move(new_buffer, buffer_, size);
+        deallocate_buffer(buffer_, cap_);
         buffer_ = new_buffer;
         size_ = size;
         cap_ = size;
     }
 
     // append_range，末尾追加一段 [first, last) 内的字符
-    template <class CharType, class CharTraits>
+    template <class CharType, class CharTraits, class Alloc>
     template <class Iter>
-    basic_string<CharType, CharTraits> &
-    basic_string<CharType, CharTraits>::
+    basic_string<CharType, CharTraits, Alloc> &
+    basic_string<CharType, CharTraits, Alloc>::
         append_range(Iter first, Iter last)
     {
         const size_type n = mySTL::distance(first, last);
@@ -1773,8 +1874,8 @@ namespace mySTL
         return *this;
     }
 
-    template <class CharType, class CharTraits>
-    int basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    int basic_string<CharType, CharTraits, Alloc>::
         compare_cstr(const_pointer s1, size_type n1, const_pointer s2, size_type n2) const
     {
         auto rlen = mySTL::min(n1, n2);
@@ -1789,9 +1890,9 @@ namespace mySTL
     }
 
     // 把 first 开始的 count1 个字符替换成 str 开始的 count2 个字符
-    template <class CharType, class CharTraits>
-    basic_string<CharType, CharTraits> &
-    basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    basic_string<CharType, CharTraits, Alloc> &
+    basic_string<CharType, CharTraits, Alloc>::
         replace_cstr(const_iterator first, size_type count1, const_pointer str, size_type count2)
     {
         if (static_cast<size_type>(cend() - first) < count1)
@@ -1823,9 +1924,9 @@ namespace mySTL
     }
 
     // 把 first 开始的 count1 个字符替换成 count2 个 ch 字符
-    template <class CharType, class CharTraits>
-    basic_string<CharType, CharTraits> &
-    basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    basic_string<CharType, CharTraits, Alloc> &
+    basic_string<CharType, CharTraits, Alloc>::
         replace_fill(const_iterator first, size_type count1, size_type count2, value_type ch)
     {
         if (static_cast<size_type>(cend() - first) < count1)
@@ -1857,10 +1958,10 @@ namespace mySTL
     }
 
     // 把 [first, last) 的字符替换成 [first2, last2)
-    template <class CharType, class CharTraits>
+    template <class CharType, class CharTraits, class Alloc>
     template <class Iter>
-    basic_string<CharType, CharTraits> &
-    basic_string<CharType, CharTraits>::
+    basic_string<CharType, CharTraits, Alloc> &
+    basic_string<CharType, CharTraits, Alloc>::
         replace_copy(const_iterator first, const_iterator last, Iter first2, Iter last2)
     {
         size_type len1 = last - first;
@@ -1889,33 +1990,61 @@ namespace mySTL
         return *this;
     }
 
+    // allocate_buffer 函数，为 n 个字符分配空间，额外多分配一个位置存放结尾的空字符
+    template <class CharType, class CharTraits, class Alloc>
+    typename basic_string<CharType, CharTraits, Alloc>::pointer
+    basic_string<CharType, CharTraits, Alloc>::
+        allocate_buffer(size_type n)
+    {
+        return data_traits::allocate(this->alloc_ref(), n + 1);
+    }
+
+    // deallocate_buffer 函数
+    template <class CharType, class CharTraits, class Alloc>
+    void basic_string<CharType, CharTraits, Alloc>::
+        deallocate_buffer(pointer p, size_type n) noexcept
+    {
+        if (p != nullptr)
+            data_traits::deallocate(this->alloc_ref(), p, n + 1);
+    }
+
+    // swap_data 函数，只交换字符串的数据，不交换分配器
+    template <class CharType, class CharTraits, class Alloc>
+    void basic_string<CharType, CharTraits, Alloc>::
+        swap_data(basic_string &rhs) noexcept
+    {
+        mySTL::swap(buffer_, rhs.buffer_);
+        mySTL::swap(size_, rhs.size_);
+        mySTL::swap(cap_, rhs.cap_);
+    }
+
     // reallocate 函数
-    template <class CharType, class CharTraits>
-    void basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    void basic_string<CharType, CharTraits, Alloc>::
         reallocate(size_type need)
     {
         const auto new_cap = mySTL::max(cap_ + need, cap_ + (cap_ >> 1));
-        auto new_buffer = data_allocator::allocate(new_cap);
+        auto new_buffer = allocate_buffer(new_cap);
         char_traits::move(new_buffer, buffer_, size_);
-        data_allocator::deallocate(buffer_);
+        deallocate_buffer(buffer_, cap_);
         buffer_ = new_buffer;
         cap_ = new_cap;
     }
 
     // reallocate_and_fill 函数
-    template <class CharType, class CharTraits>
-    typename basic_string<CharType, CharTraits>::iterator
-    basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    typename basic_string<CharType, CharTraits, Alloc>::iterator
+    basic_string<CharType, CharTraits, Alloc>::
         reallocate_and_fill(iterator pos, size_type n, value_type ch)
     {
         const auto r = pos - buffer_;
         const auto old_cap = cap_;
         const auto new_cap = mySTL::max(old_cap + n, old_cap + (old_cap >> 1));
-        auto new_buffer = data_allocator::allocate(new_cap);
+        auto new_buffer = allocate_buffer(new_cap);
         auto e1 = char_traits::move(new_buffer, buffer_, r) + r;
         auto e2 = char_traits::fill(e1, ch, n) + n;
         char_traits::move(e2, buffer_ + r, size_ - r);
-        data_allocator::deallocate(buffer_, old_cap);
+        deallocate_buffer(buffer_, old_cap);
         buffer_ = new_buffer;
         size_ += n;
         cap_ = new_cap;
@@ -1923,20 +2052,20 @@ namespace mySTL
     }
 
     // reallocate_and_copy 函数
-    template <class CharType, class CharTraits>
-    typename basic_string<CharType, CharTraits>::iterator
-    basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    typename basic_string<CharType, CharTraits, Alloc>::iterator
+    basic_string<CharType, CharTraits, Alloc>::
         reallocate_and_copy(iterator pos, const_iterator first, const_iterator last)
     {
         const auto r = pos - buffer_;
         const auto old_cap = cap_;
         const size_type n = mySTL::distance(first, last);
         const auto new_cap = mySTL::max(old_cap + n, old_cap + (old_cap >> 1));
-        auto new_buffer = data_allocator::allocate(new_cap);
+        auto new_buffer = allocate_buffer(new_cap);
         auto e1 = char_traits::move(new_buffer, buffer_, r) + r;
         auto e2 = mySTL::uninitialized_copy_n(first, n, e1) + n;
         char_traits::move(e2, buffer_ + r, size_ - r);
-        data_allocator::deallocate(buffer_, old_cap);
+        deallocate_buffer(buffer_, old_cap);
         buffer_ = new_buffer;
         size_ += n;
         cap_ = new_cap;
@@ -1947,180 +2076,185 @@ namespace mySTL
     // 重载全局操作符
 
     // 重载 operator+
-    template <class CharType, class CharTraits>
-    basic_string<CharType, CharTraits>
-    operator+(const basic_string<CharType, CharTraits> &lhs,
-              const basic_string<CharType, CharTraits> &rhs)
+    template <class CharType, class CharTraits, class Alloc>
+    basic_string<CharType, CharTraits, Alloc>
+    operator+(const basic_string<CharType, CharTraits, Alloc> &lhs,
+              const basic_string<CharType, CharTraits, Alloc> &rhs)
     {
-        basic_string<CharType, CharTraits> tmp(lhs);
+        basic_string<CharType, CharTraits, Alloc> tmp(lhs);
         tmp.append(rhs);
         return tmp;
     }
 
-    template <class CharType, class CharTraits>
-    basic_string<CharType, CharTraits>
-    operator+(const CharType *lhs, const basic_string<CharType, CharTraits> &rhs)
+    template <class CharType, class CharTraits, class Alloc>
+    basic_string<CharType, CharTraits, Alloc>
+    operator+(const CharType *lhs, const basic_string<CharType, CharTraits, Alloc> &rhs)
     {
-        basic_string<CharType, CharTraits> tmp(lhs);
+        basic_string<CharType, CharTraits, Alloc> tmp(lhs);
         tmp.append(rhs);
         return tmp;
     }
 
-    template <class CharType, class CharTraits>
-    basic_string<CharType, CharTraits>
-    operator+(CharType ch, const basic_string<CharType, CharTraits> &rhs)
+    template <class CharType, class CharTraits, class Alloc>
+    basic_string<CharType, CharTraits, Alloc>
+    operator+(CharType ch, const basic_string<CharType, CharTraits, Alloc> &rhs)
     {
-        basic_string<CharType, CharTraits> tmp(1, ch);
+        basic_string<CharType, CharTraits, Alloc> tmp(1, ch);
         tmp.append(rhs);
         return tmp;
     }
 
-    template <class CharType, class CharTraits>
-    basic_string<CharType, CharTraits>
-    operator+(const basic_string<CharType, CharTraits> &lhs, const CharType *rhs)
+    template <class CharType, class CharTraits, class Alloc>
+    basic_string<CharType, CharTraits, Alloc>
+    operator+(const basic_string<CharType, CharTraits, Alloc> &lhs, const CharType *rhs)
     {
-        basic_string<CharType, CharTraits> tmp(lhs);
+        basic_string<CharType, CharTraits, Alloc> tmp(lhs);
         tmp.append(rhs);
         return tmp;
     }
 
-    template <class CharType, class CharTraits>
-    basic_string<CharType, CharTraits>
-    operator+(const basic_string<CharType, CharTraits> &lhs, CharType ch)
+    template <class CharType, class CharTraits, class Alloc>
+    basic_string<CharType, CharTraits, Alloc>
+    operator+(const basic_string<CharType, CharTraits, Alloc> &lhs, CharType ch)
     {
-        basic_string<CharType, CharTraits> tmp(lhs);
+        basic_string<CharType, CharTraits, Alloc> tmp(lhs);
         tmp.append(1, ch);
         return tmp;
     }
 
-    template <class CharType, class CharTraits>
-    basic_string<CharType, CharTraits>
-    operator+(basic_string<CharType, CharTraits> &&lhs,
-              const basic_string<CharType, CharTraits> &rhs)
+    template <class CharType, class CharTraits, class Alloc>
+    basic_string<CharType, CharTraits, Alloc>
+    operator+(basic_string<CharType, CharTraits, Alloc> &&lhs,
+              const basic_string<CharType, CharTraits, Alloc> &rhs)
     {
-        basic_string<CharType, CharTraits> tmp(mySTL::move(lhs));
+        basic_string<CharType, CharTraits, Alloc> tmp(mySTL::move(lhs));
         tmp.append(rhs);
         return tmp;
     }
 
-    template <class CharType, class CharTraits>
-    basic_string<CharType, CharTraits>
-    operator+(const basic_string<CharType, CharTraits> &lhs,
-              basic_string<CharType, CharTraits> &&rhs)
+    template <class CharType, class CharTraits, class Alloc>
+    basic_string<CharType, CharTraits, Alloc>
+    operator+(const basic_string<CharType, CharTraits, Alloc> &lhs,
+              basic_string<CharType, CharTraits, Alloc> &&rhs)
     {
-        basic_string<CharType, CharTraits> tmp(mySTL::move(rhs));
+        basic_string<CharType, CharTraits, Alloc> tmp(mySTL::move(rhs));
         tmp.insert(tmp.begin(), lhs.begin(), lhs.end());
         return tmp;
     }
 
-    template <class CharType, class CharTraits>
-    basic_string<CharType, CharTraits>
-    operator+(basic_string<CharType, CharTraits> &&lhs,
-              basic_string<CharType, CharTraits> &&rhs)
+    template <class CharType, class CharTraits, class Alloc>
+    basic_string<CharType, CharTraits, Alloc>
+    operator+(basic_string<CharType, CharTraits, Alloc> &&lhs,
+              basic_string<CharType, CharTraits, Alloc> &&rhs)
     {
-        basic_string<CharType, CharTraits> tmp(mySTL::move(lhs));
+        basic_string<CharType, CharTraits, Alloc> tmp(mySTL::move(lhs));
         tmp.append(rhs);
         return tmp;
     }
 
-    template <class CharType, class CharTraits>
-    basic_string<CharType, CharTraits>
-    operator+(const CharType *lhs, basic_string<CharType, CharTraits> &&rhs)
+    template <class CharType, class CharTraits, class Alloc>
+    basic_string<CharType, CharTraits, Alloc>
+    operator+(const CharType *lhs, basic_string<CharType, CharTraits, Alloc> &&rhs)
     {
-        basic_string<CharType, CharTraits> tmp(mySTL::move(rhs));
+        basic_string<CharType, CharTraits, Alloc> tmp(mySTL::move(rhs));
         tmp.insert(tmp.begin(), lhs, lhs + char_traits<CharType>::length(lhs));
         return tmp;
     }
 
-    template <class CharType, class CharTraits>
-    basic_string<CharType, CharTraits>
-    operator+(CharType ch, basic_string<CharType, CharTraits> &&rhs)
+    template <class CharType, class CharTraits, class Alloc>
+    basic_string<CharType, CharTraits, Alloc>
+    operator+(CharType ch, basic_string<CharType, CharTraits, Alloc> &&rhs)
     {
-        basic_string<CharType, CharTraits> tmp(mySTL::move(rhs));
+        basic_string<CharType, CharTraits, Alloc> tmp(mySTL::move(rhs));
         tmp.insert(tmp.begin(), ch);
         return tmp;
     }
 
-    template <class CharType, class CharTraits>
-    basic_string<CharType, CharTraits>
-    operator+(basic_string<CharType, CharTraits> &&lhs, const CharType *rhs)
+    template <class CharType, class CharTraits, class Alloc>
+    basic_string<CharType, CharTraits, Alloc>
+    operator+(basic_string<CharType, CharTraits, Alloc> &&lhs, const CharType *rhs)
     {
-        basic_string<CharType, CharTraits> tmp(mySTL::move(lhs));
+        basic_string<CharType, CharTraits, Alloc> tmp(mySTL::move(lhs));
         tmp.append(rhs);
         return tmp;
     }
 
-    template <class CharType, class CharTraits>
-    basic_string<CharType, CharTraits>
-    operator+(basic_string<CharType, CharTraits> &&lhs, CharType ch)
+    template <class CharType, class CharTraits, class Alloc>
+    basic_string<CharType, CharTraits, Alloc>
+    operator+(basic_string<CharType, CharTraits, Alloc> &&lhs, CharType ch)
     {
-        basic_string<CharType, CharTraits> tmp(mySTL::move(lhs));
+        basic_string<CharType, CharTraits, Alloc> tmp(mySTL::move(lhs));
         tmp.append(1, ch);
         return tmp;
     }
 
     // 重载比较操作符
-    template <class CharType, class CharTraits>
-    bool operator==(const basic_string<CharType, CharTraits> &lhs,
-                    const basic_string<CharType, CharTraits> &rhs)
+    template <class CharType, class CharTraits, class Alloc>
+    bool operator==(const basic_string<CharType, CharTraits, Alloc> &lhs,
+                    const basic_string<CharType, CharTraits, Alloc> &rhs)
     {
         return lhs.size() == rhs.size() && lhs.compare(rhs) == 0;
     }
 
-    template <class CharType, class CharTraits>
-    bool operator!=(const basic_string<CharType, CharTraits> &lhs,
-                    const basic_string<CharType, CharTraits> &rhs)
+    template <class CharType, class CharTraits, class Alloc>
+    bool operator!=(const basic_string<CharType, CharTraits, Alloc> &lhs,
+                    const basic_string<CharType, CharTraits, Alloc> &rhs)
     {
         return lhs.size() != rhs.size() || lhs.compare(rhs) != 0;
     }
 
-    template <class CharType, class CharTraits>
-    bool operator<(const basic_string<CharType, CharTraits> &lhs,
-                   const basic_string<CharType, CharTraits> &rhs)
+    template <class CharType, class CharTraits, class Alloc>
+    bool operator<(const basic_string<CharType, CharTraits, Alloc> &lhs,
+                   const basic_string<CharType, CharTraits, Alloc> &rhs)
     {
         return lhs.compare(rhs) < 0;
     }
 
-    template <class CharType, class CharTraits>
-    bool operator<=(const basic_string<CharType, CharTraits> &lhs,
-                    const basic_string<CharType, CharTraits> &rhs)
+    template <class CharType, class CharTraits, class Alloc>
+    bool operator<=(const basic_string<CharType, CharTraits, Alloc> &lhs,
+                    const basic_string<CharType, CharTraits, Alloc> &rhs)
     {
         return lhs.compare(rhs) <= 0;
     }
 
-    template <class CharType, class CharTraits>
-    bool operator>(const basic_string<CharType, CharTraits> &lhs,
-                   const basic_string<CharType, CharTraits> &rhs)
+    template <class CharType, class CharTraits, class Alloc>
+    bool operator>(const basic_string<CharType, CharTraits, Alloc> &lhs,
+                   const basic_string<CharType, CharTraits, Alloc> &rhs)
     {
         return lhs.compare(rhs) > 0;
     }
 
-    template <class CharType, class CharTraits>
-    bool operator>=(const basic_string<CharType, CharTraits> &lhs,
-                    const basic_string<CharType, CharTraits> &rhs)
+    template <class CharType, class CharTraits, class Alloc>
+    bool operator>=(const basic_string<CharType, CharTraits, Alloc> &lhs,
+                    const basic_string<CharType, CharTraits, Alloc> &rhs)
     {
         return lhs.compare(rhs) >= 0;
     }
 
     // 重载 mySTL 的 swap
-    template <class CharType, class CharTraits>
-    void swap(basic_string<CharType, CharTraits> &lhs,
-              basic_string<CharType, CharTraits> &rhs) noexcept
+    template <class CharType, class CharTraits, class Alloc>
+    void swap(basic_string<CharType, CharTraits, Alloc> &lhs,
+              basic_string<CharType, CharTraits, Alloc> &rhs) noexcept
     {
         lhs.swap(rhs);
     }
 
     // 特化 mySTL::hash
-    template <class CharType, class CharTraits>
-    struct hash<basic_string<CharType, CharTraits>>
+    template <class CharType, class CharTraits, class Alloc>
+    struct hash<basic_string<CharType, CharTraits, Alloc>>
     {
-        size_t operator()(const basic_string<CharType, CharTraits> &str)
+        size_t operator()(const basic_string<CharType, CharTraits, Alloc> &str)
         {
             return bitwise_hash((const unsigned char *)str.c_str(),
                                 str.size() * sizeof(CharType));
         }
     };
 
+    // basic_string 没有内嵌的短字符串缓冲区，只保存指向堆上空间的指针
+    template <class CharType, class CharTraits, class Alloc>
+    struct is_trivially_relocatable<basic_string<CharType, CharTraits, Alloc>>
+        : is_trivially_relocatable<Alloc> {};
+
 }
 
 #endif
\ No newline at end of file
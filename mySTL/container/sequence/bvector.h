@@ -0,0 +1,1128 @@
+#ifndef MYSTL_BVECTOR_H_
+#define MYSTL_BVECTOR_H_
+
+// 这个头文件包含 vector<bool, Alloc> 的偏特化版本，由 vector.h 包含
+// vector<bool> : 每个元素只占一位，按 64 位的字存放，通过代理类 bit_reference 访问单个元素
+
+// notes:
+//
+// 与 std::vector<bool> 相同，operator[]、front、back 与迭代器解引用返回的是代理对象而不是 bool&，
+// 没有 data() 成员
+// 对位迭代器重载了 count、find、fill、copy、copy_backward 与 reverse，
+// 每次处理一个字（最多 64 位），count 与 find 使用 popcount 与 ctz 指令
+// 字中超出 size() 的位没有确定的值，所有操作都不依赖这些位
+
+#include <cstdint>
+#include <initializer_list>
+#include <type_traits>
+
+#include "vector.h"
+
+namespace mySTL
+{
+
+    typedef std::uint64_t bit_word;
+
+    static constexpr unsigned bit_word_bits = 64;
+
+    // 低 k 位为 1 的掩码，0 <= k <= 64
+    inline bit_word bit_low_mask(unsigned k) noexcept
+    {
+        return k >= bit_word_bits ? ~bit_word(0) : (bit_word(1) << k) - 1;
+    }
+
+    // 字中 1 的个数
+    inline unsigned bit_popcount(bit_word w) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<unsigned>(__builtin_popcountll(w));
+#else
+        w = w - ((w >> 1) & 0x5555555555555555ULL);
+        w = (w & 0x3333333333333333ULL) + ((w >> 2) & 0x3333333333333333ULL);
+        w = (w + (w >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+        return static_cast<unsigned>((w * 0x0101010101010101ULL) >> 56);
+#endif
+    }
+
+    // 字中最低的 1 所在的位置，w 不能为 0
+    inline unsigned bit_ctz(bit_word w) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<unsigned>(__builtin_ctzll(w));
+#else
+        unsigned n = 0;
+        for (; (w & 1) == 0; w >>= 1)
+            ++n;
+        return n;
+#endif
+    }
+
+    // 读取从 p 的第 offset 位开始的 k 位，0 < k <= 64，跨越两个字时拼接
+    inline bit_word bit_load(const bit_word *p, unsigned offset, unsigned k) noexcept
+    {
+        bit_word w = p[0] >> offset;
+        if (offset != 0 && offset + k > bit_word_bits)
+            w |= p[1] << (bit_word_bits - offset);
+        return w & bit_low_mask(k);
+    }
+
+    // 把 w 的低 k 位写到从 p 的第 offset 位开始的位置，其余位保持不变
+    inline void bit_store(bit_word *p, unsigned offset, unsigned k, bit_word w) noexcept
+    {
+        const bit_word mask = bit_low_mask(k);
+        w &= mask;
+        p[0] = (p[0] & ~(mask << offset)) | (w << offset);
+        if (offset != 0 && offset + k > bit_word_bits)
+        {
+            const unsigned shift = bit_word_bits - offset;
+            p[1] = (p[1] & ~(mask >> shift)) | (w >> shift);
+        }
+    }
+
+    // 单个位的代理引用
+    struct bit_reference
+    {
+        bit_word *p;
+        bit_word mask;
+
+        bit_reference(bit_word *x, bit_word m) noexcept
+            : p(x), mask(m) {}
+
+        operator bool() const noexcept { return (*p & mask) != 0; }
+
+        bit_reference &operator=(bool x) noexcept
+        {
+            if (x)
+                *p |= mask;
+            else
+                *p &= ~mask;
+            return *this;
+        }
+        bit_reference &operator=(const bit_reference &x) noexcept
+        {
+            return *this = static_cast<bool>(x);
+        }
+
+        bool operator==(const bit_reference &x) const noexcept
+        {
+            return static_cast<bool>(*this) == static_cast<bool>(x);
+        }
+        bool operator<(const bit_reference &x) const noexcept
+        {
+            return !static_cast<bool>(*this) && static_cast<bool>(x);
+        }
+        bool operator~() const noexcept { return !static_cast<bool>(*this); }
+
+        void flip() noexcept { *p ^= mask; }
+    };
+
+    // 交换两个代理引用所指的位
+    inline void swap(bit_reference x, bit_reference y) noexcept
+    {
+        const bool tmp = x;
+        x = y;
+        y = tmp;
+    }
+
+    // 位迭代器的公共部分：所在的字与字内的位置
+    struct bit_iterator_base : public iterator<random_access_iterator_tag, bool>
+    {
+        bit_word *p;
+        unsigned offset;
+
+        bit_iterator_base(bit_word *x, unsigned o) noexcept
+            : p(x), offset(o) {}
+
+        void bump_up() noexcept
+        {
+            if (offset++ == bit_word_bits - 1)
+            {
+                offset = 0;
+                ++p;
+            }
+        }
+        void bump_down() noexcept
+        {
+            if (offset-- == 0)
+            {
+                offset = bit_word_bits - 1;
+                --p;
+            }
+        }
+        void incr(ptrdiff_t i) noexcept
+        {
+            ptrdiff_t n = i + static_cast<ptrdiff_t>(offset);
+            p += n / static_cast<ptrdiff_t>(bit_word_bits);
+            n %= static_cast<ptrdiff_t>(bit_word_bits);
+            if (n < 0)
+            {
+                n += bit_word_bits;
+                --p;
+            }
+            offset = static_cast<unsigned>(n);
+        }
+    };
+
+    inline ptrdiff_t operator-(const bit_iterator_base &x, const bit_iterator_base &y) noexcept
+    {
+        return static_cast<ptrdiff_t>(bit_word_bits) * (x.p - y.p) +
+               static_cast<ptrdiff_t>(x.offset) - static_cast<ptrdiff_t>(y.offset);
+    }
+    inline bool operator==(const bit_iterator_base &x, const bit_iterator_base &y) noexcept
+    {
+        return x.p == y.p && x.offset == y.offset;
+    }
+    inline bool operator!=(const bit_iterator_base &x, const bit_iterator_base &y) noexcept
+    {
+        return !(x == y);
+    }
+    inline bool operator<(const bit_iterator_base &x, const bit_iterator_base &y) noexcept
+    {
+        return x.p < y.p || (x.p == y.p && x.offset < y.offset);
+    }
+    inline bool operator>(const bit_iterator_base &x, const bit_iterator_base &y) noexcept
+    {
+        return y < x;
+    }
+    inline bool operator<=(const bit_iterator_base &x, const bit_iterator_base &y) noexcept
+    {
+        return !(y < x);
+    }
+    inline bool operator>=(const bit_iterator_base &x, const bit_iterator_base &y) noexcept
+    {
+        return !(x < y);
+    }
+
+    // vector<bool> 的迭代器设计
+    struct bit_iterator : public bit_iterator_base
+    {
+        typedef bit_reference reference;
+        typedef bit_reference *pointer;
+        typedef bit_iterator self;
+
+        bit_iterator() noexcept
+            : bit_iterator_base(nullptr, 0) {}
+        bit_iterator(bit_word *x, unsigned o) noexcept
+            : bit_iterator_base(x, o) {}
+
+        reference operator*() const noexcept { return reference(p, bit_word(1) << offset); }
+        reference operator[](difference_type n) const noexcept { return *(*this + n); }
+
+        self &operator++() noexcept
+        {
+            bump_up();
+            return *this;
+        }
+        self operator++(int) noexcept
+        {
+            self tmp = *this;
+            bump_up();
+            return tmp;
+        }
+        self &operator--() noexcept
+        {
+            bump_down();
+            return *this;
+        }
+        self operator--(int) noexcept
+        {
+            self tmp = *this;
+            bump_down();
+            return tmp;
+        }
+
+        self &operator+=(difference_type n) noexcept
+        {
+            incr(n);
+            return *this;
+        }
+        self &operator-=(difference_type n) noexcept
+        {
+            incr(-n);
+            return *this;
+        }
+        self operator+(difference_type n) const noexcept
+        {
+            self tmp = *this;
+            return tmp += n;
+        }
+        self operator-(difference_type n) const noexcept
+        {
+            self tmp = *this;
+            return tmp -= n;
+        }
+    };
+
+    inline bit_iterator operator+(ptrdiff_t n, const bit_iterator &x) noexcept
+    {
+        return x + n;
+    }
+
+    struct bit_const_iterator : public bit_iterator_base
+    {
+        typedef bool reference;
+        typedef const bool *pointer;
+        typedef bit_const_iterator self;
+
+        bit_const_iterator() noexcept
+            : bit_iterator_base(nullptr, 0) {}
+        bit_const_iterator(bit_word *x, unsigned o) noexcept
+            : bit_iterator_base(x, o) {}
+        bit_const_iterator(const bit_iterator &x) noexcept
+            : bit_iterator_base(x.p, x.offset) {}
+
+        reference operator*() const noexcept { return (*p >> offset) & 1; }
+        reference operator[](difference_type n) const noexcept { return *(*this + n); }
+
+        self &operator++() noexcept
+        {
+            bump_up();
+            return *this;
+        }
+        self operator++(int) noexcept
+        {
+            self tmp = *this;
+            bump_up();
+            return tmp;
+        }
+        self &operator--() noexcept
+        {
+            bump_down();
+            return *this;
+        }
+        self operator--(int) noexcept
+        {
+            self tmp = *this;
+            bump_down();
+            return tmp;
+        }
+
+        self &operator+=(difference_type n) noexcept
+        {
+            incr(n);
+            return *this;
+        }
+        self &operator-=(difference_type n) noexcept
+        {
+            incr(-n);
+            return *this;
+        }
+        self operator+(difference_type n) const noexcept
+        {
+            self tmp = *this;
+            return tmp += n;
+        }
+        self operator-(difference_type n) const noexcept
+        {
+            self tmp = *this;
+            return tmp -= n;
+        }
+    };
+
+    inline bit_const_iterator operator+(ptrdiff_t n, const bit_const_iterator &x) noexcept
+    {
+        return x + n;
+    }
+
+    /*
+    位迭代器上按字处理的算法
+    对 bool 值的调用优先匹配这些非模板版本，其余情况仍然使用 algo.h / algobase.h 中的通用版本
+     */
+
+    // count：每个字做一次 popcount
+    inline size_t count(bit_const_iterator first, bit_const_iterator last, const bool &value) noexcept
+    {
+        size_t n = static_cast<size_t>(last - first);
+        size_t ones = 0;
+        bit_word *p = first.p;
+        unsigned offset = first.offset;
+        while (n > 0)
+        {
+            const unsigned k = static_cast<unsigned>(mySTL::min<size_t>(n, bit_word_bits - offset));
+            ones += bit_popcount(bit_load(p, offset, k));
+            n -= k;
+            offset = 0;
+            ++p;
+        }
+        return value ? ones : static_cast<size_t>(last - first) - ones;
+    }
+
+    inline size_t count(bit_iterator first, bit_iterator last, const bool &value) noexcept
+    {
+        return mySTL::count(bit_const_iterator(first), bit_const_iterator(last), value);
+    }
+
+    // find：跳过全 0（或全 1）的字，在第一个命中的字中用 ctz 定位
+    inline bit_const_iterator find(bit_const_iterator first, bit_const_iterator last, const bool &value) noexcept
+    {
+        size_t n = static_cast<size_t>(last - first);
+        bit_word *p = first.p;
+        unsigned offset = first.offset;
+        while (n > 0)
+        {
+            const unsigned k = static_cast<unsigned>(mySTL::min<size_t>(n, bit_word_bits - offset));
+            bit_word w = bit_load(p, offset, k);
+            if (!value)
+                w = ~w & bit_low_mask(k);
+            if (w != 0)
+                return bit_const_iterator(p, offset) + bit_ctz(w);
+            n -= k;
+            offset = 0;
+            ++p;
+        }
+        return last;
+    }
+
+    inline bit_iterator find(bit_iterator first, bit_iterator last, const bool &value) noexcept
+    {
+        bit_const_iterator r = mySTL::find(bit_const_iterator(first), bit_const_iterator(last), value);
+        return bit_iterator(r.p, r.offset);
+    }
+
+    // fill：首尾不完整的字按掩码写入，中间的字整字赋值
+    inline void fill(bit_iterator first, bit_iterator last, const bool &value) noexcept
+    {
+        const bit_word w = value ? ~bit_word(0) : bit_word(0);
+        size_t n = static_cast<size_t>(last - first);
+        bit_word *p = first.p;
+        unsigned offset = first.offset;
+        while (n > 0)
+        {
+            const unsigned k = static_cast<unsigned>(mySTL::min<size_t>(n, bit_word_bits - offset));
+            bit_store(p, offset, k, w);
+            n -= k;
+            offset = 0;
+            ++p;
+        }
+    }
+
+    // copy：按目标的字边界分段，每段读取至多 64 位写入一个字
+    // 每段先读后写，因此目标在源之前时两个区间可以重叠
+    inline bit_iterator copy(bit_const_iterator first, bit_const_iterator last, bit_iterator result) noexcept
+    {
+        const size_t len = static_cast<size_t>(last - first);
+        size_t n = len;
+        bit_const_iterator src = first;
+        bit_word *p = result.p;
+        unsigned offset = result.offset;
+        while (n > 0)
+        {
+            const unsigned k = static_cast<unsigned>(mySTL::min<size_t>(n, bit_word_bits - offset));
+            bit_store(p, offset, k, bit_load(src.p, src.offset, k));
+            src += k;
+            n -= k;
+            offset = 0;
+            ++p;
+        }
+        return result + static_cast<ptrdiff_t>(len);
+    }
+
+    inline bit_iterator copy(bit_iterator first, bit_iterator last, bit_iterator result) noexcept
+    {
+        return mySTL::copy(bit_const_iterator(first), bit_const_iterator(last), result);
+    }
+
+    // copy_backward：从尾部开始每段复制 64 位，目标在源之后时两个区间可以重叠
+    inline bit_iterator copy_backward(bit_const_iterator first, bit_const_iterator last,
+                                      bit_iterator result) noexcept
+    {
+        size_t n = static_cast<size_t>(last - first);
+        while (n > 0)
+        {
+            const unsigned k = static_cast<unsigned>(mySTL::min<size_t>(n, bit_word_bits));
+            last -= k;
+            result -= k;
+            bit_store(result.p, result.offset, k, bit_load(last.p, last.offset, k));
+            n -= k;
+        }
+        return result;
+    }
+
+    inline bit_iterator copy_backward(bit_iterator first, bit_iterator last, bit_iterator result) noexcept
+    {
+        return mySTL::copy_backward(bit_const_iterator(first), bit_const_iterator(last), result);
+    }
+
+    // reverse：代理引用不能绑定到通用 iter_swap 的左值引用参数上，这里逐位交换
+    inline void reverse(bit_iterator first, bit_iterator last) noexcept
+    {
+        while (first < last)
+        {
+            --last;
+            mySTL::swap(*first, *last);
+            ++first;
+        }
+    }
+
+    // 模板类: vector<bool, Alloc>
+    template <class Alloc>
+    class vector<bool, Alloc>
+        : private mySTL::alloc_holder<typename mySTL::allocator_traits<Alloc>::template rebind_alloc<bit_word>>
+    {
+        static_assert(std::is_same<bool, typename Alloc::value_type>::value,
+                      "the value_type of Alloc should be same with T");
+
+    public:
+        // vector<bool> 的嵌套型别定义
+        typedef Alloc allocator_type;
+        typedef typename mySTL::allocator_traits<Alloc>::template rebind_alloc<bit_word> word_allocator;
+        typedef mySTL::allocator_traits<word_allocator> word_traits;
+
+        typedef bool value_type;
+        typedef bit_reference reference;
+        typedef bool const_reference;
+        typedef bit_reference *pointer;
+        typedef const bool *const_pointer;
+        typedef size_t size_type;
+        typedef ptrdiff_t difference_type;
+
+        typedef bit_iterator iterator;
+        typedef bit_const_iterator const_iterator;
+        typedef mySTL::reverse_iterator<iterator> reverse_iterator;
+        typedef mySTL::reverse_iterator<const_iterator> const_reverse_iterator;
+
+        allocator_type get_allocator() const { return allocator_type(this->alloc_ref()); }
+
+    private:
+        typedef mySTL::alloc_holder<word_allocator> alloc_base;
+
+        bit_word *words_; // 存放位的字
+        size_type size_;  // 元素个数
+        size_type cap_;   // 容量，总是 bit_word_bits 的倍数
+
+    public:
+        // 构造、复制、移动、析构函数
+        vector() noexcept
+            : words_(nullptr), size_(0), cap_(0)
+        {
+        }
+
+        explicit vector(const allocator_type &alloc) noexcept
+            : alloc_base(word_allocator(alloc)), words_(nullptr), size_(0), cap_(0)
+        {
+        }
+
+        explicit vector(size_type n, const allocator_type &alloc = allocator_type())
+            : alloc_base(word_allocator(alloc)), words_(nullptr), size_(0), cap_(0)
+        {
+            fill_init(n, false);
+        }
+
+        vector(size_type n, const value_type &value, const allocator_type &alloc = allocator_type())
+            : alloc_base(word_allocator(alloc)), words_(nullptr), size_(0), cap_(0)
+        {
+            fill_init(n, value);
+        }
+
+        template <class Iter, typename std::enable_if<
+                                  mySTL::is_input_iterator<Iter>::value, int>::type = 0>
+        vector(Iter first, Iter last, const allocator_type &alloc = allocator_type())
+            : alloc_base(word_allocator(alloc)), words_(nullptr), size_(0), cap_(0)
+        {
+            try
+            {
+                insert(end(), first, last);
+            }
+            catch (...)
+            {
+                release();
+                throw;
+            }
+        }
+
+        vector(const vector &rhs)
+            : alloc_base(word_traits::select_on_container_copy_construction(rhs.alloc_ref())),
+              words_(nullptr), size_(0), cap_(0)
+        {
+            copy_words(rhs);
+        }
+
+        vector(const vector &rhs, const allocator_type &alloc)
+            : alloc_base(word_allocator(alloc)), words_(nullptr), size_(0), cap_(0)
+        {
+            copy_words(rhs);
+        }
+
+        vector(vector &&rhs) noexcept
+            : alloc_base(mySTL::move(rhs.alloc_ref())),
+              words_(rhs.words_), size_(rhs.size_), cap_(rhs.cap_)
+        {
+            rhs.words_ = nullptr;
+            rhs.size_ = 0;
+            rhs.cap_ = 0;
+        }
+
+        vector(vector &&rhs, const allocator_type &alloc)
+            : alloc_base(word_allocator(alloc)), words_(nullptr), size_(0), cap_(0)
+        {
+            if (mySTL::alloc_equal(this->alloc_ref(), rhs.alloc_ref()))
+            {
+                steal(rhs);
+            }
+            else
+            {
+                copy_words(rhs);
+            }
+        }
+
+        vector(std::initializer_list<value_type> ilist, const allocator_type &alloc = allocator_type())
+            : alloc_base(word_allocator(alloc)), words_(nullptr), size_(0), cap_(0)
+        {
+            insert(end(), ilist.begin(), ilist.end());
+        }
+
+        vector &operator=(const vector &rhs);
+        vector &operator=(vector &&rhs);
+
+        vector &operator=(std::initializer_list<value_type> ilist)
+        {
+            assign(ilist.begin(), ilist.end());
+            return *this;
+        }
+
+        ~vector()
+        {
+            release();
+        }
+
+    public:
+        // 迭代器相关操作
+        iterator begin() noexcept
+        {
+            return iterator(words_, 0);
+        }
+        const_iterator begin() const noexcept
+        {
+            return const_iterator(words_, 0);
+        }
+        iterator end() noexcept
+        {
+            return iterator(words_ + size_ / bit_word_bits, size_ % bit_word_bits);
+        }
+        const_iterator end() const noexcept
+        {
+            return const_iterator(words_ + size_ / bit_word_bits, size_ % bit_word_bits);
+        }
+
+        reverse_iterator rbegin() noexcept
+        {
+            return reverse_iterator(end());
+        }
+        const_reverse_iterator rbegin() const noexcept
+        {
+            return const_reverse_iterator(end());
+        }
+        reverse_iterator rend() noexcept
+        {
+            return reverse_iterator(begin());
+        }
+        const_reverse_iterator rend() const noexcept
+        {
+            return const_reverse_iterator(begin());
+        }
+
+        const_iterator cbegin() const noexcept
+        {
+            return begin();
+        }
+        const_iterator cend() const noexcept
+        {
+            return end();
+        }
+        const_reverse_iterator crbegin() const noexcept
+        {
+            return rbegin();
+        }
+        const_reverse_iterator crend() const noexcept
+        {
+            return rend();
+        }
+
+        // 容量相关操作
+        bool empty() const noexcept
+        {
+            return size_ == 0;
+        }
+        size_type size() const noexcept
+        {
+            return size_;
+        }
+        size_type max_size() const noexcept
+        {
+            const size_type words = word_traits::max_size(this->alloc_ref());
+            return words > static_cast<size_type>(-1) / bit_word_bits
+                       ? static_cast<size_type>(-1) / bit_word_bits * bit_word_bits
+                       : words * bit_word_bits;
+        }
+        size_type capacity() const noexcept
+        {
+            return cap_;
+        }
+        void reserve(size_type n);
+        void shrink_to_fit();
+
+        // 访问元素相关操作
+        reference operator[](size_type n)
+        {
+            MYSTL_DEBUG(n < size());
+            return reference(words_ + n / bit_word_bits, bit_word(1) << (n % bit_word_bits));
+        }
+        const_reference operator[](size_type n) const
+        {
+            MYSTL_DEBUG(n < size());
+            return (words_[n / bit_word_bits] >> (n % bit_word_bits)) & 1;
+        }
+        reference at(size_type n)
+        {
+            THROW_OUT_OF_RANGE_IF(!(n < size()), "vector<bool>::at() subscript out of range");
+            return (*this)[n];
+        }
+        const_reference at(size_type n) const
+        {
+            THROW_OUT_OF_RANGE_IF(!(n < size()), "vector<bool>::at() subscript out of range");
+            return (*this)[n];
+        }
+
+        reference front()
+        {
+            MYSTL_DEBUG(!empty());
+            return (*this)[0];
+        }
+        const_reference front() const
+        {
+            MYSTL_DEBUG(!empty());
+            return (*this)[0];
+        }
+        reference back()
+        {
+            MYSTL_DEBUG(!empty());
+            return (*this)[size_ - 1];
+        }
+        const_reference back() const
+        {
+            MYSTL_DEBUG(!empty());
+            return (*this)[size_ - 1];
+        }
+
+        // 修改容器相关操作
+
+        // assign
+
+        void assign(size_type n, const value_type &value);
+
+        template <class Iter, typename std::enable_if<
+                                  mySTL::is_input_iterator<Iter>::value, int>::type = 0>
+        void assign(Iter first, Iter last)
+        {
+            clear();
+            insert(end(), first, last);
+        }
+
+        void assign(std::initializer_list<value_type> il)
+        {
+            assign(il.begin(), il.end());
+        }
+
+        // emplace / emplace_back
+
+        template <class... Args>
+        iterator emplace(const_iterator pos, Args &&...args)
+        {
+            return insert(pos, value_type(mySTL::forward<Args>(args)...));
+        }
+
+        template <class... Args>
+        void emplace_back(Args &&...args)
+        {
+            push_back(value_type(mySTL::forward<Args>(args)...));
+        }
+
+        // push_back / pop_back
+
+        void push_back(const value_type &value);
+
+        void pop_back()
+        {
+            MYSTL_DEBUG(!empty());
+            --size_;
+        }
+
+        // insert
+
+        iterator insert(const_iterator pos, const value_type &value)
+        {
+            return insert(pos, 1, value);
+        }
+
+        iterator insert(const_iterator pos, size_type n, const value_type &value);
+
+        template <class Iter, typename std::enable_if<
+                                  mySTL::is_input_iterator<Iter>::value, int>::type = 0>
+        iterator insert(const_iterator pos, Iter first, Iter last)
+        {
+            MYSTL_DEBUG(pos >= begin() && pos <= end());
+            return copy_insert(static_cast<size_type>(pos - begin()), first, last, iterator_category(first));
+        }
+
+        iterator insert(const_iterator pos, std::initializer_list<value_type> il)
+        {
+            return insert(pos, il.begin(), il.end());
+        }
+
+        // erase / clear
+        iterator erase(const_iterator pos)
+        {
+            MYSTL_DEBUG(pos >= begin() && pos < end());
+            return erase(pos, pos + 1);
+        }
+        iterator erase(const_iterator first, const_iterator last);
+        void clear() noexcept { size_ = 0; }
+
+        // resize / reverse / flip
+        void resize(size_type new_size) { return resize(new_size, false); }
+        void resize(size_type new_size, const value_type &value);
+
+        void reverse() { mySTL::reverse(begin(), end()); }
+
+        // 翻转所有元素
+        void flip() noexcept
+        {
+            for (size_type i = 0; i < word_count(size_); ++i)
+                words_[i] = ~words_[i];
+        }
+
+        // swap
+        void swap(vector &rhs) noexcept;
+
+    private:
+        // helper functions
+
+        static size_type word_count(size_type bits) noexcept
+        {
+            return (bits + bit_word_bits - 1) / bit_word_bits;
+        }
+
+        iterator mutable_iter(const_iterator it) const noexcept
+        {
+            return iterator(it.p, it.offset);
+        }
+
+        // initialize / destroy
+        void fill_init(size_type n, const value_type &value);
+        void copy_words(const vector &rhs);
+        void steal(vector &rhs) noexcept;
+        void release() noexcept;
+
+        // calculate the growth size
+        size_type get_new_cap(size_type add_size);
+
+        // 分配 new_cap 位的新空间，原有的元素搬到新空间中 [0, pos) 与 [pos + n, size + n) 的位置
+        void reallocate_around(size_type pos, size_type n, size_type new_cap);
+
+        // 在 pos 处空出 n 个位置
+        void open_gap(size_type pos, size_type n);
+
+        // insert
+        template <class IIter>
+        iterator copy_insert(size_type pos, IIter first, IIter last, input_iterator_tag);
+        template <class FIter>
+        iterator copy_insert(size_type pos, FIter first, FIter last, forward_iterator_tag);
+    };
+
+    /*****************************************************************************************/
+
+    // 复制赋值操作符
+    template <class Alloc>
+    vector<bool, Alloc> &vector<bool, Alloc>::operator=(const vector &rhs)
+    {
+        if (this != &rhs)
+        {
+            if (word_traits::propagate_on_container_copy_assignment::value &&
+                !mySTL::alloc_equal(this->alloc_ref(), rhs.alloc_ref()))
+            { // 旧空间必须由原来的分配器释放
+                release();
+            }
+            mySTL::alloc_copy_assign(this->alloc_ref(), rhs.alloc_ref(),
+                                     typename word_traits::propagate_on_container_copy_assignment{});
+            size_ = 0;
+            copy_words(rhs);
+        }
+        return *this;
+    }
+
+    // 移动赋值操作符
+    template <class Alloc>
+    vector<bool, Alloc> &vector<bool, Alloc>::operator=(vector &&rhs)
+    {
+        if (this != &rhs)
+        {
+            if (word_traits::propagate_on_container_move_assignment::value ||
+                mySTL::alloc_equal(this->alloc_ref(), rhs.alloc_ref()))
+            {
+                release();
+                mySTL::alloc_move_assign(this->alloc_ref(), rhs.alloc_ref(),
+                                         typename word_traits::propagate_on_container_move_assignment{});
+                steal(rhs);
+            }
+            else
+            {
+                size_ = 0;
+                copy_words(rhs);
+            }
+        }
+        return *this;
+    }
+
+    // 预留空间大小，当原容量小于要求大小时，才会重新分配
+    template <class Alloc>
+    void vector<bool, Alloc>::reserve(size_type n)
+    {
+        if (capacity() < n)
+        {
+            THROW_LENGTH_ERROR_IF(n > max_size(),
+                                  "n can not larger than max_size() in vector<bool>::reserve(n)");
+            reallocate_around(size_, 0, word_count(n) * bit_word_bits);
+        }
+    }
+
+    // 放弃多余的容量
+    template <class Alloc>
+    void vector<bool, Alloc>::shrink_to_fit()
+    {
+        if (word_count(size_) == word_count(cap_))
+        {
+            return;
+        }
+        if (size_ == 0)
+        {
+            release();
+            return;
+        }
+        reallocate_around(size_, 0, word_count(size_) * bit_word_bits);
+    }
+
+    // 用 n 个 value 为容器赋值
+    template <class Alloc>
+    void vector<bool, Alloc>::assign(size_type n, const value_type &value)
+    {
+        if (n > cap_)
+        {
+            size_ = 0;
+            reserve(n);
+        }
+        size_ = n;
+        mySTL::fill(begin(), end(), value);
+    }
+
+    // 在尾部添加元素
+    template <class Alloc>
+    void vector<bool, Alloc>::push_back(const value_type &value)
+    {
+        if (size_ == cap_)
+        {
+            reallocate_around(size_, 0, get_new_cap(1));
+        }
+        ++size_;
+        (*this)[size_ - 1] = value;
+    }
+
+    // 在 pos 处插入 n 个元素
+    template <class Alloc>
+    typename vector<bool, Alloc>::iterator
+    vector<bool, Alloc>::insert(const_iterator pos, size_type n, const value_type &value)
+    {
+        MYSTL_DEBUG(pos >= begin() && pos <= end());
+        const value_type value_copy = value; // value 可能引用容器中的元素
+        const size_type xpos = static_cast<size_type>(pos - begin());
+        open_gap(xpos, n);
+        mySTL::fill(begin() + xpos, begin() + (xpos + n), value_copy);
+        return begin() + xpos;
+    }
+
+    // 删除[first, last)上的元素
+    template <class Alloc>
+    typename vector<bool, Alloc>::iterator
+    vector<bool, Alloc>::erase(const_iterator first, const_iterator last)
+    {
+        MYSTL_DEBUG(first >= begin() && last <= end() && !(last < first));
+        const size_type xpos = static_cast<size_type>(first - begin());
+        mySTL::copy(last, cend(), mutable_iter(first));
+        size_ -= static_cast<size_type>(last - first);
+        return begin() + xpos;
+    }
+
+    // 重置容器大小
+    template <class Alloc>
+    void vector<bool, Alloc>::resize(size_type new_size, const value_type &value)
+    {
+        if (new_size < size_)
+        {
+            size_ = new_size;
+        }
+        else
+        {
+            insert(end(), new_size - size_, value);
+        }
+    }
+
+    // 与另一个 vector<bool> 交换
+    template <class Alloc>
+    void vector<bool, Alloc>::swap(vector &rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            MYSTL_DEBUG(word_traits::propagate_on_container_swap::value ||
+                        mySTL::alloc_equal(this->alloc_ref(), rhs.alloc_ref()));
+            mySTL::alloc_swap(this->alloc_ref(), rhs.alloc_ref(),
+                              typename word_traits::propagate_on_container_swap{});
+            mySTL::swap(words_, rhs.words_);
+            mySTL::swap(size_, rhs.size_);
+            mySTL::swap(cap_, rhs.cap_);
+        }
+    }
+
+    /*
+    helper_function
+     */
+
+    // fill_init 函数
+    template <class Alloc>
+    void vector<bool, Alloc>::fill_init(size_type n, const value_type &value)
+    {
+        reserve(n);
+        size_ = n;
+        mySTL::fill(begin(), end(), value);
+    }
+
+    // 当前对象为空：按字复制 rhs 的元素
+    template <class Alloc>
+    void vector<bool, Alloc>::copy_words(const vector &rhs)
+    {
+        MYSTL_DEBUG(size_ == 0);
+        reserve(rhs.size_);
+        mySTL::uninitialized_copy_n(rhs.words_, word_count(rhs.size_), words_);
+        size_ = rhs.size_;
+    }
+
+    // 当前对象没有空间：接管 rhs 的空间
+    template <class Alloc>
+    void vector<bool, Alloc>::steal(vector &rhs) noexcept
+    {
+        words_ = rhs.words_;
+        size_ = rhs.size_;
+        cap_ = rhs.cap_;
+        rhs.words_ = nullptr;
+        rhs.size_ = 0;
+        rhs.cap_ = 0;
+    }
+
+    // 释放空间
+    template <class Alloc>
+    void vector<bool, Alloc>::release() noexcept
+    {
+        if (words_ != nullptr)
+        {
+            word_traits::deallocate(this->alloc_ref(), words_, cap_ / bit_word_bits);
+        }
+        words_ = nullptr;
+        size_ = 0;
+        cap_ = 0;
+    }
+
+    // get_new_cap 函数，按字对齐，至少一个字
+    template <class Alloc>
+    typename vector<bool, Alloc>::size_type
+    vector<bool, Alloc>::get_new_cap(size_type add_size)
+    {
+        const auto old_size = capacity();
+        THROW_LENGTH_ERROR_IF(old_size > max_size() - add_size,
+                              "vector<bool>'s size too big");
+        size_type new_cap = old_size + add_size;
+        if (old_size <= max_size() - old_size / 2)
+        {
+            new_cap = mySTL::max(old_size + old_size / 2, new_cap);
+        }
+        new_cap = mySTL::max(new_cap, static_cast<size_type>(bit_word_bits));
+        return mySTL::min(word_count(new_cap) * bit_word_bits, max_size());
+    }
+
+    template <class Alloc>
+    void vector<bool, Alloc>::reallocate_around(size_type pos, size_type n, size_type new_cap)
+    {
+        bit_word *new_words = word_traits::allocate(this->alloc_ref(), new_cap / bit_word_bits);
+        iterator new_begin(new_words, 0);
+        mySTL::copy(cbegin(), cbegin() + pos, new_begin);
+        mySTL::copy(cbegin() + pos, cend(), new_begin + (pos + n));
+        const size_type new_size = size_ + n;
+        release();
+        words_ = new_words;
+        size_ = new_size;
+        cap_ = new_cap;
+    }
+
+    template <class Alloc>
+    void vector<bool, Alloc>::open_gap(size_type pos, size_type n)
+    {
+        if (n == 0)
+        {
+            return;
+        }
+        if (cap_ - size_ < n)
+        {
+            reallocate_around(pos, n, get_new_cap(n));
+            return;
+        }
+        const_iterator old_end = cend();
+        size_ += n;
+        mySTL::copy_backward(cbegin() + pos, old_end, end());
+    }
+
+    // 输入迭代器只能逐个插入
+    template <class Alloc>
+    template <class IIter>
+    typename vector<bool, Alloc>::iterator
+    vector<bool, Alloc>::copy_insert(size_type pos, IIter first, IIter last, input_iterator_tag)
+    {
+        for (size_type i = pos; first != last; ++first, ++i)
+        {
+            insert(cbegin() + i, static_cast<value_type>(*first));
+        }
+        return begin() + pos;
+    }
+
+    template <class Alloc>
+    template <class FIter>
+    typename vector<bool, Alloc>::iterator
+    vector<bool, Alloc>::copy_insert(size_type pos, FIter first, FIter last, forward_iterator_tag)
+    {
+        const size_type n = static_cast<size_type>(mySTL::distance(first, last));
+        open_gap(pos, n);
+        mySTL::copy(first, last, begin() + pos);
+        return begin() + pos;
+    }
+
+    /*
+    重载比较符
+     */
+
+    // 整字比较，最后一个字只比较有效的位
+    template <class Alloc>
+    bool operator==(const vector<bool, Alloc> &lhs, const vector<bool, Alloc> &rhs)
+    {
+        if (lhs.size() != rhs.size())
+            return false;
+        const size_t full = lhs.size() / bit_word_bits;
+        const bit_word *p = lhs.begin().p;
+        const bit_word *q = rhs.begin().p;
+        for (size_t i = 0; i < full; ++i)
+        {
+            if (p[i] != q[i])
+                return false;
+        }
+        const unsigned rest = static_cast<unsigned>(lhs.size() % bit_word_bits);
+        return rest == 0 || ((p[full] ^ q[full]) & bit_low_mask(rest)) == 0;
+    }
+
+}
+
+#endif // !MYSTL_BVECTOR_H_
@@ -0,0 +1,747 @@
+#ifndef MYSTL_CIRCULAR_BUFFER_H_
+#define MYSTL_CIRCULAR_BUFFER_H_
+
+// 这个头文件包含一个模板类 circular_buffer
+// circular_buffer : 容量固定的环形缓冲区，元素保存在一块连续内存中，首尾相接，
+//                   可以作为 queue / stack 的底层容器，用于不需要增长的有界队列：
+//   mySTL::circular_buffer<int> buf;
+//   buf.reserve(1024);
+//   mySTL::queue<int, mySTL::circular_buffer<int>> q(mySTL::move(buf));
+
+// notes:
+//
+// 容量总是 2 的幂，第 i 个元素位于 (head + i) & (capacity - 1)，下标计算只需要一次按位与
+// 容量只由构造函数与 reserve 决定，push 不会重新分配内存；默认构造的 circular_buffer 容量为 0
+// 容量为 0 时没有可以放入或覆盖的位置，push / emplace 抛出 std::length_error 而不是静默丢弃，
+// 用作 queue / stack 的底层容器时必须先通过构造函数或 reserve 给出容量
+// 缓冲区满时的行为由 circular_buffer_overflow 决定：
+//   overwrite : 覆盖另一端的元素（push_back 覆盖最旧的 front，push_front 覆盖 back），默认行为
+//   reject    : 丢弃新元素，容器不变
+// push / emplace 返回 bool，表示新元素是否放入了缓冲区
+// 异常保证：reserve 满足强异常安全保证，未满时的 push / emplace 满足强异常安全保证
+
+#include <initializer_list>
+#include <type_traits>
+#include <utility>
+
+#include "../../iterator/iterator.h"
+#include "../../util/memory.h"
+#include "../../util/util.h"
+#include "../../util/exceptdef.h"
+#include "../../algorithm/algo.h"
+
+namespace mySTL
+{
+#ifdef max
+#pragma message("#undefing marco max")
+#undef max
+#endif // max
+
+#ifdef min
+#pragma message("#undefing marco min")
+#undef min
+#endif // min
+
+    // 缓冲区满时的处理方式
+    enum class circular_buffer_overflow
+    {
+        overwrite, // 覆盖另一端的元素
+        reject     // 丢弃新元素
+    };
+
+    // 不小于 n 的最小的 2 的幂，n 为 0 时返回 0
+    inline size_t circular_buffer_capacity(size_t n) noexcept
+    {
+        size_t cap = n == 0 ? 0 : 1;
+        while (cap < n)
+            cap <<= 1;
+        return cap;
+    }
+
+    // circular_buffer 的迭代器设计：保存缓冲区起始地址、掩码与未取模的逻辑位置
+    template <class T, class Ref, class Ptr>
+    struct circular_buffer_iterator : public iterator<random_access_iterator_tag, T>
+    {
+        typedef circular_buffer_iterator<T, T &, T *> iterator;
+        typedef circular_buffer_iterator<T, const T &, const T *> const_iterator;
+        typedef circular_buffer_iterator self;
+
+        typedef T value_type;
+        typedef Ptr pointer;
+        typedef Ref reference;
+        typedef size_t size_type;
+        typedef ptrdiff_t difference_type;
+
+        T *data;        // 缓冲区起始地址
+        size_type mask; // capacity - 1
+        size_type pos;  // 逻辑位置，取模后才是下标
+
+        circular_buffer_iterator() noexcept
+            : data(nullptr), mask(0), pos(0) {}
+        circular_buffer_iterator(T *d, size_type m, size_type p) noexcept
+            : data(d), mask(m), pos(p) {}
+        circular_buffer_iterator(const iterator &rhs) noexcept
+            : data(rhs.data), mask(rhs.mask), pos(rhs.pos) {}
+
+        reference operator*() const noexcept { return data[pos & mask]; }
+        pointer operator->() const noexcept { return &(operator*()); }
+        reference operator[](difference_type n) const noexcept { return *(*this + n); }
+
+        self &operator++() noexcept
+        {
+            ++pos;
+            return *this;
+        }
+        self operator++(int) noexcept
+        {
+            self tmp = *this;
+            ++pos;
+            return tmp;
+        }
+        self &operator--() noexcept
+        {
+            --pos;
+            return *this;
+        }
+        self operator--(int) noexcept
+        {
+            self tmp = *this;
+            --pos;
+            return tmp;
+        }
+
+        self &operator+=(difference_type n) noexcept
+        {
+            pos += n;
+            return *this;
+        }
+        self operator+(difference_type n) const noexcept
+        {
+            self tmp = *this;
+            return tmp += n;
+        }
+        self &operator-=(difference_type n) noexcept
+        {
+            pos -= n;
+            return *this;
+        }
+        self operator-(difference_type n) const noexcept
+        {
+            self tmp = *this;
+            return tmp -= n;
+        }
+        difference_type operator-(const self &rhs) const noexcept
+        {
+            return static_cast<difference_type>(pos - rhs.pos);
+        }
+
+        // 同一个容器的迭代器之间才能比较
+        bool operator==(const self &rhs) const noexcept { return pos == rhs.pos; }
+        bool operator!=(const self &rhs) const noexcept { return pos != rhs.pos; }
+        bool operator<(const self &rhs) const noexcept { return *this - rhs < 0; }
+        bool operator>(const self &rhs) const noexcept { return rhs < *this; }
+        bool operator<=(const self &rhs) const noexcept { return !(rhs < *this); }
+        bool operator>=(const self &rhs) const noexcept { return !(*this < rhs); }
+    };
+
+    // 模板类 circular_buffer
+    // 模板参数 T 代表类型，Alloc 代表分配器
+    template <class T, class Alloc = mySTL::allocator<T>>
+    class circular_buffer
+        : private mySTL::alloc_holder<typename mySTL::allocator_traits<Alloc>::template rebind_alloc<T>>
+    {
+        static_assert(std::is_same<T, typename Alloc::value_type>::value,
+                      "the value_type of Alloc should be same with T");
+
+    public:
+        // circular_buffer 的型别定义
+        typedef Alloc allocator_type;
+        typedef typename mySTL::allocator_traits<Alloc>::template rebind_alloc<T> data_allocator;
+        typedef mySTL::allocator_traits<data_allocator> data_traits;
+
+        typedef T value_type;
+        typedef typename data_traits::pointer pointer;
+        typedef typename data_traits::const_pointer const_pointer;
+        typedef value_type &reference;
+        typedef const value_type &const_reference;
+        typedef typename data_traits::size_type size_type;
+        typedef typename data_traits::difference_type difference_type;
+
+        typedef circular_buffer_iterator<T, T &, T *> iterator;
+        typedef circular_buffer_iterator<T, const T &, const T *> const_iterator;
+        typedef mySTL::reverse_iterator<iterator> reverse_iterator;
+        typedef mySTL::reverse_iterator<const_iterator> const_reverse_iterator;
+
+        allocator_type get_allocator() const { return allocator_type(this->alloc_ref()); }
+
+    private:
+        typedef mySTL::alloc_holder<data_allocator> alloc_base;
+
+        pointer data_ = nullptr; // 连续的缓冲区
+        size_type cap_ = 0;      // 容量，总是 0 或 2 的幂
+        size_type head_ = 0;     // 第一个元素的下标
+        size_type size_ = 0;     // 元素个数
+        circular_buffer_overflow overflow_ = circular_buffer_overflow::overwrite;
+
+    public:
+        // 构造、复制、移动、析构函数
+
+        circular_buffer() = default;
+
+        explicit circular_buffer(const allocator_type &alloc)
+            : alloc_base(data_allocator(alloc))
+        {
+        }
+
+        explicit circular_buffer(size_type n, const allocator_type &alloc = allocator_type())
+            : alloc_base(data_allocator(alloc))
+        {
+            fill_init(n, value_type());
+        }
+
+        circular_buffer(size_type n, const value_type &value,
+                        const allocator_type &alloc = allocator_type())
+            : alloc_base(data_allocator(alloc))
+        {
+            fill_init(n, value);
+        }
+
+        template <class IIter, typename std::enable_if<
+                                   mySTL::is_input_iterator<IIter>::value, int>::type = 0>
+        circular_buffer(IIter first, IIter last, const allocator_type &alloc = allocator_type())
+            : alloc_base(data_allocator(alloc))
+        {
+            copy_init(first, last, iterator_category(first));
+        }
+
+        circular_buffer(std::initializer_list<value_type> ilist,
+                        const allocator_type &alloc = allocator_type())
+            : alloc_base(data_allocator(alloc))
+        {
+            copy_init(ilist.begin(), ilist.end(), mySTL::forward_iterator_tag());
+        }
+
+        circular_buffer(const circular_buffer &rhs)
+            : alloc_base(data_traits::select_on_container_copy_construction(rhs.alloc_ref())),
+              overflow_(rhs.overflow_)
+        {
+            copy_from(rhs);
+        }
+
+        circular_buffer(const circular_buffer &rhs, const allocator_type &alloc)
+            : alloc_base(data_allocator(alloc)), overflow_(rhs.overflow_)
+        {
+            copy_from(rhs);
+        }
+
+        circular_buffer(circular_buffer &&rhs) noexcept
+            : alloc_base(mySTL::move(rhs.alloc_ref()))
+        {
+            steal(rhs);
+        }
+
+        circular_buffer(circular_buffer &&rhs, const allocator_type &alloc);
+
+        circular_buffer &operator=(const circular_buffer &rhs);
+        circular_buffer &operator=(circular_buffer &&rhs) noexcept(
+            data_traits::propagate_on_container_move_assignment::value ||
+            data_traits::is_always_equal::value);
+
+        circular_buffer &operator=(std::initializer_list<value_type> ilist)
+        {
+            circular_buffer tmp(ilist, get_allocator());
+            tmp.overflow_ = overflow_;
+            swap(tmp);
+            return *this;
+        }
+
+        ~circular_buffer()
+        {
+            destroy_all();
+        }
+
+    public:
+        // 迭代器相关操作
+
+        iterator begin() noexcept { return iterator(data_, cap_ - 1, head_); }
+        const_iterator begin() const noexcept { return const_iterator(data_, cap_ - 1, head_); }
+        iterator end() noexcept { return iterator(data_, cap_ - 1, head_ + size_); }
+        const_iterator end() const noexcept { return const_iterator(data_, cap_ - 1, head_ + size_); }
+
+        reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+        const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+        reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+        const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+        const_iterator cbegin() const noexcept { return begin(); }
+        const_iterator cend() const noexcept { return end(); }
+        const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+        const_reverse_iterator crend() const noexcept { return rend(); }
+
+        // 容量相关操作
+
+        bool empty() const noexcept { return size_ == 0; }
+        bool full() const noexcept { return size_ == cap_; }
+        size_type size() const noexcept { return size_; }
+        size_type capacity() const noexcept { return cap_; }
+        size_type max_size() const noexcept { return static_cast<size_type>(-1) / sizeof(T); }
+        void reserve(size_type n);
+
+        circular_buffer_overflow overflow_policy() const noexcept { return overflow_; }
+        void set_overflow_policy(circular_buffer_overflow policy) noexcept { overflow_ = policy; }
+
+        // 访问元素相关操作
+
+        reference operator[](size_type n)
+        {
+            MYSTL_DEBUG(n < size_);
+            return data_[(head_ + n) & (cap_ - 1)];
+        }
+        const_reference operator[](size_type n) const
+        {
+            MYSTL_DEBUG(n < size_);
+            return data_[(head_ + n) & (cap_ - 1)];
+        }
+
+        reference at(size_type n)
+        {
+            THROW_OUT_OF_RANGE_IF(!(n < size_), "circular_buffer<T>::at() subscript out of range");
+            return (*this)[n];
+        }
+        const_reference at(size_type n) const
+        {
+            THROW_OUT_OF_RANGE_IF(!(n < size_), "circular_buffer<T>::at() subscript out of range");
+            return (*this)[n];
+        }
+
+        reference front()
+        {
+            MYSTL_DEBUG(!empty());
+            return data_[head_];
+        }
+        const_reference front() const
+        {
+            MYSTL_DEBUG(!empty());
+            return data_[head_];
+        }
+        reference back()
+        {
+            MYSTL_DEBUG(!empty());
+            return data_[(head_ + size_ - 1) & (cap_ - 1)];
+        }
+        const_reference back() const
+        {
+            MYSTL_DEBUG(!empty());
+            return data_[(head_ + size_ - 1) & (cap_ - 1)];
+        }
+
+        // 修改容器相关操作
+
+        // emplace_front / emplace_back
+        template <class... Args>
+        bool emplace_front(Args &&...args);
+        template <class... Args>
+        bool emplace_back(Args &&...args);
+
+        // push_front / push_back
+        bool push_front(const value_type &value) { return put_front(value); }
+        bool push_front(value_type &&value) { return put_front(mySTL::move(value)); }
+        bool push_back(const value_type &value) { return put_back(value); }
+        bool push_back(value_type &&value) { return put_back(mySTL::move(value)); }
+
+        // pop_front / pop_back
+        void pop_front();
+        void pop_back();
+
+        void clear() noexcept;
+        void swap(circular_buffer &rhs) noexcept;
+
+    private:
+        // helper functions
+
+        size_type slot(size_type n) const noexcept { return (head_ + n) & (cap_ - 1); }
+
+        // initialize / destroy
+        void allocate_buffer(size_type n);
+        void fill_init(size_type n, const value_type &value);
+        template <class IIter>
+        void copy_init(IIter first, IIter last, input_iterator_tag);
+        template <class FIter>
+        void copy_init(FIter first, FIter last, forward_iterator_tag);
+        void copy_from(const circular_buffer &rhs);
+        void steal(circular_buffer &rhs) noexcept;
+        void destroy_all() noexcept;
+
+        // push
+        template <class Arg>
+        bool put_front(Arg &&value);
+        template <class Arg>
+        bool put_back(Arg &&value);
+    };
+
+    /*****************************************************************************************/
+
+    // 移动构造函数，分配器不相等时逐个移动元素
+    template <class T, class Alloc>
+    circular_buffer<T, Alloc>::circular_buffer(circular_buffer &&rhs, const allocator_type &alloc)
+        : alloc_base(data_allocator(alloc))
+    {
+        if (mySTL::alloc_equal(this->alloc_ref(), rhs.alloc_ref()))
+        {
+            steal(rhs);
+        }
+        else
+        {
+            overflow_ = rhs.overflow_;
+            allocate_buffer(rhs.cap_);
+            for (size_type i = 0; i < rhs.size_; ++i)
+                emplace_back(mySTL::move(rhs[i]));
+            rhs.clear();
+        }
+    }
+
+    // 复制赋值运算符，容量与溢出策略一并复制
+    template <class T, class Alloc>
+    circular_buffer<T, Alloc> &circular_buffer<T, Alloc>::operator=(const circular_buffer &rhs)
+    {
+        if (this != &rhs)
+        {
+            destroy_all();
+            mySTL::alloc_copy_assign(this->alloc_ref(), rhs.alloc_ref(),
+                                     typename data_traits::propagate_on_container_copy_assignment{});
+            overflow_ = rhs.overflow_;
+            copy_from(rhs);
+        }
+        return *this;
+    }
+
+    // 移动赋值运算符
+    template <class T, class Alloc>
+    circular_buffer<T, Alloc> &circular_buffer<T, Alloc>::operator=(circular_buffer &&rhs) noexcept(
+        data_traits::propagate_on_container_move_assignment::value ||
+        data_traits::is_always_equal::value)
+    {
+        if (this != &rhs)
+        {
+            destroy_all();
+            if (data_traits::propagate_on_container_move_assignment::value ||
+                mySTL::alloc_equal(this->alloc_ref(), rhs.alloc_ref()))
+            {
+                mySTL::alloc_move_assign(this->alloc_ref(), rhs.alloc_ref(),
+                                         typename data_traits::propagate_on_container_move_assignment{});
+                steal(rhs);
+            }
+            else
+            {
+                overflow_ = rhs.overflow_;
+                allocate_buffer(rhs.cap_);
+                for (size_type i = 0; i < rhs.size_; ++i)
+                    emplace_back(mySTL::move(rhs[i]));
+                rhs.clear();
+            }
+        }
+        return *this;
+    }
+
+    // 把容量扩大到不小于 n 的 2 的幂，元素按顺序移到新缓冲区的开头
+    template <class T, class Alloc>
+    void circular_buffer<T, Alloc>::reserve(size_type n)
+    {
+        if (n <= cap_)
+            return;
+        THROW_LENGTH_ERROR_IF(n > max_size(), "n can not larger than max_size() in circular_buffer<T>::reserve(n)");
+        const size_type new_cap = circular_buffer_capacity(n);
+        pointer new_data = data_traits::allocate(this->alloc_ref(), new_cap);
+        size_type i = 0;
+        try
+        {
+            for (; i < size_; ++i)
+                data_traits::construct(this->alloc_ref(), new_data + i, std::move_if_noexcept((*this)[i]));
+        }
+        catch (...)
+        {
+            data_traits::destroy(this->alloc_ref(), new_data, new_data + i);
+            data_traits::deallocate(this->alloc_ref(), new_data, new_cap);
+            throw;
+        }
+        const size_type len = size_;
+        destroy_all();
+        data_ = new_data;
+        cap_ = new_cap;
+        size_ = len;
+    }
+
+    // 在头部就地构建元素
+    template <class T, class Alloc>
+    template <class... Args>
+    bool circular_buffer<T, Alloc>::emplace_front(Args &&...args)
+    {
+        if (size_ == cap_)
+        { // 参数可能引用即将被覆盖的元素，先构建临时对象
+            THROW_LENGTH_ERROR_IF(cap_ == 0, "circular_buffer<T> has no capacity");
+            if (overflow_ == circular_buffer_overflow::reject)
+                return false;
+            return put_front(value_type(mySTL::forward<Args>(args)...));
+        }
+        const size_type n = (head_ - 1) & (cap_ - 1);
+        data_traits::construct(this->alloc_ref(), data_ + n, mySTL::forward<Args>(args)...);
+        head_ = n;
+        ++size_;
+        return true;
+    }
+
+    // 在尾部就地构建元素
+    template <class T, class Alloc>
+    template <class... Args>
+    bool circular_buffer<T, Alloc>::emplace_back(Args &&...args)
+    {
+        if (size_ == cap_)
+        {
+            THROW_LENGTH_ERROR_IF(cap_ == 0, "circular_buffer<T> has no capacity");
+            if (overflow_ == circular_buffer_overflow::reject)
+                return false;
+            return put_back(value_type(mySTL::forward<Args>(args)...));
+        }
+        data_traits::construct(this->alloc_ref(), data_ + slot(size_), mySTL::forward<Args>(args)...);
+        ++size_;
+        return true;
+    }
+
+    template <class T, class Alloc>
+    void circular_buffer<T, Alloc>::pop_front()
+    {
+        MYSTL_DEBUG(!empty());
+        data_traits::destroy(this->alloc_ref(), data_ + head_);
+        head_ = (head_ + 1) & (cap_ - 1);
+        --size_;
+    }
+
+    template <class T, class Alloc>
+    void circular_buffer<T, Alloc>::pop_back()
+    {
+        MYSTL_DEBUG(!empty());
+        data_traits::destroy(this->alloc_ref(), data_ + slot(size_ - 1));
+        --size_;
+    }
+
+    // 清空元素，保留缓冲区
+    template <class T, class Alloc>
+    void circular_buffer<T, Alloc>::clear() noexcept
+    {
+        while (size_ != 0)
+            pop_back();
+        head_ = 0;
+    }
+
+    // 交换两个 circular_buffer
+    template <class T, class Alloc>
+    void circular_buffer<T, Alloc>::swap(circular_buffer &rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            MYSTL_DEBUG(data_traits::propagate_on_container_swap::value ||
+                        mySTL::alloc_equal(this->alloc_ref(), rhs.alloc_ref()));
+            mySTL::alloc_swap(this->alloc_ref(), rhs.alloc_ref(),
+                              typename data_traits::propagate_on_container_swap{});
+            mySTL::swap(data_, rhs.data_);
+            mySTL::swap(cap_, rhs.cap_);
+            mySTL::swap(head_, rhs.head_);
+            mySTL::swap(size_, rhs.size_);
+            mySTL::swap(overflow_, rhs.overflow_);
+        }
+    }
+
+    /*****************************************************************************************/
+    // helper function
+
+    // 分配容量不小于 n 的缓冲区，容器此时没有缓冲区
+    template <class T, class Alloc>
+    void circular_buffer<T, Alloc>::allocate_buffer(size_type n)
+    {
+        THROW_LENGTH_ERROR_IF(n > max_size(), "circular_buffer<T>'s size too big");
+        cap_ = circular_buffer_capacity(n);
+        head_ = 0;
+        size_ = 0;
+        data_ = cap_ == 0 ? nullptr : data_traits::allocate(this->alloc_ref(), cap_);
+    }
+
+    template <class T, class Alloc>
+    void circular_buffer<T, Alloc>::fill_init(size_type n, const value_type &value)
+    {
+        allocate_buffer(n);
+        try
+        {
+            data_traits::uninitialized_fill_n(this->alloc_ref(), data_, n, value);
+        }
+        catch (...)
+        {
+            destroy_all();
+            throw;
+        }
+        size_ = n;
+    }
+
+    // input iterator 不能预先求出长度，逐个放入，放满时扩大容量
+    template <class T, class Alloc>
+    template <class IIter>
+    void circular_buffer<T, Alloc>::copy_init(IIter first, IIter last, input_iterator_tag)
+    {
+        try
+        {
+            for (; first != last; ++first)
+            {
+                if (size_ == cap_)
+                    reserve(cap_ == 0 ? 1 : cap_ * 2);
+                emplace_back(*first);
+            }
+        }
+        catch (...)
+        {
+            destroy_all();
+            throw;
+        }
+    }
+
+    template <class T, class Alloc>
+    template <class FIter>
+    void circular_buffer<T, Alloc>::copy_init(FIter first, FIter last, forward_iterator_tag)
+    {
+        const size_type n = mySTL::distance(first, last);
+        allocate_buffer(n);
+        try
+        {
+            data_traits::uninitialized_copy(this->alloc_ref(), first, last, data_);
+        }
+        catch (...)
+        {
+            destroy_all();
+            throw;
+        }
+        size_ = n;
+    }
+
+    // 复制 rhs 的容量与元素，元素放在新缓冲区的开头
+    template <class T, class Alloc>
+    void circular_buffer<T, Alloc>::copy_from(const circular_buffer &rhs)
+    {
+        allocate_buffer(rhs.cap_);
+        try
+        {
+            data_traits::uninitialized_copy(this->alloc_ref(), rhs.begin(), rhs.end(), data_);
+        }
+        catch (...)
+        {
+            destroy_all();
+            throw;
+        }
+        size_ = rhs.size_;
+    }
+
+    // 接管 rhs 的缓冲区，rhs 变为容量为 0 的空容器
+    template <class T, class Alloc>
+    void circular_buffer<T, Alloc>::steal(circular_buffer &rhs) noexcept
+    {
+        data_ = rhs.data_;
+        cap_ = rhs.cap_;
+        head_ = rhs.head_;
+        size_ = rhs.size_;
+        overflow_ = rhs.overflow_;
+        rhs.data_ = nullptr;
+        rhs.cap_ = 0;
+        rhs.head_ = 0;
+        rhs.size_ = 0;
+    }
+
+    // 析构所有元素并归还缓冲区
+    template <class T, class Alloc>
+    void circular_buffer<T, Alloc>::destroy_all() noexcept
+    {
+        clear();
+        if (data_ != nullptr)
+            data_traits::deallocate(this->alloc_ref(), data_, cap_);
+        data_ = nullptr;
+        cap_ = 0;
+    }
+
+    // 缓冲区满时按溢出策略覆盖 back 或拒绝
+    template <class T, class Alloc>
+    template <class Arg>
+    bool circular_buffer<T, Alloc>::put_front(Arg &&value)
+    {
+        if (size_ != cap_)
+            return emplace_front(mySTL::forward<Arg>(value));
+        THROW_LENGTH_ERROR_IF(cap_ == 0, "circular_buffer<T> has no capacity");
+        if (overflow_ == circular_buffer_overflow::reject)
+            return false;
+        // 满时 back 的下一个位置就是 front 的前一个位置，赋值给 back 后把它转到头部
+        const size_type n = (head_ - 1) & (cap_ - 1);
+        data_[n] = mySTL::forward<Arg>(value);
+        head_ = n;
+        return true;
+    }
+
+    // 缓冲区满时按溢出策略覆盖 front 或拒绝
+    template <class T, class Alloc>
+    template <class Arg>
+    bool circular_buffer<T, Alloc>::put_back(Arg &&value)
+    {
+        if (size_ != cap_)
+            return emplace_back(mySTL::forward<Arg>(value));
+        THROW_LENGTH_ERROR_IF(cap_ == 0, "circular_buffer<T> has no capacity");
+        if (overflow_ == circular_buffer_overflow::reject)
+            return false;
+        // 满时 front 所在的位置就是 back 的下一个位置，赋值后 front 后移一位
+        data_[head_] = mySTL::forward<Arg>(value);
+        head_ = (head_ + 1) & (cap_ - 1);
+        return true;
+    }
+
+    /*****************************************************************************************/
+    // 重载比较操作符
+
+    template <class T, class Alloc>
+    bool operator==(const circular_buffer<T, Alloc> &lhs, const circular_buffer<T, Alloc> &rhs)
+    {
+        return lhs.size() == rhs.size() &&
+               mySTL::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+
+    template <class T, class Alloc>
+    bool operator<(const circular_buffer<T, Alloc> &lhs, const circular_buffer<T, Alloc> &rhs)
+    {
+        return mySTL::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+    template <class T, class Alloc>
+    bool operator!=(const circular_buffer<T, Alloc> &lhs, const circular_buffer<T, Alloc> &rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    template <class T, class Alloc>
+    bool operator>(const circular_buffer<T, Alloc> &lhs, const circular_buffer<T, Alloc> &rhs)
+    {
+        return rhs < lhs;
+    }
+
+    template <class T, class Alloc>
+    bool operator<=(const circular_buffer<T, Alloc> &lhs, const circular_buffer<T, Alloc> &rhs)
+    {
+        return !(rhs < lhs);
+    }
+
+    template <class T, class Alloc>
+    bool operator>=(const circular_buffer<T, Alloc> &lhs, const circular_buffer<T, Alloc> &rhs)
+    {
+        return !(lhs < rhs);
+    }
+
+    // 重载 mySTL 的 swap
+    template <class T, class Alloc>
+    void swap(circular_buffer<T, Alloc> &lhs, circular_buffer<T, Alloc> &rhs) noexcept
+    {
+        lhs.swap(rhs);
+    }
+
+} // namespace mySTL
+#endif // !MYSTL_CIRCULAR_BUFFER_H_
@@ -0,0 +1,846 @@
+#ifndef MYSTL_CONCURRENT_VECTOR_H_
+#define MYSTL_CONCURRENT_VECTOR_H_
+
+// 这个头文件包含一个模板类 concurrent_vector
+// concurrent_vector : 由按几何级数增长的段组成的 vector，多个线程可以同时 push_back，
+//                     元素从不搬移，下标、引用与迭代器在增长时保持有效
+
+// notes:
+//
+// 第 k 段容纳 first_segment_size << k 个元素，下标 i 所在的段与段内偏移由 i 直接算出，
+// 段表是固定大小的数组，增长时只分配新的段，不会像 vector::reallocate_insert 那样整体搬移
+//
+// 线程安全：
+//   * push_back、emplace_back、grow_by、grow_to_at_least、reserve 可以与彼此以及
+//     对已构造元素的读取（operator[]、at、迭代器）并发执行
+//   * size() 包含其他线程已占用但可能尚未构造完成的位置，
+//     只应读取本线程插入的元素，或在同步（如 join）之后读取
+//   * 构造、赋值、swap、clear、析构不是线程安全的
+//
+// 异常保证：
+//   * emplace_back、push_back 先在占用位置之前构造好元素，构造抛出异常时容器不变
+//   * 段由占到其首个下标的线程分配，其余线程等待；占用位置之后分配失败无法撤销，直接终止程序
+//   * 分配器需要能被多个线程同时使用
+
+#include <atomic>
+#include <initializer_list>
+#include <thread>
+#include <type_traits>
+
+#include "../../iterator/iterator.h"
+#include "../../util/memory.h"
+#include "../../util/util.h"
+#include "../../util/exceptdef.h"
+#include "../../algorithm/algo.h"
+
+namespace mySTL
+{
+#ifdef max
+#pragma message("#undefing marco max")
+#undef max
+#endif // max
+
+#ifdef min
+#pragma message("#undefing marco min")
+#undef min
+#endif // min
+
+    // concurrent_vector 的迭代器设计：保存容器地址与下标，解引用时定位所在的段
+    template <class Vec, class T>
+    struct concurrent_vector_iterator : public iterator<random_access_iterator_tag, T>
+    {
+        typedef T value_type;
+        typedef T *pointer;
+        typedef T &reference;
+        typedef ptrdiff_t difference_type;
+        typedef concurrent_vector_iterator self;
+
+        Vec *vec;   // 所属的容器
+        size_t idx; // 当前下标
+
+        concurrent_vector_iterator() noexcept
+            : vec(nullptr), idx(0) {}
+        concurrent_vector_iterator(Vec *v, size_t i) noexcept
+            : vec(v), idx(i) {}
+
+        // iterator 可以转换为 const_iterator
+        template <class V, class U, typename std::enable_if<
+                                        std::is_convertible<V *, Vec *>::value &&
+                                            !std::is_same<V, Vec>::value,
+                                        int>::type = 0>
+        concurrent_vector_iterator(const concurrent_vector_iterator<V, U> &rhs) noexcept
+            : vec(rhs.vec), idx(rhs.idx) {}
+
+        reference operator*() const { return (*vec)[idx]; }
+        pointer operator->() const { return &(operator*()); }
+        reference operator[](difference_type n) const { return (*vec)[idx + n]; }
+
+        self &operator++() noexcept
+        {
+            ++idx;
+            return *this;
+        }
+        self operator++(int) noexcept
+        {
+            self tmp = *this;
+            ++idx;
+            return tmp;
+        }
+        self &operator--() noexcept
+        {
+            --idx;
+            return *this;
+        }
+        self operator--(int) noexcept
+        {
+            self tmp = *this;
+            --idx;
+            return tmp;
+        }
+
+        self &operator+=(difference_type n) noexcept
+        {
+            idx += n;
+            return *this;
+        }
+        self &operator-=(difference_type n) noexcept
+        {
+            idx -= n;
+            return *this;
+        }
+        self operator+(difference_type n) const noexcept { return self(vec, idx + n); }
+        self operator-(difference_type n) const noexcept { return self(vec, idx - n); }
+        difference_type operator-(const self &rhs) const noexcept
+        {
+            return static_cast<difference_type>(idx) - static_cast<difference_type>(rhs.idx);
+        }
+
+        bool operator==(const self &rhs) const noexcept { return idx == rhs.idx; }
+        bool operator!=(const self &rhs) const noexcept { return idx != rhs.idx; }
+        bool operator<(const self &rhs) const noexcept { return idx < rhs.idx; }
+        bool operator>(const self &rhs) const noexcept { return idx > rhs.idx; }
+        bool operator<=(const self &rhs) const noexcept { return idx <= rhs.idx; }
+        bool operator>=(const self &rhs) const noexcept { return idx >= rhs.idx; }
+    };
+
+    template <class Vec, class T>
+    concurrent_vector_iterator<Vec, T>
+    operator+(ptrdiff_t n, const concurrent_vector_iterator<Vec, T> &x) noexcept
+    {
+        return x + n;
+    }
+
+    // 模板类: concurrent_vector
+    // 模板参数 T 代表类型，Alloc 代表分配器
+    template <class T, class Alloc = mySTL::allocator<T>>
+    class concurrent_vector
+        : private mySTL::alloc_holder<typename mySTL::allocator_traits<Alloc>::template rebind_alloc<T>>
+    {
+        static_assert(std::is_same<T, typename Alloc::value_type>::value,
+                      "the value_type of Alloc should be same with T");
+
+    public:
+        // concurrent_vector 的嵌套型别定义
+        typedef Alloc allocator_type;
+        typedef typename mySTL::allocator_traits<Alloc>::template rebind_alloc<T> data_allocator;
+        typedef mySTL::allocator_traits<data_allocator> data_traits;
+
+        typedef T value_type;
+        typedef typename data_traits::pointer pointer;
+        typedef typename data_traits::const_pointer const_pointer;
+        typedef value_type &reference;
+        typedef const value_type &const_reference;
+        typedef typename data_traits::size_type size_type;
+        typedef typename data_traits::difference_type difference_type;
+
+        typedef concurrent_vector_iterator<concurrent_vector, T> iterator;
+        typedef concurrent_vector_iterator<const concurrent_vector, const T> const_iterator;
+        typedef mySTL::reverse_iterator<iterator> reverse_iterator;
+        typedef mySTL::reverse_iterator<const_iterator> const_reverse_iterator;
+
+        // 第 0 段的大小，必须是 2 的幂
+        static constexpr size_type first_segment_bits = 4;
+        static constexpr size_type first_segment_size = size_type(1) << first_segment_bits;
+        static constexpr size_type segment_count = sizeof(size_type) * 8 - first_segment_bits;
+
+        allocator_type get_allocator() const { return allocator_type(this->alloc_ref()); }
+
+    private:
+        typedef mySTL::alloc_holder<data_allocator> alloc_base;
+
+        std::atomic<pointer> segments_[segment_count]; // 段表，未分配的段为 nullptr
+        std::atomic<size_type> size_;                  // 已占用的位置个数
+
+    public:
+        // 构造、复制、移动、析构函数
+        concurrent_vector() noexcept
+        {
+            init_table();
+        }
+
+        explicit concurrent_vector(const allocator_type &alloc) noexcept
+            : alloc_base(data_allocator(alloc))
+        {
+            init_table();
+        }
+
+        explicit concurrent_vector(size_type n, const allocator_type &alloc = allocator_type())
+            : alloc_base(data_allocator(alloc))
+        {
+            init_table();
+            fill_init(n, value_type());
+        }
+
+        concurrent_vector(size_type n, const value_type &value,
+                          const allocator_type &alloc = allocator_type())
+            : alloc_base(data_allocator(alloc))
+        {
+            init_table();
+            fill_init(n, value);
+        }
+
+        concurrent_vector(std::initializer_list<value_type> ilist,
+                          const allocator_type &alloc = allocator_type())
+            : alloc_base(data_allocator(alloc))
+        {
+            init_table();
+            range_init(ilist.begin(), ilist.size());
+        }
+
+        concurrent_vector(const concurrent_vector &rhs)
+            : alloc_base(data_traits::select_on_container_copy_construction(rhs.alloc_ref()))
+        {
+            init_table();
+            range_init(rhs.begin(), rhs.size());
+        }
+
+        concurrent_vector(const concurrent_vector &rhs, const allocator_type &alloc)
+            : alloc_base(data_allocator(alloc))
+        {
+            init_table();
+            range_init(rhs.begin(), rhs.size());
+        }
+
+        concurrent_vector(concurrent_vector &&rhs) noexcept
+            : alloc_base(mySTL::move(rhs.alloc_ref()))
+        {
+            init_table();
+            swap_table(rhs);
+        }
+
+        // 分配器不相等时，在自己的段中逐个移动元素
+        concurrent_vector(concurrent_vector &&rhs, const allocator_type &alloc)
+            : alloc_base(data_allocator(alloc))
+        {
+            init_table();
+            if (mySTL::alloc_equal(this->alloc_ref(), rhs.alloc_ref()))
+            {
+                swap_table(rhs);
+            }
+            else
+            {
+                move_init(rhs);
+            }
+        }
+
+        concurrent_vector &operator=(const concurrent_vector &rhs)
+        {
+            if (this != &rhs)
+            {
+                if (data_traits::propagate_on_container_copy_assignment::value &&
+                    !mySTL::alloc_equal(this->alloc_ref(), rhs.alloc_ref()))
+                { // 旧的段必须由原来的分配器释放
+                    release();
+                }
+                mySTL::alloc_copy_assign(this->alloc_ref(), rhs.alloc_ref(),
+                                         typename data_traits::propagate_on_container_copy_assignment{});
+                concurrent_vector tmp(rhs, get_allocator());
+                swap_table(tmp);
+            }
+            return *this;
+        }
+
+        concurrent_vector &operator=(concurrent_vector &&rhs) noexcept(
+            data_traits::propagate_on_container_move_assignment::value ||
+            data_traits::is_always_equal::value)
+        {
+            if (this != &rhs)
+            {
+                move_assign(rhs, m_intergral_constant<bool,
+                            data_traits::propagate_on_container_move_assignment::value ||
+                            data_traits::is_always_equal::value>{});
+            }
+            return *this;
+        }
+
+        concurrent_vector &operator=(std::initializer_list<value_type> ilist)
+        {
+            concurrent_vector tmp(ilist, get_allocator());
+            swap_table(tmp);
+            return *this;
+        }
+
+        ~concurrent_vector()
+        {
+            release();
+        }
+
+    public:
+        // 迭代器相关操作
+        iterator begin() noexcept
+        {
+            return iterator(this, 0);
+        }
+        const_iterator begin() const noexcept
+        {
+            return const_iterator(this, 0);
+        }
+        iterator end() noexcept
+        {
+            return iterator(this, size());
+        }
+        const_iterator end() const noexcept
+        {
+            return const_iterator(this, size());
+        }
+
+        reverse_iterator rbegin() noexcept
+        {
+            return reverse_iterator(end());
+        }
+        const_reverse_iterator rbegin() const noexcept
+        {
+            return const_reverse_iterator(end());
+        }
+        reverse_iterator rend() noexcept
+        {
+            return reverse_iterator(begin());
+        }
+        const_reverse_iterator rend() const noexcept
+        {
+            return const_reverse_iterator(begin());
+        }
+
+        const_iterator cbegin() const noexcept
+        {
+            return begin();
+        }
+        const_iterator cend() const noexcept
+        {
+            return end();
+        }
+
+        // 容量相关操作
+        bool empty() const noexcept
+        {
+            return size() == 0;
+        }
+        size_type size() const noexcept
+        {
+            return size_.load(std::memory_order_acquire);
+        }
+        size_type max_size() const noexcept
+        {
+            return data_traits::max_size(this->alloc_ref());
+        }
+        // 从第 0 段起连续分配的段所能容纳的元素个数
+        size_type capacity() const noexcept
+        {
+            size_type k = 0;
+            while (k < segment_count && segments_[k].load(std::memory_order_acquire) != nullptr)
+                ++k;
+            return segment_base(k);
+        }
+        void reserve(size_type n);
+
+        // 访问元素相关操作
+        reference operator[](size_type n)
+        {
+            MYSTL_DEBUG(n < size());
+            return *element(n);
+        }
+        const_reference operator[](size_type n) const
+        {
+            MYSTL_DEBUG(n < size());
+            return *element(n);
+        }
+        reference at(size_type n)
+        {
+            THROW_OUT_OF_RANGE_IF(!(n < size()), "concurrent_vector<T>::at() subscript out of range");
+            return (*this)[n];
+        }
+        const_reference at(size_type n) const
+        {
+            THROW_OUT_OF_RANGE_IF(!(n < size()), "concurrent_vector<T>::at() subscript out of range");
+            return (*this)[n];
+        }
+
+        reference front()
+        {
+            MYSTL_DEBUG(!empty());
+            return (*this)[0];
+        }
+        const_reference front() const
+        {
+            MYSTL_DEBUG(!empty());
+            return (*this)[0];
+        }
+        reference back()
+        {
+            MYSTL_DEBUG(!empty());
+            return (*this)[size() - 1];
+        }
+        const_reference back() const
+        {
+            MYSTL_DEBUG(!empty());
+            return (*this)[size() - 1];
+        }
+
+        // 修改容器相关操作
+
+        // emplace_back / push_back：返回指向新元素的迭代器
+        template <class... Args>
+        iterator emplace_back(Args &&...args)
+        {
+            return emplace_back_aux(std::is_nothrow_constructible<T, Args...>{},
+                                    mySTL::forward<Args>(args)...);
+        }
+
+        iterator push_back(const value_type &value)
+        {
+            return emplace_back(value);
+        }
+        iterator push_back(value_type &&value)
+        {
+            return emplace_back(mySTL::move(value));
+        }
+
+        // grow_by：在尾部一次占用 n 个连续的位置，返回指向其中第一个元素的迭代器
+        iterator grow_by(size_type n);
+        iterator grow_by(size_type n, const value_type &value);
+        template <class Iter, typename std::enable_if<
+                                  mySTL::is_forward_iterator<Iter>::value, int>::type = 0>
+        iterator grow_by(Iter first, Iter last);
+
+        // grow_to_at_least：保证至少有 n 个元素，返回指向新增的第一个元素的迭代器，
+        // 没有新增元素时返回指向下标 n 的迭代器
+        iterator grow_to_at_least(size_type n);
+
+        // clear
+        void clear() noexcept
+        {
+            destroy_elements(0, size());
+            size_.store(0, std::memory_order_relaxed);
+        }
+
+        // swap
+        void swap(concurrent_vector &rhs) noexcept
+        {
+            if (this != &rhs)
+            {
+                MYSTL_DEBUG(data_traits::propagate_on_container_swap::value ||
+                            mySTL::alloc_equal(this->alloc_ref(), rhs.alloc_ref()));
+                mySTL::alloc_swap(this->alloc_ref(), rhs.alloc_ref(),
+                                  typename data_traits::propagate_on_container_swap{});
+                swap_table(rhs);
+            }
+        }
+
+    private:
+        // helper functions
+
+        // 下标 i 所在的段：floor(log2(i / first_segment_size + 1))
+        static size_type segment_index(size_type i) noexcept
+        {
+            size_type q = (i >> first_segment_bits) + 1;
+#if defined(__GNUC__) || defined(__clang__)
+            return static_cast<size_type>(sizeof(unsigned long long) * 8 - 1 -
+                                          __builtin_clzll(static_cast<unsigned long long>(q)));
+#else
+            size_type k = 0;
+            while (q >>= 1)
+                ++k;
+            return k;
+#endif
+        }
+        // 第 k 段第一个元素的下标
+        static size_type segment_base(size_type k) noexcept
+        {
+            return first_segment_size * ((size_type(1) << k) - 1);
+        }
+        static size_type segment_size(size_type k) noexcept
+        {
+            return first_segment_size << k;
+        }
+
+        pointer element(size_type i) const noexcept
+        {
+            const size_type k = segment_index(i);
+            return segments_[k].load(std::memory_order_acquire) + (i - segment_base(k));
+        }
+
+        void init_table() noexcept
+        {
+            for (size_type k = 0; k < segment_count; ++k)
+                segments_[k].store(nullptr, std::memory_order_relaxed);
+            size_.store(0, std::memory_order_relaxed);
+        }
+
+        void swap_table(concurrent_vector &rhs) noexcept
+        {
+            for (size_type k = 0; k < segment_count; ++k)
+            {
+                pointer p = segments_[k].load(std::memory_order_relaxed);
+                segments_[k].store(rhs.segments_[k].load(std::memory_order_relaxed), std::memory_order_relaxed);
+                rhs.segments_[k].store(p, std::memory_order_relaxed);
+            }
+            size_type n = size_.load(std::memory_order_relaxed);
+            size_.store(rhs.size_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            rhs.size_.store(n, std::memory_order_relaxed);
+        }
+
+        // 分配第 k 段，多个线程同时分配时只保留一个
+        void allocate_segment(size_type k);
+        void claim_segments(size_type first, size_type last) noexcept;
+        void wait_segment(size_type k) const noexcept;
+        size_type claim(size_type n) noexcept;
+
+        void destroy_elements(size_type first, size_type last) noexcept;
+        void release() noexcept;
+
+        void move_assign(concurrent_vector &rhs, m_true_type) noexcept;
+        void move_assign(concurrent_vector &rhs, m_false_type);
+
+        void fill_init(size_type n, const value_type &value);
+        template <class Iter>
+        void range_init(Iter first, size_type n);
+        void move_init(concurrent_vector &rhs);
+
+        template <class... Args>
+        iterator emplace_back_aux(m_true_type, Args &&...args);
+        template <class... Args>
+        iterator emplace_back_aux(m_false_type, Args &&...args);
+
+        void grow_fill(size_type first, size_type last, const value_type &value, m_true_type) noexcept;
+        void grow_fill(size_type first, size_type last, const value_type &value, m_false_type);
+    };
+
+    template <class T, class Alloc>
+    constexpr typename concurrent_vector<T, Alloc>::size_type concurrent_vector<T, Alloc>::first_segment_bits;
+    template <class T, class Alloc>
+    constexpr typename concurrent_vector<T, Alloc>::size_type concurrent_vector<T, Alloc>::first_segment_size;
+    template <class T, class Alloc>
+    constexpr typename concurrent_vector<T, Alloc>::size_type concurrent_vector<T, Alloc>::segment_count;
+
+    // 预先分配能容纳 n 个元素的段，可以与 push_back 并发执行
+    template <class T, class Alloc>
+    void concurrent_vector<T, Alloc>::reserve(size_type n)
+    {
+        THROW_LENGTH_ERROR_IF(n > max_size(),
+                              "n can not larger than max_size() in concurrent_vector<T>::reserve(n)");
+        if (n == 0)
+        {
+            return;
+        }
+        const size_type last = segment_index(n - 1);
+        for (size_type k = 0; k <= last; ++k)
+            allocate_segment(k);
+    }
+
+    // 元素的构造不会抛出异常：占用位置后直接在原地构造
+    template <class T, class Alloc>
+    template <class... Args>
+    typename concurrent_vector<T, Alloc>::iterator
+    concurrent_vector<T, Alloc>::emplace_back_aux(m_true_type, Args &&...args)
+    {
+        const size_type i = claim(1);
+        data_traits::construct(this->alloc_ref(), element(i), mySTL::forward<Args>(args)...);
+        return iterator(this, i);
+    }
+
+    // 元素的构造可能抛出异常：先构造到临时对象中，占用位置后再移动过去
+    template <class T, class Alloc>
+    template <class... Args>
+    typename concurrent_vector<T, Alloc>::iterator
+    concurrent_vector<T, Alloc>::emplace_back_aux(m_false_type, Args &&...args)
+    {
+        static_assert(std::is_nothrow_move_constructible<T>::value,
+                      "concurrent_vector<T> needs T to be nothrow constructible from the arguments "
+                      "or nothrow move constructible");
+        value_type tmp(mySTL::forward<Args>(args)...);
+        const size_type i = claim(1);
+        data_traits::construct(this->alloc_ref(), element(i), mySTL::move(tmp));
+        return iterator(this, i);
+    }
+
+    // 在尾部占用 n 个位置并做值初始化
+    template <class T, class Alloc>
+    typename concurrent_vector<T, Alloc>::iterator
+    concurrent_vector<T, Alloc>::grow_by(size_type n)
+    {
+        static_assert(std::is_nothrow_default_constructible<T>::value,
+                      "concurrent_vector<T>::grow_by(n) needs T to be nothrow default constructible");
+        const size_type first = claim(n);
+        for (size_type i = first; i < first + n; ++i)
+            data_traits::construct(this->alloc_ref(), element(i));
+        return iterator(this, first);
+    }
+
+    // 在尾部占用 n 个位置并复制 value
+    template <class T, class Alloc>
+    typename concurrent_vector<T, Alloc>::iterator
+    concurrent_vector<T, Alloc>::grow_by(size_type n, const value_type &value)
+    {
+        const size_type first = claim(n);
+        grow_fill(first, first + n, value, std::is_nothrow_copy_constructible<T>{});
+        return iterator(this, first);
+    }
+
+    // 在尾部占用 [first, last) 个位置并逐个复制，元素的复制不能抛出异常
+    template <class T, class Alloc>
+    template <class Iter, typename std::enable_if<
+                              mySTL::is_forward_iterator<Iter>::value, int>::type>
+    typename concurrent_vector<T, Alloc>::iterator
+    concurrent_vector<T, Alloc>::grow_by(Iter first, Iter last)
+    {
+        static_assert(std::is_nothrow_constructible<T, decltype(*first)>::value,
+                      "concurrent_vector<T>::grow_by(first, last) needs nothrow construction from *first");
+        const size_type n = static_cast<size_type>(mySTL::distance(first, last));
+        const size_type start = claim(n);
+        for (size_type i = start; i < start + n; ++i, ++first)
+            data_traits::construct(this->alloc_ref(), element(i), *first);
+        return iterator(this, start);
+    }
+
+    // 保证至少有 n 个元素，新增的元素做值初始化
+    template <class T, class Alloc>
+    typename concurrent_vector<T, Alloc>::iterator
+    concurrent_vector<T, Alloc>::grow_to_at_least(size_type n)
+    {
+        static_assert(std::is_nothrow_default_constructible<T>::value,
+                      "concurrent_vector<T>::grow_to_at_least(n) needs T to be nothrow default constructible");
+        size_type cur = size_.load(std::memory_order_relaxed);
+        while (cur < n && !size_.compare_exchange_weak(cur, n, std::memory_order_acq_rel))
+        {
+        }
+        if (cur < n)
+        {
+            claim_segments(cur, n);
+            for (size_type i = cur; i < n; ++i)
+                data_traits::construct(this->alloc_ref(), element(i));
+            return iterator(this, cur);
+        }
+        return iterator(this, n);
+    }
+
+    /*****************************************************************************************/
+    // helper function
+
+    template <class T, class Alloc>
+    void concurrent_vector<T, Alloc>::allocate_segment(size_type k)
+    {
+        if (segments_[k].load(std::memory_order_acquire) != nullptr)
+        {
+            return;
+        }
+        pointer p = data_traits::allocate(this->alloc_ref(), segment_size(k));
+        pointer expected = nullptr;
+        if (!segments_[k].compare_exchange_strong(expected, p, std::memory_order_acq_rel))
+        {
+            data_traits::deallocate(this->alloc_ref(), p, segment_size(k));
+        }
+    }
+
+    // 已占用 [first, last)：首个下标落在其中的段由本线程分配，其余的段等待其他线程分配
+    // 位置已经占用，无法撤销，分配失败时终止程序
+    template <class T, class Alloc>
+    void concurrent_vector<T, Alloc>::claim_segments(size_type first, size_type last) noexcept
+    {
+        const size_type kf = segment_index(first);
+        const size_type kl = segment_index(last - 1);
+        for (size_type k = kf; k <= kl; ++k)
+        {
+            if (segment_base(k) >= first)
+                allocate_segment(k);
+            else
+                wait_segment(k);
+        }
+    }
+
+    template <class T, class Alloc>
+    void concurrent_vector<T, Alloc>::wait_segment(size_type k) const noexcept
+    {
+        while (segments_[k].load(std::memory_order_acquire) == nullptr)
+            std::this_thread::yield();
+    }
+
+    // 占用 n 个连续的位置，返回第一个位置的下标
+    template <class T, class Alloc>
+    typename concurrent_vector<T, Alloc>::size_type
+    concurrent_vector<T, Alloc>::claim(size_type n) noexcept
+    {
+        const size_type first = size_.fetch_add(n, std::memory_order_acq_rel);
+        if (n != 0)
+            claim_segments(first, first + n);
+        return first;
+    }
+
+    template <class T, class Alloc>
+    void concurrent_vector<T, Alloc>::destroy_elements(size_type first, size_type last) noexcept
+    {
+        if (std::is_trivially_destructible<T>::value)
+        {
+            return;
+        }
+        for (size_type i = first; i < last; ++i)
+            data_traits::destroy(this->alloc_ref(), element(i));
+    }
+
+    template <class T, class Alloc>
+    void concurrent_vector<T, Alloc>::release() noexcept
+    {
+        destroy_elements(0, size_.load(std::memory_order_relaxed));
+        for (size_type k = 0; k < segment_count; ++k)
+        {
+            pointer p = segments_[k].load(std::memory_order_relaxed);
+            if (p != nullptr)
+                data_traits::deallocate(this->alloc_ref(), p, segment_size(k));
+            segments_[k].store(nullptr, std::memory_order_relaxed);
+        }
+        size_.store(0, std::memory_order_relaxed);
+    }
+
+    // fill_init 与 range_init 只在构造函数中使用，每构造好一个元素才增加 size_，
+    // 抛出异常时析构已构造的元素并释放所有段
+    template <class T, class Alloc>
+    void concurrent_vector<T, Alloc>::fill_init(size_type n, const value_type &value)
+    {
+        try
+        {
+            reserve(n);
+            for (size_type i = 0; i < n; ++i)
+            {
+                data_traits::construct(this->alloc_ref(), element(i), value);
+                size_.store(i + 1, std::memory_order_relaxed);
+            }
+        }
+        catch (...)
+        {
+            release();
+            throw;
+        }
+    }
+
+    template <class T, class Alloc>
+    template <class Iter>
+    void concurrent_vector<T, Alloc>::range_init(Iter first, size_type n)
+    {
+        try
+        {
+            reserve(n);
+            for (size_type i = 0; i < n; ++i, ++first)
+            {
+                data_traits::construct(this->alloc_ref(), element(i), *first);
+                size_.store(i + 1, std::memory_order_relaxed);
+            }
+        }
+        catch (...)
+        {
+            release();
+            throw;
+        }
+    }
+
+    template <class T, class Alloc>
+    void concurrent_vector<T, Alloc>::move_init(concurrent_vector &rhs)
+    {
+        const size_type n = rhs.size();
+        try
+        {
+            reserve(n);
+            for (size_type i = 0; i < n; ++i)
+            {
+                data_traits::construct(this->alloc_ref(), element(i), mySTL::move(*rhs.element(i)));
+                size_.store(i + 1, std::memory_order_relaxed);
+            }
+        }
+        catch (...)
+        {
+            release();
+            throw;
+        }
+    }
+
+    // 分配器随容器传播或总是相等时，直接接管 rhs 的段表
+    template <class T, class Alloc>
+    void concurrent_vector<T, Alloc>::move_assign(concurrent_vector &rhs, m_true_type) noexcept
+    {
+        release();
+        mySTL::alloc_move_assign(this->alloc_ref(), rhs.alloc_ref(),
+                                 typename data_traits::propagate_on_container_move_assignment{});
+        swap_table(rhs);
+    }
+
+    // 分配器不传播时，只有两者相等才能接管段表，否则逐个移动元素
+    template <class T, class Alloc>
+    void concurrent_vector<T, Alloc>::move_assign(concurrent_vector &rhs, m_false_type)
+    {
+        if (mySTL::alloc_equal(this->alloc_ref(), rhs.alloc_ref()))
+        {
+            move_assign(rhs, m_true_type{});
+        }
+        else
+        {
+            concurrent_vector tmp(mySTL::move(rhs), get_allocator());
+            swap_table(tmp);
+            rhs.clear();
+        }
+    }
+
+    template <class T, class Alloc>
+    void concurrent_vector<T, Alloc>::grow_fill(size_type first, size_type last,
+                                                const value_type &value, m_true_type) noexcept
+    {
+        for (size_type i = first; i < last; ++i)
+            data_traits::construct(this->alloc_ref(), element(i), value);
+    }
+
+    // 复制可能抛出异常：先值初始化所有位置，再逐个赋值，赋值失败时这些元素仍然有效
+    template <class T, class Alloc>
+    void concurrent_vector<T, Alloc>::grow_fill(size_type first, size_type last,
+                                                const value_type &value, m_false_type)
+    {
+        static_assert(std::is_nothrow_default_constructible<T>::value,
+                      "concurrent_vector<T>::grow_by(n, value) needs T to be nothrow copy "
+                      "or nothrow default constructible");
+        for (size_type i = first; i < last; ++i)
+            data_traits::construct(this->alloc_ref(), element(i));
+        for (size_type i = first; i < last; ++i)
+            *element(i) = value;
+    }
+
+    /*****************************************************************************************/
+    // 重载比较操作符，不是线程安全的
+
+    template <class T, class Alloc>
+    bool operator==(const concurrent_vector<T, Alloc> &lhs, const concurrent_vector<T, Alloc> &rhs)
+    {
+        return lhs.size() == rhs.size() &&
+               mySTL::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+
+    template <class T, class Alloc>
+    bool operator!=(const concurrent_vector<T, Alloc> &lhs, const concurrent_vector<T, Alloc> &rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    // 重载 mySTL 的 swap
+    template <class T, class Alloc>
+    void swap(concurrent_vector<T, Alloc> &lhs, concurrent_vector<T, Alloc> &rhs) noexcept
+    {
+        lhs.swap(rhs);
+    }
+
+} // namespace mySTL
+#endif // !MYSTL_CONCURRENT_VECTOR_H_
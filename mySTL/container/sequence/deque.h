@@ -11,6 +11,12 @@
 //   * push_front
 //   * push_back
 //   * insert
+//
+// 缓冲区缓存：
+// pop_front / pop_back 腾空的缓冲区先放入容器内的缓存（最多 DEQUE_SPARE_CHUNKS 个），
+// 需要新缓冲区时优先从缓存中取出，像 queue 这样一端进一端出的用法不再反复分配与释放；
+// map 一端用尽而总的空闲位置足够时，把缓冲区指针移到 map 中央，不重新分配 map。
+// shrink_to_fit 归还缓存中的缓冲区
 
 #include <initializer_list>
 
@@ -37,18 +43,46 @@ namespace mySTL
 #define DEQUE_MAP_INIT_SIZE 8
 #endif
 
-    template <class T>
+// deque 缓存的空闲缓冲区个数上限，为 0 时不缓存
+#ifndef DEQUE_SPARE_CHUNKS
+#define DEQUE_SPARE_CHUNKS 4
+#endif
+
+    // 不小于 n 的最小的 2 的幂
+    constexpr size_t deque_ceil_pow2(size_t n, size_t p = 1)
+    {
+        return p >= n ? p : deque_ceil_pow2(n, p << 1);
+    }
+
+    constexpr size_t deque_log2(size_t n)
+    {
+        return n <= 1 ? 0 : 1 + deque_log2(n >> 1);
+    }
+
+    // 每个缓冲区的元素个数：BufSize 为 0 时由元素大小决定（约 4096 字节，至少 16 个），
+    // 否则使用 BufSize。两种情况都向上取整为 2 的幂，下标换算只需要移位与掩码
+    template <class T, size_t BufSize = 0>
     struct deque_buf_size
     {
-        static constexpr size_t value = sizeof(T) < 256 ? 4096 / sizeof(T) : 16;
+        static constexpr size_t value =
+            deque_ceil_pow2(BufSize != 0 ? BufSize : (sizeof(T) < 256 ? 4096 / sizeof(T) : 16));
+        static constexpr size_t shift = deque_log2(value);
+        static constexpr size_t mask = value - 1;
     };
 
+    template <class T, size_t BufSize>
+    constexpr size_t deque_buf_size<T, BufSize>::value;
+    template <class T, size_t BufSize>
+    constexpr size_t deque_buf_size<T, BufSize>::shift;
+    template <class T, size_t BufSize>
+    constexpr size_t deque_buf_size<T, BufSize>::mask;
+
     // deque 的迭代器设计
-    template <class T, class Ref, class Ptr>
+    template <class T, class Ref, class Ptr, size_t BufSize = 0>
     struct deque_iterator : public iterator<random_access_iterator_tag, T>
     {
-        typedef deque_iterator<T, T &, T *> iterator;
-        typedef deque_iterator<T, const T &, const T *> const_iterator;
+        typedef deque_iterator<T, T &, T *, BufSize> iterator;
+        typedef deque_iterator<T, const T &, const T *, BufSize> const_iterator;
         typedef deque_iterator self;
 
         typedef T value_type;
@@ -59,7 +93,9 @@ namespace mySTL
         typedef T *value_pointer;
         typedef T **map_pointer;
 
-        static const size_type buffer_size = deque_buf_size<T>::value;
+        static constexpr size_type buffer_size = deque_buf_size<T, BufSize>::value;
+        static constexpr size_type buffer_shift = deque_buf_size<T, BufSize>::shift;
+        static constexpr difference_type buffer_mask = deque_buf_size<T, BufSize>::mask;
 
         // 迭代器所含成员数据
         value_pointer cur;   // 指向所在缓冲区的当前元素
@@ -157,18 +193,18 @@ namespace mySTL
 
         self &operator+=(difference_type n)
         {
-            const auto offset = n + (cur - first);
-            if (offset >= 0 && offset < static_cast<difference_type>(buffer_size))
+            const difference_type offset = n + (cur - first);
+            if (static_cast<size_type>(offset) < buffer_size)
             { // 仍在当前缓冲区
                 cur += n;
             }
             else
-            { // 要跳到其他的缓冲区
-                const auto node_offset = offset > 0
-                                             ? offset / static_cast<difference_type>(buffer_size)
-                                             : -static_cast<difference_type>((-offset - 1) / buffer_size) - 1;
+            { // 要跳到其他的缓冲区，缓冲区大小是 2 的幂，向下取整的除法与取模换成移位与掩码
+                const difference_type node_offset = offset >= 0
+                                                        ? offset >> buffer_shift
+                                                        : -((-offset - 1) >> buffer_shift) - 1;
                 set_node(node + node_offset);
-                cur = first + (offset - node_offset * static_cast<difference_type>(buffer_size));
+                cur = first + (offset & buffer_mask);
             }
             return *this;
         }
@@ -201,41 +237,92 @@ namespace mySTL
         bool operator>=(const self &rhs) const { return !(*this < rhs); }
     };
 
-    template <class T>
+    template <class T, class Ref, class Ptr, size_t BufSize>
+    constexpr typename deque_iterator<T, Ref, Ptr, BufSize>::size_type deque_iterator<T, Ref, Ptr, BufSize>::buffer_size;
+    template <class T, class Ref, class Ptr, size_t BufSize>
+    constexpr typename deque_iterator<T, Ref, Ptr, BufSize>::size_type deque_iterator<T, Ref, Ptr, BufSize>::buffer_shift;
+    template <class T, class Ref, class Ptr, size_t BufSize>
+    constexpr typename deque_iterator<T, Ref, Ptr, BufSize>::difference_type deque_iterator<T, Ref, Ptr, BufSize>::buffer_mask;
+
+    // deque 的迭代器是分段迭代器：每个缓冲区是一段，段内可以直接使用指针
+    template <class T, class Ref, class Ptr, size_t BufSize>
+    struct segmented_iterator_traits<deque_iterator<T, Ref, Ptr, BufSize>>
+    {
+        typedef deque_iterator<T, Ref, Ptr, BufSize> iterator;
+        typedef typename iterator::map_pointer segment_iterator;
+        typedef Ptr local_iterator;
+
+        static constexpr bool is_segmented = true;
+
+        static segment_iterator segment(const iterator &it) noexcept { return it.node; }
+        static local_iterator local(const iterator &it) noexcept { return it.cur; }
+        static local_iterator begin(segment_iterator s) noexcept { return *s; }
+        static local_iterator end(segment_iterator s) noexcept { return *s + iterator::buffer_size; }
+
+        static iterator compose(segment_iterator s, local_iterator l)
+        {
+            if (l == end(s))
+            { // 与 operator++ 一致，缓冲区的尾部表示为下一个缓冲区的头部
+                ++s;
+                l = begin(s);
+            }
+            return iterator(const_cast<T *>(l), s);
+        }
+    };
+
+    template <class T, class Ref, class Ptr, size_t BufSize>
+    constexpr bool segmented_iterator_traits<deque_iterator<T, Ref, Ptr, BufSize>>::is_segmented;
+
+    // 模板类 deque
+    // 模板参数 T 代表类型，Alloc 代表分配器，BufSize 代表每个缓冲区的元素个数（0 表示按元素大小决定）
+    template <class T, class Alloc = mySTL::allocator<T>, size_t BufSize = 0>
     class deque
+        : private mySTL::alloc_holder<typename mySTL::allocator_traits<Alloc>::template rebind_alloc<T>>
     {
+        static_assert(std::is_same<T, typename Alloc::value_type>::value,
+                      "the value_type of Alloc should be same with T");
+
     public:
         // deque 的型别定义
-        typedef mySTL::allocator<T> allocator_type;
-        typedef mySTL::allocator<T> data_allocator;
-        typedef mySTL::allocator<T *> map_allocator;
-
-        typedef typename allocator_type::value_type value_type;
-        typedef typename allocator_type::pointer pointer;
-        typedef typename allocator_type::const_pointer const_pointer;
-        typedef typename allocator_type::reference reference;
-        typedef typename allocator_type::const_reference const_reference;
-        typedef typename allocator_type::size_type size_type;
-        typedef typename allocator_type::difference_type difference_type;
+        typedef Alloc allocator_type;
+        typedef typename mySTL::allocator_traits<Alloc>::template rebind_alloc<T> data_allocator;
+        typedef mySTL::allocator_traits<data_allocator> data_traits;
+        typedef typename data_traits::template rebind_alloc<T *> map_allocator;
+        typedef mySTL::allocator_traits<map_allocator> map_traits;
+
+        typedef T value_type;
+        typedef typename data_traits::pointer pointer;
+        typedef typename data_traits::const_pointer const_pointer;
+        typedef value_type &reference;
+        typedef const value_type &const_reference;
+        typedef typename data_traits::size_type size_type;
+        typedef typename data_traits::difference_type difference_type;
         typedef pointer *map_pointer;
         typedef const_pointer *const_map_pointer;
 
-        typedef deque_iterator<T, T &, T *> iterator;
-        typedef deque_iterator<T, const T &, const T *> const_iterator;
+        typedef deque_iterator<T, T &, T *, BufSize> iterator;
+        typedef deque_iterator<T, const T &, const T *, BufSize> const_iterator;
         typedef mySTL::reverse_iterator<iterator> reverse_iterator;
         typedef mySTL::reverse_iterator<const_iterator> const_reverse_iterator;
 
-        allocator_type get_allocator() { return allocator_type(); }
+        allocator_type get_allocator() const { return allocator_type(this->alloc_ref()); }
 
-        static const size_type buffer_size = deque_buf_size<T>::value;
+        static constexpr size_type buffer_size = deque_buf_size<T, BufSize>::value;
+        static constexpr size_type buffer_shift = deque_buf_size<T, BufSize>::shift;
 
     private:
+        typedef mySTL::alloc_holder<data_allocator> alloc_base;
+
         // 用以下四个数据来表现一个 deque
         iterator begin_;     // 指向第一个节点
         iterator end_;       // 指向最后一个结点
         map_pointer map_;    // 指向一块 map，map 中的每个元素都是一个指针，指向一个缓冲区
         size_type map_size_; // map 内指针的数目
 
+        // 空闲缓冲区的缓存
+        pointer spare_[DEQUE_SPARE_CHUNKS > 0 ? DEQUE_SPARE_CHUNKS : 1];
+        size_type spare_count_ = 0;
+
     public:
         // 构造、复制、移动、析构函数
 
@@ -244,62 +331,81 @@ namespace mySTL
             fill_init(0, value_type());
         }
 
-        explicit deque(size_type n)
+        explicit deque(const allocator_type &alloc)
+            : alloc_base(data_allocator(alloc))
+        {
+            fill_init(0, value_type());
+        }
+
+        explicit deque(size_type n, const allocator_type &alloc = allocator_type())
+            : alloc_base(data_allocator(alloc))
         {
             fill_init(n, value_type());
         }
 
-        deque(size_type n, const value_type &value)
+        deque(size_type n, const value_type &value,
+              const allocator_type &alloc = allocator_type())
+            : alloc_base(data_allocator(alloc))
         {
             fill_init(n, value);
         }
 
         template <class IIter, typename std::enable_if<
                                    mySTL::is_input_iterator<IIter>::value, int>::type = 0>
-        deque(IIter first, IIter last)
+        deque(IIter first, IIter last, const allocator_type &alloc = allocator_type())
+            : alloc_base(data_allocator(alloc))
         {
             copy_init(first, last, iterator_category(first));
         }
 
-        deque(std::initializer_list<value_type> ilist)
+        deque(std::initializer_list<value_type> ilist,
+              const allocator_type &alloc = allocator_type())
+            : alloc_base(data_allocator(alloc))
         {
             copy_init(ilist.begin(), ilist.end(), mySTL::forward_iterator_tag());
         }
 
         deque(const deque &rhs)
+            : alloc_base(data_traits::select_on_container_copy_construction(rhs.alloc_ref()))
         {
             copy_init(rhs.begin(), rhs.end(), mySTL::forward_iterator_tag());
         }
+
+        deque(const deque &rhs, const allocator_type &alloc)
+            : alloc_base(data_allocator(alloc))
+        {
+            copy_init(rhs.begin(), rhs.end(), mySTL::forward_iterator_tag());
+        }
+
         deque(deque &&rhs) noexcept
-            : begin_(mySTL::move(rhs.begin_)),
+            : alloc_base(mySTL::move(rhs.alloc_ref())),
+              begin_(mySTL::move(rhs.begin_)),
               end_(mySTL::move(rhs.end_)),
               map_(rhs.map_),
               map_size_(rhs.map_size_)
         {
             rhs.map_ = nullptr;
             rhs.map_size_ = 0;
+            take_spare(rhs);
         }
 
+        deque(deque &&rhs, const allocator_type &alloc);
+
         deque &operator=(const deque &rhs);
-        deque &operator=(deque &&rhs);
+        deque &operator=(deque &&rhs) noexcept(
+            data_traits::propagate_on_container_move_assignment::value ||
+            data_traits::is_always_equal::value);
 
         deque &operator=(std::initializer_list<value_type> ilist)
         {
-            deque tmp(ilist);
+            deque tmp(ilist, get_allocator());
             swap(tmp);
             return *this;
         }
 
         ~deque()
         {
-            if (map_ != nullptr)
-            {
-                clear();
-                data_allocator::deallocate(*begin_.node, buffer_size);
-                *begin_.node = nullptr;
-                map_allocator::deallocate(map_, map_size_);
-                map_ = nullptr;
-            }
+            destroy_all();
         }
 
     public:
@@ -366,15 +472,18 @@ namespace mySTL
         void shrink_to_fit() noexcept;
 
         // 访问元素相关操作
+        // 从 begin_ 所在缓冲区的头部算起的偏移量，高位是缓冲区序号，低位是缓冲区内的位置
         reference operator[](size_type n)
         {
             MYSTL_DEBUG(n < size());
-            return begin_[n];
+            const size_type offset = n + static_cast<size_type>(begin_.cur - begin_.first);
+            return begin_.node[offset >> buffer_shift][offset & (buffer_size - 1)];
         }
         const_reference operator[](size_type n) const
         {
             MYSTL_DEBUG(n < size());
-            return begin_[n];
+            const size_type offset = n + static_cast<size_type>(begin_.cur - begin_.first);
+            return begin_.node[offset >> buffer_shift][offset & (buffer_size - 1)];
         }
 
         reference at(size_type n)
@@ -479,8 +588,13 @@ namespace mySTL
 
         // create node / destroy node
         map_pointer create_map(size_type size);
+        void destroy_map(map_pointer mp, size_type size);
         void create_buffer(map_pointer nstart, map_pointer nfinish);
         void destroy_buffer(map_pointer nstart, map_pointer nfinish);
+        pointer get_buffer();
+        void put_buffer(pointer buf) noexcept;
+        void release_spare_slots() noexcept;
+        void take_spare(deque &rhs) noexcept;
 
         // initialize
         void map_init(size_type nelem);
@@ -489,6 +603,11 @@ namespace mySTL
         void copy_init(IIter, IIter, input_iterator_tag);
         template <class FIter>
         void copy_init(FIter, FIter, forward_iterator_tag);
+        void destroy_all();
+
+        // move assign
+        void move_assign(deque &rhs, m_true_type) noexcept;
+        void move_assign(deque &rhs, m_false_type);
 
         // assign
         void fill_assign(size_type n, const value_type &value);
@@ -512,14 +631,62 @@ namespace mySTL
         void require_capacity(size_type n, bool front);
         void reallocate_map_at_front(size_type need);
         void reallocate_map_at_back(size_type need);
+        void recenter_map(map_pointer new_start) noexcept;
     };
 
+    template <class T, class Alloc, size_t BufSize>
+    constexpr typename deque<T, Alloc, BufSize>::size_type deque<T, Alloc, BufSize>::buffer_size;
+    template <class T, class Alloc, size_t BufSize>
+    constexpr typename deque<T, Alloc, BufSize>::size_type deque<T, Alloc, BufSize>::buffer_shift;
+
+    // 使用指定的分配器移动构造，分配器不相等时逐个移动元素
+    template <class T, class Alloc, size_t BufSize>
+    deque<T, Alloc, BufSize>::deque(deque &&rhs, const allocator_type &alloc)
+        : alloc_base(data_allocator(alloc))
+    {
+        if (mySTL::alloc_equal(this->alloc_ref(), rhs.alloc_ref()))
+        {
+            begin_ = mySTL::move(rhs.begin_);
+            end_ = mySTL::move(rhs.end_);
+            map_ = rhs.map_;
+            map_size_ = rhs.map_size_;
+            rhs.map_ = nullptr;
+            rhs.map_size_ = 0;
+            take_spare(rhs);
+        }
+        else
+        {
+            map_init(0);
+            try
+            {
+                for (auto it = rhs.begin_; it != rhs.end_; ++it)
+                    emplace_back(mySTL::move(*it));
+            }
+            catch (...)
+            {
+                destroy_all();
+                throw;
+            }
+        }
+    }
+
     // 复制赋值运算符
-    template <class T>
-    deque<T> &deque<T>::operator=(const deque &rhs)
+    template <class T, class Alloc, size_t BufSize>
+    deque<T, Alloc, BufSize> &deque<T, Alloc, BufSize>::operator=(const deque &rhs)
     {
         if (this != &rhs)
         {
+            if (data_traits::propagate_on_container_copy_assignment::value &&
+                !mySTL::alloc_equal(this->alloc_ref(), rhs.alloc_ref()))
+            { // 旧空间必须由原来的分配器释放，之后换用 rhs 的分配器重新建立
+                destroy_all();
+                mySTL::alloc_copy_assign(this->alloc_ref(), rhs.alloc_ref(),
+                                         typename data_traits::propagate_on_container_copy_assignment{});
+                copy_init(rhs.begin(), rhs.end(), mySTL::forward_iterator_tag());
+                return *this;
+            }
+            mySTL::alloc_copy_assign(this->alloc_ref(), rhs.alloc_ref(),
+                                     typename data_traits::propagate_on_container_copy_assignment{});
             const auto len = size();
             if (len >= rhs.size())
             {
@@ -527,31 +694,30 @@ namespace mySTL
             }
             else
             {
-                iterator mid = rhs.begin() + static_cast<difference_type>(len);
-                mySTL::copy(rhs.begin_, mid, begin_);
-                insert(end_, mid, rhs.end_);
+                const_iterator mid = rhs.begin() + static_cast<difference_type>(len);
+                mySTL::copy(rhs.begin(), mid, begin_);
+                insert(end_, mid, rhs.end());
             }
         }
         return *this;
     }
 
     // 移动赋值运算符
-    template <class T>
-    deque<T> &deque<T>::operator=(deque &&rhs)
+    template <class T, class Alloc, size_t BufSize>
+    deque<T, Alloc, BufSize> &deque<T, Alloc, BufSize>::operator=(deque &&rhs) noexcept(
+        data_traits::propagate_on_container_move_assignment::value ||
+        data_traits::is_always_equal::value)
     {
-        clear();
-        begin_ = mySTL::move(rhs.begin_);
-        end_ = mySTL::move(rhs.end_);
-        map_ = rhs.map_;
-        map_size_ = rhs.map_size_;
-        rhs.map_ = nullptr;
-        rhs.map_size_ = 0;
+        if (this != &rhs)
+        {
+            move_assign(rhs, typename data_traits::propagate_on_container_move_assignment{});
+        }
         return *this;
     }
 
     // 重置容器大小
-    template <class T>
-    void deque<T>::resize(size_type new_size, const value_type &value)
+    template <class T, class Alloc, size_t BufSize>
+    void deque<T, Alloc, BufSize>::resize(size_type new_size, const value_type &value)
     {
         const auto len = size();
         if (new_size < len)
@@ -565,13 +731,13 @@ namespace mySTL
     }
 
     // 在头部就地构建元素
-    template <class T>
+    template <class T, class Alloc, size_t BufSize>
     template <class... Args>
-    void deque<T>::emplace_front(Args &&...args)
+    void deque<T, Alloc, BufSize>::emplace_front(Args &&...args)
     {
         if (begin_.cur != begin_.first)
         {
-            data_allocator::construct(begin_.cur - 1, mySTL::forward<Args>(args)...);
+            data_traits::construct(this->alloc_ref(), begin_.cur - 1, mySTL::forward<Args>(args)...);
             --begin_.cur;
         }
         else
@@ -580,7 +746,7 @@ namespace mySTL
             try
             {
                 --begin_;
-                data_allocator::construct(begin_.cur, mySTL::forward<Args>(args)...);
+                data_traits::construct(this->alloc_ref(), begin_.cur, mySTL::forward<Args>(args)...);
             }
             catch (...)
             {
@@ -591,27 +757,27 @@ namespace mySTL
     }
 
     // 在尾部就地构建元素
-    template <class T>
+    template <class T, class Alloc, size_t BufSize>
     template <class... Args>
-    void deque<T>::emplace_back(Args &&...args)
+    void deque<T, Alloc, BufSize>::emplace_back(Args &&...args)
     {
         if (end_.cur != end_.last - 1)
         {
-            data_allocator::construct(end_.cur, mySTL::forward<Args>(args)...);
+            data_traits::construct(this->alloc_ref(), end_.cur, mySTL::forward<Args>(args)...);
             ++end_.cur;
         }
         else
         {
             require_capacity(1, false);
-            data_allocator::construct(end_.cur, mySTL::forward<Args>(args)...);
+            data_traits::construct(this->alloc_ref(), end_.cur, mySTL::forward<Args>(args)...);
             ++end_;
         }
     }
 
     // 在 pos 位置就地构建元素
-    template <class T>
+    template <class T, class Alloc, size_t BufSize>
     template <class... Args>
-    typename deque<T>::iterator deque<T>::emplace(iterator pos, Args &&...args)
+    typename deque<T, Alloc, BufSize>::iterator deque<T, Alloc, BufSize>::emplace(iterator pos, Args &&...args)
     {
         if (pos.cur == begin_.cur)
         {
@@ -627,12 +793,12 @@ namespace mySTL
     }
 
     // 在头部插入元素
-    template <class T>
-    void deque<T>::push_front(const value_type &value)
+    template <class T, class Alloc, size_t BufSize>
+    void deque<T, Alloc, BufSize>::push_front(const value_type &value)
     {
         if (begin_.cur != begin_.first)
         {
-            data_allocator::construct(begin_.cur - 1, value);
+            data_traits::construct(this->alloc_ref(), begin_.cur - 1, value);
             --begin_.cur;
         }
         else
@@ -641,7 +807,7 @@ namespace mySTL
             try
             {
                 --begin_;
-                data_allocator::construct(begin_.cur, value);
+                data_traits::construct(this->alloc_ref(), begin_.cur, value);
             }
             catch (...)
             {
@@ -652,62 +818,62 @@ namespace mySTL
     }
 
     // 在尾部插入元素
-    template <class T>
-    void deque<T>::push_back(const value_type &value)
+    template <class T, class Alloc, size_t BufSize>
+    void deque<T, Alloc, BufSize>::push_back(const value_type &value)
     {
         if (end_.cur != end_.last - 1)
         {
-            data_allocator::construct(end_.cur, value);
+            data_traits::construct(this->alloc_ref(), end_.cur, value);
             ++end_.cur;
         }
         else
         {
             require_capacity(1, false);
-            data_allocator::construct(end_.cur, value);
+            data_traits::construct(this->alloc_ref(), end_.cur, value);
             ++end_;
         }
     }
 
     // 弹出头部元素
-    template <class T>
-    void deque<T>::pop_front()
+    template <class T, class Alloc, size_t BufSize>
+    void deque<T, Alloc, BufSize>::pop_front()
     {
         MYSTL_DEBUG(!empty());
         if (begin_.cur != begin_.last - 1)
         {
-            data_allocator::destroy(begin_.cur);
+            data_traits::destroy(this->alloc_ref(), begin_.cur);
             ++begin_.cur;
         }
         else
         {
-            data_allocator::destroy(begin_.cur);
+            data_traits::destroy(this->alloc_ref(), begin_.cur);
             ++begin_;
             destroy_buffer(begin_.node - 1, begin_.node - 1);
         }
     }
 
     // 弹出尾部元素
-    template <class T>
-    void deque<T>::pop_back()
+    template <class T, class Alloc, size_t BufSize>
+    void deque<T, Alloc, BufSize>::pop_back()
     {
         MYSTL_DEBUG(!empty());
         if (end_.cur != end_.first)
         {
             --end_.cur;
-            data_allocator::destroy(end_.cur);
+            data_traits::destroy(this->alloc_ref(), end_.cur);
         }
         else
         {
             --end_;
-            data_allocator::destroy(end_.cur);
+            data_traits::destroy(this->alloc_ref(), end_.cur);
             destroy_buffer(end_.node + 1, end_.node + 1);
         }
     }
 
     // 在 position 处插入元素
-    template <class T>
-    typename deque<T>::iterator
-    deque<T>::insert(iterator position, const value_type &value)
+    template <class T, class Alloc, size_t BufSize>
+    typename deque<T, Alloc, BufSize>::iterator
+    deque<T, Alloc, BufSize>::insert(iterator position, const value_type &value)
     {
         if (position.cur == begin_.cur)
         {
@@ -727,9 +893,9 @@ namespace mySTL
         }
     }
 
-    template <class T>
-    typename deque<T>::iterator
-    deque<T>::insert(iterator position, value_type &&value)
+    template <class T, class Alloc, size_t BufSize>
+    typename deque<T, Alloc, BufSize>::iterator
+    deque<T, Alloc, BufSize>::insert(iterator position, value_type &&value)
     {
         if (position.cur == begin_.cur)
         {
@@ -750,21 +916,21 @@ namespace mySTL
     }
 
     // 在 position 位置插入 n 个元素
-    template <class T>
-    void deque<T>::insert(iterator position, size_type n, const value_type &value)
+    template <class T, class Alloc, size_t BufSize>
+    void deque<T, Alloc, BufSize>::insert(iterator position, size_type n, const value_type &value)
     {
         if (position.cur == begin_.cur)
         {
             require_capacity(n, true);
             auto new_begin = begin_ - n;
-            mySTL::uninitialized_fill_n(new_begin, n, value);
+            data_traits::uninitialized_fill_n(this->alloc_ref(), new_begin, n, value);
             begin_ = new_begin;
         }
         else if (position.cur == end_.cur)
         {
             require_capacity(n, false);
             auto new_end = end_ + n;
-            mySTL::uninitialized_fill_n(end_, n, value);
+            data_traits::uninitialized_fill_n(this->alloc_ref(), end_, n, value);
             end_ = new_end;
         }
         else
@@ -774,9 +940,9 @@ namespace mySTL
     }
 
     // 删除 position 处的元素
-    template <class T>
-    typename deque<T>::iterator
-    deque<T>::erase(iterator position)
+    template <class T, class Alloc, size_t BufSize>
+    typename deque<T, Alloc, BufSize>::iterator
+    deque<T, Alloc, BufSize>::erase(iterator position)
     {
         auto next = position;
         ++next;
@@ -795,9 +961,9 @@ namespace mySTL
     }
 
     // 删除[first, last)上的元素
-    template <class T>
-    typename deque<T>::iterator
-    deque<T>::erase(iterator first, iterator last)
+    template <class T, class Alloc, size_t BufSize>
+    typename deque<T, Alloc, BufSize>::iterator
+    deque<T, Alloc, BufSize>::erase(iterator first, iterator last)
     {
         if (first == begin_ && last == end_)
         {
@@ -812,14 +978,14 @@ namespace mySTL
             {
                 mySTL::copy_backward(begin_, first, last);
                 auto new_begin = begin_ + len;
-                data_allocator::destroy(begin_.cur, new_begin.cur);
+                data_traits::destroy(this->alloc_ref(), begin_, new_begin);
                 begin_ = new_begin;
             }
             else
             {
                 mySTL::copy(last, end_, first);
                 auto new_end = end_ - len;
-                data_allocator::destroy(new_end.cur, end_.cur);
+                data_traits::destroy(this->alloc_ref(), new_end, end_);
                 end_ = new_end;
             }
             return begin_ + elems_before;
@@ -827,64 +993,91 @@ namespace mySTL
     }
 
     // 清空 deque
-    template <class T>
-    void deque<T>::clear()
+    template <class T, class Alloc, size_t BufSize>
+    void deque<T, Alloc, BufSize>::clear()
     {
-        // clear 会保留头部的缓冲区
+        // clear 会保留头部的缓冲区，其余缓冲区放入缓存
         for (map_pointer cur = begin_.node + 1; cur < end_.node; ++cur)
         {
-            data_allocator::destroy(*cur, *cur + buffer_size);
+            data_traits::destroy(this->alloc_ref(), *cur, *cur + buffer_size);
         }
         if (begin_.node != end_.node)
         { // 有两个以上的缓冲区
-            mySTL::destroy(begin_.cur, begin_.last);
-            mySTL::destroy(end_.first, end_.cur);
+            data_traits::destroy(this->alloc_ref(), begin_.cur, begin_.last);
+            data_traits::destroy(this->alloc_ref(), end_.first, end_.cur);
         }
         else
         {
-            mySTL::destroy(begin_.cur, end_.cur);
+            data_traits::destroy(this->alloc_ref(), begin_.cur, end_.cur);
         }
-        shrink_to_fit();
         end_ = begin_;
+        release_spare_slots();
+    }
+
+    // 释放 begin_ 与 end_ 所在缓冲区之外的空闲缓冲区
+    template <class T, class Alloc, size_t BufSize>
+    void deque<T, Alloc, BufSize>::shrink_to_fit() noexcept
+    {
+        // 至少会留下头部缓冲区，缓存中的缓冲区全部归还
+        release_spare_slots();
+        while (spare_count_ != 0)
+            data_traits::deallocate(this->alloc_ref(), spare_[--spare_count_], buffer_size);
     }
 
     // 交换两个 deque
-    template <class T>
-    void deque<T>::swap(deque &rhs) noexcept
+    template <class T, class Alloc, size_t BufSize>
+    void deque<T, Alloc, BufSize>::swap(deque &rhs) noexcept
     {
         if (this != &rhs)
         {
+            MYSTL_DEBUG(data_traits::propagate_on_container_swap::value ||
+                        mySTL::alloc_equal(this->alloc_ref(), rhs.alloc_ref()));
+            mySTL::alloc_swap(this->alloc_ref(), rhs.alloc_ref(),
+                              typename data_traits::propagate_on_container_swap{});
             mySTL::swap(begin_, rhs.begin_);
             mySTL::swap(end_, rhs.end_);
             mySTL::swap(map_, rhs.map_);
             mySTL::swap(map_size_, rhs.map_size_);
+            for (size_type i = 0; i < mySTL::max(spare_count_, rhs.spare_count_); ++i)
+                mySTL::swap(spare_[i], rhs.spare_[i]);
+            mySTL::swap(spare_count_, rhs.spare_count_);
         }
     }
 
     // helper function
 
-    template <class T>
-    typename deque<T>::map_pointer
-    deque<T>::create_map(size_type size)
+    template <class T, class Alloc, size_t BufSize>
+    typename deque<T, Alloc, BufSize>::map_pointer
+    deque<T, Alloc, BufSize>::create_map(size_type size)
     {
+        map_allocator map_alloc(this->alloc_ref());
         map_pointer mp = nullptr;
-        mp = map_allocator::allocate(size);
+        mp = map_traits::allocate(map_alloc, size);
         for (size_type i = 0; i < size; ++i)
             *(mp + i) = nullptr;
         return mp;
     }
 
+    // destroy_map 函数
+    template <class T, class Alloc, size_t BufSize>
+    void deque<T, Alloc, BufSize>::destroy_map(map_pointer mp, size_type size)
+    {
+        map_allocator map_alloc(this->alloc_ref());
+        map_traits::deallocate(map_alloc, mp, size);
+    }
+
     // create_buffer 函数
-    template <class T>
-    void deque<T>::
+    template <class T, class Alloc, size_t BufSize>
+    void deque<T, Alloc, BufSize>::
         create_buffer(map_pointer nstart, map_pointer nfinish)
     {
         map_pointer cur;
         try
         {
             for (cur = nstart; cur <= nfinish; ++cur)
-            {
-                *cur = data_allocator::allocate(buffer_size);
+            { // 已经存在的空闲缓冲区直接复用
+                if (*cur == nullptr)
+                    *cur = get_buffer();
             }
         }
         catch (...)
@@ -892,7 +1085,7 @@ namespace mySTL
             while (cur != nstart)
             {
                 --cur;
-                data_allocator::deallocate(*cur, buffer_size);
+                put_buffer(*cur);
                 *cur = nullptr;
             }
             throw;
@@ -900,20 +1093,72 @@ namespace mySTL
     }
 
     // destroy_buffer 函数
-    template <class T>
-    void deque<T>::
+    template <class T, class Alloc, size_t BufSize>
+    void deque<T, Alloc, BufSize>::
         destroy_buffer(map_pointer nstart, map_pointer nfinish)
     {
         for (map_pointer n = nstart; n <= nfinish; ++n)
         {
-            data_allocator::deallocate(*n, buffer_size);
+            put_buffer(*n);
             *n = nullptr;
         }
     }
 
+    // 取出一个缓冲区，缓存为空时才向分配器申请
+    template <class T, class Alloc, size_t BufSize>
+    typename deque<T, Alloc, BufSize>::pointer
+    deque<T, Alloc, BufSize>::get_buffer()
+    {
+        if (spare_count_ != 0)
+            return spare_[--spare_count_];
+        return data_traits::allocate(this->alloc_ref(), buffer_size);
+    }
+
+    // 归还一个缓冲区，缓存已满时交还分配器
+    template <class T, class Alloc, size_t BufSize>
+    void deque<T, Alloc, BufSize>::put_buffer(pointer buf) noexcept
+    {
+        if (spare_count_ < DEQUE_SPARE_CHUNKS)
+            spare_[spare_count_++] = buf;
+        else
+            data_traits::deallocate(this->alloc_ref(), buf, buffer_size);
+    }
+
+    // map 中 [begin_.node, end_.node] 以外的空闲缓冲区放入缓存
+    template <class T, class Alloc, size_t BufSize>
+    void deque<T, Alloc, BufSize>::release_spare_slots() noexcept
+    {
+        for (auto cur = map_; cur < begin_.node; ++cur)
+        {
+            if (*cur != nullptr)
+            {
+                put_buffer(*cur);
+                *cur = nullptr;
+            }
+        }
+        for (auto cur = end_.node + 1; cur < map_ + map_size_; ++cur)
+        {
+            if (*cur != nullptr)
+            {
+                put_buffer(*cur);
+                *cur = nullptr;
+            }
+        }
+    }
+
+    // 接管 rhs 的缓存，当前缓存为空
+    template <class T, class Alloc, size_t BufSize>
+    void deque<T, Alloc, BufSize>::take_spare(deque &rhs) noexcept
+    {
+        for (size_type i = 0; i < rhs.spare_count_; ++i)
+            spare_[i] = rhs.spare_[i];
+        spare_count_ = rhs.spare_count_;
+        rhs.spare_count_ = 0;
+    }
+
     // map_init 函数
-    template <class T>
-    void deque<T>::
+    template <class T, class Alloc, size_t BufSize>
+    void deque<T, Alloc, BufSize>::
         map_init(size_type nElem)
     {
         const size_type nNode = nElem / buffer_size + 1; // 需要分配的缓冲区个数
@@ -937,7 +1182,7 @@ namespace mySTL
         }
         catch (...)
         {
-            map_allocator::deallocate(map_, map_size_);
+            destroy_map(map_, map_size_);
             map_ = nullptr;
             map_size_ = 0;
             throw;
@@ -949,8 +1194,8 @@ namespace mySTL
     }
 
     // fill_init 函数
-    template <class T>
-    void deque<T>::
+    template <class T, class Alloc, size_t BufSize>
+    void deque<T, Alloc, BufSize>::
         fill_init(size_type n, const value_type &value)
     {
         map_init(n);
@@ -958,16 +1203,16 @@ namespace mySTL
         {
             for (auto cur = begin_.node; cur < end_.node; ++cur)
             {
-                mySTL::uninitialized_fill(*cur, *cur + buffer_size, value);
+                data_traits::uninitialized_fill(this->alloc_ref(), *cur, *cur + buffer_size, value);
             }
-            mySTL::uninitialized_fill(end_.first, end_.cur, value);
+            data_traits::uninitialized_fill(this->alloc_ref(), end_.first, end_.cur, value);
         }
     }
 
     // copy_init 函数
-    template <class T>
+    template <class T, class Alloc, size_t BufSize>
     template <class IIter>
-    void deque<T>::
+    void deque<T, Alloc, BufSize>::
         copy_init(IIter first, IIter last, input_iterator_tag)
     {
         const size_type n = mySTL::distance(first, last);
@@ -976,9 +1221,9 @@ namespace mySTL
             emplace_back(*first);
     }
 
-    template <class T>
+    template <class T, class Alloc, size_t BufSize>
     template <class FIter>
-    void deque<T>::
+    void deque<T, Alloc, BufSize>::
         copy_init(FIter first, FIter last, forward_iterator_tag)
     {
         const size_type n = mySTL::distance(first, last);
@@ -987,15 +1232,67 @@ namespace mySTL
         {
             auto next = first;
             mySTL::advance(next, buffer_size);
-            mySTL::uninitialized_copy(first, next, *cur);
+            data_traits::uninitialized_copy(this->alloc_ref(), first, next, *cur);
             first = next;
         }
-        mySTL::uninitialized_copy(first, last, end_.first);
+        data_traits::uninitialized_copy(this->alloc_ref(), first, last, end_.first);
+    }
+
+    // destroy_all 函数，析构所有元素并归还全部空间
+    template <class T, class Alloc, size_t BufSize>
+    void deque<T, Alloc, BufSize>::destroy_all()
+    {
+        if (map_ != nullptr)
+        {
+            clear();
+            shrink_to_fit();
+            data_traits::deallocate(this->alloc_ref(), *begin_.node, buffer_size);
+            *begin_.node = nullptr;
+            destroy_map(map_, map_size_);
+            map_ = nullptr;
+            map_size_ = 0;
+        }
+    }
+
+    // move_assign 函数
+    // 分配器随容器传播或总是相等时，直接接管 rhs 的空间
+    template <class T, class Alloc, size_t BufSize>
+    void deque<T, Alloc, BufSize>::move_assign(deque &rhs, m_true_type) noexcept
+    {
+        destroy_all();
+        mySTL::alloc_move_assign(this->alloc_ref(), rhs.alloc_ref(),
+                                 typename data_traits::propagate_on_container_move_assignment{});
+        begin_ = rhs.begin_;
+        end_ = rhs.end_;
+        map_ = rhs.map_;
+        map_size_ = rhs.map_size_;
+        rhs.begin_ = iterator();
+        rhs.end_ = iterator();
+        rhs.map_ = nullptr;
+        rhs.map_size_ = 0;
+        take_spare(rhs);
+    }
+
+    // 分配器不传播时，只有两者相等才能接管空间，否则逐个移动元素
+    template <class T, class Alloc, size_t BufSize>
+    void deque<T, Alloc, BufSize>::move_assign(deque &rhs, m_false_type)
+    {
+        if (mySTL::alloc_equal(this->alloc_ref(), rhs.alloc_ref()))
+        {
+            move_assign(rhs, m_true_type{});
+        }
+        else
+        {
+            clear();
+            for (auto it = rhs.begin_; it != rhs.end_; ++it)
+                emplace_back(mySTL::move(*it));
+            rhs.clear();
+        }
     }
 
     // fill_assign 函数
-    template <class T>
-    void deque<T>::
+    template <class T, class Alloc, size_t BufSize>
+    void deque<T, Alloc, BufSize>::
         fill_assign(size_type n, const value_type &value)
     {
         if (n > size())
@@ -1011,9 +1308,9 @@ namespace mySTL
     }
 
     // copy_assign 函数
-    template <class T>
+    template <class T, class Alloc, size_t BufSize>
     template <class IIter>
-    void deque<T>::
+    void deque<T, Alloc, BufSize>::
         copy_assign(IIter first, IIter last, input_iterator_tag)
     {
         auto first1 = begin();
@@ -1032,9 +1329,9 @@ namespace mySTL
         }
     }
 
-    template <class T>
+    template <class T, class Alloc, size_t BufSize>
     template <class FIter>
-    void deque<T>::
+    void deque<T, Alloc, BufSize>::
         copy_assign(FIter first, FIter last, forward_iterator_tag)
     {
         const size_type len1 = size();
@@ -1053,10 +1350,10 @@ namespace mySTL
     }
 
     // insert_aux 函数
-    template <class T>
+    template <class T, class Alloc, size_t BufSize>
     template <class... Args>
-    typename deque<T>::iterator
-    deque<T>::
+    typename deque<T, Alloc, BufSize>::iterator
+    deque<T, Alloc, BufSize>::
         insert_aux(iterator position, Args &&...args)
     {
         const size_type elems_before = position - begin_;
@@ -1088,8 +1385,8 @@ namespace mySTL
     }
 
     // fill_insert 函数
-    template <class T>
-    void deque<T>::
+    template <class T, class Alloc, size_t BufSize>
+    void deque<T, Alloc, BufSize>::
         fill_insert(iterator position, size_type n, const value_type &value)
     {
         const size_type elems_before = position - begin_;
@@ -1107,15 +1404,17 @@ namespace mySTL
                 if (elems_before >= n)
                 {
                     auto begin_n = begin_ + n;
-                    mySTL::uninitialized_copy(begin_, begin_n, new_begin);
+                    data_traits::uninitialized_copy(this->alloc_ref(), begin_, begin_n, new_begin);
                     begin_ = new_begin;
                     mySTL::copy(begin_n, position, old_begin);
                     mySTL::fill(position - n, position, value_copy);
                 }
                 else
                 {
-                    mySTL::uninitialized_fill(
-                        mySTL::uninitialized_copy(begin_, position, new_begin), begin_, value_copy);
+                    data_traits::uninitialized_fill(
+                        this->alloc_ref(),
+                        data_traits::uninitialized_copy(this->alloc_ref(), begin_, position, new_begin),
+                        begin_, value_copy);
                     begin_ = new_begin;
                     mySTL::fill(old_begin, position, value_copy);
                 }
@@ -1140,15 +1439,15 @@ namespace mySTL
                 if (elems_after > n)
                 {
                     auto end_n = end_ - n;
-                    mySTL::uninitialized_copy(end_n, end_, end_);
+                    data_traits::uninitialized_copy(this->alloc_ref(), end_n, end_, end_);
                     end_ = new_end;
                     mySTL::copy_backward(position, end_n, old_end);
                     mySTL::fill(position, position + n, value_copy);
                 }
                 else
                 {
-                    mySTL::uninitialized_fill(end_, position + n, value_copy);
-                    mySTL::uninitialized_copy(position, end_, position + n);
+                    data_traits::uninitialized_fill(this->alloc_ref(), end_, position + n, value_copy);
+                    data_traits::uninitialized_copy(this->alloc_ref(), position, end_, position + n);
                     end_ = new_end;
                     mySTL::fill(position, old_end, value_copy);
                 }
@@ -1163,9 +1462,9 @@ namespace mySTL
     }
 
     // copy_insert
-    template <class T>
+    template <class T, class Alloc, size_t BufSize>
     template <class FIter>
-    void deque<T>::
+    void deque<T, Alloc, BufSize>::
         copy_insert(iterator position, FIter first, FIter last, size_type n)
     {
         const size_type elems_before = position - begin_;
@@ -1182,7 +1481,7 @@ namespace mySTL
                 if (elems_before >= n)
                 {
                     auto begin_n = begin_ + n;
-                    mySTL::uninitialized_copy(begin_, begin_n, new_begin);
+                    data_traits::uninitialized_copy(this->alloc_ref(), begin_, begin_n, new_begin);
                     begin_ = new_begin;
                     mySTL::copy(begin_n, position, old_begin);
                     mySTL::copy(first, last, position - n);
@@ -1191,8 +1490,9 @@ namespace mySTL
                 {
                     auto mid = first;
                     mySTL::advance(mid, n - elems_before);
-                    mySTL::uninitialized_copy(first, mid,
-                                              mySTL::uninitialized_copy(begin_, position, new_begin));
+                    data_traits::uninitialized_copy(
+                        this->alloc_ref(), first, mid,
+                        data_traits::uninitialized_copy(this->alloc_ref(), begin_, position, new_begin));
                     begin_ = new_begin;
                     mySTL::copy(mid, last, old_begin);
                 }
@@ -1217,7 +1517,7 @@ namespace mySTL
                 if (elems_after > n)
                 {
                     auto end_n = end_ - n;
-                    mySTL::uninitialized_copy(end_n, end_, end_);
+                    data_traits::uninitialized_copy(this->alloc_ref(), end_n, end_, end_);
                     end_ = new_end;
                     mySTL::copy_backward(position, end_n, old_end);
                     mySTL::copy(first, last, position);
@@ -1226,8 +1526,9 @@ namespace mySTL
                 {
                     auto mid = first;
                     mySTL::advance(mid, elems_after);
-                    mySTL::uninitialized_copy(position, end_,
-                                              mySTL::uninitialized_copy(mid, last, end_));
+                    data_traits::uninitialized_copy(
+                        this->alloc_ref(), position, end_,
+                        data_traits::uninitialized_copy(this->alloc_ref(), mid, last, end_));
                     end_ = new_end;
                     mySTL::copy(first, mid, position);
                 }
@@ -1242,9 +1543,9 @@ namespace mySTL
     }
 
     // insert_dispatch 函数
-    template <class T>
+    template <class T, class Alloc, size_t BufSize>
     template <class IIter>
-    void deque<T>::
+    void deque<T, Alloc, BufSize>::
         insert_dispatch(iterator position, IIter first, IIter last, input_iterator_tag)
     {
         if (last <= first)
@@ -1267,9 +1568,9 @@ namespace mySTL
         }
     }
 
-    template <class T>
+    template <class T, class Alloc, size_t BufSize>
     template <class FIter>
-    void deque<T>::
+    void deque<T, Alloc, BufSize>::
         insert_dispatch(iterator position, FIter first, FIter last, forward_iterator_tag)
     {
         if (last <= first)
@@ -1281,7 +1582,7 @@ namespace mySTL
             auto new_begin = begin_ - n;
             try
             {
-                mySTL::uninitialized_copy(first, last, new_begin);
+                data_traits::uninitialized_copy(this->alloc_ref(), first, last, new_begin);
                 begin_ = new_begin;
             }
             catch (...)
@@ -1297,7 +1598,7 @@ namespace mySTL
             auto new_end = end_ + n;
             try
             {
-                mySTL::uninitialized_copy(first, last, end_);
+                data_traits::uninitialized_copy(this->alloc_ref(), first, last, end_);
                 end_ = new_end;
             }
             catch (...)
@@ -1314,8 +1615,8 @@ namespace mySTL
     }
 
     // require_capacity 函数
-    template <class T>
-    void deque<T>::require_capacity(size_type n, bool front)
+    template <class T, class Alloc, size_t BufSize>
+    void deque<T, Alloc, BufSize>::require_capacity(size_type n, bool front)
     {
         if (front && (static_cast<size_type>(begin_.cur - begin_.first) < n))
         {
@@ -1340,9 +1641,16 @@ namespace mySTL
     }
 
     // reallocate_map_at_front 函数
-    template <class T>
-    void deque<T>::reallocate_map_at_front(size_type need_buffer)
+    template <class T, class Alloc, size_t BufSize>
+    void deque<T, Alloc, BufSize>::reallocate_map_at_front(size_type need_buffer)
     {
+        const size_type used_buffer = end_.node - begin_.node + 1;
+        if (map_size_ > 2 * (used_buffer + need_buffer))
+        { // map 中的空位足够，移到中央后在头部留出 need_buffer 个位置
+            recenter_map(map_ + (map_size_ - used_buffer - need_buffer) / 2 + need_buffer);
+            create_buffer(begin_.node - need_buffer, begin_.node - 1);
+            return;
+        }
         const size_type new_map_size = mySTL::max(map_size_ << 1,
                                                   map_size_ + need_buffer + DEQUE_MAP_INIT_SIZE);
         map_pointer new_map = create_map(new_map_size);
@@ -1357,8 +1665,9 @@ namespace mySTL
         for (auto begin1 = mid, begin2 = begin_.node; begin1 != end; ++begin1, ++begin2)
             *begin1 = *begin2;
 
-        // 更新数据
-        map_allocator::deallocate(map_, map_size_);
+        // 更新数据，旧 map 中的空闲缓冲区放入缓存
+        release_spare_slots();
+        destroy_map(map_, map_size_);
         map_ = new_map;
         map_size_ = new_map_size;
         begin_ = iterator(*mid + (begin_.cur - begin_.first), mid);
@@ -1366,9 +1675,16 @@ namespace mySTL
     }
 
     // reallocate_map_at_back 函数
-    template <class T>
-    void deque<T>::reallocate_map_at_back(size_type need_buffer)
+    template <class T, class Alloc, size_t BufSize>
+    void deque<T, Alloc, BufSize>::reallocate_map_at_back(size_type need_buffer)
     {
+        const size_type used_buffer = end_.node - begin_.node + 1;
+        if (map_size_ > 2 * (used_buffer + need_buffer))
+        { // map 中的空位足够，移到中央后在尾部留出 need_buffer 个位置
+            recenter_map(map_ + (map_size_ - used_buffer - need_buffer) / 2);
+            create_buffer(end_.node + 1, end_.node + need_buffer);
+            return;
+        }
         const size_type new_map_size = mySTL::max(map_size_ << 1,
                                                   map_size_ + need_buffer + DEQUE_MAP_INIT_SIZE);
         map_pointer new_map = create_map(new_map_size);
@@ -1383,53 +1699,77 @@ namespace mySTL
             *begin1 = *begin2;
         create_buffer(mid, end - 1);
 
-        // 更新数据
-        map_allocator::deallocate(map_, map_size_);
+        // 更新数据，旧 map 中的空闲缓冲区放入缓存
+        release_spare_slots();
+        destroy_map(map_, map_size_);
         map_ = new_map;
         map_size_ = new_map_size;
         begin_ = iterator(*begin + (begin_.cur - begin_.first), begin);
         end_ = iterator(*(mid - 1) + (end_.cur - end_.first), mid - 1);
     }
 
+    // 把 [begin_.node, end_.node] 上的缓冲区指针移到以 new_start 开头的位置
+    template <class T, class Alloc, size_t BufSize>
+    void deque<T, Alloc, BufSize>::recenter_map(map_pointer new_start) noexcept
+    {
+        release_spare_slots();
+        const size_type used_buffer = end_.node - begin_.node + 1;
+        if (new_start < begin_.node)
+            mySTL::copy(begin_.node, end_.node + 1, new_start);
+        else
+            mySTL::copy_backward(begin_.node, end_.node + 1, new_start + used_buffer);
+        // 腾出的位置置空
+        for (auto cur = map_; cur < new_start; ++cur)
+            *cur = nullptr;
+        for (auto cur = new_start + used_buffer; cur < map_ + map_size_; ++cur)
+            *cur = nullptr;
+        begin_ = iterator(*new_start + (begin_.cur - begin_.first), new_start);
+        end_ = iterator(*(new_start + used_buffer - 1) + (end_.cur - end_.first), new_start + used_buffer - 1);
+    }
+
     // 重载比较操作符
-    template <class T>
-    bool operator==(const deque<T> &lhs, const deque<T> &rhs)
+    template <class T, class Alloc, size_t BufSize>
+    bool operator==(const deque<T, Alloc, BufSize> &lhs, const deque<T, Alloc, BufSize> &rhs)
     {
         return lhs.size() == rhs.size() &&
                mySTL::equal(lhs.begin(), lhs.end(), rhs.begin());
     }
 
-    template <class T>
-    bool operator<(const deque<T> &lhs, const deque<T> &rhs)
+    template <class T, class Alloc, size_t BufSize>
+    bool operator<(const deque<T, Alloc, BufSize> &lhs, const deque<T, Alloc, BufSize> &rhs)
     {
         return mySTL::lexicographical_compare(
             lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
     }
 
-    template <class T>
-    bool operator!=(const deque<T> &lhs, const deque<T> &rhs)
+    template <class T, class Alloc, size_t BufSize>
+    bool operator!=(const deque<T, Alloc, BufSize> &lhs, const deque<T, Alloc, BufSize> &rhs)
     {
         return !(lhs == rhs);
     }
 
-    template <class T>
-    bool operator>(const deque<T> &lhs, const deque<T> &rhs)
+    template <class T, class Alloc, size_t BufSize>
+    bool operator>(const deque<T, Alloc, BufSize> &lhs, const deque<T, Alloc, BufSize> &rhs)
     {
         return rhs < lhs;
     }
 
-    template <class T>
-    bool operator<=(const deque<T> &lhs, const deque<T> &rhs)
+    template <class T, class Alloc, size_t BufSize>
+    bool operator<=(const deque<T, Alloc, BufSize> &lhs, const deque<T, Alloc, BufSize> &rhs)
     {
         return !(rhs < lhs);
     }
 
-    template <class T>
-    bool operator>=(const deque<T> &lhs, const deque<T> &rhs)
+    template <class T, class Alloc, size_t BufSize>
+    bool operator>=(const deque<T, Alloc, BufSize> &lhs, const deque<T, Alloc, BufSize> &rhs)
     {
         return !(lhs < rhs);
     }
 
+    // deque 的迭代器与 map 都指向堆上的空间，分配器可以按字节搬移时 deque 也可以
+    template <class T, class Alloc, size_t BufSize>
+    struct is_trivially_relocatable<deque<T, Alloc, BufSize>> : is_trivially_relocatable<Alloc> {};
+
 }
 
 #endif
\ No newline at end of file
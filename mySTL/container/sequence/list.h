@@ -155,21 +155,33 @@ struct list_const_iterator : public iterator<bidirectional_iterator_tag, T> {
   bool operator!=(const self &rhs) const { return node_ != rhs.node_; }
 };
 
-template <class T> class list {
+template <class T, class Alloc = mySTL::allocator<T>>
+class list
+    : private mySTL::alloc_holder<typename mySTL::allocator_traits<
+          Alloc>::template rebind_alloc<list_node<T>>> {
+  static_assert(std::is_same<T, typename Alloc::value_type>::value,
+                "the value_type of Alloc should be same with T");
+
 public:
   // list 的嵌套型别定义
-  typedef mySTL::allocator<T> allocator_type;
-  typedef mySTL::allocator<T> data_allocator;
-  typedef mySTL::allocator<list_node_base<T>> base_allocator;
-  typedef mySTL::allocator<list_node<T>> node_allocator;
-
-  typedef typename allocator_type::value_type value_type;
-  typedef typename allocator_type::pointer pointer;
-  typedef typename allocator_type::const_pointer const_pointer;
-  typedef typename allocator_type::reference reference;
-  typedef typename allocator_type::const_reference const_reference;
-  typedef typename allocator_type::size_type size_type;
-  typedef typename allocator_type::difference_type difference_type;
+  typedef Alloc allocator_type;
+  typedef typename mySTL::allocator_traits<Alloc>::template rebind_alloc<
+      list_node_base<T>>
+      base_allocator;
+  typedef typename mySTL::allocator_traits<Alloc>::template rebind_alloc<
+      list_node<T>>
+      node_allocator;
+  typedef mySTL::allocator_traits<base_allocator> base_alloc_traits;
+  typedef mySTL::allocator_traits<node_allocator> node_alloc_traits;
+  typedef mySTL::allocator_traits<allocator_type> data_alloc_traits;
+
+  typedef T value_type;
+  typedef typename data_alloc_traits::pointer pointer;
+  typedef typename data_alloc_traits::const_pointer const_pointer;
+  typedef value_type &reference;
+  typedef const value_type &const_reference;
+  typedef typename data_alloc_traits::size_type size_type;
+  typedef typename data_alloc_traits::difference_type difference_type;
 
   typedef list_iterator<T> iterator;
   typedef list_const_iterator<T> const_iterator;
@@ -179,9 +191,13 @@ public:
   typedef typename node_traits<T>::base_ptr base_ptr;
   typedef typename node_traits<T>::node_ptr node_ptr;
 
-  allocator_type get_allocator() { return node_allocator(); }
+  allocator_type get_allocator() const {
+    return allocator_type(this->alloc_ref());
+  }
 
 private:
+  typedef mySTL::alloc_holder<node_allocator> alloc_base;
+
   base_ptr node_;  // 指向末尾节点
   size_type size_; // 大小
 
@@ -189,43 +205,106 @@ public:
   // 构造、复制、移动、析构函数
   list() { fill_init(0, value_type()); }
 
-  explicit list(size_type n) { fill_init(n, value_type()); }
+  explicit list(const allocator_type &alloc)
+      : alloc_base(node_allocator(alloc)) {
+    fill_init(0, value_type());
+  }
+
+  explicit list(size_type n, const allocator_type &alloc = allocator_type())
+      : alloc_base(node_allocator(alloc)) {
+    fill_init(n, value_type());
+  }
 
-  list(size_type n, const T &value) { fill_init(n, value); }
+  list(size_type n, const T &value,
+       const allocator_type &alloc = allocator_type())
+      : alloc_base(node_allocator(alloc)) {
+    fill_init(n, value);
+  }
 
   template <class Iter,
             typename std::enable_if<mySTL::is_input_iterator<Iter>::value,
                                     int>::type = 0>
-  list(Iter first, Iter last) {
+  list(Iter first, Iter last, const allocator_type &alloc = allocator_type())
+      : alloc_base(node_allocator(alloc)) {
     copy_init(first, last);
   }
 
-  list(std::initializer_list<T> ilist) {
+  list(std::initializer_list<T> ilist,
+       const allocator_type &alloc = allocator_type())
+      : alloc_base(node_allocator(alloc)) {
     copy_init(ilist.begin(), ilist.end());
   }
 
-  list(const list &rhs) { copy_init(rhs.cbegin(), rhs.cend()); }
+  list(const list &rhs)
+      : alloc_base(node_alloc_traits::select_on_container_copy_construction(
+            rhs.alloc_ref())) {
+    copy_init(rhs.cbegin(), rhs.cend());
+  }
+
+  list(const list &rhs, const allocator_type &alloc)
+      : alloc_base(node_allocator(alloc)) {
+    copy_init(rhs.cbegin(), rhs.cend());
+  }
 
-  list(list &&rhs) noexcept : node_(rhs.node_), size_(rhs.size_) {
+  list(list &&rhs) noexcept
+      : alloc_base(mySTL::move(rhs.alloc_ref())), node_(rhs.node_),
+        size_(rhs.size_) {
     rhs.node_ = nullptr;
     rhs.size_ = 0;
   }
 
+  list(list &&rhs, const allocator_type &alloc)
+      : alloc_base(node_allocator(alloc)) {
+    fill_init(0, value_type());
+    if (mySTL::alloc_equal(this->alloc_ref(), rhs.alloc_ref())) {
+      splice(end(), rhs);
+    } else {
+      for (auto &x : rhs)
+        emplace_back(mySTL::move(x));
+    }
+  }
+
   list &operator=(const list &rhs) {
     if (this != &rhs) {
+      if (node_alloc_traits::propagate_on_container_copy_assignment::value &&
+          !mySTL::alloc_equal(this->alloc_ref(), rhs.alloc_ref())) {
+        // 旧节点必须由原来的分配器释放
+        clear();
+        destroy_base(node_);
+        mySTL::alloc_copy_assign(
+            this->alloc_ref(), rhs.alloc_ref(),
+            typename node_alloc_traits::propagate_on_container_copy_assignment{});
+        node_ = create_base();
+        node_->unlink();
+      }
       assign(rhs.begin(), rhs.end());
     }
     return *this;
   }
 
-  list &operator=(list &&rhs) noexcept {
-    clear();
-    splice(end(), rhs);
+  list &operator=(list &&rhs) noexcept(
+      node_alloc_traits::propagate_on_container_move_assignment::value ||
+      node_alloc_traits::is_always_equal::value) {
+    if (this != &rhs) {
+      clear();
+      if (node_alloc_traits::propagate_on_container_move_assignment::value ||
+          mySTL::alloc_equal(this->alloc_ref(), rhs.alloc_ref())) {
+        // 节点可以直接转移过来
+        mySTL::alloc_move_assign(
+            this->alloc_ref(), rhs.alloc_ref(),
+            typename node_alloc_traits::propagate_on_container_move_assignment{});
+        splice(end(), rhs);
+      } else {
+        for (auto &x : rhs)
+          emplace_back(mySTL::move(x));
+        rhs.clear();
+      }
+    }
     return *this;
   }
 
   list &operator=(std::initializer_list<T> ilist) {
-    list tmp(ilist.begin(), ilist.end());
+    list tmp(ilist.begin(), ilist.end(), get_allocator());
     swap(tmp);
     return *this;
   }
@@ -233,7 +312,7 @@ public:
   ~list() {
     if (node_) {
       clear();
-      base_allocator::deallocate(node_);
+      destroy_base(node_);
       node_ = nullptr;
       size_ = 0;
     }
@@ -401,6 +480,10 @@ public:
   void resize(size_type new_size, const value_type &value);
 
   void swap(list &rhs) noexcept {
+    MYSTL_DEBUG(node_alloc_traits::propagate_on_container_swap::value ||
+                mySTL::alloc_equal(this->alloc_ref(), rhs.alloc_ref()));
+    mySTL::alloc_swap(this->alloc_ref(), rhs.alloc_ref(),
+                      typename node_alloc_traits::propagate_on_container_swap{});
     mySTL::swap(node_, rhs.node_);
     mySTL::swap(size_, rhs.size_);
   }
@@ -436,6 +519,8 @@ private:
   // create / destroy node
   template <class... Args> node_ptr create_node(Args &&...agrs);
   void destroy_node(node_ptr p);
+  base_ptr create_base();
+  void destroy_base(base_ptr p);
 
   // initialize
   void fill_init(size_type n, const value_type &value);
@@ -464,8 +549,8 @@ private:
 };
 
 // 删除 pos 处的元素
-template <class T>
-typename list<T>::iterator list<T>::erase(const_iterator pos) {
+template <class T, class Alloc>
+typename list<T, Alloc>::iterator list<T, Alloc>::erase(const_iterator pos) {
   MYSTL_DEBUG(pos != cend());
   auto n = pos.node_;
   auto next = n->next;
@@ -476,8 +561,8 @@ typename list<T>::iterator list<T>::erase(const_iterator pos) {
 }
 
 // 删除 [first, last) 内的元素
-template <class T>
-typename list<T>::iterator list<T>::erase(const_iterator first,
+template <class T, class Alloc>
+typename list<T, Alloc>::iterator list<T, Alloc>::erase(const_iterator first,
                                           const_iterator last) {
   if (first != last) {
     unlink_nodes(first.node_, last.node_->prev);
@@ -492,7 +577,8 @@ typename list<T>::iterator list<T>::erase(const_iterator first,
 }
 
 // 清空 list
-template <class T> void list<T>::clear() {
+template <class T, class Alloc>
+void list<T, Alloc>::clear() {
   if (size_ != 0) {
     auto cur = node_->next;
     for (base_ptr next = cur->next; cur != node_;
@@ -505,8 +591,8 @@ template <class T> void list<T>::clear() {
 }
 
 // 重置容器大小
-template <class T>
-void list<T>::resize(size_type new_size, const value_type &value) {
+template <class T, class Alloc>
+void list<T, Alloc>::resize(size_type new_size, const value_type &value) {
   auto i = begin();
   size_type len = 0;
   while (i != end() && len < new_size) {
@@ -521,7 +607,8 @@ void list<T>::resize(size_type new_size, const value_type &value) {
 }
 
 // 将 list x 接合于 pos 之前
-template <class T> void list<T>::splice(const_iterator pos, list &x) {
+template <class T, class Alloc>
+void list<T, Alloc>::splice(const_iterator pos, list &x) {
   MYSTL_DEBUG(this != &x);
   if (!x.empty()) {
     THROW_LENGTH_ERROR_IF(size_ > max_size() - x.size_,
@@ -539,8 +626,8 @@ template <class T> void list<T>::splice(const_iterator pos, list &x) {
 }
 
 // 将 it 所指的节点接合于 pos 之前
-template <class T>
-void list<T>::splice(const_iterator pos, list &x, const_iterator it) {
+template <class T, class Alloc>
+void list<T, Alloc>::splice(const_iterator pos, list &x, const_iterator it) {
   if (pos.node_ != it.node_ && pos.node_ != it.node_->next) {
     THROW_LENGTH_ERROR_IF(size_ > max_size() - 1, "list<T>'s size too big");
 
@@ -554,10 +641,34 @@ void list<T>::splice(const_iterator pos, list &x, const_iterator it) {
   }
 }
 
+// 将 list x 的 [first, last) 内的节点接合于 pos 之前
+template <class T, class Alloc>
+void list<T, Alloc>::splice(const_iterator pos, list &x, const_iterator first,
+                            const_iterator last) {
+  if (first != last && this != &x) {
+    size_type n = mySTL::distance(first, last);
+    THROW_LENGTH_ERROR_IF(size_ > max_size() - n, "list<T>'s size too big");
+    auto f = first.node_;
+    auto l = last.node_->prev;
+
+    x.unlink_nodes(f, l);
+    link_nodes(pos.node_, f, l);
+
+    size_ += n;
+    x.size_ -= n;
+  } else if (first != last) {
+    auto f = first.node_;
+    auto l = last.node_->prev;
+
+    unlink_nodes(f, l);
+    link_nodes(pos.node_, f, l);
+  }
+}
+
 // 将另一元操作 pred 为 true 的所有元素移除
-template <class T>
+template <class T, class Alloc>
 template <class UnaryPredicate>
-void list<T>::remove_if(UnaryPredicate pred) {
+void list<T, Alloc>::remove_if(UnaryPredicate pred) {
   auto f = begin();
   auto l = end();
   for (auto next = f; f != l; f = next) {
@@ -569,9 +680,9 @@ void list<T>::remove_if(UnaryPredicate pred) {
 }
 
 // b从列表中删除所有连续出现的满足pred的元素。
-template <class T>
+template <class T, class Alloc>
 template <class BinaryPredicate>
-void list<T>::unique(BinaryPredicate pred) {
+void list<T, Alloc>::unique(BinaryPredicate pred) {
   auto i = begin();
   auto e = end();
   auto j = i;
@@ -588,9 +699,9 @@ void list<T>::unique(BinaryPredicate pred) {
 }
 
 // 与另一个 list 合并，按照 comp 为 true 的顺序
-template <class T>
+template <class T, class Alloc>
 template <class Compare>
-void list<T>::merge(list &x, Compare comp) {
+void list<T, Alloc>::merge(list &x, Compare comp) {
   if (this != &x) {
     THROW_LENGTH_ERROR_IF(size_ > max_size() - x.size_,
                           "list<T>'s size too big");
@@ -632,35 +743,63 @@ void list<T>::merge(list &x, Compare comp) {
   }
 }
 
+// 将 list 反转
+template <class T, class Alloc> void list<T, Alloc>::reverse() {
+  if (size_ <= 1) {
+    return;
+  }
+  auto i = begin();
+  auto e = end();
+  while (i.node_ != e.node_) {
+    mySTL::swap(i.node_->prev, i.node_->next);
+    i.node_ = i.node_->prev;
+  }
+  mySTL::swap(e.node_->prev, e.node_->next);
+}
+
 // helper function
 
 // 创建结点
-template <class T>
+template <class T, class Alloc>
 template <class... Args>
-typename list<T>::node_ptr list<T>::create_node(Args &&...args) {
-  node_ptr p = node_allocator::allocate(1);
+typename list<T, Alloc>::node_ptr list<T, Alloc>::create_node(Args &&...args) {
+  node_ptr p = node_alloc_traits::allocate(this->alloc_ref(), 1);
   try {
-    data_allocator::construct(mySTL::address_of(p->value),
+    node_alloc_traits::construct(this->alloc_ref(), mySTL::address_of(p->value),
                               mySTL::forward<Args>(args)...);
     p->prev = nullptr;
     p->next = nullptr;
   } catch (...) {
-    node_allocator::deallocate(p);
+    node_alloc_traits::deallocate(this->alloc_ref(), p, 1);
     throw;
   }
   return p;
 }
 
 // 销毁结点
-template <class T> void list<T>::destroy_node(node_ptr p) {
-  data_allocator::destroy(mySTL::address_of(p->value));
-  node_allocator::deallocate(p);
+template <class T, class Alloc>
+void list<T, Alloc>::destroy_node(node_ptr p) {
+  node_alloc_traits::destroy(this->alloc_ref(), mySTL::address_of(p->value));
+  node_alloc_traits::deallocate(this->alloc_ref(), p, 1);
+}
+
+// 创建 / 销毁末尾的哨兵节点，哨兵节点不含有值
+template <class T, class Alloc>
+typename list<T, Alloc>::base_ptr list<T, Alloc>::create_base() {
+  base_allocator base_alloc(this->alloc_ref());
+  return base_alloc_traits::allocate(base_alloc, 1);
+}
+
+template <class T, class Alloc>
+void list<T, Alloc>::destroy_base(base_ptr p) {
+  base_allocator base_alloc(this->alloc_ref());
+  base_alloc_traits::deallocate(base_alloc, p, 1);
 }
 
 // 用 n 个元素初始化容器
-template <class T>
-void list<T>::fill_init(size_type n, const value_type &value) {
-  node_ = base_allocator::allocate(1);
+template <class T, class Alloc>
+void list<T, Alloc>::fill_init(size_type n, const value_type &value) {
+  node_ = create_base();
   node_->unlink();
   size_ = n;
   try {
@@ -670,17 +809,17 @@ void list<T>::fill_init(size_type n, const value_type &value) {
     }
   } catch (...) {
     clear();
-    base_allocator::deallocate(node_);
+    destroy_base(node_);
     node_ = nullptr;
     throw;
   }
 }
 
 // 以 [first, last) 初始化容器
-template <class T>
+template <class T, class Alloc>
 template <class Iter>
-void list<T>::copy_init(Iter first, Iter last) {
-  node_ = base_allocator::allocate(1);
+void list<T, Alloc>::copy_init(Iter first, Iter last) {
+  node_ = create_base();
   node_->unlink();
   size_type n = mySTL::distance(first, last);
   size_ = n;
@@ -691,15 +830,15 @@ void list<T>::copy_init(Iter first, Iter last) {
     }
   } catch (...) {
     clear();
-    base_allocator::deallocate(node_);
+    destroy_base(node_);
     node_ = nullptr;
     throw;
   }
 }
 
 // 在 pos 处连接一个节点
-template <class T>
-typename list<T>::iterator list<T>::link_iter_node(const_iterator pos,
+template <class T, class Alloc>
+typename list<T, Alloc>::iterator list<T, Alloc>::link_iter_node(const_iterator pos,
                                                    base_ptr link_node) {
   if (pos == node_->next) {
     link_nodes_at_front(link_node, link_node);
@@ -712,8 +851,8 @@ typename list<T>::iterator list<T>::link_iter_node(const_iterator pos,
 }
 
 // 在 pos 处连接 [first, last] 的结点
-template <class T>
-void list<T>::link_nodes(base_ptr pos, base_ptr first, base_ptr last) {
+template <class T, class Alloc>
+void list<T, Alloc>::link_nodes(base_ptr pos, base_ptr first, base_ptr last) {
   pos->prev->next = first;
   first->prev = pos->prev;
   pos->prev = last;
@@ -721,8 +860,8 @@ void list<T>::link_nodes(base_ptr pos, base_ptr first, base_ptr last) {
 }
 
 // 在头部连接 [first, last] 结点
-template <class T>
-void list<T>::link_nodes_at_front(base_ptr first, base_ptr last) {
+template <class T, class Alloc>
+void list<T, Alloc>::link_nodes_at_front(base_ptr first, base_ptr last) {
   first->prev = node_;
   last->next = node_->next;
   last->next->prev = last;
@@ -730,8 +869,8 @@ void list<T>::link_nodes_at_front(base_ptr first, base_ptr last) {
 }
 
 // 在尾部连接 [first, last] 结点
-template <class T>
-void list<T>::link_nodes_at_back(base_ptr first, base_ptr last) {
+template <class T, class Alloc>
+void list<T, Alloc>::link_nodes_at_back(base_ptr first, base_ptr last) {
   last->next = node_;
   first->prev = node_->prev;
   first->prev->next = first;
@@ -739,14 +878,15 @@ void list<T>::link_nodes_at_back(base_ptr first, base_ptr last) {
 }
 
 // 容器与 [first, last] 结点断开连接
-template <class T> void list<T>::unlink_nodes(base_ptr first, base_ptr last) {
+template <class T, class Alloc>
+void list<T, Alloc>::unlink_nodes(base_ptr first, base_ptr last) {
   first->prev->next = last->next;
   last->next->prev = first->prev;
 }
 
 // 用 n 个元素为容器赋值
-template <class T>
-void list<T>::fill_assign(size_type n, const value_type &value) {
+template <class T, class Alloc>
+void list<T, Alloc>::fill_assign(size_type n, const value_type &value) {
   auto i = begin();
   auto e = end();
   for (; n > 0 && i != e; --n, ++i) {
@@ -760,9 +900,9 @@ void list<T>::fill_assign(size_type n, const value_type &value) {
 }
 
 // 复制[f2, l2)为容器赋值
-template <class T>
+template <class T, class Alloc>
 template <class Iter>
-void list<T>::copy_assign(Iter f2, Iter l2) {
+void list<T, Alloc>::copy_assign(Iter f2, Iter l2) {
   auto f1 = begin();
   auto l1 = end();
   for (; f1 != l1 && f2 != l2; ++f1, ++f2) {
@@ -776,8 +916,8 @@ void list<T>::copy_assign(Iter f2, Iter l2) {
 }
 
 // 在 pos 处插入 n 个元素
-template <class T>
-typename list<T>::iterator list<T>::fill_insert(const_iterator pos, size_type n,
+template <class T, class Alloc>
+typename list<T, Alloc>::iterator list<T, Alloc>::fill_insert(const_iterator pos, size_type n,
                                                 const value_type &value) {
   iterator r(pos.node_);
   if (n != 0) {
@@ -811,9 +951,9 @@ typename list<T>::iterator list<T>::fill_insert(const_iterator pos, size_type n,
 }
 
 // 在 pos 处插入 [first, last) 的元素
-template <class T>
+template <class T, class Alloc>
 template <class Iter>
-typename list<T>::iterator list<T>::copy_insert(const_iterator pos, size_type n,
+typename list<T, Alloc>::iterator list<T, Alloc>::copy_insert(const_iterator pos, size_type n,
                                                 Iter first) {
   iterator r(pos.node_);
   if (n != 0) {
@@ -846,9 +986,9 @@ typename list<T>::iterator list<T>::copy_insert(const_iterator pos, size_type n,
 }
 
 // 对 list 进行归并排序，返回一个迭代器指向区间最小元素的位置
-template <class T>
+template <class T, class Alloc>
 template <class Compared>
-typename list<T>::iterator list<T>::list_sort(iterator f1, iterator l2,
+typename list<T, Alloc>::iterator list<T, Alloc>::list_sort(iterator f1, iterator l2,
                                               size_type n, Compared comp) {
   if (n < 2)
     return f1;
@@ -913,7 +1053,8 @@ typename list<T>::iterator list<T>::list_sort(iterator f1, iterator l2,
 }
 
 // 重载比较操作符
-template <class T> bool operator==(const list<T> &lhs, const list<T> &rhs) {
+template <class T, class Alloc>
+bool operator==(const list<T, Alloc> &lhs, const list<T, Alloc> &rhs) {
   auto f1 = lhs.cbegin();
   auto f2 = rhs.cbegin();
   auto l1 = lhs.cend();
@@ -923,29 +1064,35 @@ template <class T> bool operator==(const list<T> &lhs, const list<T> &rhs) {
   return f1 == l1 && f2 == l2;
 }
 
-template <class T> bool operator<(const list<T> &lhs, const list<T> &rhs) {
+template <class T, class Alloc>
+bool operator<(const list<T, Alloc> &lhs, const list<T, Alloc> &rhs) {
   return mySTL::lexicographical_compare(lhs.cbegin(), lhs.cend(), rhs.cbegin(),
                                         rhs.cend());
 }
 
-template <class T> bool operator!=(const list<T> &lhs, const list<T> &rhs) {
+template <class T, class Alloc>
+bool operator!=(const list<T, Alloc> &lhs, const list<T, Alloc> &rhs) {
   return !(lhs == rhs);
 }
 
-template <class T> bool operator>(const list<T> &lhs, const list<T> &rhs) {
+template <class T, class Alloc>
+bool operator>(const list<T, Alloc> &lhs, const list<T, Alloc> &rhs) {
   return rhs < lhs;
 }
 
-template <class T> bool operator<=(const list<T> &lhs, const list<T> &rhs) {
+template <class T, class Alloc>
+bool operator<=(const list<T, Alloc> &lhs, const list<T, Alloc> &rhs) {
   return !(rhs < lhs);
 }
 
-template <class T> bool operator>=(const list<T> &lhs, const list<T> &rhs) {
+template <class T, class Alloc>
+bool operator>=(const list<T, Alloc> &lhs, const list<T, Alloc> &rhs) {
   return !(lhs < rhs);
 }
 
 // 重载 mySTL 的 swap
-template <class T> void swap(list<T> &lhs, list<T> &rhs) noexcept {
+template <class T, class Alloc>
+void swap(list<T, Alloc> &lhs, list<T, Alloc> &rhs) noexcept {
   lhs.swap(rhs);
 }
 } // namespace mySTL
@@ -0,0 +1,1000 @@
+#ifndef MYSTL_SMALL_VECTOR_H_
+#define MYSTL_SMALL_VECTOR_H_
+
+// 这个头文件包含一个模板类 small_vector
+// small_vector : 带有内嵌缓冲区的 vector，元素个数不超过 N 时存放在对象内部，不分配堆空间，
+//                超过 N 时才转移到堆上，之后与 vector 的行为相同
+
+// notes:
+//
+// 接口与 mySTL::vector 相同，区别在于：
+//   * 元素存放在内嵌缓冲区时，移动构造、移动赋值与 swap 需要逐个移动元素，
+//     这些操作在内嵌状态下不再是 O(1)，并且迭代器会失效
+//   * shrink_to_fit 在元素个数不超过 N 时把元素移回内嵌缓冲区
+// 异常保证与 vector 相同：emplace、emplace_back、push_back 满足强异常安全保证
+
+#include <initializer_list>
+#include <type_traits>
+
+#include "../../iterator/iterator.h"
+#include "../../util/memory.h"
+#include "../../util/util.h"
+#include "../../util/exceptdef.h"
+#include "../../algorithm/algo.h"
+
+namespace mySTL
+{
+#ifdef max
+#pragma message("#undefing marco max")
+#undef max
+#endif // max
+
+#ifdef min
+#pragma message("#undefing marco min")
+#undef min
+#endif // min
+
+    template <class T, size_t N = 8, class Alloc = mySTL::allocator<T>>
+    class small_vector
+        : private mySTL::alloc_holder<typename mySTL::allocator_traits<Alloc>::template rebind_alloc<T>>
+    {
+        static_assert(N > 0, "small_vector needs at least one inline element");
+        static_assert(std::is_same<T, typename Alloc::value_type>::value,
+                      "the value_type of Alloc should be same with T");
+
+    public:
+        // small_vector 的嵌套型别定义
+        typedef Alloc allocator_type;
+        typedef typename mySTL::allocator_traits<Alloc>::template rebind_alloc<T> data_allocator;
+        typedef mySTL::allocator_traits<data_allocator> data_traits;
+
+        typedef T value_type;
+        typedef typename data_traits::pointer pointer;
+        typedef typename data_traits::const_pointer const_pointer;
+        typedef value_type &reference;
+        typedef const value_type &const_reference;
+        typedef typename data_traits::size_type size_type;
+        typedef typename data_traits::difference_type difference_type;
+
+        typedef value_type *iterator;
+        typedef const value_type *const_iterator;
+        typedef mySTL::reverse_iterator<iterator> reverse_iterator;
+        typedef mySTL::reverse_iterator<const_iterator> const_reverse_iterator;
+
+        static constexpr size_type inline_capacity = N;
+
+        allocator_type get_allocator() const { return allocator_type(this->alloc_ref()); }
+
+    private:
+        typedef mySTL::alloc_holder<data_allocator> alloc_base;
+
+        iterator begin_; // 表示目前使用空间的头部
+        iterator end_;   // 表示目前使用空间的尾部
+        iterator cap_;   // 表示目前储存空间的尾部
+        typename std::aligned_storage<sizeof(T) * N, alignof(T)>::type buffer_; // 内嵌缓冲区
+
+    public:
+        // 构造、复制、移动、析构函数
+        small_vector() noexcept
+        {
+            reset_inline();
+        }
+
+        explicit small_vector(const allocator_type &alloc) noexcept
+            : alloc_base(data_allocator(alloc))
+        {
+            reset_inline();
+        }
+
+        explicit small_vector(size_type n, const allocator_type &alloc = allocator_type())
+            : alloc_base(data_allocator(alloc))
+        {
+            reset_inline();
+            fill_init(n, value_type());
+        }
+
+        small_vector(size_type n, const value_type &value,
+                     const allocator_type &alloc = allocator_type())
+            : alloc_base(data_allocator(alloc))
+        {
+            reset_inline();
+            fill_init(n, value);
+        }
+
+        template <class Iter, typename std::enable_if<
+                                  mySTL::is_input_iterator<Iter>::value, int>::type = 0>
+        small_vector(Iter first, Iter last, const allocator_type &alloc = allocator_type())
+            : alloc_base(data_allocator(alloc))
+        {
+            reset_inline();
+            range_init(first, last, iterator_category(first));
+        }
+
+        small_vector(const small_vector &rhs)
+            : alloc_base(data_traits::select_on_container_copy_construction(rhs.alloc_ref()))
+        {
+            reset_inline();
+            range_init(rhs.begin_, rhs.end_, mySTL::forward_iterator_tag{});
+        }
+
+        small_vector(const small_vector &rhs, const allocator_type &alloc)
+            : alloc_base(data_allocator(alloc))
+        {
+            reset_inline();
+            range_init(rhs.begin_, rhs.end_, mySTL::forward_iterator_tag{});
+        }
+
+        small_vector(small_vector &&rhs) noexcept(std::is_nothrow_move_constructible<T>::value)
+            : alloc_base(mySTL::move(rhs.alloc_ref()))
+        {
+            reset_inline();
+            move_from(rhs);
+        }
+
+        small_vector(small_vector &&rhs, const allocator_type &alloc);
+
+        small_vector(std::initializer_list<value_type> ilist,
+                     const allocator_type &alloc = allocator_type())
+            : alloc_base(data_allocator(alloc))
+        {
+            reset_inline();
+            range_init(ilist.begin(), ilist.end(), mySTL::forward_iterator_tag{});
+        }
+
+        small_vector &operator=(const small_vector &rhs);
+        small_vector &operator=(small_vector &&rhs);
+
+        small_vector &operator=(std::initializer_list<value_type> ilist)
+        {
+            assign(ilist.begin(), ilist.end());
+            return *this;
+        }
+
+        ~small_vector()
+        {
+            release();
+        }
+
+    public:
+        // 迭代器相关操作
+        iterator begin() noexcept
+        {
+            return begin_;
+        }
+        const_iterator begin() const noexcept
+        {
+            return begin_;
+        }
+        iterator end() noexcept
+        {
+            return end_;
+        }
+        const_iterator end() const noexcept
+        {
+            return end_;
+        }
+
+        reverse_iterator rbegin() noexcept
+        {
+            return reverse_iterator(end());
+        }
+        const_reverse_iterator rbegin() const noexcept
+        {
+            return const_reverse_iterator(end());
+        }
+        reverse_iterator rend() noexcept
+        {
+            return reverse_iterator(begin());
+        }
+        const_reverse_iterator rend() const noexcept
+        {
+            return const_reverse_iterator(begin());
+        }
+
+        const_iterator cbegin() const noexcept
+        {
+            return begin();
+        }
+        const_iterator cend() const noexcept
+        {
+            return end();
+        }
+        const_reverse_iterator crbegin() const noexcept
+        {
+            return rbegin();
+        }
+        const_reverse_iterator crend() const noexcept
+        {
+            return rend();
+        }
+
+        // 容量相关操作
+        bool empty() const noexcept
+        {
+            return begin_ == end_;
+        }
+        size_type size() const noexcept
+        {
+            return static_cast<size_type>(end_ - begin_);
+        }
+        size_type max_size() const noexcept
+        {
+            return data_traits::max_size(this->alloc_ref());
+        }
+        size_type capacity() const noexcept
+        {
+            return static_cast<size_type>(cap_ - begin_);
+        }
+        // 元素是否存放在内嵌缓冲区中
+        bool is_inline() const noexcept
+        {
+            return begin_ == inline_begin();
+        }
+        void reserve(size_type n);
+        void shrink_to_fit();
+
+        // 访问元素相关操作
+        reference operator[](size_type n)
+        {
+            MYSTL_DEBUG(n < size());
+            return *(begin_ + n);
+        }
+        const_reference operator[](size_type n) const
+        {
+            MYSTL_DEBUG(n < size());
+            return *(begin_ + n);
+        }
+        reference at(size_type n)
+        {
+            THROW_OUT_OF_RANGE_IF(!(n < size()), "small_vector<T>::at() subscript out of range");
+            return (*this)[n];
+        }
+        const_reference at(size_type n) const
+        {
+            THROW_OUT_OF_RANGE_IF(!(n < size()), "small_vector<T>::at() subscript out of range");
+            return (*this)[n];
+        }
+
+        reference front()
+        {
+            MYSTL_DEBUG(!empty());
+            return *begin_;
+        }
+        const_reference front() const
+        {
+            MYSTL_DEBUG(!empty());
+            return *begin_;
+        }
+        reference back()
+        {
+            MYSTL_DEBUG(!empty());
+            return *(end_ - 1);
+        }
+        const_reference back() const
+        {
+            MYSTL_DEBUG(!empty());
+            return *(end_ - 1);
+        }
+
+        pointer data() noexcept { return begin_; }
+        const_pointer data() const noexcept { return begin_; }
+
+        // 修改容器相关操作
+
+        // assign
+
+        void assign(size_type n, const value_type &value);
+
+        template <class Iter, typename std::enable_if<
+                                  mySTL::is_input_iterator<Iter>::value, int>::type = 0>
+        void assign(Iter first, Iter last)
+        {
+            clear();
+            insert(end(), first, last);
+        }
+
+        void assign(std::initializer_list<value_type> il)
+        {
+            assign(il.begin(), il.end());
+        }
+
+        // emplace / emplace_back
+
+        template <class... Args>
+        iterator emplace(const_iterator pos, Args &&...args);
+
+        template <class... Args>
+        void emplace_back(Args &&...args);
+
+        // push_back / pop_back
+
+        void push_back(const value_type &value)
+        {
+            emplace_back(value);
+        }
+        void push_back(value_type &&value)
+        {
+            emplace_back(mySTL::move(value));
+        }
+
+        void pop_back();
+
+        // insert
+
+        iterator insert(const_iterator pos, const value_type &value)
+        {
+            return emplace(pos, value);
+        }
+        iterator insert(const_iterator pos, value_type &&value)
+        {
+            return emplace(pos, mySTL::move(value));
+        }
+
+        iterator insert(const_iterator pos, size_type n, const value_type &value);
+
+        template <class Iter, typename std::enable_if<
+                                  mySTL::is_input_iterator<Iter>::value, int>::type = 0>
+        iterator insert(const_iterator pos, Iter first, Iter last)
+        {
+            MYSTL_DEBUG(pos >= begin() && pos <= end());
+            return copy_insert(const_cast<iterator>(pos), first, last, iterator_category(first));
+        }
+
+        iterator insert(const_iterator pos, std::initializer_list<value_type> il)
+        {
+            return insert(pos, il.begin(), il.end());
+        }
+
+        // erase / clear
+        iterator erase(const_iterator pos);
+        iterator erase(const_iterator first, const_iterator last);
+        void clear() noexcept
+        {
+            data_traits::destroy(this->alloc_ref(), begin_, end_);
+            end_ = begin_;
+        }
+
+        // resize / reverse
+        void resize(size_type new_size) { return resize(new_size, value_type()); }
+        void resize(size_type new_size, const value_type &value);
+
+        void reverse() { mySTL::reverse(begin(), end()); }
+
+        // swap
+        void swap(small_vector &rhs);
+
+    private:
+        // helper functions
+
+        // inline buffer
+        iterator inline_begin() noexcept
+        {
+            return reinterpret_cast<iterator>(&buffer_);
+        }
+        const_iterator inline_begin() const noexcept
+        {
+            return reinterpret_cast<const_iterator>(&buffer_);
+        }
+        void reset_inline() noexcept
+        {
+            begin_ = end_ = inline_begin();
+            cap_ = begin_ + N;
+        }
+
+        // initialize / destroy
+        void fill_init(size_type n, const value_type &value);
+        template <class Iter>
+        void range_init(Iter first, Iter last, input_iterator_tag);
+        template <class Iter>
+        void range_init(Iter first, Iter last, forward_iterator_tag);
+
+        void release() noexcept;
+        void move_from(small_vector &rhs);
+        void move_elements(small_vector &rhs);
+
+        // calculate the growth size
+        size_type get_new_cap(size_type add_size);
+
+        // reallocate
+        template <class Fill>
+        void reallocate_around(iterator pos, size_type n, size_type new_cap, Fill fill);
+        void relocate_around(iterator pos, iterator new_begin, size_type n,
+                             size_type new_cap, m_true_type) noexcept;
+        void relocate_around(iterator pos, iterator new_begin, size_type n,
+                             size_type new_cap, m_false_type);
+
+        // insert
+        template <class IIter>
+        iterator copy_insert(iterator pos, IIter first, IIter last, input_iterator_tag);
+        template <class FIter>
+        iterator copy_insert(iterator pos, FIter first, FIter last, forward_iterator_tag);
+        template <class FillUninit, class FillAssign>
+        iterator open_gap(iterator pos, size_type n, FillUninit fill_uninit, FillAssign fill_assign);
+    };
+
+    template <class T, size_t N, class Alloc>
+    constexpr typename small_vector<T, N, Alloc>::size_type small_vector<T, N, Alloc>::inline_capacity;
+
+    // 使用指定的分配器移动构造，分配器不相等时逐个移动元素
+    template <class T, size_t N, class Alloc>
+    small_vector<T, N, Alloc>::small_vector(small_vector &&rhs, const allocator_type &alloc)
+        : alloc_base(data_allocator(alloc))
+    {
+        reset_inline();
+        if (mySTL::alloc_equal(this->alloc_ref(), rhs.alloc_ref()))
+        {
+            move_from(rhs);
+        }
+        else
+        {
+            try
+            {
+                move_elements(rhs);
+            }
+            catch (...)
+            {
+                release();
+                throw;
+            }
+        }
+    }
+
+    // 复制赋值操作符
+    template <class T, size_t N, class Alloc>
+    small_vector<T, N, Alloc> &small_vector<T, N, Alloc>::operator=(const small_vector &rhs)
+    {
+        if (this != &rhs)
+        {
+            if (data_traits::propagate_on_container_copy_assignment::value &&
+                !mySTL::alloc_equal(this->alloc_ref(), rhs.alloc_ref()))
+            { // 旧空间必须由原来的分配器释放
+                release();
+                reset_inline();
+            }
+            mySTL::alloc_copy_assign(this->alloc_ref(), rhs.alloc_ref(),
+                                     typename data_traits::propagate_on_container_copy_assignment{});
+            assign(rhs.begin_, rhs.end_);
+        }
+        return *this;
+    }
+
+    // 移动赋值操作符
+    // rhs 的元素在堆上且可以接管时直接接管空间，否则逐个移动元素
+    template <class T, size_t N, class Alloc>
+    small_vector<T, N, Alloc> &small_vector<T, N, Alloc>::operator=(small_vector &&rhs)
+    {
+        if (this != &rhs)
+        {
+            const bool pocma = data_traits::propagate_on_container_move_assignment::value;
+            if (pocma || mySTL::alloc_equal(this->alloc_ref(), rhs.alloc_ref()))
+            {
+                release();
+                reset_inline();
+                mySTL::alloc_move_assign(this->alloc_ref(), rhs.alloc_ref(),
+                                         typename data_traits::propagate_on_container_move_assignment{});
+                move_from(rhs);
+            }
+            else
+            {
+                clear();
+                move_elements(rhs);
+            }
+        }
+        return *this;
+    }
+
+    // 预留空间大小，当原容量小于要求大小时，才会重新分配
+    template <class T, size_t N, class Alloc>
+    void small_vector<T, N, Alloc>::reserve(size_type n)
+    {
+        if (capacity() < n)
+        {
+            THROW_LENGTH_ERROR_IF(n > max_size(),
+                                  "n can not larger than max_size() in small_vector<T>::reserve(n)");
+            reallocate_around(end_, 0, n, [](iterator) {});
+        }
+    }
+
+    // 放弃多余的容量，元素个数不超过 N 时移回内嵌缓冲区
+    template <class T, size_t N, class Alloc>
+    void small_vector<T, N, Alloc>::shrink_to_fit()
+    {
+        if (is_inline() || end_ == cap_)
+        {
+            return;
+        }
+        if (size() > N)
+        {
+            reallocate_around(end_, 0, size(), [](iterator) {});
+            return;
+        }
+        iterator old_begin = begin_;
+        iterator old_end = end_;
+        const size_type old_cap = capacity();
+        data_traits::uninitialized_move(this->alloc_ref(), old_begin, old_end, inline_begin());
+        begin_ = inline_begin();
+        end_ = begin_ + (old_end - old_begin);
+        cap_ = begin_ + N;
+        data_traits::destroy(this->alloc_ref(), old_begin, old_end);
+        data_traits::deallocate(this->alloc_ref(), old_begin, old_cap);
+    }
+
+    // 在 pos 位置就地构造元素
+    template <class T, size_t N, class Alloc>
+    template <class... Args>
+    typename small_vector<T, N, Alloc>::iterator
+    small_vector<T, N, Alloc>::emplace(const_iterator pos, Args &&...args)
+    {
+        MYSTL_DEBUG(pos >= begin() && pos <= end());
+        iterator xpos = const_cast<iterator>(pos);
+        const size_type n = xpos - begin_;
+        if (end_ != cap_ && xpos == end_)
+        {
+            data_traits::construct(this->alloc_ref(), mySTL::address_of(*end_), mySTL::forward<Args>(args)...);
+            ++end_;
+        }
+        else if (end_ != cap_)
+        {
+            value_type tmp(mySTL::forward<Args>(args)...); // 参数可能引用容器中的元素
+            data_traits::construct(this->alloc_ref(), mySTL::address_of(*end_), mySTL::move(*(end_ - 1)));
+            ++end_;
+            mySTL::move_backward(xpos, end_ - 2, end_ - 1);
+            *xpos = mySTL::move(tmp);
+        }
+        else
+        {
+            reallocate_around(xpos, 1, get_new_cap(1), [&](iterator p)
+            {
+                data_traits::construct(this->alloc_ref(), mySTL::address_of(*p), mySTL::forward<Args>(args)...);
+            });
+        }
+        return begin_ + n;
+    }
+
+    // 在尾部就地构造元素
+    template <class T, size_t N, class Alloc>
+    template <class... Args>
+    void small_vector<T, N, Alloc>::emplace_back(Args &&...args)
+    {
+        if (end_ < cap_)
+        {
+            data_traits::construct(this->alloc_ref(), mySTL::address_of(*end_), mySTL::forward<Args>(args)...);
+            ++end_;
+        }
+        else
+        {
+            reallocate_around(end_, 1, get_new_cap(1), [&](iterator p)
+            {
+                data_traits::construct(this->alloc_ref(), mySTL::address_of(*p), mySTL::forward<Args>(args)...);
+            });
+        }
+    }
+
+    // 弹出尾部元素
+    template <class T, size_t N, class Alloc>
+    void small_vector<T, N, Alloc>::pop_back()
+    {
+        MYSTL_DEBUG(!empty());
+        data_traits::destroy(this->alloc_ref(), end_ - 1);
+        --end_;
+    }
+
+    // 在 pos 处插入 n 个元素
+    template <class T, size_t N, class Alloc>
+    typename small_vector<T, N, Alloc>::iterator
+    small_vector<T, N, Alloc>::insert(const_iterator pos, size_type n, const value_type &value)
+    {
+        MYSTL_DEBUG(pos >= begin() && pos <= end());
+        const value_type value_copy = value; // 避免被覆盖
+        return open_gap(const_cast<iterator>(pos), n,
+                        [&](iterator first, iterator last)
+                        {
+                            data_traits::uninitialized_fill_n(this->alloc_ref(), first, last - first, value_copy);
+                        },
+                        [&](iterator first, iterator last)
+                        {
+                            mySTL::fill_n(first, last - first, value_copy);
+                        });
+    }
+
+    // 删除 pos 位置上的元素
+    template <class T, size_t N, class Alloc>
+    typename small_vector<T, N, Alloc>::iterator
+    small_vector<T, N, Alloc>::erase(const_iterator pos)
+    {
+        MYSTL_DEBUG(pos >= begin() && pos < end());
+        iterator xpos = begin_ + (pos - begin());
+        mySTL::move(xpos + 1, end_, xpos);
+        data_traits::destroy(this->alloc_ref(), end_ - 1);
+        --end_;
+        return xpos;
+    }
+
+    // 删除[first, last)上的元素
+    template <class T, size_t N, class Alloc>
+    typename small_vector<T, N, Alloc>::iterator
+    small_vector<T, N, Alloc>::erase(const_iterator first, const_iterator last)
+    {
+        MYSTL_DEBUG(first >= begin() && last <= end() && !(last < first));
+        const auto n = first - begin();
+        iterator r = begin_ + (first - begin());
+        data_traits::destroy(this->alloc_ref(), mySTL::move(r + (last - first), end_, r), end_);
+        end_ = end_ - (last - first);
+        return begin_ + n;
+    }
+
+    // 重置容器大小
+    template <class T, size_t N, class Alloc>
+    void small_vector<T, N, Alloc>::resize(size_type new_size, const value_type &value)
+    {
+        if (new_size < size())
+        {
+            erase(begin() + new_size, end());
+        }
+        else
+        {
+            insert(end(), new_size - size(), value);
+        }
+    }
+
+    // 用 n 个 value 为容器赋值
+    template <class T, size_t N, class Alloc>
+    void small_vector<T, N, Alloc>::assign(size_type n, const value_type &value)
+    {
+        const value_type value_copy = value; // value 可能是容器中的元素
+        clear();
+        insert(end(), n, value_copy);
+    }
+
+    // 与另一个 small_vector 交换
+    // 两者都在堆上时只交换指针，否则借助一个临时对象逐个移动元素
+    template <class T, size_t N, class Alloc>
+    void small_vector<T, N, Alloc>::swap(small_vector &rhs)
+    {
+        if (this == &rhs)
+        {
+            return;
+        }
+        MYSTL_DEBUG(data_traits::propagate_on_container_swap::value ||
+                    mySTL::alloc_equal(this->alloc_ref(), rhs.alloc_ref()));
+        if (!is_inline() && !rhs.is_inline())
+        {
+            mySTL::alloc_swap(this->alloc_ref(), rhs.alloc_ref(),
+                              typename data_traits::propagate_on_container_swap{});
+            mySTL::swap(begin_, rhs.begin_);
+            mySTL::swap(end_, rhs.end_);
+            mySTL::swap(cap_, rhs.cap_);
+            return;
+        }
+        small_vector tmp(mySTL::move(rhs));
+        rhs.release();
+        rhs.reset_inline();
+        mySTL::alloc_swap(this->alloc_ref(), rhs.alloc_ref(),
+                          typename data_traits::propagate_on_container_swap{});
+        rhs.move_from(*this);
+        release();
+        reset_inline();
+        move_from(tmp);
+    }
+
+    /*
+    helper_function
+     */
+
+    // fill_init 函数
+    template <class T, size_t N, class Alloc>
+    void small_vector<T, N, Alloc>::fill_init(size_type n, const value_type &value)
+    {
+        if (n > N)
+        {
+            begin_ = data_traits::allocate(this->alloc_ref(), n);
+            end_ = begin_;
+            cap_ = begin_ + n;
+        }
+        try
+        {
+            end_ = data_traits::uninitialized_fill_n(this->alloc_ref(), begin_, n, value);
+        }
+        catch (...)
+        {
+            release();
+            throw;
+        }
+    }
+
+    // range_init 函数
+    template <class T, size_t N, class Alloc>
+    template <class Iter>
+    void small_vector<T, N, Alloc>::range_init(Iter first, Iter last, input_iterator_tag)
+    {
+        try
+        {
+            for (; first != last; ++first)
+            {
+                emplace_back(*first);
+            }
+        }
+        catch (...)
+        {
+            release();
+            throw;
+        }
+    }
+
+    template <class T, size_t N, class Alloc>
+    template <class Iter>
+    void small_vector<T, N, Alloc>::range_init(Iter first, Iter last, forward_iterator_tag)
+    {
+        const size_type len = mySTL::distance(first, last);
+        if (len > N)
+        {
+            begin_ = data_traits::allocate(this->alloc_ref(), len);
+            end_ = begin_;
+            cap_ = begin_ + len;
+        }
+        try
+        {
+            end_ = data_traits::uninitialized_copy(this->alloc_ref(), first, last, begin_);
+        }
+        catch (...)
+        {
+            release();
+            throw;
+        }
+    }
+
+    // 销毁所有元素，堆上的空间交还给分配器
+    template <class T, size_t N, class Alloc>
+    void small_vector<T, N, Alloc>::release() noexcept
+    {
+        data_traits::destroy(this->alloc_ref(), begin_, end_);
+        if (!is_inline())
+        {
+            data_traits::deallocate(this->alloc_ref(), begin_, cap_ - begin_);
+        }
+        end_ = begin_;
+    }
+
+    // 当前对象为空且在内嵌缓冲区中：接管 rhs 的堆空间，或者逐个移动 rhs 的内嵌元素
+    // 完成后 rhs 为空并回到内嵌缓冲区
+    template <class T, size_t N, class Alloc>
+    void small_vector<T, N, Alloc>::move_from(small_vector &rhs)
+    {
+        MYSTL_DEBUG(is_inline() && empty());
+        if (rhs.is_inline())
+        {
+            end_ = data_traits::uninitialized_move(this->alloc_ref(), rhs.begin_, rhs.end_, begin_);
+            rhs.clear();
+        }
+        else
+        {
+            begin_ = rhs.begin_;
+            end_ = rhs.end_;
+            cap_ = rhs.cap_;
+            rhs.reset_inline();
+        }
+    }
+
+    // 当前对象为空：在自己的空间中逐个移动构造 rhs 的元素，用于分配器不相等的情况
+    template <class T, size_t N, class Alloc>
+    void small_vector<T, N, Alloc>::move_elements(small_vector &rhs)
+    {
+        MYSTL_DEBUG(empty());
+        reserve(rhs.size());
+        end_ = data_traits::uninitialized_move(this->alloc_ref(), rhs.begin_, rhs.end_, begin_);
+        rhs.clear();
+    }
+
+    // get_new_cap 函数，内嵌缓冲区保证容量不为 0
+    template <class T, size_t N, class Alloc>
+    typename small_vector<T, N, Alloc>::size_type
+    small_vector<T, N, Alloc>::get_new_cap(size_type add_size)
+    {
+        const auto old_size = capacity();
+        THROW_LENGTH_ERROR_IF(old_size > max_size() - add_size,
+                              "small_vector<T>'s size too big");
+        if (old_size > max_size() - old_size / 2)
+        {
+            return old_size + add_size;
+        }
+        return mySTL::max(old_size + old_size / 2, old_size + add_size);
+    }
+
+    // 在堆上重新分配 new_cap 大小的空间，先由 fill 构造 pos 处的 n 个新元素，
+    // 再把 [begin_, pos) 与 [pos, end_) 搬到新元素的两侧；fill 抛出异常时容器保持不变
+    template <class T, size_t N, class Alloc>
+    template <class Fill>
+    void small_vector<T, N, Alloc>::
+        reallocate_around(iterator pos, size_type n, size_type new_cap, Fill fill)
+    {
+        auto new_begin = data_traits::allocate(this->alloc_ref(), new_cap);
+        const size_type old_size = size();
+        try
+        {
+            fill(new_begin + (pos - begin_));
+        }
+        catch (...)
+        {
+            data_traits::deallocate(this->alloc_ref(), new_begin, new_cap);
+            throw;
+        }
+        relocate_around(pos, new_begin, n, new_cap, is_trivially_relocatable<T>{});
+        begin_ = new_begin;
+        end_ = new_begin + old_size + n;
+        cap_ = new_begin + new_cap;
+    }
+
+    // 可以按字节搬移的元素：两次 memcpy，原空间只释放不析构
+    template <class T, size_t N, class Alloc>
+    void small_vector<T, N, Alloc>::
+        relocate_around(iterator pos, iterator new_begin, size_type n, size_type, m_true_type) noexcept
+    {
+        auto new_pos = mySTL::uninitialized_relocate(begin_, pos, new_begin);
+        mySTL::uninitialized_relocate(pos, end_, new_pos + n);
+        if (!is_inline())
+        {
+            data_traits::deallocate(this->alloc_ref(), begin_, cap_ - begin_);
+        }
+    }
+
+    // 其他元素：逐个移动构造，失败时销毁新空间中已构造的元素并释放新空间
+    template <class T, size_t N, class Alloc>
+    void small_vector<T, N, Alloc>::
+        relocate_around(iterator pos, iterator new_begin, size_type n, size_type new_cap, m_false_type)
+    {
+        auto new_pos = new_begin + (pos - begin_);
+        try
+        {
+            data_traits::uninitialized_move(this->alloc_ref(), begin_, pos, new_begin);
+        }
+        catch (...)
+        {
+            data_traits::destroy(this->alloc_ref(), new_pos, new_pos + n);
+            data_traits::deallocate(this->alloc_ref(), new_begin, new_cap);
+            throw;
+        }
+        try
+        {
+            data_traits::uninitialized_move(this->alloc_ref(), pos, end_, new_pos + n);
+        }
+        catch (...)
+        {
+            data_traits::destroy(this->alloc_ref(), new_begin, new_pos + n);
+            data_traits::deallocate(this->alloc_ref(), new_begin, new_cap);
+            throw;
+        }
+        release();
+    }
+
+    // 输入迭代器只能逐个插入
+    template <class T, size_t N, class Alloc>
+    template <class IIter>
+    typename small_vector<T, N, Alloc>::iterator
+    small_vector<T, N, Alloc>::copy_insert(iterator pos, IIter first, IIter last, input_iterator_tag)
+    {
+        const size_type xpos = pos - begin_;
+        for (size_type i = xpos; first != last; ++first, ++i)
+        {
+            emplace(begin_ + i, *first);
+        }
+        return begin_ + xpos;
+    }
+
+    template <class T, size_t N, class Alloc>
+    template <class FIter>
+    typename small_vector<T, N, Alloc>::iterator
+    small_vector<T, N, Alloc>::copy_insert(iterator pos, FIter first, FIter last, forward_iterator_tag)
+    {
+        const size_type n = mySTL::distance(first, last);
+        return open_gap(pos, n,
+                        [&](iterator dfirst, iterator dlast)
+                        {
+                            auto mid = first;
+                            mySTL::advance(mid, n - (dlast - dfirst));
+                            data_traits::uninitialized_copy(this->alloc_ref(), mid, last, dfirst);
+                        },
+                        [&](iterator dfirst, iterator dlast)
+                        {
+                            mySTL::copy_n(first, dlast - dfirst, dfirst);
+                        });
+    }
+
+    // 在 pos 处空出 n 个位置并填入新元素
+    // 新元素的前一部分落在已构造的位置上，用 fill_assign(first, last) 赋值；
+    // 后一部分落在未初始化的位置上，用 fill_uninit(first, last) 构造，两者都按新元素的末尾对齐
+    template <class T, size_t N, class Alloc>
+    template <class FillUninit, class FillAssign>
+    typename small_vector<T, N, Alloc>::iterator
+    small_vector<T, N, Alloc>::open_gap(iterator pos, size_type n, FillUninit fill_uninit, FillAssign fill_assign)
+    {
+        const size_type xpos = pos - begin_;
+        if (n == 0)
+        {
+            return pos;
+        }
+        if (static_cast<size_type>(cap_ - end_) < n)
+        {
+            reallocate_around(pos, n, get_new_cap(n), [&](iterator p)
+            {
+                fill_uninit(p, p + n);
+            });
+            return begin_ + xpos;
+        }
+        const size_type after_elems = end_ - pos;
+        iterator old_end = end_;
+        if (after_elems > n)
+        {
+            end_ = data_traits::uninitialized_move(this->alloc_ref(), old_end - n, old_end, old_end);
+            mySTL::move_backward(pos, old_end - n, old_end);
+            fill_assign(pos, pos + n);
+        }
+        else
+        {
+            fill_uninit(old_end, pos + n);
+            end_ = pos + n;
+            try
+            {
+                end_ = data_traits::uninitialized_move(this->alloc_ref(), pos, old_end, end_);
+            }
+            catch (...)
+            {
+                data_traits::destroy(this->alloc_ref(), old_end, pos + n);
+                end_ = old_end;
+                throw;
+            }
+            fill_assign(pos, old_end);
+        }
+        return begin_ + xpos;
+    }
+
+    /*
+    重载比较符
+     */
+
+    template <class T, size_t N, class Alloc>
+    bool operator==(const small_vector<T, N, Alloc> &lhs, const small_vector<T, N, Alloc> &rhs)
+    {
+        return lhs.size() == rhs.size() &&
+               mySTL::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+
+    template <class T, size_t N, class Alloc>
+    bool operator<(const small_vector<T, N, Alloc> &lhs, const small_vector<T, N, Alloc> &rhs)
+    {
+        return mySTL::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+    template <class T, size_t N, class Alloc>
+    bool operator!=(const small_vector<T, N, Alloc> &lhs, const small_vector<T, N, Alloc> &rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    template <class T, size_t N, class Alloc>
+    bool operator>(const small_vector<T, N, Alloc> &lhs, const small_vector<T, N, Alloc> &rhs)
+    {
+        return rhs < lhs;
+    }
+
+    template <class T, size_t N, class Alloc>
+    bool operator<=(const small_vector<T, N, Alloc> &lhs, const small_vector<T, N, Alloc> &rhs)
+    {
+        return !(rhs < lhs);
+    }
+
+    template <class T, size_t N, class Alloc>
+    bool operator>=(const small_vector<T, N, Alloc> &lhs, const small_vector<T, N, Alloc> &rhs)
+    {
+        return !(lhs < rhs);
+    }
+
+    // 重载 mySTL 的 swap
+    template <class T, size_t N, class Alloc>
+    void swap(small_vector<T, N, Alloc> &lhs, small_vector<T, N, Alloc> &rhs)
+    {
+        lhs.swap(rhs);
+    }
+
+}
+
+#endif // !MYSTL_SMALL_VECTOR_H_
@@ -0,0 +1,979 @@
+#ifndef MYSTL_SOA_VECTOR_H_
+#define MYSTL_SOA_VECTOR_H_
+
+// 这个头文件包含一个模板类 basic_soa_vector 与它的别名 soa_vector
+// soa_vector<Ts...> : 按列存放的 vector，每个字段保存在各自的连续数组中，
+//                     只读取少数字段的循环不会把其余字段带进缓存，也便于编译器向量化：
+//   mySTL::soa_vector<int, double, double> v;
+//   v.push_back(1, 2.0, 3.0);
+//   for (double& x : v.column<1>()) x *= 2;
+// basic_soa_vector<Alloc, Ts...> : 使用指定分配器的 soa_vector，分配器对每一列 rebind 后分配该列的空间：
+//   mySTL::basic_soa_vector<mySTL::pmr::polymorphic_allocator<char>, int, double> v(&resource);
+
+// notes:
+//
+// 所有列共用同一个 size 与 capacity，重新分配时一起重新分配
+// operator[] 与迭代器解引用返回 std::tuple<Ts&...>，迭代器把各列的同一行组合在一起
+// 元素通过 allocator_traits 构造与析构，polymorphic_allocator 可以把 memory_resource 传给元素
+// 重新分配时，移动构造可能抛出异常的列先复制到新空间，全部成功后其余列才按字节搬移或移动构造
+// 异常保证：emplace_back、push_back、reserve 满足强异常安全保证，
+//           除非某一列只能移动且移动构造可能抛出异常，此时只满足基本保证
+
+#include <cstddef>
+#include <cstring>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "../../iterator/iterator.h"
+#include "../../util/memory.h"
+#include "../../util/span.h"
+#include "../../util/util.h"
+#include "../../util/exceptdef.h"
+#include "../../algorithm/algo.h"
+
+namespace mySTL
+{
+#ifdef max
+#pragma message("#undefing marco max")
+#undef max
+#endif // max
+
+#ifdef min
+#pragma message("#undefing marco min")
+#undef min
+#endif // min
+
+    // soa_vector 的迭代器设计：保存各列的起始地址与当前行号
+    template <class... Us>
+    struct soa_iterator : public iterator<random_access_iterator_tag,
+                                          std::tuple<typename std::remove_const<Us>::type...>,
+                                          ptrdiff_t, void, std::tuple<Us &...>>
+    {
+        typedef std::tuple<Us &...> reference;
+        typedef soa_iterator self;
+
+        std::tuple<Us *...> cols; // 各列的起始地址
+        ptrdiff_t idx;            // 当前行号
+
+        soa_iterator() noexcept
+            : cols(), idx(0) {}
+        soa_iterator(const std::tuple<Us *...> &c, ptrdiff_t i) noexcept
+            : cols(c), idx(i) {}
+
+        // iterator 可以转换为 const_iterator
+        template <class... Vs, typename std::enable_if<
+                                   std::is_convertible<std::tuple<Vs *...>, std::tuple<Us *...>>::value &&
+                                       !std::is_same<soa_iterator<Vs...>, soa_iterator>::value,
+                                   int>::type = 0>
+        soa_iterator(const soa_iterator<Vs...> &rhs) noexcept
+            : cols(rhs.cols), idx(rhs.idx) {}
+
+        reference operator*() const noexcept { return deref(mySTL::index_sequence_for<Us...>{}); }
+        reference operator[](ptrdiff_t n) const noexcept { return *(*this + n); }
+
+        self &operator++() noexcept
+        {
+            ++idx;
+            return *this;
+        }
+        self operator++(int) noexcept
+        {
+            self tmp = *this;
+            ++idx;
+            return tmp;
+        }
+        self &operator--() noexcept
+        {
+            --idx;
+            return *this;
+        }
+        self operator--(int) noexcept
+        {
+            self tmp = *this;
+            --idx;
+            return tmp;
+        }
+
+        self &operator+=(ptrdiff_t n) noexcept
+        {
+            idx += n;
+            return *this;
+        }
+        self &operator-=(ptrdiff_t n) noexcept
+        {
+            idx -= n;
+            return *this;
+        }
+        self operator+(ptrdiff_t n) const noexcept { return self(cols, idx + n); }
+        self operator-(ptrdiff_t n) const noexcept { return self(cols, idx - n); }
+        ptrdiff_t operator-(const self &rhs) const noexcept { return idx - rhs.idx; }
+
+        // 同一个容器的迭代器只比较行号
+        bool operator==(const self &rhs) const noexcept { return idx == rhs.idx; }
+        bool operator!=(const self &rhs) const noexcept { return idx != rhs.idx; }
+        bool operator<(const self &rhs) const noexcept { return idx < rhs.idx; }
+        bool operator>(const self &rhs) const noexcept { return idx > rhs.idx; }
+        bool operator<=(const self &rhs) const noexcept { return idx <= rhs.idx; }
+        bool operator>=(const self &rhs) const noexcept { return idx >= rhs.idx; }
+
+    private:
+        template <size_t... I>
+        reference deref(mySTL::index_sequence<I...>) const noexcept
+        {
+            return reference(std::get<I>(cols)[idx]...);
+        }
+    };
+
+    template <class... Us>
+    soa_iterator<Us...> operator+(ptrdiff_t n, const soa_iterator<Us...> &x) noexcept
+    {
+        return x + n;
+    }
+
+    // 模板类: basic_soa_vector
+    // 参数一代表分配器类型，其余参数代表各列的元素类型
+    template <class Alloc, class... Ts>
+    class basic_soa_vector
+        : private mySTL::alloc_holder<typename mySTL::allocator_traits<Alloc>::template rebind_alloc<std::tuple<Ts...>>>
+    {
+        static_assert(sizeof...(Ts) > 0, "soa_vector needs at least one column");
+
+    public:
+        // basic_soa_vector 的嵌套型别定义
+        typedef Alloc allocator_type;
+        typedef typename mySTL::allocator_traits<Alloc>::template rebind_alloc<std::tuple<Ts...>> data_allocator;
+        typedef mySTL::allocator_traits<data_allocator> data_traits;
+
+        typedef std::tuple<Ts...> value_type;
+        typedef std::tuple<Ts &...> reference;
+        typedef std::tuple<const Ts &...> const_reference;
+        typedef size_t size_type;
+        typedef ptrdiff_t difference_type;
+
+        typedef soa_iterator<Ts...> iterator;
+        typedef soa_iterator<const Ts...> const_iterator;
+        typedef mySTL::reverse_iterator<iterator> reverse_iterator;
+        typedef mySTL::reverse_iterator<const_iterator> const_reverse_iterator;
+
+        // 第 I 列的元素类型
+        template <size_t I>
+        using column_type = typename std::tuple_element<I, value_type>::type;
+
+        static constexpr size_type column_count = sizeof...(Ts);
+
+        allocator_type get_allocator() const { return allocator_type(this->alloc_ref()); }
+
+    private:
+        typedef mySTL::alloc_holder<data_allocator> alloc_base;
+        typedef std::tuple<Ts *...> column_pointers;
+        typedef mySTL::index_sequence_for<Ts...> column_indices;
+
+        // 第 I 列使用的分配器
+        template <size_t I>
+        using column_allocator = typename data_traits::template rebind_alloc<column_type<I>>;
+        template <size_t I>
+        using column_traits = mySTL::allocator_traits<column_allocator<I>>;
+
+        // 第 I 列搬到新空间时是否可能抛出异常
+        template <size_t I>
+        using column_may_throw = m_intergral_constant<bool,
+            !is_trivially_relocatable<column_type<I>>::value &&
+            !std::is_nothrow_move_constructible<column_type<I>>::value>;
+
+        column_pointers columns_; // 各列的起始地址
+        size_type size_;          // 行数
+        size_type cap_;           // 每一列的容量
+
+    public:
+        // 构造、复制、移动、析构函数
+        basic_soa_vector() noexcept
+            : columns_(), size_(0), cap_(0)
+        {
+        }
+
+        explicit basic_soa_vector(const allocator_type &alloc) noexcept
+            : alloc_base(data_allocator(alloc)), columns_(), size_(0), cap_(0)
+        {
+        }
+
+        explicit basic_soa_vector(size_type n, const allocator_type &alloc = allocator_type())
+            : alloc_base(data_allocator(alloc)), columns_(), size_(0), cap_(0)
+        {
+            resize(n);
+        }
+
+        basic_soa_vector(size_type n, const Ts &...values)
+            : columns_(), size_(0), cap_(0)
+        {
+            resize(n, values...);
+        }
+
+        basic_soa_vector(size_type n, const Ts &...values, const allocator_type &alloc)
+            : alloc_base(data_allocator(alloc)), columns_(), size_(0), cap_(0)
+        {
+            resize(n, values...);
+        }
+
+        basic_soa_vector(const basic_soa_vector &rhs)
+            : alloc_base(data_traits::select_on_container_copy_construction(rhs.alloc_ref())),
+              columns_(), size_(0), cap_(0)
+        {
+            init_from(rhs.columns_, rhs.size_, m_false_type{});
+        }
+
+        basic_soa_vector(const basic_soa_vector &rhs, const allocator_type &alloc)
+            : alloc_base(data_allocator(alloc)), columns_(), size_(0), cap_(0)
+        {
+            init_from(rhs.columns_, rhs.size_, m_false_type{});
+        }
+
+        basic_soa_vector(basic_soa_vector &&rhs) noexcept
+            : alloc_base(mySTL::move(rhs.alloc_ref())),
+              columns_(rhs.columns_), size_(rhs.size_), cap_(rhs.cap_)
+        {
+            rhs.columns_ = column_pointers();
+            rhs.size_ = 0;
+            rhs.cap_ = 0;
+        }
+
+        // 分配器不相等时逐个移动元素
+        basic_soa_vector(basic_soa_vector &&rhs, const allocator_type &alloc)
+            : alloc_base(data_allocator(alloc)), columns_(), size_(0), cap_(0)
+        {
+            if (mySTL::alloc_equal(this->alloc_ref(), rhs.alloc_ref()))
+            {
+                swap_storage(rhs);
+            }
+            else
+            {
+                init_from(rhs.columns_, rhs.size_, m_true_type{});
+            }
+        }
+
+        basic_soa_vector &operator=(const basic_soa_vector &rhs)
+        {
+            if (this != &rhs)
+            {
+                if (data_traits::propagate_on_container_copy_assignment::value &&
+                    !mySTL::alloc_equal(this->alloc_ref(), rhs.alloc_ref()))
+                { // 旧空间必须由原来的分配器释放
+                    release();
+                }
+                mySTL::alloc_copy_assign(this->alloc_ref(), rhs.alloc_ref(),
+                                         typename data_traits::propagate_on_container_copy_assignment{});
+                basic_soa_vector tmp(rhs, get_allocator());
+                swap_storage(tmp);
+            }
+            return *this;
+        }
+
+        basic_soa_vector &operator=(basic_soa_vector &&rhs) noexcept(
+            data_traits::propagate_on_container_move_assignment::value ||
+            data_traits::is_always_equal::value)
+        {
+            if (this != &rhs)
+            {
+                move_assign(rhs, m_intergral_constant<bool,
+                            data_traits::propagate_on_container_move_assignment::value ||
+                            data_traits::is_always_equal::value>{});
+            }
+            return *this;
+        }
+
+        ~basic_soa_vector()
+        {
+            release();
+        }
+
+    public:
+        // 迭代器相关操作
+        iterator begin() noexcept
+        {
+            return iterator(columns_, 0);
+        }
+        const_iterator begin() const noexcept
+        {
+            return const_iterator(columns_, 0);
+        }
+        iterator end() noexcept
+        {
+            return iterator(columns_, static_cast<difference_type>(size_));
+        }
+        const_iterator end() const noexcept
+        {
+            return const_iterator(columns_, static_cast<difference_type>(size_));
+        }
+
+        reverse_iterator rbegin() noexcept
+        {
+            return reverse_iterator(end());
+        }
+        const_reverse_iterator rbegin() const noexcept
+        {
+            return const_reverse_iterator(end());
+        }
+        reverse_iterator rend() noexcept
+        {
+            return reverse_iterator(begin());
+        }
+        const_reverse_iterator rend() const noexcept
+        {
+            return const_reverse_iterator(begin());
+        }
+
+        const_iterator cbegin() const noexcept
+        {
+            return begin();
+        }
+        const_iterator cend() const noexcept
+        {
+            return end();
+        }
+
+        // 容量相关操作
+        bool empty() const noexcept
+        {
+            return size_ == 0;
+        }
+        size_type size() const noexcept
+        {
+            return size_;
+        }
+        size_type max_size() const noexcept
+        {
+            return static_cast<size_type>(-1) / max_column_bytes();
+        }
+        size_type capacity() const noexcept
+        {
+            return cap_;
+        }
+        void reserve(size_type n);
+        void shrink_to_fit();
+
+        // 访问元素相关操作
+        reference operator[](size_type n)
+        {
+            MYSTL_DEBUG(n < size());
+            return *(begin() + static_cast<difference_type>(n));
+        }
+        const_reference operator[](size_type n) const
+        {
+            MYSTL_DEBUG(n < size());
+            return *(begin() + static_cast<difference_type>(n));
+        }
+        reference at(size_type n)
+        {
+            THROW_OUT_OF_RANGE_IF(!(n < size()), "soa_vector<Ts...>::at() subscript out of range");
+            return (*this)[n];
+        }
+        const_reference at(size_type n) const
+        {
+            THROW_OUT_OF_RANGE_IF(!(n < size()), "soa_vector<Ts...>::at() subscript out of range");
+            return (*this)[n];
+        }
+
+        reference front()
+        {
+            MYSTL_DEBUG(!empty());
+            return (*this)[0];
+        }
+        const_reference front() const
+        {
+            MYSTL_DEBUG(!empty());
+            return (*this)[0];
+        }
+        reference back()
+        {
+            MYSTL_DEBUG(!empty());
+            return (*this)[size_ - 1];
+        }
+        const_reference back() const
+        {
+            MYSTL_DEBUG(!empty());
+            return (*this)[size_ - 1];
+        }
+
+        // 按列访问：第 I 列的连续数组
+        template <size_t I>
+        column_type<I> *data() noexcept
+        {
+            return std::get<I>(columns_);
+        }
+        template <size_t I>
+        const column_type<I> *data() const noexcept
+        {
+            return std::get<I>(columns_);
+        }
+
+        template <size_t I>
+        span<column_type<I>> column() noexcept
+        {
+            return span<column_type<I>>(std::get<I>(columns_), size_);
+        }
+        template <size_t I>
+        span<const column_type<I>> column() const noexcept
+        {
+            return span<const column_type<I>>(std::get<I>(columns_), size_);
+        }
+
+        // 第 n 行的第 I 列
+        template <size_t I>
+        column_type<I> &get(size_type n)
+        {
+            MYSTL_DEBUG(n < size());
+            return std::get<I>(columns_)[n];
+        }
+        template <size_t I>
+        const column_type<I> &get(size_type n) const
+        {
+            MYSTL_DEBUG(n < size());
+            return std::get<I>(columns_)[n];
+        }
+
+        // 修改容器相关操作
+
+        // emplace_back：每个参数构造对应的一列
+        template <class... Args>
+        void emplace_back(Args &&...args);
+
+        // push_back / pop_back
+
+        void push_back(const Ts &...values)
+        {
+            emplace_back(values...);
+        }
+        void push_back(Ts &&...values)
+        {
+            emplace_back(mySTL::move(values)...);
+        }
+        void push_back(const value_type &row)
+        {
+            push_back_tuple(row, column_indices{});
+        }
+
+        void pop_back();
+
+        // erase / clear
+        iterator erase(const_iterator pos);
+        iterator erase(const_iterator first, const_iterator last);
+        void clear() noexcept
+        {
+            destroy_rows(0, size_);
+            size_ = 0;
+        }
+
+        // resize
+        void resize(size_type new_size);
+        void resize(size_type new_size, const Ts &...values);
+
+        // swap
+        void swap(basic_soa_vector &rhs) noexcept
+        {
+            if (this != &rhs)
+            {
+                MYSTL_DEBUG(data_traits::propagate_on_container_swap::value ||
+                            mySTL::alloc_equal(this->alloc_ref(), rhs.alloc_ref()));
+                mySTL::alloc_swap(this->alloc_ref(), rhs.alloc_ref(),
+                                  typename data_traits::propagate_on_container_swap{});
+                swap_storage(rhs);
+            }
+        }
+
+    private:
+        // helper functions
+
+        static constexpr size_type max_column_bytes() noexcept
+        {
+            return max_of(sizeof(Ts)...);
+        }
+        static constexpr size_type max_of(size_type x) noexcept
+        {
+            return x;
+        }
+        template <class... Rest>
+        static constexpr size_type max_of(size_type x, size_type y, Rest... rest) noexcept
+        {
+            return max_of(x > y ? x : y, rest...);
+        }
+
+        void swap_storage(basic_soa_vector &rhs) noexcept
+        {
+            mySTL::swap(columns_, rhs.columns_);
+            mySTL::swap(size_, rhs.size_);
+            mySTL::swap(cap_, rhs.cap_);
+        }
+
+        void move_assign(basic_soa_vector &rhs, m_true_type) noexcept;
+        void move_assign(basic_soa_vector &rhs, m_false_type);
+
+        // 分配与释放，每一列使用由 data_allocator rebind 得到的分配器
+        template <size_t I>
+        void allocate_column(column_pointers &cols, size_type n)
+        {
+            column_allocator<I> alloc(this->alloc_ref());
+            std::get<I>(cols) = column_traits<I>::allocate(alloc, n);
+        }
+        template <size_t I>
+        void deallocate_column(column_pointers &cols, size_type n) noexcept
+        {
+            if (std::get<I>(cols) != nullptr)
+            {
+                column_allocator<I> alloc(this->alloc_ref());
+                column_traits<I>::deallocate(alloc, std::get<I>(cols), n);
+            }
+            std::get<I>(cols) = nullptr;
+        }
+        template <size_t... I>
+        void allocate_columns(column_pointers &cols, size_type n, mySTL::index_sequence<I...>)
+        {
+            int dummy[] = {0, (allocate_column<I>(cols, n), 0)...};
+            (void)dummy;
+        }
+        template <size_t... I>
+        void deallocate_columns(column_pointers &cols, size_type n, mySTL::index_sequence<I...>) noexcept
+        {
+            int dummy[] = {0, (deallocate_column<I>(cols, n), 0)...};
+            (void)dummy;
+        }
+        column_pointers allocate_columns(size_type n);
+        void deallocate_columns(column_pointers &cols, size_type n) noexcept
+        {
+            deallocate_columns(cols, n, column_indices{});
+        }
+
+        // 销毁前 count 列的 [first, last) 行
+        template <size_t I>
+        void destroy_column(column_pointers &cols, size_type first, size_type last) noexcept
+        {
+            column_allocator<I> alloc(this->alloc_ref());
+            column_traits<I>::destroy(alloc, std::get<I>(cols) + first, std::get<I>(cols) + last);
+        }
+        template <size_t... I>
+        void destroy_columns(column_pointers &cols, size_type first, size_type last, size_t count,
+                             mySTL::index_sequence<I...>) noexcept
+        {
+            int dummy[] = {0, (I < count ? destroy_column<I>(cols, first, last) : void(), 0)...};
+            (void)dummy;
+        }
+        void destroy_rows(size_type first, size_type last) noexcept
+        {
+            destroy_columns(columns_, first, last, column_count, column_indices{});
+        }
+        void release() noexcept;
+
+        // 在 cols 中复制（m_false_type）或移动（m_true_type）构造 src 的前 n 行
+        template <size_t I>
+        void init_column(column_pointers &cols, const column_pointers &src, size_type n, m_false_type)
+        {
+            column_allocator<I> alloc(this->alloc_ref());
+            column_traits<I>::uninitialized_copy(alloc, std::get<I>(src), std::get<I>(src) + n,
+                                                 std::get<I>(cols));
+        }
+        template <size_t I>
+        void init_column(column_pointers &cols, const column_pointers &src, size_type n, m_true_type)
+        {
+            column_allocator<I> alloc(this->alloc_ref());
+            column_traits<I>::uninitialized_move(alloc, std::get<I>(src), std::get<I>(src) + n,
+                                                 std::get<I>(cols));
+        }
+        template <class Move, size_t... I>
+        void init_columns(column_pointers &cols, const column_pointers &src, size_type n, size_t &done,
+                          mySTL::index_sequence<I...>)
+        {
+            int dummy[] = {0, (init_column<I>(cols, src, n, Move()), ++done, 0)...};
+            (void)dummy;
+        }
+        template <class Move>
+        void init_from(const column_pointers &src, size_type n, Move);
+
+        // 把第 I 列的前 n 行搬到 cols 中，only_may_throw 为 true 时只处理可能抛出异常的列，否则只处理其余列
+        template <size_t I>
+        void relocate_column(column_pointers &cols, size_type n, bool only_may_throw)
+        {
+            if (column_may_throw<I>::value == only_may_throw)
+            {
+                relocate_column_aux<I>(cols, n, is_trivially_relocatable<column_type<I>>{});
+            }
+        }
+        template <size_t I>
+        void relocate_column_aux(column_pointers &cols, size_type n, m_true_type) noexcept
+        {
+            if (n != 0)
+            {
+                std::memcpy(static_cast<void *>(std::get<I>(cols)),
+                            static_cast<const void *>(std::get<I>(columns_)), n * sizeof(column_type<I>));
+            }
+        }
+        template <size_t I>
+        void relocate_column_aux(column_pointers &cols, size_type n, m_false_type);
+        template <size_t... I>
+        void relocate_columns(column_pointers &cols, size_type n, bool only_may_throw, size_t &done,
+                              mySTL::index_sequence<I...>)
+        {
+            int dummy[] = {0, (relocate_column<I>(cols, n, only_may_throw), ++done, 0)...};
+            (void)dummy;
+        }
+
+        // 第一轮失败时销毁新空间中已复制的列；搬移完成后销毁原空间中不能按字节搬移的列
+        template <size_t... I>
+        void destroy_copied_columns(column_pointers &cols, size_type n, size_t done,
+                                    mySTL::index_sequence<I...>) noexcept
+        {
+            int dummy[] = {0, (I < done && column_may_throw<I>::value
+                                   ? destroy_column<I>(cols, 0, n) : void(), 0)...};
+            (void)dummy;
+        }
+        template <size_t... I>
+        void destroy_relocated_columns(size_type n, mySTL::index_sequence<I...>) noexcept
+        {
+            int dummy[] = {0, (!is_trivially_relocatable<column_type<I>>::value
+                                   ? destroy_column<I>(columns_, 0, n) : void(), 0)...};
+            (void)dummy;
+        }
+
+        // calculate the growth size
+        size_type get_new_cap(size_type add_size);
+
+        void reallocate(size_type new_cap);
+
+        // erase 时第 I 列把 [l, n) 移到 f 处
+        template <size_t I>
+        void move_column_down(size_type f, size_type l, size_type n)
+        {
+            column_type<I> *col = std::get<I>(columns_);
+            mySTL::move(col + l, col + n, col + f);
+        }
+        template <size_t... I>
+        void move_rows_down(size_type f, size_type l, size_type n, mySTL::index_sequence<I...>)
+        {
+            int dummy[] = {0, (move_column_down<I>(f, l, n), 0)...};
+            (void)dummy;
+        }
+
+        // 在第 size_ 行构造一行元素，某一列抛出异常时销毁本行已构造的列
+        template <size_t I, class Arg>
+        void construct_column(Arg &&arg)
+        {
+            column_allocator<I> alloc(this->alloc_ref());
+            column_traits<I>::construct(alloc, std::get<I>(columns_) + size_, mySTL::forward<Arg>(arg));
+        }
+        template <size_t... I, class... Args>
+        void construct_back(mySTL::index_sequence<I...>, Args &&...args);
+
+        template <size_t... I>
+        void push_back_tuple(const value_type &row, mySTL::index_sequence<I...>)
+        {
+            emplace_back(std::get<I>(row)...);
+        }
+        template <size_t... I>
+        void emplace_back_tuple(value_type &&row, mySTL::index_sequence<I...>)
+        {
+            construct_back(column_indices{}, mySTL::move(std::get<I>(row))...);
+        }
+    };
+
+    template <class Alloc, class... Ts>
+    constexpr typename basic_soa_vector<Alloc, Ts...>::size_type basic_soa_vector<Alloc, Ts...>::column_count;
+
+    // 使用 mySTL::allocator 的 basic_soa_vector
+    template <class... Ts>
+    using soa_vector = basic_soa_vector<mySTL::allocator<std::tuple<Ts...>>, Ts...>;
+
+    // 预留空间大小，当原容量小于要求大小时，才会重新分配
+    template <class Alloc, class... Ts>
+    void basic_soa_vector<Alloc, Ts...>::reserve(size_type n)
+    {
+        if (capacity() < n)
+        {
+            THROW_LENGTH_ERROR_IF(n > max_size(),
+                                  "n can not larger than max_size() in soa_vector<Ts...>::reserve(n)");
+            reallocate(n);
+        }
+    }
+
+    // 放弃多余的容量
+    template <class Alloc, class... Ts>
+    void basic_soa_vector<Alloc, Ts...>::shrink_to_fit()
+    {
+        if (size_ == cap_)
+        {
+            return;
+        }
+        if (size_ == 0)
+        {
+            release();
+            return;
+        }
+        reallocate(size_);
+    }
+
+    // 在尾部添加一行，参数可能引用容器中的元素，需要重新分配时先构造到临时对象中
+    template <class Alloc, class... Ts>
+    template <class... Args>
+    void basic_soa_vector<Alloc, Ts...>::emplace_back(Args &&...args)
+    {
+        static_assert(sizeof...(Args) == sizeof...(Ts), "soa_vector<Ts...>::emplace_back needs one argument per column");
+        if (size_ < cap_)
+        {
+            construct_back(column_indices{}, mySTL::forward<Args>(args)...);
+        }
+        else
+        {
+            value_type row(mySTL::forward<Args>(args)...);
+            reallocate(get_new_cap(1));
+            emplace_back_tuple(mySTL::move(row), column_indices{});
+        }
+        ++size_;
+    }
+
+    // 弹出尾部的一行
+    template <class Alloc, class... Ts>
+    void basic_soa_vector<Alloc, Ts...>::pop_back()
+    {
+        MYSTL_DEBUG(!empty());
+        destroy_rows(size_ - 1, size_);
+        --size_;
+    }
+
+    // 删除 pos 所在的行
+    template <class Alloc, class... Ts>
+    typename basic_soa_vector<Alloc, Ts...>::iterator
+    basic_soa_vector<Alloc, Ts...>::erase(const_iterator pos)
+    {
+        MYSTL_DEBUG(pos >= cbegin() && pos < cend());
+        return erase(pos, pos + 1);
+    }
+
+    // 删除[first, last)上的行，每一列分别把后面的元素前移
+    template <class Alloc, class... Ts>
+    typename basic_soa_vector<Alloc, Ts...>::iterator
+    basic_soa_vector<Alloc, Ts...>::erase(const_iterator first, const_iterator last)
+    {
+        MYSTL_DEBUG(first >= cbegin() && last <= cend() && !(last < first));
+        const size_type f = static_cast<size_type>(first - cbegin());
+        const size_type l = static_cast<size_type>(last - cbegin());
+        const size_type n = size_;
+        move_rows_down(f, l, n, column_indices{});
+        destroy_rows(n - (l - f), n);
+        size_ = n - (l - f);
+        return begin() + static_cast<difference_type>(f);
+    }
+
+    // 重置容器大小，新增的行做值初始化
+    template <class Alloc, class... Ts>
+    void basic_soa_vector<Alloc, Ts...>::resize(size_type new_size)
+    {
+        if (new_size < size_)
+        {
+            destroy_rows(new_size, size_);
+            size_ = new_size;
+            return;
+        }
+        reserve(new_size);
+        while (size_ < new_size)
+        {
+            construct_back(column_indices{}, Ts()...);
+            ++size_;
+        }
+    }
+
+    // 重置容器大小，新增的行复制 values
+    template <class Alloc, class... Ts>
+    void basic_soa_vector<Alloc, Ts...>::resize(size_type new_size, const Ts &...values)
+    {
+        if (new_size < size_)
+        {
+            destroy_rows(new_size, size_);
+            size_ = new_size;
+            return;
+        }
+        const value_type row(values...); // values 可能引用容器中的元素
+        reserve(new_size);
+        while (size_ < new_size)
+        {
+            push_back_tuple(row, column_indices{});
+        }
+    }
+
+    /*
+    helper_function
+     */
+
+    // 分配器随容器传播或总是相等时，直接接管 rhs 的空间
+    template <class Alloc, class... Ts>
+    void basic_soa_vector<Alloc, Ts...>::move_assign(basic_soa_vector &rhs, m_true_type) noexcept
+    {
+        release();
+        mySTL::alloc_move_assign(this->alloc_ref(), rhs.alloc_ref(),
+                                 typename data_traits::propagate_on_container_move_assignment{});
+        swap_storage(rhs);
+    }
+
+    // 分配器不传播时，只有两者相等才能接管空间，否则逐个移动元素
+    template <class Alloc, class... Ts>
+    void basic_soa_vector<Alloc, Ts...>::move_assign(basic_soa_vector &rhs, m_false_type)
+    {
+        if (mySTL::alloc_equal(this->alloc_ref(), rhs.alloc_ref()))
+        {
+            move_assign(rhs, m_true_type{});
+        }
+        else
+        {
+            basic_soa_vector tmp(mySTL::move(rhs), get_allocator());
+            swap_storage(tmp);
+            rhs.clear();
+        }
+    }
+
+    // 为每一列分配 n 个元素的空间，某一列分配失败时释放已分配的列
+    template <class Alloc, class... Ts>
+    typename basic_soa_vector<Alloc, Ts...>::column_pointers
+    basic_soa_vector<Alloc, Ts...>::allocate_columns(size_type n)
+    {
+        column_pointers cols{};
+        try
+        {
+            allocate_columns(cols, n, column_indices{});
+        }
+        catch (...)
+        {
+            deallocate_columns(cols, n);
+            throw;
+        }
+        return cols;
+    }
+
+    template <class Alloc, class... Ts>
+    void basic_soa_vector<Alloc, Ts...>::release() noexcept
+    {
+        destroy_rows(0, size_);
+        deallocate_columns(columns_, cap_);
+        size_ = 0;
+        cap_ = 0;
+    }
+
+    // 当前对象为空：逐列复制或移动 src 的前 n 行，某一列失败时销毁已构造的列
+    template <class Alloc, class... Ts>
+    template <class Move>
+    void basic_soa_vector<Alloc, Ts...>::init_from(const column_pointers &src, size_type n, Move)
+    {
+        if (n == 0)
+        {
+            return;
+        }
+        column_pointers cols = allocate_columns(n);
+        size_t done = 0;
+        try
+        {
+            init_columns<Move>(cols, src, n, done, column_indices{});
+        }
+        catch (...)
+        {
+            destroy_columns(cols, 0, n, done, column_indices{});
+            deallocate_columns(cols, n);
+            throw;
+        }
+        columns_ = cols;
+        size_ = n;
+        cap_ = n;
+    }
+
+    // get_new_cap 函数
+    template <class Alloc, class... Ts>
+    typename basic_soa_vector<Alloc, Ts...>::size_type
+    basic_soa_vector<Alloc, Ts...>::get_new_cap(size_type add_size)
+    {
+        const auto old_size = capacity();
+        THROW_LENGTH_ERROR_IF(old_size > max_size() - add_size,
+                              "soa_vector<Ts...>'s size too big");
+        if (old_size > max_size() - old_size / 2)
+        {
+            return old_size + add_size > max_size() - 16 ? old_size + add_size : old_size + add_size + 16;
+        }
+        return old_size == 0 ? mySTL::max(add_size, static_cast<size_type>(16))
+                             : mySTL::max(old_size + old_size / 2, old_size + add_size);
+    }
+
+    // 不能按字节搬移的列：移动构造不会抛出异常时移动，否则复制，失败时销毁本列已构造的元素
+    template <class Alloc, class... Ts>
+    template <size_t I>
+    void basic_soa_vector<Alloc, Ts...>::relocate_column_aux(column_pointers &cols, size_type n, m_false_type)
+    {
+        column_allocator<I> alloc(this->alloc_ref());
+        column_type<I> *from = std::get<I>(columns_);
+        column_type<I> *to = std::get<I>(cols);
+        size_type i = 0;
+        try
+        {
+            for (; i < n; ++i)
+            {
+                column_traits<I>::construct(alloc, to + i, std::move_if_noexcept(from[i]));
+            }
+        }
+        catch (...)
+        {
+            column_traits<I>::destroy(alloc, to, to + i);
+            throw;
+        }
+    }
+
+    // 所有列一起搬到 new_cap 大小的新空间，分两轮进行：
+    // 第一轮复制移动构造可能抛出异常的列，失败时销毁已复制的列并释放新空间，原空间保持不变；
+    // 第二轮按字节搬移或移动构造其余的列，不会抛出异常
+    template <class Alloc, class... Ts>
+    void basic_soa_vector<Alloc, Ts...>::reallocate(size_type new_cap)
+    {
+        column_pointers cols = allocate_columns(new_cap);
+        const size_type n = size_;
+        size_t done = 0;
+        try
+        {
+            relocate_columns(cols, n, true, done, column_indices{});
+        }
+        catch (...)
+        {
+            destroy_copied_columns(cols, n, done, column_indices{});
+            deallocate_columns(cols, new_cap);
+            throw;
+        }
+        done = 0;
+        relocate_columns(cols, n, false, done, column_indices{});
+        // 按字节搬移的列在原空间中视为未初始化，不再析构
+        destroy_relocated_columns(n, column_indices{});
+        deallocate_columns(columns_, cap_);
+        columns_ = cols;
+        cap_ = new_cap;
+    }
+
+    template <class Alloc, class... Ts>
+    template <size_t... I, class... Args>
+    void basic_soa_vector<Alloc, Ts...>::construct_back(mySTL::index_sequence<I...>, Args &&...args)
+    {
+        size_t done = 0;
+        try
+        {
+            int dummy[] = {0, (construct_column<I>(mySTL::forward<Args>(args)), ++done, 0)...};
+            (void)dummy;
+        }
+        catch (...)
+        {
+            destroy_columns(columns_, size_, size_ + 1, done, column_indices{});
+            throw;
+        }
+    }
+
+    // 重载 mySTL 的 swap
+    template <class Alloc, class... Ts>
+    void swap(basic_soa_vector<Alloc, Ts...> &lhs, basic_soa_vector<Alloc, Ts...> &rhs) noexcept
+    {
+        lhs.swap(rhs);
+    }
+
+    // soa_vector 只保存指向各列的指针与分配器
+    template <class Alloc, class... Ts>
+    struct is_trivially_relocatable<basic_soa_vector<Alloc, Ts...>> : is_trivially_relocatable<Alloc> {};
+
+}
+
+#endif // !MYSTL_SOA_VECTOR_H_
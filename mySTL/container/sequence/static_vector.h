@@ -0,0 +1,681 @@
+#ifndef MYSTL_STATIC_VECTOR_H_
+#define MYSTL_STATIC_VECTOR_H_
+
+// 这个头文件包含一个模板类 static_vector
+// static_vector : 容量固定为 N 的 vector，元素全部存放在对象内部，任何操作都不会分配内存，
+//                 可以放在其他结构体中作为定长缓冲区使用
+
+// notes:
+//
+// 接口与 mySTL::vector 相同，没有分配器，capacity() 与 max_size() 恒为 N
+// 元素个数超过 N 时抛出 std::length_error；
+// 定义 MYSTL_STATIC_VECTOR_UNCHECKED 后只保留 MYSTL_DEBUG 断言，定义 NDEBUG 后检查完全消失
+// 移动构造、移动赋值与 swap 需要逐个移动元素，迭代器指向的仍然是原来的对象
+// 异常保证：emplace_back、push_back 满足强异常安全保证
+
+#include <initializer_list>
+#include <type_traits>
+
+#include "../../iterator/iterator.h"
+#include "../../util/memory.h"
+#include "../../util/util.h"
+#include "../../util/exceptdef.h"
+#include "../../algorithm/algo.h"
+
+#ifndef MYSTL_STATIC_VECTOR_UNCHECKED
+#define STATIC_VECTOR_CHECK(expr, what) THROW_LENGTH_ERROR_IF(expr, what)
+#else
+#define STATIC_VECTOR_CHECK(expr, what) MYSTL_DEBUG(!(expr))
+#endif
+
+namespace mySTL
+{
+#ifdef max
+#pragma message("#undefing marco max")
+#undef max
+#endif // max
+
+#ifdef min
+#pragma message("#undefing marco min")
+#undef min
+#endif // min
+
+    template <class T, size_t N>
+    class static_vector
+    {
+        static_assert(N > 0, "static_vector needs a non-zero capacity");
+
+    public:
+        // static_vector 的嵌套型别定义
+        typedef T value_type;
+        typedef value_type *pointer;
+        typedef const value_type *const_pointer;
+        typedef value_type &reference;
+        typedef const value_type &const_reference;
+        typedef size_t size_type;
+        typedef ptrdiff_t difference_type;
+
+        typedef value_type *iterator;
+        typedef const value_type *const_iterator;
+        typedef mySTL::reverse_iterator<iterator> reverse_iterator;
+        typedef mySTL::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    private:
+        // 只保存元素个数而不保存指针，对象按字节复制后仍然有效
+        size_type size_;
+        typename std::aligned_storage<sizeof(T) * N, alignof(T)>::type buffer_;
+
+    public:
+        // 构造、复制、移动、析构函数
+        static_vector() noexcept
+            : size_(0)
+        {
+        }
+
+        explicit static_vector(size_type n)
+            : size_(0)
+        {
+            fill_init(n, value_type());
+        }
+
+        static_vector(size_type n, const value_type &value)
+            : size_(0)
+        {
+            fill_init(n, value);
+        }
+
+        template <class Iter, typename std::enable_if<
+                                  mySTL::is_input_iterator<Iter>::value, int>::type = 0>
+        static_vector(Iter first, Iter last)
+            : size_(0)
+        { // input iterator 逐个插入，中途抛出异常时析构函数不会运行，需要析构已插入的元素
+            try
+            {
+                insert(end(), first, last);
+            }
+            catch (...)
+            {
+                clear();
+                throw;
+            }
+        }
+
+        static_vector(const static_vector &rhs)
+            : size_(0)
+        {
+            mySTL::uninitialized_copy(rhs.begin(), rhs.end(), begin());
+            size_ = rhs.size_;
+        }
+
+        static_vector(static_vector &&rhs) noexcept(std::is_nothrow_move_constructible<T>::value)
+            : size_(0)
+        {
+            mySTL::uninitialized_move(rhs.begin(), rhs.end(), begin());
+            size_ = rhs.size_;
+            rhs.clear();
+        }
+
+        static_vector(std::initializer_list<value_type> ilist)
+            : size_(0)
+        {
+            insert(end(), ilist.begin(), ilist.end());
+        }
+
+        static_vector &operator=(const static_vector &rhs);
+        static_vector &operator=(static_vector &&rhs);
+
+        static_vector &operator=(std::initializer_list<value_type> ilist)
+        {
+            assign(ilist.begin(), ilist.end());
+            return *this;
+        }
+
+        ~static_vector()
+        {
+            clear();
+        }
+
+    public:
+        // 迭代器相关操作
+        iterator begin() noexcept
+        {
+            return reinterpret_cast<iterator>(&buffer_);
+        }
+        const_iterator begin() const noexcept
+        {
+            return reinterpret_cast<const_iterator>(&buffer_);
+        }
+        iterator end() noexcept
+        {
+            return begin() + size_;
+        }
+        const_iterator end() const noexcept
+        {
+            return begin() + size_;
+        }
+
+        reverse_iterator rbegin() noexcept
+        {
+            return reverse_iterator(end());
+        }
+        const_reverse_iterator rbegin() const noexcept
+        {
+            return const_reverse_iterator(end());
+        }
+        reverse_iterator rend() noexcept
+        {
+            return reverse_iterator(begin());
+        }
+        const_reverse_iterator rend() const noexcept
+        {
+            return const_reverse_iterator(begin());
+        }
+
+        const_iterator cbegin() const noexcept
+        {
+            return begin();
+        }
+        const_iterator cend() const noexcept
+        {
+            return end();
+        }
+        const_reverse_iterator crbegin() const noexcept
+        {
+            return rbegin();
+        }
+        const_reverse_iterator crend() const noexcept
+        {
+            return rend();
+        }
+
+        // 容量相关操作
+        bool empty() const noexcept
+        {
+            return size_ == 0;
+        }
+        bool full() const noexcept
+        {
+            return size_ == N;
+        }
+        size_type size() const noexcept
+        {
+            return size_;
+        }
+        size_type max_size() const noexcept
+        {
+            return N;
+        }
+        size_type capacity() const noexcept
+        {
+            return N;
+        }
+        void reserve(size_type n)
+        {
+            (void)n;
+            STATIC_VECTOR_CHECK(n > N, "n can not larger than capacity() in static_vector<T>::reserve(n)");
+        }
+        void shrink_to_fit() noexcept {}
+
+        // 访问元素相关操作
+        reference operator[](size_type n)
+        {
+            MYSTL_DEBUG(n < size());
+            return *(begin() + n);
+        }
+        const_reference operator[](size_type n) const
+        {
+            MYSTL_DEBUG(n < size());
+            return *(begin() + n);
+        }
+        reference at(size_type n)
+        {
+            THROW_OUT_OF_RANGE_IF(!(n < size()), "static_vector<T>::at() subscript out of range");
+            return (*this)[n];
+        }
+        const_reference at(size_type n) const
+        {
+            THROW_OUT_OF_RANGE_IF(!(n < size()), "static_vector<T>::at() subscript out of range");
+            return (*this)[n];
+        }
+
+        reference front()
+        {
+            MYSTL_DEBUG(!empty());
+            return *begin();
+        }
+        const_reference front() const
+        {
+            MYSTL_DEBUG(!empty());
+            return *begin();
+        }
+        reference back()
+        {
+            MYSTL_DEBUG(!empty());
+            return *(end() - 1);
+        }
+        const_reference back() const
+        {
+            MYSTL_DEBUG(!empty());
+            return *(end() - 1);
+        }
+
+        pointer data() noexcept { return begin(); }
+        const_pointer data() const noexcept { return begin(); }
+
+        // 修改容器相关操作
+
+        // assign
+
+        void assign(size_type n, const value_type &value);
+
+        template <class Iter, typename std::enable_if<
+                                  mySTL::is_input_iterator<Iter>::value, int>::type = 0>
+        void assign(Iter first, Iter last)
+        {
+            clear();
+            insert(end(), first, last);
+        }
+
+        void assign(std::initializer_list<value_type> il)
+        {
+            assign(il.begin(), il.end());
+        }
+
+        // emplace / emplace_back
+
+        template <class... Args>
+        iterator emplace(const_iterator pos, Args &&...args);
+
+        template <class... Args>
+        void emplace_back(Args &&...args);
+
+        // push_back / pop_back
+
+        void push_back(const value_type &value)
+        {
+            emplace_back(value);
+        }
+        void push_back(value_type &&value)
+        {
+            emplace_back(mySTL::move(value));
+        }
+
+        void pop_back();
+
+        // insert
+
+        iterator insert(const_iterator pos, const value_type &value)
+        {
+            return emplace(pos, value);
+        }
+        iterator insert(const_iterator pos, value_type &&value)
+        {
+            return emplace(pos, mySTL::move(value));
+        }
+
+        iterator insert(const_iterator pos, size_type n, const value_type &value);
+
+        template <class Iter, typename std::enable_if<
+                                  mySTL::is_input_iterator<Iter>::value, int>::type = 0>
+        iterator insert(const_iterator pos, Iter first, Iter last)
+        {
+            MYSTL_DEBUG(pos >= begin() && pos <= end());
+            return copy_insert(const_cast<iterator>(pos), first, last, iterator_category(first));
+        }
+
+        iterator insert(const_iterator pos, std::initializer_list<value_type> il)
+        {
+            return insert(pos, il.begin(), il.end());
+        }
+
+        // erase / clear
+        iterator erase(const_iterator pos);
+        iterator erase(const_iterator first, const_iterator last);
+        void clear() noexcept
+        {
+            mySTL::destroy(begin(), end());
+            size_ = 0;
+        }
+
+        // resize / reverse
+        void resize(size_type new_size) { return resize(new_size, value_type()); }
+        void resize(size_type new_size, const value_type &value);
+
+        void reverse() { mySTL::reverse(begin(), end()); }
+
+        // swap
+        void swap(static_vector &rhs);
+
+    private:
+        // helper functions
+
+        void fill_init(size_type n, const value_type &value);
+
+        template <class IIter>
+        iterator copy_insert(iterator pos, IIter first, IIter last, input_iterator_tag);
+        template <class FIter>
+        iterator copy_insert(iterator pos, FIter first, FIter last, forward_iterator_tag);
+        template <class FillUninit, class FillAssign>
+        iterator open_gap(iterator pos, size_type n, FillUninit fill_uninit, FillAssign fill_assign);
+    };
+
+    // 复制赋值操作符
+    template <class T, size_t N>
+    static_vector<T, N> &static_vector<T, N>::operator=(const static_vector &rhs)
+    {
+        if (this != &rhs)
+        {
+            if (rhs.size() > size())
+            {
+                mySTL::copy(rhs.begin(), rhs.begin() + size(), begin());
+                mySTL::uninitialized_copy(rhs.begin() + size(), rhs.end(), end());
+                size_ = rhs.size_;
+            }
+            else
+            {
+                erase(mySTL::copy(rhs.begin(), rhs.end(), begin()), end());
+            }
+        }
+        return *this;
+    }
+
+    // 移动赋值操作符
+    template <class T, size_t N>
+    static_vector<T, N> &static_vector<T, N>::operator=(static_vector &&rhs)
+    {
+        if (this != &rhs)
+        {
+            if (rhs.size() > size())
+            {
+                mySTL::move(rhs.begin(), rhs.begin() + size(), begin());
+                mySTL::uninitialized_move(rhs.begin() + size(), rhs.end(), end());
+                size_ = rhs.size_;
+            }
+            else
+            {
+                erase(mySTL::move(rhs.begin(), rhs.end(), begin()), end());
+            }
+            rhs.clear();
+        }
+        return *this;
+    }
+
+    // 在 pos 位置就地构造元素
+    template <class T, size_t N>
+    template <class... Args>
+    typename static_vector<T, N>::iterator
+    static_vector<T, N>::emplace(const_iterator pos, Args &&...args)
+    {
+        MYSTL_DEBUG(pos >= begin() && pos <= end());
+        STATIC_VECTOR_CHECK(full(), "static_vector<T>'s size too big");
+        iterator xpos = const_cast<iterator>(pos);
+        iterator last = end();
+        if (xpos == last)
+        {
+            mySTL::construct(mySTL::address_of(*last), mySTL::forward<Args>(args)...);
+            ++size_;
+        }
+        else
+        {
+            value_type tmp(mySTL::forward<Args>(args)...); // 参数可能引用容器中的元素
+            mySTL::construct(mySTL::address_of(*last), mySTL::move(*(last - 1)));
+            ++size_;
+            mySTL::move_backward(xpos, last - 1, last);
+            *xpos = mySTL::move(tmp);
+        }
+        return xpos;
+    }
+
+    // 在尾部就地构造元素
+    template <class T, size_t N>
+    template <class... Args>
+    void static_vector<T, N>::emplace_back(Args &&...args)
+    {
+        STATIC_VECTOR_CHECK(full(), "static_vector<T>'s size too big");
+        mySTL::construct(mySTL::address_of(*end()), mySTL::forward<Args>(args)...);
+        ++size_;
+    }
+
+    // 弹出尾部元素
+    template <class T, size_t N>
+    void static_vector<T, N>::pop_back()
+    {
+        MYSTL_DEBUG(!empty());
+        mySTL::destroy(end() - 1);
+        --size_;
+    }
+
+    // 在 pos 处插入 n 个元素
+    template <class T, size_t N>
+    typename static_vector<T, N>::iterator
+    static_vector<T, N>::insert(const_iterator pos, size_type n, const value_type &value)
+    {
+        MYSTL_DEBUG(pos >= begin() && pos <= end());
+        const value_type value_copy = value; // 避免被覆盖
+        return open_gap(const_cast<iterator>(pos), n,
+                        [&](iterator first, iterator last)
+                        {
+                            mySTL::uninitialized_fill_n(first, last - first, value_copy);
+                        },
+                        [&](iterator first, iterator last)
+                        {
+                            mySTL::fill_n(first, last - first, value_copy);
+                        });
+    }
+
+    // 删除 pos 位置上的元素
+    template <class T, size_t N>
+    typename static_vector<T, N>::iterator
+    static_vector<T, N>::erase(const_iterator pos)
+    {
+        MYSTL_DEBUG(pos >= begin() && pos < end());
+        iterator xpos = const_cast<iterator>(pos);
+        mySTL::move(xpos + 1, end(), xpos);
+        pop_back();
+        return xpos;
+    }
+
+    // 删除[first, last)上的元素
+    template <class T, size_t N>
+    typename static_vector<T, N>::iterator
+    static_vector<T, N>::erase(const_iterator first, const_iterator last)
+    {
+        MYSTL_DEBUG(first >= begin() && last <= end() && !(last < first));
+        iterator r = const_cast<iterator>(first);
+        mySTL::destroy(mySTL::move(r + (last - first), end(), r), end());
+        size_ -= static_cast<size_type>(last - first);
+        return r;
+    }
+
+    // 重置容器大小
+    template <class T, size_t N>
+    void static_vector<T, N>::resize(size_type new_size, const value_type &value)
+    {
+        if (new_size < size())
+        {
+            erase(begin() + new_size, end());
+        }
+        else
+        {
+            insert(end(), new_size - size(), value);
+        }
+    }
+
+    // 用 n 个 value 为容器赋值
+    template <class T, size_t N>
+    void static_vector<T, N>::assign(size_type n, const value_type &value)
+    {
+        STATIC_VECTOR_CHECK(n > N, "static_vector<T>'s size too big");
+        const value_type value_copy = value; // value 可能是容器中的元素
+        if (n > size())
+        {
+            mySTL::fill(begin(), end(), value_copy);
+            mySTL::uninitialized_fill_n(end(), n - size(), value_copy);
+            size_ = n;
+        }
+        else
+        {
+            erase(mySTL::fill_n(begin(), n, value_copy), end());
+        }
+    }
+
+    // 与另一个 static_vector 交换：交换公共部分，较长一方多出的元素移动到较短的一方
+    template <class T, size_t N>
+    void static_vector<T, N>::swap(static_vector &rhs)
+    {
+        if (this == &rhs)
+        {
+            return;
+        }
+        static_vector *shorter = size_ < rhs.size_ ? this : &rhs;
+        static_vector *longer = size_ < rhs.size_ ? &rhs : this;
+        const size_type common = shorter->size_;
+        mySTL::swap_ranges(shorter->begin(), shorter->end(), longer->begin());
+        mySTL::uninitialized_move(longer->begin() + common, longer->end(), shorter->end());
+        shorter->size_ = longer->size_;
+        longer->erase(longer->begin() + common, longer->end());
+    }
+
+    /*
+    helper_function
+     */
+
+    // fill_init 函数
+    template <class T, size_t N>
+    void static_vector<T, N>::fill_init(size_type n, const value_type &value)
+    {
+        STATIC_VECTOR_CHECK(n > N, "static_vector<T>'s size too big");
+        mySTL::uninitialized_fill_n(begin(), n, value);
+        size_ = n;
+    }
+
+    // 输入迭代器只能逐个插入
+    template <class T, size_t N>
+    template <class IIter>
+    typename static_vector<T, N>::iterator
+    static_vector<T, N>::copy_insert(iterator pos, IIter first, IIter last, input_iterator_tag)
+    {
+        iterator cur = pos;
+        for (; first != last; ++first, ++cur)
+        {
+            emplace(cur, *first);
+        }
+        return pos;
+    }
+
+    template <class T, size_t N>
+    template <class FIter>
+    typename static_vector<T, N>::iterator
+    static_vector<T, N>::copy_insert(iterator pos, FIter first, FIter last, forward_iterator_tag)
+    {
+        const size_type n = mySTL::distance(first, last);
+        return open_gap(pos, n,
+                        [&](iterator dfirst, iterator dlast)
+                        {
+                            auto mid = first;
+                            mySTL::advance(mid, n - (dlast - dfirst));
+                            mySTL::uninitialized_copy(mid, last, dfirst);
+                        },
+                        [&](iterator dfirst, iterator dlast)
+                        {
+                            mySTL::copy_n(first, dlast - dfirst, dfirst);
+                        });
+    }
+
+    // 在 pos 处空出 n 个位置并填入新元素
+    // 新元素的前一部分落在已构造的位置上，用 fill_assign(first, last) 赋值；
+    // 后一部分落在未初始化的位置上，用 fill_uninit(first, last) 构造，两者都按新元素的末尾对齐
+    template <class T, size_t N>
+    template <class FillUninit, class FillAssign>
+    typename static_vector<T, N>::iterator
+    static_vector<T, N>::open_gap(iterator pos, size_type n, FillUninit fill_uninit, FillAssign fill_assign)
+    {
+        STATIC_VECTOR_CHECK(n > N - size(), "static_vector<T>'s size too big");
+        if (n == 0)
+        {
+            return pos;
+        }
+        iterator old_end = end();
+        const size_type after_elems = old_end - pos;
+        if (after_elems > n)
+        {
+            mySTL::uninitialized_move(old_end - n, old_end, old_end);
+            size_ += n;
+            mySTL::move_backward(pos, old_end - n, old_end);
+            fill_assign(pos, pos + n);
+        }
+        else
+        {
+            fill_uninit(old_end, pos + n);
+            try
+            {
+                mySTL::uninitialized_move(pos, old_end, pos + n);
+            }
+            catch (...)
+            {
+                mySTL::destroy(old_end, pos + n);
+                throw;
+            }
+            size_ += n;
+            fill_assign(pos, old_end);
+        }
+        return pos;
+    }
+
+    /*
+    重载比较符
+     */
+
+    template <class T, size_t N>
+    bool operator==(const static_vector<T, N> &lhs, const static_vector<T, N> &rhs)
+    {
+        return lhs.size() == rhs.size() &&
+               mySTL::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+
+    template <class T, size_t N>
+    bool operator<(const static_vector<T, N> &lhs, const static_vector<T, N> &rhs)
+    {
+        return mySTL::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+    template <class T, size_t N>
+    bool operator!=(const static_vector<T, N> &lhs, const static_vector<T, N> &rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    template <class T, size_t N>
+    bool operator>(const static_vector<T, N> &lhs, const static_vector<T, N> &rhs)
+    {
+        return rhs < lhs;
+    }
+
+    template <class T, size_t N>
+    bool operator<=(const static_vector<T, N> &lhs, const static_vector<T, N> &rhs)
+    {
+        return !(rhs < lhs);
+    }
+
+    template <class T, size_t N>
+    bool operator>=(const static_vector<T, N> &lhs, const static_vector<T, N> &rhs)
+    {
+        return !(lhs < rhs);
+    }
+
+    // 重载 mySTL 的 swap
+    template <class T, size_t N>
+    void swap(static_vector<T, N> &lhs, static_vector<T, N> &rhs)
+    {
+        lhs.swap(rhs);
+    }
+
+    // static_vector 不保存指向自身的指针，元素可以按字节搬移时整个对象也可以
+    template <class T, size_t N>
+    struct is_trivially_relocatable<static_vector<T, N>> : is_trivially_relocatable<T> {};
+
+}
+
+#undef STATIC_VECTOR_CHECK
+
+#endif // !MYSTL_STATIC_VECTOR_H_
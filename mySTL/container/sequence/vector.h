@@ -34,30 +34,37 @@ namespace mySTL
 #undef min
 #endif // min
 
-    template <class T>
+    template <class T, class Alloc = mySTL::allocator<T>>
     class vector
+        : private mySTL::alloc_holder<typename mySTL::allocator_traits<Alloc>::template rebind_alloc<T>>
     {
+        static_assert(std::is_same<T, typename Alloc::value_type>::value,
+                      "the value_type of Alloc should be same with T");
+
     public:
         // vector 的嵌套型别定义
-        typedef mySTL::allocator<T> allocator_type;
-        typedef mySTL::allocator<T> data_allocator;
-
-        typedef typename allocator_type::value_type value_type;
-        typedef typename allocator_type::pointer pointer;
-        typedef typename allocator_type::const_pointer const_pointer;
-        typedef typename allocator_type::reference reference;
-        typedef typename allocator_type::const_reference const_reference;
-        typedef typename allocator_type::size_type size_type;
-        typedef typename allocator_type::difference_type difference_type;
+        typedef Alloc allocator_type;
+        typedef typename mySTL::allocator_traits<Alloc>::template rebind_alloc<T> data_allocator;
+        typedef mySTL::allocator_traits<data_allocator> data_traits;
+
+        typedef T value_type;
+        typedef typename data_traits::pointer pointer;
+        typedef typename data_traits::const_pointer const_pointer;
+        typedef value_type &reference;
+        typedef const value_type &const_reference;
+        typedef typename data_traits::size_type size_type;
+        typedef typename data_traits::difference_type difference_type;
 
         typedef value_type *iterator;
         typedef const value_type *const_iterator;
         typedef mySTL::reverse_iterator<iterator> reverse_iterator;
         typedef mySTL::reverse_iterator<const_iterator> const_reverse_iterator;
 
-        allocator_type get_allocator() { return data_allocator(); }
+        allocator_type get_allocator() const { return allocator_type(this->alloc_ref()); }
 
     private:
+        typedef mySTL::alloc_holder<data_allocator> alloc_base;
+
         iterator begin_; // 表示目前使用空间的头部
         iterator end_;   // 表示目前使用空间的尾部
         iterator cap_;   // 表示目前储存空间的尾部
@@ -69,31 +76,49 @@ namespace mySTL
             try_init();
         }
 
-        explicit vector(size_type n)
+        explicit vector(const allocator_type &alloc) noexcept
+            : alloc_base(data_allocator(alloc))
+        {
+            try_init();
+        }
+
+        explicit vector(size_type n, const allocator_type &alloc = allocator_type())
+            : alloc_base(data_allocator(alloc))
         {
             fill_init(n, value_type());
         }
 
-        vector(size_type n, const value_type &value)
+        vector(size_type n, const value_type &value,
+               const allocator_type &alloc = allocator_type())
+            : alloc_base(data_allocator(alloc))
         {
             fill_init(n, value);
         }
 
         template <class Iter, typename std::enable_if<
                                   mySTL::is_input_iterator<Iter>::value, int>::type = 0>
-        vector(Iter first, Iter last)
+        vector(Iter first, Iter last, const allocator_type &alloc = allocator_type())
+            : alloc_base(data_allocator(alloc))
         {
             MYSTL_DEBUG(!(last < first));
             range_init(first, last);
         }
 
         vector(const vector &rhs)
+            : alloc_base(data_traits::select_on_container_copy_construction(rhs.alloc_ref()))
+        {
+            range_init(rhs.begin_, rhs.end_);
+        }
+
+        vector(const vector &rhs, const allocator_type &alloc)
+            : alloc_base(data_allocator(alloc))
         {
             range_init(rhs.begin_, rhs.end_);
         }
 
         vector(vector &&rhs) noexcept
-            : begin_(rhs.begin_),
+            : alloc_base(mySTL::move(rhs.alloc_ref())),
+              begin_(rhs.begin_),
               end_(rhs.end_),
               cap_(rhs.cap_)
         {
@@ -102,17 +127,23 @@ namespace mySTL
             rhs.cap_ = nullptr;
         }
 
-        vector(std::initializer_list<value_type> ilist)
+        vector(vector &&rhs, const allocator_type &alloc);
+
+        vector(std::initializer_list<value_type> ilist,
+               const allocator_type &alloc = allocator_type())
+            : alloc_base(data_allocator(alloc))
         {
             range_init(ilist.begin(), ilist.end());
         }
 
         vector &operator=(const vector &rhs);
-        vector &operator=(vector &&rhs) noexcept;
+        vector &operator=(vector &&rhs) noexcept(
+            data_traits::propagate_on_container_move_assignment::value ||
+            data_traits::is_always_equal::value);
 
         vector &operator=(std::initializer_list<value_type> ilist)
         {
-            vector tmp(ilist.begin(), ilist.end());
+            vector tmp(ilist.begin(), ilist.end(), get_allocator());
             swap(tmp);
             return *this;
         }
@@ -187,7 +218,7 @@ namespace mySTL
         }
         size_type max_size() const noexcept
         {
-            return static_cast<size_type>(-1) / sizeof(T);
+            return data_traits::max_size(this->alloc_ref());
         }
         size_type capacity() const noexcept
         {
@@ -313,6 +344,14 @@ namespace mySTL
         void resize(size_type new_size) { return resize(new_size, value_type()); }
         void resize(size_type new_size, const value_type &value);
 
+        // 新增的元素只做默认初始化：平凡类型的元素不清零，留给调用者随后写入，省去一遍内存写
+        void resize_default_init(size_type new_size);
+
+        // 在尾部预留 n 个默认初始化的元素，交给 writer(p, n) 写入，
+        // writer 返回实际写入的个数 m (m <= n)，容器只保留前 m 个
+        template <class Writer>
+        void reserve_and_append(size_type n, Writer writer);
+
         void reverse() { mySTL::reverse(begin(), end()); }
 
         // swap
@@ -332,6 +371,10 @@ namespace mySTL
 
         void destroy_and_recover(iterator first, iterator last, size_type n);
 
+        // move assign
+        void move_assign(vector &rhs, m_true_type) noexcept;
+        void move_assign(vector &rhs, m_false_type);
+
         // calculate the growth size
         size_type get_new_cap(size_type add_size);
 
@@ -351,79 +394,132 @@ namespace mySTL
         void reallocate_emplace(iterator pos, Args &&...args);
         void reallocate_insert(iterator pos, const value_type &value);
 
+        // 元素可以按字节搬移且分配器支持 reallocate（如大页分配器的 mremap）时，尾部增长可以原地调整空间
+        typedef m_intergral_constant<bool, is_trivially_relocatable<T>::value &&
+                alloc_has_reallocate<data_allocator>::value> grow_in_place;
+
+        template <class Fill>
+        void reallocate_around(iterator pos, size_type n, size_type new_cap, Fill fill);
+        bool try_grow_in_place(size_type new_cap, m_true_type);
+        bool try_grow_in_place(size_type, m_false_type) { return false; }
+        void relocate_around(iterator pos, iterator new_begin, size_type n,
+                             size_type new_cap, m_true_type) noexcept;
+        void relocate_around(iterator pos, iterator new_begin, size_type n,
+                             size_type new_cap, m_false_type);
+
         // insert
 
         iterator fill_insert(iterator pos, size_type n, const value_type &value);
         template <class IIter>
         void copy_insert(iterator pos, IIter first, IIter last);
 
+        // default initialize
+
+        typedef m_intergral_constant<bool, std::is_trivially_default_constructible<T>::value> trivial_default_init;
+
+        void default_init_n(iterator, size_type, m_true_type) noexcept {}
+        void default_init_n(iterator first, size_type n, m_false_type);
+        void append_default_init(size_type n);
+
         // shrink_to_fit
 
         void reinsert(size_type size);
     };
 
-    template <class T>
-    vector<T> &vector<T>::operator=(const vector &rhs)
+    // 使用指定的分配器移动构造，分配器不相等时逐个移动元素
+    template <class T, class Alloc>
+    vector<T, Alloc>::vector(vector &&rhs, const allocator_type &alloc)
+        : alloc_base(data_allocator(alloc))
+    {
+        if (mySTL::alloc_equal(this->alloc_ref(), rhs.alloc_ref()))
+        {
+            begin_ = rhs.begin_;
+            end_ = rhs.end_;
+            cap_ = rhs.cap_;
+            rhs.begin_ = nullptr;
+            rhs.end_ = nullptr;
+            rhs.cap_ = nullptr;
+        }
+        else
+        {
+            const size_type len = rhs.size();
+            init_space(len, mySTL::max(len, static_cast<size_type>(16)));
+            try
+            {
+                data_traits::uninitialized_move(this->alloc_ref(), rhs.begin_, rhs.end_, begin_);
+            }
+            catch (...)
+            {
+                data_traits::deallocate(this->alloc_ref(), begin_, cap_ - begin_);
+                throw;
+            }
+        }
+    }
+
+    // 复制赋值操作符
+    template <class T, class Alloc>
+    vector<T, Alloc> &vector<T, Alloc>::operator=(const vector &rhs)
     {
         if (this != &rhs)
         {
+            if (data_traits::propagate_on_container_copy_assignment::value &&
+                !mySTL::alloc_equal(this->alloc_ref(), rhs.alloc_ref()))
+            { // 旧空间必须由原来的分配器释放
+                destroy_and_recover(begin_, end_, cap_ - begin_);
+                begin_ = end_ = cap_ = nullptr;
+            }
+            mySTL::alloc_copy_assign(this->alloc_ref(), rhs.alloc_ref(),
+                                     typename data_traits::propagate_on_container_copy_assignment{});
             const auto len = rhs.size();
             if (len > capacity())
             {
-                vector tmp(rhs.begin(), rhs.end());
+                vector tmp(rhs.begin(), rhs.end(), get_allocator());
                 swap(tmp);
             }
             else if (size() >= len)
             {
                 auto i = mySTL::copy(rhs.begin(), rhs.end(), begin());
-                data_allocator::destroy(i, end_);
+                data_traits::destroy(this->alloc_ref(), i, end_);
                 end_ = begin_ + len;
             }
             else
             {
                 mySTL::copy(rhs.begin(), rhs.begin() + size(), begin_);
-                mySTL::uninitialized_copy(rhs.begin() + size(), rhs.end(), end_);
-                cap_ = end_ = begin_ + len;
+                data_traits::uninitialized_copy(this->alloc_ref(), rhs.begin() + size(), rhs.end(), end_);
+                end_ = begin_ + len;
             }
         }
         return *this;
     }
 
     // 移动赋值操作符
-    template <class T>
-    vector<T> &vector<T>::operator=(vector &&rhs) noexcept
+    template <class T, class Alloc>
+    vector<T, Alloc> &vector<T, Alloc>::operator=(vector &&rhs) noexcept(
+        data_traits::propagate_on_container_move_assignment::value ||
+        data_traits::is_always_equal::value)
     {
-        destroy_and_recover(begin_, end_, cap_ - begin_);
-        begin_ = rhs.begin_;
-        end_ = rhs.end_;
-        cap_ = rhs.cap_;
-        rhs.begin_ = nullptr;
-        rhs.end_ = nullptr;
-        rhs.cap_ = nullptr;
+        if (this != &rhs)
+        {
+            move_assign(rhs, typename data_traits::propagate_on_container_move_assignment{});
+        }
         return *this;
     }
 
     // 预留空间大小，当原容量小于要求大小时，才会重新分配
-    template <class T>
-    void vector<T>::reserve(size_type n)
+    template <class T, class Alloc>
+    void vector<T, Alloc>::reserve(size_type n)
     {
         if (capacity() < n)
         {
             THROW_LENGTH_ERROR_IF(n > max_size(),
                                   "n can not larger than max_size() in vector<T>::reserve(n)");
-            const auto old_size = size();
-            auto tmp = data_allocator::allocate(n);
-            mySTL::uninitialized_move(begin_, end_, tmp);
-            data_allocator::deallocate(begin_, cap_ - begin_);
-            begin_ = tmp;
-            end_ = tmp + old_size;
-            cap_ = begin_ + n;
+            reallocate_around(end_, 0, n, [](iterator) {});
         }
     }
 
     // 放弃多余的容量
-    template <class T>
-    void vector<T>::shrink_to_fit()
+    template <class T, class Alloc>
+    void vector<T, Alloc>::shrink_to_fit()
     {
         if (end_ < cap_)
         {
@@ -432,23 +528,23 @@ namespace mySTL
     }
 
     // 在 pos 位置就地构造元素，避免额外的复制或移动开销
-    template <class T>
+    template <class T, class Alloc>
     template <class... Args>
-    typename vector<T>::iterator
-    vector<T>::emplace(const_iterator pos, Args &&...args)
+    typename vector<T, Alloc>::iterator
+    vector<T, Alloc>::emplace(const_iterator pos, Args &&...args)
     {
         MYSTL_DEBUG(pos >= begin() && pos <= end());
         iterator xpos = const_cast<iterator>(pos);
         const size_type n = xpos - begin_;
         if (end_ != cap_ && xpos == end_)
         {
-            data_allocator::construct(mySTL::address_of(*end_), mySTL::forward<Args>(args)...);
+            data_traits::construct(this->alloc_ref(), mySTL::address_of(*end_), mySTL::forward<Args>(args)...);
             ++end_;
         }
         else if (end_ != cap_)
         {
             auto new_end = end_;
-            data_allocator::construct(mySTL::address_of(*end_), *(end_ - 1));
+            data_traits::construct(this->alloc_ref(), mySTL::address_of(*end_), *(end_ - 1));
             ++new_end;
             mySTL::copy_backward(xpos, end_ - 1, end_);
             *xpos = value_type(mySTL::forward<Args>(args)...);
@@ -462,13 +558,13 @@ namespace mySTL
     }
 
     // 在尾部就地构造元素，避免额外的复制或移动开销
-    template <class T>
+    template <class T, class Alloc>
     template <class... Args>
-    void vector<T>::emplace_back(Args &&...args)
+    void vector<T, Alloc>::emplace_back(Args &&...args)
     {
         if (end_ < cap_)
         {
-            data_allocator::construct(mySTL::address_of(*end_), mySTL::forward<Args>(args)...);
+            data_traits::construct(this->alloc_ref(), mySTL::address_of(*end_), mySTL::forward<Args>(args)...);
             ++end_;
         }
         else
@@ -478,12 +574,12 @@ namespace mySTL
     }
 
     // 在尾部插入元素
-    template <class T>
-    void vector<T>::push_back(const value_type &value)
+    template <class T, class Alloc>
+    void vector<T, Alloc>::push_back(const value_type &value)
     {
         if (end_ != cap_)
         {
-            data_allocator::construct(mySTL::address_of(*end_), value);
+            data_traits::construct(this->alloc_ref(), mySTL::address_of(*end_), value);
             ++end_;
         }
         else
@@ -493,31 +589,31 @@ namespace mySTL
     }
 
     // 弹出尾部元素
-    template <class T>
-    void vector<T>::pop_back()
+    template <class T, class Alloc>
+    void vector<T, Alloc>::pop_back()
     {
         MYSTL_DEBUG(!empty());
-        data_allocator::destroy(end_ - 1);
+        data_traits::destroy(this->alloc_ref(), end_ - 1);
         --end_;
     }
 
     // 在 pos 处插入元素
-    template <class T>
-    typename vector<T>::iterator
-    vector<T>::insert(const_iterator pos, const value_type &value)
+    template <class T, class Alloc>
+    typename vector<T, Alloc>::iterator
+    vector<T, Alloc>::insert(const_iterator pos, const value_type &value)
     {
         MYSTL_DEBUG(pos >= begin() && pos <= end());
         iterator xpos = const_cast<iterator>(pos);
         const size_type n = pos - begin_;
         if (end_ != cap_ && xpos == end_)
         {
-            data_allocator::construct(mySTL::address_of(*end_), value);
+            data_traits::construct(this->alloc_ref(), mySTL::address_of(*end_), value);
             ++end_;
         }
         else if (end_ != cap_)
         {
             auto new_end = end_;
-            data_allocator::construct(mySTL::address_of(*end_), *(end_ - 1));
+            data_traits::construct(this->alloc_ref(), mySTL::address_of(*end_), *(end_ - 1));
             ++new_end;
             auto value_copy = value; // 避免元素因以下复制操作而被改变
             mySTL::copy_backward(xpos, end_ - 1, end_);
@@ -532,34 +628,34 @@ namespace mySTL
     }
 
     // 删除 pos 位置上的元素
-    template <class T>
-    typename vector<T>::iterator
-    vector<T>::erase(const_iterator pos)
+    template <class T, class Alloc>
+    typename vector<T, Alloc>::iterator
+    vector<T, Alloc>::erase(const_iterator pos)
     {
         MYSTL_DEBUG(pos >= begin() && pos < end());
         iterator xpos = begin_ + (pos - begin());
         mySTL::move(xpos + 1, end_, xpos);
-        data_allocator::destroy(end_ - 1);
+        data_traits::destroy(this->alloc_ref(), end_ - 1);
         --end_;
         return xpos;
     }
 
     // 删除[first, last)上的元素
-    template <class T>
-    typename vector<T>::iterator
-    vector<T>::erase(const_iterator first, const_iterator last)
+    template <class T, class Alloc>
+    typename vector<T, Alloc>::iterator
+    vector<T, Alloc>::erase(const_iterator first, const_iterator last)
     {
         MYSTL_DEBUG(first >= begin() && last <= end() && !(last < first));
         const auto n = first - begin();
         iterator r = begin_ + (first - begin());
-        data_allocator::destroy(mySTL::move(r + (last - first), end_, r), end_);
+        data_traits::destroy(this->alloc_ref(), mySTL::move(r + (last - first), end_, r), end_);
         end_ = end_ - (last - first);
         return begin_ + n;
     }
 
     // 重置容器大小
-    template <class T>
-    void vector<T>::resize(size_type new_size, const value_type &value)
+    template <class T, class Alloc>
+    void vector<T, Alloc>::resize(size_type new_size, const value_type &value)
     {
         if (new_size < size())
         {
@@ -571,12 +667,55 @@ namespace mySTL
         }
     }
 
+    // 重置容器大小，新增的元素只做默认初始化
+    template <class T, class Alloc>
+    void vector<T, Alloc>::resize_default_init(size_type new_size)
+    {
+        if (new_size < size())
+        {
+            erase(begin() + new_size, end());
+        }
+        else
+        {
+            append_default_init(new_size - size());
+        }
+    }
+
+    // 在尾部预留 n 个元素交给 writer 写入，writer 抛出异常时容器的元素保持不变
+    template <class T, class Alloc>
+    template <class Writer>
+    void vector<T, Alloc>::reserve_and_append(size_type n, Writer writer)
+    {
+        if (static_cast<size_type>(cap_ - end_) < n)
+        {
+            reallocate_around(end_, 0, get_new_cap(n), [](iterator) {});
+        }
+        default_init_n(end_, n, trivial_default_init{});
+        size_type written = 0;
+        try
+        {
+            written = writer(end_, n);
+        }
+        catch (...)
+        {
+            data_traits::destroy(this->alloc_ref(), end_, end_ + n);
+            throw;
+        }
+        MYSTL_DEBUG(written <= n);
+        data_traits::destroy(this->alloc_ref(), end_ + written, end_ + n);
+        end_ += written;
+    }
+
     // 与另一个 vector 交换
-    template <class T>
-    void vector<T>::swap(vector<T> &rhs) noexcept
+    template <class T, class Alloc>
+    void vector<T, Alloc>::swap(vector<T, Alloc> &rhs) noexcept
     {
         if (this != &rhs)
         {
+            MYSTL_DEBUG(data_traits::propagate_on_container_swap::value ||
+                        mySTL::alloc_equal(this->alloc_ref(), rhs.alloc_ref()));
+            mySTL::alloc_swap(this->alloc_ref(), rhs.alloc_ref(),
+                              typename data_traits::propagate_on_container_swap{});
             mySTL::swap(begin_, rhs.begin_);
             mySTL::swap(end_, rhs.end_);
             mySTL::swap(cap_, rhs.cap_);
@@ -588,12 +727,12 @@ namespace mySTL
      */
 
     // try_init 函数，若分配失败则忽略，不抛出异常
-    template <class T>
-    void vector<T>::try_init() noexcept
+    template <class T, class Alloc>
+    void vector<T, Alloc>::try_init() noexcept
     {
         try
         {
-            begin_ = data_allocator::allocate(16);
+            begin_ = data_traits::allocate(this->alloc_ref(), 16);
             end_ = begin_;
             cap_ = begin_ + 16;
         }
@@ -606,12 +745,12 @@ namespace mySTL
     }
 
     // init_space 函数
-    template <class T>
-    void vector<T>::init_space(size_type size, size_type cap)
+    template <class T, class Alloc>
+    void vector<T, Alloc>::init_space(size_type size, size_type cap)
     {
         try
         {
-            begin_ = data_allocator::allocate(cap);
+            begin_ = data_traits::allocate(this->alloc_ref(), cap);
             end_ = begin_ + size;
             cap_ = begin_ + cap;
         }
@@ -625,40 +764,92 @@ namespace mySTL
     }
 
     // fill_init 函数
-    template <class T>
-    void vector<T>::
+    template <class T, class Alloc>
+    void vector<T, Alloc>::
         fill_init(size_type n, const value_type &value)
     {
         const size_type init_size = mySTL::max(static_cast<size_type>(16), n);
         init_space(n, init_size);
-        mySTL::uninitialized_fill_n(begin_, n, value);
+        data_traits::uninitialized_fill_n(this->alloc_ref(), begin_, n, value);
     }
 
     // range_init 函数
-    template <class T>
+    template <class T, class Alloc>
     template <class Iter>
-    void vector<T>::
+    void vector<T, Alloc>::
         range_init(Iter first, Iter last)
     {
         const size_type len = mySTL::distance(first, last);
         const size_type init_size = mySTL::max(len, static_cast<size_type>(16));
         init_space(len, init_size);
-        mySTL::uninitialized_copy(first, last, begin_);
+        data_traits::uninitialized_copy(this->alloc_ref(), first, last, begin_);
     }
 
     // destroy_and_recover 函数
-    template <class T>
-    void vector<T>::
+    template <class T, class Alloc>
+    void vector<T, Alloc>::
         destroy_and_recover(iterator first, iterator last, size_type n)
     {
-        data_allocator::destroy(first, last);
-        data_allocator::deallocate(first, n);
+        if (first != nullptr)
+        {
+            data_traits::destroy(this->alloc_ref(), first, last);
+            data_traits::deallocate(this->alloc_ref(), first, n);
+        }
+    }
+
+    // move_assign 函数
+    // 分配器随容器传播或总是相等时，直接接管 rhs 的空间
+    template <class T, class Alloc>
+    void vector<T, Alloc>::move_assign(vector &rhs, m_true_type) noexcept
+    {
+        destroy_and_recover(begin_, end_, cap_ - begin_);
+        mySTL::alloc_move_assign(this->alloc_ref(), rhs.alloc_ref(),
+                                 typename data_traits::propagate_on_container_move_assignment{});
+        begin_ = rhs.begin_;
+        end_ = rhs.end_;
+        cap_ = rhs.cap_;
+        rhs.begin_ = nullptr;
+        rhs.end_ = nullptr;
+        rhs.cap_ = nullptr;
+    }
+
+    // 分配器不传播时，只有两者相等才能接管空间，否则逐个移动元素
+    template <class T, class Alloc>
+    void vector<T, Alloc>::move_assign(vector &rhs, m_false_type)
+    {
+        if (mySTL::alloc_equal(this->alloc_ref(), rhs.alloc_ref()))
+        {
+            move_assign(rhs, m_true_type{});
+        }
+        else
+        {
+            const size_type len = rhs.size();
+            if (len > capacity())
+            {
+                vector tmp(mySTL::move(rhs), get_allocator());
+                swap(tmp);
+            }
+            else
+            {
+                auto mid = mySTL::move(rhs.begin_, rhs.begin_ + mySTL::min(size(), len), begin_);
+                if (size() >= len)
+                {
+                    data_traits::destroy(this->alloc_ref(), mid, end_);
+                }
+                else
+                {
+                    data_traits::uninitialized_move(this->alloc_ref(), rhs.begin_ + size(), rhs.end_, end_);
+                }
+                end_ = begin_ + len;
+            }
+            rhs.clear();
+        }
     }
 
     // get_new_cap 函数
-    template <class T>
-    typename vector<T>::size_type
-    vector<T>::
+    template <class T, class Alloc>
+    typename vector<T, Alloc>::size_type
+    vector<T, Alloc>::
         get_new_cap(size_type add_size)
     {
         const auto old_size = capacity();
@@ -677,30 +868,30 @@ namespace mySTL
     }
 
     // fill_assign 函数
-    template <class T>
-    void vector<T>::
+    template <class T, class Alloc>
+    void vector<T, Alloc>::
         fill_assign(size_type n, const value_type &value)
     {
         if (n > capacity())
         {
-            vector tmp(n, value);
+            vector tmp(n, value, get_allocator());
             swap(tmp);
         }
         else if (n > size())
         {
             mySTL::fill(begin(), end(), value);
-            end_ = mySTL::uninitialized_fill_n(end_, n - size(), value);
+            end_ = data_traits::uninitialized_fill_n(this->alloc_ref(), end_, n - size(), value);
         }
         else
         {
-            erase(mySTL::fill(begin_, n, value), end_);
+            erase(mySTL::fill_n(begin_, n, value), end_);
         }
     }
 
     // copy_assign 函数
-    template <class T>
+    template <class T, class Alloc>
     template <class IIter>
-    void vector<T>::
+    void vector<T, Alloc>::
         copy_assign(IIter first, IIter last, input_iterator_tag)
     {
         auto cur = begin_;
@@ -719,20 +910,20 @@ namespace mySTL
     }
 
     // 用 [first, last) 为容器赋值
-    template <class T>
+    template <class T, class Alloc>
     template <class FIter>
-    void vector<T>::copy_assign(FIter first, FIter last, forward_iterator_tag)
+    void vector<T, Alloc>::copy_assign(FIter first, FIter last, forward_iterator_tag)
     {
         const size_type len = mySTL::distance(first, last);
         if (len > capacity())
         {
-            vector tmp(first, last);
+            vector tmp(first, last, get_allocator());
             swap(tmp);
         }
         else if (size() >= len)
         {
             auto new_end = mySTL::copy(first, last, begin_);
-            data_allocator::destroy(new_end, end_);
+            data_traits::destroy(this->alloc_ref(), new_end, end_);
             end_ = new_end;
         }
         else
@@ -740,68 +931,182 @@ namespace mySTL
             auto mid = first;
             mySTL::advance(mid, size());
             mySTL::copy(first, mid, begin_);
-            auto new_end = mySTL::uninitialized_copy(mid, last, end_);
+            auto new_end = data_traits::uninitialized_copy(this->alloc_ref(), mid, last, end_);
             end_ = new_end;
         }
     }
 
     // 重新分配空间并在 pos 处就地构造元素
-    template <class T>
+    template <class T, class Alloc>
     template <class... Args>
-    void vector<T>::
+    void vector<T, Alloc>::
         reallocate_emplace(iterator pos, Args &&...args)
     {
-        const auto new_size = get_new_cap(1);
-        auto new_begin = data_allocator::allocate(new_size);
-        auto new_end = new_begin;
+        if (grow_in_place::value && pos == end_)
+        {
+            // 空间可能被移到新的地址，而参数可能引用容器中的元素，因此先构造好新元素
+            value_type tmp(mySTL::forward<Args>(args)...);
+            reallocate_around(pos, 1, get_new_cap(1), [&](iterator p)
+            {
+                data_traits::construct(this->alloc_ref(), mySTL::address_of(*p), mySTL::move(tmp));
+            });
+            return;
+        }
+        reallocate_around(pos, 1, get_new_cap(1), [&](iterator p)
+        {
+            data_traits::construct(this->alloc_ref(), mySTL::address_of(*p), mySTL::forward<Args>(args)...);
+        });
+    }
+
+    // 重新分配空间并在 pos 处插入元素
+    template <class T, class Alloc>
+    void vector<T, Alloc>::reallocate_insert(iterator pos, const value_type &value)
+    {
+        if (grow_in_place::value && pos == end_)
+        {
+            value_type tmp(value);
+            reallocate_around(pos, 1, get_new_cap(1), [&](iterator p)
+            {
+                data_traits::construct(this->alloc_ref(), mySTL::address_of(*p), mySTL::move(tmp));
+            });
+            return;
+        }
+        reallocate_around(pos, 1, get_new_cap(1), [&](iterator p)
+        {
+            data_traits::construct(this->alloc_ref(), mySTL::address_of(*p), value);
+        });
+    }
+
+    // 非平凡类型的元素仍然通过分配器逐个构造，失败时销毁已构造的元素
+    template <class T, class Alloc>
+    void vector<T, Alloc>::default_init_n(iterator first, size_type n, m_false_type)
+    {
+        auto cur = first;
         try
         {
-            new_end = mySTL::uninitialized_move(begin_, pos, new_begin);
-            data_allocator::construct(mySTL::address_of(*new_end), mySTL::forward<Args>(args)...);
-            ++new_end;
-            new_end = mySTL::uninitialized_move(pos, end_, new_end);
+            for (; n > 0; --n, ++cur)
+            {
+                data_traits::construct(this->alloc_ref(), mySTL::address_of(*cur));
+            }
         }
         catch (...)
         {
-            data_allocator::deallocate(new_begin, new_size);
+            data_traits::destroy(this->alloc_ref(), first, cur);
             throw;
         }
-        destroy_and_recover(begin_, end_, cap_ - begin_);
+    }
+
+    // 在尾部添加 n 个默认初始化的元素
+    template <class T, class Alloc>
+    void vector<T, Alloc>::append_default_init(size_type n)
+    {
+        if (static_cast<size_type>(cap_ - end_) >= n)
+        {
+            default_init_n(end_, n, trivial_default_init{});
+            end_ += n;
+            return;
+        }
+        reallocate_around(end_, n, get_new_cap(n), [&](iterator p)
+        {
+            default_init_n(p, n, trivial_default_init{});
+        });
+    }
+
+    // 重新分配 new_cap 大小的空间，先由 fill 在新空间中 pos 对应的位置构造 n 个新元素，
+    // 再把 [begin_, pos) 与 [pos, end_) 搬到新元素的两侧
+    // 新元素先于搬移构造，因此 value 可以引用容器中的元素；fill 抛出异常时容器保持不变
+    // 在尾部增长且分配器能原地调整空间时，不再分配新空间和搬移元素
+    template <class T, class Alloc>
+    template <class Fill>
+    void vector<T, Alloc>::
+        reallocate_around(iterator pos, size_type n, size_type new_cap, Fill fill)
+    {
+        if (pos == end_ && try_grow_in_place(new_cap, grow_in_place{}))
+        {
+            fill(end_);
+            end_ += n;
+            return;
+        }
+        auto new_begin = data_traits::allocate(this->alloc_ref(), new_cap);
+        const size_type old_size = size();
+        try
+        {
+            fill(new_begin + (pos - begin_));
+        }
+        catch (...)
+        {
+            data_traits::deallocate(this->alloc_ref(), new_begin, new_cap);
+            throw;
+        }
+        relocate_around(pos, new_begin, n, new_cap, is_trivially_relocatable<T>{});
         begin_ = new_begin;
-        end_ = new_end;
-        cap_ = new_begin + new_size;
+        end_ = new_begin + old_size + n;
+        cap_ = new_begin + new_cap;
     }
 
-    // 重新分配空间并在 pos 处插入元素
-    template <class T>
-    void vector<T>::reallocate_insert(iterator pos, const value_type &value)
+    // 通过分配器的 reallocate 调整空间，失败时返回 false，原空间保持不变
+    template <class T, class Alloc>
+    bool vector<T, Alloc>::try_grow_in_place(size_type new_cap, m_true_type)
+    {
+        if (begin_ == nullptr)
+        {
+            return false;
+        }
+        const auto old_size = size();
+        auto p = data_traits::reallocate(this->alloc_ref(), begin_, cap_ - begin_, new_cap);
+        if (p == nullptr)
+        {
+            return false;
+        }
+        begin_ = p;
+        end_ = p + old_size;
+        cap_ = p + new_cap;
+        return true;
+    }
+
+    // 可以按字节搬移的元素：两次 memcpy，原空间只释放不析构
+    template <class T, class Alloc>
+    void vector<T, Alloc>::
+        relocate_around(iterator pos, iterator new_begin, size_type n, size_type, m_true_type) noexcept
     {
-        const auto new_size = get_new_cap(1);
-        auto new_begin = data_allocator::allocate(new_size);
-        auto new_end = new_begin;
-        const value_type &value_copy = value;
+        auto new_pos = mySTL::uninitialized_relocate(begin_, pos, new_begin);
+        mySTL::uninitialized_relocate(pos, end_, new_pos + n);
+        data_traits::deallocate(this->alloc_ref(), begin_, cap_ - begin_);
+    }
+
+    // 其他元素：逐个移动构造，失败时销毁新空间中已构造的元素并释放新空间
+    template <class T, class Alloc>
+    void vector<T, Alloc>::
+        relocate_around(iterator pos, iterator new_begin, size_type n, size_type new_cap, m_false_type)
+    {
+        auto new_pos = new_begin + (pos - begin_);
         try
         {
-            new_end = mySTL::uninitialized_move(begin_, pos, new_begin);
-            data_allocator::construct(mySTL::address_of(*new_end), value_copy);
-            ++new_end;
-            new_end = mySTL::uninitialized_move(pos, end_, new_end);
+            data_traits::uninitialized_move(this->alloc_ref(), begin_, pos, new_begin);
         }
         catch (...)
         {
-            data_allocator::deallocate(new_begin, new_size);
+            data_traits::destroy(this->alloc_ref(), new_pos, new_pos + n);
+            data_traits::deallocate(this->alloc_ref(), new_begin, new_cap);
+            throw;
+        }
+        try
+        {
+            data_traits::uninitialized_move(this->alloc_ref(), pos, end_, new_pos + n);
+        }
+        catch (...)
+        {
+            data_traits::destroy(this->alloc_ref(), new_begin, new_pos + n);
+            data_traits::deallocate(this->alloc_ref(), new_begin, new_cap);
             throw;
         }
         destroy_and_recover(begin_, end_, cap_ - begin_);
-        begin_ = new_begin;
-        end_ = new_end;
-        cap_ = new_begin + new_size;
     }
 
     // fill_insert 函数
-    template <class T>
-    typename vector<T>::iterator
-    vector<T>::fill_insert(iterator pos, size_type n, const value_type &value)
+    template <class T, class Alloc>
+    typename vector<T, Alloc>::iterator
+    vector<T, Alloc>::fill_insert(iterator pos, size_type n, const value_type &value)
     {
         if (n == 0)
             return pos;
@@ -813,46 +1118,32 @@ namespace mySTL
             auto old_end = end_;
             if (after_elems > n)
             {
-                mySTL::uninitialized_copy(end_ - n, end_, end_);
+                data_traits::uninitialized_copy(this->alloc_ref(), end_ - n, end_, end_);
                 end_ += n;
                 mySTL::move_backward(pos, old_end - n, old_end);
-                mySTL::uninitialized_fill_n(pos, n, value_copy);
+                data_traits::uninitialized_fill_n(this->alloc_ref(), pos, n, value_copy);
             }
             else
             {
-                end_ = mySTL::uninitialized_fill_n(end_, n - after_elems, value_copy);
-                end_ = mySTL::uninitialized_move(pos, old_end, end_);
-                mySTL::uninitialized_fill_n(pos, after_elems, value_copy);
+                end_ = data_traits::uninitialized_fill_n(this->alloc_ref(), end_, n - after_elems, value_copy);
+                end_ = data_traits::uninitialized_move(this->alloc_ref(), pos, old_end, end_);
+                data_traits::uninitialized_fill_n(this->alloc_ref(), pos, after_elems, value_copy);
             }
         }
         else
         { // 如果备用空间不足
-            const auto new_size = get_new_cap(n);
-            auto new_begin = data_allocator::allocate(new_size);
-            auto new_end = new_begin;
-            try
+            reallocate_around(pos, n, get_new_cap(n), [&](iterator p)
             {
-                new_end = mySTL::uninitialized_move(begin_, pos, new_begin);
-                new_end = mySTL::uninitialized_fill_n(new_end, n, value);
-                new_end = mySTL::uninitialized_move(pos, end_, new_end);
-            }
-            catch (...)
-            {
-                destroy_and_recover(new_begin, new_end, new_size);
-                throw;
-            }
-            data_allocator::deallocate(begin_, cap_ - begin_);
-            begin_ = new_begin;
-            end_ = new_end;
-            cap_ = begin_ + new_size;
+                data_traits::uninitialized_fill_n(this->alloc_ref(), p, n, value_copy);
+            });
         }
         return begin_ + xpos;
     }
 
     // copy_insert 函数
-    template <class T>
+    template <class T, class Alloc>
     template <class IIter>
-    void vector<T>::
+    void vector<T, Alloc>::
         copy_insert(iterator pos, IIter first, IIter last)
     {
         if (first == last)
@@ -864,110 +1155,90 @@ namespace mySTL
             auto old_end = end_;
             if (after_elems > n)
             {
-                end_ = mySTL::uninitialized_copy(end_ - n, end_, end_);
+                end_ = data_traits::uninitialized_copy(this->alloc_ref(), end_ - n, end_, end_);
                 mySTL::move_backward(pos, old_end - n, old_end);
-                mySTL::uninitialized_copy(first, last, pos);
+                data_traits::uninitialized_copy(this->alloc_ref(), first, last, pos);
             }
             else
             {
                 auto mid = first;
                 mySTL::advance(mid, after_elems);
-                end_ = mySTL::uninitialized_copy(mid, last, end_);
-                end_ = mySTL::uninitialized_move(pos, old_end, end_);
-                mySTL::uninitialized_copy(first, mid, pos);
+                end_ = data_traits::uninitialized_copy(this->alloc_ref(), mid, last, end_);
+                end_ = data_traits::uninitialized_move(this->alloc_ref(), pos, old_end, end_);
+                data_traits::uninitialized_copy(this->alloc_ref(), first, mid, pos);
             }
         }
         else
         { // 备用空间不足
-            const auto new_size = get_new_cap(n);
-            auto new_begin = data_allocator::allocate(new_size);
-            auto new_end = new_begin;
-            try
-            {
-                new_end = mySTL::uninitialized_move(begin_, pos, new_begin);
-                new_end = mySTL::uninitialized_copy(first, last, new_end);
-                new_end = mySTL::uninitialized_move(pos, end_, new_end);
-            }
-            catch (...)
+            reallocate_around(pos, static_cast<size_type>(n), get_new_cap(n), [&](iterator p)
             {
-                destroy_and_recover(new_begin, new_end, new_size);
-                throw;
-            }
-            data_allocator::deallocate(begin_, cap_ - begin_);
-            begin_ = new_begin;
-            end_ = new_end;
-            cap_ = begin_ + new_size;
+                data_traits::uninitialized_copy(this->alloc_ref(), first, last, p);
+            });
         }
     }
 
     // reinsert 函数
-    template <class T>
-    void vector<T>::reinsert(size_type size)
+    template <class T, class Alloc>
+    void vector<T, Alloc>::reinsert(size_type size)
     {
-        auto new_begin = data_allocator::allocate(size);
-        try
-        {
-            mySTL::uninitialized_move(begin_, end_, new_begin);
-        }
-        catch (...)
-        {
-            data_allocator::deallocate(new_begin, size);
-            throw;
-        }
-        data_allocator::deallocate(begin_, cap_ - begin_);
-        begin_ = new_begin;
-        end_ = begin_ + size;
-        cap_ = begin_ + size;
+        reallocate_around(end_, 0, size, [](iterator) {});
     }
 
     /*
     重载比较符
      */
 
-    template <class T>
-    bool operator==(const vector<T> &lhs, const vector<T> &rhs)
+    template <class T, class Alloc>
+    bool operator==(const vector<T, Alloc> &lhs, const vector<T, Alloc> &rhs)
     {
         return lhs.size() == rhs.size() &&
                mySTL::equal(lhs.begin(), lhs.end(), rhs.begin());
     }
 
-    template <class T>
-    bool operator<(const vector<T> &lhs, const vector<T> &rhs)
+    template <class T, class Alloc>
+    bool operator<(const vector<T, Alloc> &lhs, const vector<T, Alloc> &rhs)
     {
         return mySTL::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
     }
 
-    template <class T>
-    bool operator!=(const vector<T> &lhs, const vector<T> &rhs)
+    template <class T, class Alloc>
+    bool operator!=(const vector<T, Alloc> &lhs, const vector<T, Alloc> &rhs)
     {
         return !(lhs == rhs);
     }
 
-    template <class T>
-    bool operator>(const vector<T> &lhs, const vector<T> &rhs)
+    template <class T, class Alloc>
+    bool operator>(const vector<T, Alloc> &lhs, const vector<T, Alloc> &rhs)
     {
         return rhs < lhs;
     }
 
-    template <class T>
-    bool operator<=(const vector<T> &lhs, const vector<T> &rhs)
+    template <class T, class Alloc>
+    bool operator<=(const vector<T, Alloc> &lhs, const vector<T, Alloc> &rhs)
     {
         return !(rhs < lhs);
     }
 
-    template <class T>
-    bool operator>=(const vector<T> &lhs, const vector<T> &rhs)
+    template <class T, class Alloc>
+    bool operator>=(const vector<T, Alloc> &lhs, const vector<T, Alloc> &rhs)
     {
         return !(lhs < rhs);
     }
 
     // 重载 mySTL 的 swap
-    template <class T>
-    void swap(vector<T> &lhs, vector<T> &rhs)
+    template <class T, class Alloc>
+    void swap(vector<T, Alloc> &lhs, vector<T, Alloc> &rhs)
     {
         lhs.swap(rhs);
     }
 
+    // vector 只保存指向堆上空间的指针，分配器可以按字节搬移时 vector 也可以
+    template <class T, class Alloc>
+    struct is_trivially_relocatable<vector<T, Alloc>> : is_trivially_relocatable<Alloc> {};
+
 }
 
+// vector<bool> 的偏特化
+#include "bvector.h"
+
 #endif
\ No newline at end of file
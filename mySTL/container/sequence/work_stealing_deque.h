@@ -0,0 +1,264 @@
+#ifndef MYSTL_WORK_STEALING_DEQUE_H_
+#define MYSTL_WORK_STEALING_DEQUE_H_
+
+// 这个头文件包含一个模板类 work_stealing_deque
+// work_stealing_deque : Chase-Lev 无锁工作窃取双端队列，是任务调度器的基本组件
+//   拥有者线程在底部 push / pop（后进先出，缓存友好），其他线程从顶部 steal（先进先出，偷走最早的大任务）：
+//   mySTL::work_stealing_deque<task*> q;
+//   q.push(t);                  // 拥有者线程
+//   task* x; q.try_pop(x);      // 拥有者线程
+//   task* y; q.try_steal(y);    // 其他任意线程
+
+// notes:
+//
+// 按 Lê、Pop、Cohen、Zappa Nardelli 给出的 C11 内存模型版本实现（PPoPP 2013）
+// bottom 只由拥有者修改，top 只通过 CAS 前进；只剩最后一个元素时 pop 与 steal 通过 top 上的 CAS 决出胜者
+// 元素保存在 std::atomic<T> 的环形数组中，窃取者可能读到随后被覆盖的位置，因此要求 T 可平凡复制，
+// 通常保存任务指针或下标
+// 数组满时拥有者把元素复制到容量翻倍的新数组；旧数组可能仍被窃取者读取，挂在链表上直到析构时才释放，
+// 所有数组合计不超过当前容量的两倍
+// try_steal 在队列为空或与其他线程竞争失败时返回 false
+// size() 只是一个近似值，empty() 同理
+// 构造、析构不是线程安全的，队列不能复制或移动
+
+#include <atomic>
+#include <type_traits>
+
+#include "../../allocator/aligned_allocator.h"
+#include "../../util/memory.h"
+#include "../../util/util.h"
+#include "../../util/exceptdef.h"
+
+namespace mySTL
+{
+#ifdef max
+#pragma message("#undefing marco max")
+#undef max
+#endif // max
+
+#ifdef min
+#pragma message("#undefing marco min")
+#undef min
+#endif // min
+
+    // work_stealing_deque 的环形数组，retired 指向被替换下来的旧数组
+    template <class T>
+    struct work_stealing_array
+    {
+        std::atomic<T> *slots;
+        size_t mask;
+        work_stealing_array *retired;
+
+        size_t capacity() const noexcept { return mask + 1; }
+
+        T get(ptrdiff_t i) const noexcept
+        {
+            return slots[static_cast<size_t>(i) & mask].load(std::memory_order_relaxed);
+        }
+
+        void put(ptrdiff_t i, const T &value) noexcept
+        {
+            slots[static_cast<size_t>(i) & mask].store(value, std::memory_order_relaxed);
+        }
+    };
+
+    // 模板类 work_stealing_deque
+    // 模板参数 T 代表类型，Alloc 代表分配器
+    template <class T, class Alloc = mySTL::allocator<T>>
+    class work_stealing_deque
+        : private mySTL::alloc_holder<typename mySTL::allocator_traits<Alloc>::template rebind_alloc<std::atomic<T>>>
+    {
+        static_assert(std::is_same<T, typename Alloc::value_type>::value,
+                      "the value_type of Alloc should be same with T");
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "work_stealing_deque<T> needs T to be trivially copyable");
+
+    public:
+        // work_stealing_deque 的型别定义
+        typedef Alloc allocator_type;
+        typedef work_stealing_array<T> array_type;
+        typedef typename mySTL::allocator_traits<Alloc>::template rebind_alloc<std::atomic<T>> slot_allocator;
+        typedef typename mySTL::allocator_traits<Alloc>::template rebind_alloc<array_type> array_allocator;
+        typedef mySTL::allocator_traits<slot_allocator> slot_traits;
+        typedef mySTL::allocator_traits<array_allocator> array_traits;
+
+        typedef T value_type;
+        typedef value_type &reference;
+        typedef const value_type &const_reference;
+        typedef typename slot_traits::size_type size_type;
+
+        allocator_type get_allocator() const { return allocator_type(this->alloc_ref()); }
+
+    private:
+        typedef mySTL::alloc_holder<slot_allocator> alloc_base;
+
+        // 窃取者修改的数据
+        alignas(MYSTL_CACHE_LINE_SIZE) std::atomic<ptrdiff_t> top_; // 下一个被窃取的位置
+
+        // 拥有者修改的数据
+        alignas(MYSTL_CACHE_LINE_SIZE) std::atomic<ptrdiff_t> bottom_; // 下一个 push 的位置
+        std::atomic<array_type *> array_;
+
+        char pad_[MYSTL_CACHE_LINE_SIZE - sizeof(std::atomic<ptrdiff_t>) - sizeof(std::atomic<array_type *>)];
+
+    public:
+        // 构造、析构函数
+
+        explicit work_stealing_deque(size_type capacity = 64, const allocator_type &alloc = allocator_type())
+            : alloc_base(slot_allocator(alloc)), top_(0), bottom_(0), array_(nullptr)
+        {
+            array_.store(create_array(capacity, nullptr), std::memory_order_relaxed);
+        }
+
+        work_stealing_deque(const work_stealing_deque &) = delete;
+        work_stealing_deque &operator=(const work_stealing_deque &) = delete;
+
+        ~work_stealing_deque()
+        {
+            array_type *a = array_.load(std::memory_order_relaxed);
+            while (a != nullptr)
+            {
+                array_type *next = a->retired;
+                destroy_array(a);
+                a = next;
+            }
+        }
+
+    public:
+        // 容量相关操作
+
+        size_type capacity() const noexcept
+        {
+            return array_.load(std::memory_order_relaxed)->capacity();
+        }
+        size_type size() const noexcept
+        {
+            const ptrdiff_t b = bottom_.load(std::memory_order_relaxed);
+            const ptrdiff_t t = top_.load(std::memory_order_relaxed);
+            return b > t ? static_cast<size_type>(b - t) : 0;
+        }
+        bool empty() const noexcept { return size() == 0; }
+
+        // 拥有者线程调用
+
+        void push(const value_type &value);
+        bool try_pop(value_type &out) noexcept;
+
+        // 任意线程调用
+
+        bool try_steal(value_type &out) noexcept;
+
+    private:
+        // helper functions
+
+        array_type *create_array(size_type n, array_type *retired);
+        void destroy_array(array_type *a) noexcept;
+        array_type *grow(array_type *a, ptrdiff_t top, ptrdiff_t bottom);
+    };
+
+    /*****************************************************************************************/
+
+    // 在底部放入元素，数组满时先扩容
+    template <class T, class Alloc>
+    void work_stealing_deque<T, Alloc>::push(const value_type &value)
+    {
+        const ptrdiff_t b = bottom_.load(std::memory_order_relaxed);
+        const ptrdiff_t t = top_.load(std::memory_order_acquire);
+        array_type *a = array_.load(std::memory_order_relaxed);
+        if (b - t > static_cast<ptrdiff_t>(a->mask))
+            a = grow(a, t, b);
+        a->put(b, value);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom_.store(b + 1, std::memory_order_relaxed);
+    }
+
+    // 从底部取出元素：先减小 bottom 宣告占用，再检查是否与窃取者争夺最后一个元素
+    template <class T, class Alloc>
+    bool work_stealing_deque<T, Alloc>::try_pop(value_type &out) noexcept
+    {
+        const ptrdiff_t b = bottom_.load(std::memory_order_relaxed) - 1;
+        array_type *a = array_.load(std::memory_order_relaxed);
+        bottom_.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        ptrdiff_t t = top_.load(std::memory_order_relaxed);
+        if (t > b)
+        { // 队列为空，恢复 bottom
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            return false;
+        }
+        out = a->get(b);
+        if (t < b)
+            return true;
+        // 最后一个元素：与窃取者竞争 top
+        const bool won = top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                                      std::memory_order_relaxed);
+        bottom_.store(b + 1, std::memory_order_relaxed);
+        return won;
+    }
+
+    // 从顶部窃取元素：先读出元素，再用 CAS 推进 top 确认，失败则放弃
+    template <class T, class Alloc>
+    bool work_stealing_deque<T, Alloc>::try_steal(value_type &out) noexcept
+    {
+        ptrdiff_t t = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const ptrdiff_t b = bottom_.load(std::memory_order_acquire);
+        if (t >= b)
+            return false;
+        array_type *a = array_.load(std::memory_order_acquire);
+        value_type value = a->get(t);
+        if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                          std::memory_order_relaxed))
+            return false;
+        out = value;
+        return true;
+    }
+
+    // 分配容量不小于 n 的 2 的幂的数组
+    template <class T, class Alloc>
+    typename work_stealing_deque<T, Alloc>::array_type *
+    work_stealing_deque<T, Alloc>::create_array(size_type n, array_type *retired)
+    {
+        size_type cap = 1;
+        while (cap < n)
+            cap <<= 1;
+        array_allocator array_alloc(this->alloc_ref());
+        array_type *a = array_traits::allocate(array_alloc, 1);
+        try
+        {
+            a->slots = slot_traits::allocate(this->alloc_ref(), cap);
+        }
+        catch (...)
+        {
+            array_traits::deallocate(array_alloc, a, 1);
+            throw;
+        }
+        for (size_type i = 0; i < cap; ++i)
+            ::new (static_cast<void *>(a->slots + i)) std::atomic<T>();
+        a->mask = cap - 1;
+        a->retired = retired;
+        return a;
+    }
+
+    template <class T, class Alloc>
+    void work_stealing_deque<T, Alloc>::destroy_array(array_type *a) noexcept
+    {
+        array_allocator array_alloc(this->alloc_ref());
+        slot_traits::deallocate(this->alloc_ref(), a->slots, a->capacity());
+        array_traits::deallocate(array_alloc, a, 1);
+    }
+
+    // 把 [top, bottom) 复制到容量翻倍的新数组，旧数组挂到新数组的 retired 链上
+    template <class T, class Alloc>
+    typename work_stealing_deque<T, Alloc>::array_type *
+    work_stealing_deque<T, Alloc>::grow(array_type *a, ptrdiff_t top, ptrdiff_t bottom)
+    {
+        array_type *na = create_array(a->capacity() << 1, a);
+        for (ptrdiff_t i = top; i < bottom; ++i)
+            na->put(i, a->get(i));
+        array_.store(na, std::memory_order_release);
+        return na;
+    }
+
+} // namespace mySTL
+#endif // !MYSTL_WORK_STEALING_DEQUE_H_
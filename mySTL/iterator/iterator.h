@@ -154,7 +154,7 @@ namespace mySTL
     //input_iterator_tag版本
     template <class Iter>
     typename iterator_traits <Iter>::difference_type
-    distance_dispatch(Iter first, Iter last)
+    distance_dispatch(Iter first, Iter last, input_iterator_tag)
     {
         typename iterator_traits <Iter>::difference_type n = 0;
         while (first != last)
@@ -195,7 +195,7 @@ namespace mySTL
 
     //bidirectional_iterator_tag版本
     template <class Iter, class Distance>
-    void advance_dispatch(Iter& i, Distance n, random_access_iterator_tag)
+    void advance_dispatch(Iter& i, Distance n, bidirectional_iterator_tag)
     {
         if (n >= 0)
         {
@@ -215,7 +215,7 @@ namespace mySTL
 
     //random_access_iterator_tag版本
     template <class Iter, class Distance>
-    void advance_patch(Iter& i, Distance n, random_access_iterator_tag)
+    void advance_dispatch(Iter& i, Distance n, random_access_iterator_tag)
     {
         i += n;
     }
@@ -227,6 +227,24 @@ namespace mySTL
         advance_dispatch(i, n, iterator_category(i));
     }
 
+    /* 分段迭代器 */
+    // 由多段连续内存组成的容器（如 deque）的迭代器可以特化 segmented_iterator_traits，
+    // 提供 segment_iterator / local_iterator 类型以及以下静态函数：
+    //   segment(it)         : it 所在的段
+    //   local(it)           : it 在段内的位置
+    //   begin(s) / end(s)   : 段 s 的连续内存 [begin, end)
+    //   compose(s, l)       : 由段与段内位置合成迭代器，l == end(s) 时得到下一段的开头
+    // copy、move、fill、equal、find、for_each 等算法据此把区间拆成若干段，在每一段上使用指针版本
+    template <class Iter>
+    struct segmented_iterator_traits
+    {
+        static constexpr bool is_segmented = false;
+    };
+
+    template <class Iter>
+    struct is_segmented_iterator
+        : public m_intergral_constant<bool, segmented_iterator_traits<Iter>::is_segmented> {};
+
 
     /* 反向迭代器 reverse_iterator */
     template <class Iterator>
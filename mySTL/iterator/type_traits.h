@@ -7,11 +7,9 @@ namespace mySTL
 {
 
     //定义结构体/类中的常量
+    //与 std::integral_constant 为同一类型，标签分派时可以直接接受 std 的萃取结果
     template<class T, T v>
-    struct m_intergral_constant
-    {
-        static constexpr T value = v;
-    };
+    using m_intergral_constant = std::integral_constant<T, v>;
 
     //定义编译器的true/false
     typedef m_intergral_constant<bool, true> m_true_type;
@@ -28,6 +26,13 @@ namespace mySTL
     template <class T1, class T2>
     struct is_pair<mySTL::pair<T1, T2>> : mySTL::m_true_type{};
 
+    //判断类型能否按字节搬移：把对象 memcpy 到新地址并且不调用原对象的析构函数，
+    //效果与移动构造后析构原对象相同。平凡可复制的类型总是满足，
+    //不保存指向自身的指针的类（如 vector、basic_string）可以特化为 m_true_type
+    template <class T>
+    struct is_trivially_relocatable
+        : m_intergral_constant<bool, std::is_trivially_copyable<T>::value> {};
+
 }
 
 
@@ -13,6 +13,7 @@
 #include "../algorithm/algobase.h"
 #include "../algorithm/uninitialized.h"
 #include "../allocator/allocator.h"
+#include "../allocator/allocator_traits.h"
 #include "../allocator/construct.h"
 #include "util.h"
 // #include "./construct.h"
@@ -97,11 +98,8 @@ namespace mySTL
 
     private:
         void allocate_buffer();
-        void initialize_buffer(const T&, mySTL::m_true_type)   {}
-        void initialize_buffer(const T& value, mySTL::m_false_type) 
-        {
-            mySTL::uninitialized_fill_n(buffer, len, value);
-        }
+        void initialize_buffer(ForwardIter, mySTL::m_true_type)   {}
+        void initialize_buffer(ForwardIter first, mySTL::m_false_type);
 
     private:
         temporary_buffer(const temporary_buffer&);
@@ -117,7 +115,7 @@ namespace mySTL
             allocate_buffer();
             if (len > 0)
             {
-                initialize_buffer(*first, std::is_trivially_default_constructible<T>());
+                initialize_buffer(first, std::is_trivially_default_constructible<T>());
             }
         }
         catch (...)
@@ -128,6 +126,28 @@ namespace mySTL
         }
     }
 
+    // 把 *first 依次移动构造到缓冲区的每个位置，最后移回 *first
+    // 缓冲区中只留下被移动过的对象，不复制元素，也不需要额外的内存
+    template <class ForwardIter, class T>
+    void temporary_buffer<ForwardIter, T>::initialize_buffer(ForwardIter first, mySTL::m_false_type)
+    {
+        T* cur = buffer;
+        mySTL::construct(cur, mySTL::move(*first));
+        ++cur;
+        try
+        {
+            for (; cur != buffer + len; ++cur)
+                mySTL::construct(cur, mySTL::move(*(cur - 1)));
+        }
+        catch (...)
+        {
+            *first = mySTL::move(*(cur - 1));
+            mySTL::destroy(buffer, cur);
+            throw;
+        }
+        *first = mySTL::move(*(cur - 1));
+    }
+
     template <class ForwardIter, class T>
     void temporary_buffer<ForwardIter, T>::allocate_buffer()
     {
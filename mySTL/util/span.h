@@ -0,0 +1,106 @@
+#ifndef MYSTL_SPAN_H_
+#define MYSTL_SPAN_H_
+
+// 这个头文件包含一个模板类 span
+// span : 指向一段连续对象的视图，只保存起始地址与长度，不拥有这些对象
+
+#include <cstddef>
+#include <type_traits>
+
+#include "../iterator/iterator.h"
+#include "exceptdef.h"
+
+namespace mySTL
+{
+
+    template <class T>
+    class span
+    {
+    public:
+        typedef T element_type;
+        typedef typename std::remove_cv<T>::type value_type;
+        typedef size_t size_type;
+        typedef ptrdiff_t difference_type;
+        typedef T *pointer;
+        typedef const T *const_pointer;
+        typedef T &reference;
+        typedef const T &const_reference;
+
+        typedef T *iterator;
+        typedef mySTL::reverse_iterator<iterator> reverse_iterator;
+
+    private:
+        pointer data_;
+        size_type size_;
+
+    public:
+        span() noexcept
+            : data_(nullptr), size_(0)
+        {
+        }
+
+        span(pointer p, size_type n) noexcept
+            : data_(p), size_(n)
+        {
+        }
+
+        span(pointer first, pointer last) noexcept
+            : data_(first), size_(static_cast<size_type>(last - first))
+        {
+        }
+
+        // span<T> 可以转换为 span<const T>
+        template <class U, typename std::enable_if<
+                               std::is_convertible<U (*)[], T (*)[]>::value, int>::type = 0>
+        span(const span<U> &rhs) noexcept
+            : data_(rhs.data()), size_(rhs.size())
+        {
+        }
+
+        iterator begin() const noexcept { return data_; }
+        iterator end() const noexcept { return data_ + size_; }
+        reverse_iterator rbegin() const noexcept { return reverse_iterator(end()); }
+        reverse_iterator rend() const noexcept { return reverse_iterator(begin()); }
+
+        pointer data() const noexcept { return data_; }
+        size_type size() const noexcept { return size_; }
+        size_type size_bytes() const noexcept { return size_ * sizeof(T); }
+        bool empty() const noexcept { return size_ == 0; }
+
+        reference operator[](size_type n) const
+        {
+            MYSTL_DEBUG(n < size_);
+            return data_[n];
+        }
+        reference front() const
+        {
+            MYSTL_DEBUG(!empty());
+            return data_[0];
+        }
+        reference back() const
+        {
+            MYSTL_DEBUG(!empty());
+            return data_[size_ - 1];
+        }
+
+        // 子视图
+        span first(size_type count) const
+        {
+            MYSTL_DEBUG(count <= size_);
+            return span(data_, count);
+        }
+        span last(size_type count) const
+        {
+            MYSTL_DEBUG(count <= size_);
+            return span(data_ + (size_ - count), count);
+        }
+        span subspan(size_type offset, size_type count) const
+        {
+            MYSTL_DEBUG(offset <= size_ && count <= size_ - offset);
+            return span(data_ + offset, count);
+        }
+    };
+
+}
+
+#endif // !MYSTL_SPAN_H_
@@ -0,0 +1,441 @@
+#ifndef MYSTL_THREAD_POOL_H_
+#define MYSTL_THREAD_POOL_H_
+
+// 这个头文件包含 thread_pool、task_group 以及函数 parallel_for
+// thread_pool  : 固定数量的工作线程，每个线程一个 work_stealing_deque，空闲时从其他线程窃取任务
+// task_group   : 一组任务，spawn 提交任务，wait 等待组内所有任务完成
+// parallel_for : 把 [first, last) 二分到不超过 grain 的子区间，并行调用 f(begin, end)
+//   mySTL::task_group g;
+//   g.spawn([] { work(); });
+//   g.wait();
+//   mySTL::parallel_for(size_t(0), v.size(), size_t(4096), [&](size_t b, size_t e) { ... });
+
+// notes:
+//
+// 工作线程 spawn 的任务放入自己的队列底部，其他线程 spawn 的任务放入共享的注入队列
+// 工作线程依次从自己的队列、注入队列、随机选取的其他线程的队列中取任务，都没有时短暂让出，再睡眠在条件变量上
+// wait 不会阻塞工作线程：等待期间当前线程也会执行队列中的任务，嵌套的 task_group 不会死锁
+// 任务抛出的异常由 task_group 保存第一个，wait 在所有任务完成后重新抛出
+// 任务对象使用 thread_cache_allocator 分配，可以在其他线程释放
+// thread_pool::instance() 是全局的默认线程池，线程数为 std::thread::hardware_concurrency()
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+
+#include "../allocator/aligned_allocator.h"
+#include "../allocator/thread_cache_allocator.h"
+#include "../container/sequence/deque.h"
+#include "../container/sequence/work_stealing_deque.h"
+#include "util.h"
+
+namespace mySTL
+{
+    class thread_pool;
+    class task_group;
+
+    // 任务基类，destroy 负责析构并释放自身
+    struct pool_task
+    {
+        task_group *group;
+
+        virtual void run() = 0;
+        virtual void destroy() noexcept = 0;
+
+    protected:
+        ~pool_task() = default;
+    };
+
+    template <class Function>
+    struct pool_task_impl final : public pool_task
+    {
+        typedef mySTL::thread_cache_allocator<pool_task_impl> task_allocator;
+
+        Function fn;
+
+        template <class F>
+        pool_task_impl(task_group *g, F &&f) : fn(mySTL::forward<F>(f)) { group = g; }
+
+        void run() override { fn(); }
+
+        void destroy() noexcept override
+        {
+            this->~pool_task_impl();
+            task_allocator::deallocate(this, 1);
+        }
+    };
+
+    /*****************************************************************************************/
+    // 类 thread_pool
+    class thread_pool
+    {
+        friend class task_group;
+
+    private:
+        struct worker
+        {
+            mySTL::work_stealing_deque<pool_task *> tasks;
+            std::thread thread;
+        };
+
+        // 当前线程所属的线程池与编号，不是工作线程时 pool 为空
+        struct worker_context
+        {
+            thread_pool *pool;
+            size_t index;
+        };
+
+        enum
+        {
+            SPIN_ROUNDS = 64 // 找不到任务时睡眠之前让出的次数
+        };
+
+        typedef mySTL::aligned_allocator<worker> worker_allocator;
+
+        worker *workers_;
+        size_t size_;
+
+        std::mutex lock_; // 保护 inject_ 与睡眠
+        std::condition_variable wake_;
+        mySTL::deque<pool_task *> inject_;
+        std::atomic<size_t> injected_; // inject_ 的大小，不加锁也可以读取
+
+        std::atomic<size_t> pending_;  // 已提交但还未被取走的任务数
+        std::atomic<size_t> sleeping_; // 正在睡眠的工作线程数
+        std::atomic<bool> stop_;
+
+    public:
+        // 构造、析构函数
+
+        explicit thread_pool(size_t n = default_concurrency())
+            : workers_(nullptr), size_(n == 0 ? 1 : n), injected_(0), pending_(0), sleeping_(0), stop_(false)
+        {
+            workers_ = worker_allocator::allocate(size_);
+            for (size_t i = 0; i < size_; ++i)
+                ::new (static_cast<void *>(workers_ + i)) worker();
+            for (size_t i = 0; i < size_; ++i)
+                workers_[i].thread = std::thread([this, i] { worker_loop(i); });
+        }
+
+        thread_pool(const thread_pool &) = delete;
+        thread_pool &operator=(const thread_pool &) = delete;
+
+        // 工作线程执行完所有已提交的任务后退出
+        ~thread_pool()
+        {
+            {
+                std::lock_guard<std::mutex> guard(lock_);
+                stop_.store(true);
+            }
+            wake_.notify_all();
+            for (size_t i = 0; i < size_; ++i)
+                workers_[i].thread.join();
+            for (size_t i = 0; i < size_; ++i)
+                workers_[i].~worker();
+            worker_allocator::deallocate(workers_, size_);
+        }
+
+        static size_t default_concurrency() noexcept
+        {
+            const size_t n = std::thread::hardware_concurrency();
+            return n == 0 ? 1 : n;
+        }
+
+        // 全局的默认线程池
+        static thread_pool &instance()
+        {
+            static thread_pool pool;
+            return pool;
+        }
+
+    public:
+        size_t size() const noexcept { return size_; }
+
+        // 当前线程是否是本线程池的工作线程
+        bool in_worker() const noexcept { return context().pool == this; }
+
+    private:
+        static worker_context &context() noexcept
+        {
+            static thread_local worker_context ctx = {nullptr, 0};
+            return ctx;
+        }
+
+        void submit(pool_task *t);
+        bool take(pool_task *&t);
+        bool run_one();
+        void execute(pool_task *t) noexcept;
+        void worker_loop(size_t index);
+    };
+
+    /*****************************************************************************************/
+    // 类 task_group
+    class task_group
+    {
+        friend class thread_pool;
+
+    private:
+        thread_pool *pool_;
+        std::atomic<size_t> count_; // 未完成的任务数
+        std::mutex lock_;           // 保护 error_ 与完成通知
+        std::condition_variable done_;
+        std::exception_ptr error_;
+
+    public:
+        explicit task_group(thread_pool &pool = thread_pool::instance())
+            : pool_(&pool), count_(0) {}
+
+        task_group(const task_group &) = delete;
+        task_group &operator=(const task_group &) = delete;
+
+        // 析构前等待所有任务完成，未取出的异常被丢弃
+        ~task_group()
+        {
+            try
+            {
+                wait();
+            }
+            catch (...)
+            {
+            }
+        }
+
+        template <class Function>
+        void spawn(Function &&f)
+        {
+            typedef pool_task_impl<typename std::decay<Function>::type> task_type;
+            typedef typename task_type::task_allocator task_allocator;
+            task_type *t = task_allocator::allocate(1);
+            try
+            {
+                ::new (static_cast<void *>(t)) task_type(this, mySTL::forward<Function>(f));
+            }
+            catch (...)
+            {
+                task_allocator::deallocate(t, 1);
+                throw;
+            }
+            count_.fetch_add(1, std::memory_order_relaxed);
+            try
+            {
+                pool_->submit(t);
+            }
+            catch (...)
+            {
+                count_.fetch_sub(1, std::memory_order_relaxed);
+                t->destroy();
+                throw;
+            }
+        }
+
+        void wait();
+
+    private:
+        void finish(std::exception_ptr e) noexcept;
+    };
+
+    /*****************************************************************************************/
+
+    // 工作线程提交到自己的队列，其他线程提交到注入队列
+    inline void thread_pool::submit(pool_task *t)
+    {
+        pending_.fetch_add(1);
+        worker_context &ctx = context();
+        try
+        {
+            if (ctx.pool == this)
+            {
+                workers_[ctx.index].tasks.push(t);
+            }
+            else
+            {
+                std::lock_guard<std::mutex> guard(lock_);
+                inject_.push_back(t);
+                injected_.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        catch (...)
+        {
+            pending_.fetch_sub(1);
+            throw;
+        }
+        if (sleeping_.load() != 0)
+        {
+            std::lock_guard<std::mutex> guard(lock_);
+            wake_.notify_one();
+        }
+    }
+
+    // 依次从自己的队列、注入队列、其他线程的队列中取出一个任务
+    inline bool thread_pool::take(pool_task *&t)
+    {
+        worker_context &ctx = context();
+        const bool is_worker = ctx.pool == this;
+        if (is_worker && workers_[ctx.index].tasks.try_pop(t))
+        {
+            pending_.fetch_sub(1);
+            return true;
+        }
+        if (injected_.load(std::memory_order_relaxed) != 0)
+        {
+            std::lock_guard<std::mutex> guard(lock_);
+            if (!inject_.empty())
+            {
+                t = inject_.front();
+                inject_.pop_front();
+                injected_.fetch_sub(1, std::memory_order_relaxed);
+                pending_.fetch_sub(1);
+                return true;
+            }
+        }
+        // 从随机位置开始依次尝试窃取
+        static thread_local unsigned seed = static_cast<unsigned>(
+            std::hash<std::thread::id>()(std::this_thread::get_id())) | 1u;
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        const size_t start = seed % size_;
+        for (size_t k = 0; k < size_; ++k)
+        {
+            const size_t victim = (start + k) % size_;
+            if (is_worker && victim == ctx.index)
+                continue;
+            if (workers_[victim].tasks.try_steal(t))
+            {
+                pending_.fetch_sub(1);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    inline bool thread_pool::run_one()
+    {
+        pool_task *t;
+        if (!take(t))
+            return false;
+        execute(t);
+        return true;
+    }
+
+    inline void thread_pool::execute(pool_task *t) noexcept
+    {
+        task_group *g = t->group;
+        std::exception_ptr e;
+        try
+        {
+            t->run();
+        }
+        catch (...)
+        {
+            e = std::current_exception();
+        }
+        t->destroy();
+        g->finish(e);
+    }
+
+    inline void thread_pool::worker_loop(size_t index)
+    {
+        context() = worker_context{this, index};
+        size_t idle = 0;
+        while (true)
+        {
+            if (run_one())
+            {
+                idle = 0;
+                continue;
+            }
+            if (++idle < SPIN_ROUNDS)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+            idle = 0;
+            std::unique_lock<std::mutex> lk(lock_);
+            if (stop_.load() && pending_.load() == 0)
+                break;
+            sleeping_.fetch_add(1);
+            wake_.wait(lk, [this] { return pending_.load() != 0 || stop_.load(); });
+            sleeping_.fetch_sub(1);
+        }
+    }
+
+    /*****************************************************************************************/
+
+    // 等待期间帮助执行任务；没有可执行的任务时短暂睡眠，期间可能有新任务被提交
+    inline void task_group::wait()
+    {
+        while (count_.load(std::memory_order_acquire) != 0)
+        {
+            if (pool_->run_one())
+                continue;
+            std::unique_lock<std::mutex> lk(lock_);
+            done_.wait_for(lk, std::chrono::milliseconds(1),
+                           [this] { return count_.load(std::memory_order_acquire) == 0; });
+        }
+        // 持有 lock_ 一次，确保最后完成的任务已经离开 finish
+        std::exception_ptr e;
+        {
+            std::lock_guard<std::mutex> guard(lock_);
+            e = error_;
+            error_ = nullptr;
+        }
+        if (e)
+            std::rethrow_exception(e);
+    }
+
+    inline void task_group::finish(std::exception_ptr e) noexcept
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        if (e && !error_)
+            error_ = e;
+        if (count_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            done_.notify_all();
+    }
+
+    /*****************************************************************************************/
+    // parallel_for
+    // 把 [first, last) 不断二分，右半部分作为新任务，直到区间长度不超过 grain，再调用 f(begin, end)
+    /*****************************************************************************************/
+    template <class Size, class Function>
+    void parallel_for_range(task_group &g, Size first, Size last, Size grain, Function &f)
+    {
+        while (last - first > grain)
+        {
+            const Size mid = first + (last - first) / 2;
+            g.spawn([&g, &f, mid, last, grain] { parallel_for_range(g, mid, last, grain, f); });
+            last = mid;
+        }
+        f(first, last);
+    }
+
+    template <class Size, class Function>
+    void parallel_for(Size first, Size last, Size grain, Function f, thread_pool &pool)
+    {
+        if (!(first < last))
+            return;
+        if (grain < Size(1))
+            grain = Size(1);
+        if (last - first <= grain)
+        {
+            f(first, last);
+            return;
+        }
+        task_group g(pool);
+        parallel_for_range(g, first, last, grain, f);
+        g.wait();
+    }
+
+    template <class Size, class Function>
+    void parallel_for(Size first, Size last, Size grain, Function f)
+    {
+        mySTL::parallel_for(first, last, grain, mySTL::move(f), thread_pool::instance());
+    }
+
+} // namespace mySTL
+#endif // !MYSTL_THREAD_POOL_H_
@@ -4,6 +4,8 @@
 //move, forward, swap 等常用函数，以及pair等
 
 #include <cstddef>
+#include <tuple>
+#include <utility>
 #include "../iterator/type_traits.h"
 
 namespace mySTL
@@ -56,6 +58,26 @@ namespace mySTL
         mySTL::swap_range(a, a + N, b);
     }
 
+    /* index_sequence */
+    // C++11 中没有 std::index_sequence，用于展开 tuple 或参数包的下标
+    template <size_t... I>
+    struct index_sequence {};
+
+    template <size_t N, size_t... I>
+    struct make_index_sequence_impl : make_index_sequence_impl<N - 1, N - 1, I...> {};
+
+    template <size_t... I>
+    struct make_index_sequence_impl<0, I...>
+    {
+        typedef index_sequence<I...> type;
+    };
+
+    template <size_t N>
+    using make_index_sequence = typename make_index_sequence_impl<N>::type;
+
+    template <class... Ts>
+    using index_sequence_for = make_index_sequence<sizeof...(Ts)>;
+
     /* pair */
     template <class Ty1, class Ty2>
     struct pair
@@ -181,6 +203,22 @@ namespace mySTL
         {
         }
 
+        // piecewise constructiable, first and second are built from the two tuples
+        template <class... Args1, class... Args2>
+        pair(std::piecewise_construct_t, std::tuple<Args1...> a, std::tuple<Args2...> b)
+            : pair(a, b, index_sequence_for<Args1...>(), index_sequence_for<Args2...>())
+        {
+        }
+
+    private:
+        template <class Tuple1, class Tuple2, size_t... I1, size_t... I2>
+        pair(Tuple1& a, Tuple2& b, index_sequence<I1...>, index_sequence<I2...>)
+            : first(std::get<I1>(mySTL::move(a))...),
+            second(std::get<I2>(mySTL::move(b))...)
+        {
+        }
+
+    public:
         //  copy assign for this pair
         pair& operator=(const pair& rhs)
         {
@@ -269,6 +307,12 @@ namespace mySTL
         lhs.swap(rhs);
     }
 
+    //  pair 的两个成员都可以按字节搬移时，pair 也可以
+    template <class Ty1, class Ty2>
+    struct is_trivially_relocatable<pair<Ty1, Ty2>>
+        : m_intergral_constant<bool, is_trivially_relocatable<Ty1>::value &&
+                                     is_trivially_relocatable<Ty2>::value> {};
+
     //  make_pair
     template <class Ty1, class Ty2>
     pair<Ty1, Ty2> make_pair(Ty1&& first, Ty2&& second)